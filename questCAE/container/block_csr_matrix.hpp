@@ -0,0 +1,886 @@
+/*--------------------------------------------------------
+“串行”分块压缩行存储（BSR, Block Compressed Sparse Row）格式的矩阵
+适用于每个节点具有固定数目自由度的向量值问题
+--------------------------------------------------------*/
+
+#ifndef QUEST_BLOCK_CSR_MATRIX_HPP
+#define QUEST_BLOCK_CSR_MATRIX_HPP
+
+// 系统头文件
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/sparse_graph.hpp"
+#include "container/sparse_contiguous_row_graph.hpp"
+#include "container/system_vector.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/atomic_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+#include "includes/parallel_enviroment.hpp"
+
+namespace Quest{
+
+    /**
+     * @class BlockCsrMatrix
+     * @brief 串行分块压缩行存储（BSR）格式的矩阵，包含单元组装能力
+     * @details 稀疏模式由节点级的矩阵图给出，每个非零块为 TBlockSize x TBlockSize 的稠密子矩阵，
+     *  块内按行优先存储。每个块只存储一个列索引，相比逐元素存储列索引的 CsrMatrix，
+     *  索引数据量减少为 1/(TBlockSize*TBlockSize)，且块尺寸在编译期已知，矩阵向量乘的内层循环可被完全展开。
+     *  标量自由度编号与节点编号的关系为 EquationId = NodeIndex*TBlockSize + d
+     * @tparam TBlockSize 每个节点的自由度数（块尺寸）
+     * @tparam TDataType 存储的数据类型
+     * @tparam TIndexType 存储的索引类型
+     */
+    template<std::size_t TBlockSize, typename TDataType = double, typename TIndexType = std::size_t>
+    class BlockCsrMatrix final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+            using ValueVectorType = std::vector<TDataType>;
+
+            static constexpr IndexType BlockSize = TBlockSize;
+            static constexpr IndexType BlockEntries = TBlockSize*TBlockSize;
+
+            static_assert(TBlockSize > 0, "The block size of a BlockCsrMatrix must be positive");
+
+            QUEST_CLASS_POINTER_DEFINITION(BlockCsrMatrix);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            BlockCsrMatrix():
+                mBlockRowIndices(1, 0)
+            {
+                mpComm = &ParallelEnvironment::GetDataCommunicator("Serial");
+            }
+
+            /**
+             * @brief 构造函数
+             */
+            BlockCsrMatrix(const DataCommunicator& rComm):
+                mBlockRowIndices(1, 0)
+            {
+                if(rComm.IsDistributed()){
+                    QUEST_ERROR << "Attempting to construct a serial BlockCsrMatrix with a distributed communicator" << std::endl;
+                }
+                mpComm = &rComm;
+            }
+
+            /**
+             * @brief 构造函数
+             * @details rNodalGraph 为节点级（块级）的矩阵图，第 I 行第 J 列的条目对应一个 TBlockSize x TBlockSize 的非零块
+             */
+            template<typename TGraphType>
+            BlockCsrMatrix(const TGraphType& rNodalGraph){
+                mpComm = rNodalGraph.pGetComm();
+                rNodalGraph.ExportCSRArrays(mBlockRowIndices, mBlockColIndices);
+                if(mBlockRowIndices.empty()){
+                    mBlockRowIndices.assign(1, 0);
+                }
+
+                ComputeBlockColSize();
+
+                mValues.resize(mBlockColIndices.size()*BlockEntries);
+                SetValue(0.0);
+            }
+
+            /**
+             * @brief 复制构造函数
+             */
+            explicit BlockCsrMatrix(const BlockCsrMatrix& rOtherMatrix):
+                mpComm(rOtherMatrix.mpComm),
+                mBlockRowIndices(rOtherMatrix.mBlockRowIndices),
+                mBlockColIndices(rOtherMatrix.mBlockColIndices),
+                mValues(rOtherMatrix.mValues),
+                mNumberOfBlockCols(rOtherMatrix.mNumberOfBlockCols)
+            {
+            }
+
+            /**
+             * @brief 移动构造函数
+             */
+            BlockCsrMatrix(BlockCsrMatrix&& rOtherMatrix) = default;
+
+            /**
+             * @brief 析构函数
+             */
+            ~BlockCsrMatrix(){}
+
+            /**
+             * @brief 赋值运算符重载
+             */
+            BlockCsrMatrix& operator = (const BlockCsrMatrix& rOtherMatrix) = delete;
+
+            /**
+             * @brief 移动赋值运算符重载
+             */
+            BlockCsrMatrix& operator = (BlockCsrMatrix&& rOtherMatrix) = default;
+
+            /**
+             * @brief 清空矩阵
+             */
+            void Clear(){
+                mBlockRowIndices.assign(1, 0);
+                IndexVectorType().swap(mBlockColIndices);
+                ValueVectorType().swap(mValues);
+                mNumberOfBlockCols = 0;
+            }
+
+            /**
+             * @brief 获取数据通讯器对象
+             */
+            const DataCommunicator& GetComm() const{
+                return *mpComm;
+            }
+
+            /**
+             * @brief 获取数据通讯器对象指针
+             */
+            const DataCommunicator* pGetComm() const{
+                return mpComm;
+            }
+
+            /**
+             * @brief 将所有存储的元素设置为value
+             */
+            void SetValue(const TDataType value){
+                IndexPartition<IndexType>(mValues.size()).for_each([&](IndexType i){
+                    mValues[i] = value;
+                });
+            }
+
+            /**
+             * @brief 返回块行数（节点数）
+             */
+            IndexType NumberOfBlockRows() const{
+                return mBlockRowIndices.size() - 1;
+            }
+
+            /**
+             * @brief 返回块列数
+             */
+            IndexType NumberOfBlockCols() const{
+                return mNumberOfBlockCols;
+            }
+
+            /**
+             * @brief 返回非零块数目
+             */
+            IndexType NumberOfBlocks() const{
+                return mBlockColIndices.size();
+            }
+
+            /**
+             * @brief 返回矩阵（标量）行数
+             */
+            IndexType size1() const{
+                return NumberOfBlockRows()*BlockSize;
+            }
+
+            /**
+             * @brief 返回矩阵（标量）列数
+             */
+            IndexType size2() const{
+                return mNumberOfBlockCols*BlockSize;
+            }
+
+            /**
+             * @brief 返回存储的标量元素数目（非零块数目乘以块内元素数）
+             */
+            inline IndexType nnz() const{
+                return mValues.size();
+            }
+
+            /**
+             * @brief 返回块行索引数组
+             */
+            inline IndexVectorType& index1_data(){
+                return mBlockRowIndices;
+            }
+
+            /**
+             * @brief 返回块列索引数组
+             */
+            inline IndexVectorType& index2_data(){
+                return mBlockColIndices;
+            }
+
+            /**
+             * @brief 返回值数组，第 k 个非零块占据 [k*BlockEntries, (k+1)*BlockEntries)
+             */
+            inline ValueVectorType& value_data(){
+                return mValues;
+            }
+
+            /**
+             * @brief 返回块行索引数组
+             */
+            inline const IndexVectorType& index1_data() const{
+                return mBlockRowIndices;
+            }
+
+            /**
+             * @brief 返回块列索引数组
+             */
+            inline const IndexVectorType& index2_data() const{
+                return mBlockColIndices;
+            }
+
+            /**
+             * @brief 返回值数组
+             */
+            inline const ValueVectorType& value_data() const{
+                return mValues;
+            }
+
+            /**
+             * @brief 返回第 k 个非零块的首地址（块内行优先）
+             */
+            inline TDataType* GetBlock(const IndexType k){
+                return mValues.data() + k*BlockEntries;
+            }
+
+            /**
+             * @brief 返回第 k 个非零块的首地址（块内行优先）
+             */
+            inline const TDataType* GetBlock(const IndexType k) const{
+                return mValues.data() + k*BlockEntries;
+            }
+
+            /**
+             * @brief 设置块列数
+             */
+            void SetBlockColSize(IndexType NumberOfBlockCols){
+                mNumberOfBlockCols = NumberOfBlockCols;
+            }
+
+            /**
+             * @brief 由块列索引计算块列数
+             */
+            void ComputeBlockColSize(){
+                if(mBlockColIndices.empty()){
+                    mNumberOfBlockCols = 0;
+                    return;
+                }
+                const IndexType max_col = IndexPartition<IndexType>(mBlockColIndices.size()).template for_each<Internals::MaxReduction<IndexType>>([&](IndexType k){
+                    return mBlockColIndices[k];
+                });
+                mNumberOfBlockCols = std::max(max_col + 1, NumberOfBlockRows());
+            }
+
+            /**
+             * @brief 查找块(BlockI, BlockJ)在非零块中的位置，不存在时返回最大值
+             */
+            IndexType FindBlock(const IndexType BlockI, const IndexType BlockJ) const{
+                return BinarySearch(mBlockRowIndices[BlockI], mBlockRowIndices[BlockI+1], BlockJ);
+            }
+
+            /**
+             * @brief 函数调用形式的（标量）矩阵元素访问
+             */
+            TDataType& operator()(IndexType I, IndexType J){
+                const IndexType k = FindBlock(I/BlockSize, J/BlockSize);
+                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << I << " " << J << " not found in matrix" << std::endl;
+                return mValues[k*BlockEntries + (I%BlockSize)*BlockSize + J%BlockSize];
+            }
+
+            /**
+             * @brief 函数调用形式的（标量）矩阵元素访问
+             */
+            const TDataType& operator()(IndexType I, IndexType J) const{
+                const IndexType k = FindBlock(I/BlockSize, J/BlockSize);
+                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << I << " " << J << " not found in matrix" << std::endl;
+                return mValues[k*BlockEntries + (I%BlockSize)*BlockSize + J%BlockSize];
+            }
+
+            /**
+             * @brief 判断（标量）元素(I,J)是否存在于矩阵中
+             */
+            bool Has(IndexType I, IndexType J) const{
+                return FindBlock(I/BlockSize, J/BlockSize) != std::numeric_limits<IndexType>::max();
+            }
+
+            /**
+             * @brief 计算 y += A * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @details 每个块行的结果先累加在长度为 TBlockSize 的局部数组中（寄存器分块），块行结束时一次性写回
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void SpMV(const TInputVectorType& x, TOutputVectorType& y) const{
+                QUEST_ERROR_IF(size1() != y.size()) << "SpMV: mismatch between row sizes : " << size1()  << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(size2() != x.size()) << "SpMV: mismatch between col sizes : " << size2()  << " and input vector size " << x.size() << std::endl;
+                if(nnz() != 0){
+                    IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                        TDataType y_local[TBlockSize];
+                        BlockRowProduct(ib, x, y_local);
+                        const IndexType row = ib*BlockSize;
+                        for(IndexType r=0; r<BlockSize; ++r){
+                            y(row + r) += y_local[r];
+                        }
+                    });
+                }
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @details beta 为零时不读取 y，y 中原有的 NaN/Inf 不会保留
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void SpMV(
+                const TDataType alpha,
+                const TInputVectorType& x,
+                const TDataType beta,
+                TOutputVectorType& y
+            ) const {
+                QUEST_ERROR_IF(size1() != y.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(size2() != x.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and input vector size " << x.size() << std::endl;
+                IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                    TDataType y_local[TBlockSize];
+                    BlockRowProduct(ib, x, y_local);
+                    const IndexType row = ib*BlockSize;
+                    for(IndexType r=0; r<BlockSize; ++r){
+                        y(row + r) = (beta == TDataType()) ? alpha * y_local[r] : alpha * y_local[r] + beta * y(row + r);
+                    }
+                });
+            }
+
+            /**
+             * @brief 计算 y += AT * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @details 每个块先在局部数组中完成 TBlockSize x TBlockSize 的转置乘法，再以原子加法写回
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void TransposeSpMV(const TInputVectorType& x, TOutputVectorType& y) const{
+                QUEST_ERROR_IF(size2() != y.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(size1() != x.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and input vector size " << x.size() << std::endl;
+                BlockTransposeProduct(TDataType(1), x, y);
+            }
+
+            /**
+             * @brief 计算 y = alpha*AT*x + beta*y, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @details beta 为零时不读取 y，y 中原有的 NaN/Inf 不会保留
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void TransposeSpMV(
+                const TDataType alpha,
+                const TInputVectorType& x,
+                const TDataType beta,
+                TOutputVectorType& y
+            ) const {
+                QUEST_ERROR_IF(size2() != y.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(size1() != x.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and input vector size " << x.size() << std::endl;
+                IndexPartition<IndexType>(y.size()).for_each([&](IndexType i){
+                    y(i) = (beta == TDataType()) ? TDataType() : beta * y(i);
+                });
+                BlockTransposeProduct(alpha, x, y);
+            }
+
+            /**
+             * @brief 计算稀疏矩阵的 Frobenius 范数
+             */
+            TDataType NormFrobenius() const{
+                auto sum2 = IndexPartition<IndexType>(mValues.size()).template for_each<Internals::SumReduction<TDataType>>([this](IndexType i){
+                    return mValues[i] * mValues[i];
+                });
+                return std::sqrt(sum2);
+            }
+
+            /**
+             * @brief 开始并行化Assemble操作
+             */
+            void BeginAssemble(){}
+
+            /**
+             * @brief 结束并行化Assemble操作
+             */
+            void FinalizeAssemble(){}
+
+            /**
+             * @brief 基于全局（标量）方程编号EquationId，将矩阵rMatrixInput的局部数据组装到当前矩阵中
+             * @details 方程编号须满足 EquationId = NodeIndex*TBlockSize + d。同一节点的相邻列共享一次块查找
+             */
+            template<typename TMatrixType, typename TIndexVectorType>
+            void Assemble(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& EquationId
+            ){
+                AssembleLocalMatrix<true>(rMatrixInput, EquationId);
+            }
+
+            /**
+             * @brief 基于全局（标量）方程编号EquationId，以普通（非原子）加法将矩阵rMatrixInput组装到当前矩阵中
+             * @details 仅当没有其他线程同时写入相同的块行时才可使用，例如按着色（EntityColoring）分批组装时
+             */
+            template<typename TMatrixType, typename TIndexVectorType>
+            void AssembleNonAtomic(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& EquationId
+            ){
+                AssembleLocalMatrix<false>(rMatrixInput, EquationId);
+            }
+
+            /**
+             * @brief 按节点编号将单元矩阵逐块组装到当前矩阵中
+             * @details 单元矩阵须按节点优先排列（第 a 个节点的第 d 个自由度位于 a*TBlockSize+d），
+             *  大小为 NodeIds.size()*TBlockSize。每对节点只查找一次块位置，随后整块累加
+             * @param rMatrixInput 单元矩阵
+             * @param NodeIds 单元节点在矩阵中的块行编号
+             */
+            template<typename TMatrixType, typename TIndexVectorType>
+            void AssembleBlocks(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& NodeIds
+            ){
+                AssembleLocalBlocks<true>(rMatrixInput, NodeIds);
+            }
+
+            /**
+             * @brief 按节点编号以普通（非原子）加法将单元矩阵逐块组装到当前矩阵中
+             * @details 仅当没有其他线程同时写入相同的块行时才可使用
+             */
+            template<typename TMatrixType, typename TIndexVectorType>
+            void AssembleBlocksNonAtomic(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& NodeIds
+            ){
+                AssembleLocalBlocks<false>(rMatrixInput, NodeIds);
+            }
+
+            /**
+             * @brief 将value值累加到指定对应位置的（标量）元素
+             */
+            void AssembleEntry(const TDataType& Value, const IndexType GlobalI, const IndexType GlobalJ){
+                const IndexType k = FindBlock(GlobalI/BlockSize, GlobalJ/BlockSize);
+                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << GlobalI << " " << GlobalJ << " not found in matrix" << std::endl;
+                AtomicAdd(mValues[k*BlockEntries + (GlobalI%BlockSize)*BlockSize + GlobalJ%BlockSize], Value);
+            }
+
+            /**
+             * @brief 提取块对角线
+             * @details rDiagonalBlocks 的大小为 NumberOfBlockRows()*BlockEntries，第 i 个对角块位于 [i*BlockEntries, (i+1)*BlockEntries)，
+             *  稀疏模式中不存在的对角块置零
+             */
+            void ExtractBlockDiagonal(ValueVectorType& rDiagonalBlocks) const{
+                rDiagonalBlocks.resize(NumberOfBlockRows()*BlockEntries);
+                IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                    TDataType* p_diagonal = rDiagonalBlocks.data() + ib*BlockEntries;
+                    const IndexType k = FindBlock(ib, ib);
+                    if(k != std::numeric_limits<IndexType>::max()){
+                        const TDataType* p_block = GetBlock(k);
+                        for(IndexType e=0; e<BlockEntries; ++e){
+                            p_diagonal[e] = p_block[e];
+                        }
+                    } else {
+                        for(IndexType e=0; e<BlockEntries; ++e){
+                            p_diagonal[e] = TDataType();
+                        }
+                    }
+                });
+            }
+
+            /**
+             * @brief 提取块Jacobi预条件子，即各对角块的逆
+             * @details 对角块以部分选主元的Gauss-Jordan消元求逆，对角块奇异时报错
+             * @param rInverseDiagonalBlocks 对角块的逆，排列方式同 ExtractBlockDiagonal
+             */
+            void ExtractInverseBlockDiagonal(ValueVectorType& rInverseDiagonalBlocks) const{
+                ValueVectorType diagonal_blocks;
+                ExtractBlockDiagonal(diagonal_blocks);
+                rInverseDiagonalBlocks.resize(diagonal_blocks.size());
+
+                IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                    const bool is_invertible = InvertBlock(diagonal_blocks.data() + ib*BlockEntries, rInverseDiagonalBlocks.data() + ib*BlockEntries);
+                    QUEST_ERROR_IF_NOT(is_invertible) << "The diagonal block of block row " << ib << " is singular" << std::endl;
+                });
+            }
+
+            /**
+             * @brief 应用块Jacobi预条件子 y = D^-1 * x
+             * @param rInverseDiagonalBlocks 由 ExtractInverseBlockDiagonal 得到的对角块的逆
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void ApplyBlockJacobi(
+                const ValueVectorType& rInverseDiagonalBlocks,
+                const TInputVectorType& x,
+                TOutputVectorType& y
+            ) const {
+                QUEST_ERROR_IF(rInverseDiagonalBlocks.size() != NumberOfBlockRows()*BlockEntries) << "ApplyBlockJacobi: the inverse diagonal blocks do not match the matrix" << std::endl;
+                IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                    const TDataType* p_block = rInverseDiagonalBlocks.data() + ib*BlockEntries;
+                    const IndexType row = ib*BlockSize;
+                    TDataType x_local[TBlockSize];
+                    for(IndexType c=0; c<BlockSize; ++c){
+                        x_local[c] = x(row + c);
+                    }
+                    for(IndexType r=0; r<BlockSize; ++r){
+                        TDataType aux = TDataType();
+                        for(IndexType c=0; c<BlockSize; ++c){
+                            aux += p_block[r*BlockSize + c] * x_local[c];
+                        }
+                        y(row + r) = aux;
+                    }
+                });
+            }
+
+            /**
+             * @brief 应用齐次Dirichlet边界条件
+             * @param rFreeDofsVector 自由度向量（自由为1，约束为0）
+             * @param DiagonalValue 对角线元素的值
+             * @param rRHS 右侧向量,同步更新
+             */
+            template<typename TVectorType1, typename TVectorType2=TVectorType1>
+            void ApplyHomogeneousDirichlet(
+                const TVectorType1& rFreeDofsVector,
+                const TDataType& DiagonalValue,
+                TVectorType2& rRHS
+            ){
+                QUEST_ERROR_IF(size1() != rFreeDofsVector.size()) << "ApplyDirichlet: mismatch between row sizes : " << size1()
+                    << " and free_dofs_vector size " << rFreeDofsVector.size() << std::endl;
+                QUEST_ERROR_IF(size2() != rFreeDofsVector.size()) << "ApplyDirichlet: mismatch between col sizes : " << size2()
+                    << " and free_dofs_vector size " << rFreeDofsVector.size() << std::endl;
+
+                if(DiagonalValue != 0){
+                    IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                        for(IndexType r=0; r<BlockSize; ++r){
+                            const IndexType i = ib*BlockSize + r;
+                            rRHS[i] *= rFreeDofsVector[i];
+                            const bool is_free = std::abs(rFreeDofsVector[i]-1.0) < 1e-14;
+
+                            for(IndexType k=mBlockRowIndices[ib]; k<mBlockRowIndices[ib+1]; ++k){
+                                TDataType* p_row = GetBlock(k) + r*BlockSize;
+                                const IndexType col = mBlockColIndices[k]*BlockSize;
+                                for(IndexType c=0; c<BlockSize; ++c){
+                                    if(is_free){
+                                        p_row[c] *= rFreeDofsVector[col + c];
+                                    } else {
+                                        p_row[c] = (col + c == i) ? DiagonalValue : TDataType();
+                                    }
+                                }
+                            }
+                        }
+                    });
+                }
+            }
+
+
+            std::string Info() const {
+                std::stringstream buffer;
+                buffer << "BlockCsrMatrix<" << TBlockSize << ">";
+                return buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const {
+                rOstream << Info() << std::endl;
+                PrintData(rOstream);
+            }
+
+
+            void PrintData(std::ostream& rOstream) const {
+                rOstream << "size1 : " << size1() << std::endl;
+                rOstream << "size2 : " << size2() << std::endl;
+                rOstream << "block size : " << BlockSize << std::endl;
+                rOstream << "number of blocks : " << NumberOfBlocks() << std::endl;
+                rOstream << "index1_data : " << std::endl;
+                for(auto item : index1_data()){
+                    rOstream << item << ",";
+                }
+                rOstream << std::endl;
+
+                rOstream << "index2_data : " << std::endl;
+                for(auto item : index2_data()){
+                    rOstream << item << ",";
+                }
+                rOstream << std::endl;
+
+                rOstream << "value_data : " << std::endl;
+                for(auto item : value_data()){
+                    rOstream << item << ",";
+                }
+                rOstream << std::endl;
+            }
+
+        protected:
+            /**
+             * @brief 在块列索引的[l, r)范围内二分查找块列x的位置，未找到时返回最大值
+             */
+            inline IndexType BinarySearch(IndexType l, IndexType r, const IndexType x) const{
+                const IndexType row_end = r;
+                while(l < r){
+                    const IndexType m = l + (r - l) / 2;
+                    if(mBlockColIndices[m] < x){
+                        l = m + 1;
+                    } else {
+                        r = m;
+                    }
+                }
+                return (l < row_end && mBlockColIndices[l] == x) ? l : std::numeric_limits<IndexType>::max();
+            }
+
+        private:
+            /**
+             * @brief 计算第ib个块行与x的乘积，结果写入y_local
+             */
+            template<typename TInputVectorType>
+            inline void BlockRowProduct(const IndexType ib, const TInputVectorType& x, TDataType* y_local) const{
+                for(IndexType r=0; r<BlockSize; ++r){
+                    y_local[r] = TDataType();
+                }
+                for(IndexType k=mBlockRowIndices[ib]; k<mBlockRowIndices[ib+1]; ++k){
+                    const TDataType* p_block = GetBlock(k);
+                    const IndexType col = mBlockColIndices[k]*BlockSize;
+                    TDataType x_local[TBlockSize];
+                    for(IndexType c=0; c<BlockSize; ++c){
+                        x_local[c] = x(col + c);
+                    }
+                    for(IndexType r=0; r<BlockSize; ++r){
+                        for(IndexType c=0; c<BlockSize; ++c){
+                            y_local[r] += p_block[r*BlockSize + c] * x_local[c];
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief 计算 y += alpha*AT*x
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void BlockTransposeProduct(const TDataType alpha, const TInputVectorType& x, TOutputVectorType& y) const{
+                if(nnz() == 0){
+                    return;
+                }
+                IndexPartition<IndexType>(NumberOfBlockRows()).for_each([&](IndexType ib){
+                    const IndexType row = ib*BlockSize;
+                    TDataType x_local[TBlockSize];
+                    for(IndexType r=0; r<BlockSize; ++r){
+                        x_local[r] = alpha * x(row + r);
+                    }
+                    for(IndexType k=mBlockRowIndices[ib]; k<mBlockRowIndices[ib+1]; ++k){
+                        const TDataType* p_block = GetBlock(k);
+                        const IndexType col = mBlockColIndices[k]*BlockSize;
+                        TDataType y_local[TBlockSize];
+                        for(IndexType c=0; c<BlockSize; ++c){
+                            y_local[c] = TDataType();
+                        }
+                        for(IndexType r=0; r<BlockSize; ++r){
+                            for(IndexType c=0; c<BlockSize; ++c){
+                                y_local[c] += p_block[r*BlockSize + c] * x_local[r];
+                            }
+                        }
+                        for(IndexType c=0; c<BlockSize; ++c){
+                            AtomicAdd(y(col + c), y_local[c]);
+                        }
+                    }
+                });
+            }
+
+            /**
+             * @brief 基于标量方程编号组装局部矩阵的实现
+             * @tparam TUseAtomicAdd 是否使用原子加法
+             */
+            template<bool TUseAtomicAdd, typename TMatrixType, typename TIndexVectorType>
+            void AssembleLocalMatrix(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& EquationId
+            ){
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size1() != EquationId.size()) << "sizes of matrix and equation id do not match in Assemble" << std::endl;
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size2() != EquationId.size()) << "sizes of matrix and equation id do not match in Assemble" << std::endl;
+
+                const unsigned int local_size = rMatrixInput.size1();
+
+                for(unsigned int i_local = 0; i_local < local_size; ++i_local){
+                    const IndexType I = EquationId[i_local];
+                    const IndexType block_i = I / BlockSize;
+                    const IndexType r = I % BlockSize;
+                    const IndexType row_begin = mBlockRowIndices[block_i];
+                    const IndexType row_end = mBlockRowIndices[block_i+1];
+
+                    IndexType last_block_j = std::numeric_limits<IndexType>::max();
+                    IndexType k = row_begin;
+
+                    for(unsigned int j_local = 0; j_local < local_size; ++j_local){
+                        const IndexType J = EquationId[j_local];
+                        const IndexType block_j = J / BlockSize;
+
+                        if(block_j != last_block_j){
+                            if(k+1 < row_end && mBlockColIndices[k+1] == block_j){
+                                k = k+1;
+                            } else {
+                                k = BinarySearch(row_begin, row_end, block_j);
+                            }
+                            QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << I << " " << J << " not found in matrix" << std::endl;
+                            last_block_j = block_j;
+                        }
+
+                        AddValue<TUseAtomicAdd>(mValues[k*BlockEntries + r*BlockSize + J % BlockSize], rMatrixInput(i_local, j_local));
+                    }
+                }
+            }
+
+            /**
+             * @brief 按节点编号逐块组装局部矩阵的实现
+             * @tparam TUseAtomicAdd 是否使用原子加法
+             */
+            template<bool TUseAtomicAdd, typename TMatrixType, typename TIndexVectorType>
+            void AssembleLocalBlocks(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& NodeIds
+            ){
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size1() != NodeIds.size()*BlockSize) << "sizes of matrix and node ids do not match in AssembleBlocks" << std::endl;
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size2() != NodeIds.size()*BlockSize) << "sizes of matrix and node ids do not match in AssembleBlocks" << std::endl;
+
+                const unsigned int number_of_nodes = NodeIds.size();
+
+                for(unsigned int a = 0; a < number_of_nodes; ++a){
+                    const IndexType block_i = NodeIds[a];
+                    const IndexType row_begin = mBlockRowIndices[block_i];
+                    const IndexType row_end = mBlockRowIndices[block_i+1];
+
+                    for(unsigned int b = 0; b < number_of_nodes; ++b){
+                        const IndexType k = BinarySearch(row_begin, row_end, NodeIds[b]);
+                        QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "block indices I,J : " << block_i << " " << NodeIds[b] << " not found in matrix" << std::endl;
+
+                        TDataType* p_block = GetBlock(k);
+                        for(IndexType r=0; r<BlockSize; ++r){
+                            for(IndexType c=0; c<BlockSize; ++c){
+                                AddValue<TUseAtomicAdd>(p_block[r*BlockSize + c], rMatrixInput(a*BlockSize + r, b*BlockSize + c));
+                            }
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief 以部分选主元的Gauss-Jordan消元计算块的逆
+             * @return 块是否可逆
+             */
+            static bool InvertBlock(const TDataType* pBlock, TDataType* pInverse){
+                TDataType work[BlockEntries];
+                for(IndexType e=0; e<BlockEntries; ++e){
+                    work[e] = pBlock[e];
+                    pInverse[e] = TDataType();
+                }
+                for(IndexType r=0; r<BlockSize; ++r){
+                    pInverse[r*BlockSize + r] = TDataType(1);
+                }
+
+                for(IndexType c=0; c<BlockSize; ++c){
+                    IndexType pivot = c;
+                    for(IndexType r=c+1; r<BlockSize; ++r){
+                        if(std::abs(work[r*BlockSize + c]) > std::abs(work[pivot*BlockSize + c])){
+                            pivot = r;
+                        }
+                    }
+                    if(work[pivot*BlockSize + c] == TDataType()){
+                        return false;
+                    }
+                    if(pivot != c){
+                        for(IndexType j=0; j<BlockSize; ++j){
+                            std::swap(work[c*BlockSize + j], work[pivot*BlockSize + j]);
+                            std::swap(pInverse[c*BlockSize + j], pInverse[pivot*BlockSize + j]);
+                        }
+                    }
+
+                    const TDataType inv_pivot = TDataType(1) / work[c*BlockSize + c];
+                    for(IndexType j=0; j<BlockSize; ++j){
+                        work[c*BlockSize + j] *= inv_pivot;
+                        pInverse[c*BlockSize + j] *= inv_pivot;
+                    }
+
+                    for(IndexType r=0; r<BlockSize; ++r){
+                        if(r == c){
+                            continue;
+                        }
+                        const TDataType factor = work[r*BlockSize + c];
+                        if(factor != TDataType()){
+                            for(IndexType j=0; j<BlockSize; ++j){
+                                work[r*BlockSize + j] -= factor * work[c*BlockSize + j];
+                                pInverse[r*BlockSize + j] -= factor * pInverse[c*BlockSize + j];
+                            }
+                        }
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief 将Value累加到rTarget上
+             * @tparam TUseAtomicAdd 是否使用原子加法
+             */
+            template<bool TUseAtomicAdd>
+            static inline void AddValue(TDataType& rTarget, const TDataType Value){
+                if constexpr (TUseAtomicAdd){
+                    AtomicAdd(rTarget, Value);
+                } else {
+                    rTarget += Value;
+                }
+            }
+
+            friend class Serializer;
+
+
+            void save(Serializer& rSerializer) const{
+                rSerializer.save("BlockRowIndices", mBlockRowIndices);
+                rSerializer.save("BlockColIndices", mBlockColIndices);
+                rSerializer.save("Values", mValues);
+                rSerializer.save("NumberOfBlockCols", mNumberOfBlockCols);
+            }
+
+
+            void load(Serializer& rSerializer){
+                rSerializer.load("BlockRowIndices", mBlockRowIndices);
+                rSerializer.load("BlockColIndices", mBlockColIndices);
+                rSerializer.load("Values", mValues);
+                rSerializer.load("NumberOfBlockCols", mNumberOfBlockCols);
+            }
+
+        private:
+            /**
+             * @brief 数据通讯器指针
+             */
+            const DataCommunicator* mpComm;
+
+            /**
+             * @brief 块行索引数组（大小为块行数+1）
+             */
+            IndexVectorType mBlockRowIndices;
+
+            /**
+             * @brief 块列索引数组，每个非零块一个
+             */
+            IndexVectorType mBlockColIndices;
+
+            /**
+             * @brief 值数组，非零块依次存放，块内行优先
+             */
+            ValueVectorType mValues;
+
+            /**
+             * @brief 矩阵的块列数
+             */
+            IndexType mNumberOfBlockCols = 0;
+
+    };
+
+
+    template<std::size_t TBlockSize, typename TDataType, typename TIndexType>
+    inline std::istream& operator >> (std::istream& rIstream, BlockCsrMatrix<TBlockSize, TDataType, TIndexType>& rThis){
+        return rIstream;
+    }
+
+
+    template<std::size_t TBlockSize, typename TDataType, typename TIndexType>
+    inline std::ostream& operator << (std::ostream& rOstream, const BlockCsrMatrix<TBlockSize, TDataType, TIndexType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_BLOCK_CSR_MATRIX_HPP
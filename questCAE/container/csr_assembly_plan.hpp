@@ -0,0 +1,287 @@
+/*---------------------------------------------
+CSR矩阵组装计划
+缓存每个实体的局部矩阵在CSR值数组中的散射位置
+----------------------------------------------*/
+
+#ifndef QUEST_CSR_ASSEMBLY_PLAN_HPP
+#define QUEST_CSR_ASSEMBLY_PLAN_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+// 第三方头文件
+#include "span/span.hpp"
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class CsrAssemblyPlan
+     * @brief CSR矩阵的组装计划
+     * @details 对给定的稀疏模式与实体（单元/条件）方程编号，一次性求出每个实体的局部矩阵
+     *  （按行优先展开）在CSR值数组中对应的偏移量。只要稀疏模式和实体的方程编号不变，
+     *  后续的组装即可退化为纯粹的按下标累加，不再需要逐行二分查找。
+     *  计划只记录偏移量，不持有矩阵，可同时用于 CsrMatrix 与其他提供
+     *  index1_data()/index2_data() 接口的CSR矩阵
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TIndexType = std::size_t>
+    class CsrAssemblyPlan final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(CsrAssemblyPlan);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrAssemblyPlan(){}
+
+            /**
+             * @brief 构造函数，直接构建组装计划
+             */
+            template<typename TMatrixType, typename TFunctionType>
+            CsrAssemblyPlan(
+                const TMatrixType& rMatrix,
+                const IndexType NumberOfEntities,
+                TFunctionType&& rGetEntityIndices
+            ){
+                Build(rMatrix, NumberOfEntities, std::forward<TFunctionType>(rGetEntityIndices));
+            }
+
+            /**
+             * @brief 析构函数
+             */
+            ~CsrAssemblyPlan(){}
+
+            /**
+             * @brief 构建组装计划
+             * @details rGetEntityIndices(i, rIndices) 需把第 i 个实体的方程编号写入 rIndices，
+             *  该函数可能被多个线程同时调用。第一遍统计每个实体的局部尺寸，第二遍并行地查找偏移量
+             * @param rMatrix 已确定稀疏模式的CSR矩阵
+             * @param NumberOfEntities 实体个数
+             * @param rGetEntityIndices 获取实体方程编号的函数
+             */
+            template<typename TMatrixType, typename TFunctionType>
+            void Build(
+                const TMatrixType& rMatrix,
+                const IndexType NumberOfEntities,
+                TFunctionType&& rGetEntityIndices
+            ){
+                const auto& r_row_indices = rMatrix.index1_data();
+                const auto& r_col_indices = rMatrix.index2_data();
+
+                mEntityOffsets.resize(NumberOfEntities+1);
+                mEntityOffsets[0] = 0;
+
+                IndexPartition<IndexType>(NumberOfEntities).for_each(IndexVectorType(), [&](IndexType i, IndexVectorType& rIndices){
+                    rIndices.clear();
+                    rGetEntityIndices(i, rIndices);
+                    mEntityOffsets[i+1] = rIndices.size() * rIndices.size();
+                });
+
+                for(IndexType i=0; i<NumberOfEntities; ++i){
+                    mEntityOffsets[i+1] += mEntityOffsets[i];
+                }
+
+                mValueOffsets.resize(mEntityOffsets[NumberOfEntities]);
+
+                // 并行区内不抛出异常：记录第一个含有模式外元素的实体，循环结束后再报错
+                constexpr IndexType not_found = std::numeric_limits<IndexType>::max();
+                const IndexType first_invalid_entity = IndexPartition<IndexType>(NumberOfEntities).template for_each<Internals::MinReduction<IndexType>>(IndexVectorType(), [&](IndexType i, IndexVectorType& rIndices){
+                    rIndices.clear();
+                    rGetEntityIndices(i, rIndices);
+
+                    const IndexType local_size = rIndices.size();
+                    IndexType* p_offsets = mValueOffsets.data() + mEntityOffsets[i];
+
+                    for(IndexType i_local=0; i_local<local_size; ++i_local){
+                        const IndexType I = rIndices[i_local];
+                        const IndexType row_begin = r_row_indices[I];
+                        const IndexType row_end = r_row_indices[I+1];
+
+                        for(IndexType j_local=0; j_local<local_size; ++j_local){
+                            const IndexType k = FindPosition(r_col_indices, row_begin, row_end, rIndices[j_local]);
+                            if(k == not_found){
+                                return i;
+                            }
+                            p_offsets[i_local*local_size + j_local] = k;
+                        }
+                    }
+                    return not_found;
+                });
+
+                if(first_invalid_entity != not_found){
+                    IndexVectorType indices;
+                    rGetEntityIndices(first_invalid_entity, indices);
+                    Clear();
+                    for(const IndexType I : indices){
+                        for(const IndexType J : indices){
+                            QUEST_ERROR_IF(FindPosition(r_col_indices, r_row_indices[I], r_row_indices[I+1], J) == not_found) << "Entry (" << I << "," << J
+                                << ") of entity " << first_invalid_entity << " is not in the sparsity pattern of the matrix" << std::endl;
+                        }
+                    }
+                }
+
+                mNumberOfRows = rMatrix.size1();
+                mNumberOfNonZeros = r_row_indices[mNumberOfRows];
+                mPatternHash = PatternHash(rMatrix);
+            }
+
+            /**
+             * @brief 判断计划是否与矩阵的稀疏模式匹配
+             * @details 比较行数、非零元个数与索引数组的散列，稀疏模式被重建或修改后返回 false
+             */
+            template<typename TMatrixType>
+            bool IsBuiltFor(const TMatrixType& rMatrix) const{
+                return !mEntityOffsets.empty()
+                    && mNumberOfRows == rMatrix.size1()
+                    && mNumberOfNonZeros == static_cast<IndexType>(rMatrix.index1_data()[mNumberOfRows])
+                    && mPatternHash == PatternHash(rMatrix);
+            }
+
+            /**
+             * @brief 返回计划包含的实体个数
+             */
+            IndexType NumberOfEntities() const{
+                return mEntityOffsets.empty() ? 0 : mEntityOffsets.size()-1;
+            }
+
+            /**
+             * @brief 返回第 i 个实体的局部矩阵（行优先展开）在值数组中的偏移量
+             */
+            Quest::span<const IndexType> GetEntityOffsets(const IndexType i) const{
+                QUEST_DEBUG_ERROR_IF(i >= NumberOfEntities()) << "Entity index " << i << " exceeds the number of entities in the plan " << NumberOfEntities() << std::endl;
+                return Quest::span<const IndexType>(mValueOffsets.data() + mEntityOffsets[i], mEntityOffsets[i+1] - mEntityOffsets[i]);
+            }
+
+            /**
+             * @brief 清空组装计划
+             */
+            void Clear(){
+                IndexVectorType().swap(mEntityOffsets);
+                IndexVectorType().swap(mValueOffsets);
+                mNumberOfRows = 0;
+                mNumberOfNonZeros = 0;
+                mPatternHash = 0;
+            }
+
+
+            std::string Info() const{
+                std::stringstream buffer;
+                buffer << "CsrAssemblyPlan";
+                return buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrAssemblyPlan";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of entities : " << NumberOfEntities() << " number of offsets : " << mValueOffsets.size() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 稀疏模式的 64 位 FNV-1a 散列
+             */
+            template<typename TMatrixType>
+            static std::uint64_t PatternHash(const TMatrixType& rMatrix){
+                const IndexType size = rMatrix.size1();
+                const auto& r_row_indices = rMatrix.index1_data();
+                const auto& r_col_indices = rMatrix.index2_data();
+
+                std::uint64_t hash = 14695981039346656037ULL;
+                auto mix = [&hash](const std::uint64_t Value){
+                    hash ^= Value;
+                    hash *= 1099511628211ULL;
+                };
+                for(IndexType i=0; i<=size; ++i){
+                    mix(static_cast<std::uint64_t>(r_row_indices[i]));
+                }
+                const IndexType nnz = r_row_indices[size];
+                for(IndexType k=0; k<nnz; ++k){
+                    mix(static_cast<std::uint64_t>(r_col_indices[k]));
+                }
+                return hash;
+            }
+
+            /**
+             * @brief 在[RowBegin, RowEnd)范围内二分查找列索引J的位置，未找到时返回最大值
+             */
+            template<typename TVectorType>
+            static IndexType FindPosition(const TVectorType& rColIndices, const IndexType RowBegin, const IndexType RowEnd, const IndexType J){
+                IndexType l = RowBegin;
+                IndexType r = RowEnd;
+                while(l < r){
+                    const IndexType m = l + (r - l) / 2;
+                    if(static_cast<IndexType>(rColIndices[m]) < J){
+                        l = m + 1;
+                    } else {
+                        r = m;
+                    }
+                }
+                return (l < RowEnd && static_cast<IndexType>(rColIndices[l]) == J) ? l : std::numeric_limits<IndexType>::max();
+            }
+
+        private:
+            /**
+             * @brief 每个实体的偏移量在 mValueOffsets 中的起始位置（大小为实体数+1）
+             */
+            IndexVectorType mEntityOffsets;
+
+            /**
+             * @brief 所有实体的值数组偏移量，按实体依次存放
+             */
+            IndexVectorType mValueOffsets;
+
+            /**
+             * @brief 构建计划时矩阵的行数
+             */
+            IndexType mNumberOfRows = 0;
+
+            /**
+             * @brief 构建计划时矩阵的非零元个数
+             */
+            IndexType mNumberOfNonZeros = 0;
+
+            /**
+             * @brief 构建计划时稀疏模式的散列
+             */
+            std::uint64_t mPatternHash = 0;
+
+    };
+
+
+    template<typename TIndexType=std::size_t>
+    inline std::istream& operator >> (std::istream& rIstream, CsrAssemblyPlan<TIndexType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TIndexType=std::size_t>
+    inline std::ostream& operator << (std::ostream& rOstream, const CsrAssemblyPlan<TIndexType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_CSR_ASSEMBLY_PLAN_HPP
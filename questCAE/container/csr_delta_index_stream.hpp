@@ -0,0 +1,319 @@
+/*---------------------------------------------
+CSR矩阵列索引的差分变长编码
+矩阵向量乘时逐行即时解码，以减少列索引的内存流量
+----------------------------------------------*/
+
+#ifndef QUEST_CSR_DELTA_INDEX_STREAM_HPP
+#define QUEST_CSR_DELTA_INDEX_STREAM_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/csr_spmv_kernels.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class CsrDeltaIndexStream
+     * @brief CSR矩阵列索引的差分变长编码流
+     * @details 每行的列索引依次编码为与前一个列号的差（首个条目与行号作差），差值经 zigzag 映射为无符号数后
+     *  按 LEB128 变长编码：每字节低7位为数据，最高位表示后面还有字节。
+     *  编号良好的有限元矩阵中同一行的相邻列号相差很小，绝大多数条目只需1字节，而 std::size_t 列索引需要8字节。
+     *  编码只依赖稀疏模式，数值仍从CSR的值数组中按偏移量读取，因此数值修改后无需重建。
+     *  长行（见 CsrSpMVSchedule）需要切分到多个线程，而变长编码无法从行中间开始解码，这些行仍读取未压缩的列索引
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TIndexType = std::size_t>
+    class CsrDeltaIndexStream final{
+        public:
+            using IndexType = TIndexType;
+            using ByteVectorType = std::vector<std::uint8_t>;
+            using OffsetVectorType = std::vector<std::size_t>;
+            using ScheduleType = CsrSpMVSchedule<TIndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(CsrDeltaIndexStream);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrDeltaIndexStream(){}
+
+            /**
+             * @brief 构造函数，直接对矩阵的列索引编码
+             */
+            template<typename TMatrixType>
+            explicit CsrDeltaIndexStream(const TMatrixType& rMatrix){
+                Build(rMatrix);
+            }
+
+            /**
+             * @brief 析构函数
+             */
+            ~CsrDeltaIndexStream(){}
+
+            /**
+             * @brief 对CSR矩阵的列索引编码
+             * @details 第一遍并行统计每行编码后的字节数，前缀和得到各行的起始位置，第二遍并行写入
+             */
+            template<typename TMatrixType>
+            void Build(const TMatrixType& rMatrix){
+                const auto& r_row_indices = rMatrix.index1_data();
+                const auto& r_col_indices = rMatrix.index2_data();
+                const IndexType nrows = rMatrix.size1();
+
+                mRowOffsets.resize(nrows+1);
+                mRowOffsets[0] = 0;
+                IndexPartition<IndexType>(nrows).for_each([&](IndexType i){
+                    std::size_t row_bytes = 0;
+                    IndexType previous = i;
+                    for(IndexType k=r_row_indices[i]; k<r_row_indices[i+1]; ++k){
+                        row_bytes += EncodedSize(ZigZag(previous, r_col_indices[k]));
+                        previous = r_col_indices[k];
+                    }
+                    mRowOffsets[i+1] = row_bytes;
+                });
+                for(IndexType i=0; i<nrows; ++i){
+                    mRowOffsets[i+1] += mRowOffsets[i];
+                }
+
+                mBytes.resize(mRowOffsets[nrows]);
+                IndexPartition<IndexType>(nrows).for_each([&](IndexType i){
+                    std::uint8_t* p_byte = mBytes.data() + mRowOffsets[i];
+                    IndexType previous = i;
+                    for(IndexType k=r_row_indices[i]; k<r_row_indices[i+1]; ++k){
+                        p_byte = Encode(ZigZag(previous, r_col_indices[k]), p_byte);
+                        previous = r_col_indices[k];
+                    }
+                });
+
+                mpSourceRowIndices = r_row_indices.data();
+                mNumberOfRows = nrows;
+                mNumberOfNonZeros = r_col_indices.size();
+                mIsBuilt = true;
+            }
+
+            /**
+             * @brief 判断编码流是否与矩阵的稀疏模式匹配
+             * @details 比较行索引数组地址、行数与非零元个数，列索引原地修改后应调用 Clear()
+             */
+            template<typename TMatrixType>
+            bool IsBuiltFor(const TMatrixType& rMatrix) const{
+                return mIsBuilt
+                    && mpSourceRowIndices == rMatrix.index1_data().data()
+                    && mNumberOfRows == rMatrix.size1()
+                    && mNumberOfNonZeros == rMatrix.index2_data().size();
+            }
+
+            /**
+             * @brief 清空编码流
+             */
+            void Clear(){
+                ByteVectorType().swap(mBytes);
+                OffsetVectorType().swap(mRowOffsets);
+                mpSourceRowIndices = nullptr;
+                mNumberOfRows = 0;
+                mNumberOfNonZeros = 0;
+                mIsBuilt = false;
+            }
+
+            /**
+             * @brief 解码第 i 行的列索引并写入 pCols
+             */
+            void DecodeRow(const IndexType i, IndexType* pCols) const{
+                const std::uint8_t* p_byte = mBytes.data() + mRowOffsets[i];
+                const std::uint8_t* p_end = mBytes.data() + mRowOffsets[i+1];
+                IndexType col = i;
+                while(p_byte != p_end){
+                    col = NextColumn(p_byte, col);
+                    *pCols++ = col;
+                }
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y，列索引由编码流即时解码
+             * @param rSchedule 行调度
+             * @param pRowIndices 行索引数组
+             * @param pColIndices 未压缩的列索引数组，仅用于长行
+             * @param pValues 值数组
+             * @details beta 为零时不读取 y
+             */
+            template<typename TDataType>
+            void SpMV(
+                const ScheduleType& rSchedule,
+                const IndexType* pRowIndices,
+                const IndexType* pColIndices,
+                const TDataType* pValues,
+                const TDataType alpha,
+                const TDataType* pX,
+                const TDataType beta,
+                TDataType* pY
+            ) const {
+                IndexPartition<IndexType>(rSchedule.NumberOfChunks()).for_each([&](IndexType c){
+                    for(IndexType i=rSchedule.ChunkRowBegin(c); i<rSchedule.ChunkRowEnd(c); ++i){
+                        const std::uint8_t* p_byte = mBytes.data() + mRowOffsets[i];
+                        const TDataType* p_value = pValues + pRowIndices[i];
+                        const TDataType* p_value_end = pValues + pRowIndices[i+1];
+                        IndexType col = i;
+                        TDataType sum0 = TDataType();
+                        TDataType sum1 = TDataType();
+                        for(; p_value+2<=p_value_end; p_value+=2){
+                            col = NextColumn(p_byte, col);
+                            sum0 += p_value[0] * pX[col];
+                            col = NextColumn(p_byte, col);
+                            sum1 += p_value[1] * pX[col];
+                        }
+                        if(p_value != p_value_end){
+                            col = NextColumn(p_byte, col);
+                            sum0 += p_value[0] * pX[col];
+                        }
+                        const TDataType sum = sum0 + sum1;
+                        pY[i] = (beta == TDataType()) ? alpha*sum : alpha*sum + beta*pY[i];
+                    }
+                });
+
+                for(const IndexType i : rSchedule.LongRows()){
+                    const IndexType row_begin = pRowIndices[i];
+                    const IndexType row_nnz = pRowIndices[i+1] - row_begin;
+                    const IndexType chunk_nnz = std::max(rSchedule.ChunkNonZeros(), IndexType(1));
+                    const IndexType num_segments = std::max(IndexType(1), std::min((row_nnz + chunk_nnz - 1)/chunk_nnz, static_cast<IndexType>(ParallelUtilities::GetNumThreads())));
+                    const TDataType sum = IndexPartition<IndexType>(num_segments).template for_each<Internals::SumReduction<TDataType>>([&](IndexType s){
+                        const IndexType k_begin = row_begin + static_cast<IndexType>((static_cast<std::size_t>(row_nnz)*s)/num_segments);
+                        const IndexType k_end = row_begin + static_cast<IndexType>((static_cast<std::size_t>(row_nnz)*(s+1))/num_segments);
+                        TDataType aux = TDataType();
+                        for(IndexType k=k_begin; k<k_end; ++k){
+                            aux += pValues[k] * pX[pColIndices[k]];
+                        }
+                        return aux;
+                    });
+                    pY[i] = (beta == TDataType()) ? alpha*sum : alpha*sum + beta*pY[i];
+                }
+            }
+
+            /**
+             * @brief 返回编码流的字节数（不含行偏移数组）
+             */
+            std::size_t StreamBytes() const{
+                return mBytes.size();
+            }
+
+            /**
+             * @brief 返回平均每个非零元的字节数
+             */
+            double BytesPerNonZero() const{
+                return mNumberOfNonZeros == 0 ? 0.0 : static_cast<double>(mBytes.size())/static_cast<double>(mNumberOfNonZeros);
+            }
+
+
+            std::string Info() const{
+                return "CsrDeltaIndexStream";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrDeltaIndexStream";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of rows : " << mNumberOfRows << " nnz : " << mNumberOfNonZeros
+                    << " stream bytes : " << StreamBytes() << " bytes per non zero : " << BytesPerNonZero() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 把列号差 Current-Previous 映射为无符号数：0,-1,1,-2,... 依次映射为 0,1,2,3,...
+             */
+            static std::uint64_t ZigZag(const IndexType Previous, const IndexType Current){
+                const std::int64_t delta = static_cast<std::int64_t>(Current) - static_cast<std::int64_t>(Previous);
+                return (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+            }
+
+            /**
+             * @brief 返回无符号数编码后的字节数
+             */
+            static std::size_t EncodedSize(std::uint64_t Value){
+                std::size_t size = 1;
+                while(Value >= 0x80u){
+                    Value >>= 7;
+                    ++size;
+                }
+                return size;
+            }
+
+            /**
+             * @brief 编码一个无符号数，返回写入后的位置
+             */
+            static std::uint8_t* Encode(std::uint64_t Value, std::uint8_t* pByte){
+                while(Value >= 0x80u){
+                    *pByte++ = static_cast<std::uint8_t>(Value | 0x80u);
+                    Value >>= 7;
+                }
+                *pByte++ = static_cast<std::uint8_t>(Value);
+                return pByte;
+            }
+
+            /**
+             * @brief 解码下一个条目并返回其列号，单字节编码走无循环的快速路径
+             */
+            static inline IndexType NextColumn(const std::uint8_t*& rpByte, const IndexType Previous){
+                std::uint64_t value = *rpByte++;
+                if(value >= 0x80u){
+                    value &= 0x7fu;
+                    unsigned int shift = 7;
+                    std::uint64_t byte;
+                    do{
+                        byte = *rpByte++;
+                        value |= (byte & 0x7fu) << shift;
+                        shift += 7;
+                    } while(byte >= 0x80u);
+                }
+                const std::int64_t delta = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1u);
+                return static_cast<IndexType>(static_cast<std::int64_t>(Previous) + delta);
+            }
+
+        private:
+            /**
+             * @brief 编码后的字节流
+             */
+            ByteVectorType mBytes;
+
+            /**
+             * @brief 每行在字节流中的起始位置（大小为行数+1）
+             */
+            OffsetVectorType mRowOffsets;
+
+            /**
+             * @brief 构建时矩阵行索引数组的地址
+             */
+            const IndexType* mpSourceRowIndices = nullptr;
+
+            /**
+             * @brief 行数
+             */
+            IndexType mNumberOfRows = 0;
+
+            /**
+             * @brief 非零元个数
+             */
+            IndexType mNumberOfNonZeros = 0;
+
+            /**
+             * @brief 是否已构建
+             */
+            bool mIsBuilt = false;
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_CSR_DELTA_INDEX_STREAM_HPP
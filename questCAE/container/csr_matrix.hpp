@@ -6,8 +6,11 @@
 #define QUEST_CSR_MATRIX_HPP
 
 // 系统头文件
+#include <atomic>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <type_traits>
 
 // 第三方头文件
 #include "span/span.hpp"
@@ -16,6 +19,11 @@
 #include "includes/define.hpp"
 #include "container/sparse_contiguous_row_graph.hpp"
 #include "container/system_vector.hpp"
+#include "container/csr_assembly_plan.hpp"
+#include "container/csr_spmv_kernels.hpp"
+#include "container/csr_transpose_structure.hpp"
+#include "container/sell_c_sigma_matrix.hpp"
+#include "container/csr_delta_index_stream.hpp"
 #include "utilities/parallel_utilities.hpp"
 #include "utilities/atomic_utilities.hpp"
 #include "utilities/reduction_utilities.hpp"
@@ -40,6 +48,11 @@ namespace Quest{
                 PairHasher<IndexType, IndexType>,
                 PairComparor<IndexType, IndexType>
             >;
+            using SpMVKernelsType = CsrSpMVKernels<TDataType, TIndexType>;
+            using SpMVScheduleType = CsrSpMVSchedule<TIndexType>;
+            using SellCSigmaMatrixType = SellCSigmaMatrix<TDataType, TIndexType>;
+            using TransposeStructureType = CsrTransposeStructure<TIndexType>;
+            using DeltaIndexStreamType = CsrDeltaIndexStream<TIndexType>;
 
             QUEST_CLASS_POINTER_DEFINITION(CsrMatrix);
 
@@ -75,7 +88,7 @@ namespace Quest{
 
                 mNrows = size1();
 
-                ComputeSolSize();
+                ComputeColSize();
 
                 ResizeValueData(mColIndices.size());
                 SetValue(0.0);
@@ -128,10 +141,45 @@ namespace Quest{
                 });
             }
 
+            /**
+             * @brief 构造函数，由索引类型不同的CSR矩阵转换
+             * @details 例如把以 std::size_t 索引组装的矩阵转换为32位索引，使每个非零元的索引由8字节减为4字节。
+             *  行数、列数或非零元个数超出 TIndexType 对应有符号类型的表示范围时抛出异常
+             */
+            template<typename TOtherIndexType, typename = std::enable_if_t<!std::is_same<TOtherIndexType, TIndexType>::value>>
+            explicit CsrMatrix(const CsrMatrix<TDataType, TOtherIndexType>& rOtherMatrix){
+                // SIMD收集指令把索引视为有符号数，因此以有符号类型的最大值为界
+                constexpr std::size_t max_index = static_cast<std::size_t>(std::numeric_limits<std::make_signed_t<IndexType>>::max());
+                QUEST_ERROR_IF(static_cast<std::size_t>(rOtherMatrix.nnz()) > max_index) << "the number of nonzeros " << rOtherMatrix.nnz() << " cannot be represented by the index type" << std::endl;
+                QUEST_ERROR_IF(static_cast<std::size_t>(rOtherMatrix.size1()) >= max_index || static_cast<std::size_t>(rOtherMatrix.size2()) > max_index)
+                    << "the matrix sizes " << rOtherMatrix.size1() << " " << rOtherMatrix.size2() << " cannot be represented by the index type" << std::endl;
+
+                mpComm = rOtherMatrix.pGetComm();
+                ResizeIndex1Data(rOtherMatrix.index1_data().size());
+                ResizeIndex2Data(rOtherMatrix.index2_data().size());
+                ResizeValueData(rOtherMatrix.value_data().size());
+
+                mNrows = static_cast<IndexType>(rOtherMatrix.size1());
+                mNcols = static_cast<IndexType>(rOtherMatrix.size2());
+
+                IndexPartition<IndexType>(mRowIndices.size()).for_each([&](IndexType i){
+                    mRowIndices[i] = static_cast<IndexType>(rOtherMatrix.index1_data()[i]);
+                });
+
+                IndexPartition<IndexType>(mColIndices.size()).for_each([&](IndexType i){
+                    mColIndices[i] = static_cast<IndexType>(rOtherMatrix.index2_data()[i]);
+                });
+
+                IndexPartition<IndexType>(mValuesVector.size()).for_each([&](IndexType i){
+                    mValuesVector[i] = rOtherMatrix.value_data()[i];
+                });
+            }
+
             /**
              * @brief 移动构造函数
              */
             CsrMatrix(CsrMatrix<TDataType, TIndexType>&& rOtherMatrix){
+                mpComm = rOtherMatrix.mpComm;
                 mIsOwnerOfData = rOtherMatrix.mIsOwnerOfData;
                 rOtherMatrix.mIsOwnerOfData = false;
 
@@ -145,6 +193,12 @@ namespace Quest{
 
                 mNrows = rOtherMatrix.mNrows;
                 mNcols = rOtherMatrix.mNcols;
+
+                mpSellCSigma = std::move(rOtherMatrix.mpSellCSigma);
+                mSellCSigmaValuesAreStale.store(rOtherMatrix.mSellCSigmaValuesAreStale.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                mSellChunkHeight = rOtherMatrix.mSellChunkHeight;
+                mSellSigma = rOtherMatrix.mSellSigma;
+                mUseCompressedIndices = rOtherMatrix.mUseCompressedIndices;
             }
 
             /**
@@ -180,6 +234,13 @@ namespace Quest{
                 mNrows = rOtherMatrix.mNrows;
                 mNcols = rOtherMatrix.mNcols;
 
+                ClearStructureCaches();
+                mpSellCSigma = std::move(rOtherMatrix.mpSellCSigma);
+                mSellCSigmaValuesAreStale.store(rOtherMatrix.mSellCSigmaValuesAreStale.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                mSellChunkHeight = rOtherMatrix.mSellChunkHeight;
+                mSellSigma = rOtherMatrix.mSellSigma;
+                mUseCompressedIndices = rOtherMatrix.mUseCompressedIndices;
+
                 return *this;
             }
 
@@ -192,6 +253,7 @@ namespace Quest{
                 AssignValueData(nullptr,0);
                 mNrows = 0;
                 mNcols = 0;
+                ClearStructureCaches();
             }
 
             /**
@@ -215,6 +277,9 @@ namespace Quest{
                 IndexPartition<IndexType>(mValuesVector.size()).for_each([&](IndexType i){
                     mValuesVector[i] = value;
                 });
+                if(mpSellCSigma && mpSellCSigma->IsBuiltFor(*this)){
+                    mpSellCSigma->SetValue(value);
+                }
             }
 
             /**
@@ -268,8 +333,10 @@ namespace Quest{
 
             /**
              * @brief 返回值数组的span封装
+             * @details 非常量访问把 SELL-C-σ 副本的数值标记为过期，下次 SpMV 前重新同步
              */
             inline Quest::span<TDataType>& value_data(){
+                MarkSellCSigmaValuesStale();
                 return mValuesVector;
             }
 
@@ -327,6 +394,7 @@ namespace Quest{
                     delete [] mpRowIndicesData;
                 }
                 mpRowIndicesData = pExternalData;
+                ClearStructureCaches();
                 if(DataSize != 0){
                     mRowIndices = Quest::span<IndexType>(mpRowIndicesData, DataSize);
                 } else {
@@ -342,6 +410,7 @@ namespace Quest{
                     delete [] mpColIndicesData;
                 }
                 mpColIndicesData = pExternalData;
+                ClearStructureCaches();
                 if(DataSize != 0){
                     mColIndices = Quest::span<IndexType>(mpColIndicesData, DataSize);
                 } else {
@@ -362,6 +431,7 @@ namespace Quest{
                 } else {
                     mValuesVector = Quest::span<TDataType>();
                 }
+                MarkSellCSigmaValuesStale();
             }
 
             /**
@@ -373,6 +443,7 @@ namespace Quest{
                     delete [] mpRowIndicesData;
                 }
                 mpRowIndicesData = new IndexType[DataSize];
+                ClearStructureCaches();
                 mRowIndices = Quest::span<IndexType>(mpRowIndicesData, DataSize);
             }
 
@@ -385,6 +456,7 @@ namespace Quest{
                     delete [] mpColIndicesData;
                 }
                 mpColIndicesData = new IndexType[DataSize];
+                ClearStructureCaches();
                 mColIndices = Quest::span<IndexType>(mpColIndicesData, DataSize);
             }
 
@@ -398,6 +470,7 @@ namespace Quest{
                 }
                 mpValuesVectorData = new TDataType[DataSize];
                 mValuesVector = Quest::span<TDataType>(mpValuesVectorData, DataSize);
+                MarkSellCSigmaValuesStale();
             }
 
             /**
@@ -416,11 +489,11 @@ namespace Quest{
             /**
              * @brief 函数调用形式的矩阵元素访问
              */
-            TDataType& opeartor()(IndexType i, IndexType j){
+            TDataType& operator()(IndexType i, IndexType j){
                 const IndexType row_begin = index1_data()[i];
                 const IndexType row_end = index1_data()[i+1];
                 IndexType k = BinarySearch(index2_data(), row_begin, row_end, j);
-                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << I << " " << J << " not found in matrix" << std::endl;
+                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << i << " " << j << " not found in matrix" << std::endl;
                 return value_data()[k];
             }
 
@@ -431,7 +504,7 @@ namespace Quest{
                 const IndexType row_begin = index1_data()[i];
                 const IndexType row_end = index1_data()[i+1];
                 IndexType k = BinarySearch(index2_data(), row_begin, row_end, j);
-                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << I << " " << J << " not found in matrix" << std::endl;
+                QUEST_DEBUG_ERROR_IF(k == std::numeric_limits<IndexType>::max()) << "local indices I,J : " << i << " " << j << " not found in matrix" << std::endl;
                 return value_data()[k];
             }
 
@@ -452,7 +525,22 @@ namespace Quest{
             void SpMV(const TInputVectorType& x, TOutputVectorType& y) const{
                 QUEST_ERROR_IF(size1() != y.size()) << "SpMV: mismatch between row sizes : " << size1()  << " and destination vector size " << y.size() << std::endl;
                 QUEST_ERROR_IF(size2() != x.size()) << "SpMV: mismatch between col sizes : " << size2()  << " and input vector size " << x.size() << std::endl;
-                if(nnz() != 0){
+                if constexpr(UseSpMVKernels<TInputVectorType, TOutputVectorType>()){
+                    if(nnz() != 0){
+                        if(UseSellCSigma()){
+                            mpSellCSigma->SpMV(TDataType(1), Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                                TDataType(1), Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                        } else if(mUseCompressedIndices){
+                            GetDeltaIndexStream().SpMV(GetSpMVSchedule(), index1_data().data(), index2_data().data(), value_data().data(),
+                                TDataType(1), Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                                TDataType(1), Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                        } else {
+                            SpMVKernelsType::SpMV(GetSpMVSchedule(), index1_data().data(), index2_data().data(), value_data().data(),
+                                TDataType(1), Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                                TDataType(1), Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                        }
+                    }
+                } else if(nnz() != 0){
                     IndexPartition<IndexType>(size1()).for_each([&](IndexType i){
                         IndexType row_begin = index1_data()[i];
                         IndexType row_end = index1_data()[i+1];
@@ -465,7 +553,7 @@ namespace Quest{
             }
 
             /**
-             * @brief 计算 y = alpha*y + beta*A*x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @brief 计算 y = alpha*A*x + beta*y, 其中A为当前矩阵，x为输入向量，y为输出向量
              */
             template<typename TInputVectorType, typename TOutputVectorType>
             void SpMV(
@@ -476,6 +564,23 @@ namespace Quest{
             ) const {
                 QUEST_ERROR_IF(size1() != y.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and destination vector size " << y.size() << std::endl;
                 QUEST_ERROR_IF(size2() != x.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and input vector size " << x.size() << std::endl;
+                if constexpr(UseSpMVKernels<TInputVectorType, TOutputVectorType>()){
+                    if(size1() != 0){
+                        if(UseSellCSigma()){
+                            mpSellCSigma->SpMV(alpha, Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                                beta, Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                        } else if(mUseCompressedIndices){
+                            GetDeltaIndexStream().SpMV(GetSpMVSchedule(), index1_data().data(), index2_data().data(), value_data().data(),
+                                alpha, Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                                beta, Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                        } else {
+                            SpMVKernelsType::SpMV(GetSpMVSchedule(), index1_data().data(), index2_data().data(), value_data().data(),
+                                alpha, Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                                beta, Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                        }
+                    }
+                    return;
+                }
                 IndexPartition<IndexType>(y.size()).for_each([&](IndexType i){
                     IndexType row_begin = index1_data()[i];
                     IndexType row_end = index1_data()[i+1];
@@ -484,29 +589,32 @@ namespace Quest{
                         IndexType col = index2_data()[k];
                         aux += value_data()[k] * x(col);
                     }
-                    y(i) = alpha * aux + beta * y(i);
+                    y(i) = (beta == TDataType()) ? alpha * aux : alpha * aux + beta * y(i);
                 });
             }
 
             /**
-             * @brief 计算 y = AT * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @brief 计算 y += AT * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @details 在缓存的转置结构上逐列归约，不使用原子操作
              */
             template<typename TInputVectorType, typename TOutputVectorType>
             void TransposeSpMV(const TInputVectorType& x, TOutputVectorType& y) const{
                 QUEST_ERROR_IF(size2() != y.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and destination vector size " << y.size() << std::endl;
                 QUEST_ERROR_IF(size1() != x.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and input vector size " << x.size() << std::endl;
-                IndexPartition<IndexType>(size1()).for_each([&](IndexType i){
-                    IndexType row_begin = index1_data()[i];
-                    IndexType row_end = index1_data()[i+1];
-                    for(IndexType k = row_begin; k < row_end; ++k){
-                        IndexType j = index2_data()[k];
-                        AtomicAdd(y(j), value_data()[k] * x(i));
-                    }
-                });
+                if(nnz() == 0){
+                    return;
+                }
+                const auto& r_transpose = GetTransposeStructure();
+                if constexpr(UseSpMVKernels<TInputVectorType, TOutputVectorType>()){
+                    r_transpose.TransposeSpMV(value_data().data(), TDataType(1), Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                        TDataType(1), Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                } else {
+                    r_transpose.TransposeSpMV(value_data(), TDataType(1), x, TDataType(1), y);
+                }
             }
 
             /**
-             * @brief 计算 y = alpha*y + beta * AT * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @brief 计算 y = alpha * AT * x + beta*y, 其中A为当前矩阵，x为输入向量，y为输出向量
              */
             template<typename TInputVectorType, typename TOutputVectorType>
             void TransposeSpMV(
@@ -517,16 +625,136 @@ namespace Quest{
             ) const {
                 QUEST_ERROR_IF(size2() != y.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and destination vector size " << y.size() << std::endl;
                 QUEST_ERROR_IF(size1() != x.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and input vector size " << x.size() << std::endl;
-                y *= beta;
-                IndexPartition<IndexType>(size1()).for_each([&](IndexType i){
-                    IndexType row_begin = index1_data()[i];
-                    IndexType row_end = index1_data()[i+1];
-                    TDataType aux = alpha * x(i);
-                    for(IndexType k = row_begin; k < row_end; ++k){
-                        IndexType j = index2_data()[k];
-                        AtomicAdd(y(j), value_data()[k] * x(i));
-                    }
-                });
+                if(nnz() == 0){
+                    IndexPartition<IndexType>(y.size()).for_each([&](IndexType i){
+                        y(i) = (beta == TDataType()) ? TDataType() : beta * y(i);
+                    });
+                    return;
+                }
+                const auto& r_transpose = GetTransposeStructure();
+                if constexpr(UseSpMVKernels<TInputVectorType, TOutputVectorType>()){
+                    r_transpose.TransposeSpMV(value_data().data(), alpha, Internals::ContiguousVectorData<TInputVectorType>::Data(x),
+                        beta, Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                } else {
+                    r_transpose.TransposeSpMV(value_data(), alpha, x, beta, y);
+                }
+            }
+
+            /**
+             * @brief 返回矩阵向量乘使用的行调度，稀疏模式或线程数变化后自动重建
+             * @details 调度在首次调用时构建，不应在多个线程中同时对同一矩阵首次调用
+             */
+            const SpMVScheduleType& GetSpMVSchedule() const{
+                if(!mSpMVSchedule.IsBuiltFor(*this)){
+                    mSpMVSchedule.Build(index1_data().data(), size1());
+                }
+                return mSpMVSchedule;
+            }
+
+            /**
+             * @brief 返回缓存的转置结构（CSC视图），稀疏模式变化后自动重建
+             * @details 转置结构只记录稀疏模式与值数组的排列，数值修改后无需重建。
+             *  首次调用时构建，不应在多个线程中同时对同一矩阵首次调用
+             */
+            const TransposeStructureType& GetTransposeStructure() const{
+                if(!mTransposeStructure.IsBuiltFor(*this)){
+                    mTransposeStructure.Build(*this);
+                }
+                return mTransposeStructure;
+            }
+
+            /**
+             * @brief 启用列索引的差分变长编码，此后连续存储向量的 SpMV 在编码流上即时解码列索引
+             * @details 编码流只依赖稀疏模式，首次使用或稀疏模式变化时自动重建，数值修改后无需刷新。
+             *  同时启用 SELL-C-σ 副本时优先使用副本
+             */
+            void EnableCompressedIndices(){
+                mUseCompressedIndices = true;
+            }
+
+            /**
+             * @brief 停用列索引编码并释放编码流
+             */
+            void DisableCompressedIndices(){
+                mUseCompressedIndices = false;
+                mDeltaIndexStream.Clear();
+            }
+
+            /**
+             * @brief 判断是否启用了列索引编码
+             */
+            bool IsCompressedIndicesEnabled() const{
+                return mUseCompressedIndices;
+            }
+
+            /**
+             * @brief 返回列索引的编码流，稀疏模式变化后自动重建
+             * @details 首次调用时构建，不应在多个线程中同时对同一矩阵首次调用
+             */
+            const DeltaIndexStreamType& GetDeltaIndexStream() const{
+                if(!mDeltaIndexStream.IsBuiltFor(*this)){
+                    mDeltaIndexStream.Build(*this);
+                }
+                return mDeltaIndexStream;
+            }
+
+            /**
+             * @brief 清除矩阵向量乘的行调度、转置结构、列索引编码流与 SELL-C-σ 副本的结构，原地修改行索引或列索引数组后调用
+             * @details 已启用的 SELL-C-σ 副本保持启用，下次 UpdateSellCSigma() 时按新的稀疏模式重建
+             */
+            void ResetSpMVSchedule(){
+                ClearStructureCaches();
+            }
+
+            /**
+             * @brief 启用 SELL-C-σ 副本，此后连续存储向量的 SpMV 在副本上计算
+             * @details 组装仍在CSR格式上进行，FinalizeAssemble() 与 ApplyHomogeneousDirichlet() 会刷新副本的数值，
+             *  稀疏模式变化时副本自动重建。通过非常量的 value_data() 或 operator() 取得数值后，副本在下次 SpMV 前重新同步；
+             *  若在 SpMV 之后仍通过之前取得的引用修改数值，需调用 UpdateSellCSigma()
+             * @param ChunkHeight 块高度 C，为零时按SIMD宽度选取
+             * @param Sigma 排序窗口 σ，为零时取默认值
+             */
+            void EnableSellCSigma(const IndexType ChunkHeight = 0, const IndexType Sigma = 0){
+                mpSellCSigma = std::make_unique<SellCSigmaMatrixType>();
+                mSellChunkHeight = ChunkHeight;
+                mSellSigma = Sigma;
+                UpdateSellCSigma();
+            }
+
+            /**
+             * @brief 停用并释放 SELL-C-σ 副本
+             */
+            void DisableSellCSigma(){
+                mpSellCSigma.reset();
+            }
+
+            /**
+             * @brief 判断是否启用了 SELL-C-σ 副本
+             */
+            bool IsSellCSigmaEnabled() const{
+                return static_cast<bool>(mpSellCSigma);
+            }
+
+            /**
+             * @brief 使 SELL-C-σ 副本与当前CSR数据一致，稀疏模式变化时重建，否则只刷新数值
+             */
+            void UpdateSellCSigma(){
+                if(!mpSellCSigma || size1() == 0){
+                    return;
+                }
+                if(mpSellCSigma->IsBuiltFor(*this)){
+                    mpSellCSigma->UpdateValues(*this);
+                } else {
+                    mpSellCSigma->Build(*this, mSellChunkHeight, mSellSigma);
+                }
+                mSellCSigmaValuesAreStale.store(false, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 返回 SELL-C-σ 副本，未启用时返回空指针
+             */
+            const SellCSigmaMatrixType* pGetSellCSigma() const{
+                return mpSellCSigma.get();
             }
 
             /**
@@ -579,7 +807,9 @@ namespace Quest{
             /**
              * @brief 结束并行化Assemble操作
              */
-            void FinalizeAssemble(){}
+            void FinalizeAssemble(){
+                UpdateSellCSigma();
+            }
 
             /**
              * @brief 基于全局方程编号EquationId，将矩阵rMatrixInput的局部数据组装到当前矩阵中
@@ -589,38 +819,19 @@ namespace Quest{
                 const TMatrixType& rMatrixInput,
                 const TIndexVectorType& EquationId
             ){
-                QUEST_DEBUG_ERROR_IF(rMatrixInput.size1() != EquationId.size()) << "sizes of matrix and equation id do not match in Assemble" << std::endl;
-                QUEST_DEBUG_ERROR_IF(rMatrixInput.size2() != EquationId.size()) << "sizes of matrix and equation id do not match in Assemble" << std::endl;
-
-                const unsigned int local_size = rMatrixInput.size1();
-
-                for(unsigned int i_local = 0; i_local < local_size; ++i_local){
-                    const IndexType I = EquationId[i_local];
-                    const IndexType row_begin = index1_data()[I];
-                    const IndexType row_end = index1_data()[I+1];
-
-                    IndexTYpe J = EquationId[0];
-                    IndexType k = BinarySearch(index2_data(), row_begin, row_end, EquationId[0]);
-                    IndexType lastJ = J;
-
-                    AtomicAdd(value_data()[k], rMatrixInput(i_local, 0));
-
-                    for(unsigned int j_local = 1; j_local < local_size; ++j_local){
-                        J = EquationId[j_local];
-
-                        if(k+1<row_end && index2_data()[k+1] == J){
-                            k = k+1;
-                        } else if (J > lastJ){
-                            k = BinarySearch(index2_data(), k+2, row_end, J);
-                        } else if (J < lastJ){
-                            k = BinarySearch(index2_data(), row_begin, k-1, J);
-                        }
-
-                        AtomicAdd(value_data()[k], rMatrixInput(i_local, j_local));
+                AssembleLocalMatrix<true>(rMatrixInput, EquationId);
+            }
 
-                        lastJ = J;
-                    }
-                }
+            /**
+             * @brief 基于全局方程编号EquationId，以普通（非原子）加法将矩阵rMatrixInput组装到当前矩阵中
+             * @details 仅当没有其他线程同时写入相同的行时才可使用，例如按着色（EntityColoring）分批组装时
+             */
+            template<typename TMatrixType, typename TIndexVectorType>
+            void AssembleNonAtomic(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& EquationId
+            ){
+                AssembleLocalMatrix<false>(rMatrixInput, EquationId);
             }
 
             /**
@@ -667,6 +878,33 @@ namespace Quest{
                 }
             }
 
+            /**
+             * @brief 按组装计划将第EntityIndex个实体的局部矩阵rMatrixInput组装到当前矩阵中
+             * @details 局部矩阵按行优先顺序直接累加到计划中缓存的值数组偏移量上，不再进行二分查找。
+             *  计划须由当前稀疏模式构建（见 CsrAssemblyPlan::IsBuiltFor）
+             */
+            template<typename TMatrixType>
+            void Assemble(
+                const TMatrixType& rMatrixInput,
+                const CsrAssemblyPlan<IndexType>& rPlan,
+                const IndexType EntityIndex
+            ){
+                AssembleLocalMatrix<true>(rMatrixInput, rPlan, EntityIndex);
+            }
+
+            /**
+             * @brief 按组装计划以普通（非原子）加法组装第EntityIndex个实体的局部矩阵
+             * @details 仅当没有其他线程同时写入相同的行时才可使用，例如按着色（EntityColoring）分批组装时
+             */
+            template<typename TMatrixType>
+            void AssembleNonAtomic(
+                const TMatrixType& rMatrixInput,
+                const CsrAssemblyPlan<IndexType>& rPlan,
+                const IndexType EntityIndex
+            ){
+                AssembleLocalMatrix<false>(rMatrixInput, rPlan, EntityIndex);
+            }
+
             /**
              * @brief 将value值累加到指定对应位置的元素
              */
@@ -714,6 +952,7 @@ namespace Quest{
                             }
                         }
                     });
+                    UpdateSellCSigma();
                 }
             }
 
@@ -781,6 +1020,87 @@ namespace Quest{
             }
 
         private:
+            /**
+             * @brief 基于全局方程编号组装局部矩阵的实现
+             * @tparam TUseAtomicAdd 是否使用原子加法
+             */
+            template<bool TUseAtomicAdd, typename TMatrixType, typename TIndexVectorType>
+            void AssembleLocalMatrix(
+                const TMatrixType& rMatrixInput,
+                const TIndexVectorType& EquationId
+            ){
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size1() != EquationId.size()) << "sizes of matrix and equation id do not match in Assemble" << std::endl;
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size2() != EquationId.size()) << "sizes of matrix and equation id do not match in Assemble" << std::endl;
+
+                const unsigned int local_size = rMatrixInput.size1();
+
+                for(unsigned int i_local = 0; i_local < local_size; ++i_local){
+                    const IndexType I = EquationId[i_local];
+                    const IndexType row_begin = index1_data()[I];
+                    const IndexType row_end = index1_data()[I+1];
+
+                    IndexType J = EquationId[0];
+                    IndexType k = BinarySearch(index2_data(), row_begin, row_end, EquationId[0]);
+                    IndexType lastJ = J;
+
+                    AddValue<TUseAtomicAdd>(value_data()[k], rMatrixInput(i_local, 0));
+
+                    for(unsigned int j_local = 1; j_local < local_size; ++j_local){
+                        J = EquationId[j_local];
+
+                        if(k+1<row_end && index2_data()[k+1] == J){
+                            k = k+1;
+                        } else if (J > lastJ){
+                            k = BinarySearch(index2_data(), k+2, row_end, J);
+                        } else if (J < lastJ){
+                            k = BinarySearch(index2_data(), row_begin, k-1, J);
+                        }
+
+                        AddValue<TUseAtomicAdd>(value_data()[k], rMatrixInput(i_local, j_local));
+
+                        lastJ = J;
+                    }
+                }
+            }
+
+            /**
+             * @brief 按组装计划组装局部矩阵的实现
+             * @tparam TUseAtomicAdd 是否使用原子加法
+             */
+            template<bool TUseAtomicAdd, typename TMatrixType>
+            void AssembleLocalMatrix(
+                const TMatrixType& rMatrixInput,
+                const CsrAssemblyPlan<IndexType>& rPlan,
+                const IndexType EntityIndex
+            ){
+                const auto offsets = rPlan.GetEntityOffsets(EntityIndex);
+                const unsigned int local_size = rMatrixInput.size1();
+
+                QUEST_DEBUG_ERROR_IF(rMatrixInput.size2() != local_size) << "the local matrix must be square to be assembled with a plan" << std::endl;
+                QUEST_DEBUG_ERROR_IF(offsets.size() != local_size*local_size) << "size of the local matrix " << local_size
+                    << " does not match the assembly plan of entity " << EntityIndex << std::endl;
+
+                IndexType k = 0;
+                for(unsigned int i_local = 0; i_local < local_size; ++i_local){
+                    for(unsigned int j_local = 0; j_local < local_size; ++j_local){
+                        AddValue<TUseAtomicAdd>(value_data()[offsets[k++]], rMatrixInput(i_local, j_local));
+                    }
+                }
+            }
+
+            /**
+             * @brief 将Value累加到rTarget上
+             * @tparam TUseAtomicAdd 是否使用原子加法
+             */
+            template<bool TUseAtomicAdd>
+            static inline void AddValue(TDataType& rTarget, const TDataType Value){
+                if constexpr (TUseAtomicAdd){
+                    AtomicAdd(rTarget, Value);
+                } else {
+                    rTarget += Value;
+                }
+            }
+
             friend class Serializer;
 
 
@@ -842,6 +1162,55 @@ namespace Quest{
                 rSerializer.load("Ncol", mNcols);
             }
 
+        private:
+            /**
+             * @brief 判断是否可以使用基于指针的矩阵向量乘核函数（输入输出向量均为连续存储且元素类型一致）
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            static constexpr bool UseSpMVKernels(){
+                return Internals::IsContiguousVectorOf<TDataType, TInputVectorType>::value
+                    && Internals::IsContiguousVectorOf<TDataType, TOutputVectorType>::value;
+            }
+
+            /**
+             * @brief 判断 SpMV 是否在 SELL-C-σ 副本上计算（已启用且与当前稀疏模式一致）
+             * @details 副本的数值被标记为过期时先重新同步。与其他 SpMV 缓存一样，不能在同一矩阵上并发调用
+             */
+            bool UseSellCSigma() const{
+                if(!mpSellCSigma || !mpSellCSigma->IsBuiltFor(*this)){
+                    return false;
+                }
+                if(mSellCSigmaValuesAreStale.load(std::memory_order_relaxed)){
+                    mpSellCSigma->UpdateValues(*this);
+                    mSellCSigmaValuesAreStale.store(false, std::memory_order_relaxed);
+                }
+                return true;
+            }
+
+            /**
+             * @brief 把 SELL-C-σ 副本的数值标记为过期
+             * @details 组装时会被多个线程调用，先读后写，避免每次访问都写同一缓存行
+             */
+            void MarkSellCSigmaValuesStale(){
+                if(mpSellCSigma && !mSellCSigmaValuesAreStale.load(std::memory_order_relaxed)){
+                    mSellCSigmaValuesAreStale.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief 清除所有依赖稀疏模式的缓存，包括 SELL-C-σ 副本的结构（副本本身保持启用）
+             * @details 各缓存的 IsBuiltFor 只比较行索引数组地址、行数与非零元个数，
+             *  原地重建的相同规模稀疏模式无法由此识别，因此修改索引数组的函数都必须调用本函数
+             */
+            void ClearStructureCaches(){
+                mSpMVSchedule.Clear();
+                mTransposeStructure.Clear();
+                mDeltaIndexStream.Clear();
+                if(mpSellCSigma){
+                    mpSellCSigma->Clear();
+                }
+            }
+
         private:
             /**
              * @brief 数据通讯器指针
@@ -893,6 +1262,46 @@ namespace Quest{
              */
             IndexType mNcols = 0;
 
+            /**
+             * @brief 矩阵向量乘的行调度缓存
+             */
+            mutable SpMVScheduleType mSpMVSchedule;
+
+            /**
+             * @brief 转置结构缓存，用于无原子操作的转置矩阵向量乘
+             */
+            mutable TransposeStructureType mTransposeStructure;
+
+            /**
+             * @brief 列索引的差分变长编码流缓存
+             */
+            mutable DeltaIndexStreamType mDeltaIndexStream;
+
+            /**
+             * @brief SpMV 是否使用列索引编码流
+             */
+            bool mUseCompressedIndices = false;
+
+            /**
+             * @brief SELL-C-σ 格式的副本，仅用于矩阵向量乘
+             */
+            std::unique_ptr<SellCSigmaMatrixType> mpSellCSigma;
+
+            /**
+             * @brief SELL-C-σ 副本的数值是否可能落后于CSR数值
+             */
+            mutable std::atomic<bool> mSellCSigmaValuesAreStale{false};
+
+            /**
+             * @brief SELL-C-σ 副本的块高度，为零时按SIMD宽度选取
+             */
+            IndexType mSellChunkHeight = 0;
+
+            /**
+             * @brief SELL-C-σ 副本的排序窗口，为零时取默认值
+             */
+            IndexType mSellSigma = 0;
+
     };
 
 
@@ -0,0 +1,438 @@
+/*---------------------------------------------
+CSR矩阵的稀疏矩阵乘法（SpGEMM）
+符号阶段生成可复用的结果稀疏模式，数值阶段只刷新数值
+----------------------------------------------*/
+
+#ifndef QUEST_CSR_SPGEMM_HPP
+#define QUEST_CSR_SPGEMM_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/csr_transpose_structure.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class CsrSpGEMM
+     * @brief CSR矩阵乘法 C = A*B 的两阶段实现
+     * @details 采用按行的 Gustavson 算法，行间并行，每个线程使用长度为 B 列数的稠密累加器。
+     *  符号阶段先统计每行的非零元数目，再填充并排序列索引，得到 C 的稀疏模式；
+     *  数值阶段在已知模式上计算数值，不分配内存、不查找。A、B 的稀疏模式不变时
+     *  （如牛顿迭代之间）只需重复调用数值阶段
+     * @tparam TDataType 数据类型
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TDataType = double, typename TIndexType = std::size_t>
+    class CsrSpGEMM final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+            using MatrixType = CsrMatrix<TDataType, TIndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(CsrSpGEMM);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrSpGEMM(){}
+
+            /**
+             * @brief 析构函数
+             */
+            ~CsrSpGEMM(){}
+
+            /**
+             * @brief 计算 C = A*B，稀疏模式未变化时只执行数值阶段
+             */
+            void Multiply(const MatrixType& rA, const MatrixType& rB, MatrixType& rC){
+                if(!IsBuiltFor(rA, rB, rC)){
+                    SymbolicMultiply(rA, rB, rC);
+                }
+                NumericMultiply(rA, rB, rC);
+            }
+
+            /**
+             * @brief 符号阶段：计算 C = A*B 的稀疏模式并为 C 分配存储，C 的数值被置零
+             */
+            void SymbolicMultiply(const MatrixType& rA, const MatrixType& rB, MatrixType& rC){
+                QUEST_ERROR_IF(rA.size2() != rB.size1()) << "SymbolicMultiply: mismatch between matrix sizes : A is " << rA.size1() << "x" << rA.size2()
+                    << " and B is " << rB.size1() << "x" << rB.size2() << std::endl;
+
+                const IndexType nrows = rA.size1();
+                const IndexType ncols = rB.size2();
+                const auto& r_a_rows = rA.index1_data();
+                const auto& r_a_cols = rA.index2_data();
+                const auto& r_b_rows = rB.index1_data();
+                const auto& r_b_cols = rB.index2_data();
+
+                // 第一遍：以标记数组统计每行的非零元数目
+                IndexVectorType row_indices(nrows+1);
+                row_indices[0] = 0;
+                IndexPartition<IndexType>(nrows).for_each(IndexVectorType(ncols, std::numeric_limits<IndexType>::max()), [&](IndexType i, IndexVectorType& rMarker){
+                    IndexType count = 0;
+                    for(IndexType ka=r_a_rows[i]; ka<r_a_rows[i+1]; ++ka){
+                        const IndexType k = r_a_cols[ka];
+                        for(IndexType kb=r_b_rows[k]; kb<r_b_rows[k+1]; ++kb){
+                            const IndexType j = r_b_cols[kb];
+                            if(rMarker[j] != i){
+                                rMarker[j] = i;
+                                ++count;
+                            }
+                        }
+                    }
+                    row_indices[i+1] = count;
+                });
+
+                for(IndexType i=0; i<nrows; ++i){
+                    row_indices[i+1] += row_indices[i];
+                }
+
+                rC.ResizeIndex1Data(nrows+1);
+                rC.ResizeIndex2Data(row_indices[nrows]);
+                rC.ResizeValueData(row_indices[nrows]);
+                auto& r_c_rows = rC.index1_data();
+                auto& r_c_cols = rC.index2_data();
+                IndexPartition<IndexType>(nrows+1).for_each([&](IndexType i){
+                    r_c_rows[i] = row_indices[i];
+                });
+
+                // 第二遍：填充列索引并行内排序
+                IndexPartition<IndexType>(nrows).for_each(IndexVectorType(ncols, std::numeric_limits<IndexType>::max()), [&](IndexType i, IndexVectorType& rMarker){
+                    IndexType position = r_c_rows[i];
+                    for(IndexType ka=r_a_rows[i]; ka<r_a_rows[i+1]; ++ka){
+                        const IndexType k = r_a_cols[ka];
+                        for(IndexType kb=r_b_rows[k]; kb<r_b_rows[k+1]; ++kb){
+                            const IndexType j = r_b_cols[kb];
+                            if(rMarker[j] != i){
+                                rMarker[j] = i;
+                                r_c_cols[position++] = j;
+                            }
+                        }
+                    }
+                    std::sort(r_c_cols.begin() + r_c_rows[i], r_c_cols.begin() + r_c_rows[i+1]);
+                });
+
+                rC.SetRowSize(nrows);
+                rC.SetColSize(ncols);
+                rC.SetValue(TDataType());
+
+                mpCRowIndices = r_c_rows.data();
+                mANonZeros = r_a_cols.size();
+                mBNonZeros = r_b_cols.size();
+                mCNonZeros = r_c_cols.size();
+                mAPatternHash = PatternHash(rA);
+                mBPatternHash = PatternHash(rB);
+                mCPatternHash = PatternHash(rC);
+            }
+
+            /**
+             * @brief 数值阶段：在符号阶段得到的稀疏模式上计算 C = A*B 的数值
+             * @details A、B 的稀疏模式须与符号阶段一致，数值可以不同
+             */
+            void NumericMultiply(const MatrixType& rA, const MatrixType& rB, MatrixType& rC) const{
+                QUEST_ERROR_IF_NOT(IsBuiltFor(rA, rB, rC)) << "NumericMultiply: the sparsity patterns do not match the symbolic phase, call SymbolicMultiply first" << std::endl;
+
+                const IndexType nrows = rA.size1();
+                const IndexType ncols = rB.size2();
+                const auto& r_a_rows = rA.index1_data();
+                const auto& r_a_cols = rA.index2_data();
+                const auto& r_a_values = rA.value_data();
+                const auto& r_b_rows = rB.index1_data();
+                const auto& r_b_cols = rB.index2_data();
+                const auto& r_b_values = rB.value_data();
+                const auto& r_c_rows = rC.index1_data();
+                const auto& r_c_cols = rC.index2_data();
+                auto& r_c_values = rC.value_data();
+
+                // 稠密累加器在写回 C 时逐项清零，C 的每行包含该行所有乘积项的列，因此行间无残留
+                IndexPartition<IndexType>(nrows).for_each(std::vector<TDataType>(ncols, TDataType()), [&](IndexType i, std::vector<TDataType>& rAccumulator){
+                    for(IndexType ka=r_a_rows[i]; ka<r_a_rows[i+1]; ++ka){
+                        const IndexType k = r_a_cols[ka];
+                        const TDataType a_ik = r_a_values[ka];
+                        for(IndexType kb=r_b_rows[k]; kb<r_b_rows[k+1]; ++kb){
+                            rAccumulator[r_b_cols[kb]] += a_ik * r_b_values[kb];
+                        }
+                    }
+                    for(IndexType kc=r_c_rows[i]; kc<r_c_rows[i+1]; ++kc){
+                        TDataType& r_entry = rAccumulator[r_c_cols[kc]];
+                        r_c_values[kc] = r_entry;
+                        r_entry = TDataType();
+                    }
+                });
+
+                rC.FinalizeAssemble();
+            }
+
+            /**
+             * @brief 判断符号阶段的结果是否仍适用于给定的 A、B、C
+             * @details 比较 A、B、C 的非零元个数与索引数组的散列，A 或 B 的稀疏模式被原地改写时同样返回 false；
+             *  C 另外比较行索引数组地址，保证 C 仍是符号阶段分配的那块存储
+             */
+            bool IsBuiltFor(const MatrixType& rA, const MatrixType& rB, const MatrixType& rC) const{
+                return mpCRowIndices != nullptr
+                    && mpCRowIndices == rC.index1_data().data() && mCNonZeros == rC.nnz()
+                    && mANonZeros == rA.nnz() && mBNonZeros == rB.nnz()
+                    && mAPatternHash == PatternHash(rA)
+                    && mBPatternHash == PatternHash(rB)
+                    && mCPatternHash == PatternHash(rC);
+            }
+
+            /**
+             * @brief 稀疏模式的 64 位 FNV-1a 散列（包括行数与列数）
+             */
+            static std::uint64_t PatternHash(const MatrixType& rMatrix){
+                const IndexType size = rMatrix.size1();
+                const auto& r_row_indices = rMatrix.index1_data();
+                const auto& r_col_indices = rMatrix.index2_data();
+
+                std::uint64_t hash = 14695981039346656037ULL;
+                auto mix = [&hash](const std::uint64_t Value){
+                    hash ^= Value;
+                    hash *= 1099511628211ULL;
+                };
+                mix(static_cast<std::uint64_t>(size));
+                mix(static_cast<std::uint64_t>(rMatrix.size2()));
+                if(r_row_indices.size() == 0){
+                    return hash;
+                }
+                for(IndexType i=0; i<=size; ++i){
+                    mix(static_cast<std::uint64_t>(r_row_indices[i]));
+                }
+                const IndexType nnz = r_row_indices[size];
+                for(IndexType k=0; k<nnz; ++k){
+                    mix(static_cast<std::uint64_t>(r_col_indices[k]));
+                }
+                return hash;
+            }
+
+            /**
+             * @brief 清除符号阶段的记录
+             */
+            void Clear(){
+                mpCRowIndices = nullptr;
+                mANonZeros = 0;
+                mBNonZeros = 0;
+                mCNonZeros = 0;
+                mAPatternHash = 0;
+                mBPatternHash = 0;
+                mCPatternHash = 0;
+            }
+
+            /**
+             * @brief 计算显式转置 AT = A^T
+             * @details 由 A 的转置结构复制稀疏模式，并按排列读取数值
+             */
+            static void Transpose(const MatrixType& rA, MatrixType& rAT){
+                const auto& r_transpose = rA.GetTransposeStructure();
+                const auto& r_rows = r_transpose.index1_data();
+                const auto& r_cols = r_transpose.index2_data();
+
+                rAT.ResizeIndex1Data(r_rows.size());
+                rAT.ResizeIndex2Data(r_cols.size());
+                rAT.ResizeValueData(r_cols.size());
+                IndexPartition<IndexType>(r_rows.size()).for_each([&](IndexType i){
+                    rAT.index1_data()[i] = r_rows[i];
+                });
+                IndexPartition<IndexType>(r_cols.size()).for_each([&](IndexType p){
+                    rAT.index2_data()[p] = r_cols[p];
+                });
+                rAT.SetRowSize(rA.size2());
+                rAT.SetColSize(rA.size1());
+                TransposeValues(rA, rAT);
+            }
+
+            /**
+             * @brief 稀疏模式不变时刷新显式转置的数值
+             */
+            static void TransposeValues(const MatrixType& rA, MatrixType& rAT){
+                const auto& r_permutation = rA.GetTransposeStructure().GetValuePermutation();
+                QUEST_ERROR_IF(r_permutation.size() != rAT.nnz()) << "TransposeValues: the pattern of the transposed matrix does not match" << std::endl;
+                const auto& r_values = rA.value_data();
+                auto& r_values_t = rAT.value_data();
+                IndexPartition<IndexType>(r_permutation.size()).for_each([&](IndexType p){
+                    r_values_t[p] = r_values[r_permutation[p]];
+                });
+                rAT.FinalizeAssemble();
+            }
+
+
+            std::string Info() const{
+                return "CsrSpGEMM";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrSpGEMM";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "nnz(A) : " << mANonZeros << " nnz(B) : " << mBNonZeros << " nnz(C) : " << mCNonZeros << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 符号阶段生成的 C 的行索引数组地址
+             */
+            const IndexType* mpCRowIndices = nullptr;
+
+            /**
+             * @brief 符号阶段时 A 的非零元个数
+             */
+            IndexType mANonZeros = 0;
+
+            /**
+             * @brief 符号阶段时 B 的非零元个数
+             */
+            IndexType mBNonZeros = 0;
+
+            /**
+             * @brief 符号阶段生成的 C 的非零元个数
+             */
+            IndexType mCNonZeros = 0;
+
+            /**
+             * @brief 符号阶段时 A 的稀疏模式散列
+             */
+            std::uint64_t mAPatternHash = 0;
+
+            /**
+             * @brief 符号阶段时 B 的稀疏模式散列
+             */
+            std::uint64_t mBPatternHash = 0;
+
+            /**
+             * @brief 符号阶段生成的 C 的稀疏模式散列
+             */
+            std::uint64_t mCPatternHash = 0;
+
+    };
+
+
+    /**
+     * @class CsrTripleProduct
+     * @brief 计算 C = T^T*A*T，供施加主从约束时使用
+     * @details 缓存 T 的显式转置、中间结果 A*T 以及两次乘法的符号阶段，
+     *  稀疏模式不变时每次调用只执行数值阶段。目前的块构建器与消去构建器尚不支持主从约束，
+     *  且以 ublas 矩阵作为系统矩阵，因此本类只面向以 CsrMatrix 为系统矩阵的约束实现
+     * @tparam TDataType 数据类型
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TDataType = double, typename TIndexType = std::size_t>
+    class CsrTripleProduct final{
+        public:
+            using IndexType = TIndexType;
+            using MatrixType = CsrMatrix<TDataType, TIndexType>;
+            using SpGEMMType = CsrSpGEMM<TDataType, TIndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(CsrTripleProduct);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrTripleProduct(){}
+
+            /**
+             * @brief 析构函数
+             */
+            ~CsrTripleProduct(){}
+
+            /**
+             * @brief 计算 C = T^T*A*T
+             * @details T 的稀疏模式（按散列判断）变化时重建其转置，否则只刷新转置的数值；两次乘法各自判断是否需要符号阶段
+             */
+            void Compute(const MatrixType& rT, const MatrixType& rA, MatrixType& rC){
+                QUEST_ERROR_IF(rA.size1() != rT.size1() || rA.size2() != rT.size1()) << "CsrTripleProduct: mismatch between matrix sizes : A is "
+                    << rA.size1() << "x" << rA.size2() << " and T is " << rT.size1() << "x" << rT.size2() << std::endl;
+
+                const std::uint64_t t_pattern_hash = SpGEMMType::PatternHash(rT);
+                if(mTPatternHash != t_pattern_hash || mTNonZeros != rT.nnz() || mTransposedT.nnz() != rT.nnz()){
+                    SpGEMMType::Transpose(rT, mTransposedT);
+                    mTPatternHash = t_pattern_hash;
+                    mTNonZeros = rT.nnz();
+                } else {
+                    SpGEMMType::TransposeValues(rT, mTransposedT);
+                }
+
+                mAT.Multiply(rA, rT, mProductAT);
+                mTtAT.Multiply(mTransposedT, mProductAT, rC);
+            }
+
+            /**
+             * @brief 释放缓存的中间结果
+             */
+            void Clear(){
+                mTransposedT.Clear();
+                mProductAT.Clear();
+                mAT.Clear();
+                mTtAT.Clear();
+                mTPatternHash = 0;
+                mTNonZeros = 0;
+            }
+
+
+            std::string Info() const{
+                return "CsrTripleProduct";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrTripleProduct";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "nnz(T) : " << mTNonZeros << " nnz(A*T) : " << mProductAT.nnz() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief T 的显式转置
+             */
+            MatrixType mTransposedT;
+
+            /**
+             * @brief 中间结果 A*T
+             */
+            MatrixType mProductAT;
+
+            /**
+             * @brief A*T 的两阶段乘法
+             */
+            SpGEMMType mAT;
+
+            /**
+             * @brief T^T*(A*T) 的两阶段乘法
+             */
+            SpGEMMType mTtAT;
+
+            /**
+             * @brief 构建转置时 T 的稀疏模式散列
+             */
+            std::uint64_t mTPatternHash = 0;
+
+            /**
+             * @brief 构建转置时 T 的非零元个数
+             */
+            IndexType mTNonZeros = 0;
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_CSR_SPGEMM_HPP
@@ -0,0 +1,624 @@
+/*---------------------------------------------
+CSR矩阵向量乘的计算核函数
+包括按行长度划分的任务调度与运行时选择的SIMD实现
+----------------------------------------------*/
+
+#ifndef QUEST_CSR_SPMV_KERNELS_HPP
+#define QUEST_CSR_SPMV_KERNELS_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/ublas_interface.hpp"
+#include "container/system_vector.hpp"
+#include "utilities/cpu_features.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+#ifdef QUEST_X86_SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Quest{
+
+    /**
+     * @class CsrSpMVSchedule
+     * @brief CSR矩阵向量乘的行调度
+     * @details 按非零元数目（而非行数）把矩阵的行划分为若干连续的块，使各线程的工作量大致相同。
+     *  非零元数目不少于单个块目标工作量的行被视为长行，单独存放，计算时再把长行的非零元切分到多个线程上归约，
+     *  从而避免个别稠密行（如约束行、拉格朗日乘子行）拖慢整个并行循环。
+     *  调度只依赖稀疏模式，模式不变时可重复使用
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TIndexType = std::size_t>
+    class CsrSpMVSchedule final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+
+            /**
+             * @brief 每个线程期望分得的短行块数
+             */
+            static constexpr IndexType ChunksPerThread = 4;
+
+            /**
+             * @brief 单个短行块的最小非零元数目，避免小矩阵被切得过碎
+             */
+            static constexpr IndexType MinChunkNonZeros = 2048;
+
+            QUEST_CLASS_POINTER_DEFINITION(CsrSpMVSchedule);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrSpMVSchedule(){}
+
+            /**
+             * @brief 析构函数
+             */
+            ~CsrSpMVSchedule(){}
+
+            /**
+             * @brief 由行索引数组构建调度
+             * @param pRowIndices 行索引数组（长度为 NumberOfRows+1）
+             * @param NumberOfRows 行数
+             */
+            void Build(const IndexType* pRowIndices, const IndexType NumberOfRows){
+                const IndexType nnz = NumberOfRows == 0 ? 0 : pRowIndices[NumberOfRows] - pRowIndices[0];
+                const IndexType num_threads = static_cast<IndexType>(ParallelUtilities::GetNumThreads());
+                mChunkNonZeros = std::max(nnz / (ChunksPerThread*num_threads), MinChunkNonZeros);
+
+                mChunkRowBegin.clear();
+                mChunkRowEnd.clear();
+                mLongRows.clear();
+
+                IndexType chunk_begin = 0;
+                IndexType chunk_nnz = 0;
+                for(IndexType i=0; i<NumberOfRows; ++i){
+                    const IndexType row_nnz = pRowIndices[i+1] - pRowIndices[i];
+                    if(row_nnz >= mChunkNonZeros && num_threads > 1){
+                        if(i > chunk_begin){
+                            mChunkRowBegin.push_back(chunk_begin);
+                            mChunkRowEnd.push_back(i);
+                        }
+                        mLongRows.push_back(i);
+                        chunk_begin = i+1;
+                        chunk_nnz = 0;
+                        continue;
+                    }
+                    chunk_nnz += row_nnz;
+                    if(chunk_nnz >= mChunkNonZeros){
+                        mChunkRowBegin.push_back(chunk_begin);
+                        mChunkRowEnd.push_back(i+1);
+                        chunk_begin = i+1;
+                        chunk_nnz = 0;
+                    }
+                }
+                if(NumberOfRows > chunk_begin){
+                    mChunkRowBegin.push_back(chunk_begin);
+                    mChunkRowEnd.push_back(NumberOfRows);
+                }
+
+                mpRowIndices = pRowIndices;
+                mNumberOfRows = NumberOfRows;
+                mNumberOfNonZeros = nnz;
+                mNumberOfThreads = num_threads;
+                mIsBuilt = true;
+            }
+
+            /**
+             * @brief 判断调度是否与矩阵的稀疏模式及当前线程数匹配
+             * @details 比较行索引数组地址、行数、非零元个数与线程数，稀疏模式原地修改后应调用 Clear()
+             */
+            template<typename TMatrixType>
+            bool IsBuiltFor(const TMatrixType& rMatrix) const{
+                return mIsBuilt
+                    && mpRowIndices == rMatrix.index1_data().data()
+                    && mNumberOfRows == rMatrix.size1()
+                    && mNumberOfNonZeros == rMatrix.index2_data().size()
+                    && mNumberOfThreads == static_cast<IndexType>(ParallelUtilities::GetNumThreads());
+            }
+
+            /**
+             * @brief 清空调度
+             */
+            void Clear(){
+                IndexVectorType().swap(mChunkRowBegin);
+                IndexVectorType().swap(mChunkRowEnd);
+                IndexVectorType().swap(mLongRows);
+                mpRowIndices = nullptr;
+                mNumberOfRows = 0;
+                mNumberOfNonZeros = 0;
+                mNumberOfThreads = 0;
+                mIsBuilt = false;
+            }
+
+            /**
+             * @brief 返回短行块数
+             */
+            IndexType NumberOfChunks() const{
+                return mChunkRowBegin.size();
+            }
+
+            /**
+             * @brief 返回第 c 个短行块的起始行
+             */
+            IndexType ChunkRowBegin(const IndexType c) const{
+                return mChunkRowBegin[c];
+            }
+
+            /**
+             * @brief 返回第 c 个短行块的结束行（不含）
+             */
+            IndexType ChunkRowEnd(const IndexType c) const{
+                return mChunkRowEnd[c];
+            }
+
+            /**
+             * @brief 返回长行的行号
+             */
+            const IndexVectorType& LongRows() const{
+                return mLongRows;
+            }
+
+            /**
+             * @brief 返回单个块的目标非零元数目
+             */
+            IndexType ChunkNonZeros() const{
+                return mChunkNonZeros;
+            }
+
+
+            std::string Info() const{
+                return "CsrSpMVSchedule";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrSpMVSchedule";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of chunks : " << NumberOfChunks() << " number of long rows : " << mLongRows.size()
+                    << " non zeros per chunk : " << mChunkNonZeros << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 短行块的起始行
+             */
+            IndexVectorType mChunkRowBegin;
+
+            /**
+             * @brief 短行块的结束行（不含）
+             */
+            IndexVectorType mChunkRowEnd;
+
+            /**
+             * @brief 长行的行号
+             */
+            IndexVectorType mLongRows;
+
+            /**
+             * @brief 单个块的目标非零元数目，同时也是长行的判定阈值
+             */
+            IndexType mChunkNonZeros = 0;
+
+            /**
+             * @brief 构建调度时的行索引数组地址
+             */
+            const IndexType* mpRowIndices = nullptr;
+
+            /**
+             * @brief 构建调度时的行数
+             */
+            IndexType mNumberOfRows = 0;
+
+            /**
+             * @brief 构建调度时的非零元个数
+             */
+            IndexType mNumberOfNonZeros = 0;
+
+            /**
+             * @brief 构建调度时的线程数
+             */
+            IndexType mNumberOfThreads = 0;
+
+            /**
+             * @brief 调度是否已构建
+             */
+            bool mIsBuilt = false;
+
+    };
+
+
+    namespace Internals{
+
+        /**
+         * @brief 判断向量类型是否以连续数组存储数据，并返回数组首地址
+         * @details 只有连续存储的向量才能使用基于指针的SIMD核函数，其他向量（如ublas的代理类型）走通用实现
+         */
+        template<typename TVectorType>
+        struct ContiguousVectorData{
+            static constexpr bool IsContiguous = false;
+        };
+
+
+        template<typename TDataType>
+        struct ContiguousVectorData<DenseVector<TDataType>>{
+            static constexpr bool IsContiguous = true;
+            using DataType = TDataType;
+
+            static TDataType* Data(DenseVector<TDataType>& rVector){
+                return rVector.data().begin();
+            }
+
+            static const TDataType* Data(const DenseVector<TDataType>& rVector){
+                return rVector.data().begin();
+            }
+        };
+
+
+        template<typename TDataType, typename TIndexType>
+        struct ContiguousVectorData<SystemVector<TDataType, TIndexType>>{
+            static constexpr bool IsContiguous = true;
+            using DataType = TDataType;
+
+            static TDataType* Data(SystemVector<TDataType, TIndexType>& rVector){
+                return rVector.data().data().begin();
+            }
+
+            static const TDataType* Data(const SystemVector<TDataType, TIndexType>& rVector){
+                return rVector.data().data().begin();
+            }
+        };
+
+
+        /**
+         * @brief 判断向量类型是否为连续存储且元素类型为 TDataType
+         */
+        template<typename TDataType, typename TVectorType, typename = void>
+        struct IsContiguousVectorOf: std::false_type{};
+
+
+        template<typename TDataType, typename TVectorType>
+        struct IsContiguousVectorOf<TDataType, TVectorType, std::enable_if_t<ContiguousVectorData<TVectorType>::IsContiguous>>:
+            std::is_same<typename ContiguousVectorData<TVectorType>::DataType, TDataType>{};
+
+    } // namespace Internals
+
+
+    /**
+     * @class CsrSpMVKernels
+     * @brief CSR矩阵向量乘的计算核函数
+     * @details 核函数直接作用于CSR数组与连续存储的向量。双精度数据在运行时根据 CpuFeatures::GetSimdLevel()
+     *  选择 AVX-512、AVX2 或标量实现；其他数据类型始终使用标量实现。
+     *  行乘积按 CsrSpMVSchedule 调度：短行块并行计算，长行的非零元切分到多个线程上归约
+     * @tparam TDataType 数据类型
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TDataType = double, typename TIndexType = std::size_t>
+    class CsrSpMVKernels final{
+        public:
+            using IndexType = TIndexType;
+            using ScheduleType = CsrSpMVSchedule<TIndexType>;
+
+            /**
+             * @brief 是否存在SIMD实现（仅双精度，且索引为32位或64位整数）
+             */
+            static constexpr bool HasSimdKernels = std::is_same<TDataType, double>::value
+                && std::is_integral<TIndexType>::value
+                && (sizeof(TIndexType) == 4 || sizeof(TIndexType) == 8);
+
+        public:
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y
+             * @details beta 为零时不读取 y 的原有值
+             */
+            static void SpMV(
+                const ScheduleType& rSchedule,
+                const IndexType* pRowIndices,
+                const IndexType* pColIndices,
+                const TDataType* pValues,
+                const TDataType alpha,
+                const TDataType* pX,
+                const TDataType beta,
+                TDataType* pY
+            ){
+                SpMVImpl<false>(rSchedule, pRowIndices, pColIndices, nullptr, pValues, alpha, pX, beta, pY);
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y，第 k 个非零元的数值为 values[permutation[k]]
+             * @details 用于在不复制数值的情况下对另一种排列（如转置结构）的矩阵做乘法，数值与 x 均通过 gather 读取
+             */
+            static void SpMVIndirect(
+                const ScheduleType& rSchedule,
+                const IndexType* pRowIndices,
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const TDataType* pValues,
+                const TDataType alpha,
+                const TDataType* pX,
+                const TDataType beta,
+                TDataType* pY
+            ){
+                SpMVImpl<true>(rSchedule, pRowIndices, pColIndices, pValuePermutation, pValues, alpha, pX, beta, pY);
+            }
+
+            /**
+             * @brief 返回当前数据类型与索引类型下实际使用的SIMD级别
+             */
+            static SimdLevel GetSimdLevel(){
+                #ifdef QUEST_X86_SIMD_KERNELS
+                    if constexpr(HasSimdKernels){
+                        return CpuFeatures::GetSimdLevel();
+                    }
+                #endif
+                return SimdLevel::Scalar;
+            }
+
+        private:
+            /**
+             * @brief 矩阵向量乘的实现，短行块并行计算，长行分段归约
+             */
+            template<bool TIndirect>
+            static void SpMVImpl(
+                const ScheduleType& rSchedule,
+                const IndexType* pRowIndices,
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const TDataType* pValues,
+                const TDataType alpha,
+                const TDataType* pX,
+                const TDataType beta,
+                TDataType* pY
+            ){
+                const SimdLevel level = GetSimdLevel();
+
+                IndexPartition<IndexType>(rSchedule.NumberOfChunks()).for_each([&](IndexType c){
+                    RowsProduct<TIndirect>(level, pRowIndices, pColIndices, pValuePermutation, pValues, alpha, pX, beta, pY, rSchedule.ChunkRowBegin(c), rSchedule.ChunkRowEnd(c));
+                });
+
+                for(const IndexType i : rSchedule.LongRows()){
+                    const IndexType row_begin = pRowIndices[i];
+                    const IndexType row_nnz = pRowIndices[i+1] - row_begin;
+                    const IndexType num_segments = NumberOfSegments(rSchedule, row_nnz);
+                    const TDataType sum = IndexPartition<IndexType>(num_segments).template for_each<Internals::SumReduction<TDataType>>([&](IndexType s){
+                        const IndexType k_begin = row_begin + (row_nnz*s)/num_segments;
+                        const IndexType k_end = row_begin + (row_nnz*(s+1))/num_segments;
+                        return RangeDot<TIndirect>(level, pColIndices, pValuePermutation, pValues, pX, k_begin, k_end);
+                    });
+                    pY[i] = (beta == TDataType()) ? alpha*sum : alpha*sum + beta*pY[i];
+                }
+            }
+
+            /**
+             * @brief 长行切分的段数，每段约为一个块的工作量
+             */
+            static IndexType NumberOfSegments(const ScheduleType& rSchedule, const IndexType RowNonZeros){
+                const IndexType chunk_nnz = std::max(rSchedule.ChunkNonZeros(), IndexType(1));
+                return std::max(IndexType(1), std::min((RowNonZeros + chunk_nnz - 1)/chunk_nnz, static_cast<IndexType>(ParallelUtilities::GetNumThreads())));
+            }
+
+            /**
+             * @brief 计算 [RowBegin, RowEnd) 行的 y = alpha*A*x + beta*y
+             */
+            template<bool TIndirect>
+            static void RowsProduct(
+                const SimdLevel Level,
+                const IndexType* pRowIndices,
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const TDataType* pValues,
+                const TDataType alpha,
+                const TDataType* pX,
+                const TDataType beta,
+                TDataType* pY,
+                const IndexType RowBegin,
+                const IndexType RowEnd
+            ){
+                if(beta == TDataType()){
+                    for(IndexType i=RowBegin; i<RowEnd; ++i){
+                        pY[i] = alpha*RangeDot<TIndirect>(Level, pColIndices, pValuePermutation, pValues, pX, pRowIndices[i], pRowIndices[i+1]);
+                    }
+                } else {
+                    for(IndexType i=RowBegin; i<RowEnd; ++i){
+                        pY[i] = alpha*RangeDot<TIndirect>(Level, pColIndices, pValuePermutation, pValues, pX, pRowIndices[i], pRowIndices[i+1]) + beta*pY[i];
+                    }
+                }
+            }
+
+            /**
+             * @brief 计算 sum(values[k]*x[cols[k]]), k 属于 [KBegin, KEnd)，TIndirect 为真时数值取 values[permutation[k]]
+             */
+            template<bool TIndirect>
+            static TDataType RangeDot(
+                const SimdLevel Level,
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const TDataType* pValues,
+                const TDataType* pX,
+                const IndexType KBegin,
+                const IndexType KEnd
+            ){
+                #ifdef QUEST_X86_SIMD_KERNELS
+                    if constexpr(HasSimdKernels){
+                        if(Level == SimdLevel::AVX512){
+                            return RangeDotAVX512<TIndirect>(pColIndices, pValuePermutation, pValues, pX, KBegin, KEnd);
+                        } else if(Level == SimdLevel::AVX2){
+                            return RangeDotAVX2<TIndirect>(pColIndices, pValuePermutation, pValues, pX, KBegin, KEnd);
+                        }
+                    }
+                #endif
+                return RangeDotScalar<TIndirect>(pColIndices, pValuePermutation, pValues, pX, KBegin, KEnd);
+            }
+
+            /**
+             * @brief 标量实现，使用两个累加器以缩短浮点加法的依赖链
+             */
+            template<bool TIndirect>
+            static TDataType RangeDotScalar(
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const TDataType* pValues,
+                const TDataType* pX,
+                IndexType k,
+                const IndexType KEnd
+            ){
+                TDataType sum0 = TDataType();
+                TDataType sum1 = TDataType();
+                for(; k+2<=KEnd; k+=2){
+                    sum0 += ValueAt<TIndirect>(pValuePermutation, pValues, k) * pX[pColIndices[k]];
+                    sum1 += ValueAt<TIndirect>(pValuePermutation, pValues, k+1) * pX[pColIndices[k+1]];
+                }
+                if(k < KEnd){
+                    sum0 += ValueAt<TIndirect>(pValuePermutation, pValues, k) * pX[pColIndices[k]];
+                }
+                return sum0 + sum1;
+            }
+
+            /**
+             * @brief 返回第 k 个非零元的数值
+             */
+            template<bool TIndirect>
+            static inline TDataType ValueAt(const IndexType* pValuePermutation, const TDataType* pValues, const IndexType k){
+                if constexpr(TIndirect){
+                    return pValues[pValuePermutation[k]];
+                } else {
+                    return pValues[k];
+                }
+            }
+
+        #ifdef QUEST_X86_SIMD_KERNELS
+            /**
+             * @brief AVX2 实现，每次处理4个非零元，两个累加器交替使用
+             */
+            template<bool TIndirect>
+            __attribute__((target("avx2,fma")))
+            static double RangeDotAVX2(
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const double* pValues,
+                const double* pX,
+                IndexType k,
+                const IndexType KEnd
+            ){
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                for(; k+8<=KEnd; k+=8){
+                    acc0 = _mm256_fmadd_pd(LoadValuesAVX2<TIndirect>(pValuePermutation, pValues, k), GatherAVX2(pColIndices+k, pX), acc0);
+                    acc1 = _mm256_fmadd_pd(LoadValuesAVX2<TIndirect>(pValuePermutation, pValues, k+4), GatherAVX2(pColIndices+k+4, pX), acc1);
+                }
+                if(k+4<=KEnd){
+                    acc0 = _mm256_fmadd_pd(LoadValuesAVX2<TIndirect>(pValuePermutation, pValues, k), GatherAVX2(pColIndices+k, pX), acc0);
+                    k += 4;
+                }
+                acc0 = _mm256_add_pd(acc0, acc1);
+                const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc0), _mm256_extractf128_pd(acc0, 1));
+                double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+                for(; k<KEnd; ++k){
+                    sum += ValueAt<TIndirect>(pValuePermutation, pValues, k) * pX[pColIndices[k]];
+                }
+                return sum;
+            }
+
+            /**
+             * @brief 加载第 k 个起的4个非零元数值
+             */
+            template<bool TIndirect>
+            __attribute__((target("avx2,fma")))
+            static __m256d LoadValuesAVX2(const IndexType* pValuePermutation, const double* pValues, const IndexType k){
+                if constexpr(TIndirect){
+                    return GatherAVX2(pValuePermutation+k, pValues);
+                } else {
+                    return _mm256_loadu_pd(pValues+k);
+                }
+            }
+
+            /**
+             * @brief 以4个列索引从 x 中收集数据
+             */
+            __attribute__((target("avx2,fma")))
+            static __m256d GatherAVX2(const IndexType* pCols, const double* pX){
+                if constexpr(sizeof(IndexType) == 8){
+                    const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pCols));
+                    return _mm256_i64gather_pd(pX, idx, 8);
+                } else {
+                    const __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCols));
+                    return _mm256_i32gather_pd(pX, idx, 8);
+                }
+            }
+
+            /**
+             * @brief AVX-512 实现，每次处理8个非零元，尾部使用掩码加载而非标量循环
+             */
+            template<bool TIndirect>
+            __attribute__((target("avx512f")))
+            static double RangeDotAVX512(
+                const IndexType* pColIndices,
+                const IndexType* pValuePermutation,
+                const double* pValues,
+                const double* pX,
+                IndexType k,
+                const IndexType KEnd
+            ){
+                __m512d acc0 = _mm512_setzero_pd();
+                __m512d acc1 = _mm512_setzero_pd();
+                for(; k+16<=KEnd; k+=16){
+                    acc0 = _mm512_fmadd_pd(LoadValuesAVX512<TIndirect>(pValuePermutation, pValues, k, 0xFF), GatherAVX512(pColIndices+k, pX, 0xFF), acc0);
+                    acc1 = _mm512_fmadd_pd(LoadValuesAVX512<TIndirect>(pValuePermutation, pValues, k+8, 0xFF), GatherAVX512(pColIndices+k+8, pX, 0xFF), acc1);
+                }
+                if(k+8<=KEnd){
+                    acc0 = _mm512_fmadd_pd(LoadValuesAVX512<TIndirect>(pValuePermutation, pValues, k, 0xFF), GatherAVX512(pColIndices+k, pX, 0xFF), acc0);
+                    k += 8;
+                }
+                if(k<KEnd){
+                    const __mmask8 mask = static_cast<__mmask8>((1u << (KEnd-k)) - 1u);
+                    acc1 = _mm512_fmadd_pd(LoadValuesAVX512<TIndirect>(pValuePermutation, pValues, k, mask), GatherAVX512(pColIndices+k, pX, mask), acc1);
+                }
+                return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+            }
+
+            /**
+             * @brief 加载第 k 个起的8个非零元数值，掩码外的通道置零
+             */
+            template<bool TIndirect>
+            __attribute__((target("avx512f")))
+            static __m512d LoadValuesAVX512(const IndexType* pValuePermutation, const double* pValues, const IndexType k, const __mmask8 Mask){
+                if constexpr(TIndirect){
+                    return GatherAVX512(pValuePermutation+k, pValues, Mask);
+                } else {
+                    return _mm512_maskz_loadu_pd(Mask, pValues+k);
+                }
+            }
+
+            /**
+             * @brief 以8个列索引从 x 中收集数据，掩码外的通道置零且不访问内存
+             */
+            __attribute__((target("avx512f")))
+            static __m512d GatherAVX512(const IndexType* pCols, const double* pX, const __mmask8 Mask){
+                if constexpr(sizeof(IndexType) == 8){
+                    const __m512i idx = _mm512_maskz_loadu_epi64(Mask, pCols);
+                    return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), Mask, idx, pX, 8);
+                } else {
+                    const __m256i idx = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32(static_cast<__mmask16>(Mask), pCols));
+                    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), Mask, idx, pX, 8);
+                }
+            }
+        #endif
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_CSR_SPMV_KERNELS_HPP
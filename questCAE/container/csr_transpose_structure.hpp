@@ -0,0 +1,279 @@
+/*---------------------------------------------
+CSR矩阵的转置结构（CSC视图）
+使转置矩阵向量乘成为只读取（gather）的逐行计算
+----------------------------------------------*/
+
+#ifndef QUEST_CSR_TRANSPOSE_STRUCTURE_HPP
+#define QUEST_CSR_TRANSPOSE_STRUCTURE_HPP
+
+// 系统头文件
+#include <vector>
+#include <atomic>
+#include <iostream>
+#include <algorithm>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/csr_spmv_kernels.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class CsrTransposeStructure
+     * @brief CSR矩阵的转置稀疏模式
+     * @details 以CSR形式存储 AT 的稀疏模式：第 j 行（即 A 的第 j 列）的条目为 A 中该列的行号，
+     *  并记录每个条目在 A 的值数组中的位置。数值不复制，乘法时通过该排列直接读取 A 的 value_data()，
+     *  因此数值更新后无需重建，只有稀疏模式变化时才需重新构建。
+     *  AT*x 由此变为对 AT 各行的归约，不再需要对 y 的原子加法
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TIndexType = std::size_t>
+    class CsrTransposeStructure final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+            using ScheduleType = CsrSpMVSchedule<TIndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(CsrTransposeStructure);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrTransposeStructure(){}
+
+            /**
+             * @brief 构造函数，直接构建转置结构
+             */
+            template<typename TMatrixType>
+            explicit CsrTransposeStructure(const TMatrixType& rMatrix){
+                Build(rMatrix);
+            }
+
+            /**
+             * @brief 析构函数
+             */
+            ~CsrTransposeStructure(){}
+
+            /**
+             * @brief 由CSR矩阵构建转置结构
+             * @details 第一遍以原子计数统计每列的条目数，第二遍按原子游标写入值数组偏移量，
+             *  随后各列内排序使行号递增，最后由偏移量反查行号
+             */
+            template<typename TMatrixType>
+            void Build(const TMatrixType& rMatrix){
+                const auto& r_row_indices = rMatrix.index1_data();
+                const auto& r_col_indices = rMatrix.index2_data();
+                const IndexType nrows = rMatrix.size1();
+                const IndexType ncols = rMatrix.size2();
+                const IndexType nnz = r_col_indices.size();
+
+                std::vector<std::atomic<IndexType>> col_cursor(ncols);
+                IndexPartition<IndexType>(ncols).for_each([&](IndexType j){
+                    col_cursor[j].store(0, std::memory_order_relaxed);
+                });
+
+                IndexPartition<IndexType>(nnz).for_each([&](IndexType k){
+                    col_cursor[r_col_indices[k]].fetch_add(1, std::memory_order_relaxed);
+                });
+
+                mColPointers.resize(ncols+1);
+                mColPointers[0] = 0;
+                for(IndexType j=0; j<ncols; ++j){
+                    mColPointers[j+1] = mColPointers[j] + col_cursor[j].load(std::memory_order_relaxed);
+                }
+
+                IndexPartition<IndexType>(ncols).for_each([&](IndexType j){
+                    col_cursor[j].store(mColPointers[j], std::memory_order_relaxed);
+                });
+
+                mValuePermutation.resize(nnz);
+                IndexPartition<IndexType>(nnz).for_each([&](IndexType k){
+                    const IndexType position = col_cursor[r_col_indices[k]].fetch_add(1, std::memory_order_relaxed);
+                    mValuePermutation[position] = k;
+                });
+
+                // 值数组偏移量随行号单调递增，列内按偏移量排序即按行号排序
+                mRowIndices.resize(nnz);
+                IndexPartition<IndexType>(ncols).for_each([&](IndexType j){
+                    const auto it_begin = mValuePermutation.begin() + mColPointers[j];
+                    const auto it_end = mValuePermutation.begin() + mColPointers[j+1];
+                    std::sort(it_begin, it_end);
+                    for(IndexType p=mColPointers[j]; p<mColPointers[j+1]; ++p){
+                        const auto it_row = std::upper_bound(r_row_indices.begin(), r_row_indices.begin() + nrows + 1, mValuePermutation[p]);
+                        mRowIndices[p] = static_cast<IndexType>(std::distance(r_row_indices.begin(), it_row)) - 1;
+                    }
+                });
+
+                mSchedule.Build(mColPointers.data(), ncols);
+
+                mpSourceRowIndices = r_row_indices.data();
+                mNumberOfRows = nrows;
+                mNumberOfCols = ncols;
+                mNumberOfNonZeros = nnz;
+            }
+
+            /**
+             * @brief 判断转置结构是否与矩阵的稀疏模式匹配
+             * @details 比较行索引数组地址、行数、列数与非零元个数
+             */
+            template<typename TMatrixType>
+            bool IsBuiltFor(const TMatrixType& rMatrix) const{
+                return !mColPointers.empty()
+                    && mpSourceRowIndices == rMatrix.index1_data().data()
+                    && mNumberOfRows == rMatrix.size1()
+                    && mNumberOfCols == rMatrix.size2()
+                    && mNumberOfNonZeros == rMatrix.index2_data().size();
+            }
+
+            /**
+             * @brief 清空转置结构
+             */
+            void Clear(){
+                IndexVectorType().swap(mColPointers);
+                IndexVectorType().swap(mRowIndices);
+                IndexVectorType().swap(mValuePermutation);
+                mSchedule.Clear();
+                mpSourceRowIndices = nullptr;
+                mNumberOfRows = 0;
+                mNumberOfCols = 0;
+                mNumberOfNonZeros = 0;
+            }
+
+            /**
+             * @brief 计算 y = alpha*AT*x + beta*y，pValues 为原矩阵的值数组
+             */
+            template<typename TDataType>
+            void TransposeSpMV(
+                const TDataType* pValues,
+                const TDataType alpha,
+                const TDataType* pX,
+                const TDataType beta,
+                TDataType* pY
+            ) const {
+                if(!mSchedule.IsBuiltFor(*this)){
+                    mSchedule.Build(mColPointers.data(), mNumberOfCols);
+                }
+                CsrSpMVKernels<TDataType, TIndexType>::SpMVIndirect(mSchedule, mColPointers.data(), mRowIndices.data(), mValuePermutation.data(),
+                    pValues, alpha, pX, beta, pY);
+            }
+
+            /**
+             * @brief 计算 y = alpha*AT*x + beta*y，适用于任意提供 operator() 的向量
+             */
+            template<typename TValueVectorType, typename TDataType, typename TInputVectorType, typename TOutputVectorType>
+            void TransposeSpMV(
+                const TValueVectorType& rValues,
+                const TDataType alpha,
+                const TInputVectorType& x,
+                const TDataType beta,
+                TOutputVectorType& y
+            ) const {
+                IndexPartition<IndexType>(mNumberOfCols).for_each([&](IndexType j){
+                    TDataType aux = TDataType();
+                    for(IndexType p=mColPointers[j]; p<mColPointers[j+1]; ++p){
+                        aux += rValues[mValuePermutation[p]] * x(mRowIndices[p]);
+                    }
+                    y(j) = (beta == TDataType()) ? alpha*aux : alpha*aux + beta*y(j);
+                });
+            }
+
+            /**
+             * @brief 返回转置矩阵的行数（原矩阵的列数）
+             */
+            IndexType size1() const{
+                return mNumberOfCols;
+            }
+
+            /**
+             * @brief 返回转置矩阵的列数（原矩阵的行数）
+             */
+            IndexType size2() const{
+                return mNumberOfRows;
+            }
+
+            /**
+             * @brief 返回转置矩阵的行索引数组（原矩阵的列指针）
+             */
+            const IndexVectorType& index1_data() const{
+                return mColPointers;
+            }
+
+            /**
+             * @brief 返回转置矩阵的列索引数组（原矩阵的行号）
+             */
+            const IndexVectorType& index2_data() const{
+                return mRowIndices;
+            }
+
+            /**
+             * @brief 返回转置矩阵各条目在原矩阵值数组中的位置
+             */
+            const IndexVectorType& GetValuePermutation() const{
+                return mValuePermutation;
+            }
+
+
+            std::string Info() const{
+                return "CsrTransposeStructure";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrTransposeStructure";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "size1 : " << size1() << " size2 : " << size2() << " nnz : " << mNumberOfNonZeros << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 原矩阵的列指针（转置矩阵的行索引数组）
+             */
+            IndexVectorType mColPointers;
+
+            /**
+             * @brief 各列条目的行号（转置矩阵的列索引数组）
+             */
+            IndexVectorType mRowIndices;
+
+            /**
+             * @brief 各条目在原矩阵值数组中的位置
+             */
+            IndexVectorType mValuePermutation;
+
+            /**
+             * @brief 转置矩阵向量乘的行调度，线程数变化时重建
+             */
+            mutable ScheduleType mSchedule;
+
+            /**
+             * @brief 构建时原矩阵行索引数组的地址
+             */
+            const IndexType* mpSourceRowIndices = nullptr;
+
+            /**
+             * @brief 原矩阵的行数
+             */
+            IndexType mNumberOfRows = 0;
+
+            /**
+             * @brief 原矩阵的列数
+             */
+            IndexType mNumberOfCols = 0;
+
+            /**
+             * @brief 非零元个数
+             */
+            IndexType mNumberOfNonZeros = 0;
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_CSR_TRANSPOSE_STRUCTURE_HPP
@@ -0,0 +1,607 @@
+/*-----------------------------------------------------
+低精度存储、双精度累加的CSR矩阵
+数值以单精度（或bfloat16）存储，索引可使用32位整数，
+矩阵向量乘在双精度下累加，用于预处理器等对精度要求较低的场合
+-----------------------------------------------------*/
+
+#ifndef QUEST_MIXED_PRECISION_CSR_MATRIX_HPP
+#define QUEST_MIXED_PRECISION_CSR_MATRIX_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/csr_spmv_kernels.hpp"
+#include "utilities/cpu_features.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+#ifdef QUEST_X86_SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Quest{
+
+    /**
+     * @class BFloat16
+     * @brief bfloat16 存储类型
+     * @details 保留单精度的符号位、8位指数与高7位尾数，取值范围与单精度相同，有效数字约3位。
+     *  仅用作存储格式，所有运算先转换为单精度再进行。由单精度转换时按最近偶数舍入
+     */
+    struct BFloat16{
+        /**
+         * @brief 位模式
+         */
+        std::uint16_t mBits = 0;
+
+        /**
+         * @brief 默认构造函数
+         */
+        BFloat16() = default;
+
+        /**
+         * @brief 由单精度数构造
+         */
+        explicit BFloat16(const float Value){
+            std::uint32_t bits;
+            std::memcpy(&bits, &Value, sizeof(float));
+            if((bits & 0x7fffffffu) > 0x7f800000u){
+                // NaN 保持为 quiet NaN，避免舍入后变为无穷大
+                mBits = static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+            } else {
+                bits += 0x7fffu + ((bits >> 16) & 1u);
+                mBits = static_cast<std::uint16_t>(bits >> 16);
+            }
+        }
+
+        /**
+         * @brief 转换为单精度数
+         */
+        explicit operator float() const{
+            const std::uint32_t bits = static_cast<std::uint32_t>(mBits) << 16;
+            float value;
+            std::memcpy(&value, &bits, sizeof(float));
+            return value;
+        }
+    };
+
+    /**
+     * @class MixedPrecisionCsrMatrix
+     * @brief 低精度存储、双精度累加的CSR矩阵
+     * @details 由双精度组装的CSR矩阵转换得到，数值以 TStorageType（float 或 BFloat16）存储，行列索引以 TIndexType 存储。
+     *  SpMV 的输入输出向量为双精度，每个非零元读取后先转换为双精度再相乘累加，
+     *  因此误差仅来自数值的舍入，不会随行长度累积。单精度数值加32位索引每个非零元占8字节，约为双精度CSR的一半，
+     *  带宽受限的 SpMV 相应加快。
+     *  转换时可同时施加行列缩放（例如对称Jacobi缩放），先缩放后舍入可避免数值超出单精度范围。
+     *  稀疏模式不变时只需调用 UpdateValues 刷新数值；与 SellCSigmaMatrix 一样按源矩阵行索引数组的地址判断模式是否变化
+     * @tparam TStorageType 数值的存储类型
+     * @tparam TIndexType 索引的存储类型
+     */
+    template<typename TStorageType = float, typename TIndexType = std::uint32_t>
+    class MixedPrecisionCsrMatrix final{
+        public:
+            using DataType = double;
+            using StorageType = TStorageType;
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+            using StorageVectorType = std::vector<StorageType>;
+            using ScheduleType = CsrSpMVSchedule<TIndexType>;
+
+            static_assert(std::is_same<TStorageType, float>::value || std::is_same<TStorageType, double>::value || std::is_same<TStorageType, BFloat16>::value,
+                "MixedPrecisionCsrMatrix: storage type must be float, double or BFloat16");
+
+            /**
+             * @brief 是否提供SIMD实现：单精度或 bfloat16 存储且索引为4或8字节整数
+             */
+            static constexpr bool HasSimdKernels = (std::is_same<TStorageType, float>::value || std::is_same<TStorageType, BFloat16>::value)
+                && std::is_integral<TIndexType>::value
+                && (sizeof(TIndexType) == 4 || sizeof(TIndexType) == 8);
+
+            QUEST_CLASS_POINTER_DEFINITION(MixedPrecisionCsrMatrix);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            MixedPrecisionCsrMatrix():
+                mRowIndices(1, 0)
+            {
+            }
+
+            /**
+             * @brief 构造函数，由CSR矩阵转换
+             */
+            template<typename TCsrMatrixType>
+            explicit MixedPrecisionCsrMatrix(const TCsrMatrixType& rCsrMatrix){
+                Build(rCsrMatrix);
+            }
+
+            /**
+             * @brief 复制构造函数
+             */
+            MixedPrecisionCsrMatrix(const MixedPrecisionCsrMatrix& rOther) = default;
+
+            /**
+             * @brief 移动构造函数
+             */
+            MixedPrecisionCsrMatrix(MixedPrecisionCsrMatrix&& rOther) = default;
+
+            /**
+             * @brief 析构函数
+             */
+            ~MixedPrecisionCsrMatrix(){}
+
+            /**
+             * @brief 赋值运算符重载
+             */
+            MixedPrecisionCsrMatrix& operator = (const MixedPrecisionCsrMatrix& rOther) = delete;
+
+            /**
+             * @brief 移动赋值运算符重载
+             */
+            MixedPrecisionCsrMatrix& operator = (MixedPrecisionCsrMatrix&& rOther) = default;
+
+            /**
+             * @brief 由CSR矩阵构建稀疏模式并转换数值
+             * @param rCsrMatrix 提供 index1_data()/index2_data()/value_data()/size1()/size2() 的CSR矩阵
+             * @param pRowScaling 行缩放因子，为空时不缩放
+             * @param pColScaling 列缩放因子，为空时不缩放
+             * @details 非零元个数取 index1_data()[size1()]，因此同样适用于容量大于非零元个数的 ublas 压缩矩阵。
+             *  列数或非零元个数超出 TIndexType 的表示范围时抛出异常
+             */
+            template<typename TCsrMatrixType>
+            void Build(const TCsrMatrixType& rCsrMatrix, const double* pRowScaling = nullptr, const double* pColScaling = nullptr){
+                const auto& r_row_indices = rCsrMatrix.index1_data();
+                const auto& r_col_indices = rCsrMatrix.index2_data();
+                const std::size_t nrows = rCsrMatrix.size1();
+                const std::size_t ncols = rCsrMatrix.size2();
+                const std::size_t nnz = nrows == 0 ? 0 : static_cast<std::size_t>(r_row_indices[nrows]);
+
+                // SIMD收集指令把索引视为有符号数，因此以有符号类型的最大值为界
+                constexpr std::size_t max_index = static_cast<std::size_t>(std::numeric_limits<std::make_signed_t<IndexType>>::max());
+                QUEST_ERROR_IF(nnz > max_index) << "MixedPrecisionCsrMatrix: number of non zeros " << nnz << " exceeds the range of the index type" << std::endl;
+                QUEST_ERROR_IF(ncols > max_index) << "MixedPrecisionCsrMatrix: number of columns " << ncols << " exceeds the range of the index type" << std::endl;
+
+                mNumberOfRows = static_cast<IndexType>(nrows);
+                mNumberOfCols = static_cast<IndexType>(ncols);
+                mNumberOfNonZeros = static_cast<IndexType>(nnz);
+                mpSourceRowIndices = nrows == 0 ? nullptr : static_cast<const void*>(&r_row_indices[0]);
+
+                mRowIndices.resize(nrows+1);
+                mRowIndices[0] = 0;
+                IndexPartition<std::size_t>(nrows).for_each([&](std::size_t i){
+                    mRowIndices[i+1] = static_cast<IndexType>(r_row_indices[i+1]);
+                });
+
+                mColIndices.resize(nnz);
+                IndexPartition<std::size_t>(nnz).for_each([&](std::size_t k){
+                    mColIndices[k] = static_cast<IndexType>(r_col_indices[k]);
+                });
+
+                mValues.resize(nnz);
+                UpdateValues(rCsrMatrix, pRowScaling, pColScaling);
+
+                mSchedule.Build(mRowIndices.data(), mNumberOfRows);
+            }
+
+            /**
+             * @brief 稀疏模式不变时刷新数值
+             * @param rCsrMatrix 构建时使用的CSR矩阵
+             * @param pRowScaling 行缩放因子，为空时不缩放
+             * @param pColScaling 列缩放因子，为空时不缩放
+             */
+            template<typename TCsrMatrixType>
+            void UpdateValues(const TCsrMatrixType& rCsrMatrix, const double* pRowScaling = nullptr, const double* pColScaling = nullptr){
+                QUEST_ERROR_IF_NOT(IsBuiltFor(rCsrMatrix)) << "MixedPrecisionCsrMatrix: the sparsity pattern of the source matrix has changed, call Build instead" << std::endl;
+                const auto& r_values = rCsrMatrix.value_data();
+                IndexPartition<IndexType>(mNumberOfRows).for_each([&](IndexType i){
+                    const double row_factor = pRowScaling == nullptr ? 1.0 : pRowScaling[i];
+                    for(IndexType k=mRowIndices[i]; k<mRowIndices[i+1]; ++k){
+                        const double col_factor = pColScaling == nullptr ? 1.0 : pColScaling[mColIndices[k]];
+                        mValues[k] = ToStorage(row_factor*static_cast<double>(r_values[k])*col_factor);
+                    }
+                });
+            }
+
+            /**
+             * @brief 判断是否由该矩阵的当前稀疏模式构建
+             * @details 比较行索引数组地址、行数、列数与非零元个数
+             */
+            template<typename TCsrMatrixType>
+            bool IsBuiltFor(const TCsrMatrixType& rCsrMatrix) const{
+                const std::size_t nrows = rCsrMatrix.size1();
+                const auto& r_row_indices = rCsrMatrix.index1_data();
+                return nrows == static_cast<std::size_t>(mNumberOfRows)
+                    && rCsrMatrix.size2() == static_cast<std::size_t>(mNumberOfCols)
+                    && (nrows == 0 || (mpSourceRowIndices == static_cast<const void*>(&r_row_indices[0])
+                        && static_cast<std::size_t>(r_row_indices[nrows]) == static_cast<std::size_t>(mNumberOfNonZeros)));
+            }
+
+            /**
+             * @brief 清空矩阵
+             */
+            void Clear(){
+                IndexVectorType(1, 0).swap(mRowIndices);
+                IndexVectorType().swap(mColIndices);
+                StorageVectorType().swap(mValues);
+                mSchedule.Clear();
+                mpSourceRowIndices = nullptr;
+                mNumberOfRows = 0;
+                mNumberOfCols = 0;
+                mNumberOfNonZeros = 0;
+            }
+
+            /**
+             * @brief 返回矩阵行数
+             */
+            IndexType size1() const{
+                return mNumberOfRows;
+            }
+
+            /**
+             * @brief 返回矩阵列数
+             */
+            IndexType size2() const{
+                return mNumberOfCols;
+            }
+
+            /**
+             * @brief 返回非零元个数
+             */
+            IndexType nnz() const{
+                return mNumberOfNonZeros;
+            }
+
+            /**
+             * @brief 返回行索引数组
+             */
+            const IndexVectorType& index1_data() const{
+                return mRowIndices;
+            }
+
+            /**
+             * @brief 返回列索引数组
+             */
+            const IndexVectorType& index2_data() const{
+                return mColIndices;
+            }
+
+            /**
+             * @brief 返回低精度数值数组
+             */
+            const StorageVectorType& value_data() const{
+                return mValues;
+            }
+
+            /**
+             * @brief 返回索引与数值占用的字节数
+             */
+            std::size_t StorageBytes() const{
+                return mRowIndices.size()*sizeof(IndexType) + mColIndices.size()*sizeof(IndexType) + mValues.size()*sizeof(StorageType);
+            }
+
+            /**
+             * @brief 返回第 k 个非零元的双精度数值
+             */
+            double GetValue(const IndexType k) const{
+                return ToDouble(mValues[k]);
+            }
+
+            /**
+             * @brief 计算 y += A * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void SpMV(const TInputVectorType& x, TOutputVectorType& y) const{
+                SpMV(1.0, x, 1.0, y);
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y，累加在双精度下进行
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void SpMV(
+                const double alpha,
+                const TInputVectorType& x,
+                const double beta,
+                TOutputVectorType& y
+            ) const {
+                QUEST_ERROR_IF(static_cast<std::size_t>(size1()) != y.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(static_cast<std::size_t>(size2()) != x.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and input vector size " << x.size() << std::endl;
+                if(size1() == 0){
+                    return;
+                }
+                if constexpr(Internals::IsContiguousVectorOf<double, TInputVectorType>::value && Internals::IsContiguousVectorOf<double, TOutputVectorType>::value){
+                    SpMV(alpha, Internals::ContiguousVectorData<TInputVectorType>::Data(x), beta, Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                } else {
+                    IndexPartition<IndexType>(mNumberOfRows).for_each([&](IndexType i){
+                        double aux = 0.0;
+                        for(IndexType k=mRowIndices[i]; k<mRowIndices[i+1]; ++k){
+                            aux += ToDouble(mValues[k]) * x(mColIndices[k]);
+                        }
+                        y(i) = (beta == 0.0) ? alpha*aux : alpha*aux + beta*y(i);
+                    });
+                }
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y，输入输出为连续的双精度数组
+             * @details 与 CsrSpMVKernels 相同，按 CsrSpMVSchedule 划分短行块与长行；beta 为零时不读取 y
+             */
+            void SpMV(const double alpha, const double* pX, const double beta, double* pY) const{
+                if(!mSchedule.IsBuiltFor(*this)){
+                    mSchedule.Build(mRowIndices.data(), mNumberOfRows);
+                }
+                const SimdLevel level = GetSimdLevel();
+
+                IndexPartition<IndexType>(mSchedule.NumberOfChunks()).for_each([&](IndexType c){
+                    for(IndexType i=mSchedule.ChunkRowBegin(c); i<mSchedule.ChunkRowEnd(c); ++i){
+                        const double sum = RangeDot(level, pX, mRowIndices[i], mRowIndices[i+1]);
+                        pY[i] = (beta == 0.0) ? alpha*sum : alpha*sum + beta*pY[i];
+                    }
+                });
+
+                for(const IndexType i : mSchedule.LongRows()){
+                    const IndexType row_begin = mRowIndices[i];
+                    const IndexType row_nnz = mRowIndices[i+1] - row_begin;
+                    const IndexType chunk_nnz = std::max(mSchedule.ChunkNonZeros(), IndexType(1));
+                    const IndexType num_segments = std::max(IndexType(1), std::min(static_cast<IndexType>((row_nnz + chunk_nnz - 1)/chunk_nnz), static_cast<IndexType>(ParallelUtilities::GetNumThreads())));
+                    const double sum = IndexPartition<IndexType>(num_segments).template for_each<Internals::SumReduction<double>>([&](IndexType s){
+                        const IndexType k_begin = row_begin + static_cast<IndexType>((static_cast<std::size_t>(row_nnz)*s)/num_segments);
+                        const IndexType k_end = row_begin + static_cast<IndexType>((static_cast<std::size_t>(row_nnz)*(s+1))/num_segments);
+                        return RangeDot(level, pX, k_begin, k_end);
+                    });
+                    pY[i] = (beta == 0.0) ? alpha*sum : alpha*sum + beta*pY[i];
+                }
+            }
+
+            /**
+             * @brief 计算按行绝对值之和的最大值（无穷范数），使用存储的低精度数值
+             */
+            double NormInf() const{
+                if(mNumberOfRows == 0){
+                    return 0.0;
+                }
+                return IndexPartition<IndexType>(mNumberOfRows).template for_each<Internals::MaxReduction<double>>([this](IndexType i){
+                    double row_sum = 0.0;
+                    for(IndexType k=mRowIndices[i]; k<mRowIndices[i+1]; ++k){
+                        row_sum += std::abs(ToDouble(mValues[k]));
+                    }
+                    return row_sum;
+                });
+            }
+
+            /**
+             * @brief 返回当前使用的SIMD级别
+             */
+            static SimdLevel GetSimdLevel(){
+                #ifdef QUEST_X86_SIMD_KERNELS
+                    if constexpr(HasSimdKernels){
+                        return CpuFeatures::GetSimdLevel();
+                    }
+                #endif
+                return SimdLevel::Scalar;
+            }
+
+            /**
+             * @brief 把双精度数转换为存储类型
+             */
+            static StorageType ToStorage(const double Value){
+                if constexpr(std::is_same<StorageType, BFloat16>::value){
+                    return BFloat16(static_cast<float>(Value));
+                } else {
+                    return static_cast<StorageType>(Value);
+                }
+            }
+
+            /**
+             * @brief 把存储类型转换为双精度数
+             */
+            static double ToDouble(const StorageType Value){
+                if constexpr(std::is_same<StorageType, BFloat16>::value){
+                    return static_cast<double>(static_cast<float>(Value));
+                } else {
+                    return static_cast<double>(Value);
+                }
+            }
+
+
+            std::string Info() const{
+                return "MixedPrecisionCsrMatrix";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "MixedPrecisionCsrMatrix" << std::endl;
+                PrintData(rOstream);
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "size1 : " << size1() << std::endl;
+                rOstream << "size2 : " << size2() << std::endl;
+                rOstream << "nnz : " << nnz() << std::endl;
+                rOstream << "value bytes : " << sizeof(StorageType) << " index bytes : " << sizeof(IndexType) << " storage bytes : " << StorageBytes() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 计算 sum(values[k]*x[cols[k]]), k 属于 [KBegin, KEnd)
+             */
+            double RangeDot(const SimdLevel Level, const double* pX, const IndexType KBegin, const IndexType KEnd) const{
+                #ifdef QUEST_X86_SIMD_KERNELS
+                    if constexpr(HasSimdKernels){
+                        if(Level == SimdLevel::AVX512){
+                            return RangeDotAVX512(mColIndices.data(), mValues.data(), pX, KBegin, KEnd);
+                        } else if(Level == SimdLevel::AVX2){
+                            return RangeDotAVX2(mColIndices.data(), mValues.data(), pX, KBegin, KEnd);
+                        }
+                    }
+                #endif
+                double sum0 = 0.0;
+                double sum1 = 0.0;
+                IndexType k = KBegin;
+                for(; k+2<=KEnd; k+=2){
+                    sum0 += ToDouble(mValues[k]) * pX[mColIndices[k]];
+                    sum1 += ToDouble(mValues[k+1]) * pX[mColIndices[k+1]];
+                }
+                if(k < KEnd){
+                    sum0 += ToDouble(mValues[k]) * pX[mColIndices[k]];
+                }
+                return sum0 + sum1;
+            }
+
+        #ifdef QUEST_X86_SIMD_KERNELS
+            /**
+             * @brief AVX2 实现，每次处理4个非零元，数值加载后扩展为双精度
+             */
+            __attribute__((target("avx2,fma")))
+            static double RangeDotAVX2(const IndexType* pColIndices, const StorageType* pValues, const double* pX, IndexType k, const IndexType KEnd){
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                for(; k+8<=KEnd; k+=8){
+                    acc0 = _mm256_fmadd_pd(LoadValuesAVX2(pValues+k), GatherAVX2(pColIndices+k, pX), acc0);
+                    acc1 = _mm256_fmadd_pd(LoadValuesAVX2(pValues+k+4), GatherAVX2(pColIndices+k+4, pX), acc1);
+                }
+                if(k+4<=KEnd){
+                    acc0 = _mm256_fmadd_pd(LoadValuesAVX2(pValues+k), GatherAVX2(pColIndices+k, pX), acc0);
+                    k += 4;
+                }
+                acc0 = _mm256_add_pd(acc0, acc1);
+                const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc0), _mm256_extractf128_pd(acc0, 1));
+                double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+                for(; k<KEnd; ++k){
+                    sum += ToDouble(pValues[k]) * pX[pColIndices[k]];
+                }
+                return sum;
+            }
+
+            /**
+             * @brief 加载4个低精度数值并转换为双精度
+             * @details bfloat16 为单精度的高16位，零扩展后左移16位即得到单精度数
+             */
+            __attribute__((target("avx2,fma")))
+            static __m256d LoadValuesAVX2(const StorageType* pValues){
+                if constexpr(std::is_same<StorageType, float>::value){
+                    return _mm256_cvtps_pd(_mm_loadu_ps(pValues));
+                } else {
+                    const __m128i bits = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pValues)));
+                    return _mm256_cvtps_pd(_mm_castsi128_ps(_mm_slli_epi32(bits, 16)));
+                }
+            }
+
+            /**
+             * @brief 以4个列索引从 x 中收集数据
+             */
+            __attribute__((target("avx2,fma")))
+            static __m256d GatherAVX2(const IndexType* pCols, const double* pX){
+                if constexpr(sizeof(IndexType) == 8){
+                    return _mm256_i64gather_pd(pX, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pCols)), 8);
+                } else {
+                    return _mm256_i32gather_pd(pX, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCols)), 8);
+                }
+            }
+
+            /**
+             * @brief AVX-512 实现，每次处理8个非零元，数值加载后扩展为双精度
+             */
+            __attribute__((target("avx512f")))
+            static double RangeDotAVX512(const IndexType* pColIndices, const StorageType* pValues, const double* pX, IndexType k, const IndexType KEnd){
+                __m512d acc0 = _mm512_setzero_pd();
+                __m512d acc1 = _mm512_setzero_pd();
+                for(; k+16<=KEnd; k+=16){
+                    acc0 = _mm512_fmadd_pd(LoadValuesAVX512(pValues+k), GatherAVX512(pColIndices+k, pX), acc0);
+                    acc1 = _mm512_fmadd_pd(LoadValuesAVX512(pValues+k+8), GatherAVX512(pColIndices+k+8, pX), acc1);
+                }
+                if(k+8<=KEnd){
+                    acc0 = _mm512_fmadd_pd(LoadValuesAVX512(pValues+k), GatherAVX512(pColIndices+k, pX), acc0);
+                    k += 8;
+                }
+                double sum = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+                for(; k<KEnd; ++k){
+                    sum += ToDouble(pValues[k]) * pX[pColIndices[k]];
+                }
+                return sum;
+            }
+
+            /**
+             * @brief 加载8个低精度数值并转换为双精度
+             */
+            __attribute__((target("avx512f")))
+            static __m512d LoadValuesAVX512(const StorageType* pValues){
+                if constexpr(std::is_same<StorageType, float>::value){
+                    return _mm512_cvtps_pd(_mm256_loadu_ps(pValues));
+                } else {
+                    const __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pValues)));
+                    return _mm512_cvtps_pd(_mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+                }
+            }
+
+            /**
+             * @brief 以8个列索引从 x 中收集数据
+             */
+            __attribute__((target("avx512f")))
+            static __m512d GatherAVX512(const IndexType* pCols, const double* pX){
+                if constexpr(sizeof(IndexType) == 8){
+                    return _mm512_i64gather_pd(_mm512_loadu_si512(pCols), pX, 8);
+                } else {
+                    return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pCols)), pX, 8);
+                }
+            }
+        #endif
+
+        private:
+            /**
+             * @brief 行索引数组
+             */
+            IndexVectorType mRowIndices;
+
+            /**
+             * @brief 列索引数组
+             */
+            IndexVectorType mColIndices;
+
+            /**
+             * @brief 低精度数值数组
+             */
+            StorageVectorType mValues;
+
+            /**
+             * @brief 矩阵向量乘的行调度，线程数变化时重建
+             */
+            mutable ScheduleType mSchedule;
+
+            /**
+             * @brief 构建时源矩阵行索引数组的地址
+             */
+            const void* mpSourceRowIndices = nullptr;
+
+            /**
+             * @brief 行数
+             */
+            IndexType mNumberOfRows = 0;
+
+            /**
+             * @brief 列数
+             */
+            IndexType mNumberOfCols = 0;
+
+            /**
+             * @brief 非零元个数
+             */
+            IndexType mNumberOfNonZeros = 0;
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_MIXED_PRECISION_CSR_MATRIX_HPP
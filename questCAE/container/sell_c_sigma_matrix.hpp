@@ -0,0 +1,623 @@
+/*--------------------------------------------------------
+SELL-C-σ（分片ELLPACK）格式的稀疏矩阵
+由CSR矩阵转换得到，用于带宽受限的矩阵向量乘
+--------------------------------------------------------*/
+
+#ifndef QUEST_SELL_C_SIGMA_MATRIX_HPP
+#define QUEST_SELL_C_SIGMA_MATRIX_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <type_traits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/csr_spmv_kernels.hpp"
+#include "utilities/cpu_features.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/atomic_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+#ifdef QUEST_X86_SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Quest{
+
+    /**
+     * @class SellCSigmaMatrix
+     * @brief SELL-C-σ 格式的稀疏矩阵
+     * @details 行被分为高度为 C 的块（chunk），块内各行补零到该块的最长行长度，并按列优先存储，
+     *  使得同一块内 C 行的第 j 个非零元在内存中连续，矩阵向量乘时一次SIMD加载即可处理 C 行。
+     *  为减少补零，行在长度为 σ 的窗口内按行长度降序重排，重排只影响存储，SpMV 的输入输出仍按原行号。
+     *  矩阵由CSR矩阵转换得到，稀疏模式不变时只需调用 UpdateValues 刷新数值，组装仍在CSR格式上完成。
+     *  转换时记录每个存储位置对应的CSR偏移量，补零位置记为最大值
+     * @tparam TDataType 存储的数据类型
+     * @tparam TIndexType 存储的索引类型
+     */
+    template<typename TDataType = double, typename TIndexType = std::size_t>
+    class SellCSigmaMatrix final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+            using ValueVectorType = std::vector<TDataType>;
+            using SpMVKernelsType = CsrSpMVKernels<TDataType, TIndexType>;
+
+            /**
+             * @brief 默认排序窗口为块高度的倍数
+             */
+            static constexpr IndexType DefaultSigmaFactor = 32;
+
+            QUEST_CLASS_POINTER_DEFINITION(SellCSigmaMatrix);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            SellCSigmaMatrix():
+                mChunkOffsets(1, 0)
+            {
+            }
+
+            /**
+             * @brief 构造函数，由CSR矩阵转换
+             * @param rCsrMatrix CSR矩阵
+             * @param ChunkHeight 块高度 C，为零时按SIMD宽度选取
+             * @param Sigma 排序窗口 σ，为零时取 DefaultSigmaFactor*C
+             */
+            template<typename TCsrMatrixType>
+            explicit SellCSigmaMatrix(const TCsrMatrixType& rCsrMatrix, const IndexType ChunkHeight = 0, const IndexType Sigma = 0){
+                Build(rCsrMatrix, ChunkHeight, Sigma);
+            }
+
+            /**
+             * @brief 复制构造函数
+             */
+            SellCSigmaMatrix(const SellCSigmaMatrix& rOther) = default;
+
+            /**
+             * @brief 移动构造函数
+             */
+            SellCSigmaMatrix(SellCSigmaMatrix&& rOther) = default;
+
+            /**
+             * @brief 析构函数
+             */
+            ~SellCSigmaMatrix(){}
+
+            /**
+             * @brief 赋值运算符重载
+             */
+            SellCSigmaMatrix& operator = (const SellCSigmaMatrix& rOther) = delete;
+
+            /**
+             * @brief 移动赋值运算符重载
+             */
+            SellCSigmaMatrix& operator = (SellCSigmaMatrix&& rOther) = default;
+
+            /**
+             * @brief 返回当前处理器上推荐的块高度（一个SIMD寄存器可容纳的元素数）
+             */
+            static IndexType DefaultChunkHeight(){
+                return SpMVKernelsType::GetSimdLevel() == SimdLevel::AVX512 ? 8 : 4;
+            }
+
+            /**
+             * @brief 由CSR矩阵构建稀疏模式并复制数值
+             * @param rCsrMatrix 提供 index1_data()/index2_data()/value_data()/size1()/size2() 的CSR矩阵
+             * @param ChunkHeight 块高度 C，为零时按SIMD宽度选取
+             * @param Sigma 排序窗口 σ，为零时取 DefaultSigmaFactor*C，会被向上取整为 C 的倍数
+             */
+            template<typename TCsrMatrixType>
+            void Build(const TCsrMatrixType& rCsrMatrix, IndexType ChunkHeight = 0, IndexType Sigma = 0){
+                const auto& r_row_indices = rCsrMatrix.index1_data();
+                const auto& r_col_indices = rCsrMatrix.index2_data();
+
+                // SIMD收集指令把列索引视为有符号数
+                constexpr std::size_t max_index = static_cast<std::size_t>(std::numeric_limits<std::make_signed_t<IndexType>>::max());
+                QUEST_ERROR_IF(static_cast<std::size_t>(rCsrMatrix.size2()) > max_index) << "SellCSigmaMatrix: number of columns " << rCsrMatrix.size2() << " exceeds the range of the index type" << std::endl;
+
+                mChunkHeight = ChunkHeight == 0 ? DefaultChunkHeight() : ChunkHeight;
+                mSigma = Sigma == 0 ? DefaultSigmaFactor*mChunkHeight : Sigma;
+                mSigma = ((mSigma + mChunkHeight - 1)/mChunkHeight)*mChunkHeight;
+
+                mNumberOfRows = rCsrMatrix.size1();
+                mNumberOfCols = rCsrMatrix.size2();
+                mNumberOfNonZeros = r_col_indices.size();
+                mpSourceRowIndices = r_row_indices.data();
+
+                const IndexType num_chunks = (mNumberOfRows + mChunkHeight - 1)/mChunkHeight;
+
+                // σ 窗口内按行长度降序排列，相同长度保持原顺序
+                mPermutation.resize(num_chunks*mChunkHeight);
+                std::iota(mPermutation.begin(), mPermutation.begin() + mNumberOfRows, IndexType(0));
+                std::fill(mPermutation.begin() + mNumberOfRows, mPermutation.end(), std::numeric_limits<IndexType>::max());
+                const IndexType num_windows = (mNumberOfRows + mSigma - 1)/mSigma;
+                IndexPartition<IndexType>(num_windows).for_each([&](IndexType w){
+                    const IndexType begin = w*mSigma;
+                    const IndexType end = std::min(begin + mSigma, mNumberOfRows);
+                    std::stable_sort(mPermutation.begin() + begin, mPermutation.begin() + end, [&](IndexType a, IndexType b){
+                        return (r_row_indices[a+1] - r_row_indices[a]) > (r_row_indices[b+1] - r_row_indices[b]);
+                    });
+                });
+
+                // 每个块的宽度为块内最长行的长度
+                mChunkLengths.resize(num_chunks);
+                IndexPartition<IndexType>(num_chunks).for_each([&](IndexType c){
+                    IndexType max_length = 0;
+                    for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                        const IndexType row = mPermutation[c*mChunkHeight + lane];
+                        if(row != std::numeric_limits<IndexType>::max()){
+                            max_length = std::max(max_length, static_cast<IndexType>(r_row_indices[row+1] - r_row_indices[row]));
+                        }
+                    }
+                    mChunkLengths[c] = max_length;
+                });
+
+                mChunkOffsets.resize(num_chunks+1);
+                mChunkOffsets[0] = 0;
+                for(IndexType c=0; c<num_chunks; ++c){
+                    mChunkOffsets[c+1] = mChunkOffsets[c] + mChunkLengths[c]*mChunkHeight;
+                }
+
+                // 补零位置的列号取该行的第一个列号（空行取0），使其访问的x仍在缓存中
+                const IndexType storage_size = mChunkOffsets[num_chunks];
+                mColIndices.resize(storage_size);
+                mSourceOffsets.resize(storage_size);
+                IndexPartition<IndexType>(num_chunks).for_each([&](IndexType c){
+                    const IndexType offset = mChunkOffsets[c];
+                    for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                        const IndexType row = mPermutation[c*mChunkHeight + lane];
+                        IndexType row_begin = 0;
+                        IndexType row_length = 0;
+                        IndexType padding_col = 0;
+                        if(row != std::numeric_limits<IndexType>::max()){
+                            row_begin = r_row_indices[row];
+                            row_length = r_row_indices[row+1] - row_begin;
+                            padding_col = row_length > 0 ? static_cast<IndexType>(r_col_indices[row_begin]) : 0;
+                        }
+                        for(IndexType j=0; j<mChunkLengths[c]; ++j){
+                            const IndexType slot = offset + j*mChunkHeight + lane;
+                            if(j < row_length){
+                                mColIndices[slot] = r_col_indices[row_begin + j];
+                                mSourceOffsets[slot] = row_begin + j;
+                            } else {
+                                mColIndices[slot] = padding_col;
+                                mSourceOffsets[slot] = std::numeric_limits<IndexType>::max();
+                            }
+                        }
+                    }
+                });
+
+                mValues.resize(storage_size);
+                UpdateValues(rCsrMatrix);
+            }
+
+            /**
+             * @brief 稀疏模式不变时，从CSR矩阵刷新数值
+             */
+            template<typename TCsrMatrixType>
+            void UpdateValues(const TCsrMatrixType& rCsrMatrix){
+                QUEST_DEBUG_ERROR_IF_NOT(IsBuiltFor(rCsrMatrix)) << "UpdateValues: the SELL-C-sigma pattern does not match the CSR matrix" << std::endl;
+                const auto& r_values = rCsrMatrix.value_data();
+                IndexPartition<IndexType>(mValues.size()).for_each([&](IndexType s){
+                    const IndexType src = mSourceOffsets[s];
+                    mValues[s] = (src == std::numeric_limits<IndexType>::max()) ? TDataType() : r_values[src];
+                });
+            }
+
+            /**
+             * @brief 判断稀疏模式是否由给定的CSR矩阵转换而来
+             * @details 比较行索引数组地址、行数与非零元个数，CSR稀疏模式重建后应重新调用 Build
+             */
+            template<typename TCsrMatrixType>
+            bool IsBuiltFor(const TCsrMatrixType& rCsrMatrix) const{
+                return mChunkHeight != 0
+                    && mpSourceRowIndices == rCsrMatrix.index1_data().data()
+                    && mNumberOfRows == rCsrMatrix.size1()
+                    && mNumberOfNonZeros == rCsrMatrix.index2_data().size();
+            }
+
+            /**
+             * @brief 清空矩阵
+             */
+            void Clear(){
+                mChunkOffsets.assign(1, 0);
+                IndexVectorType().swap(mChunkLengths);
+                IndexVectorType().swap(mPermutation);
+                IndexVectorType().swap(mColIndices);
+                IndexVectorType().swap(mSourceOffsets);
+                ValueVectorType().swap(mValues);
+                mpSourceRowIndices = nullptr;
+                mChunkHeight = 0;
+                mSigma = 0;
+                mNumberOfRows = 0;
+                mNumberOfCols = 0;
+                mNumberOfNonZeros = 0;
+            }
+
+            /**
+             * @brief 将所有非零元设置为value，补零位置保持为零
+             */
+            void SetValue(const TDataType value){
+                IndexPartition<IndexType>(mValues.size()).for_each([&](IndexType s){
+                    mValues[s] = (mSourceOffsets[s] == std::numeric_limits<IndexType>::max()) ? TDataType() : value;
+                });
+            }
+
+            /**
+             * @brief 返回矩阵行数
+             */
+            IndexType size1() const{
+                return mNumberOfRows;
+            }
+
+            /**
+             * @brief 返回矩阵列数
+             */
+            IndexType size2() const{
+                return mNumberOfCols;
+            }
+
+            /**
+             * @brief 返回非零元个数（不含补零）
+             */
+            IndexType nnz() const{
+                return mNumberOfNonZeros;
+            }
+
+            /**
+             * @brief 返回存储的元素个数（含补零）
+             */
+            IndexType StorageSize() const{
+                return mValues.size();
+            }
+
+            /**
+             * @brief 返回块高度 C
+             */
+            IndexType ChunkHeight() const{
+                return mChunkHeight;
+            }
+
+            /**
+             * @brief 返回排序窗口 σ
+             */
+            IndexType Sigma() const{
+                return mSigma;
+            }
+
+            /**
+             * @brief 返回块数
+             */
+            IndexType NumberOfChunks() const{
+                return mChunkLengths.size();
+            }
+
+            /**
+             * @brief 返回填充率（非零元个数与存储元素个数之比）
+             */
+            double FillEfficiency() const{
+                return mValues.empty() ? 1.0 : static_cast<double>(mNumberOfNonZeros)/static_cast<double>(mValues.size());
+            }
+
+            /**
+             * @brief 返回重排后位置到原行号的映射，末块中多余的位置为最大值
+             */
+            const IndexVectorType& GetPermutation() const{
+                return mPermutation;
+            }
+
+            /**
+             * @brief 计算 y += A * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void SpMV(const TInputVectorType& x, TOutputVectorType& y) const{
+                SpMV(TDataType(1), x, TDataType(1), y);
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y, 其中A为当前矩阵，x为输入向量，y为输出向量
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void SpMV(
+                const TDataType alpha,
+                const TInputVectorType& x,
+                const TDataType beta,
+                TOutputVectorType& y
+            ) const {
+                QUEST_ERROR_IF(size1() != y.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(size2() != x.size()) << "SpMV: mismatch between matrix sizes : " << size1() << " " <<size2() << " and input vector size " << x.size() << std::endl;
+                if(size1() == 0){
+                    return;
+                }
+                if constexpr(Internals::IsContiguousVectorOf<TDataType, TInputVectorType>::value && Internals::IsContiguousVectorOf<TDataType, TOutputVectorType>::value){
+                    SpMV(alpha, Internals::ContiguousVectorData<TInputVectorType>::Data(x), beta, Internals::ContiguousVectorData<TOutputVectorType>::Data(y));
+                } else {
+                    IndexPartition<IndexType>(NumberOfChunks()).for_each(ValueVectorType(mChunkHeight), [&](IndexType c, ValueVectorType& rSums){
+                        const IndexType offset = mChunkOffsets[c];
+                        std::fill(rSums.begin(), rSums.end(), TDataType());
+                        for(IndexType j=0; j<mChunkLengths[c]; ++j){
+                            for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                                const IndexType slot = offset + j*mChunkHeight + lane;
+                                rSums[lane] += mValues[slot] * x(mColIndices[slot]);
+                            }
+                        }
+                        for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                            const IndexType row = mPermutation[c*mChunkHeight + lane];
+                            if(row != std::numeric_limits<IndexType>::max()){
+                                y(row) = (beta == TDataType()) ? alpha*rSums[lane] : alpha*rSums[lane] + beta*y(row);
+                            }
+                        }
+                    });
+                }
+            }
+
+            /**
+             * @brief 计算 y = alpha*A*x + beta*y，输入输出为连续数组
+             * @details 块高度为SIMD宽度的倍数时使用 AVX-512/AVX2 核函数，否则使用标量实现
+             */
+            void SpMV(const TDataType alpha, const TDataType* pX, const TDataType beta, TDataType* pY) const{
+                const SimdLevel level = SpMVKernelsType::GetSimdLevel();
+                IndexPartition<IndexType>(NumberOfChunks()).for_each(ValueVectorType(mChunkHeight), [&](IndexType c, ValueVectorType& rSums){
+                    ChunkProduct(level, c, pX, rSums.data());
+                    const IndexType* p_rows = mPermutation.data() + c*mChunkHeight;
+                    for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                        const IndexType row = p_rows[lane];
+                        if(row != std::numeric_limits<IndexType>::max()){
+                            pY[row] = (beta == TDataType()) ? alpha*rSums[lane] : alpha*rSums[lane] + beta*pY[row];
+                        }
+                    }
+                });
+            }
+
+            /**
+             * @brief 计算 y += AT * x, 其中A为当前矩阵，x为输入向量，y为输出向量
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void TransposeSpMV(const TInputVectorType& x, TOutputVectorType& y) const{
+                TransposeSpMV(TDataType(1), x, TDataType(1), y);
+            }
+
+            /**
+             * @brief 计算 y = alpha*AT*x + beta*y, 其中A为当前矩阵，x为输入向量，y为输出向量
+             * @details 补零位置的数值为零，参与累加不影响结果
+             */
+            template<typename TInputVectorType, typename TOutputVectorType>
+            void TransposeSpMV(
+                const TDataType alpha,
+                const TInputVectorType& x,
+                const TDataType beta,
+                TOutputVectorType& y
+            ) const {
+                QUEST_ERROR_IF(size2() != y.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and destination vector size " << y.size() << std::endl;
+                QUEST_ERROR_IF(size1() != x.size()) << "TransposeSpMV: mismatch between transpose matrix sizes : " << size2() << " " <<size1() << " and input vector size " << x.size() << std::endl;
+                IndexPartition<IndexType>(y.size()).for_each([&](IndexType i){
+                    y(i) = (beta == TDataType()) ? TDataType() : beta*y(i);
+                });
+                IndexPartition<IndexType>(NumberOfChunks()).for_each([&](IndexType c){
+                    const IndexType offset = mChunkOffsets[c];
+                    for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                        const IndexType row = mPermutation[c*mChunkHeight + lane];
+                        if(row == std::numeric_limits<IndexType>::max()){
+                            continue;
+                        }
+                        const TDataType factor = alpha * x(row);
+                        for(IndexType j=0; j<mChunkLengths[c]; ++j){
+                            const IndexType slot = offset + j*mChunkHeight + lane;
+                            if(mSourceOffsets[slot] != std::numeric_limits<IndexType>::max()){
+                                AtomicAdd(y(mColIndices[slot]), factor*mValues[slot]);
+                            }
+                        }
+                    }
+                });
+            }
+
+            /**
+             * @brief 计算稀疏矩阵的 Frobenius 范数
+             */
+            TDataType NormFrobenius() const{
+                const TDataType sum2 = IndexPartition<IndexType>(mValues.size()).template for_each<Internals::SumReduction<TDataType>>([this](IndexType s){
+                    return mValues[s]*mValues[s];
+                });
+                return std::sqrt(sum2);
+            }
+
+
+            std::string Info() const{
+                std::stringstream buffer;
+                buffer << "SellCSigmaMatrix";
+                return buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "SellCSigmaMatrix" << std::endl;
+                PrintData(rOstream);
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "size1 : " << size1() << std::endl;
+                rOstream << "size2 : " << size2() << std::endl;
+                rOstream << "nnz : " << nnz() << std::endl;
+                rOstream << "C : " << mChunkHeight << " sigma : " << mSigma << std::endl;
+                rOstream << "number of chunks : " << NumberOfChunks() << " fill efficiency : " << FillEfficiency() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 计算第 c 个块内 C 行的乘积，结果按块内位置写入 pSums
+             */
+            void ChunkProduct(const SimdLevel Level, const IndexType c, const TDataType* pX, TDataType* pSums) const{
+                const IndexType offset = mChunkOffsets[c];
+                const IndexType length = mChunkLengths[c];
+                const IndexType* p_cols = mColIndices.data() + offset;
+                const TDataType* p_values = mValues.data() + offset;
+
+                #ifdef QUEST_X86_SIMD_KERNELS
+                    if constexpr(SpMVKernelsType::HasSimdKernels){
+                        if(Level == SimdLevel::AVX512 && mChunkHeight % 8 == 0){
+                            ChunkProductAVX512(p_cols, p_values, pX, length, mChunkHeight, pSums);
+                            return;
+                        } else if(Level >= SimdLevel::AVX2 && mChunkHeight % 4 == 0){
+                            ChunkProductAVX2(p_cols, p_values, pX, length, mChunkHeight, pSums);
+                            return;
+                        }
+                    }
+                #endif
+
+                std::fill(pSums, pSums + mChunkHeight, TDataType());
+                for(IndexType j=0; j<length; ++j){
+                    const IndexType* p_cols_j = p_cols + j*mChunkHeight;
+                    const TDataType* p_values_j = p_values + j*mChunkHeight;
+                    for(IndexType lane=0; lane<mChunkHeight; ++lane){
+                        pSums[lane] += p_values_j[lane] * pX[p_cols_j[lane]];
+                    }
+                }
+            }
+
+        #ifdef QUEST_X86_SIMD_KERNELS
+            /**
+             * @brief AVX2 实现，每4个通道使用一个累加器
+             */
+            __attribute__((target("avx2,fma")))
+            static void ChunkProductAVX2(
+                const IndexType* pCols,
+                const double* pValues,
+                const double* pX,
+                const IndexType Length,
+                const IndexType Height,
+                double* pSums
+            ){
+                for(IndexType lane=0; lane<Height; lane+=4){
+                    __m256d acc = _mm256_setzero_pd();
+                    for(IndexType j=0; j<Length; ++j){
+                        const IndexType slot = j*Height + lane;
+                        __m256d x;
+                        if constexpr(sizeof(IndexType) == 8){
+                            x = _mm256_i64gather_pd(pX, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pCols + slot)), 8);
+                        } else {
+                            x = _mm256_i32gather_pd(pX, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCols + slot)), 8);
+                        }
+                        acc = _mm256_fmadd_pd(_mm256_loadu_pd(pValues + slot), x, acc);
+                    }
+                    _mm256_storeu_pd(pSums + lane, acc);
+                }
+            }
+
+            /**
+             * @brief AVX-512 实现，每8个通道使用一个累加器
+             */
+            __attribute__((target("avx512f")))
+            static void ChunkProductAVX512(
+                const IndexType* pCols,
+                const double* pValues,
+                const double* pX,
+                const IndexType Length,
+                const IndexType Height,
+                double* pSums
+            ){
+                for(IndexType lane=0; lane<Height; lane+=8){
+                    __m512d acc = _mm512_setzero_pd();
+                    for(IndexType j=0; j<Length; ++j){
+                        const IndexType slot = j*Height + lane;
+                        __m512d x;
+                        if constexpr(sizeof(IndexType) == 8){
+                            x = _mm512_i64gather_pd(_mm512_loadu_si512(pCols + slot), pX, 8);
+                        } else {
+                            x = _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pCols + slot)), pX, 8);
+                        }
+                        acc = _mm512_fmadd_pd(_mm512_loadu_pd(pValues + slot), x, acc);
+                    }
+                    _mm512_storeu_pd(pSums + lane, acc);
+                }
+            }
+        #endif
+
+        private:
+            /**
+             * @brief 每个块在存储数组中的起始位置（大小为块数+1）
+             */
+            IndexVectorType mChunkOffsets;
+
+            /**
+             * @brief 每个块的宽度（块内最长行的长度）
+             */
+            IndexVectorType mChunkLengths;
+
+            /**
+             * @brief 重排后位置到原行号的映射
+             */
+            IndexVectorType mPermutation;
+
+            /**
+             * @brief 按块列优先存储的列索引
+             */
+            IndexVectorType mColIndices;
+
+            /**
+             * @brief 每个存储位置对应的CSR值数组偏移量，补零位置为最大值
+             */
+            IndexVectorType mSourceOffsets;
+
+            /**
+             * @brief 按块列优先存储的数值
+             */
+            ValueVectorType mValues;
+
+            /**
+             * @brief 转换时CSR行索引数组的地址
+             */
+            const IndexType* mpSourceRowIndices = nullptr;
+
+            /**
+             * @brief 块高度 C
+             */
+            IndexType mChunkHeight = 0;
+
+            /**
+             * @brief 排序窗口 σ
+             */
+            IndexType mSigma = 0;
+
+            /**
+             * @brief 矩阵的行数
+             */
+            IndexType mNumberOfRows = 0;
+
+            /**
+             * @brief 矩阵的列数
+             */
+            IndexType mNumberOfCols = 0;
+
+            /**
+             * @brief 非零元个数（不含补零）
+             */
+            IndexType mNumberOfNonZeros = 0;
+
+    };
+
+
+    template<typename TDataType, typename TIndexType>
+    inline std::istream& operator >> (std::istream& rIstream, SellCSigmaMatrix<TDataType, TIndexType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TDataType, typename TIndexType>
+    inline std::ostream& operator << (std::ostream& rOstream, const SellCSigmaMatrix<TDataType, TIndexType>& rThis){
+        rThis.PrintInfo(rOstream);
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_SELL_C_SIGMA_MATRIX_HPP
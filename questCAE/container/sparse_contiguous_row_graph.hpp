@@ -3,8 +3,7 @@
 
 // 系统头文件
 #include <iostream>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 // 第三方头文件
 #include "span/span.hpp"
@@ -13,50 +12,50 @@
 #include "includes/define.hpp"
 #include "includes/ublas_interface.hpp"
 #include "includes/serializer.hpp"
-#include "includes/lock_object.hpp"
 #include "includes/parallel_enviroment.hpp"
 #include "utilities/parallel_utilities.hpp"
+#include "container/sparse_graph_builder.hpp"
 
 namespace Quest{
 
     /**
      * @class SparseContiguousRowGraph
      * @brief 稀疏图结构，用于存储矩阵的稀疏表示，特别适合构造压缩行存储（CSR）格式的矩阵或其他类型的稀疏矩阵
+     * @details 行数在构造时确定。图以扁平的CSR数组存储（见 SparseGraphBuilder），
+     *  AddEntry/AddEntries 写入线程私有的暂存区，并行添加时无需逐行加锁；
+     *  查询与导出前需调用 Finalize() 合并暂存条目
      */
     template<typename TIndexType = std::size_t>
     class SparseContiguousRowGraph final{
         public:
             using IndexType = TIndexType;
-            using GraphType = DenseVector<std::unordered_set<IndexType>>;
-            using const_row_iterator = typename GraphType::const_iterator;
+            using GraphType = SparseGraphBuilder<IndexType>;
+            using RowType = Quest::span<const IndexType>;
 
             QUEST_CLASS_POINTER_DEFINITION(SparseContiguousRowGraph);
 
         public:
             class const_iterator_adaptor{
                 private:
-                    const_row_iterator map_iterator;
-                    const row_iterator mbegin;
+                    const GraphType* mpGraph;
+                    IndexType mRowIndex;
 
                 public:
                     using iterator_category = std::forward_iterator_tag;
                     using difference_type   = std::ptrdiff_t;
-                    using value_type        = typename GraphType::value_type;
-                    using pointer           = typename GraphType::value_type*;
-                    using reference         = typename GraphType::value_type&;
+                    using value_type        = RowType;
+                    using pointer           = RowType*;
+                    using reference         = RowType&;
 
                 public:
-                    const_iterator_adaptor(const_row_iterator it): map_iterator(it), mbegin(it){}
-                    const_iterator_adaptor(const const_iterator_adaptor& it): map_iterator(it.map_iterator), mbegin(it.mbegin){}
-                    const_iterator_adaptor& operator ++ () {mpa_iteartor++; return *this;}
+                    const_iterator_adaptor(const GraphType* pGraph, IndexType RowIndex): mpGraph(pGraph), mRowIndex(RowIndex){}
+                    const_iterator_adaptor(const const_iterator_adaptor& it): mpGraph(it.mpGraph), mRowIndex(it.mRowIndex){}
+                    const_iterator_adaptor& operator ++ () {mRowIndex++; return *this;}
                     const_iterator_adaptor operator ++ (int) {const_iterator_adaptor tmp(*this); operator ++(); return tmp;}
-                    bool operator == (const const_iterator_adaptor& rhs) const {return map_iterator == rhs.map_iterator;}
-                    bool operator!= (const const_iterator_adaptor& rhs) const {return map_iterator!= rhs.map_iterator;}
-                    const typename GraphType::value_type& operator * () const {return *map_iterator;}
-                    const typename GraphType::value_type& operator -> () const {return *map_iterator;}
-                    const_row_iterator& base() {return map_iterator;}
-                    const const_row_iterator& base() const {return map_iterator;}
-                    IndexType GetRowIndex() const{return map_iterator-mbegin;}
+                    bool operator == (const const_iterator_adaptor& rhs) const {return mRowIndex == rhs.mRowIndex;}
+                    bool operator!= (const const_iterator_adaptor& rhs) const {return mRowIndex != rhs.mRowIndex;}
+                    RowType operator * () const {return (*mpGraph)[mRowIndex];}
+                    IndexType GetRowIndex() const{return mRowIndex;}
             };
 
         public:
@@ -70,14 +69,10 @@ namespace Quest{
             /**
              * @brief 构造函数
              */
-            SparseContiguousRowGraph(IndexType GraphSize){
+            SparseContiguousRowGraph(IndexType GraphSize):
+                mGraph(GraphSize)
+            {
                 mpComm = &ParallelEnvironment::GetDataCommunicator("Serial");
-                mGraph.resize(GraphSize, false);
-                mLocks = decltype(mLocks)(GraphSize);
-
-                IndexPartition<IndexType>(GraphSize).for_each([&](IndexType i){
-                    mGraph[i] = std::unordered_set<IndexType>();
-                });
             }
 
             /**
@@ -93,14 +88,10 @@ namespace Quest{
             /**
              * @brief 拷贝构造函数
              */
-            SparseContiguousRowGraph(const SparseContiguousRowGraph& rOther){
-                mpComm = rOther.mpComm;
-                mGraph.resize(rOther.mGraph.size());
-                IndexPartition<IndexType>(rOther.mGraph.size()).for_each([&](IndexType i){
-                    mGraph[i] = rOther.unordered_set<IndexType>();
-                });
-                mLocks = decltype(mLocks)(rOther.mLocks);
-                this->AddEntries(rOther);
+            SparseContiguousRowGraph(const SparseContiguousRowGraph& rOther):
+                mpComm(rOther.mpComm),
+                mGraph(rOther.mGraph)
+            {
             }
 
             /**
@@ -121,29 +112,28 @@ namespace Quest{
              * @brief 清空容器
              */
             void Clear(){
-                mGraph.clear();
-                mLocks.clear();
+                mGraph.Clear();
             }
 
             /**
              * @brief 获取矩阵行数
              */
             inline IndexType Size() const{
-                return mGraph.size();
+                return mGraph.Size();
             }
 
             /**
              * @brief 检查（i,j）是否存在
+             * @details 存在尚未合并的暂存条目时抛出异常，添加条目后须先调用 Finalize()
              */
             bool Has(const IndexType i, const IndexType j) const{
-                const auto& row = mGraph[i];
-                return (ro.find(j) != row.end());
+                return mGraph.Has(i, j);
             }
 
             /**
-             * @brief 下标访问，获取第i行的元素
+             * @brief 下标访问，获取第i行的列索引（升序）
              */
-            const typename GraphType::value_type& operator [] (const IndexType& i) const{
+            RowType operator [] (const IndexType& i) const{
                 return mGraph[i];
             }
 
@@ -165,9 +155,9 @@ namespace Quest{
              * @brief 添加一个元素
              */
             void AddEntry(const IndexType RowIndex, const IndexType ColIndex){
-                mLocks[RowIndex].lock();
-                mGraph[RowIndex].insert(ColIndex);
-                mLocks[RowIndex].unlock();
+                QUEST_DEBUG_ERROR_IF(RowIndex >= mGraph.NumberOfRows()) << "Index : " << RowIndex
+                    << " exceeds the graph size : " << mGraph.NumberOfRows() << std::endl;
+                mGraph.AddBlock(&RowIndex, &RowIndex+1, &ColIndex, &ColIndex+1);
             }
 
             /**
@@ -175,9 +165,9 @@ namespace Quest{
              */
             template<typename TContainerType>
             void AddEntries(const IndexType RowIndex, const TContainerType& rColIndices){
-                mLocks[RowIndex].lock();
-                mGraph[RowIndex].insert(rColIndices.begin(), rColIndices.end());
-                mLocks[RowIndex].unlock();
+                QUEST_DEBUG_ERROR_IF(RowIndex >= mGraph.NumberOfRows()) << "Index : " << RowIndex
+                    << " exceeds the graph size : " << mGraph.NumberOfRows() << std::endl;
+                mGraph.AddBlock(&RowIndex, &RowIndex+1, rColIndices.begin(), rColIndices.end());
             }
 
             /**
@@ -189,9 +179,9 @@ namespace Quest{
                 const TIteratorType& rColBegin,
                 const TIteratorType& rColEnd
             ){
-                mLocks[RowIndex].lock();
-                mGraph[RowIndex].insert(rColBegin, rColEnd);
-                mLocks[RowIndex].unlock();
+                QUEST_DEBUG_ERROR_IF(RowIndex >= mGraph.NumberOfRows()) << "Index : " << RowIndex
+                    << " exceeds the graph size : " << mGraph.NumberOfRows() << std::endl;
+                mGraph.AddBlock(&RowIndex, &RowIndex+1, rColBegin, rColEnd);
             }
 
             /**
@@ -200,12 +190,10 @@ namespace Quest{
             template<typename TContainerType>
             void AddEntries(const TContainerType& rIndices){
                 for(auto i : rIndices){
-                    QUEST_DEBUG_ERROR_IF(i > this->Size()) << "Index : " << I
-                        << " exceeds the graph size : " << Size() << std::endl;
-                    mLocks[i].lock();
-                    mGraph[i].insert(rIndices.begin(), rIndices.end());
-                    mLocks[i].unlock();
+                    QUEST_DEBUG_ERROR_IF(i >= mGraph.NumberOfRows()) << "Index : " << i
+                        << " exceeds the graph size : " << mGraph.NumberOfRows() << std::endl;
                 }
+                mGraph.AddBlock(rIndices.begin(), rIndices.end(), rIndices.begin(), rIndices.end());
             }
 
             /**
@@ -214,26 +202,46 @@ namespace Quest{
             template<typename TContainerType>
             void AddEntries(const TContainerType& rRowIndices, const TContainerType& rColIndices){
                 for(auto i : rRowIndices){
-                    AddEntries(i, rColIndices);
+                    QUEST_DEBUG_ERROR_IF(i >= mGraph.NumberOfRows()) << "Index : " << i
+                        << " exceeds the graph size : " << mGraph.NumberOfRows() << std::endl;
                 }
+                mGraph.AddBlock(rRowIndices.begin(), rRowIndices.end(), rColIndices.begin(), rColIndices.end());
             }
 
             /**
              * @brief 添加一组元素
              */
             void AddEntries(const SparseContiguousRowGraph& rOther){
-                for(IndexType i=0;i<rOther.Size();i++){
-                    AddEntries(i, rOther.GetGraph()[i]);
-                }
+                IndexPartition<IndexType>(rOther.Size()).for_each([&](IndexType i){
+                    const auto row = rOther[i];
+                    AddEntries(i, row.begin(), row.end());
+                });
+            }
+
+            /**
+             * @brief 由实体连接关系“两遍”构建图
+             * @details rGetEntityIndices(i, rIndices) 需把第 i 个实体的方程编号写入 rIndices，
+             *  计数与填充两遍中各调用一次。结果直接合并进CSR数组，无需再调用 Finalize()
+             * @param NumberOfEntities 实体个数
+             * @param rGetEntityIndices 获取实体方程编号的函数
+             */
+            template<typename TFunctionType>
+            void AddEntriesFromConnectivity(
+                const IndexType NumberOfEntities,
+                TFunctionType&& rGetEntityIndices
+            ){
+                mGraph.AddEntriesFromConnectivity(NumberOfEntities, std::forward<TFunctionType>(rGetEntityIndices), this->Size());
             }
 
             /**
-             * @brief 结束并行化
+             * @brief 合并暂存条目
              */
-            void Finalize(){}
+            void Finalize(){
+                mGraph.Finalize();
+            }
 
             /**
-             * @brief 获取图的邻接表表示
+             * @brief 获取图的存储结构(CSR数组)
              */
             const GraphType& GetGraph() const{
                 return mGraph;
@@ -248,28 +256,7 @@ namespace Quest{
                 TVectorType& rRowIndices,
                 TVectorType& rColIndices
             ) const {
-                IndexType* pRowIndicesDataSize = nullptr;
-                IndexType RowIndicesDataSize = 0;
-                IndexType* pColIndicesDataSize = nullptr;
-                IndexType ColIndicesDataSize = 0;
-                ExportCSRArrays(pRowIndicesDataSize, RowIndicesDataSize, pColIndicesDataSize, ColIndicesDataSize);
-                if(rRowIndices.size() != RowIndicesDataSize){
-                    rRowIndices.resize(RowIndicesDataSize);
-                }
-                IndexPartition<IndexType>(RowIndicesDataSize).for_each([&](IndexType i){
-                    rRowIndices[i] = pRowIndicesData[i];
-                });
-
-                delete[] pRowIndicesData;
-                if(rColIndices.size() != ColIndicesDataSize){
-                    rColIndices.resize(ColIndicesDataSize);
-                }
-                IndexPartition<IndexType>(ColIndicesDataSize).for_each([&](IndexType i){
-                    rColIndices[i] = pColIndicesData[i];
-                });
-                delete[] pColIndicesData;
-
-                return rRowIndices.size();
+                return mGraph.ExportCSRArrays(rRowIndices, rColIndices);
             }
 
             /**
@@ -283,74 +270,32 @@ namespace Quest{
 
             /**
              * @brief 导出CSR格式的数组
-             * 
+             * @details 数组由 new[] 分配，所有权转移给调用者
              */
+            template<typename TOutputIndexType>
             IndexType ExportCSRArrays(
-                IndexType*& pRowIndicesData,
-                IndexType& rRowDataSize,
-                IndexType*& pColIndicesData,
-                IndexType& rColDataSize
+                TOutputIndexType*& pRowIndicesData,
+                TOutputIndexType& rRowDataSize,
+                TOutputIndexType*& pColIndicesData,
+                TOutputIndexType& rColDataSize
             ) const {
-                IndexType nrows = this->Size();
-
-                pRowIndicesData = new IndexType[nrows+1];
-                rRowDataSize = nrows+1;
-                Quest::span<IndexType> row_indices(pRowIndicesData, nrows+1);
-
-                if(nrows == 0){
-                    row_indices[0] = 0;
-                } else {
-                    IndexPartition<IndexType>(nrows+1).for_each([&](IndexType i){
-                        row_indices[i] = 0;
-                    });
-
-                    IndexPartition<IndexType>(nrows).for_each([&](IndexType i){ 
-                        row_indices[i+1] = mGraph[i].size();
-                    });
-
-                    for(IndexType i = 1; i < static_cast<IndexType>(row_indices.size()); ++i){
-                        row_indices[i] += row_indices[i-1];
-                    }
-                }
-
-                IndexType nnz = row_indices[nrows];
-                rColDataSize = nnz;
-                pColIndicesData = new IndexType[nnz];
-                Quest::span<IndexType> col_indices(pColIndicesData, nnz);
-
-                IndexPartition<IndexType>(col_indices.size()).for_each([&](IndexType i){
-                    col_indices[i] = 0;
-                });
-
-                IndexPartition<IndexType>(nrows).for_each([&](IndexType i){
-                    IndexType start = row_indices[i];
-
-                    IndexType counter = 0;
-                    for(auto j : mGraph[i]){
-                        col_indices[start+counter] = j;
-                        counter++;
-                    }
-                });
-
-
-                IndexPartition<IndexType>(row_indices.size()-1).for_each([&](IndexType i){
-                    std::sort(col_indices.begin()+row_indices[i], col_indices.begin()+row_indices[i+1]);
-                });
-
-                return nrows;
+                return mGraph.ExportCSRArrays(pRowIndicesData, rRowDataSize, pColIndicesData, rColDataSize);
             }
 
             /**
              * @brief 将图作为单个向量导出
              * @details 格式为：行索引 行中条目数量 行中所有索引的列表
              */
-            std::vector<IndexType> ExportSingleVectorRepresentation(){
+            std::vector<IndexType> ExportSingleVectorRepresentation() const {
+                QUEST_ERROR_IF(mGraph.HasPendingEntries()) << "The graph has staged entries which were not merged. Please call Finalize() before exporting" << std::endl;
+
                 std::vector<IndexType> IJ;
-                IJ.push_back(GetGraph().size());
-                for(unsigned int I=0; I<GetGraph().size(); ++I){
+                IJ.push_back(Size());
+                for(IndexType I=0; I<Size(); ++I){
+                    const auto row = mGraph[I];
                     IJ.push_back(I);
-                    IJ.push_back(mGraph[I].size());
-                    for(auto j : mGraph[I]){
+                    IJ.push_back(row.size());
+                    for(auto j : row){
                         IJ.push_back(j);
                     }
                 }
@@ -359,10 +304,11 @@ namespace Quest{
 
             /**
              * @brief 从单个向量导入图
+             * @details 条目写入暂存区，读取前须调用 Finalize()
              */
             void AddFromSingleVectorRepresentation(const std::vector<IndexType>& rSingleVectorRepresentation){
                 auto graph_size = rSingleVectorRepresentation[0];
-                QUEST_ERROR_IF(graph_size > GetGraph().size()) 
+                QUEST_ERROR_IF(graph_size > Size()) 
                     << "mismatching size - attempting to add a graph with more rows than the ones allowed in graph" << std::endl;
                 IndexType counter = 1;
                 while(counter < rSingleVectorRepresentation.size()){
@@ -375,17 +321,17 @@ namespace Quest{
             }
 
             /**
-             * @brief 返回DenseVector的首元素的迭代器
+             * @brief 返回指向首行的迭代器
              */
             const_iterator_adaptor begin() const{
-                return const_iterator_adaptor(mGraph.begin());
+                return const_iterator_adaptor(&mGraph, 0);
             }
 
             /**
-             * @brief 返回DenseVector的尾元素的迭代器
+             * @brief 返回指向尾行之后的迭代器
              */
             const_iterator_adaptor end() const{
-                return const_iterator_adaptor(mGraph.end());
+                return const_iterator_adaptor(&mGraph, mGraph.Size());
             }
 
 
@@ -409,12 +355,15 @@ namespace Quest{
             friend class Serializer;
 
             void save(Serializer& rSerializer) const{
+                QUEST_ERROR_IF(mGraph.HasPendingEntries()) << "The graph has staged entries which were not merged. Please call Finalize() before saving" << std::endl;
+
                 const IndexType N = this->Size();
                 rSerializer.save("GraphSize",N);
                 for(IndexType i=0;i<N;i++){
-                    IndexType row_size = mGraph[i].size();
+                    const auto row = mGraph[i];
+                    IndexType row_size = row.size();
                     rSerializer.save("row_size",row_size);
-                    for(auto j : mGraph[i]){
+                    for(auto j : row){
                         rSerializer.save("J",j);
                     }
                 }
@@ -425,8 +374,7 @@ namespace Quest{
                 IndexType size;
                 rSerializer.load("GraphSize",size);
 
-                mLocks = decltype(mLocks)(size);
-                mGraph.resize(size);
+                mGraph = GraphType(size);
 
                 for(IndexType i=0;i<size;i++){
                     IndexType row_size;
@@ -437,6 +385,7 @@ namespace Quest{
                         AddEntry(i,J);
                     }
                 }
+                Finalize();
             }
 
         private:
@@ -446,17 +395,11 @@ namespace Quest{
             DataCommunicator* mpComm;
 
             /**
-             * @brief 图的邻接表表示
-             * @details DenseVector<std::unordered_set<IndexType>>
-             *  存储每行的非零元素集合
+             * @brief 图的存储结构
+             * @details 扁平CSR数组，每行的列索引升序且唯一，另含线程私有的暂存缓冲区
              */
             GraphType mGraph;
 
-            /**
-             * @brief 锁对象数组
-             */
-            std::vector<LockObject> mLocks;
-
     };
 
 
@@ -3,8 +3,7 @@
 
 // 系统头文件
 #include <iostream>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 // 第三方头文件
 #include "span/span.hpp"
@@ -15,53 +14,58 @@
 #include "includes/ublas_interface.hpp"
 #include "includes/serializer.hpp"
 #include "includes/parallel_enviroment.hpp"
+#include "container/sparse_graph_builder.hpp"
 
 namespace Quest{
 
     /**
      * @class SparseGraph
      * @brief 构建和存储矩阵图的类
-     * @details 用于存储矩阵图，旨在快速构建其他稀疏矩阵格式
+     * @details 用于存储矩阵图，旨在快速构建其他稀疏矩阵格式。
+     *  图以扁平的CSR数组存储（见 SparseGraphBuilder），行数由出现过的最大行索引决定。
+     *  AddEntry/AddEntries 写入线程私有的暂存区，可在并行循环中无锁调用，
+     *  查询、遍历与导出前需调用 Finalize() 合并暂存条目，否则抛出异常；
+     *  AddEntriesFromConnectivity 则由实体连接关系“两遍”直接构建，无需暂存
      */
     template<typename TIndexType = std::size_t>
     class SparseGraph final{
         public:
             using IndexType = TIndexType;
-            using GraphType = std::map<IndexType, std::unordered_set<IndexType>>;
-            using const_row_iterator = typename GraphType::const_iterator;
+            using GraphType = SparseGraphBuilder<IndexType>;
+            using RowType = Quest::span<const IndexType>;
 
             QUEST_CLASS_POINTER_DEFINITION(SparseGraph);
 
         public:
             class const_iterator_adaptor{
                 private:
-                    const_row_iterator map_iterator;
+                    const GraphType* mpGraph;
+                    IndexType mRowIndex;
                 public:
                     using iterator_category = std::forward_iterator_tag;
                     using difference_type   = std::ptrdiff_t;
-                    using value_type        = typename GraphType::value_type;
-                    using pointer           = typename GraphType::value_type*;
-                    using reference         = typename GraphType::value_type&;
+                    using value_type        = RowType;
+                    using pointer           = RowType*;
+                    using reference         = RowType&;
 
                 public:
-                    const_iterator_adaptor(const_row_iterator it): map_iterator(it){}
-                    const_iterator_adaptor(const const_iterator_adaptor& it): map_iterator(it.map_iterator){}
-                    const_iterator_adaptor& operator ++ () {mpa_iteartor++; return *this;}
+                    const_iterator_adaptor(const GraphType* pGraph, IndexType RowIndex): mpGraph(pGraph), mRowIndex(RowIndex){}
+                    const_iterator_adaptor(const const_iterator_adaptor& it): mpGraph(it.mpGraph), mRowIndex(it.mRowIndex){}
+                    const_iterator_adaptor& operator ++ () {mRowIndex++; return *this;}
                     const_iterator_adaptor operator ++ (int) {const_iterator_adaptor tmp(*this); operator ++(); return tmp;}
-                    bool operator == (const const_iterator_adaptor& rhs) const {return map_iterator == rhs.map_iterator;}
-                    bool operator!= (const const_iterator_adaptor& rhs) const {return map_iterator!= rhs.map_iterator;}
-                    const typename GraphType::value_type& operator * () const {return map_iterator->second;}
-                    const typename GraphType::value_type& operator -> () const {return map_iterator->second;}
-                    const_row_iterator& base() {return map_iterator;}
-                    const const_row_iterator& base() const {return map_iterator;}
-                    IndexType GetRowIndex() const{return map_iterator->first;}
+                    bool operator == (const const_iterator_adaptor& rhs) const {return mRowIndex == rhs.mRowIndex;}
+                    bool operator!= (const const_iterator_adaptor& rhs) const {return mRowIndex != rhs.mRowIndex;}
+                    RowType operator * () const {return (*mpGraph)[mRowIndex];}
+                    IndexType GetRowIndex() const{return mRowIndex;}
             };
 
         public:
             /**
              * @brief 构造函数
              */
-            SparseGraph(IndexType N){
+            SparseGraph(IndexType N):
+                mGraph(N)
+            {
                 mpComm = &ParallelEnvironment::GetDataCommunicator("Serial");
             }
 
@@ -101,7 +105,9 @@ namespace Quest{
              * @brief 构造函数
              */
             SparseGraph(const std::vector<IndexType>& rSingleVectorRepresentation){
+                mpComm = &ParallelEnvironment::GetDataCommunicator("Serial");
                 AddFromSingleVectorRepresentation(rSingleVectorRepresentation);
+                Finalize();
             }
 
             /**
@@ -114,7 +120,7 @@ namespace Quest{
             /**
              * @brief 获取数据通信器指针
              */
-            const DataCommunicator& pGetComm() const{
+            const DataCommunicator* pGetComm() const{
                 return mpComm;
             }
 
@@ -122,52 +128,43 @@ namespace Quest{
              * @brief 返回矩阵行数
              */
             IndexType Size() const{
-                if(!this->GetGraph().empty()){
-                    return (--(this->GetGraph().end()))->first + 1;
-                }
-                return 0;
+                return mGraph.Size();
             }
 
             /**
              * @brief 判断矩阵图是否为空
              */
             bool IsEmpty() const{
-                return mGraph.empty();
+                return mGraph.IsEmpty();
             }
 
             /**
              * @brief 判断（i,j）是否存在
+             * @details 存在未 Finalize() 的暂存条目时抛出异常
              */
             bool Has(const IndexType I, const IndexType J) const{
-                const auto& row_it = mGraph.find(I);
-                if(row_it == mGraph.end()){
-                    if((roww_it->second).find(J) != (row_it->second).end()){
-                        return true;
-                    }
-                    return false;
-                }
-                return false;
+                return mGraph.Has(I, J);
             }
 
             /**
-             * @brief 下标访问，返回第i行的非零元素的列索引集合
+             * @brief 下标访问，返回第i行的非零元素的列索引（升序）
              */
-            const typename GraphType::mapped_type& operator[](const IndexType& Key) const{
-                return (mGraph.find(Key))->second;
+            RowType operator[](const IndexType& Key) const{
+                return mGraph[Key];
             }
 
             /**
              * @brief 清空矩阵图
              */
             void Clear(){
-                mGraph.clear();
+                mGraph.Clear();
             }
 
             /**
              * @brief 添加矩阵元素(i,j)
              */
             void AddEntry(const IndexType I, const IndexType J){
-                mGraph[I].insert(J);
+                mGraph.AddBlock(&I, &I+1, &J, &J+1);
             }
 
             /**
@@ -175,7 +172,7 @@ namespace Quest{
              */
             template<typename TContainerType>
             void AddEntries(const IndexType RowIndex, const TContainerType& rColumnIndices){
-                mGraph[RowIndex].insert(rColumnIndices.begin(), rColumnIndices.end());
+                mGraph.AddBlock(&RowIndex, &RowIndex+1, rColumnIndices.begin(), rColumnIndices.end());
             }
 
             /**
@@ -187,7 +184,7 @@ namespace Quest{
                 const TIteratorType& rColBegin,
                 const TIteratorType& rColEnd
             ){
-                mGraph[RowIndex].insert(rColBegin, rColEnd);
+                mGraph.AddBlock(&RowIndex, &RowIndex+1, rColBegin, rColEnd);
             }
 
             /**
@@ -195,9 +192,7 @@ namespace Quest{
              */
             template<typename TContainerType>
             void AddEntries(const TContainerType& rIndices){
-                for(auto I : rIndices){
-                    mGraph[I].insert(rIndices.begin(), rIndices.end());
-                }
+                mGraph.AddBlock(rIndices.begin(), rIndices.end(), rIndices.begin(), rIndices.end());
             }
 
             /**
@@ -205,27 +200,43 @@ namespace Quest{
              */
             template<typename TContainerType>
             void AddEntries(const TContainerType& rRowIndices, const TContainerType& rColumnIndices){
-                for(auto I : rRowIndices){
-                    AddEntries(I, rColumnIndices);
-                }
+                mGraph.AddBlock(rRowIndices.begin(), rRowIndices.end(), rColumnIndices.begin(), rColumnIndices.end());
             }
 
             /**
-             * @brief 添加元素集合
+             * @brief 添加另一个图的所有条目（包括其未合并的暂存条目）
+             * @details 与本图已有的行和暂存条目一并合并，之后无需再调用 Finalize()
              */
-            void AddEntries(SparseGraph& rOtherGraph){
-                for(const auto& item : rOtherGraph.GetGraph()){
-                    AddEntries(item.first, item.second);
-                }
+            void AddEntries(const SparseGraph& rOtherGraph){
+                mGraph.AddGraph(rOtherGraph.GetGraph());
             }
 
             /**
-             * @brief 终止函数
+             * @brief 由实体连接关系“两遍”构建图
+             * @details rGetEntityIndices(i, rIndices) 需把第 i 个实体的方程编号写入 rIndices，
+             *  计数与填充两遍中各调用一次。结果直接合并进CSR数组，无需再调用 Finalize()
+             * @param NumberOfEntities 实体个数
+             * @param rGetEntityIndices 获取实体方程编号的函数
+             * @param NumberOfRows 图的行数，为0时由最大方程编号确定
              */
-            void Finalize(){}
+            template<typename TFunctionType>
+            void AddEntriesFromConnectivity(
+                const IndexType NumberOfEntities,
+                TFunctionType&& rGetEntityIndices,
+                const IndexType NumberOfRows = 0
+            ){
+                mGraph.AddEntriesFromConnectivity(NumberOfEntities, std::forward<TFunctionType>(rGetEntityIndices), NumberOfRows);
+            }
 
             /**
-             * @brief 获取图的存储结构(邻接表)
+             * @brief 合并暂存条目
+             */
+            void Finalize(){
+                mGraph.Finalize();
+            }
+
+            /**
+             * @brief 获取图的存储结构(CSR数组)
              */
             const GraphType& GetGraph() const{
                 return mGraph;
@@ -239,28 +250,7 @@ namespace Quest{
                 TVectorType& rRowIndices,
                 TVectorType& rColIndices
             ) const {
-                IndexType* pRowIndicesDataSize = nullptr;
-                IndexType RowIndicesDataSize = 0;
-                IndexType* pColIndicesDataSize = nullptr;
-                IndexType ColIndicesDataSize = 0;
-                ExportCSRArrays(pRowIndicesDataSize, RowIndicesDataSize, pColIndicesDataSize, ColIndicesDataSize);
-                if(rRowIndices.size() != RowIndicesDataSize){
-                    rRowIndices.resize(RowIndicesDataSize);
-                }
-                IndexPartition<IndexType>(RowIndicesDataSize).for_each([&](IndexType i){
-                    rRowIndices[i] = pRowIndicesData[i];
-                });
-
-                delete[] pRowIndicesData;
-                if(rColIndices.size() != ColIndicesDataSize){
-                    rColIndices.resize(ColIndicesDataSize);
-                }
-                IndexPartition<IndexType>(ColIndicesDataSize).for_each([&](IndexType i){
-                    rColIndices[i] = pColIndicesData[i];
-                });
-                delete[] pColIndicesData;
-
-                return rRowIndices.size();
+                return mGraph.ExportCSRArrays(rRowIndices, rColIndices);
             }
 
             /**
@@ -273,72 +263,38 @@ namespace Quest{
 
             /**
              * @brief 导出CSR数组格式
+             * @details 数组由 new[] 分配，所有权转移给调用者
              */
+            template<typename TOutputIndexType>
             IndexType ExportCSRArrays(
-                IndexType*& pRowIndicesData,
-                IndexType& rRowDataSize,
-                IndexType*& pColIndicesData,
-                IndexType& rColDataSize
+                TOutputIndexType*& pRowIndicesData,
+                TOutputIndexType& rRowDataSize,
+                TOutputIndexType*& pColIndicesData,
+                TOutputIndexType& rColDataSize
             ) const {
-                IndexType nrows = this->Size();
-
-                pRowIndicesData = new IndexType[nrows+1];
-                rRowDataSize = nrows+1;
-                Quest::span<IndexType> row_indices(pRowIndicesData, nrows+1);
-
-                IndexPartition<IndexType>(row_indices.size()).for_each([&](IndexType i){
-                    row_indices[i] = 0;
-                });
-
-                for(const auto& item : this->GetGraph()){
-                    row_indices[item.first+1] = item.second.size();
-                }
-
-                for(int i = 1; i < static_cast<int>(row_indices.size()); ++i){
-                    row_indices[i] += row_indices[i-1];
-                }
-
-
-                IndexType nnz = row_indices[nrows];
-                rColDataSize = nnz;
-                pColIndicesData = new IndexType[nnz];
-                Quest::span<IndexType> col_indices(pColIndicesData, nnz);
-
-                IndexPartition<IndexType>(col_indices.size()).for_each([&](IndexType i){
-                    col_indices[i] = 0;
-                });
-
-                for(const auto& item : this->GetGraph()){
-                    IndexType start = row_indices[item.first];
-
-                    IndexType counter = 0;
-                    for(auto j : item.second){
-                        col_indices[start+counter] = j;
-                        ++counter;
-                    }
-                }
-
-                IndexPartition<IndexType>(row_indices.size()-1).for_each([&](IndexType i){
-                    std::sort(col_indices.begin()+row_indices[i], col_indices.begin()+row_indices[i+1]);
-                });
-                return nrows;
+                return mGraph.ExportCSRArrays(pRowIndicesData, rRowDataSize, pColIndicesData, rColDataSize);
             }
 
             /**
              * @brief 将图作为单个向量导出
-             * @details 格式为：行索引 行中条目数量 行中所有索引的列表
+             * @details 格式为：行索引 行中条目数量 行中所有索引的列表（仅导出非空行）
              */
             std::vector<IndexType> ExportSingleVectorRepresentation() const {
+                QUEST_ERROR_IF(mGraph.HasPendingEntries()) << "The graph has staged entries which were not merged. Please call Finalize() before exporting" << std::endl;
+
                 std::vector<IndexType> single_vector_representation;
 
                 IndexType nrows = this->Size();
                 single_vector_representation.push_back(nrows);
 
-                for(const auto& item : this->GetGraph()){
-                    IndexType I = item.first;
+                for(IndexType I=0; I<nrows; ++I){
+                    const auto row = mGraph[I];
+                    if(row.size() == 0){
+                        continue;
+                    }
                     single_vector_representation.push_back(I);
-                    single_vector_representation.push_back(item.second.size());
-                    for(auto J : item.second){
+                    single_vector_representation.push_back(row.size());
+                    for(auto J : row){
                         single_vector_representation.push_back(J);
                     }
                 }
@@ -360,17 +316,19 @@ namespace Quest{
             }
 
             /**
-             * @brief 返回指向map中首行的迭代器
+             * @brief 返回指向首行的迭代器
              */
             const_iterator_adaptor begin() const{
-                return const_iterator_adaptor(mGraph.begin());
+                mGraph.CheckNoPendingEntries();
+                return const_iterator_adaptor(&mGraph, 0);
             }
 
             /**
-             * @brief 返回指向map中尾行的迭代器
+             * @brief 返回指向尾行之后的迭代器
              */
             const_iterator_adaptor end() const{
-                return const_iterator_adaptor(mGraph.end());
+                mGraph.CheckNoPendingEntries();
+                return const_iterator_adaptor(&mGraph, mGraph.Size());
             }
 
 
@@ -404,6 +362,7 @@ namespace Quest{
                 std::vector<IndexType> IJ;
                 rSerializer.load("IJ", IJ);
                 AddFromSingleVectorRepresentation(IJ);
+                Finalize();
             }
 
 
@@ -416,10 +375,8 @@ namespace Quest{
             DataCommunicator* mpComm;
 
             /**
-             * @brief 图的存储结构(邻接表)
-             * @details std::map<IndexType, std::unordered_set<IndexType>>
-             *  IndexType: 存在非零元素的行索引
-             *  std::unordered_set<IndexType>: 该行的非零元素的列索引集合
+             * @brief 图的存储结构
+             * @details 扁平CSR数组，每行的列索引升序且唯一，另含线程私有的暂存缓冲区
              */
             GraphType mGraph;
 
@@ -0,0 +1,603 @@
+/*---------------------------------------------
+“两遍”无锁稀疏图构建器
+计数 -> 填充 -> 行内排序去重，直接生成CSR数组
+----------------------------------------------*/
+
+#ifndef QUEST_SPARSE_GRAPH_BUILDER_HPP
+#define QUEST_SPARSE_GRAPH_BUILDER_HPP
+
+// 系统头文件
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+// 第三方头文件
+#include "span/span.hpp"
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/lock_object.hpp"
+#include "utilities/openmp_utils.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class SparseGraphBuilder
+     * @brief 以扁平CSR数组存储的稀疏图，采用“两遍”无锁方式构建
+     * @details 构建分为四步：
+     *  1. 计数：并行遍历所有块，以原子加统计每行的（含重复）条目数；
+     *  2. 填充：前缀和得到每行的起始位置，再次并行遍历所有块，按原子游标写入扁平缓冲区；
+     *  3. 去重：并行地对每行执行 std::sort + std::unique；
+     *  4. 压缩：将去重后的各行紧凑拷贝为最终的行指针/列索引数组。
+     *  整个过程不使用哈希集合，也不需要逐行的互斥锁。
+     *  逐条添加的条目（AddEntry/AddEntries）先写入当前线程私有的暂存缓冲区，
+     *  在 Finalize() 时与已有图一并合并。存在未合并的暂存条目时，按行读取的接口会抛出异常
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TIndexType = std::size_t>
+    class SparseGraphBuilder final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(SparseGraphBuilder);
+
+        public:
+            /**
+             * @brief 构造函数
+             * @param NumberOfRows 图的初始行数
+             */
+            explicit SparseGraphBuilder(IndexType NumberOfRows = 0):
+                mNumberOfRows(NumberOfRows),
+                mRowIndices(NumberOfRows+1, 0),
+                mStagedEntries(ParallelUtilities::GetNumThreads()+1),
+                mStagedSize(ParallelUtilities::GetNumThreads()+1, 0)
+            {
+            }
+
+            /**
+             * @brief 拷贝构造函数
+             */
+            SparseGraphBuilder(const SparseGraphBuilder& rOther):
+                mNumberOfRows(rOther.mNumberOfRows),
+                mRowIndices(rOther.mRowIndices),
+                mColIndices(rOther.mColIndices),
+                mStagedEntries(rOther.mStagedEntries),
+                mStagedSize(rOther.mStagedSize)
+            {
+            }
+
+            /**
+             * @brief 析构函数
+             */
+            ~SparseGraphBuilder(){}
+
+            /**
+             * @brief 赋值运算符
+             */
+            SparseGraphBuilder& operator = (const SparseGraphBuilder& rOther){
+                mNumberOfRows = rOther.mNumberOfRows;
+                mRowIndices = rOther.mRowIndices;
+                mColIndices = rOther.mColIndices;
+                mStagedEntries = rOther.mStagedEntries;
+                mStagedSize = rOther.mStagedSize;
+                return *this;
+            }
+
+            /**
+             * @brief 返回图的行数（包括尚未合并的暂存条目所涉及的行）
+             */
+            IndexType Size() const{
+                IndexType size = mNumberOfRows;
+                for(const auto staged_size : mStagedSize){
+                    size = std::max(size, staged_size);
+                }
+                return size;
+            }
+
+            /**
+             * @brief 返回构造、Resize() 或 Finalize() 确定的行数
+             * @details 不读取暂存区，AddBlock() 不会修改它，因此可以在并发添加条目时调用
+             */
+            IndexType NumberOfRows() const{
+                return mNumberOfRows;
+            }
+
+            /**
+             * @brief 返回已合并的非零元素个数
+             */
+            IndexType NumberOfNonZeros() const{
+                return mColIndices.size();
+            }
+
+            /**
+             * @brief 判断图是否为空
+             */
+            bool IsEmpty() const{
+                return mColIndices.empty() && !HasPendingEntries();
+            }
+
+            /**
+             * @brief 判断是否存在尚未合并的暂存条目
+             */
+            bool HasPendingEntries() const{
+                for(const auto& r_staged : mStagedEntries){
+                    if(!r_staged.empty()){
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /**
+             * @brief 存在未合并的暂存条目时抛出异常
+             */
+            void CheckNoPendingEntries() const{
+                QUEST_ERROR_IF(HasPendingEntries()) << "The graph has staged entries which were not merged. Please call Finalize() before reading it" << std::endl;
+            }
+
+            /**
+             * @brief 扩展图的行数，已有的行保持不变
+             */
+            void Resize(const IndexType NumberOfRows){
+                QUEST_ERROR_IF(NumberOfRows < mNumberOfRows) << "SparseGraphBuilder can only grow. Current size : "
+                    << mNumberOfRows << " requested size : " << NumberOfRows << std::endl;
+                mRowIndices.resize(NumberOfRows+1, mRowIndices[mNumberOfRows]);
+                mNumberOfRows = NumberOfRows;
+            }
+
+            /**
+             * @brief 清空图
+             */
+            void Clear(){
+                mNumberOfRows = 0;
+                mRowIndices.assign(1, 0);
+                mColIndices.clear();
+                for(IndexType i=0; i<mStagedEntries.size(); ++i){
+                    mStagedEntries[i].clear();
+                    mStagedSize[i] = 0;
+                }
+            }
+
+            /**
+             * @brief 添加一个“行索引集合 x 列索引集合”的块
+             * @details 调用 Finalize() 后才出现在图中。在非嵌套的 OpenMP 并行区内按线程号写入线程私有的暂存缓冲区，不加锁；
+             *  其余情况（并行区之外、嵌套并行区、线程数在构造之后增加或非 OpenMP 的线程）写入加锁的共享缓冲区，
+             *  因此任何情况下都可以并发调用
+             */
+            template<typename TRowIteratorType, typename TColIteratorType>
+            void AddBlock(
+                const TRowIteratorType& rRowBegin,
+                const TRowIteratorType& rRowEnd,
+                const TColIteratorType& rColBegin,
+                const TColIteratorType& rColEnd
+            ){
+                const IndexType nrows = std::distance(rRowBegin, rRowEnd);
+                const IndexType ncols = std::distance(rColBegin, rColEnd);
+                if(nrows == 0 || ncols == 0){
+                    return;
+                }
+
+                const IndexType buffer_id = GetStagingBufferIndex();
+                if(buffer_id == SharedStagingBufferIndex()){
+                    std::lock_guard<LockObject> lock(mSharedStagingLock);
+                    StageBlock(buffer_id, nrows, ncols, rRowBegin, rRowEnd, rColBegin, rColEnd);
+                } else {
+                    StageBlock(buffer_id, nrows, ncols, rRowBegin, rRowEnd, rColBegin, rColEnd);
+                }
+            }
+
+            /**
+             * @brief 把另一个图（包括其未合并的暂存条目）与本图已有的行和暂存条目一并合并
+             * @details 结果直接写入CSR数组，无需再调用 Finalize()
+             */
+            void AddGraph(const SparseGraphBuilder& rOther){
+                Compress(std::max(Size(), rOther.Size()), [&](auto& rVisitor){
+                    VisitFinalizedRows(rVisitor);
+                    VisitStagedEntries(rVisitor);
+                    rOther.VisitFinalizedRows(rVisitor);
+                    rOther.VisitStagedEntries(rVisitor);
+                });
+            }
+
+            /**
+             * @brief 由实体连接关系直接“两遍”构建（或扩充）图
+             * @details 每个实体贡献一个方形块（行、列索引均为该实体的方程编号）。
+             *  rGetEntityIndices(i, rIndices) 需把第 i 个实体的方程编号写入 rIndices，
+             *  该函数在计数与填充两遍中各调用一次，且可能被多个线程同时调用。
+             *  已有的行以及尚未合并的暂存条目会一并合并
+             * @param NumberOfEntities 实体个数
+             * @param rGetEntityIndices 获取实体方程编号的函数
+             * @param NumberOfRows 图的行数，为0时由实体的最大方程编号确定
+             */
+            template<typename TFunctionType>
+            void AddEntriesFromConnectivity(
+                const IndexType NumberOfEntities,
+                TFunctionType&& rGetEntityIndices,
+                IndexType NumberOfRows = 0
+            ){
+                if(NumberOfRows == 0){
+                    NumberOfRows = IndexPartition<IndexType>(NumberOfEntities).template for_each<Internals::MaxReduction<IndexType>>(IndexVectorType(),
+                        [&](IndexType i, IndexVectorType& rIndices){
+                            rIndices.clear();
+                            rGetEntityIndices(i, rIndices);
+                            IndexType max_index = 0;
+                            for(const auto index : rIndices){
+                                max_index = std::max(max_index, static_cast<IndexType>(index)+1);
+                            }
+                            return max_index;
+                        }
+                    );
+                }
+
+                Compress(std::max(NumberOfRows, Size()), [&](auto& rVisitor){
+                    VisitFinalizedRows(rVisitor);
+                    VisitStagedEntries(rVisitor);
+                    IndexPartition<IndexType>(NumberOfEntities).for_each(IndexVectorType(), [&](IndexType i, IndexVectorType& rIndices){
+                        rIndices.clear();
+                        rGetEntityIndices(i, rIndices);
+                        rVisitor(rIndices.begin(), rIndices.end(), rIndices.begin(), rIndices.end());
+                    });
+                });
+            }
+
+            /**
+             * @brief 将暂存条目合并到CSR数组中
+             */
+            void Finalize(){
+                if(!HasPendingEntries()){
+                    return;
+                }
+
+                Compress(Size(), [&](auto& rVisitor){
+                    VisitFinalizedRows(rVisitor);
+                    VisitStagedEntries(rVisitor);
+                });
+            }
+
+            /**
+             * @brief 返回第 i 行的列索引（已排序且唯一）
+             */
+            Quest::span<const IndexType> operator[](const IndexType i) const{
+                CheckNoPendingEntries();
+                QUEST_ERROR_IF(i >= mNumberOfRows) << "Row index : " << i << " exceeds the graph size : " << mNumberOfRows << std::endl;
+                return Quest::span<const IndexType>(mColIndices.data() + mRowIndices[i], mRowIndices[i+1] - mRowIndices[i]);
+            }
+
+            /**
+             * @brief 判断（i,j）是否存在
+             * @details 二分查找，存在未合并的暂存条目时抛出异常
+             */
+            bool Has(const IndexType I, const IndexType J) const{
+                CheckNoPendingEntries();
+                if(I >= mNumberOfRows){
+                    return false;
+                }
+                const auto it_begin = mColIndices.begin() + mRowIndices[I];
+                const auto it_end = mColIndices.begin() + mRowIndices[I+1];
+                return std::binary_search(it_begin, it_end, J);
+            }
+
+            /**
+             * @brief 返回CSR行指针数组
+             */
+            const IndexVectorType& GetRowIndices() const{
+                return mRowIndices;
+            }
+
+            /**
+             * @brief 返回CSR列索引数组
+             */
+            const IndexVectorType& GetColIndices() const{
+                return mColIndices;
+            }
+
+            /**
+             * @brief 导出CSR数组格式
+             * @details 数组由 new[] 分配，所有权转移给调用者
+             */
+            template<typename TOutputIndexType>
+            IndexType ExportCSRArrays(
+                TOutputIndexType*& pRowIndicesData,
+                TOutputIndexType& rRowDataSize,
+                TOutputIndexType*& pColIndicesData,
+                TOutputIndexType& rColDataSize
+            ) const {
+                QUEST_ERROR_IF(HasPendingEntries()) << "The graph has staged entries which were not merged. Please call Finalize() before exporting" << std::endl;
+
+                rRowDataSize = mRowIndices.size();
+                pRowIndicesData = new TOutputIndexType[mRowIndices.size()];
+                rColDataSize = mColIndices.size();
+                pColIndicesData = new TOutputIndexType[mColIndices.size()];
+
+                CopyCSRArrays(pRowIndicesData, pColIndicesData);
+
+                return mNumberOfRows;
+            }
+
+            /**
+             * @brief 导出CSR数组格式
+             */
+            template<typename TVectorType>
+            IndexType ExportCSRArrays(
+                TVectorType& rRowIndices,
+                TVectorType& rColIndices
+            ) const {
+                QUEST_ERROR_IF(HasPendingEntries()) << "The graph has staged entries which were not merged. Please call Finalize() before exporting" << std::endl;
+
+                if(rRowIndices.size() != mRowIndices.size()){
+                    rRowIndices.resize(mRowIndices.size());
+                }
+                if(rColIndices.size() != mColIndices.size()){
+                    rColIndices.resize(mColIndices.size());
+                }
+
+                CopyCSRArrays(&rRowIndices[0], mColIndices.empty() ? nullptr : &rColIndices[0]);
+
+                return mNumberOfRows;
+            }
+
+
+            std::string Info() const{
+                std::stringstream buffer;
+                buffer << "SparseGraphBuilder";
+                return buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "SparseGraphBuilder";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of rows : " << mNumberOfRows << " number of nonzeros : " << mColIndices.size() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 共享（加锁）暂存缓冲区的编号，即最后一个缓冲区
+             */
+            IndexType SharedStagingBufferIndex() const{
+                return mStagedEntries.size() - 1;
+            }
+
+            /**
+             * @brief 返回当前调用应写入的暂存缓冲区
+             * @details 只有在非嵌套的 OpenMP 并行区内、线程号小于线程私有缓冲区个数时才使用线程私有的缓冲区
+             */
+            IndexType GetStagingBufferIndex() const{
+                #ifdef _OPENMP
+                    if(OpenMPUtils::IsInParallel() && omp_get_level() == 1){
+                        const IndexType thread_id = static_cast<IndexType>(OpenMPUtils::ThisThread());
+                        if(thread_id < SharedStagingBufferIndex()){
+                            return thread_id;
+                        }
+                    }
+                #endif
+                return SharedStagingBufferIndex();
+            }
+
+            /**
+             * @brief 把一个块追加到第 BufferIndex 个暂存缓冲区
+             */
+            template<typename TRowIteratorType, typename TColIteratorType>
+            void StageBlock(
+                const IndexType BufferIndex,
+                const IndexType NumberOfBlockRows,
+                const IndexType NumberOfBlockCols,
+                const TRowIteratorType& rRowBegin,
+                const TRowIteratorType& rRowEnd,
+                const TColIteratorType& rColBegin,
+                const TColIteratorType& rColEnd
+            ){
+                auto& r_staged = mStagedEntries[BufferIndex];
+                r_staged.push_back(NumberOfBlockRows);
+                r_staged.push_back(NumberOfBlockCols);
+                IndexType max_row = 0;
+                for(auto it = rRowBegin; it != rRowEnd; ++it){
+                    r_staged.push_back(*it);
+                    max_row = std::max(max_row, static_cast<IndexType>(*it));
+                }
+                r_staged.insert(r_staged.end(), rColBegin, rColEnd);
+
+                mStagedSize[BufferIndex] = std::max(mStagedSize[BufferIndex], max_row+1);
+            }
+
+            /**
+             * @brief 将CSR数组并行拷贝（并转换索引类型）到输出缓冲区
+             */
+            template<typename TOutputIndexType>
+            void CopyCSRArrays(TOutputIndexType* pRowIndicesData, TOutputIndexType* pColIndicesData) const{
+                QUEST_ERROR_IF(mColIndices.size() > static_cast<std::size_t>(std::numeric_limits<TOutputIndexType>::max()))
+                    << "The number of nonzeros " << mColIndices.size() << " cannot be represented by the requested index type" << std::endl;
+
+                // 导出为更窄的索引类型（如32位）时还须检查最大列号
+                if constexpr(sizeof(TOutputIndexType) < sizeof(IndexType)){
+                    const IndexType max_col = IndexPartition<IndexType>(mColIndices.size()).template for_each<Internals::MaxReduction<IndexType>>([&](IndexType k){
+                        return mColIndices[k];
+                    });
+                    QUEST_ERROR_IF(!mColIndices.empty() && max_col > static_cast<IndexType>(std::numeric_limits<TOutputIndexType>::max()))
+                        << "The column index " << max_col << " cannot be represented by the requested index type" << std::endl;
+                }
+
+                IndexPartition<IndexType>(mRowIndices.size()).for_each([&](IndexType i){
+                    pRowIndicesData[i] = static_cast<TOutputIndexType>(mRowIndices[i]);
+                });
+                IndexPartition<IndexType>(mColIndices.size()).for_each([&](IndexType i){
+                    pColIndicesData[i] = static_cast<TOutputIndexType>(mColIndices[i]);
+                });
+            }
+
+
+            /**
+             * @brief 以块的形式并行遍历已合并的行
+             */
+            template<typename TVisitorType>
+            void VisitFinalizedRows(TVisitorType& rVisitor) const{
+                IndexPartition<IndexType>(mNumberOfRows).for_each([&](IndexType i){
+                    const auto it_begin = mColIndices.begin() + mRowIndices[i];
+                    const auto it_end = mColIndices.begin() + mRowIndices[i+1];
+                    rVisitor(&i, &i+1, it_begin, it_end);
+                });
+            }
+
+
+            /**
+             * @brief 以块的形式并行遍历暂存条目
+             * @details 先串行定位每条暂存记录的起始位置，再按记录并行遍历，避免线程间负载不均
+             */
+            template<typename TVisitorType>
+            void VisitStagedEntries(TVisitorType& rVisitor) const{
+                std::vector<const IndexType*> records;
+                for(const auto& r_staged : mStagedEntries){
+                    IndexType position = 0;
+                    while(position < r_staged.size()){
+                        records.push_back(r_staged.data() + position);
+                        position += 2 + r_staged[position] + r_staged[position+1];
+                    }
+                }
+
+                IndexPartition<IndexType>(records.size()).for_each([&](IndexType k){
+                    const IndexType* p_record = records[k];
+                    const IndexType* p_rows = p_record + 2;
+                    const IndexType* p_cols = p_rows + p_record[0];
+                    rVisitor(p_rows, p_cols, p_cols, p_cols + p_record[1]);
+                });
+            }
+
+
+            /**
+             * @brief “两遍”构建的核心
+             * @param NumberOfRows 结果图的行数
+             * @param rForEachBlock 以访问者 visitor(row_begin, row_end, col_begin, col_end) 并行遍历所有块的函数，
+             *  在计数与填充两遍中各调用一次
+             */
+            template<typename TBlockLoopType>
+            void Compress(const IndexType NumberOfRows, TBlockLoopType&& rForEachBlock){
+                // 第一遍：统计每行（含重复）的条目数
+                std::vector<std::atomic<IndexType>> row_cursor(NumberOfRows);
+                IndexPartition<IndexType>(NumberOfRows).for_each([&](IndexType i){
+                    row_cursor[i].store(0, std::memory_order_relaxed);
+                });
+
+                auto count_visitor = [&](auto row_begin, auto row_end, auto col_begin, auto col_end){
+                    const IndexType ncols = std::distance(col_begin, col_end);
+                    for(auto it = row_begin; it != row_end; ++it){
+                        QUEST_DEBUG_ERROR_IF(static_cast<IndexType>(*it) >= NumberOfRows) << "Row index : " << *it
+                            << " exceeds the graph size : " << NumberOfRows << std::endl;
+                        row_cursor[*it].fetch_add(ncols, std::memory_order_relaxed);
+                    }
+                };
+                rForEachBlock(count_visitor);
+
+                IndexVectorType raw_row_indices(NumberOfRows+1);
+                raw_row_indices[0] = 0;
+                for(IndexType i=0; i<NumberOfRows; ++i){
+                    raw_row_indices[i+1] = raw_row_indices[i] + row_cursor[i].load(std::memory_order_relaxed);
+                }
+
+                // 第二遍：按原子游标写入扁平缓冲区
+                IndexPartition<IndexType>(NumberOfRows).for_each([&](IndexType i){
+                    row_cursor[i].store(raw_row_indices[i], std::memory_order_relaxed);
+                });
+
+                IndexVectorType raw_col_indices(raw_row_indices[NumberOfRows]);
+                auto fill_visitor = [&](auto row_begin, auto row_end, auto col_begin, auto col_end){
+                    const IndexType ncols = std::distance(col_begin, col_end);
+                    for(auto it = row_begin; it != row_end; ++it){
+                        const IndexType position = row_cursor[*it].fetch_add(ncols, std::memory_order_relaxed);
+                        std::copy(col_begin, col_end, raw_col_indices.begin() + position);
+                    }
+                };
+                rForEachBlock(fill_visitor);
+
+                // 行内排序去重
+                IndexVectorType row_indices(NumberOfRows+1);
+                row_indices[0] = 0;
+                IndexPartition<IndexType>(NumberOfRows).for_each([&](IndexType i){
+                    const auto it_begin = raw_col_indices.begin() + raw_row_indices[i];
+                    const auto it_end = raw_col_indices.begin() + raw_row_indices[i+1];
+                    std::sort(it_begin, it_end);
+                    row_indices[i+1] = std::distance(it_begin, std::unique(it_begin, it_end));
+                });
+
+                for(IndexType i=0; i<NumberOfRows; ++i){
+                    row_indices[i+1] += row_indices[i];
+                }
+
+                // 压缩为最终的CSR数组
+                IndexVectorType col_indices(row_indices[NumberOfRows]);
+                IndexPartition<IndexType>(NumberOfRows).for_each([&](IndexType i){
+                    const auto it_begin = raw_col_indices.begin() + raw_row_indices[i];
+                    std::copy(it_begin, it_begin + (row_indices[i+1] - row_indices[i]), col_indices.begin() + row_indices[i]);
+                });
+
+                mNumberOfRows = NumberOfRows;
+                mRowIndices.swap(row_indices);
+                mColIndices.swap(col_indices);
+                for(IndexType i=0; i<mStagedEntries.size(); ++i){
+                    IndexVectorType().swap(mStagedEntries[i]);
+                    mStagedSize[i] = 0;
+                }
+            }
+
+        private:
+            /**
+             * @brief 图的行数
+             */
+            IndexType mNumberOfRows;
+
+            /**
+             * @brief CSR行指针数组（大小为行数+1）
+             */
+            IndexVectorType mRowIndices;
+
+            /**
+             * @brief CSR列索引数组，每行内部升序且唯一
+             */
+            IndexVectorType mColIndices;
+
+            /**
+             * @brief 暂存缓冲区，前面每个 OpenMP 线程各一个，最后一个为加锁的共享缓冲区
+             * @details 每条记录的格式为：行数 列数 行索引列表 列索引列表
+             */
+            std::vector<IndexVectorType> mStagedEntries;
+
+            /**
+             * @brief 每个暂存缓冲区涉及的最大行索引+1
+             */
+            IndexVectorType mStagedSize;
+
+            /**
+             * @brief 保护共享暂存缓冲区的锁
+             */
+            LockObject mSharedStagingLock;
+
+    };
+
+
+    template<typename TIndexType=std::size_t>
+    inline std::istream& operator >> (std::istream& rIstream, SparseGraphBuilder<TIndexType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TIndexType=std::size_t>
+    inline std::ostream& operator << (std::ostream& rOstream, const SparseGraphBuilder<TIndexType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_SPARSE_GRAPH_BUILDER_HPP
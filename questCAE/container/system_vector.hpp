@@ -238,7 +238,7 @@ namespace Quest{
                     << "the parameter gather_on_rank essentially does nothing for a non-distribued vector. It is added to have the same interface as for the distributed_system_vector" << std::endl;
 
                 auto partition = IndexPartition<IndexType>(size());
-                TDataType dot_value = partition.template for_each<SumReduction<TDataType>>([&](IndexType i){
+                TDataType dot_value = partition.template for_each<Internals::SumReduction<TDataType>>([&](IndexType i){
                     return (*this)[i] * rOtherVector[i];
                 });
 
@@ -272,6 +272,24 @@ namespace Quest{
                 }
             }
 
+            /**
+             * @brief 以普通（非原子）加法将输入向量按方程ID组装到全局向量中
+             * @details 仅当没有其他线程同时写入相同的位置时才可使用，例如按着色（EntityColoring）分批组装时
+             */
+            template<typename TVectorType, typename TIndexVectorType>
+            void AssembleNonAtomic(
+                const TVectorType& rVectorInput,
+                const TIndexVectorType& EquationId
+            ){
+                QUEST_DEBUG_ERROR_IF(rVectorInput.size()!= EquationId.size());
+
+                for(unsigned int i=0; i<EquationId.size(); ++i){
+                    IndexType global_i = EquationId[i];
+                    QUEST_DEBUG_ERROR_IF(global_i > mData.size());
+                    mData[global_i] += rVectorInput[i];
+                }
+            }
+
 
             std::string Info() const{
                 std::stringstream buffer;
@@ -298,7 +316,7 @@ namespace Quest{
             /**
              * @brief 数据通信器指针
              */
-            const DataCommunicator& mpComm;
+            const DataCommunicator* mpComm;
             
             /**
              * @brief 系统向量数据
@@ -0,0 +1,215 @@
+/*---------------------------------------------
+稀疏三角矩阵的层次调度
+把前代/回代中互不依赖的行分为同一层，层内并行计算
+----------------------------------------------*/
+
+#ifndef QUEST_TRIANGULAR_LEVEL_SCHEDULE_HPP
+#define QUEST_TRIANGULAR_LEVEL_SCHEDULE_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class TriangularLevelSchedule
+     * @brief 稀疏三角矩阵求解的层次调度
+     * @details 下三角求解中第 i 行依赖于 L(i,j) != 0 (j < i) 的各行，定义 level(i) = 1 + max level(j)，
+     *  同一层的行之间没有依赖，可以并行求解，各层之间按顺序执行；上三角求解按行号递减方向同理。
+     *  矩阵以CSR形式给出，每行列号递增，pDiagonal[i] 为第 i 行对角元在列索引数组中的位置，
+     *  下三角部分为 [pRowIndices[i], pDiagonal[i])，上三角部分为 (pDiagonal[i], pRowIndices[i+1])。
+     *  调度只依赖稀疏模式，模式不变时可重复使用；行数很少的层串行执行，以免并行开销超过计算量
+     * @tparam TIndexType 索引类型
+     */
+    template<typename TIndexType = std::size_t>
+    class TriangularLevelSchedule final{
+        public:
+            using IndexType = TIndexType;
+            using IndexVectorType = std::vector<IndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(TriangularLevelSchedule);
+
+            /**
+             * @brief 行数少于该值的层串行执行
+             */
+            static constexpr IndexType MinRowsPerParallelLevel = 128;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            TriangularLevelSchedule(){}
+
+            /**
+             * @brief 析构函数
+             */
+            ~TriangularLevelSchedule(){}
+
+            /**
+             * @brief 构建下三角部分（前代）的层次调度
+             */
+            template<typename TRowIndexType, typename TColIndexType, typename TDiagonalType>
+            void BuildLower(const IndexType Size, const TRowIndexType* pRowIndices, const TColIndexType* pColIndices, const TDiagonalType* pDiagonal){
+                IndexVectorType level(Size, 0);
+                for(IndexType i=0; i<Size; ++i){
+                    IndexType lev = 0;
+                    for(IndexType k=pRowIndices[i]; k<static_cast<IndexType>(pDiagonal[i]); ++k){
+                        lev = std::max(lev, level[pColIndices[k]] + 1);
+                    }
+                    level[i] = lev;
+                }
+                GroupRows(level);
+            }
+
+            /**
+             * @brief 构建上三角部分（回代）的层次调度
+             */
+            template<typename TRowIndexType, typename TColIndexType, typename TDiagonalType>
+            void BuildUpper(const IndexType Size, const TRowIndexType* pRowIndices, const TColIndexType* pColIndices, const TDiagonalType* pDiagonal){
+                IndexVectorType level(Size, 0);
+                for(IndexType i=Size; i-->0;){
+                    IndexType lev = 0;
+                    for(IndexType k=static_cast<IndexType>(pDiagonal[i])+1; k<static_cast<IndexType>(pRowIndices[i+1]); ++k){
+                        lev = std::max(lev, level[pColIndices[k]] + 1);
+                    }
+                    level[i] = lev;
+                }
+                GroupRows(level);
+            }
+
+            /**
+             * @brief 清空调度
+             */
+            void Clear(){
+                IndexVectorType().swap(mLevelOffsets);
+                IndexVectorType().swap(mRows);
+            }
+
+            /**
+             * @brief 按层依次对每一行调用 rFunction(i)，层内并行
+             */
+            template<typename TFunctionType>
+            void ForEachRow(TFunctionType&& rFunction) const{
+                for(IndexType l=0; l<NumberOfLevels(); ++l){
+                    const IndexType begin = mLevelOffsets[l];
+                    const IndexType end = mLevelOffsets[l+1];
+                    if(end - begin < MinRowsPerParallelLevel){
+                        for(IndexType k=begin; k<end; ++k){
+                            rFunction(mRows[k]);
+                        }
+                    } else {
+                        IndexPartition<IndexType>(end - begin).for_each([&](IndexType k){
+                            rFunction(mRows[begin + k]);
+                        });
+                    }
+                }
+            }
+
+            /**
+             * @brief 返回层数
+             */
+            IndexType NumberOfLevels() const{
+                return mLevelOffsets.empty() ? 0 : mLevelOffsets.size() - 1;
+            }
+
+            /**
+             * @brief 返回行数
+             */
+            IndexType NumberOfRows() const{
+                return mRows.size();
+            }
+
+            /**
+             * @brief 返回每层的平均行数，即可用的平均并行度
+             */
+            double AverageRowsPerLevel() const{
+                return NumberOfLevels() == 0 ? 0.0 : static_cast<double>(NumberOfRows())/static_cast<double>(NumberOfLevels());
+            }
+
+            /**
+             * @brief 返回第 l 层在行数组中的起始位置
+             */
+            IndexType LevelBegin(const IndexType l) const{
+                return mLevelOffsets[l];
+            }
+
+            /**
+             * @brief 返回第 l 层在行数组中的结束位置
+             */
+            IndexType LevelEnd(const IndexType l) const{
+                return mLevelOffsets[l+1];
+            }
+
+            /**
+             * @brief 返回按层排列的行号
+             */
+            const IndexVectorType& Rows() const{
+                return mRows;
+            }
+
+
+            std::string Info() const{
+                return "TriangularLevelSchedule";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "TriangularLevelSchedule";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of rows : " << NumberOfRows() << " number of levels : " << NumberOfLevels()
+                    << " average rows per level : " << AverageRowsPerLevel() << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 按层号对行计数排序，层内保持行号递增
+             */
+            void GroupRows(const IndexVectorType& rLevel){
+                const IndexType size = rLevel.size();
+                IndexType num_levels = 0;
+                for(IndexType i=0; i<size; ++i){
+                    num_levels = std::max(num_levels, rLevel[i] + 1);
+                }
+
+                mLevelOffsets.assign(num_levels+1, 0);
+                for(IndexType i=0; i<size; ++i){
+                    ++mLevelOffsets[rLevel[i]+1];
+                }
+                for(IndexType l=0; l<num_levels; ++l){
+                    mLevelOffsets[l+1] += mLevelOffsets[l];
+                }
+
+                mRows.resize(size);
+                IndexVectorType cursor(mLevelOffsets.begin(), mLevelOffsets.end()-1);
+                for(IndexType i=0; i<size; ++i){
+                    mRows[cursor[rLevel[i]]++] = i;
+                }
+            }
+
+        private:
+            /**
+             * @brief 每层在行数组中的起始位置（大小为层数+1）
+             */
+            IndexVectorType mLevelOffsets;
+
+            /**
+             * @brief 按层排列的行号
+             */
+            IndexVectorType mRows;
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_TRIANGULAR_LEVEL_SCHEDULE_HPP
@@ -21,7 +21,7 @@ namespace Quest{
         public:
             using FactoryType = LinearSolverFactory<TSparseSpace, TLocalSpace>;
 
-            QUEST_CALSS_POINTER_DEFINITION(LinearSolverFactory);
+            QUEST_CLASS_POINTER_DEFINITION(LinearSolverFactory);
 
         public:
             /**
@@ -49,10 +49,10 @@ namespace Quest{
                     << "Trying to construct a Linear solver with solver_type:\n\""
                     << solver_name << "\" which does not exist.\n"
                     << "The list of available options (for currently loaded applications) is:\n"
-                    << KratosComponents< FactoryType >() << std::endl;
+                    << QuestComponents< FactoryType >() << std::endl;
 
                 const auto& aux = QuestComponents<FactoryType>::Get(solver_name);
-                return aux.CreateSover(Settings);
+                return aux.CreateSolver(Settings);
             }
 
         protected:
@@ -97,6 +97,20 @@ namespace Quest{
     #define QUEST_REGISTER_COMPLEX_LINEAR_SOLVER(name, reference) \
         QuestComponents<ComplexLinearSolverFactoryType>::Add(name, reference);
 
+
+    using FloatSparseSpaceType = TUblasSparseSpace<float>;
+    using FloatLocalSparseSpaceType = TUblasDenseSpace<float>;
+
+    using FloatLinearSolverFactoryType = LinearSolverFactory<FloatSparseSpaceType, FloatLocalSparseSpaceType>;
+
+    QUEST_API_EXTERN template class QUEST_API(QUEST_CORE) QuestComponents<FloatLinearSolverFactoryType>;
+
+    #ifdef QUEST_REGISTER_FLOAT_LINEAR_SOLVER
+    #undef QUEST_REGISTER_FLOAT_LINEAR_SOLVER
+    #endif
+    #define QUEST_REGISTER_FLOAT_LINEAR_SOLVER(name, reference) \
+        QuestComponents<FloatLinearSolverFactoryType>::Add(name, reference);
+
 }
 
 
@@ -1,9 +1,17 @@
 #include "includes/define.hpp"
 #include "factories/standard_linear_solver_factory.hpp"
 #include "linear_solvers/linear_solver.hpp"
+#include "linear_solvers/amgcl_solver.hpp"
 #include "linear_solvers/cg_solver.hpp"
+#include "linear_solvers/pipelined_cg_solver.hpp"
+#include "linear_solvers/block_cg_solver.hpp"
+#include "linear_solvers/recycling_cg_solver.hpp"
+#include "linear_solvers/gmres_solver.hpp"
+#include "linear_solvers/bicgstab_l_solver.hpp"
 #include "linear_solvers/scaling_solver.hpp"
 #include "linear_solvers/skyline_lu_custom_scalar_solver.hpp"
+#include "linear_solvers/supernodal_cholesky_solver.hpp"
+#include "linear_solvers/mixed_precision_refinement_solver.hpp"
 #include "space/ublas_space.hpp"
 
 
@@ -14,17 +22,46 @@ namespace Quest{
         using LocalSpaceType = TUblasDenseSpace<double>;
         using ComplexSpaceType = TUblasDenseSpace<std::complex<double>>;
         using ComplexLocalSpaceType = TUblasDenseSpace<std::complex<double>>;
+        using FloatSpaceType = TUblasSparseSpace<float>;
+        using FloatLocalSpaceType = TUblasDenseSpace<float>;
 
         using CGSolverType = CGSolver<SpaceType, LocalSpaceType>;
+        using PipelinedCGSolverType = PipelinedCGSolver<SpaceType, LocalSpaceType>;
+        using BlockCGSolverType = BlockCGSolver<SpaceType, LocalSpaceType>;
+        using RecyclingCGSolverType = RecyclingCGSolver<SpaceType, LocalSpaceType>;
+        using GMRESSolverType = GMRESSolver<SpaceType, LocalSpaceType>;
+        using BiCGStabLSolverType = BiCGStabLSolver<SpaceType, LocalSpaceType>;
+        using SupernodalCholeskySolverType = SupernodalCholeskySolver<SpaceType, LocalSpaceType>;
+        using FloatSupernodalCholeskySolverType = SupernodalCholeskySolver<FloatSpaceType, FloatLocalSpaceType>;
+        using MixedPrecisionRefinementSolverType = MixedPrecisionRefinementSolver<SpaceType, LocalSpaceType>;
         using SkyLineLUComplexSolverType = SkylineLUCustomScalarSolver<ComplexSpaceType, ComplexLocalSpaceType>;
         using ScalingSolverType = ScalingSolver<SpaceType, LocalSpaceType>;
+        using AMGCLSolverType = AMGCLSolver<SpaceType, LocalSpaceType>;
 
         static auto CGSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, CGSolverType>();
+        static auto PipelinedCGSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, PipelinedCGSolverType>();
+        static auto BlockCGSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, BlockCGSolverType>();
+        static auto RecyclingCGSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, RecyclingCGSolverType>();
+        static auto GMRESSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, GMRESSolverType>();
+        static auto BiCGStabLSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, BiCGStabLSolverType>();
+        static auto AMGCLSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, AMGCLSolverType>();
         static auto ScalingSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, ScalingSolverType>();
+        static auto SupernodalCholeskySolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, SupernodalCholeskySolverType>();
+        static auto FloatSupernodalCholeskySolverFactory = StandardLinearSolverFactory<FloatSpaceType, FloatLocalSpaceType, FloatSupernodalCholeskySolverType>();
+        static auto MixedPrecisionRefinementSolverFactory = StandardLinearSolverFactory<SpaceType, LocalSpaceType, MixedPrecisionRefinementSolverType>();
         static auto SkyLineLUComplexSolverFactory = StandardLinearSolverFactory<ComplexSpaceType, ComplexLocalSpaceType, SkyLineLUComplexSolverType>();
 
         QUEST_REGISTER_LINEAR_SOLVER("cg", CGSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("pipelined_cg", PipelinedCGSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("block_cg", BlockCGSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("recycling_cg", RecyclingCGSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("gmres", GMRESSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("bicgstab_l", BiCGStabLSolverFactory);
         QUEST_REGISTER_LINEAR_SOLVER("scaling", ScalingSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("amgcl", AMGCLSolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("supernodal_cholesky", SupernodalCholeskySolverFactory);
+        QUEST_REGISTER_LINEAR_SOLVER("mixed_precision_refinement", MixedPrecisionRefinementSolverFactory);
+        QUEST_REGISTER_FLOAT_LINEAR_SOLVER("supernodal_cholesky", FloatSupernodalCholeskySolverFactory);
         // QUEST_REGISTER_COMPLEX_LINEAR_SOLVER("skyline_lu_complex", SkyLineLUComplexSolverFactory);
     }
 
@@ -20,7 +20,7 @@ namespace Quest{
     template<typename TSparseSpace, typename TLocalSpace, typename TLinearSolverType>
     class StandardLinearSolverFactory : public LinearSolverFactory<TSparseSpace, TLocalSpace>{
         public:
-
+            using LinearSolverType = LinearSolver<TSparseSpace, TLocalSpace>;
 
         public:
 
@@ -39,9 +39,6 @@ namespace Quest{
             }
 
         private:
-            using LinearSolverType = LinearSolver<TSparseSpace, TLocalSpace>;
-
-        private:
 
 
     };
@@ -4,6 +4,10 @@
 
 #include "linear_solvers/preconditioner/preconditioner.hpp"
 #include "linear_solvers/preconditioner/diagonal_preconditioner.hpp"
+#include "linear_solvers/preconditioner/mixed_precision_polynomial_preconditioner.hpp"
+#include "linear_solvers/preconditioner/chebyshev_preconditioner.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/preconditioner/ilut_preconditioner.hpp"
 
 
 namespace Quest{
@@ -14,12 +18,24 @@ namespace Quest{
 
         using PreconditionerType = Preconditioner<SpaceType, LocalSpaceType>;
         using DiagonalPreconditionerType = DiagonalPreconditioner<SpaceType, LocalSpaceType>;
+        using MixedPrecisionPolynomialPreconditionerType = MixedPrecisionPolynomialPreconditioner<SpaceType, LocalSpaceType>;
+        using ChebyshevPreconditionerType = ChebyshevPreconditioner<SpaceType, LocalSpaceType>;
+        using ILU0PreconditionerType = ILU0Preconditioner<SpaceType, LocalSpaceType>;
+        using ILUTPreconditionerType = ILUTPreconditioner<SpaceType, LocalSpaceType>;
 
         static auto PreconditionerFactory = StandardPreconditionerFactory<SpaceType, LocalSpaceType, PreconditionerType>();
         static auto DiagonalPreconditionerFactory = StandardPreconditionerFactory<SpaceType, LocalSpaceType, DiagonalPreconditionerType>();
+        static auto MixedPrecisionPolynomialPreconditionerFactory = StandardPreconditionerFactory<SpaceType, LocalSpaceType, MixedPrecisionPolynomialPreconditionerType>();
+        static auto ChebyshevPreconditionerFactory = StandardPreconditionerFactory<SpaceType, LocalSpaceType, ChebyshevPreconditionerType>();
+        static auto ILU0PreconditionerFactory = StandardPreconditionerFactory<SpaceType, LocalSpaceType, ILU0PreconditionerType>();
+        static auto ILUTPreconditionerFactory = StandardPreconditionerFactory<SpaceType, LocalSpaceType, ILUTPreconditionerType>();
 
         QUEST_REGISTER_PRECONDITIONER("none", PreconditionerFactory);
         QUEST_REGISTER_PRECONDITIONER("diagonal", DiagonalPreconditionerFactory);
+        QUEST_REGISTER_PRECONDITIONER("mixed_precision_polynomial", MixedPrecisionPolynomialPreconditionerFactory);
+        QUEST_REGISTER_PRECONDITIONER("chebyshev", ChebyshevPreconditionerFactory);
+        QUEST_REGISTER_PRECONDITIONER("ilu0", ILU0PreconditionerFactory);
+        QUEST_REGISTER_PRECONDITIONER("ilut", ILUTPreconditionerFactory);
     };
 
 }
\ No newline at end of file
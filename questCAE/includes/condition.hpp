@@ -4,6 +4,7 @@
 // 项目头文件
 #include "includes/properties.hpp"
 #include "includes/process_info.hpp"
+#include "includes/local_system_batch.hpp"
 #include "includes/geometrical_object.hpp"
 #include "includes/quest_parameters.hpp"
 #include "container/global_pointers_vector.hpp"
@@ -264,6 +265,31 @@ namespace Quest{
                 }
             }
 
+            /**
+             * @brief 批量计算一批同类型条件的局部系统，结果按结构数组写入 rBatch
+             * @details 在批中任一条件上调用，构建器保证批中所有条件的动态类型与局部系统尺寸相同。
+             *  默认实现逐个调用 CalculateLocalSystem 并复制到 rBatch，热点条件类型可重写此方法，跨条件向量化计算。
+             *  重写时须先调用 rBatch.Initialize(rConditions.size(), LocalSize)，第 k 个条件的结果写入第 k 个位置
+             * @param rConditions 同类型的条件
+             * @param rBatch 局部系统的批量结果
+             * @param rCurrentProcessInfo 当前过程信息实例
+             */
+            virtual void CalculateLocalSystemBatch(
+                const Quest::span<Condition* const> rConditions,
+                LocalSystemBatch& rBatch,
+                const ProcessInfo& rCurrentProcessInfo
+            ){
+                auto& r_lhs = rBatch.GetLhsScratch();
+                auto& r_rhs = rBatch.GetRhsScratch();
+                for(std::size_t lane=0; lane<rConditions.size(); ++lane){
+                    rConditions[lane]->CalculateLocalSystem(r_lhs, r_rhs, rCurrentProcessInfo);
+                    if(lane == 0){
+                        rBatch.Initialize(rConditions.size(), r_rhs.size());
+                    }
+                    rBatch.SetLane(lane, r_lhs, r_rhs);
+                }
+            }
+
             /**
              * 在组装过程中调用，仅用于计算条件左端矩阵
              * @param rLeftHandSideMatrix 条件左端矩阵
@@ -4,6 +4,7 @@
 // 项目头文件
 #include "includes/properties.hpp"
 #include "includes/process_info.hpp"
+#include "includes/local_system_batch.hpp"
 #include "includes/geometrical_object.hpp"
 #include "includes/constitutive_law.hpp"
 #include "includes/quest_parameters.hpp"
@@ -266,6 +267,31 @@ namespace Quest{
                 }
             }
 
+            /**
+             * @brief 批量计算一批同类型单元的局部系统，结果按结构数组写入 rBatch
+             * @details 在批中任一单元上调用，构建器保证批中所有单元的动态类型与局部系统尺寸相同。
+             *  默认实现逐个调用 CalculateLocalSystem 并复制到 rBatch，热点单元类型可重写此方法，跨单元向量化计算。
+             *  重写时须先调用 rBatch.Initialize(rElements.size(), LocalSize)，第 k 个单元的结果写入第 k 个位置
+             * @param rElements 同类型的单元
+             * @param rBatch 局部系统的批量结果
+             * @param rCurrentProcessInfo 当前过程信息实例
+             */
+            virtual void CalculateLocalSystemBatch(
+                const Quest::span<Element* const> rElements,
+                LocalSystemBatch& rBatch,
+                const ProcessInfo& rCurrentProcessInfo
+            ){
+                auto& r_lhs = rBatch.GetLhsScratch();
+                auto& r_rhs = rBatch.GetRhsScratch();
+                for(std::size_t lane=0; lane<rElements.size(); ++lane){
+                    rElements[lane]->CalculateLocalSystem(r_lhs, r_rhs, rCurrentProcessInfo);
+                    if(lane == 0){
+                        rBatch.Initialize(rElements.size(), r_rhs.size());
+                    }
+                    rBatch.SetLane(lane, r_lhs, r_rhs);
+                }
+            }
+
             /**
              * @brief 在组装过程中调用此方法，仅计算单元的左侧矩阵
              * @param rLeftHandSideMatrix 单元的左侧矩阵
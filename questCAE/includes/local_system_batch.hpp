@@ -0,0 +1,271 @@
+/*---------------------------------------------
+同类型实体局部系统的批量结果
+按结构数组（SoA）存放，便于跨实体向量化
+----------------------------------------------*/
+
+#ifndef QUEST_LOCAL_SYSTEM_BATCH_HPP
+#define QUEST_LOCAL_SYSTEM_BATCH_HPP
+
+// 系统头文件
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+// 第三方头文件
+#include "span/span.hpp"
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/ublas_interface.hpp"
+#include "utilities/cpu_features.hpp"
+
+namespace Quest{
+
+    /**
+     * @class LocalSystemBatch
+     * @brief 一批局部尺寸相同的实体的局部系统（左端矩阵与右端向量）
+     * @details 第 Lane 个实体的 LHS(i,j) 存放在 mLhs[(i*LocalSize + j)*LaneStride + Lane]，
+     *  RHS(i) 存放在 mRhs[i*LaneStride + Lane]。同一个局部分量在各实体之间连续存放，
+     *  向量化的核函数可以对 LhsLanes(i,j)/RhsLanes(i) 直接按SIMD宽度读写。
+     *  容量只增不减，重复调用 Initialize 不会重新分配内存
+     */
+    class LocalSystemBatch final{
+        public:
+            using IndexType = std::size_t;
+            using DataType = double;
+            using MatrixType = Matrix;
+            using VectorType = Vector;
+            using EquationIdVectorType = std::vector<IndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(LocalSystemBatch);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            LocalSystemBatch(){}
+
+
+            /**
+             * @brief 设置批大小与局部尺寸，不清零已有的数值
+             * @param NumberOfLanes 批中实体的个数
+             * @param LocalSize 每个实体局部系统的尺寸
+             */
+            void Initialize(const IndexType NumberOfLanes, const IndexType LocalSize){
+                mNumberOfLanes = NumberOfLanes;
+                mLocalSize = LocalSize;
+                mLaneStride = NumberOfLanes;
+                if(mLhs.size() < LocalSize*LocalSize*NumberOfLanes){
+                    mLhs.resize(LocalSize*LocalSize*NumberOfLanes);
+                }
+                if(mRhs.size() < LocalSize*NumberOfLanes){
+                    mRhs.resize(LocalSize*NumberOfLanes);
+                }
+            }
+
+
+            /**
+             * @brief 把当前批的所有数值置零
+             */
+            void SetToZero(){
+                std::fill(mLhs.begin(), mLhs.begin() + mLocalSize*mLocalSize*mLaneStride, DataType());
+                std::fill(mRhs.begin(), mRhs.begin() + mLocalSize*mLaneStride, DataType());
+            }
+
+
+            /**
+             * @brief 返回批中实体的个数
+             */
+            IndexType NumberOfLanes() const{
+                return mNumberOfLanes;
+            }
+
+
+            /**
+             * @brief 返回局部系统的尺寸
+             */
+            IndexType LocalSize() const{
+                return mLocalSize;
+            }
+
+
+            /**
+             * @brief 返回同一局部分量相邻两个实体之间的间距
+             */
+            IndexType LaneStride() const{
+                return mLaneStride;
+            }
+
+
+            /**
+             * @brief 第 Lane 个实体的 LHS(i,j)
+             */
+            DataType& LHS(const IndexType Lane, const IndexType i, const IndexType j){
+                QUEST_DEBUG_ERROR_IF(Lane >= mNumberOfLanes || i >= mLocalSize || j >= mLocalSize) << "Index (" << Lane << "," << i << "," << j << ") out of range" << std::endl;
+                return mLhs[(i*mLocalSize + j)*mLaneStride + Lane];
+            }
+
+
+            DataType LHS(const IndexType Lane, const IndexType i, const IndexType j) const{
+                QUEST_DEBUG_ERROR_IF(Lane >= mNumberOfLanes || i >= mLocalSize || j >= mLocalSize) << "Index (" << Lane << "," << i << "," << j << ") out of range" << std::endl;
+                return mLhs[(i*mLocalSize + j)*mLaneStride + Lane];
+            }
+
+
+            /**
+             * @brief 第 Lane 个实体的 RHS(i)
+             */
+            DataType& RHS(const IndexType Lane, const IndexType i){
+                QUEST_DEBUG_ERROR_IF(Lane >= mNumberOfLanes || i >= mLocalSize) << "Index (" << Lane << "," << i << ") out of range" << std::endl;
+                return mRhs[i*mLaneStride + Lane];
+            }
+
+
+            DataType RHS(const IndexType Lane, const IndexType i) const{
+                QUEST_DEBUG_ERROR_IF(Lane >= mNumberOfLanes || i >= mLocalSize) << "Index (" << Lane << "," << i << ") out of range" << std::endl;
+                return mRhs[i*mLaneStride + Lane];
+            }
+
+
+            /**
+             * @brief 返回所有实体的 LHS(i,j)，共 NumberOfLanes() 个连续的值
+             */
+            DataType* LhsLanes(const IndexType i, const IndexType j){
+                return mLhs.data() + (i*mLocalSize + j)*mLaneStride;
+            }
+
+
+            /**
+             * @brief 返回所有实体的 RHS(i)，共 NumberOfLanes() 个连续的值
+             */
+            DataType* RhsLanes(const IndexType i){
+                return mRhs.data() + i*mLaneStride;
+            }
+
+
+            /**
+             * @brief 把一个实体的稠密局部系统写入第 Lane 个位置
+             */
+            void SetLane(const IndexType Lane, const MatrixType& rLHS, const VectorType& rRHS){
+                QUEST_DEBUG_ERROR_IF(Lane >= mNumberOfLanes) << "Lane " << Lane << " exceeds the number of lanes " << mNumberOfLanes << std::endl;
+                QUEST_ERROR_IF(rLHS.size1() != mLocalSize || rLHS.size2() != mLocalSize || rRHS.size() != mLocalSize)
+                    << "The local system of lane " << Lane << " has size (" << rLHS.size1() << "x" << rLHS.size2() << ", " << rRHS.size()
+                    << ") but the batch local size is " << mLocalSize << ". All entities of a batch must have the same local size" << std::endl;
+
+                for(IndexType i=0; i<mLocalSize; ++i){
+                    for(IndexType j=0; j<mLocalSize; ++j){
+                        mLhs[(i*mLocalSize + j)*mLaneStride + Lane] = rLHS(i,j);
+                    }
+                    mRhs[i*mLaneStride + Lane] = rRHS[i];
+                }
+            }
+
+
+            /**
+             * @brief 逐实体计算时使用的临时左端矩阵
+             */
+            MatrixType& GetLhsScratch(){
+                return mLhsScratch;
+            }
+
+
+            /**
+             * @brief 逐实体计算时使用的临时右端向量
+             */
+            VectorType& GetRhsScratch(){
+                return mRhsScratch;
+            }
+
+
+            /**
+             * @brief 逐实体计算时使用的临时方程编号
+             */
+            EquationIdVectorType& GetEquationIdScratch(){
+                return mEquationIdScratch;
+            }
+
+
+            /**
+             * @brief 按当前使用的SIMD级别返回默认批大小（一个SIMD寄存器可容纳的双精度数，至少为2）
+             */
+            static IndexType GetDefaultBatchSize(){
+                switch(CpuFeatures::GetSimdLevel()){
+                    case SimdLevel::AVX512:
+                        return 8;
+                    case SimdLevel::AVX2:
+                        return 4;
+                    default:
+                        return 2;
+                }
+            }
+
+
+            std::string Info() const{
+                return "LocalSystemBatch";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of lanes : " << mNumberOfLanes << " local size : " << mLocalSize << std::endl;
+            }
+
+        private:
+            /**
+             * @brief 批中实体的个数
+             */
+            IndexType mNumberOfLanes = 0;
+
+            /**
+             * @brief 局部系统的尺寸
+             */
+            IndexType mLocalSize = 0;
+
+            /**
+             * @brief 同一局部分量相邻两个实体之间的间距
+             */
+            IndexType mLaneStride = 0;
+
+            /**
+             * @brief 左端矩阵（SoA）
+             */
+            std::vector<DataType> mLhs;
+
+            /**
+             * @brief 右端向量（SoA）
+             */
+            std::vector<DataType> mRhs;
+
+            /**
+             * @brief 逐实体计算时使用的临时左端矩阵
+             */
+            MatrixType mLhsScratch;
+
+            /**
+             * @brief 逐实体计算时使用的临时右端向量
+             */
+            VectorType mRhsScratch;
+
+            /**
+             * @brief 逐实体计算时使用的临时方程编号
+             */
+            EquationIdVectorType mEquationIdScratch;
+
+    };
+
+
+    inline std::ostream& operator << (std::ostream& rOstream, const LocalSystemBatch& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_LOCAL_SYSTEM_BATCH_HPP
@@ -25,6 +25,7 @@
 #include "includes/master_slave_constraint.hpp"
 #include "container/variable.hpp"
 #include "container/variable_data.hpp"
+#include "utilities/entity_coloring_utilities.hpp"
 
 namespace Quest{
 
@@ -1360,6 +1361,20 @@ namespace Quest{
                 return GetMesh(ThisIndex).ConditionsArray();
             }
 
+            /**
+             * @brief 返回单元与条件的着色，用于无原子操作的并行组装
+             * @details 着色在首次调用时构建并缓存；单元、条件的数目或连接关系（实体编号与节点编号）变化时自动重建
+             */
+            const ModelPartColoring& GetColoring();
+
+            /**
+             * @brief 清除缓存的单元与条件着色
+             * @details 只用于释放内存，缓存过期时 GetColoring() 会自行重建
+             */
+            void ResetColoring(){
+                mpColoring.reset();
+            }
+
             /**
              * @brief 获取指定ID的网格的几何对象的数量
              */
@@ -2052,6 +2067,11 @@ namespace Quest{
              */
             SubModelPartsContainerType mSubModelParts;
 
+            /**
+             * @brief 缓存的单元与条件着色
+             */
+            ModelPartColoring::Pointer mpColoring = nullptr;
+
             /**
              * @brief 包含该模型部件的模型
              */
@@ -11,6 +11,7 @@
 #include "includes/define.hpp"
 #include "container/data_value_container.hpp"
 #include "container/flags.hpp"
+#include "utilities/scratch_arena.hpp"
 
 namespace Quest{
 
@@ -271,6 +272,15 @@ namespace Quest{
                 mSolutionStepIndex = NewIndex;
             }
 
+            /**
+             * @brief 获取当前线程的临时内存池
+             * @details 构建器在计算每个单元/条件的局部系统前后记录并回退内存池，
+             *  因此在 CalculateLocalSystem 等函数中分配的临时量无需释放，但不能保存到函数返回之后
+             */
+            ScratchArena& GetScratchArena() const{
+                return ScratchArena::GetThreadLocalArena();
+            }
+
 
             std::string Info() const override{
                 return "Process Info";
@@ -55,7 +55,7 @@ namespace Quest{
             static void Add(const std::string& rName, const TComponentType& rComponent){
                 auto it_comp = msComponents.find(rName);
                 QUEST_ERROR_IF(it_comp != msComponents.end() && typeid(*(it_comp->second)) != typeid(rComponent)) << "The component \"" << rName << "\" has already been registered with a different type." << std::endl;
-                msComponenets.insert(ValueType(rName, &rComponent));
+                msComponents.insert(ValueType(rName, &rComponent));
             }
 
 
@@ -110,6 +110,10 @@ namespace Quest{
                 return "Quest Components";
             }
 
+            virtual void PrintInfo(std::ostream& rOStream) const{
+                rOStream << Info();
+            }
+
             virtual void PrintData(std::ostream& rOStream) const{
                 for(const auto& rComp : msComponents){
                     rOStream << "    " << rComp.first << std::endl;
@@ -147,6 +151,13 @@ namespace Quest{
     };
 
 
+    /**
+     * @brief 组件容器的定义，随 quest_components.cpp 中的显式实例化生成
+     */
+    template<typename TComponentType>
+    typename QuestComponents<TComponentType>::ComponentsContainerType QuestComponents<TComponentType>::msComponents;
+
+
     template<>
     class QUEST_API(QUEST_CORE) QuestComponents<VariableData>{
         public:
@@ -201,6 +212,10 @@ namespace Quest{
                 return "Quest Components <VariableData>";
             }
 
+            virtual void PrintInfo(std::ostream& rOStream) const{
+                rOStream << Info();
+            }
+
             virtual void PrintData(std::ostream& rOStream) const{
                 for(const auto& rComp : msComponents){
                     rOStream << "    " << rComp.first << std::endl;
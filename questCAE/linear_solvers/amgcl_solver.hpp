@@ -0,0 +1,525 @@
+#ifndef QUEST_AMGCL_SOLVER_HPP
+#define QUEST_AMGCL_SOLVER_HPP
+
+// 系统头文件
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+// 第三方头文件
+#include <boost/property_tree/ptree.hpp>
+#include <amgcl/backend/builtin.hpp>
+#include <amgcl/adapter/zero_copy.hpp>
+#include <amgcl/adapter/ublas.hpp>
+#include <amgcl/amg.hpp>
+#include <amgcl/coarsening/runtime.hpp>
+#include <amgcl/relaxation/runtime.hpp>
+#include <amgcl/solver/runtime.hpp>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/quest_parameters.hpp"
+#include "linear_solvers/linear_solver.hpp"
+
+namespace Quest{
+
+    /**
+     * @class AMGCLSolver
+     * @brief 基于 amgcl 的代数多重网格求解器
+     * @details 以代数多重网格（AMG）作为 Krylov 求解器（默认CG）的预处理器，适用于大规模椭圆型问题。
+     *  系统矩阵以 amgcl::adapter::zero_copy 直接映射稀疏空间矩阵的CSR数组，不做额外复制。
+     *  粗化方法、光滑器、Krylov 方法及块大小均可由 Parameters 设置：
+     *  - coarsening_type：ruge_stuben、aggregation、smoothed_aggregation、smoothed_aggr_emin
+     *  - smoother_type：spai0、spai1、damped_jacobi、gauss_seidel、ilu0、iluk、ilup、ilut、chebyshev
+     *  - krylov_type：cg、bicgstab、bicgstabl、gmres、lgmres、fgmres、idrs、richardson、preonly
+     *  - block_size：每个节点的自由度数，聚合类粗化按节点整体聚合
+     *  reuse_hierarchy 为真且矩阵稀疏模式（按行数、非零元个数与索引数组的散列判断）未变时，只用新的数值重新计算各层粗网格矩阵与光滑器，沿用已有的插值/限制算子。
+     *  多重网格层次与 Krylov 求解器分开保存，修改容差只重建后者，不丢弃已构建的层次
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     * @tparam TReordererType 重排序器类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class AMGCLSolver : public LinearSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(AMGCLSolver);
+
+            using BaseType = LinearSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+            using DataType = typename TSparseSpaceType::DataType;
+            using IndexType = typename BaseType::IndexType;
+            using BackendType = amgcl::backend::builtin<DataType>;
+            using AMGType = amgcl::amg<BackendType, amgcl::runtime::coarsening::wrapper, amgcl::runtime::relaxation::wrapper>;
+            using KrylovSolverType = amgcl::runtime::solver::wrapper<BackendType>;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            AMGCLSolver(){
+                Parameters default_settings(GetDefaultParameters());
+                SetParameters(default_settings);
+            }
+
+            /**
+             * @brief 构造函数
+             * @param rSettings 求解器设置，缺省项取 GetDefaultParameters() 中的值
+             */
+            AMGCLSolver(Parameters rSettings){
+                QUEST_TRY
+
+                rSettings.ValidateAndAssignDefaults(GetDefaultParameters());
+                SetParameters(rSettings);
+
+                QUEST_CATCH("")
+            }
+
+            /**
+             * @brief 复制构造函数
+             * @details 只复制设置，多重网格层次在下一次求解时重新构建
+             */
+            AMGCLSolver(const AMGCLSolver& rOther):
+                BaseType(rOther),
+                mAMGCLParameters(rOther.mAMGCLParameters),
+                mTolerance(rOther.mTolerance),
+                mMaxIterationsNumber(rOther.mMaxIterationsNumber),
+                mReuseHierarchy(rOther.mReuseHierarchy),
+                mVerbosity(rOther.mVerbosity)
+            {}
+
+            /**
+             * @brief 析构函数
+             */
+            ~AMGCLSolver() override{
+                Clear();
+            }
+
+            /**
+             * @brief 赋值运算符
+             */
+            AMGCLSolver& operator = (const AMGCLSolver& rOther){
+                BaseType::operator=(rOther);
+                mAMGCLParameters = rOther.mAMGCLParameters;
+                mTolerance = rOther.mTolerance;
+                mMaxIterationsNumber = rOther.mMaxIterationsNumber;
+                mReuseHierarchy = rOther.mReuseHierarchy;
+                mVerbosity = rOther.mVerbosity;
+                Clear();
+                return *this;
+            }
+
+            /**
+             * @brief 返回默认设置
+             */
+            static Parameters GetDefaultParameters(){
+                return Parameters(R"({
+                    "solver_type": "amgcl",
+                    "krylov_type": "cg",
+                    "smoother_type": "spai0",
+                    "coarsening_type": "smoothed_aggregation",
+                    "tolerance": 1e-6,
+                    "max_iteration": 200,
+                    "gmres_krylov_space_dimension": 100,
+                    "block_size": 1,
+                    "coarse_enough": 1000,
+                    "max_levels": 0,
+                    "pre_sweeps": 1,
+                    "post_sweeps": 1,
+                    "reuse_hierarchy": true,
+                    "verbosity": 0,
+                    "scaling": false
+                })");
+            }
+
+            /**
+             * @brief 构建多重网格层次
+             * @details 稀疏模式与上次相同且允许重用时只重算数值，否则完整重建
+             */
+            void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(mReuseHierarchy && mpPreconditioner && IsBuiltFor(rA)){
+                    VisitMappedMatrix(rA, [this](const auto& rMatrix){
+                        mpPreconditioner->rebuild(rMatrix);
+                    });
+                    ++mNumberOfNumericRebuilds;
+                } else {
+                    mpPreconditioner.reset();
+                    mpKrylovSolver.reset();
+                    VisitMappedMatrix(rA, [this](const auto& rMatrix){
+                        mpPreconditioner = std::make_shared<AMGType>(rMatrix, typename AMGType::params(mAMGCLParameters.get_child("precond")));
+                    });
+                    mNumberOfRows = rA.size1();
+                    mNumberOfNonZeros = NumberOfNonZeros(rA);
+                    mPatternHash = PatternHash(rA);
+                    mNumberOfNumericRebuilds = 0;
+                }
+                if(!mpKrylovSolver){
+                    mpKrylovSolver = std::make_shared<KrylovSolverType>(mNumberOfRows, mAMGCLParameters.get_child("solver"));
+                }
+            }
+
+            /**
+             * @brief 执行求解
+             */
+            void PerformSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                QUEST_ERROR_IF(!mpPreconditioner || !mpKrylovSolver) << "AMGCLSolver: InitializeSolutionStep must be called before PerformSolutionStep" << std::endl;
+
+                if constexpr(amgcl::backend::is_builtin_vector<VectorType>::value){
+                    std::tie(mIterationsNumber, mResidualNorm) = (*mpKrylovSolver)(*mpPreconditioner, rB, rX);
+                } else {
+                    mB.resize(rB.size());
+                    mX.resize(rX.size());
+                    std::copy(std::begin(rB), std::end(rB), mB.begin());
+                    std::copy(std::begin(rX), std::end(rX), mX.begin());
+                    std::tie(mIterationsNumber, mResidualNorm) = (*mpKrylovSolver)(*mpPreconditioner, mB, mX);
+                    std::copy(mX.begin(), mX.end(), std::begin(rX));
+                }
+
+                QUEST_WARNING_IF("AMGCL Linear Solver", mResidualNorm > mTolerance) << "Non converged linear solution. ["
+                    << mResidualNorm << " > " << mTolerance << "]" << std::endl;
+
+                if(mVerbosity > 0){
+                    QUEST_INFO("AMGCL Linear Solver") << "iterations : " << mIterationsNumber << " relative residual : " << mResidualNorm << std::endl;
+                }
+                if(mVerbosity > 1){
+                    QUEST_INFO("AMGCL Linear Solver") << *mpPreconditioner << std::endl;
+                }
+            }
+
+            /**
+             * @brief 求解线性系统 rA*rX = rB，rX 同时作为初始猜测
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB)){
+                    return false;
+                }
+
+                InitializeSolutionStep(rA, rX, rB);
+                PerformSolutionStep(rA, rX, rB);
+                this->FinalizeSolutionStep(rA, rX, rB);
+
+                return mResidualNorm <= mTolerance;
+            }
+
+            /**
+             * @brief 多重右端项求解，各列共用同一多重网格层次
+             * @details 与单右端项求解一样依次调用 InitializeSolutionStep、PerformSolutionStep 与 FinalizeSolutionStep，
+             *  前者只在第一列调用一次，后者以最后一列调用一次
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB)){
+                    return false;
+                }
+
+                const unsigned int number_of_columns = TDenseSpaceType::Size2(rX);
+                if(number_of_columns == 0){
+                    return true;
+                }
+
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                bool is_solved = true;
+                for(unsigned int i = 0; i < number_of_columns; ++i){
+                    TDenseSpaceType::GetColumn(i, rX, x);
+                    TDenseSpaceType::GetColumn(i, rB, b);
+                    if(i == 0){
+                        InitializeSolutionStep(rA, x, b);
+                    }
+                    PerformSolutionStep(rA, x, b);
+                    is_solved &= mResidualNorm <= mTolerance;
+                    TDenseSpaceType::SetColumn(i, rX, x);
+                }
+                this->FinalizeSolutionStep(rA, x, b);
+
+                return is_solved;
+            }
+
+            /**
+             * @brief 清除多重网格层次
+             */
+            void Clear() override{
+                mpPreconditioner.reset();
+                mpKrylovSolver.reset();
+                mNumberOfRows = 0;
+                mNumberOfNonZeros = 0;
+                mPatternHash = 0;
+                mNumberOfNumericRebuilds = 0;
+                std::vector<DataType>().swap(mX);
+                std::vector<DataType>().swap(mB);
+            }
+
+            /**
+             * @brief 设置收敛容差
+             * @details 只在下一次求解前按新容差重建 Krylov 求解器，已构建的多重网格层次保持不变
+             */
+            void SetTolerance(double NewTolerance) override{
+                mTolerance = NewTolerance;
+                mAMGCLParameters.put("solver.tol", NewTolerance);
+                mpKrylovSolver.reset();
+            }
+
+            /**
+             * @brief 返回收敛容差
+             */
+            double GetTolerance() override{
+                return mTolerance;
+            }
+
+            /**
+             * @brief 返回上一次求解的迭代次数
+             */
+            IndexType GetIterationsNumber() override{
+                return mIterationsNumber;
+            }
+
+            /**
+             * @brief 返回上一次求解的相对残差
+             */
+            double GetResidualNorm() const{
+                return mResidualNorm;
+            }
+
+            /**
+             * @brief 返回自上次完整构建以来只重算数值的次数
+             */
+            std::size_t GetNumberOfNumericRebuilds() const{
+                return mNumberOfNumericRebuilds;
+            }
+
+            /**
+             * @brief 返回传递给 amgcl 的参数树
+             */
+            const boost::property_tree::ptree& GetAMGCLParameters() const{
+                return mAMGCLParameters;
+            }
+
+
+            std::string Info() const override{
+                return "AMGCL Linear Solver";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "AMGCL Linear Solver";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "krylov : " << mAMGCLParameters.get<std::string>("solver.type")
+                    << " coarsening : " << mAMGCLParameters.get<std::string>("precond.coarsening.type")
+                    << " smoother : " << mAMGCLParameters.get<std::string>("precond.relax.type")
+                    << " tolerance : " << mTolerance << " max iterations : " << mMaxIterationsNumber << std::endl;
+                if(mpPreconditioner){
+                    rOstream << *mpPreconditioner << std::endl;
+                }
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 把 Parameters 转换为 amgcl 的参数树
+             */
+            void SetParameters(Parameters& rSettings){
+                mTolerance = rSettings["tolerance"].GetDouble();
+                mMaxIterationsNumber = rSettings["max_iteration"].GetInt();
+                mReuseHierarchy = rSettings["reuse_hierarchy"].GetBool();
+                mVerbosity = rSettings["verbosity"].GetInt();
+
+                const std::string krylov_type = rSettings["krylov_type"].GetString();
+                const std::string coarsening_type = rSettings["coarsening_type"].GetString();
+                const int block_size = rSettings["block_size"].GetInt();
+                const int max_levels = rSettings["max_levels"].GetInt();
+
+                QUEST_ERROR_IF(block_size < 1) << "AMGCLSolver: block_size must be positive, got " << block_size << std::endl;
+                QUEST_ERROR_IF(block_size > 1 && coarsening_type == "ruge_stuben")
+                    << "AMGCLSolver: block_size > 1 requires an aggregation based coarsening, ruge_stuben was given" << std::endl;
+
+                mAMGCLParameters.clear();
+                mAMGCLParameters.put("solver.type", krylov_type);
+                mAMGCLParameters.put("solver.tol", mTolerance);
+                mAMGCLParameters.put("solver.maxiter", mMaxIterationsNumber);
+                if(krylov_type == "gmres" || krylov_type == "lgmres" || krylov_type == "fgmres"){
+                    mAMGCLParameters.put("solver.M", rSettings["gmres_krylov_space_dimension"].GetInt());
+                }
+
+                mAMGCLParameters.put("precond.coarsening.type", coarsening_type);
+                if(block_size > 1){
+                    mAMGCLParameters.put("precond.coarsening.aggr.block_size", block_size);
+                }
+                mAMGCLParameters.put("precond.relax.type", rSettings["smoother_type"].GetString());
+                mAMGCLParameters.put("precond.coarse_enough", rSettings["coarse_enough"].GetInt());
+                if(max_levels > 0){
+                    mAMGCLParameters.put("precond.max_levels", max_levels);
+                }
+                mAMGCLParameters.put("precond.npre", rSettings["pre_sweeps"].GetInt());
+                mAMGCLParameters.put("precond.npost", rSettings["post_sweeps"].GetInt());
+                mAMGCLParameters.put("precond.allow_rebuild", mReuseHierarchy);
+
+                mpPreconditioner.reset();
+                mpKrylovSolver.reset();
+            }
+
+            /**
+             * @brief 以零复制方式把稀疏空间矩阵映射为 amgcl 矩阵并传给 rFunction
+             * @details 索引类型与 ptrdiff_t 等宽时直接映射为 amgcl 的内置CSR类型，否则保留原索引类型映射
+             */
+            template<typename TFunctionType>
+            static void VisitMappedMatrix(SparseMatrixType& rA, TFunctionType&& rFunction){
+                const std::size_t size = rA.size1();
+                const auto* p_row = &rA.index1_data()[0];
+                const auto* p_col = &rA.index2_data()[0];
+                const auto* p_val = &rA.value_data()[0];
+                using RowIndexType = std::decay_t<decltype(*p_row)>;
+                using ColIndexType = std::decay_t<decltype(*p_col)>;
+                if constexpr(sizeof(RowIndexType) == sizeof(std::ptrdiff_t) && sizeof(ColIndexType) == sizeof(std::ptrdiff_t)){
+                    rFunction(*amgcl::adapter::zero_copy(size, p_row, p_col, p_val));
+                } else {
+                    rFunction(*amgcl::adapter::zero_copy_direct(size, p_row, p_col, p_val));
+                }
+            }
+
+            /**
+             * @brief 返回矩阵的非零元个数
+             */
+            static std::size_t NumberOfNonZeros(const SparseMatrixType& rA){
+                return rA.size1() == 0 ? 0 : static_cast<std::size_t>(rA.index1_data()[rA.size1()]);
+            }
+
+            /**
+             * @brief 以行数、非零元个数与索引数组的散列判断已有的多重网格层次是否由该矩阵的当前稀疏模式构建
+             * @details 不比较索引数组的地址：原地重写的同规模稀疏模式地址不变，而拷贝得到的相同模式地址不同
+             */
+            bool IsBuiltFor(const SparseMatrixType& rA) const{
+                return mNumberOfRows == rA.size1()
+                    && mNumberOfNonZeros == NumberOfNonZeros(rA)
+                    && mPatternHash == PatternHash(rA);
+            }
+
+            /**
+             * @brief 稀疏模式的 64 位 FNV-1a 散列
+             */
+            static std::uint64_t PatternHash(const SparseMatrixType& rA){
+                const std::size_t size = rA.size1();
+                const std::size_t nnz = NumberOfNonZeros(rA);
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                std::uint64_t hash = 14695981039346656037ULL;
+                auto mix = [&hash](const std::uint64_t Value){
+                    hash ^= Value;
+                    hash *= 1099511628211ULL;
+                };
+                if(size > 0){
+                    for(std::size_t i=0; i<=size; ++i){
+                        mix(static_cast<std::uint64_t>(r_row_indices[i]));
+                    }
+                }
+                for(std::size_t k=0; k<nnz; ++k){
+                    mix(static_cast<std::uint64_t>(r_col_indices[k]));
+                }
+                return hash;
+            }
+
+        private:
+            /**
+             * @brief amgcl 参数树
+             */
+            boost::property_tree::ptree mAMGCLParameters;
+
+            /**
+             * @brief 多重网格层次（作为预处理器）
+             */
+            std::shared_ptr<AMGType> mpPreconditioner;
+
+            /**
+             * @brief Krylov 求解器，持有与容差、迭代次数相关的设置及工作向量
+             */
+            std::shared_ptr<KrylovSolverType> mpKrylovSolver;
+
+            /**
+             * @brief 收敛容差（相对残差）
+             */
+            double mTolerance = 1e-6;
+
+            /**
+             * @brief 最大迭代次数
+             */
+            int mMaxIterationsNumber = 200;
+
+            /**
+             * @brief 稀疏模式不变时是否只重算数值
+             */
+            bool mReuseHierarchy = true;
+
+            /**
+             * @brief 输出级别
+             */
+            int mVerbosity = 0;
+
+            /**
+             * @brief 上一次求解的迭代次数
+             */
+            std::size_t mIterationsNumber = 0;
+
+            /**
+             * @brief 上一次求解的相对残差
+             */
+            double mResidualNorm = 0.0;
+
+            /**
+             * @brief 构建层次时矩阵的行数
+             */
+            std::size_t mNumberOfRows = 0;
+
+            /**
+             * @brief 构建层次时矩阵的非零元个数
+             */
+            std::size_t mNumberOfNonZeros = 0;
+
+            /**
+             * @brief 构建层次时稀疏模式的散列
+             */
+            std::uint64_t mPatternHash = 0;
+
+            /**
+             * @brief 自上次完整构建以来只重算数值的次数
+             */
+            std::size_t mNumberOfNumericRebuilds = 0;
+
+            /**
+             * @brief 向量类型不被 amgcl 直接识别时使用的解向量缓冲
+             */
+            std::vector<DataType> mX;
+
+            /**
+             * @brief 向量类型不被 amgcl 直接识别时使用的右端项缓冲
+             */
+            std::vector<DataType> mB;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, AMGCLSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const AMGCLSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_AMGCL_SOLVER_HPP
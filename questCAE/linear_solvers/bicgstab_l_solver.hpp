@@ -0,0 +1,517 @@
+#ifndef QUEST_BICGSTAB_L_SOLVER_HPP
+#define QUEST_BICGSTAB_L_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/iterative_solver.hpp"
+#include "factories/preconditioner_factory.hpp"
+
+namespace Quest{
+
+    /**
+     * @brief BiCGStab(ℓ) 求解器，适用于非对称系统
+     * @details Sleijpen–Fokkema 的 BiCGStab(ℓ)：每个循环先做 ℓ 步 BiCG，得到 r̂_0 与 r̂_j = A^j*r̂_0（j = 1..ℓ），
+     *  再以 ℓ 次多项式使 ||r̂_0 - Σ γ_j*r̂_j|| 最小。ℓ = 1 即 BiCGStab；特征值带有较大虚部时
+     *  （如对流占优问题），BiCGStab 的一次稳定多项式容易停滞，ℓ = 2 或 4 通常更稳健。
+     *  最小残差步的 (ℓ+1)^2 个内积在一次按行分块的遍历中得到，只需一次归约；
+     *  随后 x、r̂_0、û_0 的更新与新残差范数的累加在同一次遍历中完成。
+     *  预处理方式与 CGSolver 相同（分裂预处理，预处理器作用于 A 的两侧），残差按预处理后的系统度量，
+     *  迭代次数按 BiCG 步计，每个循环计 ℓ 次
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType,
+             typename TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType>,
+             typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class BiCGStabLSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(BiCGStabLSolver);
+
+            using BaseType = IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            BiCGStabLSolver() {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BiCGStabLSolver(double NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BiCGStabLSolver(double NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+
+            /**
+             * @brief 构造函数
+             * @param NewPolynomialOrder 稳定多项式的次数 ℓ
+             */
+            BiCGStabLSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                unsigned int NewPolynomialOrder
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber)
+            {
+                SetPolynomialOrder(NewPolynomialOrder);
+            }
+
+
+            /**
+             * @brief 构造函数
+             */
+            BiCGStabLSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BiCGStabLSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                unsigned int NewPolynomialOrder,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner)
+            {
+                SetPolynomialOrder(NewPolynomialOrder);
+            }
+
+
+            /**
+             * @brief 构造函数
+             * @details 除基类的参数外还接受 "bicgstab_polynomial_order"，因此不经基类的参数构造函数校验
+             */
+            BiCGStabLSolver(
+                Parameters settings,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(){
+                AssignSettings(settings);
+                BaseType::SetPreconditioner(pNewPreconditioner);
+            }
+
+
+            /**
+             * @brief 构造函数
+             * @details 预处理器由 settings["preconditioner_type"] 经预处理器工厂创建
+             */
+            BiCGStabLSolver(Parameters settings) : BaseType(){
+                AssignSettings(settings);
+                BaseType::SetPreconditioner(PreconditionerFactory<TSparseSpaceType, TDenseSpaceType>::Create(settings["preconditioner_type"].GetString()));
+            }
+
+
+            /**
+             * @brief 复制构造函数
+             */
+            BiCGStabLSolver(const BiCGStabLSolver& Other) : BaseType(Other), mPolynomialOrder(Other.mPolynomialOrder) {}
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~BiCGStabLSolver() override {}
+
+
+            /**
+             * @brief 重载赋值运算符
+             */
+            BiCGStabLSolver& operator = (const BiCGStabLSolver& Other){
+                BaseType::operator=(Other);
+                mPolynomialOrder = Other.mPolynomialOrder;
+                return *this;
+            }
+
+
+            /**
+             * @brief 求解线性系统Ax=b，并将结果存储在系统向量 rX 中
+             * @param rA 系统矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB))
+                    return false;
+
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+                BaseType::GetPreconditioner()->ApplyInverseRight(rX);
+                BaseType::GetPreconditioner()->ApplyLeft(rB);
+
+                bool is_solved = IterativeSolve(rA, rX, rB);
+
+                QUEST_WARNING_IF("BiCGStab(l) Linear Solver", !is_solved)<<"Non converged linear solution. ["<< BaseType::GetResidualNorm()/BaseType::mBNorm << " > "<<  BaseType::GetTolerance() << "]" << std::endl;
+
+                BaseType::GetPreconditioner()->Finalize(rX);
+
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统的多重求解方法
+             * @param rA 系数矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+                bool is_solved = true;
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                for(unsigned int i = 0; i < TDenseSpaceType::Size2(rX); i++){
+                    TDenseSpaceType::GetColumn(i,rX,x);
+                    TDenseSpaceType::GetColumn(i,rB,b);
+
+                    BaseType::GetPreconditioner()->ApplyInverseRight(x);
+                    BaseType::GetPreconditioner()->ApplyLeft(b);
+
+                    is_solved &= IterativeSolve(rA, x, b);
+
+                    BaseType::GetPreconditioner()->Finalize(x);
+                    TDenseSpaceType::SetColumn(i,rX,x);
+                }
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 设置稳定多项式的次数 ℓ
+             */
+            void SetPolynomialOrder(const unsigned int NewPolynomialOrder){
+                QUEST_ERROR_IF(NewPolynomialOrder == 0) << "The polynomial order of BiCGStab(l) must be positive" << std::endl;
+                mPolynomialOrder = NewPolynomialOrder;
+            }
+
+
+            /**
+             * @brief 返回稳定多项式的次数 ℓ
+             */
+            unsigned int GetPolynomialOrder() const{
+                return mPolynomialOrder;
+            }
+
+
+            std::string Info() const override{
+                std::stringstream buffer;
+                buffer << "BiCGStab(" << mPolynomialOrder << ") linear solver with " << BaseType::GetPreconditioner()->Info();
+                return  buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                BaseType::PrintData(rOstream);
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 按默认参数校验 settings 并设置容许误差、最大迭代次数与多项式次数
+             */
+            void AssignSettings(Parameters& rSettings){
+                QUEST_TRY
+
+                Parameters default_parameters(
+                    R"({
+                        "solver_type": "bicgstab_l",
+                        "tolerance": 1e-6,
+                        "max_iteration":200,
+                        "preconditioner_type":"none",
+                        "scaling": false,
+                        "bicgstab_polynomial_order": 2
+                    })"
+                );
+
+                rSettings.ValidateAndAssignDefaults(default_parameters);
+
+                this->SetTolerance(rSettings["tolerance"].GetDouble());
+                this->SetMaxIterationsNumber(rSettings["max_iteration"].GetInt());
+                SetPolynomialOrder(rSettings["bicgstab_polynomial_order"].GetInt());
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 迭代求解线性系统Ax=b
+             * @details r[0..ℓ]、u[0..ℓ] 对应算法中的 r̂_j 与 û_j，r̃_0 取初始残差；
+             *  ρ 或 (û_{j+1}, r̃_0) 为零（BiCG 中断）、或 r̂_1..r̂_ℓ 数值线性相关时提前结束
+             */
+            bool IterativeSolve(SparseMatrixType& rA, VectorType& rX, VectorType& rB){
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                const std::size_t l = mPolynomialOrder;
+
+                BaseType::mIterationsNumber = 0;
+                BaseType::mBNorm = TSparseSpaceType::TwoNorm(rB);
+
+                std::vector<VectorType> r(l + 1, VectorType(size));
+                std::vector<VectorType> u(l + 1, VectorType(size));
+                VectorType r_shadow(size);
+
+                this->PreconditionedMult(rA, rX, r[0]);
+                TSparseSpaceType::ScaleAndAdd(1.0, rB, -1.0, r[0]);
+                TSparseSpaceType::Copy(r[0], r_shadow);
+                TSparseSpaceType::SetToZero(u[0]);
+
+                BaseType::mResidualNorm = TSparseSpaceType::TwoNorm(r[0]);
+
+                double rho_0 = 1.0;
+                double alpha = 0.0;
+                double omega = 1.0;
+
+                std::vector<double> gram((l+1) * (l+1), 0.0);
+                std::vector<double> gamma(l, 0.0);
+
+                while(BaseType::IterationNeeded()){
+                    rho_0 *= -omega;
+
+                    // BiCG 部分
+                    bool is_breakdown = false;
+                    for(std::size_t j=0; j<l; ++j){
+                        const double rho_1 = TSparseSpaceType::Dot(r[j], r_shadow);
+                        if(std::abs(rho_0) < 1.0e-300){
+                            is_breakdown = true;
+                            break;
+                        }
+                        const double beta = alpha * rho_1 / rho_0;
+                        rho_0 = rho_1;
+
+                        UpdateDirections(j, beta, r, u);
+                        this->PreconditionedMult(rA, u[j], u[j+1]);
+
+                        const double sigma = TSparseSpaceType::Dot(u[j+1], r_shadow);
+                        if(std::abs(sigma) < 1.0e-300){
+                            is_breakdown = true;
+                            break;
+                        }
+                        alpha = rho_0 / sigma;
+
+                        UpdateResiduals(j, alpha, u, r, rX);
+                        this->PreconditionedMult(rA, r[j], r[j+1]);
+                    }
+                    if(is_breakdown)
+                        break;
+
+                    // 最小残差部分：(R^T R)(1:ℓ,1:ℓ)*γ = (R^T R)(1:ℓ,0)
+                    GramMatrix(r, gram);
+                    if(!SolveMinimalResidual(gram, l, gamma))
+                        break;
+                    omega = gamma[l-1];
+
+                    const double norm_squared = ApplyPolynomial(gamma, r, u, rX);
+                    BaseType::mResidualNorm = std::sqrt(norm_squared);
+                    BaseType::mIterationsNumber += l;
+
+                    if(std::abs(omega) < 1.0e-300)
+                        break;
+                }
+
+                return BaseType::IsConverged();
+            }
+
+
+            /**
+             * @brief û_i = r̂_i - β*û_i（i = 0..J），一次遍历
+             */
+            static void UpdateDirections(const std::size_t J, const double Beta, const std::vector<VectorType>& rR, std::vector<VectorType>& rU){
+                const int size = static_cast<int>(rR[0].size());
+
+                #pragma omp parallel for firstprivate(size)
+                for(int k = 0; k < size; k++){
+                    for(std::size_t i=0; i<=J; ++i){
+                        rU[i][k] = rR[i][k] - Beta * rU[i][k];
+                    }
+                }
+            }
+
+
+            /**
+             * @brief r̂_i -= α*û_{i+1}（i = 0..J），x += α*û_0，一次遍历
+             */
+            static void UpdateResiduals(const std::size_t J, const double Alpha, const std::vector<VectorType>& rU, std::vector<VectorType>& rR, VectorType& rX){
+                const int size = static_cast<int>(rX.size());
+
+                #pragma omp parallel for firstprivate(size)
+                for(int k = 0; k < size; k++){
+                    for(std::size_t i=0; i<=J; ++i){
+                        rR[i][k] -= Alpha * rU[i+1][k];
+                    }
+                    rX[k] += Alpha * rU[0][k];
+                }
+            }
+
+
+            /**
+             * @brief 计算 r̂_0..r̂_ℓ 的 Gram 矩阵（行优先，(ℓ+1)x(ℓ+1)）
+             * @details 按 RowBlockSize 行分块，块内依次累加上三角的各个内积，全部内积共用一次归约
+             */
+            static void GramMatrix(const std::vector<VectorType>& rR, std::vector<double>& rGram){
+                const std::size_t count = rR.size();
+                const std::size_t size = rR[0].size();
+                const int num_blocks = static_cast<int>((size + RowBlockSize - 1) / RowBlockSize);
+
+                std::fill(rGram.begin(), rGram.end(), 0.0);
+
+                #pragma omp parallel
+                {
+                    std::vector<double> local(count * count, 0.0);
+
+                    #pragma omp for nowait
+                    for(int block = 0; block < num_blocks; ++block){
+                        const std::size_t begin = static_cast<std::size_t>(block) * RowBlockSize;
+                        const std::size_t end = std::min(begin + RowBlockSize, size);
+                        for(std::size_t a=0; a<count; ++a){
+                            const VectorType& r_a = rR[a];
+                            for(std::size_t b=a; b<count; ++b){
+                                const VectorType& r_b = rR[b];
+                                double sum = 0.0;
+                                for(std::size_t i=begin; i<end; ++i){
+                                    sum += r_a[i] * r_b[i];
+                                }
+                                local[a*count + b] += sum;
+                            }
+                        }
+                    }
+
+                    #pragma omp critical
+                    {
+                        for(std::size_t k=0; k<count*count; ++k){
+                            rGram[k] += local[k];
+                        }
+                    }
+                }
+
+                for(std::size_t a=0; a<count; ++a){
+                    for(std::size_t b=0; b<a; ++b){
+                        rGram[a*count + b] = rGram[b*count + a];
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 以 Cholesky 分解求解 ℓ 阶最小残差法方程，r̂_1..r̂_ℓ 数值线性相关时返回 false
+             */
+            static bool SolveMinimalResidual(const std::vector<double>& rGram, const std::size_t L, std::vector<double>& rGamma){
+                const std::size_t count = L + 1;
+
+                std::vector<double> factor(L * L, 0.0);
+                for(std::size_t j=0; j<L; ++j){
+                    double diagonal = rGram[(j+1)*count + (j+1)];
+                    for(std::size_t k=0; k<j; ++k){
+                        diagonal -= factor[j*L + k] * factor[j*L + k];
+                    }
+                    if(!(diagonal > 1.0e-14 * rGram[(j+1)*count + (j+1)])){
+                        return false;
+                    }
+                    factor[j*L + j] = std::sqrt(diagonal);
+                    for(std::size_t i=j+1; i<L; ++i){
+                        double sum = rGram[(i+1)*count + (j+1)];
+                        for(std::size_t k=0; k<j; ++k){
+                            sum -= factor[i*L + k] * factor[j*L + k];
+                        }
+                        factor[i*L + j] = sum / factor[j*L + j];
+                    }
+                }
+
+                for(std::size_t i=0; i<L; ++i){
+                    double sum = rGram[(i+1)*count];
+                    for(std::size_t k=0; k<i; ++k){
+                        sum -= factor[i*L + k] * rGamma[k];
+                    }
+                    rGamma[i] = sum / factor[i*L + i];
+                }
+                for(std::size_t i=L; i-->0;){
+                    double sum = rGamma[i];
+                    for(std::size_t k=i+1; k<L; ++k){
+                        sum -= factor[k*L + i] * rGamma[k];
+                    }
+                    rGamma[i] = sum / factor[i*L + i];
+                }
+
+                return true;
+            }
+
+
+            /**
+             * @brief x += Σ γ_j*r̂_{j-1}，r̂_0 -= Σ γ_j*r̂_j，û_0 -= Σ γ_j*û_j（j = 1..ℓ），一次遍历并返回新的 (r̂_0, r̂_0)
+             */
+            static double ApplyPolynomial(const std::vector<double>& rGamma, std::vector<VectorType>& rR, std::vector<VectorType>& rU, VectorType& rX){
+                const int size = static_cast<int>(rX.size());
+                const std::size_t l = rGamma.size();
+
+                double norm_squared = 0.0;
+                #pragma omp parallel for reduction(+:norm_squared), firstprivate(size)
+                for(int k = 0; k < size; k++){
+                    double x_k = rX[k];
+                    double r_k = rR[0][k];
+                    double u_k = rU[0][k];
+                    for(std::size_t j=1; j<=l; ++j){
+                        const double gamma_j = rGamma[j-1];
+                        x_k += gamma_j * rR[j-1][k];
+                        r_k -= gamma_j * rR[j][k];
+                        u_k -= gamma_j * rU[j][k];
+                    }
+                    rX[k] = x_k;
+                    rR[0][k] = r_k;
+                    rU[0][k] = u_k;
+                    norm_squared += r_k * r_k;
+                }
+
+                return norm_squared;
+            }
+
+        private:
+            /**
+             * @brief 分块内积中每块的行数
+             */
+            static constexpr std::size_t RowBlockSize = 256;
+
+            /**
+             * @brief 稳定多项式的次数 ℓ
+             */
+            unsigned int mPolynomialOrder = 2;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, BiCGStabLSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const BiCGStabLSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_BICGSTAB_L_SOLVER_HPP
@@ -0,0 +1,670 @@
+#ifndef QUEST_BLOCK_CG_SOLVER_HPP
+#define QUEST_BLOCK_CG_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/csr_multivector_kernels.hpp"
+#include "linear_solvers/iterative_solver.hpp"
+#include "factories/preconditioner_factory.hpp"
+
+namespace Quest{
+
+    /**
+     * @brief 多右端项的块共轭梯度法求解器
+     * @details 对同一系数矩阵的 m 个右端项同时迭代，采用无中断的块CG（breakdown-free block CG）：
+     *  搜索方向块 P 由当前残差块经 A 共轭修正后再做秩揭示的 Cholesky-QR 得到，线性相关的方向被舍去，
+     *  因此 P 的列数可以小于未收敛的右端项个数。每步的 A*P 由 SpMM 一次读取矩阵完成，块内积各只需一次归约。
+     *  每个右端项独立判断收敛（||r_j|| <= tol*||b_j||），收敛的列立即从块中移除（收缩），其解不再更新，
+     *  后续迭代只在剩余列上进行。移除列后新的搜索方向与更早的方向块不再严格 A 共轭，剩余列的迭代次数可能比不收缩时略多，
+     *  但每步的矩阵乘与向量遍历只作用于剩余列，总计算量通常更少。
+     *  预处理方式与 CGSolver 相同（分裂预处理），预处理器逐列作用。
+     *  迭代中用到的临时块向量保存为成员并重复使用，每次求解只在首次用到最大列数时分配
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType,
+             typename TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType>,
+             typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class BlockCGSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(BlockCGSolver);
+
+            using BaseType = IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+            using MultiVectorType = CsrMultiVectorKernels::MultiVectorType;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            BlockCGSolver() {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BlockCGSolver(double NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BlockCGSolver(double NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BlockCGSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            BlockCGSolver(
+                Parameters settings,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(settings, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             * @details 预处理器由 settings["preconditioner_type"] 经预处理器工厂创建
+             */
+            BlockCGSolver(Parameters settings) : BaseType(settings) {
+                if(settings.Has("preconditioner_type")){
+                    BaseType::SetPreconditioner(PreconditionerFactory<TSparseSpaceType, TDenseSpaceType>::Create(settings["preconditioner_type"].GetString()));
+                }
+            }
+
+
+            /**
+             * @brief 复制构造函数
+             */
+            BlockCGSolver(const BlockCGSolver& Other) : BaseType(Other) {}
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~BlockCGSolver() override {}
+
+
+            /**
+             * @brief 重载赋值运算符
+             */
+            BlockCGSolver& operator = (const BlockCGSolver& Other){
+                BaseType::operator=(Other);
+                return *this;
+            }
+
+
+            /**
+             * @brief 求解线性系统Ax=b，按单列块处理
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB))
+                    return false;
+
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                MultiVectorType x(size);
+                MultiVectorType b(size);
+                BaseType::GetPreconditioner()->ApplyInverseRight(rX);
+                BaseType::GetPreconditioner()->ApplyLeft(rB);
+                for(std::size_t i=0; i<size; ++i){
+                    x[i] = rX[i];
+                    b[i] = rB[i];
+                }
+
+                bool is_solved = BlockIterativeSolve(rA, x, b, 1);
+
+                for(std::size_t i=0; i<size; ++i){
+                    rX[i] = x[i];
+                }
+                BaseType::GetPreconditioner()->Finalize(rX);
+
+                QUEST_WARNING_IF("Block CG Linear Solver", !is_solved)<<"Non converged linear solution. ["<< BaseType::GetResidualNorm() << " > "<<  BaseType::GetTolerance() << "]" << std::endl;
+
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统，全部右端项同时迭代
+             * @param rA 系数矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+                const std::size_t size = TDenseSpaceType::Size1(rX);
+                const std::size_t num_rhs = TDenseSpaceType::Size2(rX);
+                MultiVectorType x(size * num_rhs);
+                MultiVectorType b(size * num_rhs);
+
+                VectorType x_column(size);
+                VectorType b_column(size);
+                for(std::size_t j=0; j<num_rhs; ++j){
+                    TDenseSpaceType::GetColumn(j, rX, x_column);
+                    TDenseSpaceType::GetColumn(j, rB, b_column);
+                    BaseType::GetPreconditioner()->ApplyInverseRight(x_column);
+                    BaseType::GetPreconditioner()->ApplyLeft(b_column);
+                    for(std::size_t i=0; i<size; ++i){
+                        x[i*num_rhs + j] = x_column[i];
+                        b[i*num_rhs + j] = b_column[i];
+                    }
+                }
+
+                bool is_solved = BlockIterativeSolve(rA, x, b, num_rhs);
+
+                for(std::size_t j=0; j<num_rhs; ++j){
+                    for(std::size_t i=0; i<size; ++i){
+                        x_column[i] = x[i*num_rhs + j];
+                    }
+                    BaseType::GetPreconditioner()->Finalize(x_column);
+                    TDenseSpaceType::SetColumn(j, rX, x_column);
+                }
+
+                QUEST_WARNING_IF("Block CG Linear Solver", !is_solved)<<"Non converged linear solution. ["<< BaseType::GetResidualNorm() << " > "<<  BaseType::GetTolerance() << "]" << std::endl;
+
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 返回各右端项收敛时的迭代次数（未收敛的为总迭代次数）
+             */
+            const std::vector<std::size_t>& GetColumnIterationsNumber() const{
+                return mColumnIterations;
+            }
+
+
+            /**
+             * @brief 返回各右端项最终的相对残差 ||r_j||/||b_j||
+             */
+            const std::vector<double>& GetColumnResidualNorms() const{
+                return mColumnResidualNorms;
+            }
+
+
+            std::string Info() const override{
+                std::stringstream buffer;
+                buffer << "Block conjugate gradient linear solver with " << BaseType::GetPreconditioner()->Info();
+                return  buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                BaseType::PrintData(rOstream);
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 块迭代求解
+             * @details X、R 只保存未收敛的列（行优先，列数 a），rColumnIndices 记录其原列号。每步：
+             *  Q = A*P；α = (PT*Q)^(-1)*(PT*R)；X += P*α，R -= Q*α（同一次遍历中累加各列残差范数）；
+             *  移除收敛列；β = -(PT*Q)^(-1)*(QT*R)，其中 QT*R 由 QT*R_old - (QT*Q)*α 得到，无需再次遍历；
+             *  P = orth(R + P*β)
+             * @param rX 解（行优先，NumRHS 列），输入为初值
+             * @param rB 右端项（行优先，NumRHS 列）
+             */
+            bool BlockIterativeSolve(SparseMatrixType& rA, MultiVectorType& rX, const MultiVectorType& rB, const std::size_t NumRHS){
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                const double tolerance = BaseType::GetTolerance();
+
+                BaseType::mIterationsNumber = 0;
+                mColumnIterations.assign(NumRHS, 0);
+                mColumnResidualNorms.assign(NumRHS, 0.0);
+
+                // R = B - A*X
+                MultiVectorType residual;
+                ApplyOperator(rA, rX, NumRHS, residual);
+                IndexPartition<std::size_t>(size*NumRHS).for_each([&](std::size_t k){
+                    residual[k] = rB[k] - residual[k];
+                });
+
+                std::vector<double> b_norms(NumRHS, 0.0);
+                std::vector<double> r_norms(NumRHS, 0.0);
+                ColumnNorms(size, rB, NumRHS, b_norms);
+                ColumnNorms(size, residual, NumRHS, r_norms);
+
+                std::vector<std::size_t> active;
+                for(std::size_t j=0; j<NumRHS; ++j){
+                    mColumnResidualNorms[j] = RelativeNorm(r_norms[j], b_norms[j]);
+                    if(r_norms[j] > tolerance * b_norms[j]){
+                        active.push_back(j);
+                    }
+                }
+
+                MultiVectorType x_active;
+                MultiVectorType r_active;
+                Gather(size, rX, NumRHS, active, x_active);
+                Gather(size, residual, NumRHS, active, r_active);
+                MultiVectorType().swap(residual);
+
+                MultiVectorType p_block;
+                std::size_t p_width = Orthonormalize(size, r_active, active.size(), p_block);
+
+                MultiVectorType q_block;
+                std::vector<double> ptq, ptr, qtq, qtr, alpha, beta;
+                while(!active.empty() && p_width > 0 && BaseType::mIterationsNumber < BaseType::GetMaxIterationsNumber()){
+                    std::size_t width = active.size();
+
+                    ApplyOperator(rA, p_block, p_width, q_block);
+                    CsrMultiVectorKernels::BlockDot(size, p_block, p_width, q_block, p_width, ptq);
+                    CsrMultiVectorKernels::BlockDot(size, p_block, p_width, r_active, width, ptr);
+                    CsrMultiVectorKernels::BlockDot(size, q_block, p_width, q_block, p_width, qtq);
+                    CsrMultiVectorKernels::BlockDot(size, q_block, p_width, r_active, width, qtr);
+
+                    if(!CholeskyFactorize(ptq, p_width)){
+                        break;
+                    }
+                    alpha = ptr;
+                    CholeskySolve(ptq, p_width, alpha, width);
+
+                    UpdateSolution(size, p_block, q_block, p_width, alpha, x_active, r_active, width, r_norms);
+                    BaseType::mIterationsNumber++;
+
+                    // QT*R_new = QT*R_old - (QT*Q)*α
+                    for(std::size_t a=0; a<p_width; ++a){
+                        for(std::size_t c=0; c<width; ++c){
+                            double sum = 0.0;
+                            for(std::size_t l=0; l<p_width; ++l){
+                                sum += qtq[a*p_width + l] * alpha[l*width + c];
+                            }
+                            qtr[a*width + c] -= sum;
+                        }
+                    }
+
+                    // 移除收敛的列
+                    std::vector<std::size_t> keep;
+                    for(std::size_t c=0; c<width; ++c){
+                        const std::size_t j = active[c];
+                        mColumnResidualNorms[j] = RelativeNorm(r_norms[c], b_norms[j]);
+                        mColumnIterations[j] = BaseType::mIterationsNumber;
+                        if(r_norms[c] > tolerance * b_norms[j]){
+                            keep.push_back(c);
+                        } else {
+                            Scatter(size, x_active, width, c, rX, NumRHS, j);
+                        }
+                    }
+                    if(keep.size() != width){
+                        std::vector<std::size_t> new_active;
+                        for(const std::size_t c : keep){
+                            new_active.push_back(active[c]);
+                        }
+                        Gather(size, x_active, width, keep, mGatherBuffer);
+                        x_active.swap(mGatherBuffer);
+                        Gather(size, r_active, width, keep, mGatherBuffer);
+                        r_active.swap(mGatherBuffer);
+                        std::vector<double> qtr_kept(p_width * keep.size());
+                        for(std::size_t a=0; a<p_width; ++a){
+                            for(std::size_t c=0; c<keep.size(); ++c){
+                                qtr_kept[a*keep.size() + c] = qtr[a*width + keep[c]];
+                            }
+                        }
+                        qtr.swap(qtr_kept);
+                        active.swap(new_active);
+                        width = active.size();
+                    }
+                    if(active.empty()){
+                        break;
+                    }
+
+                    // W = R + P*β，β = -(PT*Q)^(-1)*(QT*R)
+                    beta = qtr;
+                    CholeskySolve(ptq, p_width, beta, width);
+                    MultiVectorType& r_w_block = mDirectionBuffer;
+                    CsrMultiVectorKernels::MultiplySmall(size, p_block, p_width, beta, width, r_w_block);
+                    IndexPartition<std::size_t>(size*width).for_each([&](std::size_t k){
+                        r_w_block[k] = r_active[k] - r_w_block[k];
+                    });
+                    p_width = Orthonormalize(size, r_w_block, width, p_block);
+                }
+
+                for(std::size_t c=0; c<active.size(); ++c){
+                    Scatter(size, x_active, active.size(), c, rX, NumRHS, active[c]);
+                }
+
+                BaseType::mBNorm = 1.0;
+                BaseType::mResidualNorm = 0.0;
+                for(std::size_t j=0; j<NumRHS; ++j){
+                    BaseType::mResidualNorm = std::max(BaseType::mResidualNorm, mColumnResidualNorms[j]);
+                }
+
+                return active.empty();
+            }
+
+            /**
+             * @brief 计算预处理后的块乘积 rY = S_L*A*S_R*rX
+             * @details 右预处理逐列作用后以 SpMM 一次读取矩阵完成全部列的乘法，再逐列作用左预处理
+             */
+            void ApplyOperator(SparseMatrixType& rA, const MultiVectorType& rX, const std::size_t Width, MultiVectorType& rY){
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                auto p_preconditioner = BaseType::GetPreconditioner();
+
+                MultiVectorType& r_x = mOperatorBuffer;
+                r_x.assign(rX.begin(), rX.begin() + size*Width);
+                VectorType& column = mColumnBuffer;
+                if(column.size() != size){
+                    column.resize(size, false);
+                }
+                for(std::size_t c=0; c<Width; ++c){
+                    for(std::size_t i=0; i<size; ++i){
+                        column[i] = r_x[i*Width + c];
+                    }
+                    p_preconditioner->ApplyRight(column);
+                    for(std::size_t i=0; i<size; ++i){
+                        r_x[i*Width + c] = column[i];
+                    }
+                }
+
+                CsrMultiVectorKernels::SpMM(rA, r_x, rY, Width);
+
+                for(std::size_t c=0; c<Width; ++c){
+                    for(std::size_t i=0; i<size; ++i){
+                        column[i] = rY[i*Width + c];
+                    }
+                    p_preconditioner->ApplyLeft(column);
+                    for(std::size_t i=0; i<size; ++i){
+                        rY[i*Width + c] = column[i];
+                    }
+                }
+            }
+
+            /**
+             * @brief X += P*α，R -= Q*α，并在同一次遍历中计算 R 各列的范数
+             */
+            static void UpdateSolution(
+                const std::size_t Size,
+                const MultiVectorType& rP,
+                const MultiVectorType& rQ,
+                const std::size_t PWidth,
+                const std::vector<double>& rAlpha,
+                MultiVectorType& rX,
+                MultiVectorType& rR,
+                const std::size_t Width,
+                std::vector<double>& rNorms
+            ){
+                rNorms.assign(Width, 0.0);
+                const int size = static_cast<int>(Size);
+
+                #pragma omp parallel
+                {
+                    std::vector<double> local(Width, 0.0);
+
+                    #pragma omp for nowait
+                    for(int i = 0; i < size; ++i){
+                        const double* p_p = rP.data() + static_cast<std::size_t>(i)*PWidth;
+                        const double* p_q = rQ.data() + static_cast<std::size_t>(i)*PWidth;
+                        double* p_x = rX.data() + static_cast<std::size_t>(i)*Width;
+                        double* p_r = rR.data() + static_cast<std::size_t>(i)*Width;
+                        for(std::size_t l=0; l<PWidth; ++l){
+                            const double* p_alpha = rAlpha.data() + l*Width;
+                            for(std::size_t c=0; c<Width; ++c){
+                                p_x[c] += p_p[l] * p_alpha[c];
+                                p_r[c] -= p_q[l] * p_alpha[c];
+                            }
+                        }
+                        for(std::size_t c=0; c<Width; ++c){
+                            local[c] += p_r[c] * p_r[c];
+                        }
+                    }
+
+                    #pragma omp critical
+                    {
+                        for(std::size_t c=0; c<Width; ++c){
+                            rNorms[c] += local[c];
+                        }
+                    }
+                }
+
+                for(std::size_t c=0; c<Width; ++c){
+                    rNorms[c] = std::sqrt(rNorms[c]);
+                }
+            }
+
+            /**
+             * @brief 秩揭示的 Cholesky-QR，返回 P 的列数
+             * @details Gram 矩阵的条件数是 W 的平方，一次 Cholesky-QR 得到的 P 只是近似正交，因此对结果再做一次（CholQR2）
+             */
+            std::size_t Orthonormalize(const std::size_t Size, const MultiVectorType& rW, const std::size_t Width, MultiVectorType& rP){
+                const std::size_t rank = CholeskyQR(Size, rW, Width, mOrthonormalizeBuffer);
+                if(rank == 0){
+                    rP.clear();
+                    return 0;
+                }
+                return CholeskyQR(Size, mOrthonormalizeBuffer, rank, rP);
+            }
+
+            /**
+             * @brief 由 W 的 Gram 矩阵逐列做 Cholesky 分解，相对自身范数几乎线性相关的列被舍去，返回 P = W_kept*T^(-1) 的列数
+             */
+            static std::size_t CholeskyQR(const std::size_t Size, const MultiVectorType& rW, const std::size_t Width, MultiVectorType& rP){
+                std::vector<double> gram;
+                CsrMultiVectorKernels::BlockDot(Size, rW, Width, rW, Width, gram);
+
+                // factor 的第 t 行对应第 t 个保留列，factor[t][j] 为 T 在原第 j 列上的分量
+                std::vector<std::size_t> kept;
+                std::vector<double> factor;
+                for(std::size_t j=0; j<Width; ++j){
+                    double diagonal = gram[j*Width + j];
+                    for(std::size_t t=0; t<kept.size(); ++t){
+                        diagonal -= factor[t*Width + j] * factor[t*Width + j];
+                    }
+                    if(!(diagonal > DependencyTolerance * gram[j*Width + j]) || gram[j*Width + j] <= 0.0){
+                        continue;
+                    }
+                    const double t_jj = std::sqrt(diagonal);
+                    const std::size_t t = kept.size();
+                    factor.resize((t+1)*Width, 0.0);
+                    factor[t*Width + j] = t_jj;
+                    for(std::size_t l=j+1; l<Width; ++l){
+                        double sum = gram[j*Width + l];
+                        for(std::size_t s=0; s<t; ++s){
+                            sum -= factor[s*Width + j] * factor[s*Width + l];
+                        }
+                        factor[t*Width + l] = sum / t_jj;
+                    }
+                    kept.push_back(j);
+                }
+
+                const std::size_t rank = kept.size();
+                if(rank == 0){
+                    rP.clear();
+                    return 0;
+                }
+
+                // C = E_kept*T^(-1)，E_kept 选出保留列，T 为保留列上的上三角因子
+                std::vector<double> inverse(rank*rank, 0.0);
+                for(std::size_t c=0; c<rank; ++c){
+                    inverse[c*rank + c] = 1.0 / factor[c*Width + kept[c]];
+                    for(std::size_t r=c; r-->0;){
+                        double sum = 0.0;
+                        for(std::size_t s=r+1; s<=c; ++s){
+                            sum += factor[r*Width + kept[s]] * inverse[s*rank + c];
+                        }
+                        inverse[r*rank + c] = -sum / factor[r*Width + kept[r]];
+                    }
+                }
+                std::vector<double> coefficients(Width*rank, 0.0);
+                for(std::size_t r=0; r<rank; ++r){
+                    for(std::size_t c=0; c<rank; ++c){
+                        coefficients[kept[r]*rank + c] = inverse[r*rank + c];
+                    }
+                }
+                CsrMultiVectorKernels::MultiplySmall(Size, rW, Width, coefficients, rank, rP);
+                return rank;
+            }
+
+            /**
+             * @brief 对称正定小矩阵的 Cholesky 分解（原位，下三角），不正定时返回 false
+             */
+            static bool CholeskyFactorize(std::vector<double>& rMatrix, const std::size_t Size){
+                for(std::size_t j=0; j<Size; ++j){
+                    double diagonal = rMatrix[j*Size + j];
+                    for(std::size_t k=0; k<j; ++k){
+                        diagonal -= rMatrix[j*Size + k] * rMatrix[j*Size + k];
+                    }
+                    if(!(diagonal > 0.0)){
+                        return false;
+                    }
+                    const double l_jj = std::sqrt(diagonal);
+                    rMatrix[j*Size + j] = l_jj;
+                    for(std::size_t i=j+1; i<Size; ++i){
+                        double sum = 0.5 * (rMatrix[i*Size + j] + rMatrix[j*Size + i]);
+                        for(std::size_t k=0; k<j; ++k){
+                            sum -= rMatrix[i*Size + k] * rMatrix[j*Size + k];
+                        }
+                        rMatrix[i*Size + j] = sum / l_jj;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief 由 Cholesky 因子求解 L*LT*Y = rRhs（Size 行 Width 列，行优先），结果写回 rRhs
+             */
+            static void CholeskySolve(const std::vector<double>& rFactor, const std::size_t Size, std::vector<double>& rRhs, const std::size_t Width){
+                for(std::size_t c=0; c<Width; ++c){
+                    for(std::size_t i=0; i<Size; ++i){
+                        double sum = rRhs[i*Width + c];
+                        for(std::size_t k=0; k<i; ++k){
+                            sum -= rFactor[i*Size + k] * rRhs[k*Width + c];
+                        }
+                        rRhs[i*Width + c] = sum / rFactor[i*Size + i];
+                    }
+                    for(std::size_t i=Size; i-->0;){
+                        double sum = rRhs[i*Width + c];
+                        for(std::size_t k=i+1; k<Size; ++k){
+                            sum -= rFactor[k*Size + i] * rRhs[k*Width + c];
+                        }
+                        rRhs[i*Width + c] = sum / rFactor[i*Size + i];
+                    }
+                }
+            }
+
+            /**
+             * @brief 计算块向量各列的2范数
+             */
+            static void ColumnNorms(const std::size_t Size, const MultiVectorType& rX, const std::size_t Width, std::vector<double>& rNorms){
+                std::vector<double> gram;
+                CsrMultiVectorKernels::BlockDot(Size, rX, Width, rX, Width, gram);
+                rNorms.resize(Width);
+                for(std::size_t c=0; c<Width; ++c){
+                    rNorms[c] = std::sqrt(gram[c*Width + c]);
+                }
+            }
+
+            /**
+             * @brief 取出块向量中 rColumns 指定的列
+             */
+            static void Gather(const std::size_t Size, const MultiVectorType& rSource, const std::size_t SourceWidth, const std::vector<std::size_t>& rColumns, MultiVectorType& rDestination){
+                const std::size_t width = rColumns.size();
+                rDestination.resize(Size * width);
+                IndexPartition<std::size_t>(Size).for_each([&](std::size_t i){
+                    for(std::size_t c=0; c<width; ++c){
+                        rDestination[i*width + c] = rSource[i*SourceWidth + rColumns[c]];
+                    }
+                });
+            }
+
+            /**
+             * @brief 把 rSource 的第 SourceColumn 列写入 rDestination 的第 DestinationColumn 列
+             */
+            static void Scatter(const std::size_t Size, const MultiVectorType& rSource, const std::size_t SourceWidth, const std::size_t SourceColumn,
+                MultiVectorType& rDestination, const std::size_t DestinationWidth, const std::size_t DestinationColumn){
+                IndexPartition<std::size_t>(Size).for_each([&](std::size_t i){
+                    rDestination[i*DestinationWidth + DestinationColumn] = rSource[i*SourceWidth + SourceColumn];
+                });
+            }
+
+            /**
+             * @brief 相对残差，右端项为零时返回残差本身
+             */
+            static double RelativeNorm(const double ResidualNorm, const double BNorm){
+                return BNorm > 0.0 ? ResidualNorm / BNorm : ResidualNorm;
+            }
+
+        private:
+            /**
+             * @brief 正交化时判定列线性相关的相对阈值（作用于范数平方，即投影后剩余范数小于原范数的 1e-6 倍时舍去）
+             */
+            static constexpr double DependencyTolerance = 1.0e-12;
+
+            /**
+             * @brief 各右端项收敛时的迭代次数
+             */
+            std::vector<std::size_t> mColumnIterations;
+
+            /**
+             * @brief 各右端项最终的相对残差
+             */
+            std::vector<double> mColumnResidualNorms;
+
+            /**
+             * @brief ApplyOperator 中右预处理后的块向量
+             */
+            MultiVectorType mOperatorBuffer;
+
+            /**
+             * @brief 预处理器逐列作用时的列向量
+             */
+            VectorType mColumnBuffer;
+
+            /**
+             * @brief 移除收敛列时的目标块向量，与被压缩的块交换存储
+             */
+            MultiVectorType mGatherBuffer;
+
+            /**
+             * @brief 正交化前的搜索方向块 W = R + P*β
+             */
+            MultiVectorType mDirectionBuffer;
+
+            /**
+             * @brief CholQR2 第一遍的结果
+             */
+            MultiVectorType mOrthonormalizeBuffer;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, BlockCGSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const BlockCGSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_BLOCK_CG_SOLVER_HPP
@@ -0,0 +1,496 @@
+#ifndef QUEST_GMRES_SOLVER_HPP
+#define QUEST_GMRES_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/iterative_solver.hpp"
+#include "factories/preconditioner_factory.hpp"
+
+namespace Quest{
+
+    /**
+     * @brief 重启型广义最小残差法（GMRES(m)）求解器，适用于非对称系统
+     * @details 每个循环在 m 维Krylov子空间上以 Arnoldi 过程构造正交基，Hessenberg 矩阵由 Givens 旋转逐列化为上三角，
+     *  残差范数在旋转后直接得到，无需额外计算；循环结束（或收敛）时求解上三角系统更新解，并以真实残差重启。
+     *  正交化采用两遍经典 Gram-Schmidt（CGS2）：每一遍把新向量对全部基向量的内积放在同一次遍历中按行分块累加，
+     *  一遍只需一次归约，而修正 Gram-Schmidt 需要逐个基向量归约；两遍之后正交性与修正 Gram-Schmidt 相当。
+     *  第二遍的投影扣除与第三次遍历的扣除同各自的内积（范数）累加融合，每步共三次遍历。
+     *  预处理方式与 CGSolver 相同（分裂预处理，预处理器作用于 A 的两侧），残差按预处理后的系统度量
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType,
+             typename TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType>,
+             typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class GMRESSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(GMRESSolver);
+
+            using BaseType = IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            GMRESSolver() {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            GMRESSolver(double NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            GMRESSolver(double NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+
+            /**
+             * @brief 构造函数
+             * @param NewKrylovSpaceDimension 重启前Krylov子空间的维数 m
+             */
+            GMRESSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                unsigned int NewKrylovSpaceDimension
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber),
+                mKrylovSpaceDimension(NewKrylovSpaceDimension)
+            {
+                QUEST_ERROR_IF(mKrylovSpaceDimension == 0) << "The Krylov space dimension of GMRES must be positive" << std::endl;
+            }
+
+
+            /**
+             * @brief 构造函数
+             */
+            GMRESSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            GMRESSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                unsigned int NewKrylovSpaceDimension,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner),
+                mKrylovSpaceDimension(NewKrylovSpaceDimension)
+            {
+                QUEST_ERROR_IF(mKrylovSpaceDimension == 0) << "The Krylov space dimension of GMRES must be positive" << std::endl;
+            }
+
+
+            /**
+             * @brief 构造函数
+             * @details 除基类的参数外还接受 "gmres_krylov_space_dimension"，因此不经基类的参数构造函数校验
+             */
+            GMRESSolver(
+                Parameters settings,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(){
+                AssignSettings(settings);
+                BaseType::SetPreconditioner(pNewPreconditioner);
+            }
+
+
+            /**
+             * @brief 构造函数
+             * @details 预处理器由 settings["preconditioner_type"] 经预处理器工厂创建
+             */
+            GMRESSolver(Parameters settings) : BaseType(){
+                AssignSettings(settings);
+                BaseType::SetPreconditioner(PreconditionerFactory<TSparseSpaceType, TDenseSpaceType>::Create(settings["preconditioner_type"].GetString()));
+            }
+
+
+            /**
+             * @brief 复制构造函数
+             */
+            GMRESSolver(const GMRESSolver& Other) : BaseType(Other), mKrylovSpaceDimension(Other.mKrylovSpaceDimension) {}
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~GMRESSolver() override {}
+
+
+            /**
+             * @brief 重载赋值运算符
+             */
+            GMRESSolver& operator = (const GMRESSolver& Other){
+                BaseType::operator=(Other);
+                mKrylovSpaceDimension = Other.mKrylovSpaceDimension;
+                return *this;
+            }
+
+
+            /**
+             * @brief 求解线性系统Ax=b，并将结果存储在系统向量 rX 中
+             * @param rA 系统矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB))
+                    return false;
+
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+                BaseType::GetPreconditioner()->ApplyInverseRight(rX);
+                BaseType::GetPreconditioner()->ApplyLeft(rB);
+
+                bool is_solved = IterativeSolve(rA, rX, rB);
+
+                QUEST_WARNING_IF("GMRES Linear Solver", !is_solved)<<"Non converged linear solution. ["<< BaseType::GetResidualNorm()/BaseType::mBNorm << " > "<<  BaseType::GetTolerance() << "]" << std::endl;
+
+                BaseType::GetPreconditioner()->Finalize(rX);
+
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统的多重求解方法
+             * @param rA 系数矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+                bool is_solved = true;
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                for(unsigned int i = 0; i < TDenseSpaceType::Size2(rX); i++){
+                    TDenseSpaceType::GetColumn(i,rX,x);
+                    TDenseSpaceType::GetColumn(i,rB,b);
+
+                    BaseType::GetPreconditioner()->ApplyInverseRight(x);
+                    BaseType::GetPreconditioner()->ApplyLeft(b);
+
+                    is_solved &= IterativeSolve(rA, x, b);
+
+                    BaseType::GetPreconditioner()->Finalize(x);
+                    TDenseSpaceType::SetColumn(i,rX,x);
+                }
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 设置重启前Krylov子空间的维数
+             */
+            void SetKrylovSpaceDimension(const unsigned int NewKrylovSpaceDimension){
+                QUEST_ERROR_IF(NewKrylovSpaceDimension == 0) << "The Krylov space dimension of GMRES must be positive" << std::endl;
+                mKrylovSpaceDimension = NewKrylovSpaceDimension;
+            }
+
+
+            /**
+             * @brief 返回重启前Krylov子空间的维数
+             */
+            unsigned int GetKrylovSpaceDimension() const{
+                return mKrylovSpaceDimension;
+            }
+
+
+            std::string Info() const override{
+                std::stringstream buffer;
+                buffer << "GMRES(" << mKrylovSpaceDimension << ") linear solver with " << BaseType::GetPreconditioner()->Info();
+                return  buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                BaseType::PrintData(rOstream);
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 按默认参数校验 settings 并设置容许误差、最大迭代次数与子空间维数
+             */
+            void AssignSettings(Parameters& rSettings){
+                QUEST_TRY
+
+                Parameters default_parameters(
+                    R"({
+                        "solver_type": "gmres",
+                        "tolerance": 1e-6,
+                        "max_iteration":200,
+                        "preconditioner_type":"none",
+                        "scaling": false,
+                        "gmres_krylov_space_dimension": 50
+                    })"
+                );
+
+                rSettings.ValidateAndAssignDefaults(default_parameters);
+
+                this->SetTolerance(rSettings["tolerance"].GetDouble());
+                this->SetMaxIterationsNumber(rSettings["max_iteration"].GetInt());
+                SetKrylovSpaceDimension(rSettings["gmres_krylov_space_dimension"].GetInt());
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 迭代求解线性系统Ax=b
+             * @details 外层每次以真实残差 r = b - A*x 重启，内层至多 m 步 Arnoldi；
+             *  H 的第 k 列存于 hessenberg[k*(m+1), (k+1)*(m+1))，g 为旋转后的右端项，|g_{k+1}| 即当前残差范数
+             */
+            bool IterativeSolve(SparseMatrixType& rA, VectorType& rX, VectorType& rB){
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                const std::size_t m = mKrylovSpaceDimension;
+
+                BaseType::mIterationsNumber = 0;
+                BaseType::mBNorm = TSparseSpaceType::TwoNorm(rB);
+
+                std::vector<VectorType> basis(m + 1, VectorType(size));
+                VectorType w(size);
+
+                std::vector<double> hessenberg(m * (m+1), 0.0);
+                std::vector<double> cosines(m, 0.0);
+                std::vector<double> sines(m, 0.0);
+                std::vector<double> g(m + 1, 0.0);
+                std::vector<double> y(m, 0.0);
+                std::vector<double> first_dots(m + 1, 0.0);
+                std::vector<double> second_dots(m + 1, 0.0);
+
+                while(true){
+                    this->PreconditionedMult(rA, rX, w);
+                    const double beta = ResidualAndNorm(rB, w, basis[0]);
+                    BaseType::mResidualNorm = beta;
+
+                    if(!BaseType::IterationNeeded() || beta < 1.0e-30)
+                        break;
+
+                    TSparseSpaceType::Assign(basis[0], 1.0/beta, basis[0]);
+                    std::fill(g.begin(), g.end(), 0.0);
+                    g[0] = beta;
+
+                    std::size_t k = 0;
+                    while(k < m && BaseType::IterationNeeded()){
+                        this->PreconditionedMult(rA, basis[k], w);
+
+                        double* p_column = hessenberg.data() + k*(m+1);
+                        const double h_next = OrthogonalizeCGS2(basis, k+1, w, first_dots, second_dots);
+                        for(std::size_t i=0; i<=k; ++i){
+                            p_column[i] = first_dots[i] + second_dots[i];
+                        }
+                        p_column[k+1] = h_next;
+
+                        // 以已有的 Givens 旋转作用于新列，再构造消去 H(k+1,k) 的旋转
+                        for(std::size_t i=0; i<k; ++i){
+                            const double temp = cosines[i]*p_column[i] + sines[i]*p_column[i+1];
+                            p_column[i+1] = -sines[i]*p_column[i] + cosines[i]*p_column[i+1];
+                            p_column[i] = temp;
+                        }
+                        const double denominator = std::hypot(p_column[k], p_column[k+1]);
+                        if(denominator < 1.0e-300){
+                            break;
+                        }
+                        cosines[k] = p_column[k] / denominator;
+                        sines[k] = p_column[k+1] / denominator;
+                        p_column[k] = denominator;
+                        p_column[k+1] = 0.0;
+                        g[k+1] = -sines[k]*g[k];
+                        g[k] = cosines[k]*g[k];
+
+                        BaseType::mResidualNorm = std::abs(g[k+1]);
+                        BaseType::mIterationsNumber++;
+                        ++k;
+
+                        // 幸运中断：Krylov子空间已不变，当前子空间上的解即精确解
+                        if(h_next <= 1.0e-14 * denominator){
+                            break;
+                        }
+                        TSparseSpaceType::Assign(basis[k], 1.0/h_next, w);
+                    }
+
+                    if(k == 0)
+                        break;
+
+                    // 回代求解 H(0:k,0:k)*y = g(0:k)，再以 x += V*y 一次遍历更新解
+                    for(std::size_t i=k; i-->0;){
+                        double sum = g[i];
+                        for(std::size_t j=i+1; j<k; ++j){
+                            sum -= hessenberg[j*(m+1) + i] * y[j];
+                        }
+                        y[i] = sum / hessenberg[i*(m+1) + i];
+                    }
+                    CombineAndProject(basis, k, 1.0, y.data(), rX, nullptr);
+
+                    if(BaseType::mIterationsNumber >= BaseType::GetMaxIterationsNumber()){
+                        this->PreconditionedMult(rA, rX, w);
+                        BaseType::mResidualNorm = ResidualAndNorm(rB, w, basis[0]);
+                        break;
+                    }
+                }
+
+                return BaseType::IsConverged();
+            }
+
+
+            /**
+             * @brief 以 CGS2 将 rW 对前 Count 个基向量正交化，返回正交化后 rW 的范数
+             * @param rFirstDots 第一遍的投影系数
+             * @param rSecondDots 第二遍的投影系数，两者之和为 Hessenberg 矩阵的该列
+             */
+            static double OrthogonalizeCGS2(
+                const std::vector<VectorType>& rBasis,
+                const std::size_t Count,
+                VectorType& rW,
+                std::vector<double>& rFirstDots,
+                std::vector<double>& rSecondDots
+            ){
+                CombineAndProject(rBasis, Count, 0.0, nullptr, rW, rFirstDots.data());
+                CombineAndProject(rBasis, Count, -1.0, rFirstDots.data(), rW, rSecondDots.data());
+                const double norm_squared = CombineAndProject(rBasis, Count, -1.0, rSecondDots.data(), rW, nullptr);
+
+                return std::sqrt(norm_squared);
+            }
+
+
+            /**
+             * @brief 一次遍历中完成 rW += Scale*Σ c_j*v_j（pCoefficients 为空时跳过），
+             *  并在 pDots 非空时累加 d_j = (v_j, rW)，返回 (rW, rW)
+             * @details 按 RowBlockSize 行分块：块内先完成 rW 的更新，再依次与各基向量的同一块求内积，
+             *  rW 的块常驻一级缓存，各基向量每遍只读取一次；全部内积共用一次归约
+             */
+            static double CombineAndProject(
+                const std::vector<VectorType>& rBasis,
+                const std::size_t Count,
+                const double Scale,
+                const double* pCoefficients,
+                VectorType& rW,
+                double* pDots
+            ){
+                const std::size_t size = rW.size();
+                const int num_blocks = static_cast<int>((size + RowBlockSize - 1) / RowBlockSize);
+
+                std::vector<double> dots(Count, 0.0);
+                double norm_squared = 0.0;
+
+                #pragma omp parallel
+                {
+                    std::vector<double> local_dots(Count, 0.0);
+                    double local_norm = 0.0;
+
+                    #pragma omp for nowait
+                    for(int block = 0; block < num_blocks; ++block){
+                        const std::size_t begin = static_cast<std::size_t>(block) * RowBlockSize;
+                        const std::size_t end = std::min(begin + RowBlockSize, size);
+
+                        if(pCoefficients != nullptr){
+                            for(std::size_t j=0; j<Count; ++j){
+                                const double c_j = Scale * pCoefficients[j];
+                                const VectorType& r_v = rBasis[j];
+                                for(std::size_t i=begin; i<end; ++i){
+                                    rW[i] += c_j * r_v[i];
+                                }
+                            }
+                        }
+
+                        if(pDots != nullptr){
+                            for(std::size_t j=0; j<Count; ++j){
+                                const VectorType& r_v = rBasis[j];
+                                double sum = 0.0;
+                                for(std::size_t i=begin; i<end; ++i){
+                                    sum += r_v[i] * rW[i];
+                                }
+                                local_dots[j] += sum;
+                            }
+                        }
+
+                        for(std::size_t i=begin; i<end; ++i){
+                            local_norm += rW[i] * rW[i];
+                        }
+                    }
+
+                    #pragma omp critical
+                    {
+                        for(std::size_t j=0; j<Count; ++j){
+                            dots[j] += local_dots[j];
+                        }
+                        norm_squared += local_norm;
+                    }
+                }
+
+                if(pDots != nullptr){
+                    std::copy(dots.begin(), dots.end(), pDots);
+                }
+                return norm_squared;
+            }
+
+
+            /**
+             * @brief rR = rB - rAx，并在同一次遍历中返回 ||rR||
+             */
+            static double ResidualAndNorm(const VectorType& rB, const VectorType& rAx, VectorType& rR){
+                const int size = static_cast<int>(rB.size());
+
+                double norm_squared = 0.0;
+                #pragma omp parallel for reduction(+:norm_squared), firstprivate(size)
+                for(int i = 0; i < size; i++){
+                    const double r_i = rB[i] - rAx[i];
+                    rR[i] = r_i;
+                    norm_squared += r_i * r_i;
+                }
+
+                return std::sqrt(norm_squared);
+            }
+
+        private:
+            /**
+             * @brief 分块内积中每块的行数（一块 rW 为 2KB，与各基向量的对应块一同留在一级缓存中）
+             */
+            static constexpr std::size_t RowBlockSize = 256;
+
+            /**
+             * @brief 重启前Krylov子空间的维数 m
+             */
+            unsigned int mKrylovSpaceDimension = 50;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, GMRESSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const GMRESSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_GMRES_SOLVER_HPP
@@ -185,6 +185,16 @@ namespace Quest{
             ){}
 
 
+            /**
+             * @brief 检查系数矩阵不变时能否沿用已有的分解
+             * @details 返回 true 的求解器在一次 InitializeSolutionStep 之后可以多次调用 PerformSolutionStep 求解不同的右端项，
+             *  构建器在左端矩阵未重新组装时据此跳过分解，只执行回代
+             */
+            virtual bool FactorizationIsReusable(){
+                return false;
+            }
+
+
             /**
              * @brief 获取重排序器
              */
@@ -0,0 +1,552 @@
+#ifndef QUEST_MIXED_PRECISION_REFINEMENT_SOLVER_HPP
+#define QUEST_MIXED_PRECISION_REFINEMENT_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <limits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/quest_parameters.hpp"
+#include "factories/linear_solver_factory.hpp"
+#include "linear_solvers/direct_solver.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class MixedPrecisionRefinementSolver
+     * @brief 低精度分解加双精度迭代修正的直接求解器
+     * @details 把系数矩阵转换为低精度（默认单精度）副本，交给低精度空间中注册的直接求解器分解，
+     *  分解的存储与计算量都约为双精度的一半。求解时以该分解做经典迭代修正：
+     *  d = A_f⁻¹ r（低精度），x += d，r = b - A x（双精度矩阵向量乘），直到 ||r|| <= tol*||b||。
+     *  右端在转换前按 ||r|| 归一化，避免残差很小时在低精度下下溢。
+     *  收敛速度约为 κ(A)*u_f，因此分解后用三次低精度回代的反幂迭代估计 κ ≈ ||A||∞ * ||A⁻¹||，
+     *  估计值超过 SetMaxConditionNumber 的阈值，或修正过程中残差下降不足一半、达到最大修正次数仍未收敛时，
+     *  改用双精度空间中同名的直接求解器完整分解，并在下一次 InitializeSolutionStep 前一直使用该分解
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     * @tparam TLowSparseSpaceType 低精度稀疏空间类型
+     * @tparam TLowDenseSpaceType 低精度稠密空间类型
+     * @tparam TReordererType 重排器类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType,
+             typename TLowSparseSpaceType = TUblasSparseSpace<float>,
+             typename TLowDenseSpaceType = TUblasDenseSpace<float>,
+             typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class MixedPrecisionRefinementSolver : public DirectSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(MixedPrecisionRefinementSolver);
+
+            using BaseType = DirectSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>;
+            using LinearSolverType = LinearSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>;
+            using LowSolverType = LinearSolver<TLowSparseSpaceType, TLowDenseSpaceType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+            using LowMatrixType = typename TLowSparseSpaceType::MatrixType;
+            using LowVectorType = typename TLowSparseSpaceType::VectorType;
+            using LowDataType = typename TLowSparseSpaceType::DataType;
+            using IndexType = typename BaseType::IndexType;
+
+        public:
+            /**
+             * @brief 构造函数
+             * @param pLowPrecisionSolver 低精度直接求解器
+             * @param pFallbackSolver 双精度直接求解器，条件数过大或修正不收敛时使用
+             * @param Tolerance 相对残差容差
+             * @param MaxIterations 最大修正次数
+             * @param MaxConditionNumber 使用低精度分解的最大条件数估计值
+             */
+            MixedPrecisionRefinementSolver(
+                typename LowSolverType::Pointer pLowPrecisionSolver,
+                typename LinearSolverType::Pointer pFallbackSolver,
+                const double Tolerance = 1e-12,
+                const unsigned int MaxIterations = 10,
+                const double MaxConditionNumber = 1e6
+            ) : BaseType(),
+                mpLowPrecisionSolver(pLowPrecisionSolver),
+                mpFallbackSolver(pFallbackSolver),
+                mTolerance(Tolerance),
+                mMaxIterations(MaxIterations),
+                mMaxConditionNumber(MaxConditionNumber)
+            {}
+
+
+            /**
+             * @brief 构造函数
+             * @details "inner_solver_settings" 给出内层直接求解器，分别由低精度与双精度求解器工厂创建（双精度求解器在需要时才创建）
+             */
+            MixedPrecisionRefinementSolver(Parameters settings) : BaseType(){
+                QUEST_TRY
+
+                Parameters default_parameters(
+                    R"({
+                        "solver_type": "mixed_precision_refinement",
+                        "inner_solver_settings": {
+                            "solver_type": "supernodal_cholesky"
+                        },
+                        "tolerance": 1e-12,
+                        "max_iteration": 10,
+                        "max_condition_number": 1e6,
+                        "scaling": false
+                    })"
+                );
+
+                settings.ValidateAndAssignDefaults(default_parameters);
+
+                mTolerance = settings["tolerance"].GetDouble();
+                mMaxIterations = settings["max_iteration"].GetInt();
+                mMaxConditionNumber = settings["max_condition_number"].GetDouble();
+                mInnerSettings = settings["inner_solver_settings"].Clone();
+                mpLowPrecisionSolver = LinearSolverFactory<TLowSparseSpaceType, TLowDenseSpaceType>().Create(mInnerSettings.Clone());
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~MixedPrecisionRefinementSolver() override{}
+
+
+            /**
+             * @brief 转换低精度矩阵并分解，估计条件数，过大时改用双精度分解
+             */
+            void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                mUseFallback = false;
+                mLowRhs.resize(size, false);
+                mLowSolution.resize(size, false);
+                mResidual.resize(size, false);
+
+                ConvertMatrix(rA);
+                mpLowPrecisionSolver->InitializeSolutionStep(mLowMatrix, mLowSolution, mLowRhs);
+
+                mConditionEstimate = EstimateConditionNumber(rA);
+                if(!(mConditionEstimate <= mMaxConditionNumber)){
+                    SwitchToFallback(rA, rX, rB);
+                }
+            }
+
+
+            /**
+             * @brief 以已有的分解迭代修正求解
+             */
+            void PerformSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                mIterationsNumber = 0;
+                if(mUseFallback){
+                    SolveWithFallback(rA, rX, rB);
+                    return;
+                }
+
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                const double b_norm = TSparseSpaceType::TwoNorm(rB);
+                TSparseSpaceType::SetToZero(rX);
+                mIsConverged = (b_norm == 0.0);
+                if(mIsConverged){
+                    mResidualNorm = 0.0;
+                    return;
+                }
+
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    mResidual[i] = rB[i];
+                });
+                double residual_norm = b_norm;
+                while(mIterationsNumber < mMaxIterations){
+                    // d = ||r|| * A_f⁻¹(r/||r||)，x += d
+                    const double inverse_norm = 1.0 / residual_norm;
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        mLowRhs[i] = static_cast<LowDataType>(mResidual[i] * inverse_norm);
+                    });
+                    mpLowPrecisionSolver->PerformSolutionStep(mLowMatrix, mLowSolution, mLowRhs);
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        rX[i] += residual_norm * static_cast<double>(mLowSolution[i]);
+                    });
+                    ++mIterationsNumber;
+
+                    // r = b - A x
+                    TSparseSpaceType::Mult(rA, rX, mResidual);
+                    const double new_norm = std::sqrt(IndexPartition<std::size_t>(size).template for_each<Internals::SumReduction<double>>([&](std::size_t i){
+                        const double r = rB[i] - mResidual[i];
+                        mResidual[i] = r;
+                        return r * r;
+                    }));
+
+                    mResidualNorm = new_norm / b_norm;
+                    if(new_norm <= mTolerance * b_norm){
+                        mIsConverged = true;
+                        return;
+                    }
+                    if(!(new_norm < 0.5 * residual_norm)){
+                        break;
+                    }
+                    residual_norm = new_norm;
+                }
+
+                // 修正停滞或次数用尽：改用双精度分解
+                SwitchToFallback(rA, rX, rB);
+                SolveWithFallback(rA, rX, rB);
+            }
+
+
+            /**
+             * @brief 结束求解步，保留分解以便重复求解
+             */
+            void FinalizeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(mUseFallback){
+                    mpFallbackSolver->FinalizeSolutionStep(rA, rX, rB);
+                } else {
+                    mpLowPrecisionSolver->FinalizeSolutionStep(mLowMatrix, mLowSolution, mLowRhs);
+                }
+            }
+
+
+            /**
+             * @brief 低精度分解（或回退的双精度分解）在 PerformSolutionStep 之间保留时可以沿用，二者使用相同的内层设置
+             */
+            bool FactorizationIsReusable() override{
+                return mpLowPrecisionSolver->FactorizationIsReusable();
+            }
+
+
+            /**
+             * @brief 求解
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                InitializeSolutionStep(rA, rX, rB);
+                PerformSolutionStep(rA, rX, rB);
+                FinalizeSolutionStep(rA, rX, rB);
+
+                return mIsConverged;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统，只分解一次
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                InitializeSolutionStep(rA, x, b);
+
+                bool is_solved = true;
+                for(unsigned int i = 0; i < TDenseSpaceType::Size2(rX); i++){
+                    TDenseSpaceType::GetColumn(i,rB,b);
+                    PerformSolutionStep(rA, x, b);
+                    is_solved &= mIsConverged;
+                    TDenseSpaceType::SetColumn(i,rX,x);
+                }
+                FinalizeSolutionStep(rA, x, b);
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 清空低精度矩阵与两个内层求解器的分解
+             */
+            void Clear() override{
+                mpLowPrecisionSolver->Clear();
+                if(mpFallbackSolver != nullptr){
+                    mpFallbackSolver->Clear();
+                }
+                mLowMatrix = LowMatrixType();
+                mUseFallback = false;
+                mConditionEstimate = 0.0;
+            }
+
+
+            /**
+             * @brief 设置相对残差容差
+             */
+            void SetTolerance(double NewTolerance) override{
+                mTolerance = NewTolerance;
+            }
+
+
+            /**
+             * @brief 返回相对残差容差
+             */
+            double GetTolerance() override{
+                return mTolerance;
+            }
+
+
+            /**
+             * @brief 返回上一次求解的修正次数（使用双精度分解时为 0）
+             */
+            IndexType GetIterationsNumber() override{
+                return mIterationsNumber;
+            }
+
+
+            /**
+             * @brief 返回上一次求解的相对残差
+             */
+            double GetResidualNorm() const{
+                return mResidualNorm;
+            }
+
+
+            /**
+             * @brief 设置使用低精度分解的最大条件数估计值
+             */
+            void SetMaxConditionNumber(const double MaxConditionNumber){
+                mMaxConditionNumber = MaxConditionNumber;
+            }
+
+
+            /**
+             * @brief 返回使用低精度分解的最大条件数估计值
+             */
+            double GetMaxConditionNumber() const{
+                return mMaxConditionNumber;
+            }
+
+
+            /**
+             * @brief 返回最近一次分解的条件数估计值
+             */
+            double GetConditionEstimate() const{
+                return mConditionEstimate;
+            }
+
+
+            /**
+             * @brief 当前是否使用双精度分解
+             */
+            bool IsUsingFallback() const{
+                return mUseFallback;
+            }
+
+
+            std::string Info() const override{
+                return "Mixed precision iterative refinement solver";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "tolerance : " << mTolerance << " max iterations : " << mMaxIterations
+                         << " condition estimate : " << mConditionEstimate << " (max " << mMaxConditionNumber << ")"
+                         << (mUseFallback ? ", using the double precision factorization" : "") << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 把 rA 复制为低精度矩阵：稀疏模式照搬，数值按元素转换
+             */
+            void ConvertMatrix(const SparseMatrixType& rA){
+                const std::size_t size1 = rA.size1();
+                const std::size_t size2 = rA.size2();
+                const std::size_t nnz = rA.index1_data()[size1];
+
+                if(mLowMatrix.size1() != size1 || mLowMatrix.size2() != size2 || mLowMatrix.nnz_capacity() < nnz){
+                    mLowMatrix = LowMatrixType(size1, size2, nnz);
+                }
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+                auto& r_low_row_indices = mLowMatrix.index1_data();
+                auto& r_low_col_indices = mLowMatrix.index2_data();
+                auto& r_low_values = mLowMatrix.value_data();
+
+                IndexPartition<std::size_t>(size1 + 1).for_each([&](std::size_t i){
+                    r_low_row_indices[i] = r_row_indices[i];
+                });
+                IndexPartition<std::size_t>(nnz).for_each([&](std::size_t k){
+                    r_low_col_indices[k] = r_col_indices[k];
+                    r_low_values[k] = static_cast<LowDataType>(r_values[k]);
+                });
+                mLowMatrix.set_filled(size1 + 1, nnz);
+            }
+
+
+            /**
+             * @brief 估计 κ(A) ≈ ||A||∞ * ||A⁻¹||
+             * @details ||A⁻¹|| 由低精度分解上的三步反幂迭代估计（下界），分解不可用（出现非有限值）时返回无穷大
+             */
+            double EstimateConditionNumber(const SparseMatrixType& rA){
+                const std::size_t size = rA.size1();
+                if(size == 0){
+                    return 1.0;
+                }
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_values = rA.value_data();
+                const double norm_a = IndexPartition<std::size_t>(size).template for_each<Internals::MaxReduction<double>>([&](std::size_t i){
+                    double row_sum = 0.0;
+                    for(std::size_t k=r_row_indices[i]; k<static_cast<std::size_t>(r_row_indices[i+1]); ++k){
+                        row_sum += std::abs(r_values[k]);
+                    }
+                    return row_sum;
+                });
+
+                // z 先存放在 mResidual 中，初值为确定性的正向量
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    mResidual[i] = 1.0 + 0.5 * std::sin(static_cast<double>(i) * 0.7548776662466927);
+                });
+                double z_norm = TSparseSpaceType::TwoNorm(mResidual);
+                double norm_inverse = 0.0;
+                for(unsigned int iteration = 0; iteration < 3; ++iteration){
+                    const double inverse_norm = 1.0 / z_norm;
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        mLowRhs[i] = static_cast<LowDataType>(mResidual[i] * inverse_norm);
+                    });
+                    mpLowPrecisionSolver->PerformSolutionStep(mLowMatrix, mLowSolution, mLowRhs);
+                    const double w_norm = std::sqrt(IndexPartition<std::size_t>(size).template for_each<Internals::SumReduction<double>>([&](std::size_t i){
+                        const double w = static_cast<double>(mLowSolution[i]);
+                        mResidual[i] = w;
+                        return w * w;
+                    }));
+                    if(!std::isfinite(w_norm) || w_norm == 0.0){
+                        return std::numeric_limits<double>::infinity();
+                    }
+                    norm_inverse = w_norm;
+                    z_norm = w_norm;
+                }
+                return norm_a * norm_inverse;
+            }
+
+
+            /**
+             * @brief 改用双精度直接求解器分解 rA
+             */
+            void SwitchToFallback(SparseMatrixType& rA, VectorType& rX, VectorType& rB){
+                if(mpFallbackSolver == nullptr){
+                    mpFallbackSolver = LinearSolverFactory<TSparseSpaceType, TDenseSpaceType>().Create(mInnerSettings.Clone());
+                }
+                mpFallbackSolver->InitializeSolutionStep(rA, rX, rB);
+                mpLowPrecisionSolver->Clear();
+                mUseFallback = true;
+            }
+
+
+            /**
+             * @brief 以双精度分解求解，修正次数记为 0，并按 b - A x 的真实残差判断是否收敛
+             */
+            void SolveWithFallback(SparseMatrixType& rA, VectorType& rX, VectorType& rB){
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+                mpFallbackSolver->PerformSolutionStep(rA, rX, rB);
+                mIterationsNumber = 0;
+
+                const double b_norm = TSparseSpaceType::TwoNorm(rB);
+                TSparseSpaceType::Mult(rA, rX, mResidual);
+                const double residual_norm = std::sqrt(IndexPartition<std::size_t>(size).template for_each<Internals::SumReduction<double>>([&](std::size_t i){
+                    const double r = rB[i] - mResidual[i];
+                    mResidual[i] = r;
+                    return r * r;
+                }));
+
+                mResidualNorm = (b_norm == 0.0) ? residual_norm : residual_norm / b_norm;
+                mIsConverged = (residual_norm <= mTolerance * b_norm);
+            }
+
+        private:
+            /**
+             * @brief 低精度直接求解器
+             */
+            typename LowSolverType::Pointer mpLowPrecisionSolver;
+
+            /**
+             * @brief 双精度直接求解器
+             */
+            typename LinearSolverType::Pointer mpFallbackSolver = nullptr;
+
+            /**
+             * @brief 内层直接求解器参数，创建双精度求解器时使用
+             */
+            Parameters mInnerSettings;
+
+            /**
+             * @brief 低精度矩阵
+             */
+            LowMatrixType mLowMatrix;
+
+            /**
+             * @brief 低精度右端
+             */
+            LowVectorType mLowRhs;
+
+            /**
+             * @brief 低精度修正量
+             */
+            LowVectorType mLowSolution;
+
+            /**
+             * @brief 双精度残差
+             */
+            VectorType mResidual;
+
+            /**
+             * @brief 相对残差容差
+             */
+            double mTolerance = 1e-12;
+
+            /**
+             * @brief 最大修正次数
+             */
+            unsigned int mMaxIterations = 10;
+
+            /**
+             * @brief 使用低精度分解的最大条件数估计值
+             */
+            double mMaxConditionNumber = 1e6;
+
+            /**
+             * @brief 最近一次分解的条件数估计值
+             */
+            double mConditionEstimate = 0.0;
+
+            /**
+             * @brief 上一次求解的修正次数
+             */
+            unsigned int mIterationsNumber = 0;
+
+            /**
+             * @brief 上一次求解的相对残差
+             */
+            double mResidualNorm = 0.0;
+
+            /**
+             * @brief 上一次求解是否收敛
+             */
+            bool mIsConverged = false;
+
+            /**
+             * @brief 是否使用双精度分解
+             */
+            bool mUseFallback = false;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TLowSparseSpaceType, typename TLowDenseSpaceType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, MixedPrecisionRefinementSolver<TSparseSpaceType, TDenseSpaceType, TLowSparseSpaceType, TLowDenseSpaceType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TLowSparseSpaceType, typename TLowDenseSpaceType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const MixedPrecisionRefinementSolver<TSparseSpaceType, TDenseSpaceType, TLowSparseSpaceType, TLowDenseSpaceType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_MIXED_PRECISION_REFINEMENT_SOLVER_HPP
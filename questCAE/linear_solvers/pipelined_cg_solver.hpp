@@ -0,0 +1,308 @@
+#ifndef QUEST_PIPELINED_CG_SOLVER_HPP
+#define QUEST_PIPELINED_CG_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <cmath>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/iterative_solver.hpp"
+#include "factories/preconditioner_factory.hpp"
+
+namespace Quest{
+
+    /**
+     * @brief 流水线共轭梯度法求解器
+     * @details 采用 Ghysels–Vanroose 的流水线CG递推：除 x、r、p 外另以递推维护 w = A*r、s = A*p、z = A*s，
+     *  每步只需一次矩阵向量乘 q = A*w，随后在同一次遍历中更新 z、s、p、x、r、w，并同时累加下一步所需的 (r,r) 与 (w,r)。
+     *  与标准CG相比，每步的向量遍历由五次减少为一次，全局归约（同步点）由两次减少为一次，适合每线程问题规模较小、
+     *  同步开销占主导的情形；以后扩展到多进程时，该归约也可与矩阵向量乘重叠。
+     *  代价是多存储三个向量，且递推残差与真实残差之间的偏差比标准CG略大。
+     *  预处理方式与 CGSolver 相同（分裂预处理，预处理器作用于 A 的两侧）
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType,
+             typename TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType>,
+             typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class PipelinedCGSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(PipelinedCGSolver);
+
+            using BaseType = IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            PipelinedCGSolver() {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            PipelinedCGSolver(double NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            PipelinedCGSolver(double NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            PipelinedCGSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            PipelinedCGSolver(
+                Parameters settings,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(settings, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             * @details 预处理器由 settings["preconditioner_type"] 经预处理器工厂创建
+             */
+            PipelinedCGSolver(Parameters settings) : BaseType(settings) {
+                if(settings.Has("preconditioner_type")){
+                    BaseType::SetPreconditioner(PreconditionerFactory<TSparseSpaceType, TDenseSpaceType>::Create(settings["preconditioner_type"].GetString()));
+                }
+            }
+
+
+            /**
+             * @brief 复制构造函数
+             */
+            PipelinedCGSolver(const PipelinedCGSolver& Other) : BaseType(Other) {}
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~PipelinedCGSolver() override {}
+
+
+            /**
+             * @brief 重载赋值运算符
+             */
+            PipelinedCGSolver& operator = (const PipelinedCGSolver& Other){
+                BaseType::operator=(Other);
+                return *this;
+            }
+
+
+            /**
+             * @brief 求解线性系统Ax=b，并将结果存储在系统向量 rX 中
+             * @param rA 系统矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB))
+                    return false;
+
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+                BaseType::GetPreconditioner()->ApplyInverseRight(rX);
+                BaseType::GetPreconditioner()->ApplyLeft(rB);
+
+                bool is_solved = IterativeSolve(rA, rX, rB);
+
+                QUEST_WARNING_IF("Pipelined CG Linear Solver", !is_solved)<<"Non converged linear solution. ["<< BaseType::GetResidualNorm()/BaseType::mBNorm << " > "<<  BaseType::GetTolerance() << "]" << std::endl;
+
+                BaseType::GetPreconditioner()->Finalize(rX);
+
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统的多重求解方法
+             * @param rA 系数矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+                bool is_solved = true;
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                for(unsigned int i = 0; i < TDenseSpaceType::Size2(rX); i++){
+                    TDenseSpaceType::GetColumn(i,rX,x);
+                    TDenseSpaceType::GetColumn(i,rB,b);
+
+                    BaseType::GetPreconditioner()->ApplyInverseRight(x);
+                    BaseType::GetPreconditioner()->ApplyLeft(b);
+
+                    is_solved &= IterativeSolve(rA, x, b);
+
+                    BaseType::GetPreconditioner()->Finalize(x);
+                    TDenseSpaceType::SetColumn(i,rX,x);
+                }
+                return is_solved;
+            }
+
+
+            std::string Info() const override{
+                std::stringstream buffer;
+                buffer << "Pipelined conjugate gradient linear solver with " << BaseType::GetPreconditioner()->Info();
+                return  buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                BaseType::PrintData(rOstream);
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 迭代求解线性系统Ax=b
+             * @details 第 i 步：q = A*w；由上一步归约得到的 γ = (r,r)、δ = (w,r) 计算
+             *  β = γ/γ_old，α = γ/(δ - β*γ/α_old)（首步 β = 0，α = γ/δ），随后调用 FusedUpdate
+             */
+            bool IterativeSolve(SparseMatrixType& rA, VectorType& rX, VectorType& rB){
+                const int size = TSparseSpaceType::Size1(rA);
+
+                BaseType::mIterationsNumber = 0;
+
+                VectorType r(size);
+                VectorType w(size);
+                VectorType q(size);
+                VectorType p(size);
+                VectorType s(size);
+                VectorType z(size);
+
+                this->PreconditionedMult(rA, rX, r);
+                TSparseSpaceType::ScaleAndAdd(1.0, rB, -1.0, r);
+                this->PreconditionedMult(rA, r, w);
+
+                BaseType::mBNorm = TSparseSpaceType::TwoNorm(rB);
+
+                TSparseSpaceType::SetToZero(p);
+                TSparseSpaceType::SetToZero(s);
+                TSparseSpaceType::SetToZero(z);
+
+                double gamma = TSparseSpaceType::Dot(r, r);
+                double delta = TSparseSpaceType::Dot(w, r);
+                double gamma_old = gamma;
+                double alpha = 0.0;
+
+                BaseType::mResidualNorm = std::sqrt(std::abs(gamma));
+
+                if(std::abs(gamma) < 1.0e-30)
+                    return BaseType::IsConverged();
+
+                while(BaseType::IterationNeeded()){
+                    this->PreconditionedMult(rA, w, q);
+
+                    double beta = 0.0;
+                    double denominator = delta;
+                    if(BaseType::mIterationsNumber > 0){
+                        beta = gamma / gamma_old;
+                        denominator = delta - beta * gamma / alpha;
+                    }
+
+                    if(std::abs(denominator) < 1.0e-30)
+                        break;
+
+                    alpha = gamma / denominator;
+                    gamma_old = gamma;
+
+                    FusedUpdate(alpha, beta, rX, r, w, q, p, s, z, gamma, delta);
+
+                    BaseType::mResidualNorm = std::sqrt(std::abs(gamma));
+                    BaseType::mIterationsNumber++;
+
+                    if(std::abs(gamma) < 1.0e-30)
+                        break;
+                }
+
+                return BaseType::IsConverged();
+            }
+
+            /**
+             * @brief 单次遍历完成全部向量更新与内积累加
+             * @details z = q + β*z，s = w + β*s，p = r + β*p，x += α*p，r -= α*s，w -= α*z，
+             *  同时累加 rGamma = (r,r) 与 rDelta = (w,r)（使用更新后的 r、w），两个内积共用一次归约
+             */
+            static void FusedUpdate(
+                const double Alpha,
+                const double Beta,
+                VectorType& rX,
+                VectorType& rR,
+                VectorType& rW,
+                const VectorType& rQ,
+                VectorType& rP,
+                VectorType& rS,
+                VectorType& rZ,
+                double& rGamma,
+                double& rDelta
+            ){
+                const int size = static_cast<int>(rX.size());
+
+                double gamma = 0.0;
+                double delta = 0.0;
+                #pragma omp parallel for reduction(+:gamma, delta), firstprivate(size)
+                for(int i = 0; i < size; i++){
+                    const double z_i = rQ[i] + Beta * rZ[i];
+                    const double s_i = rW[i] + Beta * rS[i];
+                    const double p_i = rR[i] + Beta * rP[i];
+                    const double r_i = rR[i] - Alpha * s_i;
+                    const double w_i = rW[i] - Alpha * z_i;
+                    rZ[i] = z_i;
+                    rS[i] = s_i;
+                    rP[i] = p_i;
+                    rX[i] += Alpha * p_i;
+                    rR[i] = r_i;
+                    rW[i] = w_i;
+                    gamma += r_i * r_i;
+                    delta += w_i * r_i;
+                }
+
+                rGamma = gamma;
+                rDelta = delta;
+            }
+
+        private:
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, PipelinedCGSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const PipelinedCGSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_PIPELINED_CG_SOLVER_HPP
@@ -0,0 +1,566 @@
+#ifndef QUEST_CHEBYSHEV_PRECONDITIONER_HPP
+#define QUEST_CHEBYSHEV_PRECONDITIONER_HPP
+
+// 系统头文件
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/preconditioner/preconditioner.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ChebyshevPreconditioner
+     * @brief Chebyshev 加速的 Jacobi 多项式预处理器
+     * @details 适用于对称正定矩阵。记 D 为 A 的对角阵，S = D^(-1/2)，As = S*A*S，
+     *  p(t) 为区间 [λmin, λmax] 上逼近 1/t 的 m 次 Chebyshev 多项式（1 - t*p(t) = T_m((θ-t)/δ)/T_m(θ/δ)，θ、δ 为区间中点与半宽）。
+     *  迭代求解器在缩放变量 x' = D^(1/2)*x 上作用于 p(As)*As：右预处理为 S，左预处理为 p(As)*S，
+     *  p(As)*As 与 As 可交换，因此对称，且在 (0, λmax] 上 t*p(t) ∈ (0, 2)，保持正定，可直接用于 CG。
+     *  特征值界在 Initialize 中由缩放矩阵上的若干步 Lanczos 迭代估计：λmax 取最大 Ritz 值的 1.1 倍与 Gershgorin 上界中的较小者，
+     *  λmin 取最小 Ritz 值（SetEigenvalueRatio 给定比值 r 时取 λmax/r，作光滑器用）。
+     *  多项式按三项递推求值，每一次递推是一遍按行的遍历：缩放矩阵向量乘、残差与方向更新及结果累加合并进行，
+     *  除矩阵向量乘外没有全局归约或同步点，估计特征值界时的内积只在 Initialize 中出现。
+     *  m = 0 时退化为对称 Jacobi 预处理（再乘以 1/θ）
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    class ChebyshevPreconditioner : public Preconditioner<TSparseSpaceType, TDenseSpaceType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(ChebyshevPreconditioner);
+
+            using BaseType = Preconditioner<TSparseSpaceType, TDenseSpaceType>;
+            using SparseMatrixType = typename BaseType::SparseMatrixType;
+            using VectorType = typename BaseType::VectorType;
+            using DenseMatrixType = typename BaseType::DenseMatrixType;
+
+            /**
+             * @brief 默认多项式次数
+             */
+            static constexpr unsigned int DefaultDegree = 3;
+
+            /**
+             * @brief 默认 Lanczos 迭代步数
+             */
+            static constexpr unsigned int DefaultEigenvalueIterations = 10;
+
+        public:
+            /**
+             * @brief 构造函数
+             * @param Degree 多项式次数 m（每次作用 m 次矩阵向量乘）
+             * @param EigenvalueIterations 估计特征值界的 Lanczos 步数
+             */
+            explicit ChebyshevPreconditioner(
+                const unsigned int Degree = DefaultDegree,
+                const unsigned int EigenvalueIterations = DefaultEigenvalueIterations
+            ):
+                mDegree(Degree),
+                mEigenvalueIterations(EigenvalueIterations)
+            {}
+
+            /**
+             * @brief 复制构造函数
+             * @details 特征值界与缩放因子不复制，在下一次 Initialize 时重新计算
+             */
+            ChebyshevPreconditioner(const ChebyshevPreconditioner& rOther):
+                BaseType(rOther),
+                mDegree(rOther.mDegree),
+                mEigenvalueIterations(rOther.mEigenvalueIterations),
+                mEigenvalueRatio(rOther.mEigenvalueRatio)
+            {}
+
+            /**
+             * @brief 析构函数
+             */
+            ~ChebyshevPreconditioner() override {}
+
+            /**
+             * @brief 赋值运算符
+             */
+            ChebyshevPreconditioner& operator = (const ChebyshevPreconditioner& rOther){
+                BaseType::operator=(rOther);
+                mDegree = rOther.mDegree;
+                mEigenvalueIterations = rOther.mEigenvalueIterations;
+                mEigenvalueRatio = rOther.mEigenvalueRatio;
+                Clear();
+                return *this;
+            }
+
+            /**
+             * @brief 为线性系统 rA*rX = rB 初始化预处理器
+             * @details 计算对称 Jacobi 缩放并用 Lanczos 迭代估计 As 的特征值界，每个矩阵只做一次
+             */
+            void Initialize(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                const std::size_t size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+
+                mScaling.resize(size);
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    double diag_Aii = 0.0;
+                    for(std::size_t k=r_row_indices[i]; k<static_cast<std::size_t>(r_row_indices[i+1]); ++k){
+                        if(static_cast<std::size_t>(r_col_indices[k]) == i){
+                            diag_Aii = r_values[k];
+                            break;
+                        }
+                    }
+                    QUEST_ERROR_IF(diag_Aii == 0.0) << "zero found in the diagonal at row " << i << ". Chebyshev preconditioner can not be used" << std::endl;
+                    mScaling[i] = 1.0/std::sqrt(std::abs(diag_Aii));
+                });
+
+                mResidual.resize(size);
+                mDirection.resize(size);
+                mScaledDirection.resize(size);
+                mNextScaledDirection.resize(size);
+
+                EstimateEigenvalueBounds(rA);
+            }
+
+
+            void Initialize(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::Initialize(rA, rX, rB);
+            }
+
+
+            /**
+             * @brief 计算 rY = p(As)*As*rX，即预处理后的矩阵向量乘
+             * @details 重载基类以避免复制临时向量：S*rX 与 As 的乘积在同一遍内完成并直接作为多项式求值的初始残差
+             */
+            void Mult(SparseMatrixType& rA, VectorType& rX, VectorType& rY) override{
+                mpMatrix = &rA;
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    mNextScaledDirection[i] = mScaling[i] * rX[i];
+                });
+                ScaledProduct(rA, mNextScaledDirection, mResidual);
+                ApplyPolynomial(rA, rY);
+            }
+
+
+            /**
+             * @brief 对向量进行左预处理 p(As)*S
+             */
+            VectorType& ApplyLeft(VectorType& rX) override{
+                QUEST_ERROR_IF(!mpMatrix) << "Chebyshev preconditioner is not initialized" << std::endl;
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    mResidual[i] = mScaling[i] * rX[i];
+                });
+                ApplyPolynomial(*mpMatrix, rX);
+                return rX;
+            }
+
+
+            /**
+             * @brief 对向量进行右预处理 S
+             */
+            VectorType& ApplyRight(VectorType& rX) override{
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    rX[i] *= mScaling[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 转置预处理系统的左预处理，即右预处理的转置 S
+             */
+            VectorType& ApplyTransposeLeft(VectorType& rX) override{
+                return ApplyRight(rX);
+            }
+
+
+            /**
+             * @brief 转置预处理系统的右预处理，即左预处理的转置 S*p(As)：先求多项式，再缩放
+             */
+            VectorType& ApplyTransposeRight(VectorType& rX) override{
+                QUEST_ERROR_IF(!mpMatrix) << "Chebyshev preconditioner is not initialized" << std::endl;
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    mResidual[i] = rX[i];
+                });
+                ApplyPolynomial(*mpMatrix, rX);
+                return ApplyRight(rX);
+            }
+
+
+            /**
+             * @brief 右侧逆操作预处理 D^(1/2)
+             */
+            VectorType& ApplyInverseRight(VectorType& rX) override{
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    rX[i] /= mScaling[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 清除缩放因子、特征值界与工作向量
+             */
+            void Clear() override{
+                mpMatrix = nullptr;
+                mLowerBound = 0.0;
+                mUpperBound = 1.0;
+                std::vector<double>().swap(mScaling);
+                std::vector<double>().swap(mResidual);
+                std::vector<double>().swap(mDirection);
+                std::vector<double>().swap(mScaledDirection);
+                std::vector<double>().swap(mNextScaledDirection);
+            }
+
+
+            /**
+             * @brief 设置多项式次数，立即生效
+             */
+            void SetDegree(const unsigned int Degree){
+                mDegree = Degree;
+            }
+
+
+            /**
+             * @brief 返回多项式次数
+             */
+            unsigned int GetDegree() const{
+                return mDegree;
+            }
+
+
+            /**
+             * @brief 设置估计特征值界的 Lanczos 步数，下一次 Initialize 时生效
+             */
+            void SetEigenvalueIterations(const unsigned int EigenvalueIterations){
+                mEigenvalueIterations = EigenvalueIterations;
+            }
+
+
+            /**
+             * @brief 返回估计特征值界的 Lanczos 步数
+             */
+            unsigned int GetEigenvalueIterations() const{
+                return mEigenvalueIterations;
+            }
+
+
+            /**
+             * @brief 设置 λmax/λmin 的固定比值，0 表示 λmin 取最小 Ritz 值
+             * @details 作多重网格光滑器时通常只需压低 [λmax/r, λmax] 上的高频分量，r 取 10~30
+             */
+            void SetEigenvalueRatio(const double EigenvalueRatio){
+                mEigenvalueRatio = EigenvalueRatio;
+            }
+
+
+            /**
+             * @brief 返回 λmax/λmin 的固定比值
+             */
+            double GetEigenvalueRatio() const{
+                return mEigenvalueRatio;
+            }
+
+
+            /**
+             * @brief 返回估计的特征值下界
+             */
+            double GetLowerBound() const{
+                return mLowerBound;
+            }
+
+
+            /**
+             * @brief 返回估计的特征值上界
+             */
+            double GetUpperBound() const{
+                return mUpperBound;
+            }
+
+
+            std::string Info() const override{
+                return "Chebyshev preconditioner";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "Chebyshev preconditioner";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "degree : " << mDegree << " eigenvalue bounds : [" << mLowerBound << ", " << mUpperBound << "]" << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief rOut = As*rIn，其中 rIn 已乘以 S（rIn = S*v），即 rOut_i = s_i * Σ a_ij * rIn_j
+             */
+            void ScaledProduct(const SparseMatrixType& rA, const std::vector<double>& rIn, std::vector<double>& rOut) const{
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    double sum = 0.0;
+                    for(std::size_t k=r_row_indices[i]; k<static_cast<std::size_t>(r_row_indices[i+1]); ++k){
+                        sum += r_values[k] * rIn[r_col_indices[k]];
+                    }
+                    rOut[i] = mScaling[i] * sum;
+                });
+            }
+
+
+            /**
+             * @brief 以 Chebyshev 三项递推计算 rY = p(As)*v，v 事先存放在 mResidual 中
+             * @details d0 = v/θ，y = d0；此后每步 r <- r - As*d，d <- ρ_{k+1}ρ_k*d + (2ρ_{k+1}/δ)*r，y <- y + d，
+             *  ρ_0 = δ/θ，ρ_{k+1} = 1/(2θ/δ - ρ_k)。As*d 以 S*d 的双缓冲计算，其余量逐行原位更新，每步一遍
+             */
+            void ApplyPolynomial(const SparseMatrixType& rA, VectorType& rY){
+                const std::size_t size = mScaling.size();
+                const double theta = 0.5 * (mUpperBound + mLowerBound);
+                const double delta = 0.5 * (mUpperBound - mLowerBound);
+                const double sigma = theta / delta;
+
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    const double d = mResidual[i] / theta;
+                    mDirection[i] = d;
+                    mScaledDirection[i] = mScaling[i] * d;
+                    rY[i] = d;
+                });
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+
+                double rho = 1.0 / sigma;
+                for(unsigned int step = 0; step < mDegree; ++step){
+                    const double rho_next = 1.0 / (2.0 * sigma - rho);
+                    const double direction_factor = rho_next * rho;
+                    const double residual_factor = 2.0 * rho_next / delta;
+
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        double sum = 0.0;
+                        for(std::size_t k=r_row_indices[i]; k<static_cast<std::size_t>(r_row_indices[i+1]); ++k){
+                            sum += r_values[k] * mScaledDirection[r_col_indices[k]];
+                        }
+                        const double r = mResidual[i] - mScaling[i] * sum;
+                        const double d = direction_factor * mDirection[i] + residual_factor * r;
+                        mResidual[i] = r;
+                        mDirection[i] = d;
+                        mNextScaledDirection[i] = mScaling[i] * d;
+                        rY[i] += d;
+                    });
+                    mScaledDirection.swap(mNextScaledDirection);
+                    rho = rho_next;
+                }
+            }
+
+
+            /**
+             * @brief 估计 As 的特征值界
+             * @details 从确定性的正向量出发做 mEigenvalueIterations 步 Lanczos 迭代（不重正交化），
+             *  以二分法求三对角阵的最大、最小特征值（Ritz 值）。最大 Ritz 值从下方逼近 λmax，故放大 1.1 倍，并以 Gershgorin 上界截断
+             */
+            void EstimateEigenvalueBounds(const SparseMatrixType& rA){
+                mpMatrix = &rA;
+                const std::size_t size = mScaling.size();
+                if(size == 0){
+                    mLowerBound = 0.5;
+                    mUpperBound = 1.0;
+                    return;
+                }
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+                const double gershgorin = IndexPartition<std::size_t>(size).template for_each<Internals::MaxReduction<double>>([&](std::size_t i){
+                    double row_sum = 0.0;
+                    for(std::size_t k=r_row_indices[i]; k<static_cast<std::size_t>(r_row_indices[i+1]); ++k){
+                        row_sum += std::abs(r_values[k]) * mScaling[r_col_indices[k]];
+                    }
+                    return mScaling[i] * row_sum;
+                });
+
+                // v 存放在 mDirection，前一个 Lanczos 向量在 mResidual，S*v 在 mScaledDirection，As*v 在 mNextScaledDirection
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    mDirection[i] = 1.0 + 0.5 * std::sin(static_cast<double>(i) * 0.7548776662466927);
+                    mResidual[i] = 0.0;
+                });
+                double norm = std::sqrt(Dot(mDirection, mDirection));
+
+                std::vector<double> alphas;
+                std::vector<double> betas;
+                double beta = 0.0;
+                const unsigned int num_steps = std::max(1u, std::min<unsigned int>(mEigenvalueIterations, size));
+                for(unsigned int j = 0; j < num_steps; ++j){
+                    const double inverse_norm = 1.0 / norm;
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        mDirection[i] *= inverse_norm;
+                        mScaledDirection[i] = mScaling[i] * mDirection[i];
+                    });
+                    ScaledProduct(rA, mScaledDirection, mNextScaledDirection);
+
+                    const double alpha = Dot(mDirection, mNextScaledDirection);
+                    alphas.push_back(alpha);
+
+                    // w = As*v - α*v - β*v_prev，随后 v_prev <- v，v <- w
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        const double w = mNextScaledDirection[i] - alpha * mDirection[i] - beta * mResidual[i];
+                        mResidual[i] = mDirection[i];
+                        mDirection[i] = w;
+                    });
+                    beta = std::sqrt(Dot(mDirection, mDirection));
+                    if(j + 1 == num_steps || beta <= 1.0e-12 * std::abs(alpha)){
+                        break;
+                    }
+                    betas.push_back(beta);
+                    norm = beta;
+                }
+
+                const double ritz_max = TridiagonalEigenvalue(alphas, betas, alphas.size() - 1);
+                const double ritz_min = TridiagonalEigenvalue(alphas, betas, 0);
+
+                mUpperBound = std::min(1.1 * ritz_max, gershgorin);
+                if(!(mUpperBound > 0.0)){
+                    mUpperBound = gershgorin > 0.0 ? gershgorin : 1.0;
+                }
+                mLowerBound = (mEigenvalueRatio > 0.0) ? mUpperBound / mEigenvalueRatio : ritz_min;
+                if(!(mLowerBound > 0.0) || mLowerBound >= mUpperBound){
+                    mLowerBound = mUpperBound / 30.0;
+                }
+            }
+
+
+            /**
+             * @brief 对称三对角阵（对角 rAlphas，次对角 rBetas）升序第 Index 个特征值，Sturm 序列二分
+             */
+            static double TridiagonalEigenvalue(const std::vector<double>& rAlphas, const std::vector<double>& rBetas, const std::size_t Index){
+                const std::size_t n = rAlphas.size();
+                double lower = rAlphas[0];
+                double upper = rAlphas[0];
+                for(std::size_t i=0; i<n; ++i){
+                    const double radius = (i > 0 ? std::abs(rBetas[i-1]) : 0.0) + (i+1 < n ? std::abs(rBetas[i]) : 0.0);
+                    lower = std::min(lower, rAlphas[i] - radius);
+                    upper = std::max(upper, rAlphas[i] + radius);
+                }
+
+                // 小于 x 的特征值个数
+                auto count_below = [&](const double x){
+                    std::size_t count = 0;
+                    double q = rAlphas[0] - x;
+                    for(std::size_t i=0; ; ++i){
+                        if(q < 0.0){
+                            ++count;
+                        }
+                        if(i+1 == n){
+                            break;
+                        }
+                        if(q == 0.0){
+                            q = 1.0e-300;
+                        }
+                        q = rAlphas[i+1] - x - rBetas[i] * rBetas[i] / q;
+                    }
+                    return count;
+                };
+
+                for(int iteration = 0; iteration < 100 && upper - lower > 1.0e-10 * std::max(std::abs(lower), std::abs(upper)); ++iteration){
+                    const double middle = 0.5 * (lower + upper);
+                    if(count_below(middle) > Index){
+                        upper = middle;
+                    } else {
+                        lower = middle;
+                    }
+                }
+                return 0.5 * (lower + upper);
+            }
+
+
+            /**
+             * @brief 并行内积
+             */
+            static double Dot(const std::vector<double>& rA, const std::vector<double>& rB){
+                return IndexPartition<std::size_t>(rA.size()).template for_each<Internals::SumReduction<double>>([&](std::size_t i){
+                    return rA[i] * rB[i];
+                });
+            }
+
+        private:
+            /**
+             * @brief 多项式次数
+             */
+            unsigned int mDegree;
+
+            /**
+             * @brief 估计特征值界的 Lanczos 步数
+             */
+            unsigned int mEigenvalueIterations;
+
+            /**
+             * @brief λmax/λmin 的固定比值，0 表示使用 Lanczos 估计的 λmin
+             */
+            double mEigenvalueRatio = 0.0;
+
+            /**
+             * @brief 特征值下界 λmin
+             */
+            double mLowerBound = 0.0;
+
+            /**
+             * @brief 特征值上界 λmax
+             */
+            double mUpperBound = 1.0;
+
+            /**
+             * @brief 最近一次 Initialize 或 Mult 的系数矩阵，ApplyLeft 与 ApplyTransposeRight 中的多项式求值使用
+             */
+            const SparseMatrixType* mpMatrix = nullptr;
+
+            /**
+             * @brief 对称Jacobi缩放因子 1/sqrt(|Aii|)
+             */
+            std::vector<double> mScaling;
+
+            /**
+             * @brief 多项式求值的残差向量
+             */
+            std::vector<double> mResidual;
+
+            /**
+             * @brief 多项式求值的方向向量
+             */
+            std::vector<double> mDirection;
+
+            /**
+             * @brief S*方向向量，矩阵向量乘的输入
+             */
+            std::vector<double> mScaledDirection;
+
+            /**
+             * @brief S*方向向量的另一缓冲
+             */
+            std::vector<double> mNextScaledDirection;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::istream& operator >> (std::istream& rIstream, ChebyshevPreconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::ostream& operator << (std::ostream& rOstream, const ChebyshevPreconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+}
+
+#endif //QUEST_CHEBYSHEV_PRECONDITIONER_HPP
@@ -0,0 +1,107 @@
+#ifndef QUEST_ILU0_PRECONDITIONER_HPP
+#define QUEST_ILU0_PRECONDITIONER_HPP
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/preconditioner/ilu_preconditioner.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ILU0Preconditioner
+     * @brief 零填充不完全LU分解（ILU(0)）预处理器
+     * @details L 与 U 的稀疏模式与 A 相同，分解过程中不产生新的非零元。
+     *  矩阵每行的列号须递增且包含对角元
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    class ILU0Preconditioner : public ILUPreconditioner<TSparseSpaceType, TDenseSpaceType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(ILU0Preconditioner);
+
+            using BaseType = ILUPreconditioner<TSparseSpaceType, TDenseSpaceType>;
+            using SparseMatrixType = typename BaseType::SparseMatrixType;
+            using VectorType = typename BaseType::VectorType;
+            using DenseMatrixType = typename BaseType::DenseMatrixType;
+            using IndexType = typename BaseType::IndexType;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            ILU0Preconditioner(){}
+
+            /**
+             * @brief 复制构造函数
+             */
+            ILU0Preconditioner(const ILU0Preconditioner& rOther):
+                BaseType(rOther)
+            {}
+
+            /**
+             * @brief 析构函数
+             */
+            ~ILU0Preconditioner() override {}
+
+            /**
+             * @brief 赋值运算符
+             */
+            ILU0Preconditioner& operator = (const ILU0Preconditioner& rOther){
+                BaseType::operator=(rOther);
+                return *this;
+            }
+
+
+            std::string Info() const override{
+                return "ILU0 preconditioner";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "ILU0 preconditioner";
+            }
+
+        protected:
+            /**
+             * @brief 稀疏模式取 A 的稀疏模式
+             */
+            void BuildPattern(SparseMatrixType& rA) override{
+                const IndexType size = rA.size1();
+                const IndexType nnz = BaseType::MatrixNonZeros(rA);
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                this->mRowIndices.resize(size+1);
+                this->mColIndices.resize(nnz);
+                IndexPartition<IndexType>(size+1).for_each([&](IndexType i){
+                    this->mRowIndices[i] = r_row_indices[i];
+                });
+                IndexPartition<IndexType>(nnz).for_each([&](IndexType k){
+                    this->mColIndices[k] = r_col_indices[k];
+                });
+            }
+
+        private:
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::istream& operator >> (std::istream& rIstream, ILU0Preconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::ostream& operator << (std::ostream& rOstream, const ILU0Preconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_ILU0_PRECONDITIONER_HPP
@@ -0,0 +1,489 @@
+#ifndef QUEST_ILU_PRECONDITIONER_HPP
+#define QUEST_ILU_PRECONDITIONER_HPP
+
+// 系统头文件
+#include <vector>
+#include <cmath>
+#include <limits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/triangular_level_schedule.hpp"
+#include "linear_solvers/preconditioner/preconditioner.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ILUPreconditioner
+     * @brief 不完全LU分解预处理器基类
+     * @details 在给定的稀疏模式 P 上计算 A ≈ L*U，L 为单位下三角阵，U 为上三角阵，二者共用一个CSR数组存储（每行列号递增）。
+     *  派生类只负责确定稀疏模式（ILU(0) 取 A 的模式，ILUT 按阈值与填充数确定），数值分解与三角求解由本类完成：
+     *  - 数值分解按 IKJ 顺序逐行消元，第 i 行只读取 L(i,k) != 0 的各行 k，因此与前代求解具有相同的依赖关系，
+     *    按下三角层次调度逐层并行；
+     *  - 前代与回代分别按下三角、上三角层次调度逐层并行；
+     *  - 稀疏模式、A 到 P 的数值映射与层次调度只依赖矩阵的稀疏模式，模式不变时（如各时间步之间）只重新进行数值分解。
+     *  记 D = |diag(U)|，左预处理为 D^(-1/2)*L^(-1)，右预处理为 U^(-1)*D^(1/2)，二者之积为 (LU)^(-1)。
+     *  A 对称且模式为 ILU(0) 时 U = diag(U)*LT，预处理后的矩阵 D^(-1/2)*L^(-1)*A*L^(-T)*D^(-1/2) 仍然对称，可与CG配合使用
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    class ILUPreconditioner : public Preconditioner<TSparseSpaceType, TDenseSpaceType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(ILUPreconditioner);
+
+            using BaseType = Preconditioner<TSparseSpaceType, TDenseSpaceType>;
+            using SparseMatrixType = typename BaseType::SparseMatrixType;
+            using VectorType = typename BaseType::VectorType;
+            using DenseMatrixType = typename BaseType::DenseMatrixType;
+            using DataType = typename TSparseSpaceType::DataType;
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+            using ScheduleType = TriangularLevelSchedule<IndexType>;
+
+            /**
+             * @brief 数值映射中表示 A 的条目不在稀疏模式 P 中
+             */
+            static constexpr IndexType NoEntry = std::numeric_limits<IndexType>::max();
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            ILUPreconditioner(){}
+
+            /**
+             * @brief 复制构造函数
+             * @details 分解结果不复制，在下一次 Initialize 时重新计算
+             */
+            ILUPreconditioner(const ILUPreconditioner& rOther):
+                BaseType(rOther),
+                mReuseSymbolicFactorization(rOther.mReuseSymbolicFactorization)
+            {}
+
+            /**
+             * @brief 析构函数
+             */
+            ~ILUPreconditioner() override {}
+
+            /**
+             * @brief 赋值运算符
+             */
+            ILUPreconditioner& operator = (const ILUPreconditioner& rOther){
+                BaseType::operator=(rOther);
+                mReuseSymbolicFactorization = rOther.mReuseSymbolicFactorization;
+                Clear();
+                return *this;
+            }
+
+            /**
+             * @brief 为线性系统 rA*rX = rB 初始化预处理器
+             * @details 稀疏模式与上次相同且允许重用时只进行数值分解，否则先由派生类确定稀疏模式
+             */
+            void Initialize(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(!(mReuseSymbolicFactorization && IsBuiltFor(rA))){
+                    SymbolicFactorization(rA);
+                    mNumberOfNumericFactorizations = 0;
+                }
+                NumericFactorization(rA);
+                ++mNumberOfNumericFactorizations;
+            }
+
+
+            void Initialize(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::Initialize(rA, rX, rB);
+            }
+
+
+            /**
+             * @brief 左预处理 D^(-1/2)*L^(-1)
+             */
+            VectorType& ApplyLeft(VectorType& rX) override{
+                mLowerSchedule.ForEachRow([&](IndexType i){
+                    DataType sum = rX[i];
+                    for(IndexType k=mRowIndices[i]; k<mDiagonal[i]; ++k){
+                        sum -= mValues[k] * rX[mColIndices[k]];
+                    }
+                    rX[i] = sum;
+                });
+                IndexPartition<IndexType>(mScaling.size()).for_each([&](IndexType i){
+                    rX[i] /= mScaling[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 右预处理 U^(-1)*D^(1/2)
+             */
+            VectorType& ApplyRight(VectorType& rX) override{
+                IndexPartition<IndexType>(mScaling.size()).for_each([&](IndexType i){
+                    rX[i] *= mScaling[i];
+                });
+                mUpperSchedule.ForEachRow([&](IndexType i){
+                    DataType sum = rX[i];
+                    for(IndexType k=mDiagonal[i]+1; k<mRowIndices[i+1]; ++k){
+                        sum -= mValues[k] * rX[mColIndices[k]];
+                    }
+                    rX[i] = sum / mValues[mDiagonal[i]];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 转置预处理系统的左预处理 D^(1/2)*U^(-T)
+             * @details 按列（逐行散射）求解，串行执行
+             */
+            VectorType& ApplyTransposeLeft(VectorType& rX) override{
+                const IndexType size = mScaling.size();
+                for(IndexType i=0; i<size; ++i){
+                    const DataType z_i = rX[i] / mValues[mDiagonal[i]];
+                    rX[i] = z_i;
+                    for(IndexType k=mDiagonal[i]+1; k<mRowIndices[i+1]; ++k){
+                        rX[mColIndices[k]] -= mValues[k] * z_i;
+                    }
+                }
+                IndexPartition<IndexType>(size).for_each([&](IndexType i){
+                    rX[i] *= mScaling[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 转置预处理系统的右预处理 L^(-T)*D^(-1/2)
+             * @details 按列（逐行散射）求解，串行执行
+             */
+            VectorType& ApplyTransposeRight(VectorType& rX) override{
+                const IndexType size = mScaling.size();
+                IndexPartition<IndexType>(size).for_each([&](IndexType i){
+                    rX[i] /= mScaling[i];
+                });
+                for(IndexType i=size; i-->0;){
+                    const DataType z_i = rX[i];
+                    for(IndexType k=mRowIndices[i]; k<mDiagonal[i]; ++k){
+                        rX[mColIndices[k]] -= mValues[k] * z_i;
+                    }
+                }
+                return rX;
+            }
+
+
+            /**
+             * @brief 右侧逆操作预处理 D^(-1/2)*U
+             */
+            VectorType& ApplyInverseRight(VectorType& rX) override{
+                const IndexType size = mScaling.size();
+                mTemp.resize(size);
+                IndexPartition<IndexType>(size).for_each([&](IndexType i){
+                    DataType sum = DataType();
+                    for(IndexType k=mDiagonal[i]; k<mRowIndices[i+1]; ++k){
+                        sum += mValues[k] * rX[mColIndices[k]];
+                    }
+                    mTemp[i] = sum / mScaling[i];
+                });
+                IndexPartition<IndexType>(size).for_each([&](IndexType i){
+                    rX[i] = mTemp[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 清除分解结果、数值映射与层次调度
+             */
+            void Clear() override{
+                IndexVectorType().swap(mRowIndices);
+                IndexVectorType().swap(mColIndices);
+                IndexVectorType().swap(mDiagonal);
+                IndexVectorType().swap(mValueMap);
+                std::vector<DataType>().swap(mValues);
+                std::vector<DataType>().swap(mScaling);
+                std::vector<DataType>().swap(mTemp);
+                mLowerSchedule.Clear();
+                mUpperSchedule.Clear();
+                mpSourceRowIndices = nullptr;
+                mSourceSize = 0;
+                mSourceNonZeros = 0;
+                mNumberOfNumericFactorizations = 0;
+            }
+
+
+            /**
+             * @brief 设置稀疏模式不变时是否只进行数值分解
+             */
+            void SetReuseSymbolicFactorization(const bool Reuse){
+                mReuseSymbolicFactorization = Reuse;
+            }
+
+
+            /**
+             * @brief 返回稀疏模式不变时是否只进行数值分解
+             */
+            bool GetReuseSymbolicFactorization() const{
+                return mReuseSymbolicFactorization;
+            }
+
+
+            /**
+             * @brief 返回自上次确定稀疏模式以来的数值分解次数
+             */
+            std::size_t GetNumberOfNumericFactorizations() const{
+                return mNumberOfNumericFactorizations;
+            }
+
+
+            /**
+             * @brief 返回 L 与 U 的非零元总数
+             */
+            IndexType NumberOfNonZeros() const{
+                return mColIndices.size();
+            }
+
+
+            /**
+             * @brief 返回前代的层次调度
+             */
+            const ScheduleType& GetLowerSchedule() const{
+                return mLowerSchedule;
+            }
+
+
+            /**
+             * @brief 返回回代的层次调度
+             */
+            const ScheduleType& GetUpperSchedule() const{
+                return mUpperSchedule;
+            }
+
+
+            std::string Info() const override{
+                return "ILU preconditioner";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "ILU preconditioner";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "number of rows : " << mScaling.size() << " factor nnz : " << NumberOfNonZeros()
+                    << " lower levels : " << mLowerSchedule.NumberOfLevels()
+                    << " upper levels : " << mUpperSchedule.NumberOfLevels()
+                    << " numeric factorizations : " << mNumberOfNumericFactorizations << std::endl;
+            }
+
+        protected:
+            /**
+             * @brief 确定稀疏模式 P
+             * @details 派生类填充 mRowIndices 与 mColIndices（每行列号递增且包含对角元），其余数据由本类生成
+             */
+            virtual void BuildPattern(SparseMatrixType& rA) = 0;
+
+            /**
+             * @brief 返回矩阵的非零元个数
+             */
+            static IndexType MatrixNonZeros(const SparseMatrixType& rA){
+                return rA.size1() == 0 ? 0 : static_cast<IndexType>(rA.index1_data()[rA.size1()]);
+            }
+
+        protected:
+            /**
+             * @brief 稀疏模式 P 的行索引
+             */
+            IndexVectorType mRowIndices;
+
+            /**
+             * @brief 稀疏模式 P 的列索引
+             */
+            IndexVectorType mColIndices;
+
+        private:
+            /**
+             * @brief 判断稀疏模式、数值映射与层次调度是否由该矩阵的当前稀疏模式生成
+             */
+            bool IsBuiltFor(const SparseMatrixType& rA) const{
+                return mpSourceRowIndices != nullptr
+                    && mpSourceRowIndices == static_cast<const void*>(&rA.index1_data()[0])
+                    && mSourceSize == rA.size1()
+                    && mSourceNonZeros == MatrixNonZeros(rA);
+            }
+
+            /**
+             * @brief 确定稀疏模式并生成对角元位置、A 到 P 的数值映射与层次调度
+             */
+            void SymbolicFactorization(SparseMatrixType& rA){
+                const IndexType size = rA.size1();
+                QUEST_ERROR_IF(size != rA.size2()) << "ILU preconditioner requires a square matrix, got " << size << "x" << rA.size2() << std::endl;
+
+                BuildPattern(rA);
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                mDiagonal.resize(size);
+                mValueMap.resize(MatrixNonZeros(rA));
+                IndexPartition<IndexType>(size).for_each([&](IndexType i){
+                    mDiagonal[i] = NoEntry;
+                    for(IndexType k=mRowIndices[i]; k<mRowIndices[i+1]; ++k){
+                        QUEST_ERROR_IF(k > mRowIndices[i] && mColIndices[k] <= mColIndices[k-1]) << "ILU preconditioner: unsorted columns in row " << i << std::endl;
+                        if(mColIndices[k] == i){
+                            mDiagonal[i] = k;
+                        }
+                    }
+                    QUEST_ERROR_IF(mDiagonal[i] == NoEntry) << "ILU preconditioner: no diagonal entry in row " << i << std::endl;
+
+                    // A 与 P 的每行列号均递增，逐行归并得到数值映射
+                    IndexType p = mRowIndices[i];
+                    for(IndexType k=r_row_indices[i]; k<static_cast<IndexType>(r_row_indices[i+1]); ++k){
+                        const IndexType col = r_col_indices[k];
+                        while(p < mRowIndices[i+1] && mColIndices[p] < col){
+                            ++p;
+                        }
+                        mValueMap[k] = (p < mRowIndices[i+1] && mColIndices[p] == col) ? p : NoEntry;
+                    }
+                });
+
+                mLowerSchedule.BuildLower(size, mRowIndices.data(), mColIndices.data(), mDiagonal.data());
+                mUpperSchedule.BuildUpper(size, mRowIndices.data(), mColIndices.data(), mDiagonal.data());
+
+                mValues.resize(mColIndices.size());
+                mScaling.resize(size);
+
+                mpSourceRowIndices = static_cast<const void*>(&r_row_indices[0]);
+                mSourceSize = size;
+                mSourceNonZeros = MatrixNonZeros(rA);
+            }
+
+            /**
+             * @brief 在稀疏模式 P 上进行数值分解
+             * @details 把 A 的数值写入 P（不在 P 中的条目舍去），随后按下三角层次调度逐层并行地进行 IKJ 消元：
+             *  对第 i 行按列号递增的每个 L(i,k)，令 L(i,k) = a(i,k)/U(k,k)，并对第 k 行 U 部分与第 i 行 k 之后部分的公共列 j
+             *  执行 a(i,j) -= L(i,k)*U(k,j)，两者列号均递增，逐项归并即可定位
+             */
+            void NumericFactorization(SparseMatrixType& rA){
+                const IndexType size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_values = rA.value_data();
+
+                IndexPartition<IndexType>(size).for_each([&](IndexType i){
+                    for(IndexType k=mRowIndices[i]; k<mRowIndices[i+1]; ++k){
+                        mValues[k] = DataType();
+                    }
+                    for(IndexType k=r_row_indices[i]; k<static_cast<IndexType>(r_row_indices[i+1]); ++k){
+                        if(mValueMap[k] != NoEntry){
+                            mValues[mValueMap[k]] = r_values[k];
+                        }
+                    }
+                });
+
+                mLowerSchedule.ForEachRow([&](IndexType i){
+                    const IndexType row_end = mRowIndices[i+1];
+                    for(IndexType ik=mRowIndices[i]; ik<mDiagonal[i]; ++ik){
+                        const IndexType k = mColIndices[ik];
+                        const DataType l_ik = mValues[ik] / mValues[mDiagonal[k]];
+                        mValues[ik] = l_ik;
+                        IndexType ij = ik + 1;
+                        for(IndexType kj=mDiagonal[k]+1; kj<mRowIndices[k+1]; ++kj){
+                            const IndexType col = mColIndices[kj];
+                            while(ij < row_end && mColIndices[ij] < col){
+                                ++ij;
+                            }
+                            if(ij == row_end){
+                                break;
+                            }
+                            if(mColIndices[ij] == col){
+                                mValues[ij] -= l_ik * mValues[kj];
+                            }
+                        }
+                    }
+                    QUEST_ERROR_IF(mValues[mDiagonal[i]] == DataType()) << "ILU preconditioner: zero pivot found at row " << i << std::endl;
+                    mScaling[i] = std::sqrt(std::abs(mValues[mDiagonal[i]]));
+                });
+            }
+
+        private:
+            /**
+             * @brief 稀疏模式 P 中各行对角元的位置
+             */
+            IndexVectorType mDiagonal;
+
+            /**
+             * @brief A 的第 k 个非零元在 P 中的位置，不在 P 中时为 NoEntry
+             */
+            IndexVectorType mValueMap;
+
+            /**
+             * @brief L（对角元以下）与 U（含对角元）的数值
+             */
+            std::vector<DataType> mValues;
+
+            /**
+             * @brief sqrt(|U(i,i)|)
+             */
+            std::vector<DataType> mScaling;
+
+            /**
+             * @brief ApplyInverseRight 使用的工作向量
+             */
+            std::vector<DataType> mTemp;
+
+            /**
+             * @brief 前代（及数值分解）的层次调度
+             */
+            ScheduleType mLowerSchedule;
+
+            /**
+             * @brief 回代的层次调度
+             */
+            ScheduleType mUpperSchedule;
+
+            /**
+             * @brief 稀疏模式不变时是否只进行数值分解
+             */
+            bool mReuseSymbolicFactorization = true;
+
+            /**
+             * @brief 确定稀疏模式时矩阵行索引数组的地址
+             */
+            const void* mpSourceRowIndices = nullptr;
+
+            /**
+             * @brief 确定稀疏模式时矩阵的行数
+             */
+            IndexType mSourceSize = 0;
+
+            /**
+             * @brief 确定稀疏模式时矩阵的非零元个数
+             */
+            IndexType mSourceNonZeros = 0;
+
+            /**
+             * @brief 自上次确定稀疏模式以来的数值分解次数
+             */
+            std::size_t mNumberOfNumericFactorizations = 0;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::istream& operator >> (std::istream& rIstream, ILUPreconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::ostream& operator << (std::ostream& rOstream, const ILUPreconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_ILU_PRECONDITIONER_HPP
@@ -0,0 +1,288 @@
+#ifndef QUEST_ILUT_PRECONDITIONER_HPP
+#define QUEST_ILUT_PRECONDITIONER_HPP
+
+// 系统头文件
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/preconditioner/ilu_preconditioner.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ILUTPreconditioner
+     * @brief 阈值不完全LU分解（ILUT）预处理器
+     * @details 稀疏模式按 Saad 的 ILUT(τ, p) 逐行消元确定：消元时绝对值小于 τ*||a_i||/n_i 的乘子直接舍去，
+     *  消元结束后 L 与 U 部分各只保留绝对值不小于该阈值的最大若干项（A 中该部分原有的非零元数加上 FillIn），对角元始终保留。
+     *  这一步按行串行进行，只在稀疏模式变化时执行；数值由基类在该模式上按层次调度并行分解，
+     *  稀疏模式不变时（如各时间步之间）直接复用该模式只重新进行数值分解
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    class ILUTPreconditioner : public ILUPreconditioner<TSparseSpaceType, TDenseSpaceType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(ILUTPreconditioner);
+
+            using BaseType = ILUPreconditioner<TSparseSpaceType, TDenseSpaceType>;
+            using SparseMatrixType = typename BaseType::SparseMatrixType;
+            using VectorType = typename BaseType::VectorType;
+            using DenseMatrixType = typename BaseType::DenseMatrixType;
+            using DataType = typename BaseType::DataType;
+            using IndexType = typename BaseType::IndexType;
+
+        public:
+            /**
+             * @brief 构造函数
+             * @param DropTolerance 相对舍弃阈值 τ
+             * @param FillIn 每行 L 与 U 部分各自允许的额外非零元个数
+             */
+            explicit ILUTPreconditioner(const double DropTolerance = 1e-4, const unsigned int FillIn = 10):
+                mDropTolerance(DropTolerance),
+                mFillIn(FillIn)
+            {}
+
+            /**
+             * @brief 复制构造函数
+             */
+            ILUTPreconditioner(const ILUTPreconditioner& rOther):
+                BaseType(rOther),
+                mDropTolerance(rOther.mDropTolerance),
+                mFillIn(rOther.mFillIn)
+            {}
+
+            /**
+             * @brief 析构函数
+             */
+            ~ILUTPreconditioner() override {}
+
+            /**
+             * @brief 赋值运算符
+             */
+            ILUTPreconditioner& operator = (const ILUTPreconditioner& rOther){
+                BaseType::operator=(rOther);
+                mDropTolerance = rOther.mDropTolerance;
+                mFillIn = rOther.mFillIn;
+                return *this;
+            }
+
+
+            /**
+             * @brief 设置相对舍弃阈值，下一次确定稀疏模式时生效
+             */
+            void SetDropTolerance(const double DropTolerance){
+                mDropTolerance = DropTolerance;
+                this->Clear();
+            }
+
+
+            /**
+             * @brief 返回相对舍弃阈值
+             */
+            double GetDropTolerance() const{
+                return mDropTolerance;
+            }
+
+
+            /**
+             * @brief 设置每行允许的额外非零元个数，下一次确定稀疏模式时生效
+             */
+            void SetFillIn(const unsigned int FillIn){
+                mFillIn = FillIn;
+                this->Clear();
+            }
+
+
+            /**
+             * @brief 返回每行允许的额外非零元个数
+             */
+            unsigned int GetFillIn() const{
+                return mFillIn;
+            }
+
+
+            std::string Info() const override{
+                return "ILUT preconditioner";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "ILUT preconditioner";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "drop tolerance : " << mDropTolerance << " fill in : " << mFillIn << std::endl;
+                BaseType::PrintData(rOstream);
+            }
+
+        protected:
+            /**
+             * @brief 按 ILUT(τ, p) 逐行消元确定稀疏模式
+             * @details 第 i 行载入稠密工作行 w，按列号递增（以最小堆维护，包括消元中新产生的填充）依次消去 k < i 的各项，
+             *  消元需要已处理各行的 U 部分数值，这些数值只在此处临时保存
+             */
+            void BuildPattern(SparseMatrixType& rA) override{
+                const IndexType size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+
+                std::vector<std::vector<std::pair<IndexType, DataType>>> upper_rows(size);
+                std::vector<DataType> work(size, DataType());
+                std::vector<char> is_nonzero(size, 0);
+                std::vector<IndexType> nonzeros;
+                std::vector<IndexType> heap;
+                std::vector<std::pair<double, IndexType>> candidates;
+
+                this->mRowIndices.assign(1, 0);
+                this->mColIndices.clear();
+
+                for(IndexType i=0; i<size; ++i){
+                    const IndexType row_begin = r_row_indices[i];
+                    const IndexType row_end = r_row_indices[i+1];
+
+                    double row_norm = 0.0;
+                    IndexType lower_count = 0;
+                    IndexType upper_count = 0;
+                    nonzeros.clear();
+                    heap.clear();
+                    for(IndexType k=row_begin; k<row_end; ++k){
+                        const IndexType j = r_col_indices[k];
+                        row_norm += std::abs(r_values[k]) * std::abs(r_values[k]);
+                        if(!is_nonzero[j]){
+                            is_nonzero[j] = 1;
+                            nonzeros.push_back(j);
+                            if(j < i){
+                                heap.push_back(j);
+                            }
+                        }
+                        work[j] += r_values[k];
+                        if(j < i){
+                            ++lower_count;
+                        } else if(j > i){
+                            ++upper_count;
+                        }
+                    }
+                    const double drop = mDropTolerance * std::sqrt(row_norm) / std::max<IndexType>(row_end - row_begin, 1);
+                    std::make_heap(heap.begin(), heap.end(), std::greater<IndexType>());
+
+                    while(!heap.empty()){
+                        std::pop_heap(heap.begin(), heap.end(), std::greater<IndexType>());
+                        const IndexType k = heap.back();
+                        heap.pop_back();
+
+                        const auto& r_upper_k = upper_rows[k];
+                        const DataType w_k = work[k] / r_upper_k[0].second;
+                        if(std::abs(w_k) < drop){
+                            work[k] = DataType();
+                            continue;
+                        }
+                        work[k] = w_k;
+                        for(std::size_t q=1; q<r_upper_k.size(); ++q){
+                            const IndexType j = r_upper_k[q].first;
+                            if(!is_nonzero[j]){
+                                is_nonzero[j] = 1;
+                                nonzeros.push_back(j);
+                                if(j < i){
+                                    heap.push_back(j);
+                                    std::push_heap(heap.begin(), heap.end(), std::greater<IndexType>());
+                                }
+                            }
+                            work[j] -= w_k * r_upper_k[q].second;
+                        }
+                    }
+
+                    // L 部分
+                    candidates.clear();
+                    for(const IndexType j : nonzeros){
+                        if(j < i && std::abs(work[j]) >= drop && work[j] != DataType()){
+                            candidates.emplace_back(std::abs(work[j]), j);
+                        }
+                    }
+                    KeepLargest(candidates, lower_count + mFillIn);
+                    for(const auto& r_candidate : candidates){
+                        this->mColIndices.push_back(r_candidate.second);
+                    }
+
+                    // 对角元
+                    DataType diagonal = work[i];
+                    if(diagonal == DataType()){
+                        diagonal = drop > 0.0 ? drop : 1.0;
+                    }
+                    this->mColIndices.push_back(i);
+                    auto& r_upper_i = upper_rows[i];
+                    r_upper_i.emplace_back(i, diagonal);
+
+                    // U 部分
+                    candidates.clear();
+                    for(const IndexType j : nonzeros){
+                        if(j > i && std::abs(work[j]) >= drop && work[j] != DataType()){
+                            candidates.emplace_back(std::abs(work[j]), j);
+                        }
+                    }
+                    KeepLargest(candidates, upper_count + mFillIn);
+                    for(const auto& r_candidate : candidates){
+                        this->mColIndices.push_back(r_candidate.second);
+                        r_upper_i.emplace_back(r_candidate.second, work[r_candidate.second]);
+                    }
+                    this->mRowIndices.push_back(this->mColIndices.size());
+
+                    for(const IndexType j : nonzeros){
+                        work[j] = DataType();
+                        is_nonzero[j] = 0;
+                    }
+                }
+            }
+
+        private:
+            /**
+             * @brief 只保留绝对值最大的 MaxCount 项，并按列号递增排序
+             */
+            static void KeepLargest(std::vector<std::pair<double, IndexType>>& rCandidates, const IndexType MaxCount){
+                if(rCandidates.size() > MaxCount){
+                    std::nth_element(rCandidates.begin(), rCandidates.begin() + MaxCount, rCandidates.end(),
+                        [](const auto& rA, const auto& rB){ return rA.first > rB.first; });
+                    rCandidates.resize(MaxCount);
+                }
+                std::sort(rCandidates.begin(), rCandidates.end(),
+                    [](const auto& rA, const auto& rB){ return rA.second < rB.second; });
+            }
+
+        private:
+            /**
+             * @brief 相对舍弃阈值 τ
+             */
+            double mDropTolerance;
+
+            /**
+             * @brief 每行 L 与 U 部分各自允许的额外非零元个数
+             */
+            unsigned int mFillIn;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::istream& operator >> (std::istream& rIstream, ILUTPreconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType>
+    inline std::ostream& operator << (std::ostream& rOstream, const ILUTPreconditioner<TSparseSpaceType, TDenseSpaceType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_ILUT_PRECONDITIONER_HPP
@@ -0,0 +1,340 @@
+#ifndef QUEST_MIXED_PRECISION_POLYNOMIAL_PRECONDITIONER_HPP
+#define QUEST_MIXED_PRECISION_POLYNOMIAL_PRECONDITIONER_HPP
+
+// 系统头文件
+#include <vector>
+#include <cmath>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "container/mixed_precision_csr_matrix.hpp"
+#include "linear_solvers/preconditioner/preconditioner.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class MixedPrecisionPolynomialPreconditioner
+     * @brief 基于低精度矩阵副本的多项式预处理器
+     * @details 适用于对称正定矩阵。记 D 为 A 的对角阵，As = D^(-1/2)*A*D^(-1/2)，θ 为 As 的无穷范数（最大特征值的上界），
+     *  q(t) 为 t^(-1/2) 在 θ 处二项式展开的前 m+1 项：q(t) = θ^(-1/2) * sum_k c_k*(1-t/θ)^k。
+     *  右预处理 S = D^(-1/2)*q(As)，左预处理为其转置 q(As)*D^(-1/2)，迭代求解器作用于对称正定的 q(As)*As*q(As)。
+     *  As 以 MixedPrecisionCsrMatrix 存储（默认单精度数值与32位索引），多项式求值在双精度下累加；
+     *  外层迭代的矩阵向量乘与残差仍使用原双精度矩阵，低精度只影响预处理算子本身，不影响收敛后解的精度。
+     *  m = 0 时退化为对称Jacobi预处理
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     * @tparam TStorageType 低精度矩阵的数值存储类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TStorageType = float>
+    class MixedPrecisionPolynomialPreconditioner : public Preconditioner<TSparseSpaceType, TDenseSpaceType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(MixedPrecisionPolynomialPreconditioner);
+
+            using BaseType = Preconditioner<TSparseSpaceType, TDenseSpaceType>;
+            using SparseMatrixType = typename BaseType::SparseMatrixType;
+            using VectorType = typename BaseType::VectorType;
+            using DenseMatrixType = typename BaseType::DenseMatrixType;
+            using ReducedMatrixType = MixedPrecisionCsrMatrix<TStorageType, std::uint32_t>;
+
+            /**
+             * @brief 默认多项式次数
+             */
+            static constexpr unsigned int DefaultDegree = 2;
+
+        public:
+            /**
+             * @brief 构造函数
+             * @param Degree 多项式次数 m
+             */
+            explicit MixedPrecisionPolynomialPreconditioner(const unsigned int Degree = DefaultDegree):
+                mDegree(Degree)
+            {}
+
+            /**
+             * @brief 复制构造函数
+             * @details 低精度矩阵不复制，在下一次 Initialize 时重新构建
+             */
+            MixedPrecisionPolynomialPreconditioner(const MixedPrecisionPolynomialPreconditioner& rOther):
+                BaseType(rOther),
+                mDegree(rOther.mDegree)
+            {}
+
+            /**
+             * @brief 析构函数
+             */
+            ~MixedPrecisionPolynomialPreconditioner() override {}
+
+            /**
+             * @brief 赋值运算符
+             */
+            MixedPrecisionPolynomialPreconditioner& operator = (const MixedPrecisionPolynomialPreconditioner& rOther){
+                BaseType::operator=(rOther);
+                mDegree = rOther.mDegree;
+                Clear();
+                return *this;
+            }
+
+            /**
+             * @brief 为线性系统 rA*rX = rB 初始化预处理器
+             * @details 计算对称Jacobi缩放并转换出低精度矩阵；矩阵稀疏模式不变时只刷新数值
+             */
+            void Initialize(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                const std::size_t size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const auto& r_values = rA.value_data();
+
+                mScaling.resize(size);
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    double diag_Aii = 0.0;
+                    for(std::size_t k=r_row_indices[i]; k<static_cast<std::size_t>(r_row_indices[i+1]); ++k){
+                        if(static_cast<std::size_t>(r_col_indices[k]) == i){
+                            diag_Aii = r_values[k];
+                            break;
+                        }
+                    }
+                    QUEST_ERROR_IF(diag_Aii == 0.0) << "zero found in the diagonal at row " << i << ". Mixed precision polynomial preconditioner can not be used" << std::endl;
+                    mScaling[i] = 1.0/std::sqrt(std::abs(diag_Aii));
+                });
+
+                if(mReducedMatrix.IsBuiltFor(rA)){
+                    mReducedMatrix.UpdateValues(rA, mScaling.data(), mScaling.data());
+                } else {
+                    mReducedMatrix.Build(rA, mScaling.data(), mScaling.data());
+                }
+
+                mTheta = mReducedMatrix.NormInf();
+                if(mTheta <= 0.0){
+                    mTheta = 1.0;
+                }
+
+                // (1-u)^(-1/2) 的二项式展开系数
+                mCoefficients.resize(mDegree+1);
+                mCoefficients[0] = 1.0;
+                for(unsigned int k=0; k<mDegree; ++k){
+                    mCoefficients[k+1] = mCoefficients[k]*(2.0*k + 1.0)/(2.0*k + 2.0);
+                }
+
+                // 缩放后对角元为1，用 q(1) 近似 q(As) 以估计右预处理的逆
+                const double u = 1.0 - 1.0/mTheta;
+                double q_one = 0.0;
+                for(unsigned int k=mDegree+1; k-->0;){
+                    q_one = q_one*u + mCoefficients[k];
+                }
+                mInverseRightFactor = 1.0/(q_one/std::sqrt(mTheta));
+
+                mInput.resize(size);
+                mWork.resize(size);
+                mAuxiliary.resize(size);
+            }
+
+
+            void Initialize(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::Initialize(rA, rX, rB);
+            }
+
+
+            /**
+             * @brief 对向量进行左预处理 q(As)*D^(-1/2)
+             */
+            VectorType& ApplyLeft(VectorType& rX) override{
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    mInput[i] = rX[i] * mScaling[i];
+                });
+                ApplyPolynomial();
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    rX[i] = mWork[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 对向量进行右预处理 D^(-1/2)*q(As)
+             */
+            VectorType& ApplyRight(VectorType& rX) override{
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    mInput[i] = rX[i];
+                });
+                ApplyPolynomial();
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    rX[i] = mWork[i] * mScaling[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 转置预处理系统的左预处理，矩阵对称时即为右预处理的转置 q(As)*D^(-1/2)
+             */
+            VectorType& ApplyTransposeLeft(VectorType& rX) override{
+                return ApplyLeft(rX);
+            }
+
+
+            /**
+             * @brief 转置预处理系统的右预处理，矩阵对称时即为左预处理的转置 D^(-1/2)*q(As)
+             */
+            VectorType& ApplyTransposeRight(VectorType& rX) override{
+                return ApplyRight(rX);
+            }
+
+
+            /**
+             * @brief 右侧逆操作预处理
+             * @details 只用于把初始解变换到预处理空间，近似即可：以 q(1) 代替 q(As)，最终解由 Finalize 中的 ApplyRight 精确恢复
+             */
+            VectorType& ApplyInverseRight(VectorType& rX) override{
+                IndexPartition<std::size_t>(mScaling.size()).for_each([&](std::size_t i){
+                    rX[i] *= mInverseRightFactor / mScaling[i];
+                });
+                return rX;
+            }
+
+
+            /**
+             * @brief 清除低精度矩阵与工作向量
+             */
+            void Clear() override{
+                mReducedMatrix.Clear();
+                std::vector<double>().swap(mScaling);
+                std::vector<double>().swap(mCoefficients);
+                std::vector<double>().swap(mInput);
+                std::vector<double>().swap(mWork);
+                std::vector<double>().swap(mAuxiliary);
+            }
+
+
+            /**
+             * @brief 设置多项式次数，下一次 Initialize 时生效
+             */
+            void SetDegree(const unsigned int Degree){
+                mDegree = Degree;
+            }
+
+
+            /**
+             * @brief 返回多项式次数
+             */
+            unsigned int GetDegree() const{
+                return mDegree;
+            }
+
+
+            /**
+             * @brief 返回低精度矩阵
+             */
+            const ReducedMatrixType& GetReducedMatrix() const{
+                return mReducedMatrix;
+            }
+
+
+            std::string Info() const override{
+                return "Mixed precision polynomial preconditioner";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "Mixed precision polynomial preconditioner";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "degree : " << mDegree << " theta : " << mTheta << std::endl;
+                mReducedMatrix.PrintData(rOstream);
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 以 Horner 法计算 mWork = q(As)*mInput
+             * @details w = c_m*v，随后 w <- w - As*w/θ + c_k*v（k = m-1,...,0），最后乘以 θ^(-1/2)
+             */
+            void ApplyPolynomial(){
+                const std::size_t size = mInput.size();
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    mWork[i] = mCoefficients[mDegree] * mInput[i];
+                });
+                for(unsigned int k=mDegree; k-->0;){
+                    const double c_k = mCoefficients[k];
+                    IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                        mAuxiliary[i] = mWork[i] + c_k * mInput[i];
+                    });
+                    mReducedMatrix.SpMV(-1.0/mTheta, mWork.data(), 1.0, mAuxiliary.data());
+                    mWork.swap(mAuxiliary);
+                }
+                const double factor = 1.0/std::sqrt(mTheta);
+                IndexPartition<std::size_t>(size).for_each([&](std::size_t i){
+                    mWork[i] *= factor;
+                });
+            }
+
+        private:
+            /**
+             * @brief 多项式次数
+             */
+            unsigned int mDegree;
+
+            /**
+             * @brief 缩放后矩阵无穷范数，作为最大特征值的上界
+             */
+            double mTheta = 1.0;
+
+            /**
+             * @brief ApplyInverseRight 使用的标量因子 1/q(1)
+             */
+            double mInverseRightFactor = 1.0;
+
+            /**
+             * @brief 对称Jacobi缩放因子 1/sqrt(|Aii|)
+             */
+            std::vector<double> mScaling;
+
+            /**
+             * @brief 多项式系数
+             */
+            std::vector<double> mCoefficients;
+
+            /**
+             * @brief 缩放后矩阵的低精度副本
+             */
+            ReducedMatrixType mReducedMatrix;
+
+            /**
+             * @brief 多项式求值的输入向量
+             */
+            std::vector<double> mInput;
+
+            /**
+             * @brief 多项式求值的结果向量
+             */
+            std::vector<double> mWork;
+
+            /**
+             * @brief 多项式求值的辅助向量
+             */
+            std::vector<double> mAuxiliary;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TStorageType>
+    inline std::istream& operator >> (std::istream& rIstream, MixedPrecisionPolynomialPreconditioner<TSparseSpaceType, TDenseSpaceType, TStorageType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TStorageType>
+    inline std::ostream& operator << (std::ostream& rOstream, const MixedPrecisionPolynomialPreconditioner<TSparseSpaceType, TDenseSpaceType, TStorageType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+}
+
+#endif //QUEST_MIXED_PRECISION_POLYNOMIAL_PRECONDITIONER_HPP
@@ -0,0 +1,972 @@
+#ifndef QUEST_RECYCLING_CG_SOLVER_HPP
+#define QUEST_RECYCLING_CG_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "linear_solvers/iterative_solver.hpp"
+#include "factories/preconditioner_factory.hpp"
+
+namespace Quest{
+
+    /**
+     * @brief 带子空间回收的共轭梯度法求解器（deflated CG / RCG）
+     * @details 在多次求解之间保留 k 个回收向量 W（预处理后的变量空间中），求解时以 W 收缩：
+     *  初值先在 span(W) 上做 Galerkin 修正使 Wᵀr0 = 0，此后每步的搜索方向再减去其在 span(W) 上的 A 投影
+     *  p = r + βp - W E⁻¹(AW)ᵀr，E = WᵀAW。被 W 近似的小特征值不再拖慢收敛。
+     *  迭代中每积累 ℓ 个搜索方向 P 及 AP 就在 Z = [U P] 上计算调和 Ritz 向量（(AZ)ᵀ(AZ)y = θ ZᵀAZ y 的最小 k 个 θ）
+     *  更新候选空间 U（初始为 W），求解结束后 U 即为下次求解的 W（RCG 的分段更新），每次求解最多更新 SetRecycleCycles() 段。
+     *  更新所需的 ZᵀAZ、(AZ)ᵀAZ 利用 CG 方向的 A 共轭性与 U 的 F 正交性按块组装，每段只需 O(kℓ+ℓ²) 次内积。
+     *  AW 在每次求解开始时重新计算（k 次矩阵向量乘，不计入迭代次数），因此矩阵数值变化后回收空间仍然可用，
+     *  只是收缩效果随矩阵变化而减弱；矩阵阶数变化、E 不正定或调用 Clear() 时回收空间被丢弃。
+     *  除矩阵向量乘与 (p,Ap) 外，每步只有两次遍历：r 的更新与 (AW)ᵀr、(r,r) 合并为一次，x 与 p 的更新合并为一次
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType,
+             typename TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType>,
+             typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class RecyclingCGSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(RecyclingCGSolver);
+
+            using BaseType = IterativeSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            RecyclingCGSolver() {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            RecyclingCGSolver(double NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            RecyclingCGSolver(double NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+
+            /**
+             * @brief 构造函数
+             * @param RecycleSpaceDimension 回收向量个数 k
+             * @param RecycleDirections 每段保存的搜索方向个数 ℓ
+             */
+            RecyclingCGSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                unsigned int RecycleSpaceDimension,
+                unsigned int RecycleDirections
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {
+                SetRecycleSpaceDimension(RecycleSpaceDimension);
+                SetRecycleDirections(RecycleDirections);
+            }
+
+
+            /**
+             * @brief 构造函数
+             */
+            RecyclingCGSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            RecyclingCGSolver(
+                double NewMaxTolerance,
+                unsigned int NewMaxIterationsNumber,
+                unsigned int RecycleSpaceDimension,
+                unsigned int RecycleDirections,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {
+                SetRecycleSpaceDimension(RecycleSpaceDimension);
+                SetRecycleDirections(RecycleDirections);
+            }
+
+
+            /**
+             * @brief 构造函数
+             */
+            RecyclingCGSolver(
+                Parameters settings,
+                typename TPreconditionerType::Pointer pNewPreconditioner
+            ) : BaseType() {
+                AssignSettings(settings);
+                BaseType::SetPreconditioner(pNewPreconditioner);
+            }
+
+
+            /**
+             * @brief 构造函数
+             * @details 预处理器由 settings["preconditioner_type"] 经预处理器工厂创建
+             */
+            RecyclingCGSolver(Parameters settings) : BaseType(){
+                AssignSettings(settings);
+                BaseType::SetPreconditioner(PreconditionerFactory<TSparseSpaceType, TDenseSpaceType>::Create(settings["preconditioner_type"].GetString()));
+            }
+
+
+            /**
+             * @brief 复制构造函数，回收空间不复制
+             */
+            RecyclingCGSolver(const RecyclingCGSolver& Other) :
+                BaseType(Other),
+                mRecycleSpaceDimension(Other.mRecycleSpaceDimension),
+                mRecycleDirections(Other.mRecycleDirections),
+                mRecycleCycles(Other.mRecycleCycles)
+            {}
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~RecyclingCGSolver() override {}
+
+
+            /**
+             * @brief 重载赋值运算符，回收空间不复制
+             */
+            RecyclingCGSolver& operator = (const RecyclingCGSolver& Other){
+                BaseType::operator=(Other);
+                mRecycleSpaceDimension = Other.mRecycleSpaceDimension;
+                mRecycleDirections = Other.mRecycleDirections;
+                mRecycleCycles = Other.mRecycleCycles;
+                mRecycleSpace.clear();
+                return *this;
+            }
+
+
+            /**
+             * @brief 系数变化时调用，矩阵阶数改变时丢弃回收空间
+             */
+            void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                BaseType::InitializeSolutionStep(rA, rX, rB);
+                if(!mRecycleSpace.empty() && mRecycleSpace[0].size() != TSparseSpaceType::Size1(rA)){
+                    mRecycleSpace.clear();
+                }
+            }
+
+
+            /**
+             * @brief 清空预处理器与回收空间
+             */
+            void Clear() override{
+                BaseType::Clear();
+                mRecycleSpace.clear();
+            }
+
+
+            /**
+             * @brief 求解线性系统Ax=b，并将结果存储在系统向量 rX 中
+             * @param rA 系统矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                if(this->IsNotConsistent(rA, rX, rB))
+                    return false;
+
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+                BaseType::GetPreconditioner()->ApplyInverseRight(rX);
+                BaseType::GetPreconditioner()->ApplyLeft(rB);
+
+                bool is_solved = IterativeSolve(rA, rX, rB);
+
+                QUEST_WARNING_IF("Recycling CG Linear Solver", !is_solved)<<"Non converged linear solution. ["<< BaseType::GetResidualNorm()/BaseType::mBNorm << " > "<<  BaseType::GetTolerance() << "]" << std::endl;
+
+                BaseType::GetPreconditioner()->Finalize(rX);
+
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统，各列依次求解并逐次更新回收空间
+             * @param rA 系数矩阵
+             * @param rX 解向量
+             * @param rB 右端常数向量
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+                bool is_solved = true;
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                for(unsigned int i = 0; i < TDenseSpaceType::Size2(rX); i++){
+                    TDenseSpaceType::GetColumn(i,rX,x);
+                    TDenseSpaceType::GetColumn(i,rB,b);
+
+                    BaseType::GetPreconditioner()->ApplyInverseRight(x);
+                    BaseType::GetPreconditioner()->ApplyLeft(b);
+
+                    is_solved &= IterativeSolve(rA, x, b);
+
+                    BaseType::GetPreconditioner()->Finalize(x);
+                    TDenseSpaceType::SetColumn(i,rX,x);
+                }
+                return is_solved;
+            }
+
+
+            /**
+             * @brief 设置回收向量个数 k，0 时退化为普通 CG
+             */
+            void SetRecycleSpaceDimension(const unsigned int RecycleSpaceDimension){
+                mRecycleSpaceDimension = RecycleSpaceDimension;
+                if(mRecycleSpace.size() > mRecycleSpaceDimension){
+                    mRecycleSpace.resize(mRecycleSpaceDimension);
+                }
+            }
+
+
+            /**
+             * @brief 返回回收向量个数 k
+             */
+            unsigned int GetRecycleSpaceDimension() const{
+                return mRecycleSpaceDimension;
+            }
+
+
+            /**
+             * @brief 设置每段保存的搜索方向个数 ℓ（每 ℓ 步更新一次候选空间）
+             */
+            void SetRecycleDirections(const unsigned int RecycleDirections){
+                QUEST_ERROR_IF(RecycleDirections == 0 && mRecycleSpaceDimension > 0) << "The number of recycled search directions must be positive" << std::endl;
+                mRecycleDirections = RecycleDirections;
+            }
+
+
+            /**
+             * @brief 返回每段保存的搜索方向个数 ℓ
+             */
+            unsigned int GetRecycleDirections() const{
+                return mRecycleDirections;
+            }
+
+
+            /**
+             * @brief 设置每次求解最多更新候选空间的段数，0 表示整个求解过程都更新
+             * @details 候选空间在前几段内即已捕获主要的小特征值方向，限制段数可避免长求解中更新开销超过迭代本身
+             */
+            void SetRecycleCycles(const unsigned int RecycleCycles){
+                mRecycleCycles = RecycleCycles;
+            }
+
+
+            /**
+             * @brief 返回每次求解最多更新候选空间的段数
+             */
+            unsigned int GetRecycleCycles() const{
+                return mRecycleCycles;
+            }
+
+
+            /**
+             * @brief 返回当前回收空间的维数
+             */
+            std::size_t GetRecycleSpaceSize() const{
+                return mRecycleSpace.size();
+            }
+
+
+            std::string Info() const override{
+                std::stringstream buffer;
+                buffer << "Recycling conjugate gradient linear solver with " << BaseType::GetPreconditioner()->Info();
+                return  buffer.str();
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                BaseType::PrintData(rOstream);
+                rOstream << "Recycle space dimension: " << mRecycleSpaceDimension << " (current " << mRecycleSpace.size() << "), recycled directions per cycle: " << mRecycleDirections << ", cycles per solve: " << mRecycleCycles << std::endl;
+            }
+
+        protected:
+
+        private:
+            /**
+             * @brief 由参数设置容差、最大迭代次数与回收参数
+             */
+            void AssignSettings(Parameters& rSettings){
+                QUEST_TRY
+
+                Parameters default_parameters(
+                    R"({
+                        "solver_type": "recycling_cg",
+                        "tolerance": 1e-6,
+                        "max_iteration":200,
+                        "preconditioner_type":"none",
+                        "scaling": false,
+                        "recycle_space_dimension": 8,
+                        "recycle_directions": 16,
+                        "recycle_cycles": 4
+                    })"
+                );
+
+                rSettings.ValidateAndAssignDefaults(default_parameters);
+
+                this->SetTolerance(rSettings["tolerance"].GetDouble());
+                this->SetMaxIterationsNumber(rSettings["max_iteration"].GetInt());
+                SetRecycleSpaceDimension(rSettings["recycle_space_dimension"].GetInt());
+                SetRecycleDirections(rSettings["recycle_directions"].GetInt());
+                SetRecycleCycles(rSettings["recycle_cycles"].GetInt());
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 迭代求解线性系统Ax=b
+             */
+            bool IterativeSolve(SparseMatrixType& rA, VectorType& rX, VectorType& rB){
+                const std::size_t size = TSparseSpaceType::Size1(rA);
+
+                BaseType::mIterationsNumber = 0;
+                BaseType::mBNorm = TSparseSpaceType::TwoNorm(rB);
+
+                if(!mRecycleSpace.empty() && mRecycleSpace[0].size() != size){
+                    mRecycleSpace.clear();
+                }
+
+                // AW 与 E = WᵀAW 的 Cholesky 分解
+                std::vector<VectorType> recycle_images;
+                std::vector<double> coarse_matrix;
+                std::vector<double> candidate_f;
+                std::vector<double> candidate_g;
+                if(!mRecycleSpace.empty()){
+                    recycle_images.assign(mRecycleSpace.size(), VectorType(size));
+                    for(std::size_t j=0; j<mRecycleSpace.size(); ++j){
+                        this->PreconditionedMult(rA, mRecycleSpace[j], recycle_images[j]);
+                    }
+                    CrossProducts(mRecycleSpace, recycle_images, coarse_matrix);
+                    Symmetrize(mRecycleSpace.size(), coarse_matrix);
+                    candidate_f = coarse_matrix;
+                    if(CholeskyFactorize(mRecycleSpace.size(), coarse_matrix)){
+                        if(mRecycleSpaceDimension > 0){
+                            CrossProducts(recycle_images, recycle_images, candidate_g, true);
+                            CopyUpperToLower(mRecycleSpace.size(), candidate_g);
+                        }
+                    } else {
+                        mRecycleSpace.clear();
+                        recycle_images.clear();
+                        candidate_f.clear();
+                    }
+                }
+                const std::size_t k = mRecycleSpace.size();
+                std::vector<double> coefficients(k);
+
+                VectorType r(size);
+                this->PreconditionedMult(rA, rX, r);
+                TSparseSpaceType::ScaleAndAdd(1.0, rB, -1.0, r);
+
+                // 初值修正 x += W E⁻¹ Wᵀr，r -= AW E⁻¹ Wᵀr
+                if(k > 0){
+                    UpdateResidualAndProject(0.0, r, r, mRecycleSpace, coefficients);
+                    CholeskySolve(k, coarse_matrix, coefficients);
+                    CorrectInitialGuess(coefficients, recycle_images, rX, r);
+                }
+
+                // 候选回收空间 U 及 AU，初始为 W 与 AW
+                std::vector<VectorType> candidate(mRecycleSpace);
+                std::vector<VectorType> candidate_images(recycle_images);
+                std::vector<VectorType> directions;
+                std::vector<VectorType> direction_images;
+                std::vector<double> direction_curvatures;
+                const std::size_t cycle_length = (mRecycleSpaceDimension > 0) ? mRecycleDirections : 0;
+                directions.reserve(cycle_length);
+                direction_images.reserve(cycle_length);
+                direction_curvatures.reserve(cycle_length);
+                unsigned int num_cycles = 0;
+
+                // p0 = r0 - W E⁻¹ (AW)ᵀr0
+                double roh0 = UpdateResidualAndProject(0.0, r, r, recycle_images, coefficients);
+                CholeskySolve(k, coarse_matrix, coefficients);
+                VectorType p(size);
+                TSparseSpaceType::SetToZero(p);
+                UpdateSolutionAndDirection(0.0, 0.0, coefficients, r, p, rX);
+                VectorType q(size);
+
+                BaseType::mResidualNorm = std::sqrt(roh0);
+
+                while(std::abs(roh0) >= 1.0e-30 && BaseType::IterationNeeded()){
+                    this->PreconditionedMult(rA, p, q);
+
+                    const double pq = TSparseSpaceType::Dot(p, q);
+                    if(std::abs(pq) < 1.0e-30)
+                        break;
+
+                    if(cycle_length > 0 && (mRecycleCycles == 0 || num_cycles < mRecycleCycles)){
+                        directions.push_back(p);
+                        direction_images.push_back(q);
+                        direction_curvatures.push_back(pq);
+                        if(directions.size() == cycle_length){
+                            UpdateCandidateSpace(candidate, candidate_images, candidate_f, candidate_g, directions, direction_images, direction_curvatures);
+                            ++num_cycles;
+                        }
+                    }
+
+                    const double alpha = roh0 / pq;
+                    const double roh1 = UpdateResidualAndProject(alpha, q, r, recycle_images, coefficients);
+                    CholeskySolve(k, coarse_matrix, coefficients);
+                    UpdateSolutionAndDirection(alpha, roh1 / roh0, coefficients, r, p, rX);
+
+                    roh0 = roh1;
+                    BaseType::mResidualNorm = std::sqrt(roh1);
+                    BaseType::mIterationsNumber++;
+                }
+
+                if(cycle_length > 0){
+                    if(!directions.empty()){
+                        UpdateCandidateSpace(candidate, candidate_images, candidate_f, candidate_g, directions, direction_images, direction_curvatures);
+                    }
+                    mRecycleSpace.swap(candidate);
+                }
+
+                return BaseType::IsConverged();
+            }
+
+
+            /**
+             * @brief 由 Z = [U P]、AZ = [AU AP] 计算调和 Ritz 向量，取最小的 k 个作为新的 U 与 AU，并清空 P 与 AP
+             * @details F = ZᵀAZ 与 G = (AZ)ᵀAZ 按块组装：UᵀAU、(AU)ᵀAU 由上一次更新得到（rCandidateF、rCandidateG），
+             *  PᵀAP 取 CG 方向共轭性给出的对角阵 diag(pᵀAp)，只有 UᵀAP、(AU)ᵀAP 与 (AP)ᵀAP 需要内积，合并为两次遍历。
+             *  先对 F 做特征分解并舍去数值上线性相关的方向，在 F 正交的基上化为标准对称特征问题；
+             *  新向量 F 正交，按 U 的列归一化后 UᵀAU 与 (AU)ᵀAU 均为对角阵
+             */
+            void UpdateCandidateSpace(
+                std::vector<VectorType>& rCandidate,
+                std::vector<VectorType>& rCandidateImages,
+                std::vector<double>& rCandidateF,
+                std::vector<double>& rCandidateG,
+                std::vector<VectorType>& rDirections,
+                std::vector<VectorType>& rDirectionImages,
+                std::vector<double>& rDirectionCurvatures
+            ){
+                const std::size_t num_candidate = rCandidate.size();
+                const std::size_t num_directions = rDirections.size();
+                const std::size_t count = num_candidate + num_directions;
+
+                // UᵀAP 与 (AU)ᵀAP 一次遍历，(AP)ᵀAP 一次遍历
+                std::vector<double> cross;
+                std::vector<double> direction_g;
+                if(num_candidate > 0){
+                    std::vector<VectorType> left;
+                    left.reserve(2 * num_candidate);
+                    for(std::size_t j=0; j<num_candidate; ++j){
+                        left.push_back(std::move(rCandidate[j]));
+                    }
+                    for(std::size_t j=0; j<num_candidate; ++j){
+                        left.push_back(std::move(rCandidateImages[j]));
+                    }
+                    CrossProducts(left, rDirectionImages, cross);
+                    for(std::size_t j=0; j<num_candidate; ++j){
+                        rCandidate[j] = std::move(left[j]);
+                        rCandidateImages[j] = std::move(left[num_candidate + j]);
+                    }
+                }
+                CrossProducts(rDirectionImages, rDirectionImages, direction_g, true);
+                CopyUpperToLower(num_directions, direction_g);
+
+                std::vector<double> f(count * count, 0.0);
+                std::vector<double> g(count * count, 0.0);
+                for(std::size_t j=0; j<num_candidate; ++j){
+                    for(std::size_t i=0; i<num_candidate; ++i){
+                        f[i + j*count] = rCandidateF[i + j*num_candidate];
+                        g[i + j*count] = rCandidateG[i + j*num_candidate];
+                    }
+                }
+                for(std::size_t b=0; b<num_directions; ++b){
+                    const std::size_t j = num_candidate + b;
+                    for(std::size_t a=0; a<num_candidate; ++a){
+                        const double f_ab = cross[a + b*2*num_candidate];
+                        const double g_ab = cross[num_candidate + a + b*2*num_candidate];
+                        f[a + j*count] = f_ab;
+                        f[j + a*count] = f_ab;
+                        g[a + j*count] = g_ab;
+                        g[j + a*count] = g_ab;
+                    }
+                    f[j + j*count] = rDirectionCurvatures[b];
+                    for(std::size_t c=0; c<num_directions; ++c){
+                        g[num_candidate + c + j*count] = direction_g[c + b*num_directions];
+                    }
+                }
+
+                std::vector<VectorType> basis;
+                std::vector<VectorType> images;
+                basis.reserve(count);
+                images.reserve(count);
+                for(std::size_t j=0; j<num_candidate; ++j){
+                    basis.push_back(std::move(rCandidate[j]));
+                    images.push_back(std::move(rCandidateImages[j]));
+                }
+                for(std::size_t j=0; j<num_directions; ++j){
+                    basis.push_back(std::move(rDirections[j]));
+                    images.push_back(std::move(rDirectionImages[j]));
+                }
+                rCandidate.clear();
+                rCandidateImages.clear();
+                rCandidateF.clear();
+                rCandidateG.clear();
+                rDirections.clear();
+                rDirectionImages.clear();
+                rDirectionCurvatures.clear();
+
+                // F = V Λ Vᵀ，T = Λ^(-1/2) Vᵀ 只保留 λ > tol*λmax 的方向
+                std::vector<double> f_values;
+                std::vector<double> f_vectors;
+                SymmetricEigen(count, f, f_values, f_vectors);
+                const double f_max = *std::max_element(f_values.begin(), f_values.end());
+                if(!(f_max > 0.0))
+                    return;
+
+                std::vector<std::size_t> kept;
+                for(std::size_t j=0; j<count; ++j){
+                    if(f_values[j] > 1.0e-12 * f_max){
+                        kept.push_back(j);
+                    }
+                }
+                const std::size_t rank = kept.size();
+
+                std::vector<double> transform(rank * count);
+                for(std::size_t a=0; a<rank; ++a){
+                    const double scale = 1.0 / std::sqrt(f_values[kept[a]]);
+                    for(std::size_t i=0; i<count; ++i){
+                        transform[a + i*rank] = scale * f_vectors[i + kept[a]*count];
+                    }
+                }
+
+                // C = T G Tᵀ
+                std::vector<double> tg(rank * count, 0.0);
+                for(std::size_t j=0; j<count; ++j){
+                    for(std::size_t i=0; i<count; ++i){
+                        const double g_ij = g[i + j*count];
+                        for(std::size_t a=0; a<rank; ++a){
+                            tg[a + j*rank] += transform[a + i*rank] * g_ij;
+                        }
+                    }
+                }
+                std::vector<double> c(rank * rank, 0.0);
+                for(std::size_t b=0; b<rank; ++b){
+                    for(std::size_t j=0; j<count; ++j){
+                        const double t_bj = transform[b + j*rank];
+                        for(std::size_t a=0; a<rank; ++a){
+                            c[a + b*rank] += tg[a + j*rank] * t_bj;
+                        }
+                    }
+                }
+                Symmetrize(rank, c);
+
+                std::vector<double> theta;
+                std::vector<double> u;
+                SymmetricEigen(rank, c, theta, u);
+
+                std::vector<std::size_t> order(rank);
+                std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [&theta](const std::size_t a, const std::size_t b){
+                    return theta[a] < theta[b];
+                });
+
+                // Y = Tᵀ U_k，新的 W = Z Y（各列归一化）
+                const std::size_t new_dimension = std::min<std::size_t>(mRecycleSpaceDimension, rank);
+                std::vector<double> y(count * new_dimension, 0.0);
+                for(std::size_t j=0; j<new_dimension; ++j){
+                    const double* p_u = u.data() + order[j]*rank;
+                    for(std::size_t i=0; i<count; ++i){
+                        double sum = 0.0;
+                        for(std::size_t a=0; a<rank; ++a){
+                            sum += transform[a + i*rank] * p_u[a];
+                        }
+                        y[i + j*count] = sum;
+                    }
+                }
+
+                const std::size_t size = basis[0].size();
+                rCandidate.assign(new_dimension, VectorType(size));
+                rCandidateImages.assign(new_dimension, VectorType(size));
+                CombineBasis(basis, y, rCandidate);
+                CombineBasis(images, y, rCandidateImages);
+
+                // YᵀFY = I，YᵀGY = diag(θ)，归一化后只需按列缩放
+                rCandidateF.assign(new_dimension * new_dimension, 0.0);
+                rCandidateG.assign(new_dimension * new_dimension, 0.0);
+                for(std::size_t j=0; j<new_dimension; ++j){
+                    const double norm = TSparseSpaceType::TwoNorm(rCandidate[j]);
+                    const double scale = (norm > 0.0) ? 1.0/norm : 1.0;
+                    if(norm > 0.0){
+                        TSparseSpaceType::Assign(rCandidate[j], scale, rCandidate[j]);
+                        TSparseSpaceType::Assign(rCandidateImages[j], scale, rCandidateImages[j]);
+                    }
+                    rCandidateF[j + j*new_dimension] = scale * scale;
+                    rCandidateG[j + j*new_dimension] = scale * scale * theta[order[j]];
+                }
+            }
+
+
+            /**
+             * @brief r -= α*q，并计算 rCoefficients[j] = (rVectors[j], r) 与 (r, r)，一次遍历
+             * @details 按 RowBlockSize 行分块，线程内累加后合并；α = 0 时只做投影
+             */
+            static double UpdateResidualAndProject(
+                const double Alpha,
+                const VectorType& rQ,
+                VectorType& rR,
+                const std::vector<VectorType>& rVectors,
+                std::vector<double>& rCoefficients
+            ){
+                const std::size_t count = rVectors.size();
+                const std::size_t size = rR.size();
+                const int num_blocks = static_cast<int>((size + RowBlockSize - 1) / RowBlockSize);
+
+                std::fill(rCoefficients.begin(), rCoefficients.end(), 0.0);
+                double norm_squared = 0.0;
+
+                #pragma omp parallel
+                {
+                    std::vector<double> local(count, 0.0);
+                    double local_norm = 0.0;
+
+                    #pragma omp for nowait
+                    for(int block = 0; block < num_blocks; ++block){
+                        const std::size_t begin = static_cast<std::size_t>(block) * RowBlockSize;
+                        const std::size_t end = std::min(begin + RowBlockSize, size);
+                        if(Alpha != 0.0){
+                            for(std::size_t i=begin; i<end; ++i){
+                                rR[i] -= Alpha * rQ[i];
+                            }
+                        }
+                        for(std::size_t i=begin; i<end; ++i){
+                            local_norm += rR[i] * rR[i];
+                        }
+                        for(std::size_t j=0; j<count; ++j){
+                            const VectorType& r_vector = rVectors[j];
+                            double sum = 0.0;
+                            for(std::size_t i=begin; i<end; ++i){
+                                sum += r_vector[i] * rR[i];
+                            }
+                            local[j] += sum;
+                        }
+                    }
+
+                    #pragma omp critical
+                    {
+                        norm_squared += local_norm;
+                        for(std::size_t j=0; j<count; ++j){
+                            rCoefficients[j] += local[j];
+                        }
+                    }
+                }
+
+                return norm_squared;
+            }
+
+
+            /**
+             * @brief x += α*p，随后 p = r + β*p - W*μ，一次遍历
+             */
+            void UpdateSolutionAndDirection(const double Alpha, const double Beta, const std::vector<double>& rMu, const VectorType& rR, VectorType& rP, VectorType& rX) const{
+                const int size = static_cast<int>(rR.size());
+                const std::size_t count = rMu.size();
+
+                #pragma omp parallel for firstprivate(size)
+                for(int i = 0; i < size; i++){
+                    const double p = rP[i];
+                    rX[i] += Alpha * p;
+                    double value = rR[i] + Beta * p;
+                    for(std::size_t j=0; j<count; ++j){
+                        value -= mRecycleSpace[j][i] * rMu[j];
+                    }
+                    rP[i] = value;
+                }
+            }
+
+
+            /**
+             * @brief x += W*c，r -= AW*c，一次遍历
+             */
+            void CorrectInitialGuess(const std::vector<double>& rC, const std::vector<VectorType>& rImages, VectorType& rX, VectorType& rR) const{
+                const int size = static_cast<int>(rR.size());
+                const std::size_t count = rC.size();
+
+                #pragma omp parallel for firstprivate(size)
+                for(int i = 0; i < size; i++){
+                    double x = rX[i];
+                    double r = rR[i];
+                    for(std::size_t j=0; j<count; ++j){
+                        x += mRecycleSpace[j][i] * rC[j];
+                        r -= rImages[j][i] * rC[j];
+                    }
+                    rX[i] = x;
+                    rR[i] = r;
+                }
+            }
+
+
+            /**
+             * @brief rResult(a,b) = (rLeft[a], rRight[b])（列主序），按行分块一次遍历
+             * @details UpperOnly 为 true 时（rLeft 与 rRight 相同）只计算 a <= b 的部分，结果需再经 Symmetrize 补全
+             */
+            static void CrossProducts(const std::vector<VectorType>& rLeft, const std::vector<VectorType>& rRight, std::vector<double>& rResult, const bool UpperOnly = false){
+                const std::size_t rows = rLeft.size();
+                const std::size_t cols = rRight.size();
+                const std::size_t size = rLeft[0].size();
+                const int num_blocks = static_cast<int>((size + RowBlockSize - 1) / RowBlockSize);
+
+                rResult.assign(rows * cols, 0.0);
+
+                #pragma omp parallel
+                {
+                    std::vector<double> local(rows * cols, 0.0);
+
+                    #pragma omp for nowait
+                    for(int block = 0; block < num_blocks; ++block){
+                        const std::size_t begin = static_cast<std::size_t>(block) * RowBlockSize;
+                        const std::size_t end = std::min(begin + RowBlockSize, size);
+                        for(std::size_t b=0; b<cols; ++b){
+                            const VectorType& r_right = rRight[b];
+                            const std::size_t last_row = UpperOnly ? std::min(b + 1, rows) : rows;
+                            for(std::size_t a=0; a<last_row; ++a){
+                                const VectorType& r_left = rLeft[a];
+                                double sum = 0.0;
+                                for(std::size_t i=begin; i<end; ++i){
+                                    sum += r_left[i] * r_right[i];
+                                }
+                                local[a + b*rows] += sum;
+                            }
+                        }
+                    }
+
+                    #pragma omp critical
+                    {
+                        for(std::size_t j=0; j<rows*cols; ++j){
+                            rResult[j] += local[j];
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief rOut[j] = Σ_i rBasis[i]*rY(i,j)，按行一次遍历
+             */
+            static void CombineBasis(const std::vector<VectorType>& rBasis, const std::vector<double>& rY, std::vector<VectorType>& rOut){
+                const int size = static_cast<int>(rBasis[0].size());
+                const std::size_t count = rBasis.size();
+                const std::size_t num_out = rOut.size();
+
+                #pragma omp parallel for firstprivate(size)
+                for(int i = 0; i < size; i++){
+                    for(std::size_t j=0; j<num_out; ++j){
+                        double sum = 0.0;
+                        for(std::size_t a=0; a<count; ++a){
+                            sum += rBasis[a][i] * rY[a + j*count];
+                        }
+                        rOut[j][i] = sum;
+                    }
+                }
+            }
+
+
+            /**
+             * @brief M = (M + Mᵀ)/2
+             */
+            static void Symmetrize(const std::size_t N, std::vector<double>& rM){
+                for(std::size_t j=0; j<N; ++j){
+                    for(std::size_t i=j+1; i<N; ++i){
+                        const double value = 0.5 * (rM[i + j*N] + rM[j + i*N]);
+                        rM[i + j*N] = value;
+                        rM[j + i*N] = value;
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 由上三角部分补全对称矩阵
+             */
+            static void CopyUpperToLower(const std::size_t N, std::vector<double>& rM){
+                for(std::size_t j=0; j<N; ++j){
+                    for(std::size_t i=j+1; i<N; ++i){
+                        rM[i + j*N] = rM[j + i*N];
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 小规模对称正定矩阵的原位 Cholesky 分解（下三角），不正定时返回 false
+             */
+            static bool CholeskyFactorize(const std::size_t N, std::vector<double>& rM){
+                for(std::size_t j=0; j<N; ++j){
+                    double d = rM[j + j*N];
+                    for(std::size_t t=0; t<j; ++t){
+                        d -= rM[j + t*N] * rM[j + t*N];
+                    }
+                    if(!(d > 0.0))
+                        return false;
+                    d = std::sqrt(d);
+                    rM[j + j*N] = d;
+                    for(std::size_t i=j+1; i<N; ++i){
+                        double value = rM[i + j*N];
+                        for(std::size_t t=0; t<j; ++t){
+                            value -= rM[i + t*N] * rM[j + t*N];
+                        }
+                        rM[i + j*N] = value / d;
+                    }
+                }
+                return true;
+            }
+
+
+            /**
+             * @brief 以 Cholesky 因子求解 L Lᵀ y = rB，结果覆盖 rB
+             */
+            static void CholeskySolve(const std::size_t N, const std::vector<double>& rL, std::vector<double>& rB){
+                for(std::size_t i=0; i<N; ++i){
+                    double value = rB[i];
+                    for(std::size_t t=0; t<i; ++t){
+                        value -= rL[i + t*N] * rB[t];
+                    }
+                    rB[i] = value / rL[i + i*N];
+                }
+                for(std::size_t i=N; i-->0;){
+                    double value = rB[i];
+                    for(std::size_t t=i+1; t<N; ++t){
+                        value -= rL[t + i*N] * rB[t];
+                    }
+                    rB[i] = value / rL[i + i*N];
+                }
+            }
+
+
+            /**
+             * @brief 小规模对称矩阵的循环 Jacobi 特征分解，rVectors 的第 j 列为 rValues[j] 对应的特征向量
+             */
+            static void SymmetricEigen(const std::size_t N, std::vector<double> M, std::vector<double>& rValues, std::vector<double>& rVectors){
+                rVectors.assign(N * N, 0.0);
+                for(std::size_t i=0; i<N; ++i){
+                    rVectors[i + i*N] = 1.0;
+                }
+
+                double norm = 0.0;
+                for(const double value : M){
+                    norm += value * value;
+                }
+                const double threshold = 1.0e-30 * norm;
+
+                for(int sweep = 0; sweep < 100; ++sweep){
+                    double off = 0.0;
+                    for(std::size_t j=0; j<N; ++j){
+                        for(std::size_t i=j+1; i<N; ++i){
+                            off += M[i + j*N] * M[i + j*N];
+                        }
+                    }
+                    if(off <= threshold)
+                        break;
+
+                    for(std::size_t p=0; p<N; ++p){
+                        for(std::size_t q=p+1; q<N; ++q){
+                            const double m_pq = M[p + q*N];
+                            if(m_pq == 0.0)
+                                continue;
+
+                            const double tau = (M[q + q*N] - M[p + p*N]) / (2.0 * m_pq);
+                            const double t = (tau >= 0.0 ? 1.0 : -1.0) / (std::abs(tau) + std::sqrt(1.0 + tau*tau));
+                            const double c = 1.0 / std::sqrt(1.0 + t*t);
+                            const double s = t * c;
+
+                            for(std::size_t k=0; k<N; ++k){
+                                const double m_kp = M[k + p*N];
+                                const double m_kq = M[k + q*N];
+                                M[k + p*N] = c*m_kp - s*m_kq;
+                                M[k + q*N] = s*m_kp + c*m_kq;
+                            }
+                            for(std::size_t k=0; k<N; ++k){
+                                const double m_pk = M[p + k*N];
+                                const double m_qk = M[q + k*N];
+                                M[p + k*N] = c*m_pk - s*m_qk;
+                                M[q + k*N] = s*m_pk + c*m_qk;
+                            }
+                            for(std::size_t k=0; k<N; ++k){
+                                const double v_kp = rVectors[k + p*N];
+                                const double v_kq = rVectors[k + q*N];
+                                rVectors[k + p*N] = c*v_kp - s*v_kq;
+                                rVectors[k + q*N] = s*v_kp + c*v_kq;
+                            }
+                        }
+                    }
+                }
+
+                rValues.resize(N);
+                for(std::size_t i=0; i<N; ++i){
+                    rValues[i] = M[i + i*N];
+                }
+            }
+
+        private:
+            /**
+             * @brief 内积按行分块的块大小
+             */
+            static constexpr std::size_t RowBlockSize = 256;
+
+            /**
+             * @brief 回收向量个数 k
+             */
+            unsigned int mRecycleSpaceDimension = 8;
+
+            /**
+             * @brief 每段保存的搜索方向个数 ℓ
+             */
+            unsigned int mRecycleDirections = 16;
+
+            /**
+             * @brief 每次求解最多更新候选空间的段数，0 表示不限
+             */
+            unsigned int mRecycleCycles = 4;
+
+            /**
+             * @brief 回收空间 W（预处理后的变量空间中）
+             */
+            std::vector<VectorType> mRecycleSpace;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, RecyclingCGSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TPreconditionerType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const RecyclingCGSolver<TSparseSpaceType, TDenseSpaceType, TPreconditionerType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_RECYCLING_CG_SOLVER_HPP
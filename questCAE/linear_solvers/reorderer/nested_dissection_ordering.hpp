@@ -0,0 +1,318 @@
+#ifndef QUEST_NESTED_DISSECTION_ORDERING_HPP
+#define QUEST_NESTED_DISSECTION_ORDERING_HPP
+
+// 系统头文件
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+// 项目头文件
+#include "includes/define.hpp"
+
+namespace Quest{
+
+    /**
+     * @class NestedDissectionOrdering
+     * @brief 稀疏对称矩阵的嵌套剖分排序
+     * @details 对矩阵的邻接图递归二分：在子图中以伪外围点为根做广度优先搜索得到层次结构，
+     *  选取两侧规模均衡且自身最小的一层作为顶点分隔集，并把不与下一层相邻的分隔点移回前一侧以缩小分隔集。
+     *  两侧子图先于分隔集编号，分隔集排在最后，因此分解时两侧互不产生填充，消去树也随之平衡，便于按子树并行。
+     *  子图不连通时各连通分量分别处理；规模不超过 LeafSize 的子图按原编号顺序排列。
+     *  排序只在稀疏模式变化时计算一次，按子图串行进行
+     */
+    class NestedDissectionOrdering{
+        public:
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+
+        public:
+            /**
+             * @brief 计算嵌套剖分排序
+             * @param Size 矩阵阶数
+             * @param rRowIndices CSR 行指针（Size+1 个）
+             * @param rColIndices CSR 列号，结构不对称时按 A+AT 的结构处理
+             * @param rPermutation 输出，rPermutation[新编号] = 原编号
+             * @param LeafSize 不再剖分的子图规模
+             */
+            template<typename TRowIndices, typename TColIndices>
+            static void Compute(
+                const IndexType Size,
+                const TRowIndices& rRowIndices,
+                const TColIndices& rColIndices,
+                IndexVectorType& rPermutation,
+                const IndexType LeafSize = 64
+            ){
+                IndexVectorType adjacency_pointers;
+                IndexVectorType adjacency;
+                BuildSymmetricGraph(Size, rRowIndices, rColIndices, adjacency_pointers, adjacency);
+
+                rPermutation.assign(Size, 0);
+                if(Size == 0){
+                    return;
+                }
+
+                IndexVectorType stamp(Size, NoStamp);
+                IndexVectorType level(Size, 0);
+                IndexVectorType queue;
+                queue.reserve(Size);
+
+                struct Task{
+                    IndexVectorType Vertices;
+                    IndexType FirstPosition;
+                };
+                std::vector<Task> tasks;
+                tasks.push_back({IndexVectorType(Size), 0});
+                std::iota(tasks.back().Vertices.begin(), tasks.back().Vertices.end(), 0);
+
+                IndexType current_stamp = 0;
+                while(!tasks.empty()){
+                    Task task = std::move(tasks.back());
+                    tasks.pop_back();
+                    IndexVectorType& r_vertices = task.Vertices;
+                    const IndexType count = r_vertices.size();
+
+                    if(count <= LeafSize){
+                        std::sort(r_vertices.begin(), r_vertices.end());
+                        std::copy(r_vertices.begin(), r_vertices.end(), rPermutation.begin() + task.FirstPosition);
+                        continue;
+                    }
+
+                    // 标记子图，子图外的顶点在搜索中被忽略
+                    const IndexType subset_stamp = current_stamp++;
+                    for(const IndexType v : r_vertices){
+                        stamp[v] = subset_stamp;
+                    }
+
+                    // 不连通时把第一个连通分量与其余部分拆开
+                    const IndexType visit_stamp = current_stamp++;
+                    BreadthFirstSearch(r_vertices[0], subset_stamp, visit_stamp, adjacency_pointers, adjacency, stamp, level, queue);
+                    if(queue.size() < count){
+                        IndexVectorType rest;
+                        rest.reserve(count - queue.size());
+                        for(const IndexType v : r_vertices){
+                            if(stamp[v] != visit_stamp){
+                                rest.push_back(v);
+                            }
+                        }
+                        IndexVectorType component(queue.begin(), queue.end());
+                        const IndexType component_size = component.size();
+                        tasks.push_back({std::move(component), task.FirstPosition});
+                        tasks.push_back({std::move(rest), task.FirstPosition + component_size});
+                        continue;
+                    }
+
+                    // 伪外围点：反复从最后一层中度数最小的点重新搜索，直到层数不再增加
+                    IndexType root = r_vertices[0];
+                    IndexType num_levels = level[queue.back()] + 1;
+                    for(int sweep = 0; sweep < 5; ++sweep){
+                        const IndexType candidate = MinimumDegreeInLastLevel(queue, level, adjacency_pointers);
+                        const IndexType search_stamp = current_stamp++;
+                        for(const IndexType v : r_vertices){
+                            stamp[v] = subset_stamp;
+                        }
+                        BreadthFirstSearch(candidate, subset_stamp, search_stamp, adjacency_pointers, adjacency, stamp, level, queue);
+                        const IndexType candidate_levels = level[queue.back()] + 1;
+                        if(candidate_levels <= num_levels && sweep > 0){
+                            break;
+                        }
+                        root = candidate;
+                        num_levels = candidate_levels;
+                    }
+                    for(const IndexType v : r_vertices){
+                        stamp[v] = subset_stamp;
+                    }
+                    const IndexType final_stamp = current_stamp++;
+                    BreadthFirstSearch(root, subset_stamp, final_stamp, adjacency_pointers, adjacency, stamp, level, queue);
+                    num_levels = level[queue.back()] + 1;
+
+                    // 层数过少（接近稠密）时不再剖分
+                    if(num_levels < 3){
+                        std::sort(r_vertices.begin(), r_vertices.end());
+                        std::copy(r_vertices.begin(), r_vertices.end(), rPermutation.begin() + task.FirstPosition);
+                        continue;
+                    }
+
+                    const IndexType separator_level = ChooseSeparatorLevel(queue, level, num_levels);
+
+                    // 分隔层中不与下一层相邻的点移入前一侧
+                    IndexVectorType part_a;
+                    IndexVectorType part_b;
+                    IndexVectorType separator;
+                    for(const IndexType v : queue){
+                        const IndexType l = level[v];
+                        if(l < separator_level){
+                            part_a.push_back(v);
+                        } else if(l > separator_level){
+                            part_b.push_back(v);
+                        } else {
+                            bool touches_next = false;
+                            for(IndexType k=adjacency_pointers[v]; k<adjacency_pointers[v+1]; ++k){
+                                const IndexType w = adjacency[k];
+                                if(stamp[w] == final_stamp && level[w] == separator_level + 1){
+                                    touches_next = true;
+                                    break;
+                                }
+                            }
+                            if(touches_next){
+                                separator.push_back(v);
+                            } else {
+                                part_a.push_back(v);
+                            }
+                        }
+                    }
+
+                    std::sort(separator.begin(), separator.end());
+                    const IndexType separator_position = task.FirstPosition + part_a.size() + part_b.size();
+                    std::copy(separator.begin(), separator.end(), rPermutation.begin() + separator_position);
+
+                    const IndexType part_a_size = part_a.size();
+                    if(!part_a.empty()){
+                        tasks.push_back({std::move(part_a), task.FirstPosition});
+                    }
+                    if(!part_b.empty()){
+                        tasks.push_back({std::move(part_b), task.FirstPosition + part_a_size});
+                    }
+                }
+            }
+
+        private:
+            static constexpr IndexType NoStamp = std::numeric_limits<IndexType>::max();
+
+            /**
+             * @brief 由 CSR 结构构造 A+AT 的邻接表（去掉对角元，每行升序且无重复）
+             */
+            template<typename TRowIndices, typename TColIndices>
+            static void BuildSymmetricGraph(
+                const IndexType Size,
+                const TRowIndices& rRowIndices,
+                const TColIndices& rColIndices,
+                IndexVectorType& rPointers,
+                IndexVectorType& rAdjacency
+            ){
+                IndexVectorType degree(Size + 1, 0);
+                for(IndexType i=0; i<Size; ++i){
+                    for(IndexType k=rRowIndices[i]; k<static_cast<IndexType>(rRowIndices[i+1]); ++k){
+                        const IndexType j = rColIndices[k];
+                        if(j != i){
+                            ++degree[i];
+                            ++degree[j];
+                        }
+                    }
+                }
+
+                IndexVectorType fill(Size + 1, 0);
+                for(IndexType i=0; i<Size; ++i){
+                    fill[i+1] = fill[i] + degree[i];
+                }
+                IndexVectorType raw(fill[Size]);
+                IndexVectorType position(fill.begin(), fill.end() - 1);
+                for(IndexType i=0; i<Size; ++i){
+                    for(IndexType k=rRowIndices[i]; k<static_cast<IndexType>(rRowIndices[i+1]); ++k){
+                        const IndexType j = rColIndices[k];
+                        if(j != i){
+                            raw[position[i]++] = j;
+                            raw[position[j]++] = i;
+                        }
+                    }
+                }
+
+                rPointers.assign(Size + 1, 0);
+                rAdjacency.clear();
+                rAdjacency.reserve(raw.size() / 2);
+                for(IndexType i=0; i<Size; ++i){
+                    auto it_begin = raw.begin() + fill[i];
+                    auto it_end = raw.begin() + fill[i+1];
+                    std::sort(it_begin, it_end);
+                    it_end = std::unique(it_begin, it_end);
+                    rAdjacency.insert(rAdjacency.end(), it_begin, it_end);
+                    rPointers[i+1] = rAdjacency.size();
+                }
+            }
+
+            /**
+             * @brief 在 stamp == SubsetStamp 的顶点中从 Root 做广度优先搜索
+             * @details 访问过的顶点 stamp 置为 VisitStamp 并记录层号，rQueue 按访问顺序保存这些顶点
+             */
+            static void BreadthFirstSearch(
+                const IndexType Root,
+                const IndexType SubsetStamp,
+                const IndexType VisitStamp,
+                const IndexVectorType& rPointers,
+                const IndexVectorType& rAdjacency,
+                IndexVectorType& rStamp,
+                IndexVectorType& rLevel,
+                IndexVectorType& rQueue
+            ){
+                rQueue.clear();
+                rQueue.push_back(Root);
+                rStamp[Root] = VisitStamp;
+                rLevel[Root] = 0;
+                for(IndexType head = 0; head < rQueue.size(); ++head){
+                    const IndexType v = rQueue[head];
+                    for(IndexType k=rPointers[v]; k<rPointers[v+1]; ++k){
+                        const IndexType w = rAdjacency[k];
+                        if(rStamp[w] == SubsetStamp){
+                            rStamp[w] = VisitStamp;
+                            rLevel[w] = rLevel[v] + 1;
+                            rQueue.push_back(w);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief 返回最后一层中度数最小的顶点
+             */
+            static IndexType MinimumDegreeInLastLevel(const IndexVectorType& rQueue, const IndexVectorType& rLevel, const IndexVectorType& rPointers){
+                const IndexType last_level = rLevel[rQueue.back()];
+                IndexType best = rQueue.back();
+                IndexType best_degree = std::numeric_limits<IndexType>::max();
+                for(IndexType k=rQueue.size(); k-->0;){
+                    const IndexType v = rQueue[k];
+                    if(rLevel[v] != last_level){
+                        break;
+                    }
+                    const IndexType degree = rPointers[v+1] - rPointers[v];
+                    if(degree < best_degree){
+                        best_degree = degree;
+                        best = v;
+                    }
+                }
+                return best;
+            }
+
+            /**
+             * @brief 选择分隔层：在两侧规模都不小于其余顶点 1/3 的层中取顶点最少者，没有这样的层时取中位层
+             */
+            static IndexType ChooseSeparatorLevel(const IndexVectorType& rQueue, const IndexVectorType& rLevel, const IndexType NumLevels){
+                IndexVectorType level_sizes(NumLevels, 0);
+                for(const IndexType v : rQueue){
+                    ++level_sizes[rLevel[v]];
+                }
+
+                const IndexType total = rQueue.size();
+                IndexType best = 0;
+                IndexType best_size = std::numeric_limits<IndexType>::max();
+                IndexType median = 1;
+                IndexType before = level_sizes[0];
+                for(IndexType l=1; l+1<NumLevels; ++l){
+                    const IndexType after = total - before - level_sizes[l];
+                    const IndexType rest = before + after;
+                    if(3*before >= rest && 3*after >= rest && level_sizes[l] < best_size){
+                        best = l;
+                        best_size = level_sizes[l];
+                    }
+                    if(2*before < total){
+                        median = l;
+                    }
+                    before += level_sizes[l];
+                }
+                return best_size == std::numeric_limits<IndexType>::max() ? median : best;
+            }
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_NESTED_DISSECTION_ORDERING_HPP
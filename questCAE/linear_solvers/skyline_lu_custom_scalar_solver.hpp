@@ -6,13 +6,14 @@
 #include <complex>
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 
 // 第三方头文件
 #include <memory>
 #include <amgcl/backend/builtin.hpp>
 #include <amgcl/adapter/zero_copy.hpp>
 #include <amgcl/value_type/complex.hpp>
-#include <amgcl/solver/skyline_lu.hpp>
+#include <amgcl/reorder/cuthill_mckee.hpp>
 
 // 项目头文件
 #include "includes/define.hpp"
@@ -22,6 +23,16 @@
 
 namespace Quest{
 
+    /**
+     * @class SkylineLUCustomScalarSolver
+     * @brief 任意标量类型（含复数）的 Skyline LU 直接求解器
+     * @details 分为符号分解与数值分解两个阶段：符号分解计算 Cuthill-McKee 排序、Skyline 轮廓以及 A 的每个非零元
+     *  在 Skyline 存储中的位置；数值分解把 A 的值散布到轮廓中并以 Crout 算法原位分解。
+     *  符号分解按稀疏模式（阶数、非零元个数与索引数组的散列）缓存，模式不变时只重做数值分解，
+     *  轮廓按稀疏模式而非非零值确定，因此数值变化后的显式零元不会落在轮廓之外。
+     *  每次 InitializeSolutionStep 都重做数值分解；LHS 未更新时是否沿用已有分解由构建器的
+     *  ReuseFactorization 标志决定（见 BuilderAndSolver::InternalSystemSolve），此时构建器只调用 PerformSolutionStep
+     */
     template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
     class SkylineLUCustomScalarSolver : public DirectSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>{
         public:
@@ -31,8 +42,8 @@ namespace Quest{
             using VectorType = typename TSparseSpaceType::VectorType;
             using DenseMatrixType = typename TDenseSpaceType::MatrixType;
             using DataType = typename TSparseSpaceType::DataType;
-            using BuiltinMatrixType = typename amgcl::backend::builtin<DataType>::matrix;
-            using SolverType = amgcl::solver::skyline_lu<DataType>;
+            using IndexType = std::size_t;
+            using OrderingType = amgcl::reorder::cuthill_mckee<false>;
 
         public:
             /**
@@ -46,7 +57,13 @@ namespace Quest{
              */
             SkylineLUCustomScalarSolver(Parameters& rParam):
                 DirectSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>(rParam)
-            {}
+            {
+                Parameters default_parameters(R"({
+                    "solver_type": "skyline_lu_complex",
+                    "scaling": false
+                })");
+                rParam.ValidateAndAssignDefaults(default_parameters);
+            }
 
 
             /**
@@ -58,18 +75,14 @@ namespace Quest{
 
             /**
              * @brief 初始化求解步
+             * @details 稀疏模式变化时重新进行符号分解；模式不变时只重做数值分解
              */
             void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
-                Clear();
+                if(!IsSymbolicFactorizationValid(rA)){
+                    SymbolicFactorization(rA);
+                }
 
-                pBuiltinMatrix = amgcl::adapter::zero_copy(
-                    rA.size1(),
-                    rA.index1_data().begin(),
-                    rA.index2_data().begin(),
-                    rA.value_data().begin()
-                );
-
-                pSolver = std::make_shared<SolverType>(*pBuiltinMatrix);
+                NumericFactorization(rA);
             }
 
 
@@ -77,14 +90,35 @@ namespace Quest{
              * @brief 执行当前求解步
              */
             void PerformSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
-                std::vector<DataType> x(rX.size());
-                std::vector<DataType> b(rB.size());
-
-                std::copy(std::begin(rB), std::end(rB), std::begin(b));
-
-                (*pSolver)(b, x);
-
-                std::copy(std::begin(x), std::end(x), std::begin(rX));
+                QUEST_ERROR_IF_NOT(mIsFactorized) << "SkylineLUCustomScalarSolver: InitializeSolutionStep must be called before PerformSolutionStep" << std::endl;
+
+                const IndexType size = mPermutation.size();
+                const DataType* p_lower = mFactorValues.data() + size;
+                const DataType* p_upper = p_lower + mProfilePointers[size];
+                const DataType* p_inverse_diagonal = mFactorValues.data();
+
+                // y = L^-1 * P*b
+                for(IndexType i=0; i<size; ++i){
+                    DataType sum = rB[mPermutation[i]];
+                    const IndexType first_column = i + mProfilePointers[i] - mProfilePointers[i+1];
+                    for(IndexType k=mProfilePointers[i], j=first_column; k<mProfilePointers[i+1]; ++k, ++j){
+                        sum -= p_lower[k] * mWork[j];
+                    }
+                    mWork[i] = p_inverse_diagonal[i] * sum;
+                }
+
+                // y = U^-1 * y
+                for(IndexType j=size; j-->0;){
+                    const DataType y_j = mWork[j];
+                    const IndexType first_row = j + mProfilePointers[j] - mProfilePointers[j+1];
+                    for(IndexType k=mProfilePointers[j], i=first_row; k<mProfilePointers[j+1]; ++k, ++i){
+                        mWork[i] -= p_upper[k] * y_j;
+                    }
+                }
+
+                for(IndexType i=0; i<size; ++i){
+                    rX[mPermutation[i]] = mWork[i];
+                }
             }
 
 
@@ -101,19 +135,49 @@ namespace Quest{
 
 
             /**
-             * @brief 结束求解步
+             * @brief 结束求解步，保留分解以便后续求解重用
              */
-            void FinalizeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
-                Clear();
-            }
+            void FinalizeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{}
 
 
             /**
-             * @brief 清空求解信息
+             * @brief 清空符号分解与数值分解
              */
             void Clear() override{
-                pSolver.reset();
-                pBuiltinMatrix.reset();
+                mIsSymbolicValid = false;
+                mIsFactorized = false;
+                mPatternSize = 0;
+                mPatternNonZeros = 0;
+                mPatternHash = 0;
+                std::vector<int>().swap(mPermutation);
+                std::vector<IndexType>().swap(mProfilePointers);
+                std::vector<IndexType>().swap(mScatterPositions);
+                std::vector<DataType>().swap(mFactorValues);
+                std::vector<DataType>().swap(mWork);
+            }
+
+
+            /**
+             * @brief 分解在 PerformSolutionStep 之间保留，可以沿用
+             */
+            bool FactorizationIsReusable() override{
+                return true;
+            }
+
+
+            /**
+             * @brief 返回符号分解的次数
+             */
+            std::size_t GetNumberOfSymbolicFactorizations() const{
+                return mNumberOfSymbolicFactorizations;
+            }
+
+
+            /**
+             * @brief 返回数值分解的次数
+             */
+            std::size_t GetNumberOfNumericFactorizations() const{
+                return mNumberOfNumericFactorizations;
             }
 
 
@@ -121,20 +185,230 @@ namespace Quest{
                 rOstream << "Skyline LU Custom Scalar Solver";
             }
 
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "profile size : " << (mProfilePointers.empty() ? 0 : mProfilePointers.back()) << std::endl;
+                rOstream << "symbolic factorizations : " << mNumberOfSymbolicFactorizations << " numeric factorizations : " << mNumberOfNumericFactorizations;
+            }
+
         protected:
 
         private:
+            /**
+             * @brief 以阶数、非零元个数与索引数组的散列判断稀疏模式是否与上次符号分解时相同
+             */
+            bool IsSymbolicFactorizationValid(const SparseMatrixType& rA) const{
+                return mIsSymbolicValid
+                    && mPatternSize == rA.size1()
+                    && mPatternNonZeros == static_cast<IndexType>(rA.index1_data()[rA.size1()])
+                    && mPatternHash == PatternHash(rA);
+            }
+
+
+            /**
+             * @brief 稀疏模式的 64 位 FNV-1a 散列
+             */
+            static std::uint64_t PatternHash(const SparseMatrixType& rA){
+                const IndexType size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                std::uint64_t hash = 14695981039346656037ULL;
+                auto mix = [&hash](const std::uint64_t Value){
+                    hash ^= Value;
+                    hash *= 1099511628211ULL;
+                };
+                for(IndexType i=0; i<=size; ++i){
+                    mix(static_cast<std::uint64_t>(r_row_indices[i]));
+                }
+                const IndexType nnz = r_row_indices[size];
+                for(IndexType k=0; k<nnz; ++k){
+                    mix(static_cast<std::uint64_t>(r_col_indices[k]));
+                }
+                return hash;
+            }
+
+
+            /**
+             * @brief 符号分解：排序、Skyline 轮廓，以及 A 的每个非零元在分解存储中的位置
+             * @details 分解存储依次为 D 的倒数（n 个）、L 的行轮廓与 U 的列轮廓，二者共用 mProfilePointers
+             */
+            void SymbolicFactorization(SparseMatrixType& rA){
+                const IndexType size = rA.size1();
+                QUEST_ERROR_IF(size != rA.size2()) << "SkylineLUCustomScalarSolver requires a square matrix, got " << size << "x" << rA.size2() << std::endl;
+
+                Clear();
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                const IndexType nnz = r_row_indices[size];
+
+                auto p_matrix = amgcl::adapter::zero_copy(
+                    size,
+                    rA.index1_data().begin(),
+                    rA.index2_data().begin(),
+                    rA.value_data().begin()
+                );
+                mPermutation.resize(size);
+                OrderingType::get(*p_matrix, mPermutation);
+
+                std::vector<IndexType> inverse(size);
+                for(IndexType i=0; i<size; ++i){
+                    inverse[mPermutation[i]] = i;
+                }
+
+                // 第 i 行 L 的长度与第 i 列 U 的高度取两者的最大值，使 L 与 U 共用同一轮廓
+                std::vector<IndexType> heights(size, 0);
+                for(IndexType r=0; r<size; ++r){
+                    const IndexType i = inverse[r];
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        const IndexType j = inverse[r_col_indices[k]];
+                        if(i > j){
+                            heights[i] = std::max(heights[i], i - j);
+                        } else if(i < j){
+                            heights[j] = std::max(heights[j], j - i);
+                        }
+                    }
+                }
+                mProfilePointers.assign(size + 1, 0);
+                for(IndexType i=0; i<size; ++i){
+                    mProfilePointers[i+1] = mProfilePointers[i] + heights[i];
+                }
+                const IndexType profile_size = mProfilePointers[size];
+
+                mScatterPositions.resize(nnz);
+                for(IndexType r=0; r<size; ++r){
+                    const IndexType i = inverse[r];
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        const IndexType j = inverse[r_col_indices[k]];
+                        if(i == j){
+                            mScatterPositions[k] = i;
+                        } else if(i > j){
+                            mScatterPositions[k] = size + mProfilePointers[i+1] + j - i;
+                        } else {
+                            mScatterPositions[k] = size + profile_size + mProfilePointers[j+1] + i - j;
+                        }
+                    }
+                }
+
+                mFactorValues.resize(size + 2*profile_size);
+                mWork.resize(size);
+
+                mPatternSize = size;
+                mPatternNonZeros = nnz;
+                mPatternHash = PatternHash(rA);
+                mIsSymbolicValid = true;
+                ++mNumberOfSymbolicFactorizations;
+            }
+
+
+            /**
+             * @brief 数值分解：散布 A 的值并以 Crout 算法原位分解，U 的对角元为 1，D 中存储主元的倒数
+             */
+            void NumericFactorization(SparseMatrixType& rA){
+                const IndexType size = mPermutation.size();
+                const auto& r_values = rA.value_data();
+                const IndexType nnz = mScatterPositions.size();
+
+                mIsFactorized = false;
+                std::fill(mFactorValues.begin(), mFactorValues.end(), DataType(0));
+                for(IndexType k=0; k<nnz; ++k){
+                    mFactorValues[mScatterPositions[k]] += r_values[k];
+                }
+                if(size == 0){
+                    mIsFactorized = true;
+                    ++mNumberOfNumericFactorizations;
+                    return;
+                }
+
+                const std::vector<IndexType>& ptr = mProfilePointers;
+                DataType* D = mFactorValues.data();
+                DataType* L = D + size;
+                DataType* U = L + ptr[size];
+
+                QUEST_ERROR_IF(D[0] == DataType(0)) << "SkylineLUCustomScalarSolver: zero pivot at row " << mPermutation[0] << std::endl;
+                D[0] = DataType(1) / D[0];
+
+                for(IndexType k=0; k+1<size; ++k){
+                    const IndexType begin = k + 1 + ptr[k+1] - ptr[k+2];
+
+                    // U 的第 k+1 列
+                    IndexType entry = ptr[k+1];
+                    for(IndexType i=begin; i<=k; ++entry, ++i){
+                        DataType sum = U[entry];
+                        const IndexType row_begin = i + ptr[i] - ptr[i+1];
+                        const IndexType mult_begin = std::max(begin, row_begin);
+                        IndexType index_l = ptr[i] + mult_begin - row_begin;
+                        IndexType index_u = ptr[k+1] + mult_begin - begin;
+                        for(IndexType j=mult_begin; j<i; ++j, ++index_l, ++index_u){
+                            sum -= L[index_l] * U[index_u];
+                        }
+                        U[entry] = D[i] * sum;
+                    }
+
+                    // L 的第 k+1 行
+                    entry = ptr[k+1];
+                    for(IndexType i=begin; i<=k; ++entry, ++i){
+                        DataType sum = L[entry];
+                        const IndexType column_begin = i + ptr[i] - ptr[i+1];
+                        const IndexType mult_begin = std::max(column_begin, begin);
+                        IndexType index_l = ptr[k+1] + mult_begin - begin;
+                        IndexType index_u = ptr[i] + mult_begin - column_begin;
+                        for(IndexType j=mult_begin; j<i; ++j, ++index_l, ++index_u){
+                            sum -= L[index_l] * U[index_u];
+                        }
+                        L[entry] = sum;
+                    }
+
+                    DataType pivot = D[k+1];
+                    for(IndexType j=ptr[k+1]; j<ptr[k+2]; ++j){
+                        pivot -= L[j] * U[j];
+                    }
+                    QUEST_ERROR_IF(pivot == DataType(0)) << "SkylineLUCustomScalarSolver: zero pivot at row " << mPermutation[k+1] << std::endl;
+                    D[k+1] = DataType(1) / pivot;
+                }
+
+                mIsFactorized = true;
+                ++mNumberOfNumericFactorizations;
+            }
 
         private:
             /**
-             * @brief 稀疏矩阵
+             * @brief 符号分解对应的稀疏模式
              */
-            Quest::shared_ptr<BuiltinMatrixType> pBuiltinMatrix;
+            bool mIsSymbolicValid = false;
+            IndexType mPatternSize = 0;
+            IndexType mPatternNonZeros = 0;
+            std::uint64_t mPatternHash = 0;
 
             /**
-             * @brief 求解器指针
+             * @brief 排序，mPermutation[新编号] = 原编号
              */
-            Quest::shared_ptr<SolverType> pSolver;
+            std::vector<int> mPermutation;
+
+            /**
+             * @brief L 的行轮廓与 U 的列轮廓的起始位置
+             */
+            std::vector<IndexType> mProfilePointers;
+
+            /**
+             * @brief A 的第 k 个非零元在 mFactorValues 中的位置
+             */
+            std::vector<IndexType> mScatterPositions;
+
+            /**
+             * @brief 分解存储：D 的倒数、L、U
+             */
+            std::vector<DataType> mFactorValues;
+
+            /**
+             * @brief 前代回代的工作向量
+             */
+            std::vector<DataType> mWork;
+
+            bool mIsFactorized = false;
+            std::size_t mNumberOfSymbolicFactorizations = 0;
+            std::size_t mNumberOfNumericFactorizations = 0;
 
     };
 
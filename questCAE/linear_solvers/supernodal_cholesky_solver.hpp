@@ -0,0 +1,1194 @@
+#ifndef QUEST_SUPERNODAL_CHOLESKY_SOLVER_HPP
+#define QUEST_SUPERNODAL_CHOLESKY_SOLVER_HPP
+
+// 系统头文件
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstdint>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/quest_parameters.hpp"
+#include "linear_solvers/direct_solver.hpp"
+#include "linear_solvers/reorderer/nested_dissection_ordering.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class SupernodalCholeskySolver
+     * @brief 对称矩阵的超节点 Cholesky（LLT）/ LDLT 直接求解器
+     * @details 分为符号分解与数值分解两个阶段：
+     *  符号分解计算嵌套剖分排序、消去树及其后序、超节点划分（相邻列结构相同或只差少量显式零元时合并，即松弛超节点）、
+     *  各超节点的行结构以及子节点更新矩阵到父节点波前的相对位置。结果按稀疏模式缓存，模式不变时
+     *  （如各时间步之间、模态分析的多次分解）只重新进行数值分解。
+     *  数值分解采用多波前法：按超节点消去树自叶向根逐层处理，同层超节点互不依赖；
+     *  同层超节点足够多时按超节点并行，靠近树根的少数大波前则在稠密核函数内部并行。
+     *  每个超节点把 A 的对应列与各子节点的更新矩阵组装成波前，对其前 nc 列做分块的稠密部分分解
+     *  （对角块分解、面板三角求解与 Schur 补更新均以按列分块的 BLAS-3 方式组织），剩余部分即交给父节点的更新矩阵。
+     *  前代与回代同样按层并行：前代时各超节点把对祖先行的贡献以向量形式交给父节点，回代只读取祖先的已知解。
+     *  LDLT 不选主元，适用于对称拟定矩阵（如带移位的 K - σM）；主元为零或（LLT 时）非正时报错。
+     *  只使用矩阵的一个三角部分的数值（A 可以完整存储，也可以只存储一个三角）。
+     *  分解与回代按空间的 DataType 存储和计算，以单精度空间实例化时可作为 MixedPrecisionRefinementSolver 的低精度分解
+     * @tparam TSparseSpaceType 稀疏空间类型
+     * @tparam TDenseSpaceType 稠密空间类型
+     * @tparam TReordererType 重排器类型
+     */
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType>>
+    class SupernodalCholeskySolver : public DirectSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(SupernodalCholeskySolver);
+
+            using BaseType = DirectSolver<TSparseSpaceType, TDenseSpaceType, TReordererType>;
+            using SparseMatrixType = typename TSparseSpaceType::MatrixType;
+            using VectorType = typename TSparseSpaceType::VectorType;
+            using DenseMatrixType = typename TDenseSpaceType::MatrixType;
+            using DataType = typename TSparseSpaceType::DataType;
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+
+            /**
+             * @brief 分解类型
+             */
+            enum class FactorizationType{
+                Cholesky,
+                LDLT
+            };
+
+            /**
+             * @brief 排序方式
+             */
+            enum class OrderingType{
+                NestedDissection,
+                Natural
+            };
+
+        public:
+            /**
+             * @brief 默认构造函数，Cholesky 分解，嵌套剖分排序
+             */
+            SupernodalCholeskySolver() {}
+
+
+            /**
+             * @brief 构造函数
+             */
+            explicit SupernodalCholeskySolver(
+                const FactorizationType Factorization,
+                const OrderingType Ordering = OrderingType::NestedDissection
+            ):
+                mFactorization(Factorization),
+                mOrdering(Ordering)
+            {}
+
+
+            /**
+             * @brief 构造函数
+             * @details 参数 "factorization_type" 取 "cholesky" 或 "ldlt"，"ordering" 取 "nested_dissection" 或 "natural"
+             */
+            SupernodalCholeskySolver(Parameters settings) : BaseType(){
+                QUEST_TRY
+
+                Parameters default_parameters(
+                    R"({
+                        "solver_type": "supernodal_cholesky",
+                        "factorization_type": "cholesky",
+                        "ordering": "nested_dissection",
+                        "scaling": false
+                    })"
+                );
+
+                settings.ValidateAndAssignDefaults(default_parameters);
+
+                const std::string factorization = settings["factorization_type"].GetString();
+                if(factorization == "cholesky"){
+                    mFactorization = FactorizationType::Cholesky;
+                } else if(factorization == "ldlt"){
+                    mFactorization = FactorizationType::LDLT;
+                } else {
+                    QUEST_ERROR << "Unknown factorization_type \"" << factorization << "\" for the supernodal Cholesky solver. Available: \"cholesky\", \"ldlt\"" << std::endl;
+                }
+
+                const std::string ordering = settings["ordering"].GetString();
+                if(ordering == "nested_dissection"){
+                    mOrdering = OrderingType::NestedDissection;
+                } else if(ordering == "natural"){
+                    mOrdering = OrderingType::Natural;
+                } else {
+                    QUEST_ERROR << "Unknown ordering \"" << ordering << "\" for the supernodal Cholesky solver. Available: \"nested_dissection\", \"natural\"" << std::endl;
+                }
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~SupernodalCholeskySolver() override{
+                Clear();
+            }
+
+
+            /**
+             * @brief 初始化求解步：稀疏模式变化时重新进行符号分解，随后进行数值分解
+             */
+            void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                Factorize(rA);
+            }
+
+
+            /**
+             * @brief 执行当前求解步：以已有的分解求解
+             */
+            void PerformSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                QUEST_ERROR_IF_NOT(mIsFactorized) << "The supernodal Cholesky solver has not been factorized, call InitializeSolutionStep first" << std::endl;
+                SolveFactorized(rB, rX);
+            }
+
+
+            /**
+             * @brief 结束求解步，保留分解以便重复求解
+             */
+            void FinalizeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{}
+
+
+            /**
+             * @brief 求解
+             */
+            bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                InitializeSolutionStep(rA, rX, rB);
+                PerformSolutionStep(rA, rX, rB);
+                FinalizeSolutionStep(rA, rX, rB);
+
+                return true;
+            }
+
+
+            /**
+             * @brief 分解在 PerformSolutionStep 之间保留，可以沿用
+             */
+            bool FactorizationIsReusable() override{
+                return true;
+            }
+
+
+            /**
+             * @brief 求解一组具有相同系数矩阵的线性系统，只分解一次
+             */
+            bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override{
+                Factorize(rA);
+
+                VectorType x(TDenseSpaceType::Size1(rX));
+                VectorType b(TDenseSpaceType::Size1(rB));
+                for(unsigned int i = 0; i < TDenseSpaceType::Size2(rX); i++){
+                    TDenseSpaceType::GetColumn(i,rB,b);
+                    SolveFactorized(b, x);
+                    TDenseSpaceType::SetColumn(i,rX,x);
+                }
+                return true;
+            }
+
+
+            /**
+             * @brief 清空符号分解与数值分解
+             */
+            void Clear() override{
+                mIsSymbolicValid = false;
+                mIsFactorized = false;
+                mPatternSize = 0;
+                mPatternNonZeros = 0;
+                mPatternHash = 0;
+                IndexVectorType().swap(mPermutation);
+                IndexVectorType().swap(mColumnPointers);
+                IndexVectorType().swap(mColumnSources);
+                IndexVectorType().swap(mAssemblyPositions);
+                IndexVectorType().swap(mSupernodeBegin);
+                IndexVectorType().swap(mChildPointers);
+                IndexVectorType().swap(mChildren);
+                IndexVectorType().swap(mStructurePointers);
+                IndexVectorType().swap(mStructureRows);
+                IndexVectorType().swap(mRelativeIndices);
+                IndexVectorType().swap(mFactorPointers);
+                IndexVectorType().swap(mLevelPointers);
+                IndexVectorType().swap(mLevelSupernodes);
+                std::vector<DataType>().swap(mFactorValues);
+            }
+
+
+            /**
+             * @brief 返回符号分解的次数
+             */
+            std::size_t GetNumberOfSymbolicFactorizations() const{
+                return mNumberOfSymbolicFactorizations;
+            }
+
+
+            /**
+             * @brief 返回数值分解的次数
+             */
+            std::size_t GetNumberOfNumericFactorizations() const{
+                return mNumberOfNumericFactorizations;
+            }
+
+
+            /**
+             * @brief 返回超节点个数
+             */
+            std::size_t GetNumberOfSupernodes() const{
+                return mSupernodeBegin.empty() ? 0 : mSupernodeBegin.size() - 1;
+            }
+
+
+            /**
+             * @brief 返回因子 L 的存储量（含超节点对角块的上三角部分与松弛超节点的显式零元）
+             */
+            std::size_t GetFactorNonZeros() const{
+                return mFactorPointers.empty() ? 0 : mFactorPointers.back();
+            }
+
+
+            /**
+             * @brief 返回排序，GetPermutation()[新编号] = 原编号
+             */
+            const IndexVectorType& GetPermutation() const{
+                return mPermutation;
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const override{
+                rOstream << "Supernodal " << (mFactorization == FactorizationType::Cholesky ? "Cholesky" : "LDLT") << " direct solver";
+            }
+
+
+            void PrintData(std::ostream& rOstream) const override{
+                rOstream << "ordering : " << (mOrdering == OrderingType::NestedDissection ? "nested dissection" : "natural") << std::endl;
+                rOstream << "number of supernodes : " << GetNumberOfSupernodes() << std::endl;
+                rOstream << "number of levels : " << (mLevelPointers.empty() ? 0 : mLevelPointers.size() - 1) << std::endl;
+                rOstream << "factor storage : " << GetFactorNonZeros() << std::endl;
+                rOstream << "symbolic factorizations : " << mNumberOfSymbolicFactorizations << " numeric factorizations : " << mNumberOfNumericFactorizations;
+            }
+
+        protected:
+
+        private:
+            ///@name 符号分解
+            ///@{
+
+            /**
+             * @brief 稀疏模式变化时重新进行符号分解，随后进行数值分解
+             */
+            void Factorize(SparseMatrixType& rA){
+                if(!IsSymbolicFactorizationValid(rA)){
+                    SymbolicFactorization(rA);
+                }
+                NumericFactorization(rA);
+            }
+
+
+            /**
+             * @brief 以阶数、非零元个数与索引数组的散列判断稀疏模式是否与上次符号分解时相同
+             */
+            bool IsSymbolicFactorizationValid(const SparseMatrixType& rA) const{
+                return mIsSymbolicValid
+                    && mPatternSize == rA.size1()
+                    && mPatternNonZeros == static_cast<IndexType>(rA.index1_data()[rA.size1()])
+                    && mPatternHash == PatternHash(rA);
+            }
+
+
+            /**
+             * @brief 稀疏模式的 64 位 FNV-1a 散列
+             */
+            static std::uint64_t PatternHash(const SparseMatrixType& rA){
+                const IndexType size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                std::uint64_t hash = 14695981039346656037ULL;
+                auto mix = [&hash](const std::uint64_t Value){
+                    hash ^= Value;
+                    hash *= 1099511628211ULL;
+                };
+                for(IndexType i=0; i<=size; ++i){
+                    mix(static_cast<std::uint64_t>(r_row_indices[i]));
+                }
+                const IndexType nnz = r_row_indices[size];
+                for(IndexType k=0; k<nnz; ++k){
+                    mix(static_cast<std::uint64_t>(r_col_indices[k]));
+                }
+                return hash;
+            }
+
+
+            /**
+             * @brief 符号分解
+             */
+            void SymbolicFactorization(SparseMatrixType& rA){
+                const IndexType size = rA.size1();
+                QUEST_ERROR_IF(size != rA.size2()) << "The supernodal Cholesky solver requires a square matrix, got " << size << "x" << rA.size2() << std::endl;
+
+                Clear();
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                // 1. 填充约化排序
+                IndexVectorType permutation;
+                if(mOrdering == OrderingType::NestedDissection){
+                    NestedDissectionOrdering::Compute(size, r_row_indices, r_col_indices, permutation);
+                } else {
+                    permutation.resize(size);
+                    std::iota(permutation.begin(), permutation.end(), 0);
+                }
+
+                // 2. 以消去树的后序重新编号，使每个子树（进而每个超节点）的列连续
+                IndexVectorType inverse(size);
+                for(IndexType k=0; k<size; ++k){
+                    inverse[permutation[k]] = k;
+                }
+                IndexVectorType row_pointers;
+                IndexVectorType row_columns;
+                BuildLowerRows(rA, inverse, row_pointers, row_columns);
+                IndexVectorType parent;
+                EliminationTree(size, row_pointers, row_columns, parent);
+                IndexVectorType postorder;
+                Postorder(parent, postorder);
+
+                mPermutation.resize(size);
+                for(IndexType k=0; k<size; ++k){
+                    mPermutation[k] = permutation[postorder[k]];
+                }
+                for(IndexType k=0; k<size; ++k){
+                    inverse[mPermutation[k]] = k;
+                }
+                BuildLowerRows(rA, inverse, row_pointers, row_columns);
+                EliminationTree(size, row_pointers, row_columns, parent);
+                BuildLowerColumns(rA, inverse);
+
+                // 3. 列计数：第 k 行的行子树由行中各非零列沿消去树上溯到 k 的路径组成
+                IndexVectorType counts(size, 1);
+                {
+                    IndexVectorType mark(size, NoEntry);
+                    for(IndexType k=0; k<size; ++k){
+                        mark[k] = k;
+                        for(IndexType p=row_pointers[k]; p<row_pointers[k+1]; ++p){
+                            for(IndexType i=row_columns[p]; mark[i] != k; i=parent[i]){
+                                ++counts[i];
+                                mark[i] = k;
+                            }
+                        }
+                    }
+                }
+
+                // 4. 超节点划分与超节点消去树
+                BuildSupernodes(parent, counts);
+                const IndexType num_supernodes = mSupernodeBegin.size() - 1;
+
+                IndexVectorType supernode_of(size);
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    for(IndexType c=mSupernodeBegin[s]; c<mSupernodeBegin[s+1]; ++c){
+                        supernode_of[c] = s;
+                    }
+                }
+                IndexVectorType supernode_parent(num_supernodes, NoEntry);
+                mChildPointers.assign(num_supernodes + 1, 0);
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    const IndexType p = parent[mSupernodeBegin[s+1] - 1];
+                    if(p != NoEntry){
+                        supernode_parent[s] = supernode_of[p];
+                        ++mChildPointers[supernode_of[p] + 1];
+                    }
+                }
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    mChildPointers[s+1] += mChildPointers[s];
+                }
+                mChildren.resize(mChildPointers[num_supernodes]);
+                {
+                    IndexVectorType fill(mChildPointers.begin(), mChildPointers.end() - 1);
+                    for(IndexType s=0; s<num_supernodes; ++s){
+                        if(supernode_parent[s] != NoEntry){
+                            mChildren[fill[supernode_parent[s]]++] = s;
+                        }
+                    }
+                }
+
+                // 5. 超节点行结构（A 的对应列与各子节点结构的并集），以及组装所需的波前内位置
+                BuildStructures(size);
+
+                // 6. 因子存储与层次划分
+                mFactorPointers.assign(num_supernodes + 1, 0);
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    mFactorPointers[s+1] = mFactorPointers[s] + FrontSize(s) * NumberOfColumns(s);
+                }
+
+                IndexVectorType level(num_supernodes, 0);
+                IndexType num_levels = 0;
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    for(IndexType k=mChildPointers[s]; k<mChildPointers[s+1]; ++k){
+                        level[s] = std::max(level[s], level[mChildren[k]] + 1);
+                    }
+                    num_levels = std::max(num_levels, level[s] + 1);
+                }
+                mLevelPointers.assign(num_levels + 1, 0);
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    ++mLevelPointers[level[s] + 1];
+                }
+                for(IndexType l=0; l<num_levels; ++l){
+                    mLevelPointers[l+1] += mLevelPointers[l];
+                }
+                mLevelSupernodes.resize(num_supernodes);
+                {
+                    IndexVectorType fill(mLevelPointers.begin(), mLevelPointers.end() - 1);
+                    for(IndexType s=0; s<num_supernodes; ++s){
+                        mLevelSupernodes[fill[level[s]]++] = s;
+                    }
+                }
+
+                mPatternSize = size;
+                mPatternNonZeros = r_row_indices[size];
+                mPatternHash = PatternHash(rA);
+                mIsSymbolicValid = true;
+                ++mNumberOfSymbolicFactorizations;
+            }
+
+
+            /**
+             * @brief 按新编号构造 A 的严格下三角部分的行结构（A 完整存储时每个非零元对出现两次，不影响后续用途）
+             */
+            static void BuildLowerRows(const SparseMatrixType& rA, const IndexVectorType& rInverse, IndexVectorType& rPointers, IndexVectorType& rColumns){
+                const IndexType size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                rPointers.assign(size + 1, 0);
+                for(IndexType r=0; r<size; ++r){
+                    const IndexType row = rInverse[r];
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        const IndexType col = rInverse[r_col_indices[k]];
+                        if(col < row){
+                            ++rPointers[row + 1];
+                        } else if(row < col){
+                            ++rPointers[col + 1];
+                        }
+                    }
+                }
+                for(IndexType i=0; i<size; ++i){
+                    rPointers[i+1] += rPointers[i];
+                }
+                rColumns.resize(rPointers[size]);
+                IndexVectorType fill(rPointers.begin(), rPointers.end() - 1);
+                for(IndexType r=0; r<size; ++r){
+                    const IndexType row = rInverse[r];
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        const IndexType col = rInverse[r_col_indices[k]];
+                        if(col < row){
+                            rColumns[fill[row]++] = col;
+                        } else if(row < col){
+                            rColumns[fill[col]++] = row;
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 按新编号构造组装用的下三角列结构：第 J 列记录 A 中新编号满足 I >= J 的非零元在 value_data 中的位置
+             * @details A 完整存储时只取下三角的一半，只存储一个三角时取其全部，因此两种存储方式都只组装一次
+             */
+            void BuildLowerColumns(const SparseMatrixType& rA, const IndexVectorType& rInverse){
+                const IndexType size = rA.size1();
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+
+                // 判断 A 是否只存储了一个三角：只要同时出现 I > J 与 I < J 的非零元，就按完整存储只取 I >= J
+                bool has_lower = false;
+                bool has_upper = false;
+                for(IndexType r=0; r<size && !(has_lower && has_upper); ++r){
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        const IndexType c = r_col_indices[k];
+                        has_lower |= (c < r);
+                        has_upper |= (c > r);
+                    }
+                }
+                const bool take_upper = has_upper && !has_lower;
+
+                mColumnPointers.assign(size + 1, 0);
+                auto target_column = [&](const IndexType Row, const IndexType Col, IndexType& rColumn, IndexType& rRow){
+                    const bool is_lower_in_original = take_upper ? (Col >= Row) : (Col <= Row);
+                    if(!is_lower_in_original){
+                        return false;
+                    }
+                    const IndexType i = rInverse[Row];
+                    const IndexType j = rInverse[Col];
+                    rColumn = std::min(i, j);
+                    rRow = std::max(i, j);
+                    return true;
+                };
+
+                IndexType column = 0;
+                IndexType row = 0;
+                for(IndexType r=0; r<size; ++r){
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        if(target_column(r, r_col_indices[k], column, row)){
+                            ++mColumnPointers[column + 1];
+                        }
+                    }
+                }
+                for(IndexType j=0; j<size; ++j){
+                    mColumnPointers[j+1] += mColumnPointers[j];
+                }
+                mColumnSources.resize(mColumnPointers[size]);
+                mAssemblyPositions.resize(mColumnPointers[size]);
+                IndexVectorType fill(mColumnPointers.begin(), mColumnPointers.end() - 1);
+                for(IndexType r=0; r<size; ++r){
+                    for(IndexType k=r_row_indices[r]; k<static_cast<IndexType>(r_row_indices[r+1]); ++k){
+                        if(target_column(r, r_col_indices[k], column, row)){
+                            const IndexType p = fill[column]++;
+                            mColumnSources[p] = k;
+                            // 暂存新编号下的行号，BuildStructures 中换算为波前内的位置
+                            mAssemblyPositions[p] = row;
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 由严格下三角的行结构计算消去树（Liu 算法，带路径压缩），根的父节点为 NoEntry
+             */
+            static void EliminationTree(const IndexType Size, const IndexVectorType& rPointers, const IndexVectorType& rColumns, IndexVectorType& rParent){
+                rParent.assign(Size, NoEntry);
+                IndexVectorType ancestor(Size, NoEntry);
+                for(IndexType k=0; k<Size; ++k){
+                    for(IndexType p=rPointers[k]; p<rPointers[k+1]; ++p){
+                        IndexType i = rColumns[p];
+                        while(ancestor[i] != NoEntry && ancestor[i] != k){
+                            const IndexType next = ancestor[i];
+                            ancestor[i] = k;
+                            i = next;
+                        }
+                        if(ancestor[i] == NoEntry){
+                            ancestor[i] = k;
+                            rParent[i] = k;
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 消去树的后序，rPostorder[新编号] = 旧编号
+             */
+            static void Postorder(const IndexVectorType& rParent, IndexVectorType& rPostorder){
+                const IndexType size = rParent.size();
+                IndexVectorType head(size, NoEntry);
+                IndexVectorType next(size, NoEntry);
+                for(IndexType j=size; j-->0;){
+                    if(rParent[j] != NoEntry){
+                        next[j] = head[rParent[j]];
+                        head[rParent[j]] = j;
+                    }
+                }
+
+                rPostorder.clear();
+                rPostorder.reserve(size);
+                IndexVectorType stack;
+                for(IndexType root=0; root<size; ++root){
+                    if(rParent[root] != NoEntry){
+                        continue;
+                    }
+                    stack.push_back(root);
+                    while(!stack.empty()){
+                        const IndexType j = stack.back();
+                        const IndexType child = head[j];
+                        if(child == NoEntry){
+                            stack.pop_back();
+                            rPostorder.push_back(j);
+                        } else {
+                            head[j] = next[child];
+                            stack.push_back(child);
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 超节点划分
+             * @details 列 j 的父节点为 j+1 时，若两列结构相同（counts[j] == counts[j+1] + 1）则并入同一超节点；
+             *  否则按松弛规则合并，合并带来的显式零元所占比例随超节点变宽而收紧（列数不超过 4 时总是合并，
+             *  不超过 16 时允许 80%，不超过 48 时允许 10%，其余 5%），以少量零元换取更宽的稠密块
+             */
+            void BuildSupernodes(const IndexVectorType& rParent, const IndexVectorType& rCounts){
+                const IndexType size = rParent.size();
+                mSupernodeBegin.assign(1, 0);
+                if(size == 0){
+                    return;
+                }
+
+                IndexType zeros = 0;
+                for(IndexType j=1; j<size; ++j){
+                    const IndexType first = mSupernodeBegin.back();
+                    const IndexType num_columns = j - first;
+                    bool merge = false;
+                    IndexType new_zeros = zeros;
+                    if(rParent[j-1] == j){
+                        if(rCounts[j-1] == rCounts[j] + 1){
+                            merge = true;
+                        } else {
+                            new_zeros = zeros + num_columns * (rCounts[j] + 1 - rCounts[j-1]);
+                            const IndexType new_columns = num_columns + 1;
+                            const double total = static_cast<double>(new_columns * rCounts[j] + num_columns * new_columns / 2);
+                            const double fraction = static_cast<double>(new_zeros) / total;
+                            merge = new_columns <= 4
+                                || (new_columns <= 16 && fraction < 0.8)
+                                || (new_columns <= 48 && fraction < 0.1)
+                                || fraction < 0.05;
+                        }
+                    }
+                    if(merge){
+                        zeros = new_zeros;
+                    } else {
+                        mSupernodeBegin.push_back(j);
+                        zeros = 0;
+                    }
+                }
+                mSupernodeBegin.push_back(size);
+            }
+
+
+            /**
+             * @brief 计算各超节点的行结构、A 的非零元在波前中的行位置以及各超节点行结构在父节点波前中的相对位置
+             */
+            void BuildStructures(const IndexType Size){
+                const IndexType num_supernodes = mSupernodeBegin.size() - 1;
+                IndexVectorType mark(Size, NoEntry);
+                IndexVectorType position(Size, 0);
+                IndexVectorType rows;
+
+                mStructurePointers.assign(1, 0);
+                mStructureRows.clear();
+                for(IndexType s=0; s<num_supernodes; ++s){
+                    const IndexType first = mSupernodeBegin[s];
+                    const IndexType last = mSupernodeBegin[s+1] - 1;
+                    const IndexType num_columns = last - first + 1;
+
+                    rows.clear();
+                    for(IndexType c=first; c<=last; ++c){
+                        for(IndexType p=mColumnPointers[c]; p<mColumnPointers[c+1]; ++p){
+                            const IndexType i = mAssemblyPositions[p];
+                            if(i > last && mark[i] != s){
+                                mark[i] = s;
+                                rows.push_back(i);
+                            }
+                        }
+                    }
+                    for(IndexType k=mChildPointers[s]; k<mChildPointers[s+1]; ++k){
+                        const IndexType child = mChildren[k];
+                        for(IndexType p=mStructurePointers[child]; p<mStructurePointers[child+1]; ++p){
+                            const IndexType i = mStructureRows[p];
+                            if(i > last && mark[i] != s){
+                                mark[i] = s;
+                                rows.push_back(i);
+                            }
+                        }
+                    }
+                    std::sort(rows.begin(), rows.end());
+                    mStructureRows.insert(mStructureRows.end(), rows.begin(), rows.end());
+                    mStructurePointers.push_back(mStructureRows.size());
+                    mRelativeIndices.resize(mStructureRows.size());
+
+                    for(IndexType c=first; c<=last; ++c){
+                        position[c] = c - first;
+                    }
+                    for(IndexType r=0; r<rows.size(); ++r){
+                        position[rows[r]] = num_columns + r;
+                    }
+
+                    for(IndexType c=first; c<=last; ++c){
+                        for(IndexType p=mColumnPointers[c]; p<mColumnPointers[c+1]; ++p){
+                            mAssemblyPositions[p] = position[mAssemblyPositions[p]];
+                        }
+                    }
+                    for(IndexType k=mChildPointers[s]; k<mChildPointers[s+1]; ++k){
+                        const IndexType child = mChildren[k];
+                        for(IndexType p=mStructurePointers[child]; p<mStructurePointers[child+1]; ++p){
+                            mRelativeIndices[p] = position[mStructureRows[p]];
+                        }
+                    }
+                }
+            }
+
+            ///@}
+            ///@name 数值分解
+            ///@{
+
+            /**
+             * @brief 多波前数值分解
+             * @details 自叶向根逐层处理；同层超节点不少于线程数时按超节点并行，否则依次处理并在稠密核函数内部并行
+             */
+            void NumericFactorization(SparseMatrixType& rA){
+                const IndexType num_supernodes = mSupernodeBegin.size() - 1;
+                const auto& r_values = rA.value_data();
+                const IndexType num_threads = static_cast<IndexType>(ParallelUtilities::GetNumThreads());
+
+                mIsFactorized = false;
+                mFactorValues.resize(mFactorPointers[num_supernodes]);
+                std::vector<std::vector<DataType>> updates(num_supernodes);
+
+                for(IndexType l=0; l+1<mLevelPointers.size(); ++l){
+                    const IndexType level_begin = mLevelPointers[l];
+                    const IndexType level_size = mLevelPointers[l+1] - level_begin;
+                    if(level_size >= num_threads && num_threads > 1){
+                        IndexPartition<IndexType>(level_size).for_each([&](IndexType k){
+                            FactorizeSupernode(mLevelSupernodes[level_begin + k], r_values, updates, false);
+                        });
+                    } else {
+                        for(IndexType k=0; k<level_size; ++k){
+                            FactorizeSupernode(mLevelSupernodes[level_begin + k], r_values, updates, num_threads > 1);
+                        }
+                    }
+                }
+
+                mIsFactorized = true;
+                ++mNumberOfNumericFactorizations;
+            }
+
+
+            /**
+             * @brief 组装并部分分解超节点 s 的波前
+             * @details 波前为 m x m（m = nc + nb）的对称矩阵，前 nc 列直接组装在因子存储中（列主序，前导维数 m），
+             *  右下 nb x nb 的部分组装在 rUpdates[s] 中；分解前 nc 列后 rUpdates[s] 即为交给父节点的更新矩阵
+             * @param Parallel 是否在稠密核函数内部并行
+             */
+            template<typename TValues>
+            void FactorizeSupernode(const IndexType s, const TValues& rValues, std::vector<std::vector<DataType>>& rUpdates, const bool Parallel){
+                const IndexType first = mSupernodeBegin[s];
+                const IndexType nc = NumberOfColumns(s);
+                const IndexType nb = mStructurePointers[s+1] - mStructurePointers[s];
+                const IndexType m = nc + nb;
+                DataType* p_front = mFactorValues.data() + mFactorPointers[s];
+
+                std::fill(p_front, p_front + m*nc, 0.0);
+                std::vector<DataType>& r_update = rUpdates[s];
+                r_update.assign(nb*nb, 0.0);
+
+                for(IndexType c=0; c<nc; ++c){
+                    DataType* p_column = p_front + c*m;
+                    for(IndexType p=mColumnPointers[first + c]; p<mColumnPointers[first + c + 1]; ++p){
+                        p_column[mAssemblyPositions[p]] += rValues[mColumnSources[p]];
+                    }
+                }
+
+                // 扩展相加：子节点更新矩阵的下三角按相对位置加入波前
+                for(IndexType k=mChildPointers[s]; k<mChildPointers[s+1]; ++k){
+                    const IndexType child = mChildren[k];
+                    const IndexType child_nb = mStructurePointers[child+1] - mStructurePointers[child];
+                    const IndexType* p_relative = mRelativeIndices.data() + mStructurePointers[child];
+                    std::vector<DataType>& r_child_update = rUpdates[child];
+                    for(IndexType jc=0; jc<child_nb; ++jc){
+                        const IndexType rj = p_relative[jc];
+                        const DataType* p_source = r_child_update.data() + jc*child_nb;
+                        if(rj < nc){
+                            DataType* p_target = p_front + rj*m;
+                            for(IndexType ic=jc; ic<child_nb; ++ic){
+                                p_target[p_relative[ic]] += p_source[ic];
+                            }
+                        } else {
+                            DataType* p_target = r_update.data() + (rj - nc)*nb;
+                            for(IndexType ic=jc; ic<child_nb; ++ic){
+                                p_target[p_relative[ic] - nc] += p_source[ic];
+                            }
+                        }
+                    }
+                    std::vector<DataType>().swap(r_child_update);
+                }
+
+                FactorizePanel(m, nc, p_front, first, Parallel);
+
+                if(nb > 0){
+                    std::vector<DataType> diagonal;
+                    const DataType* p_diagonal = PanelDiagonal(m, 0, nc, p_front, diagonal);
+                    SchurUpdate(nb, nb, nc, p_front + nc, m, p_diagonal, r_update.data(), nb, Parallel);
+                }
+            }
+
+
+            /**
+             * @brief 分解 m x nc 的面板（前 nc 行为对角块），按 BlockSize 列分块：
+             *  块内逐列左视分解（含该块以下全部行的三角求解），再以块对面板剩余列做 Schur 补更新
+             * @details LLT 时对角元存 l_jj；LDLT 时对角元存 d_j，L 为单位下三角
+             */
+            void FactorizePanel(const IndexType m, const IndexType nc, DataType* pPanel, const IndexType FirstColumn, const bool Parallel){
+                const bool is_ldlt = (mFactorization == FactorizationType::LDLT);
+                std::vector<DataType> diagonal;
+
+                for(IndexType k0=0; k0<nc; k0+=BlockSize){
+                    const IndexType k1 = std::min(k0 + BlockSize, nc);
+
+                    for(IndexType c=k0; c<k1; ++c){
+                        DataType* p_column = pPanel + c*m;
+
+                        // 块内前面各列的贡献：col_c -= Σ_t L(:,t)*d_t*L(c,t)
+                        const IndexType num_rows = m - c;
+                        const int num_chunks = static_cast<int>((num_rows + RowChunkSize - 1) / RowChunkSize);
+                        #pragma omp parallel for if(Parallel && num_chunks > 1)
+                        for(int chunk = 0; chunk < num_chunks; ++chunk){
+                            const IndexType i_begin = c + static_cast<IndexType>(chunk)*RowChunkSize;
+                            const IndexType i_end = std::min(i_begin + RowChunkSize, m);
+                            for(IndexType t=k0; t<c; ++t){
+                                const DataType* p_t = pPanel + t*m;
+                                const DataType coefficient = is_ldlt ? p_t[c] * p_t[t] : p_t[c];
+                                for(IndexType i=i_begin; i<i_end; ++i){
+                                    p_column[i] -= coefficient * p_t[i];
+                                }
+                            }
+                        }
+
+                        const DataType pivot = p_column[c];
+                        DataType scale = 0.0;
+                        if(is_ldlt){
+                            QUEST_ERROR_IF(std::abs(pivot) <= std::numeric_limits<DataType>::min()) << "Supernodal LDLT: zero pivot at row " << mPermutation[FirstColumn + c] << std::endl;
+                            scale = 1.0 / pivot;
+                        } else {
+                            QUEST_ERROR_IF(!(pivot > 0.0)) << "Supernodal Cholesky: matrix is not positive definite (pivot " << pivot << " at row " << mPermutation[FirstColumn + c] << ")" << std::endl;
+                            p_column[c] = std::sqrt(pivot);
+                            scale = 1.0 / p_column[c];
+                        }
+
+                        #pragma omp parallel for if(Parallel && num_chunks > 1)
+                        for(int chunk = 0; chunk < num_chunks; ++chunk){
+                            const IndexType i_begin = c + 1 + static_cast<IndexType>(chunk)*RowChunkSize;
+                            const IndexType i_end = std::min(i_begin + RowChunkSize, m);
+                            for(IndexType i=i_begin; i<i_end; ++i){
+                                p_column[i] *= scale;
+                            }
+                        }
+                    }
+
+                    if(k1 < nc){
+                        const DataType* p_diagonal = PanelDiagonal(m, k0, k1, pPanel, diagonal);
+                        SchurUpdate(m - k1, nc - k1, k1 - k0, pPanel + k0*m + k1, m, p_diagonal, pPanel + k1*m + k1, m, Parallel);
+                    }
+                }
+            }
+
+
+            /**
+             * @brief LDLT 时取出面板第 [Begin, End) 列的 d_j，LLT 时返回空指针
+             */
+            const DataType* PanelDiagonal(const IndexType m, const IndexType Begin, const IndexType End, const DataType* pPanel, std::vector<DataType>& rDiagonal) const{
+                if(mFactorization != FactorizationType::LDLT){
+                    return nullptr;
+                }
+                rDiagonal.resize(End - Begin);
+                for(IndexType t=Begin; t<End; ++t){
+                    rDiagonal[t - Begin] = pPanel[t + t*m];
+                }
+                return rDiagonal.data();
+            }
+
+
+            /**
+             * @brief Schur 补更新 C(i,j) -= Σ_k A(i,k)*d_k*A(j,k)，只更新 i >= j 的部分
+             * @details A 为 M x K（列主序，前导维数 lda），C 为 M x N（列主序，前导维数 ldc，N <= M，前 N 行为对称部分），
+             *  pD 为空时 d_k = 1。按 ColumnTileSize 列、RowTileSize 行、KTileSize 个 k 分块：A 的一个行块与 k 块常驻缓存，
+             *  被该列块的各列重复使用；最内层每次同时累加四个 k，C 的每个元素读写一次即完成四次乘加
+             */
+            static void SchurUpdate(
+                const IndexType M,
+                const IndexType N,
+                const IndexType K,
+                const DataType* pA,
+                const IndexType lda,
+                const DataType* pD,
+                DataType* pC,
+                const IndexType ldc,
+                const bool Parallel
+            ){
+                if(M == 0 || N == 0 || K == 0){
+                    return;
+                }
+
+                const int num_column_tiles = static_cast<int>((N + ColumnTileSize - 1) / ColumnTileSize);
+                #pragma omp parallel for schedule(dynamic) if(Parallel && num_column_tiles > 1)
+                for(int tile = 0; tile < num_column_tiles; ++tile){
+                    const IndexType j0 = static_cast<IndexType>(tile) * ColumnTileSize;
+                    const IndexType j1 = std::min(j0 + ColumnTileSize, N);
+                    std::vector<DataType> weights(ColumnTileSize * KTileSize);
+
+                    for(IndexType k0=0; k0<K; k0+=KTileSize){
+                        const IndexType k1 = std::min(k0 + KTileSize, K);
+                        const IndexType kw = k1 - k0;
+                        for(IndexType j=j0; j<j1; ++j){
+                            for(IndexType k=k0; k<k1; ++k){
+                                const DataType a_jk = pA[j + k*lda];
+                                weights[(j - j0)*KTileSize + (k - k0)] = pD ? a_jk * pD[k] : a_jk;
+                            }
+                        }
+
+                        for(IndexType i0=j0; i0<M; i0+=RowTileSize){
+                            const IndexType i1 = std::min(i0 + RowTileSize, M);
+                            for(IndexType j=j0; j<j1; ++j){
+                                const IndexType i_begin = std::max(i0, j);
+                                if(i_begin >= i1){
+                                    continue;
+                                }
+                                DataType* p_c = pC + j*ldc;
+                                const DataType* p_w = weights.data() + (j - j0)*KTileSize;
+                                IndexType k = 0;
+                                for(; k+4<=kw; k+=4){
+                                    const DataType w0 = p_w[k];
+                                    const DataType w1 = p_w[k+1];
+                                    const DataType w2 = p_w[k+2];
+                                    const DataType w3 = p_w[k+3];
+                                    const DataType* p_a0 = pA + (k0 + k)*lda;
+                                    const DataType* p_a1 = p_a0 + lda;
+                                    const DataType* p_a2 = p_a1 + lda;
+                                    const DataType* p_a3 = p_a2 + lda;
+                                    for(IndexType i=i_begin; i<i1; ++i){
+                                        p_c[i] -= w0*p_a0[i] + w1*p_a1[i] + w2*p_a2[i] + w3*p_a3[i];
+                                    }
+                                }
+                                for(; k<kw; ++k){
+                                    const DataType w0 = p_w[k];
+                                    const DataType* p_a0 = pA + (k0 + k)*lda;
+                                    for(IndexType i=i_begin; i<i1; ++i){
+                                        p_c[i] -= w0*p_a0[i];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            ///@}
+            ///@name 求解
+            ///@{
+
+            /**
+             * @brief 以已有的分解求解 A*x = b
+             * @details 前代自叶向根逐层进行，各超节点把 L21*x_s 作为贡献向量交给父节点；
+             *  LDLT 时再除以 D；回代自根向叶逐层进行，只读取祖先超节点的已知解
+             */
+            void SolveFactorized(const VectorType& rB, VectorType& rX) const{
+                const IndexType size = mPermutation.size();
+                const IndexType num_supernodes = mSupernodeBegin.size() - 1;
+                const bool is_ldlt = (mFactorization == FactorizationType::LDLT);
+
+                std::vector<DataType> y(size);
+                IndexPartition<IndexType>(size).for_each([&](IndexType k){
+                    y[k] = rB[mPermutation[k]];
+                });
+
+                std::vector<std::vector<DataType>> contributions(num_supernodes);
+                const IndexType num_levels = mLevelPointers.size() - 1;
+
+                for(IndexType l=0; l<num_levels; ++l){
+                    const IndexType level_begin = mLevelPointers[l];
+                    IndexPartition<IndexType>(mLevelPointers[l+1] - level_begin).for_each([&](IndexType k){
+                        const IndexType s = mLevelSupernodes[level_begin + k];
+                        const IndexType first = mSupernodeBegin[s];
+                        const IndexType nc = NumberOfColumns(s);
+                        const IndexType nb = mStructurePointers[s+1] - mStructurePointers[s];
+                        const IndexType m = nc + nb;
+                        const DataType* p_front = mFactorValues.data() + mFactorPointers[s];
+                        DataType* p_y = y.data() + first;
+
+                        std::vector<DataType>& r_tail = contributions[s];
+                        r_tail.assign(nb, 0.0);
+                        for(IndexType q=mChildPointers[s]; q<mChildPointers[s+1]; ++q){
+                            const IndexType child = mChildren[q];
+                            const IndexType* p_relative = mRelativeIndices.data() + mStructurePointers[child];
+                            std::vector<DataType>& r_child = contributions[child];
+                            for(IndexType i=0; i<r_child.size(); ++i){
+                                const IndexType r = p_relative[i];
+                                if(r < nc){
+                                    p_y[r] -= r_child[i];
+                                } else {
+                                    r_tail[r - nc] += r_child[i];
+                                }
+                            }
+                            std::vector<DataType>().swap(r_child);
+                        }
+
+                        for(IndexType c=0; c<nc; ++c){
+                            const DataType* p_column = p_front + c*m;
+                            if(!is_ldlt){
+                                p_y[c] /= p_column[c];
+                            }
+                            const DataType y_c = p_y[c];
+                            for(IndexType i=c+1; i<nc; ++i){
+                                p_y[i] -= p_column[i] * y_c;
+                            }
+                            for(IndexType i=nc; i<m; ++i){
+                                r_tail[i - nc] += p_column[i] * y_c;
+                            }
+                        }
+                    });
+                }
+
+                if(is_ldlt){
+                    IndexPartition<IndexType>(num_supernodes).for_each([&](IndexType s){
+                        const IndexType m = FrontSize(s);
+                        const DataType* p_front = mFactorValues.data() + mFactorPointers[s];
+                        for(IndexType c=0; c<NumberOfColumns(s); ++c){
+                            y[mSupernodeBegin[s] + c] /= p_front[c + c*m];
+                        }
+                    });
+                }
+
+                for(IndexType l=num_levels; l-->0;){
+                    const IndexType level_begin = mLevelPointers[l];
+                    IndexPartition<IndexType>(mLevelPointers[l+1] - level_begin).for_each([&](IndexType k){
+                        const IndexType s = mLevelSupernodes[level_begin + k];
+                        const IndexType first = mSupernodeBegin[s];
+                        const IndexType nc = NumberOfColumns(s);
+                        const IndexType m = FrontSize(s);
+                        const DataType* p_front = mFactorValues.data() + mFactorPointers[s];
+                        const IndexType* p_rows = mStructureRows.data() + mStructurePointers[s];
+                        DataType* p_y = y.data() + first;
+
+                        for(IndexType c=nc; c-->0;){
+                            const DataType* p_column = p_front + c*m;
+                            DataType sum = p_y[c];
+                            for(IndexType i=c+1; i<nc; ++i){
+                                sum -= p_column[i] * p_y[i];
+                            }
+                            for(IndexType i=nc; i<m; ++i){
+                                sum -= p_column[i] * y[p_rows[i - nc]];
+                            }
+                            p_y[c] = is_ldlt ? sum : sum / p_column[c];
+                        }
+                    });
+                }
+
+                if(rX.size() != size){
+                    rX.resize(size, false);
+                }
+                IndexPartition<IndexType>(size).for_each([&](IndexType k){
+                    rX[mPermutation[k]] = y[k];
+                });
+            }
+
+            ///@}
+
+            /**
+             * @brief 超节点 s 的列数
+             */
+            IndexType NumberOfColumns(const IndexType s) const{
+                return mSupernodeBegin[s+1] - mSupernodeBegin[s];
+            }
+
+            /**
+             * @brief 超节点 s 的波前阶数（列数加行结构长度）
+             */
+            IndexType FrontSize(const IndexType s) const{
+                return NumberOfColumns(s) + mStructurePointers[s+1] - mStructurePointers[s];
+            }
+
+        private:
+            static constexpr IndexType NoEntry = std::numeric_limits<IndexType>::max();
+
+            /**
+             * @brief 面板分解的列块宽度
+             */
+            static constexpr IndexType BlockSize = 32;
+
+            /**
+             * @brief 面板逐列分解时每个并行任务处理的行数
+             */
+            static constexpr IndexType RowChunkSize = 1024;
+
+            /**
+             * @brief Schur 补更新的分块大小
+             */
+            static constexpr IndexType ColumnTileSize = 32;
+            static constexpr IndexType RowTileSize = 256;
+            static constexpr IndexType KTileSize = 64;
+
+            FactorizationType mFactorization = FactorizationType::Cholesky;
+            OrderingType mOrdering = OrderingType::NestedDissection;
+
+            /**
+             * @brief 符号分解对应的稀疏模式
+             */
+            bool mIsSymbolicValid = false;
+            IndexType mPatternSize = 0;
+            IndexType mPatternNonZeros = 0;
+            std::uint64_t mPatternHash = 0;
+
+            /**
+             * @brief 排序，mPermutation[新编号] = 原编号（含消去树后序）
+             */
+            IndexVectorType mPermutation;
+
+            /**
+             * @brief 组装结构：新编号第 J 列的非零元在 A 的 value_data 中的位置及其在超节点波前中的行位置
+             */
+            IndexVectorType mColumnPointers;
+            IndexVectorType mColumnSources;
+            IndexVectorType mAssemblyPositions;
+
+            /**
+             * @brief 超节点 s 包含列 [mSupernodeBegin[s], mSupernodeBegin[s+1])
+             */
+            IndexVectorType mSupernodeBegin;
+
+            /**
+             * @brief 超节点消去树的子节点（CSR 形式）
+             */
+            IndexVectorType mChildPointers;
+            IndexVectorType mChildren;
+
+            /**
+             * @brief 超节点对角块以下的行结构（升序）及其在父节点波前中的位置
+             */
+            IndexVectorType mStructurePointers;
+            IndexVectorType mStructureRows;
+            IndexVectorType mRelativeIndices;
+
+            /**
+             * @brief 超节点 s 的因子为 mFactorValues[mFactorPointers[s]] 起的 m x nc 列主序稠密块
+             */
+            IndexVectorType mFactorPointers;
+            std::vector<DataType> mFactorValues;
+
+            /**
+             * @brief 按层（自叶向根）排列的超节点
+             */
+            IndexVectorType mLevelPointers;
+            IndexVectorType mLevelSupernodes;
+
+            bool mIsFactorized = false;
+            std::size_t mNumberOfSymbolicFactorizations = 0;
+            std::size_t mNumberOfNumericFactorizations = 0;
+
+    };
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType>
+    inline std::istream& operator >> (std::istream& rIstream, SupernodalCholeskySolver<TSparseSpaceType, TDenseSpaceType, TReordererType>& rThis){
+        return rIstream;
+    }
+
+
+    template<typename TSparseSpaceType, typename TDenseSpaceType, typename TReordererType>
+    inline std::ostream& operator << (std::ostream& rOstream, const SupernodalCholeskySolver<TSparseSpaceType, TDenseSpaceType, TReordererType>& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_SUPERNODAL_CHOLESKY_SOLVER_HPP
@@ -1,6 +1,12 @@
 #include "includes/define_python.hpp"
 #include "python/add_linear_solvers_to_python.hpp"
 #include "linear_solvers/cg_solver.hpp"
+#include "linear_solvers/pipelined_cg_solver.hpp"
+#include "linear_solvers/block_cg_solver.hpp"
+#include "linear_solvers/recycling_cg_solver.hpp"
+#include "linear_solvers/gmres_solver.hpp"
+#include "linear_solvers/bicgstab_l_solver.hpp"
+#include "linear_solvers/amgcl_solver.hpp"
 #include "includes/dof.hpp"
 #include "space/ublas_space.hpp"
 #include "includes/ublas_complex_interface.hpp"
@@ -8,9 +14,15 @@
 #include "linear_solvers/reorderer/reorderer.hpp"
 #include "linear_solvers/direct_solver.hpp"
 #include "linear_solvers/skyline_lu_custom_scalar_solver.hpp"
+#include "linear_solvers/supernodal_cholesky_solver.hpp"
+#include "linear_solvers/mixed_precision_refinement_solver.hpp"
 
 #include "linear_solvers/preconditioner/preconditioner.hpp"
 #include "linear_solvers/preconditioner/diagonal_preconditioner.hpp"
+#include "linear_solvers/preconditioner/mixed_precision_polynomial_preconditioner.hpp"
+#include "linear_solvers/preconditioner/chebyshev_preconditioner.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/preconditioner/ilut_preconditioner.hpp"
 
 namespace Quest::Python{
 
@@ -39,6 +51,12 @@ namespace Quest::Python{
         using LinearSolverType = LinearSolver<SpaceType,  LocalSpaceType>;
         using IterativeSolverType = IterativeSolver<SpaceType,  LocalSpaceType>;
         using CGSolverType = CGSolver<SpaceType,  LocalSpaceType>;
+        using PipelinedCGSolverType = PipelinedCGSolver<SpaceType,  LocalSpaceType>;
+        using BlockCGSolverType = BlockCGSolver<SpaceType,  LocalSpaceType>;
+        using RecyclingCGSolverType = RecyclingCGSolver<SpaceType,  LocalSpaceType>;
+        using GMRESSolverType = GMRESSolver<SpaceType,  LocalSpaceType>;
+        using BiCGStabLSolverType = BiCGStabLSolver<SpaceType,  LocalSpaceType>;
+        using AMGCLSolverType = AMGCLSolver<SpaceType,  LocalSpaceType>;
         
         using ComplexLinearSolverType = TLinearSolverType<std::complex<double>, std::complex<double>>;
         using MixedLinearSolverType = TLinearSolverType<double, std::complex<double>>;
@@ -63,6 +81,56 @@ namespace Quest::Python{
             .def(py::init<>())
             .def("__str__", PrintObject<DiagonalPreconditionerType>);
 
+
+        using MixedPrecisionPolynomialPreconditionerType = MixedPrecisionPolynomialPreconditioner<SpaceType,  LocalSpaceType>;
+        py::class_<MixedPrecisionPolynomialPreconditionerType, MixedPrecisionPolynomialPreconditionerType::Pointer, PreconditionerType>(m,"MixedPrecisionPolynomialPreconditioner")
+            .def(py::init<>())
+            .def(py::init<unsigned int>())
+            .def("SetDegree", &MixedPrecisionPolynomialPreconditionerType::SetDegree)
+            .def("GetDegree", &MixedPrecisionPolynomialPreconditionerType::GetDegree)
+            .def("__str__", PrintObject<MixedPrecisionPolynomialPreconditionerType>);
+
+
+        using ChebyshevPreconditionerType = ChebyshevPreconditioner<SpaceType,  LocalSpaceType>;
+        py::class_<ChebyshevPreconditionerType, ChebyshevPreconditionerType::Pointer, PreconditionerType>(m,"ChebyshevPreconditioner")
+            .def(py::init<>())
+            .def(py::init<unsigned int>())
+            .def(py::init<unsigned int, unsigned int>())
+            .def("SetDegree", &ChebyshevPreconditionerType::SetDegree)
+            .def("GetDegree", &ChebyshevPreconditionerType::GetDegree)
+            .def("SetEigenvalueIterations", &ChebyshevPreconditionerType::SetEigenvalueIterations)
+            .def("GetEigenvalueIterations", &ChebyshevPreconditionerType::GetEigenvalueIterations)
+            .def("SetEigenvalueRatio", &ChebyshevPreconditionerType::SetEigenvalueRatio)
+            .def("GetEigenvalueRatio", &ChebyshevPreconditionerType::GetEigenvalueRatio)
+            .def("GetLowerBound", &ChebyshevPreconditionerType::GetLowerBound)
+            .def("GetUpperBound", &ChebyshevPreconditionerType::GetUpperBound)
+            .def("__str__", PrintObject<ChebyshevPreconditionerType>);
+
+
+        using ILUPreconditionerType = ILUPreconditioner<SpaceType,  LocalSpaceType>;
+        py::class_<ILUPreconditionerType, ILUPreconditionerType::Pointer, PreconditionerType>(m,"ILUPreconditioner")
+            .def("SetReuseSymbolicFactorization", &ILUPreconditionerType::SetReuseSymbolicFactorization)
+            .def("GetReuseSymbolicFactorization", &ILUPreconditionerType::GetReuseSymbolicFactorization)
+            .def("GetNumberOfNumericFactorizations", &ILUPreconditionerType::GetNumberOfNumericFactorizations)
+            .def("__str__", PrintObject<ILUPreconditionerType>);
+
+
+        using ILU0PreconditionerType = ILU0Preconditioner<SpaceType,  LocalSpaceType>;
+        py::class_<ILU0PreconditionerType, ILU0PreconditionerType::Pointer, ILUPreconditionerType>(m,"ILU0Preconditioner")
+            .def(py::init<>())
+            .def("__str__", PrintObject<ILU0PreconditionerType>);
+
+
+        using ILUTPreconditionerType = ILUTPreconditioner<SpaceType,  LocalSpaceType>;
+        py::class_<ILUTPreconditionerType, ILUTPreconditionerType::Pointer, ILUPreconditionerType>(m,"ILUTPreconditioner")
+            .def(py::init<>())
+            .def(py::init<double, unsigned int>())
+            .def("SetDropTolerance", &ILUTPreconditionerType::SetDropTolerance)
+            .def("GetDropTolerance", &ILUTPreconditionerType::GetDropTolerance)
+            .def("SetFillIn", &ILUTPreconditionerType::SetFillIn)
+            .def("GetFillIn", &ILUTPreconditionerType::GetFillIn)
+            .def("__str__", PrintObject<ILUTPreconditionerType>);
+
         // 线性求解器
         py::class_<LinearSolverType, LinearSolverType::Pointer>(m,"LinearSolver")
             .def(py::init<>())
@@ -99,6 +167,72 @@ namespace Quest::Python{
             .def(py::init<Parameters,  PreconditionerType::Pointer>())
             .def("__str__", PrintObject<CGSolverType>);
 
+        py::class_<PipelinedCGSolverType, PipelinedCGSolverType::Pointer,IterativeSolverType>(m,"PipelinedCGSolver")
+            .def(py::init<double>())
+            .def(py::init<double, unsigned int>())
+            .def(py::init<double, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters>())
+            .def("__str__", PrintObject<PipelinedCGSolverType>);
+
+        py::class_<BlockCGSolverType, BlockCGSolverType::Pointer,IterativeSolverType>(m,"BlockCGSolver")
+            .def(py::init<double>())
+            .def(py::init<double, unsigned int>())
+            .def(py::init<double, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters>())
+            .def("GetColumnIterationsNumber",&BlockCGSolverType::GetColumnIterationsNumber)
+            .def("GetColumnResidualNorms",&BlockCGSolverType::GetColumnResidualNorms)
+            .def("__str__", PrintObject<BlockCGSolverType>);
+
+        py::class_<RecyclingCGSolverType, RecyclingCGSolverType::Pointer,IterativeSolverType>(m,"RecyclingCGSolver")
+            .def(py::init<double>())
+            .def(py::init<double, unsigned int>())
+            .def(py::init<double, unsigned int, unsigned int, unsigned int>())
+            .def(py::init<double, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<double, unsigned int, unsigned int, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters>())
+            .def("SetRecycleSpaceDimension",&RecyclingCGSolverType::SetRecycleSpaceDimension)
+            .def("GetRecycleSpaceDimension",&RecyclingCGSolverType::GetRecycleSpaceDimension)
+            .def("SetRecycleDirections",&RecyclingCGSolverType::SetRecycleDirections)
+            .def("GetRecycleDirections",&RecyclingCGSolverType::GetRecycleDirections)
+            .def("SetRecycleCycles",&RecyclingCGSolverType::SetRecycleCycles)
+            .def("GetRecycleCycles",&RecyclingCGSolverType::GetRecycleCycles)
+            .def("GetRecycleSpaceSize",&RecyclingCGSolverType::GetRecycleSpaceSize)
+            .def("__str__", PrintObject<RecyclingCGSolverType>);
+
+        py::class_<GMRESSolverType, GMRESSolverType::Pointer,IterativeSolverType>(m,"GMRESSolver")
+            .def(py::init<double>())
+            .def(py::init<double, unsigned int>())
+            .def(py::init<double, unsigned int, unsigned int>())
+            .def(py::init<double, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<double, unsigned int, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters>())
+            .def("SetKrylovSpaceDimension",&GMRESSolverType::SetKrylovSpaceDimension)
+            .def("GetKrylovSpaceDimension",&GMRESSolverType::GetKrylovSpaceDimension)
+            .def("__str__", PrintObject<GMRESSolverType>);
+
+        py::class_<BiCGStabLSolverType, BiCGStabLSolverType::Pointer,IterativeSolverType>(m,"BiCGStabLSolver")
+            .def(py::init<double>())
+            .def(py::init<double, unsigned int>())
+            .def(py::init<double, unsigned int, unsigned int>())
+            .def(py::init<double, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<double, unsigned int, unsigned int,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters,  PreconditionerType::Pointer>())
+            .def(py::init<Parameters>())
+            .def("SetPolynomialOrder",&BiCGStabLSolverType::SetPolynomialOrder)
+            .def("GetPolynomialOrder",&BiCGStabLSolverType::GetPolynomialOrder)
+            .def("__str__", PrintObject<BiCGStabLSolverType>);
+
+        py::class_<AMGCLSolverType, AMGCLSolverType::Pointer, LinearSolverType>(m,"AMGCLSolver")
+            .def(py::init< >())
+            .def(py::init<Parameters>())
+            .def("GetResidualNorm",&AMGCLSolverType::GetResidualNorm)
+            .def("GetNumberOfNumericRebuilds",&AMGCLSolverType::GetNumberOfNumericRebuilds)
+            .def("__str__", PrintObject<AMGCLSolverType>);
+
         using ReordererType = Reorderer<SpaceType,  LocalSpaceType >;
         using DirectSolverType = DirectSolver<SpaceType,  LocalSpaceType, ReordererType >;
         
@@ -115,6 +249,26 @@ namespace Quest::Python{
             .def(py::init<Parameters>())
             .def("__str__", PrintObject<DirectSolverType>);
 
+        using SupernodalCholeskySolverType = SupernodalCholeskySolver<SpaceType,  LocalSpaceType, ReordererType>;
+        py::class_<SupernodalCholeskySolverType, SupernodalCholeskySolverType::Pointer, DirectSolverType>(m,"SupernodalCholeskySolver")
+            .def(py::init< >())
+            .def(py::init<Parameters>())
+            .def("GetNumberOfSymbolicFactorizations",&SupernodalCholeskySolverType::GetNumberOfSymbolicFactorizations)
+            .def("GetNumberOfNumericFactorizations",&SupernodalCholeskySolverType::GetNumberOfNumericFactorizations)
+            .def("GetNumberOfSupernodes",&SupernodalCholeskySolverType::GetNumberOfSupernodes)
+            .def("GetFactorNonZeros",&SupernodalCholeskySolverType::GetFactorNonZeros)
+            .def("__str__", PrintObject<SupernodalCholeskySolverType>);
+
+        using MixedPrecisionRefinementSolverType = MixedPrecisionRefinementSolver<SpaceType,  LocalSpaceType>;
+        py::class_<MixedPrecisionRefinementSolverType, MixedPrecisionRefinementSolverType::Pointer, DirectSolverType>(m,"MixedPrecisionRefinementSolver")
+            .def(py::init<Parameters>())
+            .def("SetMaxConditionNumber",&MixedPrecisionRefinementSolverType::SetMaxConditionNumber)
+            .def("GetMaxConditionNumber",&MixedPrecisionRefinementSolverType::GetMaxConditionNumber)
+            .def("GetConditionEstimate",&MixedPrecisionRefinementSolverType::GetConditionEstimate)
+            .def("GetResidualNorm",&MixedPrecisionRefinementSolverType::GetResidualNorm)
+            .def("IsUsingFallback",&MixedPrecisionRefinementSolverType::IsUsingFallback)
+            .def("__str__", PrintObject<MixedPrecisionRefinementSolverType>);
+
         py::class<ComplexDirectSolverType, ComplexDirectSolverType::Pointer, ComplexLinearSolverType>(m,"ComplexDirectSolver")
             .def(py::init< >() )
             .def(py::init<Parameters>())
@@ -123,6 +277,8 @@ namespace Quest::Python{
         py::class_<ComplexSkylineLUSolverType, typename ComplexSkylineLUSolverType::Pointer, ComplexDirectSolverType>(m,"ComplexSkylineLUSolver")
             .def(py::init< >())
             .def(py::init<Parameters&>())
+            .def("GetNumberOfSymbolicFactorizations",&ComplexSkylineLUSolverType::GetNumberOfSymbolicFactorizations)
+            .def("GetNumberOfNumericFactorizations",&ComplexSkylineLUSolverType::GetNumberOfNumericFactorizations)
             .def("__str__", PrintObject<ComplexSkylineLUSolverType>);
     }
 
@@ -27,7 +27,17 @@ namespace Quest::Python{
             .def("IsEmpty", &SparseGraph<IndexType>::IsEmpty)
             .def("AddEntry", &SparseGraph<IndexType>::AddEntry)
             .def("Finalize", &SparseGraph<IndexType>::Finalize)
-            .def("GetGraph", &SparseGraph<IndexType>::GetGraph, py::return_value_policy::reference_internal)
+            .def("GetGraph", [](SparseGraph<IndexType>& self){
+                self.Finalize();
+                std::map<IndexType, std::vector<IndexType>> graph;
+                for(auto it = self.begin(); it != self.end(); ++it){
+                    const auto row = *it;
+                    if(row.size() != 0){
+                        graph[it.GetRowIndex()] = std::vector<IndexType>(row.begin(), row.end());
+                    }
+                }
+                return graph;
+            })
             .def("AddEntries", [](SparseGraph<IndexType>& self, std::vector<IndexType>& indices){
                 self.AddEntries(indices);
             })
@@ -51,7 +61,14 @@ namespace Quest::Python{
                 self.AddEntries(row_indices, col_indices);
             })
             .def("Finalize", &SparseContiguousRowGraph<IndexType>::Finalize)
-            .def("GetGraph", &SparseContiguousRowGraph<IndexType>::GetGraph)
+            .def("GetGraph", [](const SparseContiguousRowGraph<IndexType>& self){
+                std::vector<std::vector<IndexType>> graph(self.Size());
+                for(IndexType i = 0; i < self.Size(); ++i){
+                    const auto row = self[i];
+                    graph[i] = std::vector<IndexType>(row.begin(), row.end());
+                }
+                return graph;
+            })
             .def("ExportSingleVectorRepresentation", &SparseContiguousRowGraph<IndexType>::ExportSingleVectorRepresentation)
             .def("__str__", PrintObject<SparseContiguousRowGraph<IndexType>>);
 
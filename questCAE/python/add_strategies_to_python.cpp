@@ -7,11 +7,14 @@
 #include "solving_strats/strategies/solving_strategy.hpp"
 #include "solving_strats/strategies/implicit_solving_strategy.hpp"
 #include "solving_strats/strategies/explicit_solving_strategy.hpp"
+#include "solving_strats/strategies/residual_based_newton_raphson_strategy.hpp"
 
 #include "solving_strategies/schemes/scheme.hpp"
 
 #include "solving_strategies/builder_and_solvers/builder_and_solver.hpp"
 #include "solving_strategies/builder_and_solvers/explicit_builder.hpp"
+#include "solving_strategies/builder_and_solvers/residual_based_block_builder_and_solver.hpp"
+#include "solving_strategies/builder_and_solvers/residual_based_elimination_builder_and_solver.hpp"
 
 #include "linear_solvers/linear_solver.hpp"
 
@@ -185,6 +188,8 @@ namespace Quest::Python{
             .def("GetCalculateReactionsFlag", &BuilderAndSolverType::GetCalculateReactionsFlag)
             .def("SetDofSetIsInitializedFlag", &BuilderAndSolverType::SetDofSetIsInitializedFlag)
             .def("GetDofSetIsInitializedFlag", &BuilderAndSolverType::GetDofSetIsInitializedFlag)
+            .def("SetReuseFactorizationFlag", &BuilderAndSolverType::SetReuseFactorizationFlag)
+            .def("GetReuseFactorizationFlag", &BuilderAndSolverType::GetReuseFactorizationFlag)
             .def("SetReshapeMatrixFlag", &BuilderAndSolverType::SetReshapeMatrixFlag)
             .def("GetReshapeMatrixFlag", &BuilderAndSolverType::GetReshapeMatrixFlag)
             .def("GetEquationSystemSize", &BuilderAndSolverType::GetEquationSystemSize)
@@ -209,8 +214,27 @@ namespace Quest::Python{
             .def("GetDefaultParameters",&BuilderAndSolverType::GetDefaultParameters)
             .def("SetEchoLevel", &BuilderAndSolverType::SetEchoLevel)
             .def("GetEchoLevel", &BuilderAndSolverType::GetEchoLevel)
+            .def("GetSystemStructureIsBuilt", &BuilderAndSolverType::GetSystemStructureIsBuilt)
+            .def("GetNumberOfStructureBuilds", &BuilderAndSolverType::GetNumberOfStructureBuilds)
+            .def("IsBuildRequired", &BuilderAndSolverType::IsBuildRequired)
             .def("Info", &BuilderAndSolverType::Info);
 
+        using ResidualBasedBlockBuilderAndSolverType = ResidualBasedBlockBuilderAndSolver< SparseSpaceType, LocalSpaceType, LinearSolverType >;
+
+        py::class_< ResidualBasedBlockBuilderAndSolverType, typename ResidualBasedBlockBuilderAndSolverType::Pointer, BuilderAndSolverType>(m,"ResidualBasedBlockBuilderAndSolver")
+            .def(py::init<LinearSolverType::Pointer > ())
+            .def(py::init<LinearSolverType::Pointer, Parameters >() )
+            .def("GetScaleFactor", &ResidualBasedBlockBuilderAndSolverType::GetScaleFactor);
+
+        using ResidualBasedEliminationBuilderAndSolverType = ResidualBasedEliminationBuilderAndSolver< SparseSpaceType, LocalSpaceType, LinearSolverType >;
+
+        py::class_< ResidualBasedEliminationBuilderAndSolverType, typename ResidualBasedEliminationBuilderAndSolverType::Pointer, BuilderAndSolverType>(m,"ResidualBasedEliminationBuilderAndSolver")
+            .def(py::init<LinearSolverType::Pointer > ())
+            .def(py::init<LinearSolverType::Pointer, Parameters >() )
+            .def("GetNumberOfFixedDofs", &ResidualBasedEliminationBuilderAndSolverType::GetNumberOfFixedDofs)
+            .def("GetFixedDofIncrements", &ResidualBasedEliminationBuilderAndSolverType::GetFixedDofIncrements, py::return_value_policy::reference_internal)
+            .def("GetAppliedFixedDofIncrements", &ResidualBasedEliminationBuilderAndSolverType::GetAppliedFixedDofIncrements, py::return_value_policy::reference_internal);
+
 
         using ExplicitBuilderType = ExplicitBuilder< SparseSpaceType, LocalSpaceType >;
 
@@ -287,6 +311,23 @@ namespace Quest::Python{
             .def("GetStiffnessMatrixIsBuilt", &ImplicitSolvingStrategyType::GetStiffnessMatrixIsBuilt);
 
 
+        using ResidualBasedNewtonRaphsonStrategyType = ResidualBasedNewtonRaphsonStrategy< SparseSpaceType, LocalSpaceType, LinearSolverType >;
+        py::class_<ResidualBasedNewtonRaphsonStrategyType, typename ResidualBasedNewtonRaphsonStrategyType::Pointer, ImplicitSolvingStrategyType>(m,"ResidualBasedNewtonRaphsonStrategy")
+            .def(py::init<ModelPart&, BaseSchemeType::Pointer, BuilderAndSolverType::Pointer, Parameters >() )
+            .def(py::init<ModelPart&, BaseSchemeType::Pointer, BuilderAndSolverType::Pointer, int, bool, bool, bool >())
+            .def("GetNewtonType", &ResidualBasedNewtonRaphsonStrategyType::GetNewtonType)
+            .def("SetTangentUpdateInterval", &ResidualBasedNewtonRaphsonStrategyType::SetTangentUpdateInterval)
+            .def("GetTangentUpdateInterval", &ResidualBasedNewtonRaphsonStrategyType::GetTangentUpdateInterval)
+            .def("SetMaxIterationNumber", &ResidualBasedNewtonRaphsonStrategyType::SetMaxIterationNumber)
+            .def("GetMaxIterationNumber", &ResidualBasedNewtonRaphsonStrategyType::GetMaxIterationNumber)
+            .def("GetIterationNumber", &ResidualBasedNewtonRaphsonStrategyType::GetIterationNumber)
+            .def("GetNumberOfTangentUpdates", &ResidualBasedNewtonRaphsonStrategyType::GetNumberOfTangentUpdates)
+            .def("SetCalculateReactionsFlag", &ResidualBasedNewtonRaphsonStrategyType::SetCalculateReactionsFlag)
+            .def("GetCalculateReactionsFlag", &ResidualBasedNewtonRaphsonStrategyType::GetCalculateReactionsFlag)
+            .def("GetScheme", &ResidualBasedNewtonRaphsonStrategyType::GetScheme)
+            .def("GetBuilderAndSolver", &ResidualBasedNewtonRaphsonStrategyType::GetBuilderAndSolver);
+
+
         using BaseExplicitSolvingStrategyType = ExplicitSolvingStrategy< SparseSpaceType, LocalSpaceType >
         py::class_< BaseExplicitSolvingStrategyType, typename BaseExplicitSolvingStrategyType::Pointer, BaseSolvingStrategyType >(m,"BaseExplicitSolvingStrategy")
             .def(py::init<ModelPart &, bool, int>())
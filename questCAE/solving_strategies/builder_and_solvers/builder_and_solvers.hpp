@@ -3,12 +3,21 @@
 
 // 系统头文件
 #include <set>
+#include <vector>
+#include <unordered_set>
+#include <numeric>
 
 // 项目头文件
 #include "includes/define.hpp"
+#include "includes/key_hash.hpp"
 #include "includes/model_part.hpp"
 #include "solving_strategies/schemes/schemes.hpp"
 #include "includes/quest_parameters.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+#include "utilities/entity_coloring_utilities.hpp"
+#include "utilities/entity_batching_utilities.hpp"
+#include "utilities/scratch_arena.hpp"
 
 namespace Quest{
 
@@ -39,6 +48,10 @@ namespace Quest{
             using ElementsArrayType =  ModelPart::ElementsContainerType;
             using ConditionsArrayType = ModelPart::ConditionsContainerType;
             using ElementsContainerType = PointerVectorSet<Element, IndexedObject>;
+            using DofsVectorType = ModelPart::DofsVectorType;
+            using DofSetType = std::unordered_set<typename TDofType::Pointer, DofPointerHasher>;
+            using EquationIdVectorType = Element::EquationIdVectorType;
+            using IndexVectorType = std::vector<IndexType>;
 
         public:
             /**
@@ -105,6 +118,47 @@ namespace Quest{
             }
 
 
+            /**
+             * @brief 返回是否按着色分批（无原子操作）组装的标志
+             */
+            bool GetUseColoringFlag() const
+            {
+                return mUseColoring;
+            }
+
+
+            /**
+             * @brief 设置是否按着色分批（无原子操作）组装的标志
+             */
+            void SetUseColoringFlag(bool flag)
+            {
+                mUseColoring = flag;
+            }
+
+
+            /**
+             * @brief 返回是否沿用线性求解器已有分解的标志
+             */
+            bool GetReuseFactorizationFlag() const
+            {
+                return mReuseFactorization;
+            }
+
+
+            /**
+             * @brief 设置是否沿用线性求解器已有分解的标志
+             * @details 由求解策略设置：左端矩阵自上次求解以来未重新组装时设为 true，此时求解只执行回代；
+             *  重新组装左端矩阵后须设为 false，同时使已有的分解失效
+             */
+            void SetReuseFactorizationFlag(bool flag)
+            {
+                mReuseFactorization = flag;
+                if(!flag){
+                    mFactorizationIsValid = false;
+                }
+            }
+
+
             /**
              * @brief 返回自由度集合是否初始化的标志
              */
@@ -150,6 +204,53 @@ namespace Quest{
             }
 
 
+            /**
+             * @brief 返回稀疏模式是否已构建
+             */
+            bool GetSystemStructureIsBuilt() const
+            {
+                return mSystemStructureIsBuilt;
+            }
+
+
+            /**
+             * @brief 返回稀疏模式的构建次数
+             */
+            IndexType GetNumberOfStructureBuilds() const
+            {
+                return mNumberOfStructureBuilds;
+            }
+
+
+            /**
+             * @brief 下一次组装是否必须调用 Build，而不能只调用 BuildRHS
+             * @details 某些右端贡献只在组装左端矩阵时才能得到（例如消去型构建器待施加的约束自由度给定增量），
+             *  复用切线的求解策略应在此时重新组装左端矩阵。默认返回 false
+             */
+            virtual bool IsBuildRequired() const
+            {
+                return false;
+            }
+
+
+            /**
+             * @brief 计算约束状态的指纹（约束自由度在自由度集合中的位置）
+             * @param rDofSet 排序后的自由度集合
+             */
+            static std::size_t ComputeFixityHash(const DofsArrayType& rDofSet)
+            {
+                const auto it_begin = rDofSet.begin();
+                return IndexPartition<std::size_t>(rDofSet.size()).template for_each<Internals::SumReduction<std::size_t>>([&](std::size_t i){
+                    if(!(it_begin + i)->IsFixed()){
+                        return std::size_t(0);
+                    }
+                    HashType seed = 0;
+                    HashCombine(seed, i);
+                    return static_cast<std::size_t>(seed);
+                });
+            }
+
+
             /**
              * @brief 返回线性求解器对象指针
              */
@@ -389,13 +490,81 @@ namespace Quest{
             /**
              * @brief 通过“询问”每个元素和条件的 Dof 来构建问题中涉及的 DofSets 列表。
              * @details Dof 列表存储在 BuilderAndSolver 中，因为它与矩阵和 RHS 的构建方式密切相关。
+             *  并行收集单元与条件的自由度并排序；显式调用时总是重新收集，使已有的稀疏模式失效并记录当前的拓扑
              * @param pScheme 积分方案的指针
              * @param rModelPart 要计算的模型部分
              */
             virtual void SetUpDofSet(
                 typename TSchemeType::Pointer pScheme,
                 ModelPart& rModelPart
-            ){}
+            ){
+                QUEST_TRY
+
+                QUEST_INFO_IF("BuilderAndSolver", this->GetEchoLevel() > 1) << "Setting up the dofs" << std::endl;
+
+                const auto& r_elements_array = rModelPart.Elements();
+                const auto& r_conditions_array = rModelPart.Conditions();
+                const int n_elems = static_cast<int>(r_elements_array.size());
+                const int n_conds = static_cast<int>(r_conditions_array.size());
+
+                DofSetType dof_global_set;
+                dof_global_set.reserve(n_elems*20);
+
+                DofsVectorType dof_list;
+
+                #pragma omp parallel firstprivate(dof_list)
+                {
+                    const auto& r_process_info = rModelPart.GetProcessInfo();
+
+                    DofSetType dofs_tmp_set;
+                    dofs_tmp_set.reserve(20000);
+
+                    #pragma omp for schedule(guided, 512) nowait
+                    for(int i_elem = 0; i_elem < n_elems; ++i_elem){
+                        const auto it_elem = r_elements_array.begin() + i_elem;
+                        pScheme->GetDofList(*it_elem, dof_list, r_process_info);
+                        dofs_tmp_set.insert(dof_list.begin(), dof_list.end());
+                    }
+
+                    #pragma omp for schedule(guided, 512) nowait
+                    for(int i_cond = 0; i_cond < n_conds; ++i_cond){
+                        const auto it_cond = r_conditions_array.begin() + i_cond;
+                        pScheme->GetDofList(*it_cond, dof_list, r_process_info);
+                        dofs_tmp_set.insert(dof_list.begin(), dof_list.end());
+                    }
+
+                    #pragma omp critical
+                    {
+                        dof_global_set.insert(dofs_tmp_set.begin(), dofs_tmp_set.end());
+                    }
+                }
+
+                DofsArrayType temp_dof_set;
+                temp_dof_set.reserve(dof_global_set.size());
+                for(auto it_dof = dof_global_set.begin(); it_dof != dof_global_set.end(); ++it_dof){
+                    temp_dof_set.push_back(*it_dof);
+                }
+                temp_dof_set.Sort();
+                mDofSet = temp_dof_set;
+
+                QUEST_ERROR_IF(mDofSet.size() == 0) << "No degrees of freedom!" << std::endl;
+
+                if(GetCalculateReactionsFlag()){
+                    for(auto it_dof = mDofSet.begin(); it_dof != mDofSet.end(); ++it_dof){
+                        QUEST_ERROR_IF_NOT(it_dof->HasReaction()) << "Reaction variable not set for the following : " << std::endl
+                            << "Node : " << it_dof->Id() << std::endl
+                            << "Dof : " << (*it_dof) << std::endl << "Not possible to calculate reactions." << std::endl;
+                    }
+                }
+
+                mDofSetIsInitialized = true;
+                mSystemStructureIsBuilt = false;
+                StoreTopology(rModelPart);
+
+                QUEST_INFO_IF("BuilderAndSolver", this->GetEchoLevel() > 2) << "Number of degrees of freedom:" << mDofSet.size() << std::endl;
+
+                QUEST_CATCH("")
+            }
 
 
             /**
@@ -439,6 +608,8 @@ namespace Quest{
 
             /**
              * @brief 在解算步骤开始时对方程系统应用某些操作
+             * @details 重置各线程的临时内存池：上一步中扩容出的多个块合并为一个块，最大占用重新统计。
+             *  派生类重写时须调用此实现
              * @param rModelPart 要计算的模型部分
              * @param rA 方程系统的 LHS 矩阵
              * @param rDx 未知数的向量
@@ -449,7 +620,9 @@ namespace Quest{
                 TSystemMatrixType& rA,
                 TSystemVectorType& rDx,
                 TSystemVectorType& rb
-            ){}
+            ){
+                ScratchArena::ResetThreadLocalArenas();
+            }
 
 
             /**
@@ -492,6 +665,15 @@ namespace Quest{
                 this->mDofSet = DofsArrayType();
                 this->mpReactionsVector.reset();
                 if (this->mpLinearSystemSolver != nullptr) this->mpLinearSystemSolver->Clear();
+                this->mFactorizationIsValid = false;
+                this->mDofSetIsInitialized = false;
+                this->mSystemStructureIsBuilt = false;
+                this->mColoringIsBuilt = false;
+                this->mBatchingIsBuilt = false;
+                IndexVectorType().swap(this->mElementEquationIdOffsets);
+                IndexVectorType().swap(this->mElementEquationIds);
+                IndexVectorType().swap(this->mConditionEquationIdOffsets);
+                IndexVectorType().swap(this->mConditionEquationIds);
 
                 QUEST_INFO_IF("BuilderAndSolver", this->GetEchoLevel() > 0) << "Clear Function called" << std::endl;
             }
@@ -520,8 +702,11 @@ namespace Quest{
             {
                 const Parameters default_parameters = Parameters(R"(
                 {
-                    "name"       : "builder_and_solver",
-                    "echo_level" : 1
+                    "name"                 : "builder_and_solver",
+                    "echo_level"           : 1,
+                    "use_coloring"         : false,
+                    "use_batched_assembly" : false,
+                    "batch_size"           : 0
                 })" );
                 return default_parameters;
             }
@@ -612,6 +797,242 @@ namespace Quest{
              */
             virtual void AssignSettings(const Parameters ThisParameters){
                 mEchoLevel = ThisParameters["echo_level"].GetInt();
+                mUseColoring = ThisParameters["use_coloring"].GetBool();
+
+                mUseBatchedAssembly = ThisParameters["use_batched_assembly"].GetBool();
+                const int batch_size = ThisParameters["batch_size"].GetInt();
+                QUEST_ERROR_IF(batch_size < 0) << "The batch_size must be non-negative. Got " << batch_size << std::endl;
+                mBatchSize = batch_size == 0 ? LocalSystemBatch::GetDefaultBatchSize() : static_cast<IndexType>(batch_size);
+            }
+
+
+            /**
+             * @brief 调用线性求解器求解
+             * @details 设置了 ReuseFactorization 标志、上一次求解之后已有分解且线性求解器支持沿用分解时只调用 PerformSolutionStep，
+             *  否则调用 Solve（重新分解）
+             */
+            void InternalSystemSolve(
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ){
+                if(mReuseFactorization && mFactorizationIsValid && mpLinearSystemSolver->FactorizationIsReusable()){
+                    mpLinearSystemSolver->PerformSolutionStep(rA, rDx, rb);
+                } else {
+                    mpLinearSystemSolver->Solve(rA, rDx, rb);
+                    mFactorizationIsValid = true;
+                }
+            }
+
+
+            /**
+             * @brief 组装时的线程局部存储
+             */
+            struct AssemblyTLS{
+                LocalSystemMatrixType LHS;
+                LocalSystemVectorType RHS;
+                EquationIdVectorType EquationIds;
+            };
+
+
+            /**
+             * @brief 批量组装时的线程局部存储
+             */
+            template<typename TEntityType>
+            struct BatchAssemblyTLS{
+                LocalSystemBatch Batch;
+                std::vector<TEntityType*> Entities;
+                IndexVectorType Indices;
+            };
+
+
+            /**
+             * @brief 缓存所有单元与条件的方程编号（两遍：计数、填充）
+             */
+            void CollectEquationIds(TSchemeType& rScheme, ModelPart& rModelPart)
+            {
+                const auto& r_process_info = rModelPart.GetProcessInfo();
+                CollectEntityEquationIds(rScheme, rModelPart.Elements(), r_process_info, mElementEquationIdOffsets, mElementEquationIds);
+                CollectEntityEquationIds(rScheme, rModelPart.Conditions(), r_process_info, mConditionEquationIdOffsets, mConditionEquationIds);
+                mColoringIsBuilt = false;
+                mBatchingIsBuilt = false;
+            }
+
+
+            template<typename TContainerType>
+            static void CollectEntityEquationIds(
+                TSchemeType& rScheme,
+                TContainerType& rEntities,
+                const ProcessInfo& rProcessInfo,
+                IndexVectorType& rOffsets,
+                IndexVectorType& rEquationIds
+            ){
+                const IndexType n_entities = rEntities.size();
+                const auto it_begin = rEntities.begin();
+
+                rOffsets.resize(n_entities + 1);
+                rOffsets[0] = 0;
+                IndexPartition<IndexType>(n_entities).for_each(EquationIdVectorType(), [&](IndexType i, EquationIdVectorType& rIds){
+                    rScheme.EquationId(*(it_begin + i), rIds, rProcessInfo);
+                    rOffsets[i+1] = rIds.size();
+                });
+                std::partial_sum(rOffsets.begin(), rOffsets.end(), rOffsets.begin());
+
+                rEquationIds.resize(rOffsets[n_entities]);
+                IndexPartition<IndexType>(n_entities).for_each(EquationIdVectorType(), [&](IndexType i, EquationIdVectorType& rIds){
+                    rScheme.EquationId(*(it_begin + i), rIds, rProcessInfo);
+                    QUEST_DEBUG_ERROR_IF(rIds.size() != rOffsets[i+1] - rOffsets[i]) << "The equation ids of entity " << i << " changed between two calls" << std::endl;
+                    std::copy(rIds.begin(), rIds.end(), rEquationIds.begin() + rOffsets[i]);
+                });
+            }
+
+
+            /**
+             * @brief 保证单元与条件的着色与缓存的方程编号一致
+             * @details 按方程编号着色：两个实体的方程编号有交集时视为冲突，因此同一颜色内的实体写入的全局行与右端项分量互不相同。
+             *  不使用 ModelPart::GetColoring() 的按节点着色，因为方程编号可能包含实体几何以外的自由度
+             */
+            void EnsureColoring()
+            {
+                if(mColoringIsBuilt){
+                    return;
+                }
+
+                mElementColoring = EntityColoringUtilities::ColorByIndices(mElementEquationIdOffsets, mElementEquationIds);
+                mConditionColoring = EntityColoringUtilities::ColorByIndices(mConditionEquationIdOffsets, mConditionEquationIds);
+                mColoringIsBuilt = true;
+
+                QUEST_INFO_IF("BuilderAndSolver", this->GetEchoLevel() > 2) << "Colored assembly. Element colors : "
+                    << mElementColoring.NumberOfColors() << " condition colors : " << mConditionColoring.NumberOfColors() << std::endl;
+            }
+
+
+            /**
+             * @brief 保证单元与条件的分批与缓存的方程编号（以及着色）一致
+             */
+            void EnsureBatching(ModelPart& rModelPart)
+            {
+                if(mBatchingIsBuilt
+                    && mElementBatching.NumberOfEntities() == rModelPart.Elements().size()
+                    && mConditionBatching.NumberOfEntities() == rModelPart.Conditions().size()){
+                    return;
+                }
+
+                if(mUseColoring){
+                    EnsureColoring();
+                    mElementBatching = EntityBatchingUtilities::BatchEntities(rModelPart.Elements(), mElementEquationIdOffsets, mElementColoring, mBatchSize);
+                    mConditionBatching = EntityBatchingUtilities::BatchEntities(rModelPart.Conditions(), mConditionEquationIdOffsets, mConditionColoring, mBatchSize);
+                } else {
+                    mElementBatching = EntityBatchingUtilities::BatchEntities(rModelPart.Elements(), mElementEquationIdOffsets, mBatchSize);
+                    mConditionBatching = EntityBatchingUtilities::BatchEntities(rModelPart.Conditions(), mConditionEquationIdOffsets, mBatchSize);
+                }
+                mBatchingIsBuilt = true;
+
+                QUEST_INFO_IF("BuilderAndSolver", this->GetEchoLevel() > 2) << "Batched assembly. Element batches : "
+                    << mElementBatching.NumberOfBatches() << " condition batches : " << mConditionBatching.NumberOfBatches() << std::endl;
+            }
+
+
+            /**
+             * @brief 逐颜色并行遍历激活的实体，同一颜色的实体不共享方程编号
+             * @param rFunction 以 (实体, 实体序号, AssemblyTLS&) 调用
+             */
+            template<typename TContainerType, typename TFunction>
+            static void ForEachColoredEntity(
+                TContainerType& rEntities,
+                const EntityColoring& rColoring,
+                TFunction&& rFunction
+            ){
+                QUEST_DEBUG_ERROR_IF(rColoring.NumberOfEntities() != rEntities.size()) << "The coloring does not match the container. Number of colored entities : "
+                    << rColoring.NumberOfEntities() << " number of entities : " << rEntities.size() << std::endl;
+
+                const auto it_begin = rEntities.begin();
+                for(IndexType c=0; c<rColoring.NumberOfColors(); ++c){
+                    const auto color = rColoring.GetColor(c);
+                    IndexPartition<IndexType>(color.size()).for_each(AssemblyTLS(), [&](IndexType k, AssemblyTLS& rTLS){
+                        const IndexType i = color[k];
+                        auto& r_entity = *(it_begin + i);
+                        if(r_entity.IsActive()){
+                            rFunction(r_entity, i, rTLS);
+                        }
+                    });
+                }
+            }
+
+
+            /**
+             * @brief 逐颜色并行遍历分批，通过方案的 CalculateSystemContributionsBatch 计算每批激活实体的局部系统
+             * @details 不着色时所有批属于同一种颜色；着色时同一颜色内的批不共享自由度
+             * @param rScatter 以 (LocalSystemBatch, 各通道对应的实体序号) 调用，负责把局部系统累加到全局系统
+             */
+            template<typename TEntityType, typename TContainerType, typename TFunction>
+            static void ForEachBatch(
+                TSchemeType& rScheme,
+                TContainerType& rEntities,
+                const EntityBatching& rBatching,
+                const ProcessInfo& rProcessInfo,
+                TFunction&& rScatter
+            ){
+                const auto it_begin = rEntities.begin();
+
+                for(IndexType c=0; c<rBatching.NumberOfColors(); ++c){
+                    const auto batches = rBatching.GetColorBatches(c);
+                    IndexPartition<IndexType>(batches.second - batches.first).for_each(BatchAssemblyTLS<TEntityType>(), [&](IndexType k, BatchAssemblyTLS<TEntityType>& rTLS){
+                        rTLS.Entities.clear();
+                        rTLS.Indices.clear();
+                        for(const IndexType i : rBatching.GetBatch(batches.first + k)){
+                            auto& r_entity = *(it_begin + i);
+                            if(r_entity.IsActive()){
+                                rTLS.Entities.push_back(&r_entity);
+                                rTLS.Indices.push_back(i);
+                            }
+                        }
+                        if(rTLS.Entities.empty()){
+                            return;
+                        }
+
+                        ScratchArena::Scope scratch_scope(rProcessInfo.GetScratchArena());
+
+                        rScheme.CalculateSystemContributionsBatch(Quest::span<TEntityType* const>(rTLS.Entities.data(), rTLS.Entities.size()), rTLS.Batch, rProcessInfo);
+                        QUEST_DEBUG_ERROR_IF(rTLS.Batch.NumberOfLanes() != rTLS.Indices.size()) << "The batch has " << rTLS.Batch.NumberOfLanes()
+                            << " lanes but " << rTLS.Indices.size() << " entities were requested" << std::endl;
+
+                        rScatter(rTLS.Batch, rTLS.Indices);
+                    });
+                }
+            }
+
+
+            /**
+             * @brief 计算单元与条件的拓扑指纹（与实体顺序、编号及节点连接有关）
+             */
+            static std::size_t ComputeTopologyHash(const ModelPart& rModelPart)
+            {
+                HashType seed = EntityColoringUtilities::ComputeConnectivityHash(rModelPart.Elements());
+                HashCombine(seed, EntityColoringUtilities::ComputeConnectivityHash(rModelPart.Conditions()));
+                return seed;
+            }
+
+
+            /**
+             * @brief 记录当前的拓扑
+             */
+            void StoreTopology(const ModelPart& rModelPart)
+            {
+                mNumberOfElements = rModelPart.Elements().size();
+                mNumberOfConditions = rModelPart.Conditions().size();
+                mTopologyHash = ComputeTopologyHash(rModelPart);
+            }
+
+
+            /**
+             * @brief 判断拓扑是否与上一次构建自由度集合时不同
+             */
+            bool IsTopologyChanged(const ModelPart& rModelPart) const
+            {
+                return mNumberOfElements != rModelPart.Elements().size()
+                    || mNumberOfConditions != rModelPart.Conditions().size()
+                    || mTopologyHash != ComputeTopologyHash(rModelPart);
             }
 
 
@@ -651,11 +1072,113 @@ namespace Quest{
              */
             int mEchoLevel = 0;
 
+            /**
+             * @brief 是否按着色分批组装
+             * @details 为真时派生类应调用 EnsureColoring()，按 mElementColoring 与 mConditionColoring 逐颜色遍历单元与条件，
+             *  并以 AssembleNonAtomic 等非原子接口组装全局矩阵与向量
+             */
+            bool mUseColoring = false;
+
+            /**
+             * @brief 是否沿用线性求解器已有的分解
+             */
+            bool mReuseFactorization = false;
+
+            /**
+             * @brief 线性求解器中是否有与当前左端矩阵一致的分解
+             */
+            bool mFactorizationIsValid = false;
+
             /**
              * @brief 指向反力向量的指针
              */
             TSystemVectorPointerType mpReactionsVector;
 
+            /**
+             * @brief 各单元方程编号在 mElementEquationIds 中的起始位置
+             */
+            IndexVectorType mElementEquationIdOffsets;
+
+            /**
+             * @brief 所有单元的方程编号，按单元依次存放
+             */
+            IndexVectorType mElementEquationIds;
+
+            /**
+             * @brief 各条件方程编号在 mConditionEquationIds 中的起始位置
+             */
+            IndexVectorType mConditionEquationIdOffsets;
+
+            /**
+             * @brief 所有条件的方程编号，按条件依次存放
+             */
+            IndexVectorType mConditionEquationIds;
+
+            /**
+             * @brief 单元与条件的着色是否与缓存的方程编号一致
+             */
+            bool mColoringIsBuilt = false;
+
+            /**
+             * @brief 按方程编号的单元着色
+             */
+            EntityColoring mElementColoring;
+
+            /**
+             * @brief 按方程编号的条件着色
+             */
+            EntityColoring mConditionColoring;
+
+            /**
+             * @brief 稀疏模式是否有效
+             */
+            bool mSystemStructureIsBuilt = false;
+
+            /**
+             * @brief 稀疏模式的构建次数
+             */
+            IndexType mNumberOfStructureBuilds = 0;
+
+            /**
+             * @brief 是否批量计算局部系统
+             */
+            bool mUseBatchedAssembly = false;
+
+            /**
+             * @brief 批大小的上限
+             */
+            IndexType mBatchSize = 1;
+
+            /**
+             * @brief 单元与条件的分批是否有效
+             */
+            bool mBatchingIsBuilt = false;
+
+            /**
+             * @brief 单元的分批
+             */
+            EntityBatching mElementBatching;
+
+            /**
+             * @brief 条件的分批
+             */
+            EntityBatching mConditionBatching;
+
+            /**
+             * @brief 构建自由度集合时的单元个数
+             */
+            std::size_t mNumberOfElements = 0;
+
+            /**
+             * @brief 构建自由度集合时的条件个数
+             */
+            std::size_t mNumberOfConditions = 0;
+
+            /**
+             * @brief 构建自由度集合时的拓扑指纹
+             */
+            std::size_t mTopologyHash = 0;
+
         private:
 
     };
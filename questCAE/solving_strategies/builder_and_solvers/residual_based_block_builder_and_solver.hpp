@@ -0,0 +1,891 @@
+#ifndef QUEST_RESIDUAL_BASED_BLOCK_BUILDER_AND_SOLVER_HPP
+#define QUEST_RESIDUAL_BASED_BLOCK_BUILDER_AND_SOLVER_HPP
+
+// 系统头文件
+#include <vector>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/model_part.hpp"
+#include "includes/quest_parameters.hpp"
+#include "solving_strategies/builder_and_solvers/builder_and_solvers.hpp"
+#include "container/sparse_graph_builder.hpp"
+#include "container/csr_assembly_plan.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/atomic_utilities.hpp"
+#include "utilities/scratch_arena.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ResidualBasedBlockBuilderAndSolver
+     * @brief 基于残差的块构建器：所有自由度（包括约束自由度）都保留在方程系统中
+     * @details 自由度集合、稀疏模式以及各单元/条件的方程编号与组装计划（CsrAssemblyPlan）只在以下情况下重新构建：
+     *  首次调用 ResizeAndInitializeVectors、SetReshapeMatrixFlag(true)、调用 SetUpDofSet/Clear，
+     *  或模型拓扑发生变化（单元/条件的个数、编号或节点连接与上一次构建时不同）。
+     *  其余时间步之间只重置矩阵与向量的数值，由求解策略的重建级别决定调用 Build 还是只调用 BuildRHS。
+     *  稀疏模式由 SparseGraphBuilder 按缓存的方程编号两遍并行构建，并直接写入CSR矩阵的数组。
+     *  组装时单元与条件在同一个并行区内计算局部系统，左端矩阵按组装计划中的偏移量直接累加到值数组，
+     *  右端向量按缓存的方程编号累加，默认使用原子加；use_coloring 为真时按着色分批，使用普通加法。
+     *  use_batched_assembly 为真时 Build 把动态类型与局部尺寸相同的实体分为不超过 batch_size（0 表示SIMD宽度）的批，
+     *  通过方案的 CalculateSystemContributionsBatch 批量计算局部系统，方案的批量实现须与 CalculateSystemContributions 一致。
+     *  Dirichlet 条件直接在CSR结构上施加：约束行只保留对角元（取 diagonal_values_for_dirichlet_dofs 给出的缩放值），
+     *  自由行中约束列的元素置零，约束自由度对应的右端项置零。
+     *  主从约束（MasterSlaveConstraint）暂不支持
+     * @tparam TSparseSpace 稀疏空间类型
+     * @tparam TDenseSpace 稠密空间类型
+     * @tparam TLinearSolver 线性求解器类型
+     */
+    template<typename TSparseSpace, typename TDenseSpace, typename TLinearSolver>
+    class ResidualBasedBlockBuilderAndSolver : public BuilderAndSolver<TSparseSpace, TDenseSpace, TLinearSolver>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(ResidualBasedBlockBuilderAndSolver);
+
+            using BaseType = BuilderAndSolver<TSparseSpace, TDenseSpace, TLinearSolver>;
+            using ClassType = ResidualBasedBlockBuilderAndSolver<TSparseSpace, TDenseSpace, TLinearSolver>;
+            using SizeType = typename BaseType::SizeType;
+            using IndexType = typename BaseType::IndexType;
+            using TDataType = typename BaseType::TDataType;
+            using TSystemMatrixType = typename BaseType::TSystemMatrixType;
+            using TSystemVectorType = typename BaseType::TSystemVectorType;
+            using TSystemMatrixPointerType = typename BaseType::TSystemMatrixPointerType;
+            using TSystemVectorPointerType = typename BaseType::TSystemVectorPointerType;
+            using LocalSystemMatrixType = typename BaseType::LocalSystemMatrixType;
+            using LocalSystemVectorType = typename BaseType::LocalSystemVectorType;
+            using TSchemeType = typename BaseType::TSchemeType;
+            using TDofType = typename BaseType::TDofType;
+            using DofsArrayType = typename BaseType::DofsArrayType;
+            using EquationIdVectorType = typename BaseType::EquationIdVectorType;
+            using IndexVectorType = typename BaseType::IndexVectorType;
+            using AssemblyTLS = typename BaseType::AssemblyTLS;
+            using AssemblyPlanType = CsrAssemblyPlan<IndexType>;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            explicit ResidualBasedBlockBuilderAndSolver() : BaseType(){}
+
+
+            /**
+             * @brief 构造函数，基于输入参数
+             */
+            explicit ResidualBasedBlockBuilderAndSolver(
+                typename TLinearSolver::Pointer pNewLinearSystemSolver,
+                Parameters ThisParameters
+            ) : BaseType(pNewLinearSystemSolver)
+            {
+                ThisParameters = this->ValidateAndAssignParameters(ThisParameters, this->GetDefaultParameters());
+                this->AssignSettings(ThisParameters);
+            }
+
+
+            /**
+             * @brief 构造函数
+             */
+            explicit ResidualBasedBlockBuilderAndSolver(typename TLinearSolver::Pointer pNewLinearSystemSolver)
+                : BaseType(pNewLinearSystemSolver)
+            {
+            }
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~ResidualBasedBlockBuilderAndSolver() override{}
+
+
+            /**
+             * @brief 创建并返回一个新的对象指针
+             */
+            typename BaseType::Pointer Create(
+                typename TLinearSolver::Pointer pNewLinearSystemSolver,
+                Parameters ThisParameters
+            ) const override{
+                return Quest::make_shared<ClassType>(pNewLinearSystemSolver, ThisParameters);
+            }
+
+
+            /**
+             * @brief 在一次并行遍历中同时组装左端矩阵与右端向量（不施加 Dirichlet 条件）
+             * @param pScheme 指向积分方案的指针
+             * @param rModelPart 要计算的模型部分
+             * @param rA 系统方程的 LHS 矩阵，稀疏模式须由 ResizeAndInitializeVectors 构建
+             * @param rb 系统方程的 RHS 向量
+             */
+            void Build(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(!pScheme) << "No scheme provided!" << std::endl;
+
+                EnsureAssemblyPlans(*pScheme, rModelPart, rA);
+
+                TSparseSpace::SetToZero(rA);
+                TSparseSpace::SetToZero(rb);
+
+                AssembleSystem<true, true>(*pScheme, rModelPart, &rA, &rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 只组装左端矩阵（不施加 Dirichlet 条件）
+             */
+            void BuildLHS(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA
+            ) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(!pScheme) << "No scheme provided!" << std::endl;
+
+                EnsureAssemblyPlans(*pScheme, rModelPart, rA);
+
+                TSparseSpace::SetToZero(rA);
+
+                AssembleSystem<true, false>(*pScheme, rModelPart, &rA, nullptr);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 块构建器中完整矩阵即 BuildLHS 的结果
+             */
+            void BuildLHS_Complete(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA
+            ) override{
+                this->BuildLHS(pScheme, rModelPart, rA);
+            }
+
+
+            /**
+             * @brief 组装右端向量，并将约束自由度对应的项置零
+             */
+            void BuildRHS(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                BuildRHSNoDirichlet(pScheme, rModelPart, rb);
+
+                IndexPartition<std::size_t>(this->mDofSet.size()).for_each([&](std::size_t i){
+                    const auto it_dof = this->mDofSet.begin() + i;
+                    if(it_dof->IsFixed()){
+                        rb[it_dof->GetEquationId()] = TDataType();
+                    }
+                });
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 调用线性求解器，右端为零时直接返回零解，设置了 ReuseFactorization 标志时沿用已有分解
+             */
+            void SystemSolve(
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                const double norm_b = TSparseSpace::Size(rb) != 0 ? TSparseSpace::TwoNorm(rb) : 0.0;
+
+                if(norm_b != 0.0){
+                    this->InternalSystemSolve(rA, rDx, rb);
+                } else {
+                    TSparseSpace::SetToZero(rDx);
+                }
+
+                QUEST_INFO_IF("ResidualBasedBlockBuilderAndSolver", this->GetEchoLevel() > 1) << *(this->mpLinearSystemSolver) << std::endl;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 组装、施加 Dirichlet 条件并求解
+             */
+            void BuildAndSolve(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                Build(pScheme, rModelPart, rA, rb);
+
+                ApplyDirichletConditions(pScheme, rModelPart, rA, rDx, rb);
+
+                SystemSolve(rA, rDx, rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 保持已有的左端矩阵，只重新组装右端向量并求解
+             */
+            void BuildRHSAndSolve(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                BuildRHS(pScheme, rModelPart, rb);
+
+                SystemSolve(rA, rDx, rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 在CSR结构上原位施加 Dirichlet 条件
+             * @details 稀疏模式不变：约束行的非对角元与自由行中约束列的元素置零，约束行的对角元设为缩放值，
+             *  约束自由度对应的右端项置零
+             */
+            void ApplyDirichletConditions(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                ApplyDirichletConditions_LHS(pScheme, rModelPart, rA, rDx);
+                ApplyDirichletConditions_RHS(pScheme, rModelPart, rDx, rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 只对左端矩阵施加 Dirichlet 条件
+             */
+            void ApplyDirichletConditions_LHS(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx
+            ) override{
+                QUEST_TRY
+
+                const std::size_t system_size = rA.size1();
+                UpdateFixedDofsMask(system_size);
+
+                const double scale_factor = TSparseSpace::GetScaleNorm(rModelPart.GetProcessInfo(), rA, mScalingDiagonal);
+                mScaleFactor = scale_factor;
+
+                const auto& r_row_indices = rA.index1_data();
+                const auto& r_col_indices = rA.index2_data();
+                auto& r_values = rA.value_data();
+
+                IndexPartition<std::size_t>(system_size).for_each([&](std::size_t i){
+                    const std::size_t row_begin = r_row_indices[i];
+                    const std::size_t row_end = r_row_indices[i+1];
+
+                    if(mFixedDofsMask[i]){
+                        for(std::size_t k=row_begin; k<row_end; ++k){
+                            r_values[k] = (static_cast<std::size_t>(r_col_indices[k]) == i) ? scale_factor : TDataType();
+                        }
+                    } else {
+                        for(std::size_t k=row_begin; k<row_end; ++k){
+                            if(mFixedDofsMask[r_col_indices[k]]){
+                                r_values[k] = TDataType();
+                            }
+                        }
+                    }
+                });
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 只对右端向量施加 Dirichlet 条件
+             */
+            void ApplyDirichletConditions_RHS(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                const std::size_t system_size = TSparseSpace::Size(rb);
+                UpdateFixedDofsMask(system_size);
+
+                IndexPartition<std::size_t>(system_size).for_each([&](std::size_t i){
+                    if(mFixedDofsMask[i]){
+                        rb[i] = TDataType();
+                    }
+                });
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 按自由度集合的顺序编号（约束自由度同样参与编号）
+             */
+            void SetUpSystem(ModelPart& rModelPart) override{
+                QUEST_TRY
+
+                this->mEquationSystemSize = this->mDofSet.size();
+
+                IndexPartition<std::size_t>(this->mDofSet.size()).for_each([&](std::size_t i){
+                    auto it_dof = this->mDofSet.begin() + i;
+                    it_dof->SetEquationId(i);
+                });
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 初始化并调整方程系统的大小
+             * @details 拓扑变化时重新收集自由度并编号；稀疏模式失效、要求每步重构或矩阵尚为空时重新构建稀疏模式与组装计划，
+             *  否则保留已有的矩阵结构，只调整向量的大小
+             */
+            void ResizeAndInitializeVectors(
+                typename TSchemeType::Pointer pScheme,
+                TSystemMatrixPointerType& pA,
+                TSystemVectorPointerType& pDx,
+                TSystemVectorPointerType& pb,
+                ModelPart& rModelPart
+            ) override{
+                QUEST_TRY
+
+                if(pA == nullptr){
+                    pA = TSparseSpace::CreateEmptyMatrixPointer();
+                }
+                if(pDx == nullptr){
+                    pDx = TSparseSpace::CreateEmptyVectorPointer();
+                }
+                if(pb == nullptr){
+                    pb = TSparseSpace::CreateEmptyVectorPointer();
+                }
+
+                if(!this->mDofSetIsInitialized || this->IsTopologyChanged(rModelPart)){
+                    QUEST_INFO_IF("ResidualBasedBlockBuilderAndSolver", this->GetEchoLevel() > 0 && this->mDofSetIsInitialized)
+                        << "The model topology has changed. Rebuilding the DOF set and the sparsity pattern" << std::endl;
+                    this->SetUpDofSet(pScheme, rModelPart);
+                    this->SetUpSystem(rModelPart);
+                }
+
+                TSystemMatrixType& rA = *pA;
+                const std::size_t system_size = this->mEquationSystemSize;
+
+                if(!this->mSystemStructureIsBuilt || this->GetReshapeMatrixFlag() || rA.size1() != system_size || rA.size2() != system_size){
+                    ConstructMatrixStructure(*pScheme, rModelPart, rA);
+                }
+
+                if(TSparseSpace::Size(*pDx) != system_size){
+                    pDx->resize(system_size, false);
+                }
+                TSparseSpace::SetToZero(*pDx);
+
+                if(TSparseSpace::Size(*pb) != system_size){
+                    pb->resize(system_size, false);
+                }
+                TSparseSpace::SetToZero(*pb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 计算约束自由度的反力 R = -(f - K u)
+             */
+            void CalculateReactions(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                BuildRHSNoDirichlet(pScheme, rModelPart, rb);
+
+                block_for_each(this->mDofSet, [&](TDofType& rDof){
+                    if(rDof.IsFixed()){
+                        rDof.GetSolutionStepReactionValue() = -rb[rDof.GetEquationId()];
+                    }
+                });
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 清空自由度集合、稀疏模式、组装计划与线性求解器
+             */
+            void Clear() override{
+                BaseType::Clear();
+
+                mElementPlan.Clear();
+                mConditionPlan.Clear();
+                std::vector<char>().swap(mFixedDofsMask);
+            }
+
+
+            /**
+             * @brief 检查输入
+             */
+            int Check(ModelPart& rModelPart) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(rModelPart.NumberOfMasterSlaveConstraints() != 0) << "ResidualBasedBlockBuilderAndSolver does not support master-slave constraints. Number of constraints : "
+                    << rModelPart.NumberOfMasterSlaveConstraints() << std::endl;
+
+                return BaseType::Check(rModelPart);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 此方法提供默认参数，以避免不同构造函数之间的冲突
+             * @return 默认参数
+             */
+            Parameters GetDefaultParameters() const override{
+                Parameters default_parameters = Parameters(R"(
+                {
+                    "name"                              : "block_builder_and_solver",
+                    "diagonal_values_for_dirichlet_dofs" : "use_max_diagonal"
+                })");
+
+                const Parameters base_default_parameters = BaseType::GetDefaultParameters();
+                default_parameters.RecursivelyAddMissingParameters(base_default_parameters);
+                return default_parameters;
+            }
+
+
+            /**
+             * @brief 返回类在参数中的名称
+             */
+            static std::string Name(){
+                return "block_builder_and_solver";
+            }
+
+
+            /**
+             * @brief 返回最近一次施加 Dirichlet 条件时约束行对角元的缩放值
+             */
+            double GetScaleFactor() const{
+                return mScaleFactor;
+            }
+
+
+            std::string Info() const override{
+                return "ResidualBasedBlockBuilderAndSolver";
+            }
+
+
+            void PrintInfo(std::ostream& rOStream) const override{
+                rOStream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOStream) const override{
+                rOStream << Info() << " equation system size : " << this->mEquationSystemSize
+                         << " structure builds : " << this->mNumberOfStructureBuilds;
+            }
+
+        protected:
+            /**
+             * @brief 组装右端向量，不施加 Dirichlet 条件
+             */
+            void BuildRHSNoDirichlet(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemVectorType& rb
+            ){
+                QUEST_TRY
+
+                QUEST_ERROR_IF(!pScheme) << "No scheme provided!" << std::endl;
+
+                EnsureEquationIds(*pScheme, rModelPart);
+
+                TSparseSpace::SetToZero(rb);
+
+                AssembleSystem<false, true>(*pScheme, rModelPart, nullptr, &rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 此方法将设置分配给成员变量
+             */
+            void AssignSettings(const Parameters ThisParameters) override{
+                BaseType::AssignSettings(ThisParameters);
+
+                const std::string diagonal_values = ThisParameters["diagonal_values_for_dirichlet_dofs"].GetString();
+                if(diagonal_values == "no_scaling"){
+                    mScalingDiagonal = SCALING_DIAGONAL::NO_SCALING;
+                } else if(diagonal_values == "use_max_diagonal"){
+                    mScalingDiagonal = SCALING_DIAGONAL::CONSIDER_MAX_DIAGONAL;
+                } else if(diagonal_values == "use_diagonal_norm"){
+                    mScalingDiagonal = SCALING_DIAGONAL::CONSIDER_NORM_DIAGONAL;
+                } else if(diagonal_values == "defined_in_process_info"){
+                    mScalingDiagonal = SCALING_DIAGONAL::CONSIDER_PRESCRIBED_DIAGONAL;
+                } else {
+                    QUEST_ERROR << "Unknown diagonal_values_for_dirichlet_dofs : " << diagonal_values
+                        << ". Available options are no_scaling, use_max_diagonal, use_diagonal_norm and defined_in_process_info" << std::endl;
+                }
+            }
+
+
+            /**
+             * @brief 构建稀疏模式、缓存方程编号并建立组装计划
+             * @details 稀疏模式由单元、条件的方程编号以及所有对角元组成，直接写入CSR矩阵的数组
+             */
+            void ConstructMatrixStructure(
+                TSchemeType& rScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA
+            ){
+                QUEST_TRY
+
+                const IndexType system_size = this->mEquationSystemSize;
+
+                this->CollectEquationIds(rScheme, rModelPart);
+
+                const IndexType n_elems = this->mElementEquationIdOffsets.size() - 1;
+                const IndexType n_conds = this->mConditionEquationIdOffsets.size() - 1;
+
+                SparseGraphBuilder<IndexType> graph(system_size);
+                graph.AddEntriesFromConnectivity(n_elems + n_conds + system_size, [&](IndexType i, IndexVectorType& rIndices){
+                    if(i < n_elems){
+                        rIndices.assign(this->mElementEquationIds.begin() + this->mElementEquationIdOffsets[i], this->mElementEquationIds.begin() + this->mElementEquationIdOffsets[i+1]);
+                    } else if(i < n_elems + n_conds){
+                        const IndexType j = i - n_elems;
+                        rIndices.assign(this->mConditionEquationIds.begin() + this->mConditionEquationIdOffsets[j], this->mConditionEquationIds.begin() + this->mConditionEquationIdOffsets[j+1]);
+                    } else {
+                        rIndices.push_back(i - n_elems - n_conds);
+                    }
+                }, system_size);
+
+                const auto& r_graph_rows = graph.GetRowIndices();
+                const auto& r_graph_cols = graph.GetColIndices();
+                const IndexType nnz = r_graph_cols.size();
+
+                rA = TSystemMatrixType(system_size, system_size, nnz);
+
+                auto& r_row_indices = rA.index1_data();
+                auto& r_col_indices = rA.index2_data();
+                auto& r_values = rA.value_data();
+
+                IndexPartition<IndexType>(system_size + 1).for_each([&](IndexType i){
+                    r_row_indices[i] = r_graph_rows[i];
+                });
+                IndexPartition<IndexType>(nnz).for_each([&](IndexType k){
+                    r_col_indices[k] = r_graph_cols[k];
+                    r_values[k] = TDataType();
+                });
+                rA.set_filled(system_size + 1, nnz);
+
+                BuildAssemblyPlans(rA);
+
+                this->mSystemStructureIsBuilt = true;
+                ++this->mNumberOfStructureBuilds;
+
+                QUEST_INFO_IF("ResidualBasedBlockBuilderAndSolver", this->GetEchoLevel() > 2) << "Constructed the matrix structure. Size : "
+                    << system_size << " non-zeros : " << nnz << std::endl;
+
+                QUEST_CATCH("")
+            }
+
+        private:
+            /**
+             * @brief 由缓存的方程编号建立单元与条件的组装计划
+             */
+            void BuildAssemblyPlans(const TSystemMatrixType& rA){
+                this->mBatchingIsBuilt = false;
+                mElementPlan.Build(rA, this->mElementEquationIdOffsets.size() - 1, [&](IndexType i, IndexVectorType& rIndices){
+                    rIndices.assign(this->mElementEquationIds.begin() + this->mElementEquationIdOffsets[i], this->mElementEquationIds.begin() + this->mElementEquationIdOffsets[i+1]);
+                });
+                mConditionPlan.Build(rA, this->mConditionEquationIdOffsets.size() - 1, [&](IndexType i, IndexVectorType& rIndices){
+                    rIndices.assign(this->mConditionEquationIds.begin() + this->mConditionEquationIdOffsets[i], this->mConditionEquationIds.begin() + this->mConditionEquationIdOffsets[i+1]);
+                });
+            }
+
+
+            /**
+             * @brief 保证缓存的方程编号与当前模型一致
+             */
+            void EnsureEquationIds(TSchemeType& rScheme, ModelPart& rModelPart){
+                if(this->mElementEquationIdOffsets.size() != rModelPart.Elements().size() + 1 || this->mConditionEquationIdOffsets.size() != rModelPart.Conditions().size() + 1){
+                    this->CollectEquationIds(rScheme, rModelPart);
+                }
+            }
+
+
+            /**
+             * @brief 保证组装计划与矩阵的稀疏模式一致
+             * @details 矩阵的稀疏模式不是由本构建器生成（或已被外部修改）时，按当前的方程编号重新建立计划，
+             *  此时矩阵必须已包含所有单元与条件的元素
+             */
+            void EnsureAssemblyPlans(TSchemeType& rScheme, ModelPart& rModelPart, const TSystemMatrixType& rA){
+                EnsureEquationIds(rScheme, rModelPart);
+                if(!mElementPlan.IsBuiltFor(rA) || !mConditionPlan.IsBuiltFor(rA)
+                    || mElementPlan.NumberOfEntities() != rModelPart.Elements().size()
+                    || mConditionPlan.NumberOfEntities() != rModelPart.Conditions().size()){
+                    BuildAssemblyPlans(rA);
+                }
+            }
+
+
+            /**
+             * @brief 在同一个并行区中计算并组装单元与条件的局部系统
+             * @tparam TAssembleLHS 是否组装左端矩阵
+             * @tparam TAssembleRHS 是否组装右端向量
+             */
+            template<bool TAssembleLHS, bool TAssembleRHS>
+            void AssembleSystem(
+                TSchemeType& rScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType* pA,
+                TSystemVectorType* pb
+            ){
+                const auto& r_process_info = rModelPart.GetProcessInfo();
+                TDataType* p_values = nullptr;
+                TDataType* p_rhs = nullptr;
+                if constexpr(TAssembleLHS){
+                    p_values = &(pA->value_data()[0]);
+                }
+                if constexpr(TAssembleRHS){
+                    p_rhs = &((*pb)[0]);
+                }
+
+                auto& r_elements = rModelPart.Elements();
+                auto& r_conditions = rModelPart.Conditions();
+
+                if constexpr(TAssembleLHS && TAssembleRHS){
+                    if(this->mUseBatchedAssembly){
+                        this->EnsureBatching(rModelPart);
+                        // 不着色时所有批属于同一种颜色，使用原子加；着色时同一颜色内的批不共享自由度，使用普通加法
+                        const bool use_atomics = !this->mUseColoring;
+                        BaseType::template ForEachBatch<Element>(rScheme, r_elements, this->mElementBatching, r_process_info, [&](const LocalSystemBatch& rBatch, const IndexVectorType& rIndices){
+                            if(use_atomics){
+                                ScatterBatch<true>(rBatch, rIndices, mElementPlan, this->mElementEquationIdOffsets, this->mElementEquationIds, p_values, p_rhs);
+                            } else {
+                                ScatterBatch<false>(rBatch, rIndices, mElementPlan, this->mElementEquationIdOffsets, this->mElementEquationIds, p_values, p_rhs);
+                            }
+                        });
+                        BaseType::template ForEachBatch<Condition>(rScheme, r_conditions, this->mConditionBatching, r_process_info, [&](const LocalSystemBatch& rBatch, const IndexVectorType& rIndices){
+                            if(use_atomics){
+                                ScatterBatch<true>(rBatch, rIndices, mConditionPlan, this->mConditionEquationIdOffsets, this->mConditionEquationIds, p_values, p_rhs);
+                            } else {
+                                ScatterBatch<false>(rBatch, rIndices, mConditionPlan, this->mConditionEquationIdOffsets, this->mConditionEquationIds, p_values, p_rhs);
+                            }
+                        });
+                        return;
+                    }
+                }
+
+                if(this->mUseColoring){
+                    this->EnsureColoring();
+                    // 同一颜色的实体不共享方程编号，使用普通加法
+                    BaseType::ForEachColoredEntity(r_elements, this->mElementColoring, [&](Element& rElement, const IndexType i, AssemblyTLS& rTLS){
+                        AssembleEntity<TAssembleLHS, TAssembleRHS, false>(rScheme, rElement, i, rTLS, mElementPlan, this->mElementEquationIdOffsets, this->mElementEquationIds, p_values, p_rhs, r_process_info);
+                    });
+                    BaseType::ForEachColoredEntity(r_conditions, this->mConditionColoring, [&](Condition& rCondition, const IndexType i, AssemblyTLS& rTLS){
+                        AssembleEntity<TAssembleLHS, TAssembleRHS, false>(rScheme, rCondition, i, rTLS, mConditionPlan, this->mConditionEquationIdOffsets, this->mConditionEquationIds, p_values, p_rhs, r_process_info);
+                    });
+                    return;
+                }
+
+                const int n_elems = static_cast<int>(r_elements.size());
+                const int n_conds = static_cast<int>(r_conditions.size());
+                const auto it_elem_begin = r_elements.begin();
+                const auto it_cond_begin = r_conditions.begin();
+
+                #pragma omp parallel
+                {
+                    AssemblyTLS tls;
+
+                    #pragma omp for schedule(guided, 512) nowait
+                    for(int i_elem = 0; i_elem < n_elems; ++i_elem){
+                        auto& r_elem = *(it_elem_begin + i_elem);
+                        if(r_elem.IsActive()){
+                            AssembleEntity<TAssembleLHS, TAssembleRHS, true>(rScheme, r_elem, i_elem, tls, mElementPlan, this->mElementEquationIdOffsets, this->mElementEquationIds, p_values, p_rhs, r_process_info);
+                        }
+                    }
+
+                    #pragma omp for schedule(guided, 512)
+                    for(int i_cond = 0; i_cond < n_conds; ++i_cond){
+                        auto& r_cond = *(it_cond_begin + i_cond);
+                        if(r_cond.IsActive()){
+                            AssembleEntity<TAssembleLHS, TAssembleRHS, true>(rScheme, r_cond, i_cond, tls, mConditionPlan, this->mConditionEquationIdOffsets, this->mConditionEquationIds, p_values, p_rhs, r_process_info);
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 计算一个实体的局部系统并累加到全局矩阵与向量
+             * @tparam TAtomic 是否使用原子加
+             */
+            template<bool TAssembleLHS, bool TAssembleRHS, bool TAtomic, typename TEntityType>
+            static void AssembleEntity(
+                TSchemeType& rScheme,
+                TEntityType& rEntity,
+                const IndexType EntityIndex,
+                AssemblyTLS& rTLS,
+                const AssemblyPlanType& rPlan,
+                const IndexVectorType& rOffsets,
+                const IndexVectorType& rEquationIds,
+                TDataType* pValues,
+                TDataType* pRhs,
+                const ProcessInfo& rProcessInfo
+            ){
+                // 单元/条件在本次计算中从线程内存池取得的临时量在返回时统一回收
+                ScratchArena::Scope scratch_scope(rProcessInfo.GetScratchArena());
+
+                if constexpr(TAssembleLHS && TAssembleRHS){
+                    rScheme.CalculateSystemContributions(rEntity, rTLS.LHS, rTLS.RHS, rTLS.EquationIds, rProcessInfo);
+                } else if constexpr(TAssembleLHS){
+                    rScheme.CalculateLHSContribution(rEntity, rTLS.LHS, rTLS.EquationIds, rProcessInfo);
+                } else {
+                    rScheme.CalculateRHSContribution(rEntity, rTLS.RHS, rTLS.EquationIds, rProcessInfo);
+                }
+
+                const IndexType local_size = rOffsets[EntityIndex+1] - rOffsets[EntityIndex];
+
+                if constexpr(TAssembleLHS){
+                    QUEST_DEBUG_ERROR_IF(rTLS.LHS.size1() != local_size) << "The local LHS size " << rTLS.LHS.size1()
+                        << " does not match the number of equation ids " << local_size << std::endl;
+                    const auto offsets = rPlan.GetEntityOffsets(EntityIndex);
+                    for(IndexType i=0; i<local_size; ++i){
+                        for(IndexType j=0; j<local_size; ++j){
+                            if constexpr(TAtomic){
+                                AtomicAdd(pValues[offsets[i*local_size + j]], static_cast<TDataType>(rTLS.LHS(i,j)));
+                            } else {
+                                pValues[offsets[i*local_size + j]] += rTLS.LHS(i,j);
+                            }
+                        }
+                    }
+                }
+
+                if constexpr(TAssembleRHS){
+                    QUEST_DEBUG_ERROR_IF(rTLS.RHS.size() != local_size) << "The local RHS size " << rTLS.RHS.size()
+                        << " does not match the number of equation ids " << local_size << std::endl;
+                    const IndexType* p_ids = rEquationIds.data() + rOffsets[EntityIndex];
+                    for(IndexType i=0; i<local_size; ++i){
+                        if constexpr(TAtomic){
+                            AtomicAdd(pRhs[p_ids[i]], static_cast<TDataType>(rTLS.RHS[i]));
+                        } else {
+                            pRhs[p_ids[i]] += rTLS.RHS[i];
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 把一批局部系统按组装计划累加到全局矩阵与向量
+             * @tparam TAtomic 是否使用原子加
+             */
+            template<bool TAtomic>
+            static void ScatterBatch(
+                const LocalSystemBatch& rBatch,
+                const IndexVectorType& rIndices,
+                const AssemblyPlanType& rPlan,
+                const IndexVectorType& rOffsets,
+                const IndexVectorType& rEquationIds,
+                TDataType* pValues,
+                TDataType* pRhs
+            ){
+                const IndexType local_size = rBatch.LocalSize();
+                for(IndexType lane=0; lane<rIndices.size(); ++lane){
+                    const IndexType entity = rIndices[lane];
+                    QUEST_DEBUG_ERROR_IF(local_size != rOffsets[entity+1] - rOffsets[entity]) << "The local size " << local_size
+                        << " does not match the number of equation ids " << rOffsets[entity+1] - rOffsets[entity] << std::endl;
+                    const auto offsets = rPlan.GetEntityOffsets(entity);
+                    const IndexType* p_ids = rEquationIds.data() + rOffsets[entity];
+                    for(IndexType i=0; i<local_size; ++i){
+                        for(IndexType j=0; j<local_size; ++j){
+                            if constexpr(TAtomic){
+                                AtomicAdd(pValues[offsets[i*local_size + j]], static_cast<TDataType>(rBatch.LHS(lane,i,j)));
+                            } else {
+                                pValues[offsets[i*local_size + j]] += rBatch.LHS(lane,i,j);
+                            }
+                        }
+                        if constexpr(TAtomic){
+                            AtomicAdd(pRhs[p_ids[i]], static_cast<TDataType>(rBatch.RHS(lane,i)));
+                        } else {
+                            pRhs[p_ids[i]] += rBatch.RHS(lane,i);
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 按方程编号标记约束自由度
+             */
+            void UpdateFixedDofsMask(const std::size_t SystemSize){
+                mFixedDofsMask.assign(SystemSize, 0);
+                IndexPartition<std::size_t>(this->mDofSet.size()).for_each([&](std::size_t i){
+                    const auto it_dof = this->mDofSet.begin() + i;
+                    if(it_dof->IsFixed()){
+                        mFixedDofsMask[it_dof->GetEquationId()] = 1;
+                    }
+                });
+            }
+
+
+        private:
+            /**
+             * @brief 单元的组装计划
+             */
+            AssemblyPlanType mElementPlan;
+
+            /**
+             * @brief 条件的组装计划
+             */
+            AssemblyPlanType mConditionPlan;
+
+            /**
+             * @brief 按方程编号标记的约束自由度
+             */
+            std::vector<char> mFixedDofsMask;
+
+            /**
+             * @brief 约束行对角元的取值方式
+             */
+            SCALING_DIAGONAL mScalingDiagonal = SCALING_DIAGONAL::CONSIDER_MAX_DIAGONAL;
+
+            /**
+             * @brief 最近一次施加 Dirichlet 条件时的缩放值
+             */
+            double mScaleFactor = 1.0;
+
+    };
+
+}
+
+#endif //QUEST_RESIDUAL_BASED_BLOCK_BUILDER_AND_SOLVER_HPP
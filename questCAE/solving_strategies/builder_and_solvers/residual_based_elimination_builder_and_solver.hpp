@@ -0,0 +1,999 @@
+#ifndef QUEST_RESIDUAL_BASED_ELIMINATION_BUILDER_AND_SOLVER_HPP
+#define QUEST_RESIDUAL_BASED_ELIMINATION_BUILDER_AND_SOLVER_HPP
+
+// 系统头文件
+#include <vector>
+#include <limits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/model_part.hpp"
+#include "includes/quest_parameters.hpp"
+#include "solving_strategies/builder_and_solvers/builder_and_solvers.hpp"
+#include "container/sparse_graph_builder.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/atomic_utilities.hpp"
+#include "utilities/scratch_arena.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ResidualBasedEliminationBuilderAndSolver
+     * @brief 基于残差的消去构建器：约束自由度不进入方程系统
+     * @details 只对自由自由度编号 [0, n)，约束自由度的编号放在自由范围之后 [n, N)，全局矩阵只有 n×n。
+     *  组装时每个单元/条件局部矩阵的元素按缓存的目标位置分为三类：
+     *  自由行自由列累加到缩减矩阵；约束行累加到单独缓存的约束行块 K_c（大小 (N-n)×N）；
+     *  自由行约束列的贡献乘以约束自由度的给定增量（GetFixedDofIncrements，默认为零）后移到右端，
+     *  因此缩减系统中不再出现约束列。给定增量只被下一次 Build 使用一次，之后清零（见 GetFixedDofIncrements）。
+     *  约束行的右端项同时累加到反力向量 f_c 中。
+     *  求解后反力取 R_c = -(f_c - K_c Δu)，不需要再次组装；若求解后又调用过 BuildRHS，则直接取 R_c = -f_c。
+     *  自由度集合、编号、稀疏模式与目标位置在拓扑或约束状态（约束自由度集合）变化、SetReshapeMatrixFlag(true)
+     *  或调用 SetUpDofSet/Clear 之前一直保留。use_batched_assembly 为真时 Build 按（动态类型，局部尺寸）分批，
+     *  通过方案的 CalculateSystemContributionsBatch 批量计算局部系统，批大小不超过 batch_size（0 表示SIMD宽度）。
+     *  主从约束（MasterSlaveConstraint）暂不支持
+     * @tparam TSparseSpace 稀疏空间类型
+     * @tparam TDenseSpace 稠密空间类型
+     * @tparam TLinearSolver 线性求解器类型
+     */
+    template<typename TSparseSpace, typename TDenseSpace, typename TLinearSolver>
+    class ResidualBasedEliminationBuilderAndSolver : public BuilderAndSolver<TSparseSpace, TDenseSpace, TLinearSolver>{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(ResidualBasedEliminationBuilderAndSolver);
+
+            using BaseType = BuilderAndSolver<TSparseSpace, TDenseSpace, TLinearSolver>;
+            using ClassType = ResidualBasedEliminationBuilderAndSolver<TSparseSpace, TDenseSpace, TLinearSolver>;
+            using SizeType = typename BaseType::SizeType;
+            using IndexType = typename BaseType::IndexType;
+            using TDataType = typename BaseType::TDataType;
+            using TSystemMatrixType = typename BaseType::TSystemMatrixType;
+            using TSystemVectorType = typename BaseType::TSystemVectorType;
+            using TSystemMatrixPointerType = typename BaseType::TSystemMatrixPointerType;
+            using TSystemVectorPointerType = typename BaseType::TSystemVectorPointerType;
+            using LocalSystemMatrixType = typename BaseType::LocalSystemMatrixType;
+            using LocalSystemVectorType = typename BaseType::LocalSystemVectorType;
+            using TSchemeType = typename BaseType::TSchemeType;
+            using TDofType = typename BaseType::TDofType;
+            using DofsArrayType = typename BaseType::DofsArrayType;
+            using EquationIdVectorType = typename BaseType::EquationIdVectorType;
+            using IndexVectorType = typename BaseType::IndexVectorType;
+            using AssemblyTLS = typename BaseType::AssemblyTLS;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            explicit ResidualBasedEliminationBuilderAndSolver() : BaseType(){}
+
+
+            /**
+             * @brief 构造函数，基于输入参数
+             */
+            explicit ResidualBasedEliminationBuilderAndSolver(
+                typename TLinearSolver::Pointer pNewLinearSystemSolver,
+                Parameters ThisParameters
+            ) : BaseType(pNewLinearSystemSolver)
+            {
+                ThisParameters = this->ValidateAndAssignParameters(ThisParameters, this->GetDefaultParameters());
+                this->AssignSettings(ThisParameters);
+            }
+
+
+            /**
+             * @brief 构造函数
+             */
+            explicit ResidualBasedEliminationBuilderAndSolver(typename TLinearSolver::Pointer pNewLinearSystemSolver)
+                : BaseType(pNewLinearSystemSolver)
+            {
+            }
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~ResidualBasedEliminationBuilderAndSolver() override{}
+
+
+            /**
+             * @brief 创建并返回一个新的对象指针
+             */
+            typename BaseType::Pointer Create(
+                typename TLinearSolver::Pointer pNewLinearSystemSolver,
+                Parameters ThisParameters
+            ) const override{
+                return Quest::make_shared<ClassType>(pNewLinearSystemSolver, ThisParameters);
+            }
+
+
+            /**
+             * @brief 在一次并行遍历中组装缩减矩阵、右端向量、约束行块与反力向量
+             * @param pScheme 指向积分方案的指针
+             * @param rModelPart 要计算的模型部分
+             * @param rA 缩减后的 LHS 矩阵，稀疏模式须由 ResizeAndInitializeVectors 构建
+             * @param rb 缩减后的 RHS 向量
+             */
+            void Build(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(!pScheme) << "No scheme provided!" << std::endl;
+                CheckStructure(rA);
+
+                TSparseSpace::SetToZero(rA);
+                TSparseSpace::SetToZero(rb);
+                TSparseSpace::SetToZero(mFixedRowMatrix);
+                TSparseSpace::SetToZero(*(this->mpReactionsVector));
+
+                AssembleSystem<true, true>(*pScheme, rModelPart, &rA, &rb);
+                mReactionsAreLinearized = false;
+
+                // 给定增量已移到本次的右端：转存供反力计算使用并清零，同一求解步之后的组装从更新后的状态出发，不再重复施加
+                TSparseSpace::Copy(mFixedDofIncrements, mAppliedFixedDofIncrements);
+                TSparseSpace::SetToZero(mFixedDofIncrements);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 只组装缩减矩阵与约束行块
+             */
+            void BuildLHS(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA
+            ) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(!pScheme) << "No scheme provided!" << std::endl;
+                CheckStructure(rA);
+
+                TSparseSpace::SetToZero(rA);
+                TSparseSpace::SetToZero(mFixedRowMatrix);
+
+                AssembleSystem<true, false>(*pScheme, rModelPart, &rA, nullptr);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 只组装缩减右端向量与反力向量
+             * @details 不组装左端矩阵，因此约束自由度的给定增量不会移到右端
+             */
+            void BuildRHS(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(!pScheme) << "No scheme provided!" << std::endl;
+                QUEST_ERROR_IF_NOT(this->mSystemStructureIsBuilt) << "The system structure is not built. Please call ResizeAndInitializeVectors first" << std::endl;
+
+                TSparseSpace::SetToZero(rb);
+                TSparseSpace::SetToZero(*(this->mpReactionsVector));
+
+                AssembleSystem<false, true>(*pScheme, rModelPart, nullptr, &rb);
+                mReactionsAreLinearized = false;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 调用线性求解器，右端为零时直接返回零解，设置了 ReuseFactorization 标志时沿用已有分解
+             */
+            void SystemSolve(
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                const double norm_b = TSparseSpace::Size(rb) != 0 ? TSparseSpace::TwoNorm(rb) : 0.0;
+
+                if(norm_b != 0.0){
+                    this->InternalSystemSolve(rA, rDx, rb);
+                } else {
+                    TSparseSpace::SetToZero(rDx);
+                }
+                mReactionsAreLinearized = true;
+
+                QUEST_INFO_IF("ResidualBasedEliminationBuilderAndSolver", this->GetEchoLevel() > 1) << *(this->mpLinearSystemSolver) << std::endl;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 组装并求解（约束自由度已消去，不需要施加 Dirichlet 条件）
+             */
+            void BuildAndSolve(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                Build(pScheme, rModelPart, rA, rb);
+
+                SystemSolve(rA, rDx, rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 保持已有的缩减矩阵，只重新组装右端向量并求解
+             */
+            void BuildRHSAndSolve(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                BuildRHS(pScheme, rModelPart, rb);
+
+                SystemSolve(rA, rDx, rb);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 约束自由度不在方程系统中，无需处理
+             */
+            void ApplyDirichletConditions(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{}
+
+
+            /**
+             * @brief 编号：自由自由度依次为 [0, n)，约束自由度依次为 [n, N)
+             */
+            void SetUpSystem(ModelPart& rModelPart) override{
+                QUEST_TRY
+
+                IndexType free_id = 0;
+                IndexType fixed_count = 0;
+                for(const auto& r_dof : this->mDofSet){
+                    if(r_dof.IsFixed()){
+                        ++fixed_count;
+                    } else {
+                        ++free_id;
+                    }
+                }
+
+                this->mEquationSystemSize = free_id;
+                mNumberOfFixedDofs = fixed_count;
+
+                IndexType fixed_id = free_id;
+                free_id = 0;
+                for(auto& r_dof : this->mDofSet){
+                    if(r_dof.IsFixed()){
+                        r_dof.SetEquationId(fixed_id++);
+                    } else {
+                        r_dof.SetEquationId(free_id++);
+                    }
+                }
+
+                mFixityHash = BaseType::ComputeFixityHash(this->mDofSet);
+                this->mSystemStructureIsBuilt = false;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 初始化并调整方程系统的大小
+             * @details 拓扑变化时重新收集自由度，约束状态变化时重新编号，二者发生其一、要求每步重构或矩阵尚为空时
+             *  重新构建缩减矩阵与约束行块的稀疏模式，否则保留已有结构，只调整向量的大小
+             */
+            void ResizeAndInitializeVectors(
+                typename TSchemeType::Pointer pScheme,
+                TSystemMatrixPointerType& pA,
+                TSystemVectorPointerType& pDx,
+                TSystemVectorPointerType& pb,
+                ModelPart& rModelPart
+            ) override{
+                QUEST_TRY
+
+                if(pA == nullptr){
+                    pA = TSparseSpace::CreateEmptyMatrixPointer();
+                }
+                if(pDx == nullptr){
+                    pDx = TSparseSpace::CreateEmptyVectorPointer();
+                }
+                if(pb == nullptr){
+                    pb = TSparseSpace::CreateEmptyVectorPointer();
+                }
+                if(this->mpReactionsVector == nullptr){
+                    this->mpReactionsVector = TSparseSpace::CreateEmptyVectorPointer();
+                }
+
+                if(!this->mDofSetIsInitialized || this->IsTopologyChanged(rModelPart)){
+                    QUEST_INFO_IF("ResidualBasedEliminationBuilderAndSolver", this->GetEchoLevel() > 0 && this->mDofSetIsInitialized)
+                        << "The model topology has changed. Rebuilding the DOF set and the sparsity pattern" << std::endl;
+                    this->SetUpDofSet(pScheme, rModelPart);
+                    this->SetUpSystem(rModelPart);
+                } else if(mFixityHash != BaseType::ComputeFixityHash(this->mDofSet)){
+                    QUEST_INFO_IF("ResidualBasedEliminationBuilderAndSolver", this->GetEchoLevel() > 0)
+                        << "The set of fixed DOFs has changed. Renumbering the equations" << std::endl;
+                    this->SetUpSystem(rModelPart);
+                }
+
+                TSystemMatrixType& rA = *pA;
+                const std::size_t system_size = this->mEquationSystemSize;
+
+                if(!this->mSystemStructureIsBuilt || this->GetReshapeMatrixFlag() || rA.size1() != system_size || rA.size2() != system_size){
+                    ConstructMatrixStructure(*pScheme, rModelPart, rA);
+                }
+
+                if(TSparseSpace::Size(*pDx) != system_size){
+                    pDx->resize(system_size, false);
+                }
+                TSparseSpace::SetToZero(*pDx);
+
+                if(TSparseSpace::Size(*pb) != system_size){
+                    pb->resize(system_size, false);
+                }
+                TSparseSpace::SetToZero(*pb);
+
+                if(TSparseSpace::Size(*(this->mpReactionsVector)) != mNumberOfFixedDofs){
+                    this->mpReactionsVector->resize(mNumberOfFixedDofs, false);
+                }
+                TSparseSpace::SetToZero(*(this->mpReactionsVector));
+
+                if(TSparseSpace::Size(mFixedDofIncrements) != mNumberOfFixedDofs){
+                    mFixedDofIncrements.resize(mNumberOfFixedDofs, false);
+                    TSparseSpace::SetToZero(mFixedDofIncrements);
+                }
+                if(TSparseSpace::Size(mAppliedFixedDofIncrements) != mNumberOfFixedDofs){
+                    mAppliedFixedDofIncrements.resize(mNumberOfFixedDofs, false);
+                    TSparseSpace::SetToZero(mAppliedFixedDofIncrements);
+                }
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 由缓存的约束行块计算反力
+             * @details 上一次组装之后求解过方程时 R_c = -(f_c - K_c Δu)，其中 Δu 由 rDx 与上一次 Build 施加的给定增量组成；
+             *  否则 f_c 已是当前状态的残差，R_c = -f_c
+             */
+            void CalculateReactions(
+                typename TSchemeType::Pointer pScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA,
+                TSystemVectorType& rDx,
+                TSystemVectorType& rb
+            ) override{
+                QUEST_TRY
+
+                const IndexType free_size = this->mEquationSystemSize;
+                const auto& r_reactions = *(this->mpReactionsVector);
+
+                if(mReactionsAreLinearized){
+                    const auto& r_row_indices = mFixedRowMatrix.index1_data();
+                    const auto& r_col_indices = mFixedRowMatrix.index2_data();
+                    const auto& r_values = mFixedRowMatrix.value_data();
+
+                    block_for_each(this->mDofSet, [&](TDofType& rDof){
+                        if(rDof.IsFixed()){
+                            const IndexType i = rDof.GetEquationId() - free_size;
+                            TDataType k_du = TDataType();
+                            for(IndexType k=r_row_indices[i]; k<static_cast<IndexType>(r_row_indices[i+1]); ++k){
+                                const IndexType j = r_col_indices[k];
+                                k_du += r_values[k] * (j < free_size ? rDx[j] : mAppliedFixedDofIncrements[j - free_size]);
+                            }
+                            rDof.GetSolutionStepReactionValue() = -(r_reactions[i] - k_du);
+                        }
+                    });
+                } else {
+                    block_for_each(this->mDofSet, [&](TDofType& rDof){
+                        if(rDof.IsFixed()){
+                            rDof.GetSolutionStepReactionValue() = -r_reactions[rDof.GetEquationId() - free_size];
+                        }
+                    });
+                }
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 清空自由度集合、稀疏模式、缓存与线性求解器
+             */
+            void Clear() override{
+                BaseType::Clear();
+
+                mReactionsAreLinearized = false;
+                mFixedRowMatrix = TSystemMatrixType();
+                mFixedDofIncrements = TSystemVectorType();
+                mAppliedFixedDofIncrements = TSystemVectorType();
+                IndexVectorType().swap(mElementTargets);
+                IndexVectorType().swap(mConditionTargets);
+            }
+
+
+            /**
+             * @brief 检查输入
+             */
+            int Check(ModelPart& rModelPart) override{
+                QUEST_TRY
+
+                QUEST_ERROR_IF(rModelPart.NumberOfMasterSlaveConstraints() != 0) << "ResidualBasedEliminationBuilderAndSolver does not support master-slave constraints. Number of constraints : "
+                    << rModelPart.NumberOfMasterSlaveConstraints() << std::endl;
+
+                return BaseType::Check(rModelPart);
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 此方法提供默认参数，以避免不同构造函数之间的冲突
+             * @return 默认参数
+             */
+            Parameters GetDefaultParameters() const override{
+                Parameters default_parameters = Parameters(R"(
+                {
+                    "name" : "elimination_builder_and_solver"
+                })");
+
+                const Parameters base_default_parameters = BaseType::GetDefaultParameters();
+                default_parameters.RecursivelyAddMissingParameters(base_default_parameters);
+                return default_parameters;
+            }
+
+
+            /**
+             * @brief 返回类在参数中的名称
+             */
+            static std::string Name(){
+                return "elimination_builder_and_solver";
+            }
+
+
+            /**
+             * @brief 返回约束自由度的个数
+             */
+            IndexType GetNumberOfFixedDofs() const{
+                return mNumberOfFixedDofs;
+            }
+
+
+            /**
+             * @brief 返回约束自由度的给定增量（按约束自由度的编号减去自由自由度个数存放）
+             * @details 默认为零，即基于残差的格式中约束值已由方案预测到自由度上。
+             *  非零时下一次 Build 把自由行约束列的贡献 K_fc Δu_c 从右端减去，随后把增量转存到
+             *  GetAppliedFixedDofIncrements 并清零，同一求解步之后的组装不再重复施加（调用者须在求解后把增量加到约束自由度上）
+             */
+            TSystemVectorType& GetFixedDofIncrements(){
+                return mFixedDofIncrements;
+            }
+
+
+            /**
+             * @brief 有待施加的约束自由度给定增量时返回 true，它们只在 Build 中移到右端
+             */
+            bool IsBuildRequired() const override{
+                return mNumberOfFixedDofs != 0 && TSparseSpace::TwoNorm(mFixedDofIncrements) != 0.0;
+            }
+
+
+            /**
+             * @brief 返回最近一次 Build 施加的约束自由度给定增量
+             */
+            const TSystemVectorType& GetAppliedFixedDofIncrements() const{
+                return mAppliedFixedDofIncrements;
+            }
+
+
+            /**
+             * @brief 返回缓存的约束行块 K_c（行为约束自由度，列为全部自由度）
+             */
+            const TSystemMatrixType& GetFixedRowMatrix() const{
+                return mFixedRowMatrix;
+            }
+
+
+            std::string Info() const override{
+                return "ResidualBasedEliminationBuilderAndSolver";
+            }
+
+
+            void PrintInfo(std::ostream& rOStream) const override{
+                rOStream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOStream) const override{
+                rOStream << Info() << " free dofs : " << this->mEquationSystemSize << " fixed dofs : " << mNumberOfFixedDofs
+                         << " structure builds : " << this->mNumberOfStructureBuilds;
+            }
+
+        protected:
+            /**
+             * @brief 构建缩减矩阵与约束行块的稀疏模式，并缓存每个局部矩阵元素的目标位置
+             * @details 目标位置统一编号：[0, nnz(A)) 为缩减矩阵的值数组，[nnz(A), nnz(A)+nnz(K_c)) 为约束行块的值数组，
+             *  最大值表示自由行约束列（移到右端）
+             */
+            void ConstructMatrixStructure(
+                TSchemeType& rScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType& rA
+            ){
+                QUEST_TRY
+
+                const IndexType free_size = this->mEquationSystemSize;
+                const IndexType total_size = free_size + mNumberOfFixedDofs;
+
+                this->CollectEquationIds(rScheme, rModelPart);
+
+                const IndexType n_elems = this->mElementEquationIdOffsets.size() - 1;
+                const IndexType n_conds = this->mConditionEquationIdOffsets.size() - 1;
+
+                auto get_entity_ids = [&](IndexType i) -> std::pair<const IndexType*, const IndexType*>{
+                    if(i < n_elems){
+                        return {this->mElementEquationIds.data() + this->mElementEquationIdOffsets[i], this->mElementEquationIds.data() + this->mElementEquationIdOffsets[i+1]};
+                    }
+                    const IndexType j = i - n_elems;
+                    return {this->mConditionEquationIds.data() + this->mConditionEquationIdOffsets[j], this->mConditionEquationIds.data() + this->mConditionEquationIdOffsets[j+1]};
+                };
+
+                // 缩减矩阵：只保留自由编号，并补全对角元
+                SparseGraphBuilder<IndexType> graph(free_size);
+                graph.AddEntriesFromConnectivity(n_elems + n_conds + free_size, [&](IndexType i, IndexVectorType& rIndices){
+                    if(i < n_elems + n_conds){
+                        const auto ids = get_entity_ids(i);
+                        for(auto it = ids.first; it != ids.second; ++it){
+                            if(*it < free_size){
+                                rIndices.push_back(*it);
+                            }
+                        }
+                    } else {
+                        rIndices.push_back(i - n_elems - n_conds);
+                    }
+                }, free_size);
+                FillMatrix(graph, free_size, free_size, rA);
+                mReducedNonZeros = rA.nnz();
+
+                // 约束行块：行为约束编号减去 n，列为全部编号
+                SparseGraphBuilder<IndexType> fixed_graph(mNumberOfFixedDofs);
+                #pragma omp parallel
+                {
+                    IndexVectorType fixed_rows;
+
+                    #pragma omp for schedule(guided, 512)
+                    for(int i = 0; i < static_cast<int>(n_elems + n_conds); ++i){
+                        const auto ids = get_entity_ids(i);
+                        fixed_rows.clear();
+                        for(auto it = ids.first; it != ids.second; ++it){
+                            if(*it >= free_size){
+                                fixed_rows.push_back(*it - free_size);
+                            }
+                        }
+                        fixed_graph.AddBlock(fixed_rows.begin(), fixed_rows.end(), ids.first, ids.second);
+                    }
+                }
+                fixed_graph.Finalize();
+                FillMatrix(fixed_graph, mNumberOfFixedDofs, total_size, mFixedRowMatrix);
+
+                BuildTargets(this->mElementEquationIdOffsets, this->mElementEquationIds, rA, mElementTargetOffsets, mElementTargets);
+                BuildTargets(this->mConditionEquationIdOffsets, this->mConditionEquationIds, rA, mConditionTargetOffsets, mConditionTargets);
+
+                this->mSystemStructureIsBuilt = true;
+                this->mBatchingIsBuilt = false;
+                ++this->mNumberOfStructureBuilds;
+
+                QUEST_INFO_IF("ResidualBasedEliminationBuilderAndSolver", this->GetEchoLevel() > 2) << "Constructed the matrix structure. Free dofs : "
+                    << free_size << " non-zeros : " << rA.nnz() << " fixed dofs : " << mNumberOfFixedDofs << " fixed row non-zeros : " << mFixedRowMatrix.nnz() << std::endl;
+
+                QUEST_CATCH("")
+            }
+
+        private:
+            /**
+             * @brief 组装的目标数组
+             */
+            struct AssemblyTargets{
+                IndexType FreeSize = 0;
+                IndexType NumberOfReducedNonZeros = 0;
+                TDataType* pValues = nullptr;
+                TDataType* pFixedRowValues = nullptr;
+                TDataType* pRhs = nullptr;
+                TDataType* pReactions = nullptr;
+                const TDataType* pFixedIncrements = nullptr;
+                bool MoveFixedColumns = false;
+            };
+
+
+            /**
+             * @brief 把图写入CSR矩阵的数组
+             */
+            static void FillMatrix(const SparseGraphBuilder<IndexType>& rGraph, const IndexType Size1, const IndexType Size2, TSystemMatrixType& rMatrix){
+                const auto& r_graph_rows = rGraph.GetRowIndices();
+                const auto& r_graph_cols = rGraph.GetColIndices();
+                const IndexType nnz = r_graph_cols.size();
+
+                rMatrix = TSystemMatrixType(Size1, Size2, nnz);
+
+                auto& r_row_indices = rMatrix.index1_data();
+                auto& r_col_indices = rMatrix.index2_data();
+                auto& r_values = rMatrix.value_data();
+
+                IndexPartition<IndexType>(Size1 + 1).for_each([&](IndexType i){
+                    r_row_indices[i] = Size1 == 0 ? 0 : r_graph_rows[i];
+                });
+                IndexPartition<IndexType>(nnz).for_each([&](IndexType k){
+                    r_col_indices[k] = r_graph_cols[k];
+                    r_values[k] = TDataType();
+                });
+                rMatrix.set_filled(Size1 + 1, nnz);
+            }
+
+
+            /**
+             * @brief 求出每个局部矩阵元素的目标位置
+             */
+            void BuildTargets(
+                const IndexVectorType& rOffsets,
+                const IndexVectorType& rEquationIds,
+                const TSystemMatrixType& rA,
+                IndexVectorType& rTargetOffsets,
+                IndexVectorType& rTargets
+            ) const{
+                const IndexType n_entities = rOffsets.size() - 1;
+                const IndexType free_size = this->mEquationSystemSize;
+                const IndexType nnz_a = rA.nnz();
+
+                rTargetOffsets.resize(n_entities + 1);
+                rTargetOffsets[0] = 0;
+                for(IndexType i=0; i<n_entities; ++i){
+                    const IndexType local_size = rOffsets[i+1] - rOffsets[i];
+                    rTargetOffsets[i+1] = rTargetOffsets[i] + local_size * local_size;
+                }
+                rTargets.resize(rTargetOffsets[n_entities]);
+
+                IndexPartition<IndexType>(n_entities).for_each([&](IndexType e){
+                    const IndexType* p_ids = rEquationIds.data() + rOffsets[e];
+                    const IndexType local_size = rOffsets[e+1] - rOffsets[e];
+                    IndexType* p_targets = rTargets.data() + rTargetOffsets[e];
+
+                    for(IndexType i=0; i<local_size; ++i){
+                        const IndexType I = p_ids[i];
+                        for(IndexType j=0; j<local_size; ++j){
+                            const IndexType J = p_ids[j];
+                            IndexType target;
+                            if(I < free_size){
+                                target = J < free_size ? FindPosition(rA, I, J) : std::numeric_limits<IndexType>::max();
+                            } else {
+                                target = nnz_a + FindPosition(mFixedRowMatrix, I - free_size, J);
+                            }
+                            p_targets[i*local_size + j] = target;
+                        }
+                    }
+                });
+            }
+
+
+            /**
+             * @brief 二分查找 (I,J) 在值数组中的位置
+             */
+            static IndexType FindPosition(const TSystemMatrixType& rMatrix, const IndexType I, const IndexType J){
+                const auto& r_row_indices = rMatrix.index1_data();
+                const auto& r_col_indices = rMatrix.index2_data();
+                const auto it_begin = r_col_indices.begin() + r_row_indices[I];
+                const auto it_end = r_col_indices.begin() + r_row_indices[I+1];
+                const auto it = std::lower_bound(it_begin, it_end, J);
+                QUEST_DEBUG_ERROR_IF(it == it_end || static_cast<IndexType>(*it) != J) << "Entry (" << I << "," << J << ") is not in the sparsity pattern" << std::endl;
+                return static_cast<IndexType>(it - r_col_indices.begin());
+            }
+
+
+            /**
+             * @brief 检查稀疏模式是否由本构建器为 rA 生成
+             */
+            void CheckStructure(const TSystemMatrixType& rA) const{
+                QUEST_ERROR_IF_NOT(this->mSystemStructureIsBuilt) << "The system structure is not built. Please call ResizeAndInitializeVectors first" << std::endl;
+                QUEST_ERROR_IF(rA.size1() != this->mEquationSystemSize || rA.nnz() != mReducedNonZeros)
+                    << "The system matrix does not match the structure built by the elimination builder" << std::endl;
+            }
+
+
+            /**
+             * @brief 在同一个并行区中计算并组装单元与条件的局部系统
+             */
+            template<bool TAssembleLHS, bool TAssembleRHS>
+            void AssembleSystem(
+                TSchemeType& rScheme,
+                ModelPart& rModelPart,
+                TSystemMatrixType* pA,
+                TSystemVectorType* pb
+            ){
+                const auto& r_process_info = rModelPart.GetProcessInfo();
+
+                AssemblyTargets targets;
+                targets.FreeSize = this->mEquationSystemSize;
+                if constexpr(TAssembleLHS){
+                    targets.NumberOfReducedNonZeros = pA->nnz();
+                    targets.pValues = pA->nnz() == 0 ? nullptr : &(pA->value_data()[0]);
+                    targets.pFixedRowValues = mFixedRowMatrix.nnz() == 0 ? nullptr : &(mFixedRowMatrix.value_data()[0]);
+                    targets.pFixedIncrements = mNumberOfFixedDofs == 0 ? nullptr : &(mFixedDofIncrements[0]);
+                    targets.MoveFixedColumns = TAssembleRHS && IsBuildRequired();
+                }
+                if constexpr(TAssembleRHS){
+                    targets.pRhs = targets.FreeSize == 0 ? nullptr : &((*pb)[0]);
+                    targets.pReactions = mNumberOfFixedDofs == 0 ? nullptr : &((*(this->mpReactionsVector))[0]);
+                }
+
+                auto& r_elements = rModelPart.Elements();
+                auto& r_conditions = rModelPart.Conditions();
+
+                if constexpr(TAssembleLHS && TAssembleRHS){
+                    if(this->mUseBatchedAssembly){
+                        this->EnsureBatching(rModelPart);
+                        // 不着色时所有批属于同一种颜色，使用原子加；着色时同一颜色内的批不共享自由度，使用普通加法
+                        const bool use_atomics = !this->mUseColoring;
+                        BaseType::template ForEachBatch<Element>(rScheme, r_elements, this->mElementBatching, r_process_info, [&](const LocalSystemBatch& rBatch, const IndexVectorType& rIndices){
+                            ScatterBatch(rBatch, rIndices, use_atomics, this->mElementEquationIdOffsets, this->mElementEquationIds, mElementTargetOffsets, mElementTargets, targets);
+                        });
+                        BaseType::template ForEachBatch<Condition>(rScheme, r_conditions, this->mConditionBatching, r_process_info, [&](const LocalSystemBatch& rBatch, const IndexVectorType& rIndices){
+                            ScatterBatch(rBatch, rIndices, use_atomics, this->mConditionEquationIdOffsets, this->mConditionEquationIds, mConditionTargetOffsets, mConditionTargets, targets);
+                        });
+                        return;
+                    }
+                }
+
+                if(this->mUseColoring){
+                    this->EnsureColoring();
+                    // 同一颜色的实体不共享方程编号，使用普通加法
+                    BaseType::ForEachColoredEntity(r_elements, this->mElementColoring, [&](Element& rElement, const IndexType i, AssemblyTLS& rTLS){
+                        AssembleEntity<TAssembleLHS, TAssembleRHS, false>(rScheme, rElement, i, rTLS, this->mElementEquationIdOffsets, this->mElementEquationIds, mElementTargetOffsets, mElementTargets, targets, r_process_info);
+                    });
+                    BaseType::ForEachColoredEntity(r_conditions, this->mConditionColoring, [&](Condition& rCondition, const IndexType i, AssemblyTLS& rTLS){
+                        AssembleEntity<TAssembleLHS, TAssembleRHS, false>(rScheme, rCondition, i, rTLS, this->mConditionEquationIdOffsets, this->mConditionEquationIds, mConditionTargetOffsets, mConditionTargets, targets, r_process_info);
+                    });
+                    return;
+                }
+
+                const int n_elems = static_cast<int>(r_elements.size());
+                const int n_conds = static_cast<int>(r_conditions.size());
+                const auto it_elem_begin = r_elements.begin();
+                const auto it_cond_begin = r_conditions.begin();
+
+                #pragma omp parallel
+                {
+                    AssemblyTLS tls;
+
+                    #pragma omp for schedule(guided, 512) nowait
+                    for(int i_elem = 0; i_elem < n_elems; ++i_elem){
+                        auto& r_elem = *(it_elem_begin + i_elem);
+                        if(r_elem.IsActive()){
+                            AssembleEntity<TAssembleLHS, TAssembleRHS, true>(rScheme, r_elem, i_elem, tls, this->mElementEquationIdOffsets, this->mElementEquationIds, mElementTargetOffsets, mElementTargets, targets, r_process_info);
+                        }
+                    }
+
+                    #pragma omp for schedule(guided, 512)
+                    for(int i_cond = 0; i_cond < n_conds; ++i_cond){
+                        auto& r_cond = *(it_cond_begin + i_cond);
+                        if(r_cond.IsActive()){
+                            AssembleEntity<TAssembleLHS, TAssembleRHS, true>(rScheme, r_cond, i_cond, tls, this->mConditionEquationIdOffsets, this->mConditionEquationIds, mConditionTargetOffsets, mConditionTargets, targets, r_process_info);
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 计算一个实体的局部系统，并按目标位置分别累加到缩减系统、约束行块与反力向量
+             * @tparam TAtomic 是否使用原子加
+             */
+            template<bool TAssembleLHS, bool TAssembleRHS, bool TAtomic, typename TEntityType>
+            static void AssembleEntity(
+                TSchemeType& rScheme,
+                TEntityType& rEntity,
+                const IndexType EntityIndex,
+                AssemblyTLS& rTLS,
+                const IndexVectorType& rOffsets,
+                const IndexVectorType& rEquationIds,
+                const IndexVectorType& rTargetOffsets,
+                const IndexVectorType& rTargets,
+                const AssemblyTargets& rAssemblyTargets,
+                const ProcessInfo& rProcessInfo
+            ){
+                // 单元/条件在本次计算中从线程内存池取得的临时量在返回时统一回收
+                ScratchArena::Scope scratch_scope(rProcessInfo.GetScratchArena());
+
+                if constexpr(TAssembleLHS && TAssembleRHS){
+                    rScheme.CalculateSystemContributions(rEntity, rTLS.LHS, rTLS.RHS, rTLS.EquationIds, rProcessInfo);
+                } else if constexpr(TAssembleLHS){
+                    rScheme.CalculateLHSContribution(rEntity, rTLS.LHS, rTLS.EquationIds, rProcessInfo);
+                } else {
+                    rScheme.CalculateRHSContribution(rEntity, rTLS.RHS, rTLS.EquationIds, rProcessInfo);
+                }
+
+                const IndexType local_size = rOffsets[EntityIndex+1] - rOffsets[EntityIndex];
+                if constexpr(TAssembleLHS){
+                    QUEST_DEBUG_ERROR_IF(rTLS.LHS.size1() != local_size) << "The local LHS size " << rTLS.LHS.size1()
+                        << " does not match the number of equation ids " << local_size << std::endl;
+                }
+                if constexpr(TAssembleRHS){
+                    QUEST_DEBUG_ERROR_IF(rTLS.RHS.size() != local_size) << "The local RHS size " << rTLS.RHS.size()
+                        << " does not match the number of equation ids " << local_size << std::endl;
+                }
+
+                ScatterLocalSystem<TAssembleLHS, TAssembleRHS, TAtomic>(
+                    [&](const IndexType i, const IndexType j){ return rTLS.LHS(i,j); },
+                    [&](const IndexType i){ return rTLS.RHS[i]; },
+                    EntityIndex, rOffsets, rEquationIds, rTargetOffsets, rTargets, rAssemblyTargets);
+            }
+
+
+            /**
+             * @brief 把一批局部系统按目标位置分别累加到缩减系统、约束行块与反力向量
+             * @param UseAtomics 是否使用原子加
+             */
+            static void ScatterBatch(
+                const LocalSystemBatch& rBatch,
+                const IndexVectorType& rIndices,
+                const bool UseAtomics,
+                const IndexVectorType& rOffsets,
+                const IndexVectorType& rEquationIds,
+                const IndexVectorType& rTargetOffsets,
+                const IndexVectorType& rTargets,
+                const AssemblyTargets& rAssemblyTargets
+            ){
+                for(IndexType lane=0; lane<rIndices.size(); ++lane){
+                    const IndexType entity = rIndices[lane];
+                    QUEST_DEBUG_ERROR_IF(rBatch.LocalSize() != rOffsets[entity+1] - rOffsets[entity]) << "The local size " << rBatch.LocalSize()
+                        << " does not match the number of equation ids " << rOffsets[entity+1] - rOffsets[entity] << std::endl;
+                    auto lhs = [&](const IndexType i, const IndexType j){ return rBatch.LHS(lane,i,j); };
+                    auto rhs = [&](const IndexType i){ return rBatch.RHS(lane,i); };
+                    if(UseAtomics){
+                        ScatterLocalSystem<true, true, true>(lhs, rhs, entity, rOffsets, rEquationIds, rTargetOffsets, rTargets, rAssemblyTargets);
+                    } else {
+                        ScatterLocalSystem<true, true, false>(lhs, rhs, entity, rOffsets, rEquationIds, rTargetOffsets, rTargets, rAssemblyTargets);
+                    }
+                }
+            }
+
+
+            /**
+             * @brief 把一个实体的局部系统按目标位置分别累加到缩减系统、约束行块与反力向量
+             * @param rLHS 局部左端矩阵的访问函数 rLHS(i,j)
+             * @param rRHS 局部右端向量的访问函数 rRHS(i)
+             * @tparam TAtomic 是否使用原子加
+             */
+            template<bool TAssembleLHS, bool TAssembleRHS, bool TAtomic, typename TLHSAccessor, typename TRHSAccessor>
+            static void ScatterLocalSystem(
+                const TLHSAccessor& rLHS,
+                const TRHSAccessor& rRHS,
+                const IndexType EntityIndex,
+                const IndexVectorType& rOffsets,
+                const IndexVectorType& rEquationIds,
+                const IndexVectorType& rTargetOffsets,
+                const IndexVectorType& rTargets,
+                const AssemblyTargets& rAssemblyTargets
+            ){
+                auto add = [](TDataType& rTarget, const TDataType Value){
+                    if constexpr(TAtomic){
+                        AtomicAdd(rTarget, Value);
+                    } else {
+                        rTarget += Value;
+                    }
+                };
+
+                const IndexType local_size = rOffsets[EntityIndex+1] - rOffsets[EntityIndex];
+                const IndexType* p_ids = rEquationIds.data() + rOffsets[EntityIndex];
+                const IndexType free_size = rAssemblyTargets.FreeSize;
+
+                if constexpr(TAssembleLHS){
+                    const IndexType* p_targets = rTargets.data() + rTargetOffsets[EntityIndex];
+                    const IndexType nnz_a = rAssemblyTargets.NumberOfReducedNonZeros;
+
+                    for(IndexType i=0; i<local_size; ++i){
+                        for(IndexType j=0; j<local_size; ++j){
+                            const IndexType target = p_targets[i*local_size + j];
+                            const TDataType value = rLHS(i,j);
+                            if(target < nnz_a){
+                                add(rAssemblyTargets.pValues[target], value);
+                            } else if(target != std::numeric_limits<IndexType>::max()){
+                                add(rAssemblyTargets.pFixedRowValues[target - nnz_a], value);
+                            } else if(rAssemblyTargets.MoveFixedColumns){
+                                // 自由行约束列：K_fc Δu_c 移到右端
+                                add(rAssemblyTargets.pRhs[p_ids[i]], -value * rAssemblyTargets.pFixedIncrements[p_ids[j] - free_size]);
+                            }
+                        }
+                    }
+                }
+
+                if constexpr(TAssembleRHS){
+                    for(IndexType i=0; i<local_size; ++i){
+                        const IndexType I = p_ids[i];
+                        if(I < free_size){
+                            add(rAssemblyTargets.pRhs[I], rRHS(i));
+                        } else {
+                            add(rAssemblyTargets.pReactions[I - free_size], rRHS(i));
+                        }
+                    }
+                }
+            }
+
+
+        private:
+            /**
+             * @brief 约束行块 K_c，大小为 约束自由度个数 × 全部自由度个数
+             */
+            TSystemMatrixType mFixedRowMatrix;
+
+            /**
+             * @brief 约束自由度的给定增量，由下一次 Build 使用
+             */
+            TSystemVectorType mFixedDofIncrements;
+
+            /**
+             * @brief 最近一次 Build 施加的给定增量（用于计算反力）
+             */
+            TSystemVectorType mAppliedFixedDofIncrements;
+
+            /**
+             * @brief 各单元目标位置在 mElementTargets 中的起始位置
+             */
+            IndexVectorType mElementTargetOffsets;
+
+            /**
+             * @brief 所有单元局部矩阵元素（行优先）的目标位置
+             */
+            IndexVectorType mElementTargets;
+
+            /**
+             * @brief 各条件目标位置在 mConditionTargets 中的起始位置
+             */
+            IndexVectorType mConditionTargetOffsets;
+
+            /**
+             * @brief 所有条件局部矩阵元素（行优先）的目标位置
+             */
+            IndexVectorType mConditionTargets;
+
+            /**
+             * @brief 约束自由度的个数
+             */
+            IndexType mNumberOfFixedDofs = 0;
+
+            /**
+             * @brief 缩减矩阵的非零元个数
+             */
+            IndexType mReducedNonZeros = 0;
+
+            /**
+             * @brief 反力向量是否仍对应求解前的状态（需要用 K_c Δu 修正）
+             */
+            bool mReactionsAreLinearized = false;
+
+            /**
+             * @brief 编号时的约束状态指纹
+             */
+            std::size_t mFixityHash = 0;
+
+    };
+
+}
+
+#endif //QUEST_RESIDUAL_BASED_ELIMINATION_BUILDER_AND_SOLVER_HPP
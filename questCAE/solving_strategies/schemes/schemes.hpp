@@ -431,6 +431,38 @@ namespace Quest{
             }
 
 
+            /**
+             * @brief 批量计算一批同类型单元对系统的贡献，结果按结构数组写入 rBatch
+             * @details 默认实现对每个单元调用 CalculateSystemContributions 并逐通道写入，因此与逐实体组装的结果一致。
+             *  贡献即单元局部系统的方案可以重写此方法并调用 CalculateLocalSystemBatch，以使用单元的批量核函数
+             * @param rElements 动态类型与局部系统尺寸相同的单元
+             * @param rBatch 局部系统的批量结果
+             * @param rCurrentProcessInfo 当前进程信息实例
+             */
+            virtual void CalculateSystemContributionsBatch(
+                const Quest::span<Element* const> rElements,
+                LocalSystemBatch& rBatch,
+                const ProcessInfo& rCurrentProcessInfo
+            ){
+                CalculateSystemContributionsPerLane(rElements, rBatch, rCurrentProcessInfo);
+            }
+
+
+            /**
+             * @brief 批量计算一批同类型条件对系统的贡献，结果按结构数组写入 rBatch
+             * @param rConditions 动态类型与局部系统尺寸相同的条件
+             * @param rBatch 局部系统的批量结果
+             * @param rCurrentProcessInfo 当前进程信息实例
+             */
+            virtual void CalculateSystemContributionsBatch(
+                const Quest::span<Condition* const> rConditions,
+                LocalSystemBatch& rBatch,
+                const ProcessInfo& rCurrentProcessInfo
+            ){
+                CalculateSystemContributionsPerLane(rConditions, rBatch, rCurrentProcessInfo);
+            }
+
+
             /**
              * @brief 此函数旨在计算RHS贡献
              * @param rElement 要计算的单元
@@ -597,6 +629,42 @@ namespace Quest{
             }
 
         protected:
+            /**
+             * @brief 逐个实体调用 CalculateSystemContributions，并把结果写入批的各个通道
+             */
+            template<typename TEntityType>
+            void CalculateSystemContributionsPerLane(
+                const Quest::span<TEntityType* const> rEntities,
+                LocalSystemBatch& rBatch,
+                const ProcessInfo& rCurrentProcessInfo
+            ){
+                auto& r_lhs = rBatch.GetLhsScratch();
+                auto& r_rhs = rBatch.GetRhsScratch();
+                auto& r_equation_ids = rBatch.GetEquationIdScratch();
+                for(std::size_t lane=0; lane<rEntities.size(); ++lane){
+                    this->CalculateSystemContributions(*rEntities[lane], r_lhs, r_rhs, r_equation_ids, rCurrentProcessInfo);
+                    if(lane == 0){
+                        rBatch.Initialize(rEntities.size(), r_rhs.size());
+                    }
+                    rBatch.SetLane(lane, r_lhs, r_rhs);
+                }
+            }
+
+
+            /**
+             * @brief 直接调用实体的 CalculateLocalSystemBatch（可能是向量化的批量核函数）
+             * @details 只适用于贡献与实体局部系统相同（不引入时间积分项等）的方案
+             */
+            template<typename TEntityType>
+            static void CalculateLocalSystemBatch(
+                const Quest::span<TEntityType* const> rEntities,
+                LocalSystemBatch& rBatch,
+                const ProcessInfo& rCurrentProcessInfo
+            ){
+                if(!rEntities.empty()){
+                    rEntities[0]->CalculateLocalSystemBatch(rEntities, rBatch, rCurrentProcessInfo);
+                }
+            }
 
         private:
             /**
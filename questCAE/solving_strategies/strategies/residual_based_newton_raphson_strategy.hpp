@@ -0,0 +1,878 @@
+#ifndef QUEST_RESIDUAL_BASED_NEWTON_RAPHSON_STRATEGY_HPP
+#define QUEST_RESIDUAL_BASED_NEWTON_RAPHSON_STRATEGY_HPP
+
+// 系统头文件
+#include <cmath>
+#include <string>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/model_part.hpp"
+#include "includes/quest_parameters.hpp"
+#include "solving_strategies/strategies/implicit_solving_strategy.hpp"
+#include "solving_strategies/builder_and_solvers/builder_and_solvers.hpp"
+#include "solving_strategies/schemes/schemes.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @brief 基于残差的牛顿-拉弗森求解策略，可配置切线矩阵的复用方式
+     * @details 切线矩阵的更新方式由 "newton_type" 指定，并与构建级别一一对应：
+     *  - "full"（构建级别2）：每次迭代重新组装左端矩阵并分解
+     *  - "modified"（构建级别1）：每个求解步的第一次迭代更新切线，之后每隔 "tangent_update_interval" 次迭代
+     *    （为0时不按间隔更新）或残差下降过慢（本次残差大于上一次残差的 "stall_ratio" 倍）时更新
+     *  - "initial_stiffness"（构建级别0）：只在第一次求解、调用 SetRebuildLevel 或方程系统（大小、非零元数、约束状态、稀疏模式）变化时更新
+     *  不更新切线的迭代只组装右端向量（BuildRHS），并通过构建器的 ReuseFactorization 标志沿用线性求解器已有的分解，只执行回代。
+     *  收敛判据：迭代开始时的残差满足相对或绝对容差，或更新后的增量满足相对或绝对容差。
+     *  构建器要求调用 Build 时（IsBuildRequired，例如消去型构建器有待施加的约束自由度给定增量），任何方式都在该次迭代更新切线。
+     * @tparam TSparseSpace 线性代数稀疏空间
+     * @tparam TDenseSpace 线性代数密集空间
+     * @tparam TLinearSolver 线性求解器类型
+     */
+    template<class TSparseSpace, class TDenseSpace, class TLinearSolver>
+    class ResidualBasedNewtonRaphsonStrategy : public ImplicitSolvingStrategy<TSparseSpace, TDenseSpace, TLinearSolver>{
+        public:
+            using BaseType = ImplicitSolvingStrategy<TSparseSpace, TDenseSpace, TLinearSolver>;
+            using SolvingStrategyType = typename BaseType::BaseType;
+            using TDataType = typename BaseType::TDataType;
+            using TSystemMatrixType = typename BaseType::TSystemMatrixType;
+            using TSystemVectorType = typename BaseType::TSystemVectorType;
+            using TSystemMatrixPointerType = typename BaseType::TSystemMatrixPointerType;
+            using TSystemVectorPointerType = typename BaseType::TSystemVectorPointerType;
+            using TSchemeType = typename BaseType::TSchemeType;
+            using TBuilderAndSolverType = typename BaseType::TBuilderAndSolverType;
+            using ClassType = ResidualBasedNewtonRaphsonStrategy<TSparseSpace, TDenseSpace, TLinearSolver>;
+            using TDofType = typename BaseType::TDofType;
+            using DofsArrayType = typename BaseType::DofsArrayType;
+            using IndexType = std::size_t;
+
+            QUEST_CLASS_POINTER_DEFINITION(ResidualBasedNewtonRaphsonStrategy);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            explicit ResidualBasedNewtonRaphsonStrategy() {}
+
+
+            /**
+             * @brief 构造函数，基于传入参数
+             * @param rModelPart 要求解的模型部件
+             * @param pScheme 积分方案
+             * @param pNewBuilderAndSolver 构建器
+             * @param ThisParameters 设置
+             */
+            explicit ResidualBasedNewtonRaphsonStrategy(
+                ModelPart& rModelPart,
+                typename TSchemeType::Pointer pScheme,
+                typename TBuilderAndSolverType::Pointer pNewBuilderAndSolver,
+                Parameters ThisParameters
+            ): BaseType(rModelPart),
+                mpScheme(pScheme),
+                mpBuilderAndSolver(pNewBuilderAndSolver)
+            {
+                ThisParameters = this->ValidateAndAssignParameters(ThisParameters, this->GetDefaultParameters());
+                this->AssignSettings(ThisParameters);
+
+                InitializeMembers();
+            }
+
+
+            /**
+             * @brief 构造函数
+             * @param rModelPart 要求解的模型部件
+             * @param pScheme 积分方案
+             * @param pNewBuilderAndSolver 构建器
+             * @param MaxIterations 最大迭代次数
+             * @param CalculateReactions 是否计算反力
+             * @param ReformDofSetAtEachStep 是否每步重新收集自由度
+             * @param MoveMeshFlag 是否移动网格
+             */
+            explicit ResidualBasedNewtonRaphsonStrategy(
+                ModelPart& rModelPart,
+                typename TSchemeType::Pointer pScheme,
+                typename TBuilderAndSolverType::Pointer pNewBuilderAndSolver,
+                int MaxIterations = 30,
+                bool CalculateReactions = false,
+                bool ReformDofSetAtEachStep = false,
+                bool MoveMeshFlag = false
+            ): BaseType(rModelPart, MoveMeshFlag),
+                mpScheme(pScheme),
+                mpBuilderAndSolver(pNewBuilderAndSolver)
+            {
+                Parameters default_parameters = this->GetDefaultParameters();
+                default_parameters["max_iteration"].SetInt(MaxIterations);
+                default_parameters["compute_reactions"].SetBool(CalculateReactions);
+                default_parameters["reform_dofs_at_each_step"].SetBool(ReformDofSetAtEachStep);
+                default_parameters["move_mesh_flag"].SetBool(MoveMeshFlag);
+                this->AssignSettings(default_parameters);
+
+                InitializeMembers();
+            }
+
+
+            /**
+             * @brief 析构函数
+             */
+            ~ResidualBasedNewtonRaphsonStrategy() override
+            {
+                if(mpBuilderAndSolver != nullptr){
+                    mpBuilderAndSolver->SetReuseFactorizationFlag(false);
+                }
+            }
+
+
+            /**
+             * @brief 创建并返回一个使用相同积分方案与构建器的牛顿-拉弗森求解策略
+             */
+            typename SolvingStrategyType::Pointer Create(
+                ModelPart& rModelPart,
+                Parameters ThisParameters
+            ) const override{
+                return Quest::make_shared<ClassType>(rModelPart, mpScheme, mpBuilderAndSolver, ThisParameters);
+            }
+
+
+            /**
+             * @brief 初始化积分方案、单元与条件
+             */
+            void Initialize() override
+            {
+                QUEST_TRY
+
+                if(!mInitializeWasPerformed){
+                    ModelPart& r_model_part = BaseType::GetModelPart();
+
+                    if(!mpScheme->SchemeIsInitialized()){
+                        mpScheme->Initialize(r_model_part);
+                    }
+                    if(!mpScheme->ElementsAreInitialized()){
+                        mpScheme->InitializeElements(r_model_part);
+                    }
+                    if(!mpScheme->ConditionsAreInitialized()){
+                        mpScheme->InitializeConditions(r_model_part);
+                    }
+
+                    mInitializeWasPerformed = true;
+                }
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 准备求解步：调整方程系统大小，初始化构建器与积分方案
+             * @details 构建级别不为0时使当前切线失效，使每个求解步的第一次迭代重新组装左端矩阵
+             */
+            void InitializeSolutionStep() override
+            {
+                QUEST_TRY
+
+                if(!mSolutionStepIsInitialized){
+                    ModelPart& r_model_part = BaseType::GetModelPart();
+
+                    if(!mInitializeWasPerformed){
+                        Initialize();
+                    }
+
+                    if(mReformDofSetAtEachStep){
+                        mpBuilderAndSolver->SetDofSetIsInitializedFlag(false);
+                        this->mStiffnessMatrixIsBuilt = false;
+                    }
+
+                    mpBuilderAndSolver->ResizeAndInitializeVectors(mpScheme, mpA, mpDx, mpb, r_model_part);
+
+                    TSystemMatrixType& rA = *mpA;
+                    TSystemVectorType& rDx = *mpDx;
+                    TSystemVectorType& rb = *mpb;
+
+                    mpBuilderAndSolver->InitializeSolutionStep(r_model_part, rA, rDx, rb);
+                    mpScheme->InitializeSolutionStep(r_model_part, rA, rDx, rb);
+
+                    if(this->mRebuildLevel > 0){
+                        this->mStiffnessMatrixIsBuilt = false;
+                    }
+                    mTangentUpdateRequested = false;
+
+                    mSolutionStepIsInitialized = true;
+                }
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 预测当前求解步的解
+             */
+            void Predict() override
+            {
+                QUEST_TRY
+
+                if(!mSolutionStepIsInitialized){
+                    InitializeSolutionStep();
+                }
+
+                mpScheme->Predict(BaseType::GetModelPart(), mpBuilderAndSolver->GetDofSet(), *mpA, *mpDx, *mpb);
+
+                if(BaseType::GetMoveMeshFlag()){
+                    BaseType::MoveMesh();
+                }
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 牛顿-拉弗森迭代求解当前步
+             * @return 是否收敛
+             */
+            bool SolveSolutionStep() override
+            {
+                QUEST_TRY
+
+                ModelPart& r_model_part = BaseType::GetModelPart();
+                DofsArrayType& r_dof_set = mpBuilderAndSolver->GetDofSet();
+                TSystemMatrixType& rA = *mpA;
+                TSystemVectorType& rDx = *mpDx;
+                TSystemVectorType& rb = *mpb;
+
+                CheckSystemSignature(rA, r_dof_set);
+
+                mIterationNumber = 0;
+                mInitialResidualNorm = 0.0;
+                double previous_residual_norm = 0.0;
+                bool is_converged = false;
+
+                while(!is_converged && mIterationNumber < mMaxIterationNumber){
+                    ++mIterationNumber;
+
+                    mpScheme->InitializeNonLinIteration(r_model_part, rA, rDx, rb);
+
+                    TSparseSpace::SetToZero(rDx);
+                    const bool update_tangent = IsTangentUpdateRequired();
+                    if(update_tangent){
+                        mpBuilderAndSolver->Build(mpScheme, r_model_part, rA, rb);
+                        mpBuilderAndSolver->ApplyDirichletConditions(mpScheme, r_model_part, rA, rDx, rb);
+                        mpBuilderAndSolver->SetReuseFactorizationFlag(false);
+
+                        this->mStiffnessMatrixIsBuilt = true;
+                        mTangentUpdateRequested = false;
+                        mIterationsSinceTangentUpdate = 0;
+                        ++mNumberOfTangentUpdates;
+                    } else {
+                        mpBuilderAndSolver->BuildRHS(mpScheme, r_model_part, rb);
+                        mpBuilderAndSolver->SetReuseFactorizationFlag(true);
+                    }
+
+                    mResidualNorm = TSparseSpace::TwoNorm(rb);
+                    if(mIterationNumber == 1){
+                        mInitialResidualNorm = mResidualNorm;
+                    }
+
+                    QUEST_INFO_IF("ResidualBasedNewtonRaphsonStrategy", this->GetEchoLevel() > 1) << "Iteration " << mIterationNumber
+                        << " residual norm : " << mResidualNorm << (update_tangent ? " (tangent updated)" : "") << std::endl;
+
+                    if(IsResidualConverged()){
+                        mpScheme->FinalizeNonLinIteration(r_model_part, rA, rDx, rb);
+                        is_converged = true;
+                        break;
+                    }
+
+                    if(!std::isfinite(mResidualNorm)){
+                        QUEST_INFO_IF("ResidualBasedNewtonRaphsonStrategy", this->GetEchoLevel() > 0) << "The residual norm is not finite at iteration "
+                            << mIterationNumber << ". The iterations are stopped" << std::endl;
+                        mpScheme->FinalizeNonLinIteration(r_model_part, rA, rDx, rb);
+                        break;
+                    }
+
+                    mpBuilderAndSolver->SystemSolve(rA, rDx, rb);
+
+                    mpScheme->Update(r_model_part, r_dof_set, rA, rDx, rb);
+                    if(BaseType::GetMoveMeshFlag()){
+                        BaseType::MoveMesh();
+                    }
+
+                    mpScheme->FinalizeNonLinIteration(r_model_part, rA, rDx, rb);
+
+                    is_converged = IsIncrementConverged(rDx, r_dof_set);
+
+                    if(this->mRebuildLevel == 1 && mIterationNumber > 1 && mResidualNorm > mStallRatio*previous_residual_norm){
+                        QUEST_INFO_IF("ResidualBasedNewtonRaphsonStrategy", this->GetEchoLevel() > 1) << "Convergence stalled (residual ratio "
+                            << mResidualNorm/previous_residual_norm << "). The tangent will be updated" << std::endl;
+                        mTangentUpdateRequested = true;
+                    }
+                    previous_residual_norm = mResidualNorm;
+                    ++mIterationsSinceTangentUpdate;
+                }
+
+                QUEST_INFO_IF("ResidualBasedNewtonRaphsonStrategy", !is_converged && this->GetEchoLevel() > 0) << "Maximum number of iterations "
+                    << mMaxIterationNumber << " reached without convergence. Residual norm : " << mResidualNorm << std::endl;
+
+                return is_converged;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 结束求解步：计算反力，结束积分方案与构建器的求解步
+             */
+            void FinalizeSolutionStep() override
+            {
+                QUEST_TRY
+
+                ModelPart& r_model_part = BaseType::GetModelPart();
+                TSystemMatrixType& rA = *mpA;
+                TSystemVectorType& rDx = *mpDx;
+                TSystemVectorType& rb = *mpb;
+
+                if(mCalculateReactionsFlag){
+                    mpBuilderAndSolver->CalculateReactions(mpScheme, r_model_part, rA, rDx, rb);
+                }
+
+                mpScheme->FinalizeSolutionStep(r_model_part, rA, rDx, rb);
+                mpBuilderAndSolver->FinalizeSolutionStep(r_model_part, rA, rDx, rb);
+
+                mSolutionStepIsInitialized = false;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 清除方程系统、构建器与积分方案的内部存储
+             */
+            void Clear() override
+            {
+                QUEST_TRY
+
+                if(mpA != nullptr){
+                    TSparseSpace::Clear(mpA);
+                }
+                if(mpDx != nullptr){
+                    TSparseSpace::Clear(mpDx);
+                }
+                if(mpb != nullptr){
+                    TSparseSpace::Clear(mpb);
+                }
+
+                mpBuilderAndSolver->SetDofSetIsInitializedFlag(false);
+                mpBuilderAndSolver->SetReuseFactorizationFlag(false);
+                mpBuilderAndSolver->Clear();
+                mpScheme->Clear();
+
+                this->mStiffnessMatrixIsBuilt = false;
+                mSystemSignature = SystemSignature();
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 当前求解步是否收敛（重新组装残差后检查）
+             */
+            bool IsConverged() override
+            {
+                QUEST_TRY
+
+                mpBuilderAndSolver->BuildRHS(mpScheme, BaseType::GetModelPart(), *mpb);
+                mResidualNorm = TSparseSpace::TwoNorm(*mpb);
+
+                return IsResidualConverged();
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 计算输出所需的数据
+             */
+            void CalculateOutputData() override
+            {
+                mpScheme->CalculateOutputData(BaseType::GetModelPart(), mpBuilderAndSolver->GetDofSet(), *mpA, *mpDx, *mpb);
+            }
+
+
+            /**
+             * @brief 设置构建级别（0：初始刚度，1：修正牛顿，2：完全牛顿），并使当前切线失效
+             */
+            void SetRebuildLevel(int Level) override
+            {
+                QUEST_ERROR_IF(Level < 0 || Level > 2) << "The rebuild level must be 0 (initial stiffness), 1 (modified Newton) or 2 (full Newton). Got " << Level << std::endl;
+                BaseType::SetRebuildLevel(Level);
+            }
+
+
+            /**
+             * @brief 返回切线矩阵的更新方式
+             */
+            std::string GetNewtonType() const
+            {
+                switch(this->mRebuildLevel){
+                    case 0:
+                        return "initial_stiffness";
+                    case 1:
+                        return "modified";
+                    default:
+                        return "full";
+                }
+            }
+
+
+            /**
+             * @brief 设置修正牛顿法中两次切线更新之间的最大迭代次数（0 表示不按间隔更新）
+             */
+            void SetTangentUpdateInterval(const IndexType Interval)
+            {
+                mTangentUpdateInterval = Interval;
+            }
+
+
+            /**
+             * @brief 返回修正牛顿法中两次切线更新之间的最大迭代次数
+             */
+            IndexType GetTangentUpdateInterval() const
+            {
+                return mTangentUpdateInterval;
+            }
+
+
+            /**
+             * @brief 设置最大迭代次数
+             */
+            void SetMaxIterationNumber(const IndexType MaxIterationNumber)
+            {
+                mMaxIterationNumber = MaxIterationNumber;
+            }
+
+
+            /**
+             * @brief 返回最大迭代次数
+             */
+            IndexType GetMaxIterationNumber() const
+            {
+                return mMaxIterationNumber;
+            }
+
+
+            /**
+             * @brief 返回上一个求解步的迭代次数
+             */
+            IndexType GetIterationNumber() const
+            {
+                return mIterationNumber;
+            }
+
+
+            /**
+             * @brief 返回切线矩阵（左端矩阵）组装的累计次数
+             */
+            IndexType GetNumberOfTangentUpdates() const
+            {
+                return mNumberOfTangentUpdates;
+            }
+
+
+            /**
+             * @brief 返回最近一次组装的残差范数
+             */
+            double GetResidualNorm() override
+            {
+                return mResidualNorm;
+            }
+
+
+            /**
+             * @brief 返回积分方案
+             */
+            typename TSchemeType::Pointer GetScheme()
+            {
+                return mpScheme;
+            }
+
+
+            /**
+             * @brief 返回构建器
+             */
+            typename TBuilderAndSolverType::Pointer GetBuilderAndSolver()
+            {
+                return mpBuilderAndSolver;
+            }
+
+
+            /**
+             * @brief 设置是否在求解步结束时计算反力
+             */
+            void SetCalculateReactionsFlag(bool CalculateReactionsFlag)
+            {
+                mCalculateReactionsFlag = CalculateReactionsFlag;
+                mpBuilderAndSolver->SetCalculateReactionsFlag(CalculateReactionsFlag);
+            }
+
+
+            /**
+             * @brief 返回是否在求解步结束时计算反力
+             */
+            bool GetCalculateReactionsFlag() const
+            {
+                return mCalculateReactionsFlag;
+            }
+
+
+            TSystemMatrixType& GetSystemMatrix() override
+            {
+                return *mpA;
+            }
+
+
+            TSystemVectorType& GetSystemVector() override
+            {
+                return *mpb;
+            }
+
+
+            TSystemVectorType& GetSolutionVector() override
+            {
+                return *mpDx;
+            }
+
+
+            /**
+             * @brief 检查模型、构建器与积分方案的设置
+             */
+            int Check() override
+            {
+                QUEST_TRY
+
+                BaseType::Check();
+
+                mpBuilderAndSolver->Check(BaseType::GetModelPart());
+                mpScheme->Check(BaseType::GetModelPart());
+
+                return 0;
+
+                QUEST_CATCH("")
+            }
+
+
+            /**
+             * @brief 该方法提供默认参数，以避免不同构造函数之间的冲突
+             * @return 默认参数
+             */
+            Parameters GetDefaultParameters() const override
+            {
+                Parameters default_parameters = Parameters(R"(
+                {
+                    "name"                            : "newton_raphson_strategy",
+                    "newton_type"                     : "full",
+                    "tangent_update_interval"         : 0,
+                    "stall_ratio"                     : 0.5,
+                    "max_iteration"                   : 30,
+                    "residual_relative_tolerance"     : 1.0e-6,
+                    "residual_absolute_tolerance"     : 1.0e-9,
+                    "displacement_relative_tolerance" : 1.0e-6,
+                    "displacement_absolute_tolerance" : 1.0e-9,
+                    "compute_reactions"               : false,
+                    "reform_dofs_at_each_step"        : false
+                })");
+
+                const Parameters base_default_parameters = BaseType::GetDefaultParameters();
+                default_parameters.RecursivelyAddMissingParameters(base_default_parameters);
+
+                return default_parameters;
+            }
+
+
+            /**
+             * @brief 返回当前类在参数中的名称
+             */
+            static std::string Name()
+            {
+                return "newton_raphson_strategy";
+            }
+
+
+            std::string Info() const override
+            {
+                return "ResidualBasedNewtonRaphsonStrategy";
+            }
+
+
+            void PrintData(std::ostream& rOStream) const override
+            {
+                rOStream << Info() << std::endl;
+                rOStream << "newton type : " << GetNewtonType() << " tangent updates : " << mNumberOfTangentUpdates
+                         << " last iterations : " << mIterationNumber << std::endl;
+            }
+
+        protected:
+            /**
+             * @brief 该方法将设置分配给成员变量
+             * @details 构建级别由 "newton_type" 决定，"build_level" 被忽略
+             * @param ThisParameters 要分配给成员变量的参数
+             */
+            void AssignSettings(const Parameters ThisParameters) override
+            {
+                BaseType::AssignSettings(ThisParameters);
+
+                const std::string newton_type = ThisParameters["newton_type"].GetString();
+                if(newton_type == "full"){
+                    this->mRebuildLevel = 2;
+                } else if(newton_type == "modified"){
+                    this->mRebuildLevel = 1;
+                } else if(newton_type == "initial_stiffness"){
+                    this->mRebuildLevel = 0;
+                } else {
+                    QUEST_ERROR << "Unknown newton_type \"" << newton_type << "\". Available options are: full, modified, initial_stiffness" << std::endl;
+                }
+
+                QUEST_ERROR_IF(ThisParameters["tangent_update_interval"].GetInt() < 0) << "The tangent update interval must not be negative" << std::endl;
+                mTangentUpdateInterval = ThisParameters["tangent_update_interval"].GetInt();
+                mStallRatio = ThisParameters["stall_ratio"].GetDouble();
+
+                QUEST_ERROR_IF(ThisParameters["max_iteration"].GetInt() < 1) << "The maximum number of iterations must be positive" << std::endl;
+                mMaxIterationNumber = ThisParameters["max_iteration"].GetInt();
+
+                mResidualRelativeTolerance = ThisParameters["residual_relative_tolerance"].GetDouble();
+                mResidualAbsoluteTolerance = ThisParameters["residual_absolute_tolerance"].GetDouble();
+                mDisplacementRelativeTolerance = ThisParameters["displacement_relative_tolerance"].GetDouble();
+                mDisplacementAbsoluteTolerance = ThisParameters["displacement_absolute_tolerance"].GetDouble();
+
+                mCalculateReactionsFlag = ThisParameters["compute_reactions"].GetBool();
+                mReformDofSetAtEachStep = ThisParameters["reform_dofs_at_each_step"].GetBool();
+            }
+
+        private:
+            /**
+             * @brief 方程系统的指纹，用于判断已有的切线是否仍与方程系统一致
+             */
+            struct SystemSignature{
+                IndexType Size = 0;
+                IndexType NonZeros = 0;
+                IndexType NumberOfDofs = 0;
+                std::size_t FixityHash = 0;
+                IndexType NumberOfStructureBuilds = 0;
+
+                bool operator == (const SystemSignature& rOther) const{
+                    return Size == rOther.Size && NonZeros == rOther.NonZeros && NumberOfDofs == rOther.NumberOfDofs && FixityHash == rOther.FixityHash
+                        && NumberOfStructureBuilds == rOther.NumberOfStructureBuilds;
+                }
+
+                bool operator != (const SystemSignature& rOther) const{
+                    return !(*this == rOther);
+                }
+            };
+
+            /**
+             * @brief 初始化方程系统与构建器
+             */
+            void InitializeMembers()
+            {
+                mpA = TSparseSpace::CreateEmptyMatrixPointer();
+                mpDx = TSparseSpace::CreateEmptyVectorPointer();
+                mpb = TSparseSpace::CreateEmptyVectorPointer();
+
+                this->mStiffnessMatrixIsBuilt = false;
+
+                mpBuilderAndSolver->SetCalculateReactionsFlag(mCalculateReactionsFlag);
+                mpBuilderAndSolver->SetReshapeMatrixFlag(mReformDofSetAtEachStep);
+                mpBuilderAndSolver->SetReuseFactorizationFlag(false);
+                mpBuilderAndSolver->SetEchoLevel(this->GetEchoLevel());
+            }
+
+
+            /**
+             * @brief 当前迭代是否需要重新组装左端矩阵
+             */
+            bool IsTangentUpdateRequired() const
+            {
+                if(!this->mStiffnessMatrixIsBuilt || mpBuilderAndSolver->IsBuildRequired()){
+                    return true;
+                }
+
+                switch(this->mRebuildLevel){
+                    case 0:
+                        return false;
+                    case 1:
+                        return mTangentUpdateRequested || (mTangentUpdateInterval != 0 && mIterationsSinceTangentUpdate >= mTangentUpdateInterval);
+                    default:
+                        return true;
+                }
+            }
+
+
+            /**
+             * @brief 方程系统的大小、非零元数或约束状态变化，或构建器重建了稀疏模式时使已有的切线失效
+             * @details 稀疏模式重建后非零元数可能不变而位置不同，因此同时比较构建器的稀疏模式构建次数
+             */
+            void CheckSystemSignature(const TSystemMatrixType& rA, const DofsArrayType& rDofSet)
+            {
+                SystemSignature signature;
+                signature.Size = rA.size1();
+                signature.NonZeros = rA.nnz();
+                signature.NumberOfDofs = rDofSet.size();
+                signature.FixityHash = TBuilderAndSolverType::ComputeFixityHash(rDofSet);
+                signature.NumberOfStructureBuilds = mpBuilderAndSolver->GetNumberOfStructureBuilds();
+
+                if(signature != mSystemSignature){
+                    QUEST_INFO_IF("ResidualBasedNewtonRaphsonStrategy", this->mStiffnessMatrixIsBuilt && this->GetEchoLevel() > 1)
+                        << "The equation system has changed. The tangent will be updated" << std::endl;
+                    this->mStiffnessMatrixIsBuilt = false;
+                    mSystemSignature = signature;
+                }
+            }
+
+
+            /**
+             * @brief 残差是否满足相对或绝对容差
+             */
+            bool IsResidualConverged() const
+            {
+                if(mResidualNorm <= mResidualAbsoluteTolerance){
+                    return true;
+                }
+                return mInitialResidualNorm > 0.0 && mResidualNorm/mInitialResidualNorm <= mResidualRelativeTolerance;
+            }
+
+
+            /**
+             * @brief 增量是否满足相对（相对于自由自由度的当前值）或绝对容差
+             */
+            bool IsIncrementConverged(const TSystemVectorType& rDx, DofsArrayType& rDofSet) const
+            {
+                const double increment_norm = TSparseSpace::TwoNorm(rDx);
+                if(increment_norm <= mDisplacementAbsoluteTolerance){
+                    return true;
+                }
+
+                const double solution_norm = std::sqrt(block_for_each<Internals::SumReduction<double>>(rDofSet, [](TDofType& rDof){
+                    if(rDof.IsFixed()){
+                        return 0.0;
+                    }
+                    const double value = rDof.GetSolutionStepValue();
+                    return value*value;
+                }));
+
+                return solution_norm > 0.0 && increment_norm/solution_norm <= mDisplacementRelativeTolerance;
+            }
+
+        private:
+            /**
+             * @brief 积分方案
+             */
+            typename TSchemeType::Pointer mpScheme = nullptr;
+
+            /**
+             * @brief 构建器
+             */
+            typename TBuilderAndSolverType::Pointer mpBuilderAndSolver = nullptr;
+
+            /**
+             * @brief 左端矩阵
+             */
+            TSystemMatrixPointerType mpA;
+
+            /**
+             * @brief 解的增量
+             */
+            TSystemVectorPointerType mpDx;
+
+            /**
+             * @brief 右端向量（残差）
+             */
+            TSystemVectorPointerType mpb;
+
+            /**
+             * @brief 修正牛顿法中两次切线更新之间的最大迭代次数（0 表示不按间隔更新）
+             */
+            IndexType mTangentUpdateInterval = 0;
+
+            /**
+             * @brief 修正牛顿法中判断收敛停滞的残差比
+             */
+            double mStallRatio = 0.5;
+
+            /**
+             * @brief 最大迭代次数
+             */
+            IndexType mMaxIterationNumber = 30;
+
+            /**
+             * @brief 残差的相对与绝对容差
+             */
+            double mResidualRelativeTolerance = 1.0e-6;
+            double mResidualAbsoluteTolerance = 1.0e-9;
+
+            /**
+             * @brief 增量的相对与绝对容差
+             */
+            double mDisplacementRelativeTolerance = 1.0e-6;
+            double mDisplacementAbsoluteTolerance = 1.0e-9;
+
+            /**
+             * @brief 是否计算反力
+             */
+            bool mCalculateReactionsFlag = false;
+
+            /**
+             * @brief 是否每步重新收集自由度
+             */
+            bool mReformDofSetAtEachStep = false;
+
+            /**
+             * @brief 是否已经初始化
+             */
+            bool mInitializeWasPerformed = false;
+
+            /**
+             * @brief 当前求解步是否已经初始化
+             */
+            bool mSolutionStepIsInitialized = false;
+
+            /**
+             * @brief 是否因收敛停滞要求在下一次迭代更新切线
+             */
+            bool mTangentUpdateRequested = false;
+
+            /**
+             * @brief 当前求解步的迭代次数
+             */
+            IndexType mIterationNumber = 0;
+
+            /**
+             * @brief 自上次切线更新以来的迭代次数
+             */
+            IndexType mIterationsSinceTangentUpdate = 0;
+
+            /**
+             * @brief 切线更新的累计次数
+             */
+            IndexType mNumberOfTangentUpdates = 0;
+
+            /**
+             * @brief 当前求解步第一次迭代的残差范数
+             */
+            double mInitialResidualNorm = 0.0;
+
+            /**
+             * @brief 最近一次组装的残差范数
+             */
+            double mResidualNorm = 0.0;
+
+            /**
+             * @brief 上一次组装切线时方程系统的指纹
+             */
+            SystemSignature mSystemSignature;
+
+            /**
+             * @brief 复制构造函数
+             */
+            ResidualBasedNewtonRaphsonStrategy(const ResidualBasedNewtonRaphsonStrategy& Other);
+
+    };
+
+}
+
+#endif //QUEST_RESIDUAL_BASED_NEWTON_RAPHSON_STRATEGY_HPP
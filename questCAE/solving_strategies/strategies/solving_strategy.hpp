@@ -190,7 +190,9 @@ namespace Quest{
 
             /**
              * @brief 设置重建级别值
-             * 仅用于隐式策略
+             * @details 基类没有重建级别的概念，调用即报错。只有 ImplicitSolvingStrategy（刚度矩阵的构建级别 0/1/2，
+             *  ResidualBasedNewtonRaphsonStrategy 以此选择切线的更新方式）与 ExplicitSolvingStrategy（自由度集合的重建级别 0/1）
+             *  及其派生类实现了该方法，两者的级别含义不同
              * @param Level 重建级别
              */
             virtual void SetRebuildLevel(int Level)
@@ -201,7 +203,7 @@ namespace Quest{
 
             /**
              * @brief 获取重建级别值
-             * 仅用于隐式策略
+             * @details 与 SetRebuildLevel 相同，只在 ImplicitSolvingStrategy 与 ExplicitSolvingStrategy 及其派生类中可用
              * @return 重建级别
              */
             virtual int GetRebuildLevel() const
@@ -83,6 +83,7 @@ namespace Quest{
         mGeometries.Clear();
         mTables.clear();
         mpCommunicator->Clear();
+        mpColoring.reset();
         this->AssignFlags(Flags());
 
         QUEST_CATCH("")
@@ -1478,6 +1479,33 @@ namespace Quest{
     }
 
 
+    const ModelPartColoring& ModelPart::GetColoring(){
+        QUEST_TRY
+
+        const SizeType number_of_elements = NumberOfElements();
+        const SizeType number_of_conditions = NumberOfConditions();
+        const std::size_t element_hash = EntityColoringUtilities::ComputeConnectivityHash(Elements());
+        const std::size_t condition_hash = EntityColoringUtilities::ComputeConnectivityHash(Conditions());
+
+        if(mpColoring == nullptr
+            || mpColoring->NumberOfElements != number_of_elements || mpColoring->NumberOfConditions != number_of_conditions
+            || mpColoring->ElementConnectivityHash != element_hash || mpColoring->ConditionConnectivityHash != condition_hash){
+            auto p_coloring = Quest::make_shared<ModelPartColoring>();
+            p_coloring->ElementColoring = EntityColoringUtilities::ColorEntities(Elements());
+            p_coloring->ConditionColoring = EntityColoringUtilities::ColorEntities(Conditions());
+            p_coloring->NumberOfElements = number_of_elements;
+            p_coloring->NumberOfConditions = number_of_conditions;
+            p_coloring->ElementConnectivityHash = element_hash;
+            p_coloring->ConditionConnectivityHash = condition_hash;
+            mpColoring = p_coloring;
+        }
+
+        return *mpColoring;
+
+        QUEST_CATCH("")
+    }
+
+
     ModelPart::GeometryType::Pointer ModelPart::CreateNewGeometry(
         const std::string& rGeometryName,
         const std::vector<ModelPart::IndexType>& rGeometryNodeIds
@@ -64,8 +64,7 @@ namespace Quest{
 
     void PeriodicCondition::CalculateRightHandSide(VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo)
     {
-        MatrixType LHS;
-        CalculateLocalSystem(LHS,rRightHandSideVector,rCurrentProcessInfo);
+        rRightHandSideVector.resize(0,false);
     }
 
 
@@ -140,9 +140,12 @@ namespace Quest{
     using RealDenseSpace = UblasSpace<double, DenseMatrix<double>, DenseVector<double>>;
     using ComplexSparseSpace = UblasSpace<std::complex<double>, boost::numeric::ublas::compressed_matrix<std::complex<double>>, boost::numeric::ublas::vector<std::complex<double>>>;
     using ComplexDenseSpace = UblasSpace<std::complex<double>, DenseMatrix<std::complex<double>>, DenseVector<std::complex<double>>>;
+    using FloatSparseSpace = UblasSpace<float, boost::numeric::ublas::compressed_matrix<float>, boost::numeric::ublas::vector<float>>;
+    using FloatDenseSpace = UblasSpace<float, DenseMatrix<float>, DenseVector<float>>;
 
     template class QuestComponents<LinearSolverFactory<RealSparseSpace, RealDenseSpace>>;
     template class QuestComponents<LinearSolverFactory<ComplexSparseSpace, ComplexDenseSpace>>;
+    template class QuestComponents<LinearSolverFactory<FloatSparseSpace, FloatDenseSpace>>;
     template class QuestComponents<PreconditionerFactory<RealSparseSpace, RealDenseSpace>>;
     template class QuestComponents<ExplicitBuilder<RealSparseSpace, RealDenseSpace>>;
 
@@ -0,0 +1,283 @@
+#ifndef QUEST_CSR_SPACE_HPP
+#define QUEST_CSR_SPACE_HPP
+
+// 系统头文件
+#include <cmath>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/ublas_interface.hpp"
+#include "space/ublas_space.hpp"
+#include "utilities/dof_updater.hpp"
+
+namespace Quest{
+
+    /**
+     * @class CsrSpace
+     * @brief 以项目自带的CSR类矩阵（CsrMatrix、BlockCsrMatrix、SellCSigmaMatrix等）为稀疏矩阵类型的线性代数空间
+     * @details 提供与 UblasSpace 相同的静态接口，使迭代求解器与预条件子可以直接作用于这些矩阵。
+     *  矩阵相关的操作委托给矩阵自身的 SpMV/TransposeSpMV/NormFrobenius/SetValue，
+     *  向量相关的操作委托给稠密 UblasSpace
+     * @tparam TDataType 数据类型
+     * @tparam TMatrixType 矩阵类型，需提供 size1()/size2()/SpMV()/TransposeSpMV()/NormFrobenius()/SetValue()
+     * @tparam TVectorType 向量类型
+     */
+    template<typename TDataType, typename TMatrixType, typename TVectorType = DenseVector<TDataType>>
+    class CsrSpace{
+        public:
+            QUEST_CLASS_POINTER_DEFINITION(CsrSpace);
+
+            using DataType = TDataType;
+            using MatrixType = TMatrixType;
+            using VectorType = TVectorType;
+            using IndexType = std::size_t;
+            using SizeType = std::size_t;
+            using MatrixPointerType = typename Quest::shared_ptr<TMatrixType>;
+            using VectorPointerType = typename Quest::shared_ptr<TVectorType>;
+            using DofUpdaterType = DofUpdater<CsrSpace<TDataType, TMatrixType, TVectorType>>;
+            using DofUpdaterPointerType = typename DofUpdaterType::UniquePointer;
+
+            using VectorSpaceType = UblasSpace<TDataType, DenseMatrix<TDataType>, TVectorType>;
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            CsrSpace(){}
+
+
+            /**
+             * @brief 析构函数
+             */
+            virtual ~CsrSpace(){}
+
+
+            /**
+             * @brief 创建一个空的矩阵指针对象
+             */
+            static MatrixPointerType CreateEmptyMatrixPointer(){
+                return MatrixPointerType(new TMatrixType());
+            }
+
+
+            /**
+             * @brief 创建一个空的向量指针对象
+             */
+            static VectorPointerType CreateEmptyVectorPointer(){
+                return VectorPointerType(new TVectorType(0));
+            }
+
+
+            /**
+             * @brief 获取向量的维度
+             */
+            static IndexType Size(const VectorType& rV){
+                return rV.size();
+            }
+
+
+            /**
+             * @brief 获取矩阵行数
+             */
+            static IndexType Size1(const MatrixType& rM){
+                return rM.size1();
+            }
+
+
+            /**
+             * @brief 获取矩阵列数
+             */
+            static IndexType Size2(const MatrixType& rM){
+                return rM.size2();
+            }
+
+
+            /**
+             * @brief rY = rX
+             */
+            static void Copy(const VectorType& rX, VectorType& rY){
+                VectorSpaceType::Copy(rX, rY);
+            }
+
+
+            /**
+             * @brief rX * rY
+             */
+            static TDataType Dot(const VectorType& rX, const VectorType& rY){
+                return VectorSpaceType::Dot(rX, rY);
+            }
+
+
+            /**
+             * @brief ||rX||2
+             */
+            static TDataType TwoNorm(const VectorType& rX){
+                return std::sqrt(Dot(rX, rX));
+            }
+
+
+            /**
+             * @brief 矩阵的 Frobenius 范数
+             */
+            static TDataType TwoNorm(const MatrixType& rA){
+                return rA.NormFrobenius();
+            }
+
+
+            /**
+             * @brief rY = rA * rX
+             * @details rY 的原有内容被覆盖，无需预先初始化
+             */
+            static void Mult(const MatrixType& rA, const VectorType& rX, VectorType& rY){
+                if(rY.size() != rA.size1()){
+                    rY.resize(rA.size1(), false);
+                }
+                rA.SpMV(TDataType(1), rX, TDataType(), rY);
+            }
+
+
+            /**
+             * @brief rY = rAT * rX
+             * @details rY 的原有内容被覆盖，无需预先初始化
+             */
+            static void TransposeMult(const MatrixType& rA, const VectorType& rX, VectorType& rY){
+                if(rY.size() != rA.size2()){
+                    rY.resize(rA.size2(), false);
+                }
+                rA.TransposeSpMV(TDataType(1), rX, TDataType(), rY);
+            }
+
+
+            /**
+             * @brief 检查是否需要进行乘法操作，并尝试避免进行乘法
+             */
+            static void InplaceMult(VectorType& rX, const double A){
+                VectorSpaceType::InplaceMult(rX, A);
+            }
+
+
+            /**
+             * @brief X = A * y
+             */
+            static void Assign(VectorType& rX, const double A, const VectorType& rY){
+                VectorSpaceType::Assign(rX, A, rY);
+            }
+
+
+            /**
+             * @brief X += A*y
+             */
+            static void UnaliasedAdd(VectorType& rX, const double A, const VectorType& rY){
+                VectorSpaceType::UnaliasedAdd(rX, A, rY);
+            }
+
+
+            /**
+             * @brief rZ = (A * rX) + (B * rY)
+             */
+            static void ScaleAndAdd(const double A, const VectorType& rX, const double B, const VectorType& rY, VectorType& rZ){
+                VectorSpaceType::ScaleAndAdd(A, rX, B, rY, rZ);
+            }
+
+
+            /**
+             * @brief rY = (A * rX) + (B * rY)
+             */
+            static void ScaleAndAdd(const double A, const VectorType& rX, const double B, VectorType& rY){
+                VectorSpaceType::ScaleAndAdd(A, rX, B, rY);
+            }
+
+
+            /**
+             * @brief 设置向量某一元素值
+             */
+            static void SetValue(VectorType& rX, IndexType i, TDataType value){
+                rX[i] = value;
+            }
+
+
+            /**
+             * @brief rX = A
+             */
+            static void Set(VectorType& rX, TDataType A){
+                std::fill(rX.begin(), rX.end(), A);
+            }
+
+
+            static void Resize(VectorType& rX, SizeType n){
+                rX.resize(n, false);
+            }
+
+
+            static void Resize(VectorPointerType& pX, SizeType n){
+                pX->resize(n, false);
+            }
+
+
+            static void Clear(MatrixPointerType& pA){
+                pA->Clear();
+            }
+
+
+            static void Clear(VectorPointerType& pX){
+                pX->clear();
+                pX->resize(0, false);
+            }
+
+
+            /**
+             * @brief 将矩阵 rA 的所有元素设置为零，保留稀疏模式
+             */
+            inline static void SetToZero(MatrixType& rA){
+                rA.SetValue(TDataType());
+            }
+
+
+            inline static void SetToZero(VectorType& rX){
+                VectorSpaceType::SetToZero(rX);
+            }
+
+
+            inline static constexpr bool IsDistributed() { return false; }
+
+
+            inline static TDataType GetValue(const VectorType& x, std::size_t i){
+                return x[i];
+            }
+
+
+            static void GatherValues(const VectorType& x, const std::vector<std::size_t>& IndexArray, TDataType* pValue){
+                for(std::size_t i=0; i<IndexArray.size(); ++i){
+                    pValue[i] = x[IndexArray[i]];
+                }
+            }
+
+
+            static DofUpdaterPointerType CreateDofUpdater(){
+                DofUpdaterType tmp;
+                return tmp.Create();
+            }
+
+
+            static constexpr bool IsDistributedSpace(){
+                return false;
+            }
+
+
+            virtual std::string Info() const{
+                return "CsrSpace";
+            }
+
+
+            virtual void PrintInfo(std::ostream& rOstream) const{
+                rOstream << "CsrSpace";
+            }
+
+
+            virtual void PrintData(std::ostream& rOstream) const{}
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_CSR_SPACE_HPP
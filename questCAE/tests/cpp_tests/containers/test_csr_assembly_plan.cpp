@@ -0,0 +1,131 @@
+// 系统头文件
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/csr_assembly_plan.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+        using IndexVectorType = std::vector<IndexType>;
+
+        /**
+         * @brief 一维链上的两节点“单元” i 连接方程 i 与 i+1
+         */
+        void ElementIndices(const IndexType i, IndexVectorType& rIndices){
+            rIndices.assign({i, i+1});
+        }
+
+        /**
+         * @brief 以给定的每行列索引填充CSR矩阵的稀疏模式，数值置零
+         */
+        void FillPattern(CsrMatrix<double>& rA, const std::vector<IndexVectorType>& rRows){
+            const IndexType n = rRows.size();
+            rA.ResizeIndex1Data(n+1);
+            rA.index1_data()[0] = 0;
+            for(IndexType i=0; i<n; ++i){
+                rA.index1_data()[i+1] = rA.index1_data()[i] + rRows[i].size();
+            }
+            const IndexType nnz = rA.index1_data()[n];
+            rA.ResizeIndex2Data(nnz);
+            rA.ResizeValueData(nnz);
+            for(IndexType i=0; i<n; ++i){
+                std::copy(rRows[i].begin(), rRows[i].end(), rA.index2_data().begin() + rA.index1_data()[i]);
+            }
+            std::fill(rA.value_data().begin(), rA.value_data().end(), 0.0);
+            rA.SetRowSize(n);
+            rA.SetColSize(n);
+        }
+
+        /**
+         * @brief n 阶三对角稀疏模式
+         */
+        std::vector<IndexVectorType> TridiagonalRows(const IndexType n){
+            std::vector<IndexVectorType> rows(n);
+            for(IndexType i=0; i<n; ++i){
+                for(IndexType j=(i==0 ? 0 : i-1); j<=std::min(i+1, n-1); ++j){
+                    rows[i].push_back(j);
+                }
+            }
+            return rows;
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(CsrAssemblyPlanScattersLocalMatrices, QuestCoreContainersFastSuite)
+    {
+        const IndexType n = 50;
+        const IndexType n_elems = n - 1;
+        CsrMatrix<double> A;
+        FillPattern(A, TridiagonalRows(n));
+
+        CsrAssemblyPlan<IndexType> plan(A, n_elems, ElementIndices);
+        QUEST_EXPECT_EQ(plan.NumberOfEntities(), n_elems);
+        QUEST_EXPECT_TRUE(plan.IsBuiltFor(A));
+
+        // 按计划累加单元刚度 [1 -1; -1 1]，结果应为一维拉普拉斯矩阵
+        const double local_lhs[4] = {1.0, -1.0, -1.0, 1.0};
+        for(IndexType e=0; e<n_elems; ++e){
+            const auto offsets = plan.GetEntityOffsets(e);
+            QUEST_EXPECT_EQ(offsets.size(), 4);
+            for(IndexType k=0; k<offsets.size(); ++k){
+                A.value_data()[offsets[k]] += local_lhs[k];
+            }
+        }
+
+        for(IndexType i=0; i<n; ++i){
+            for(IndexType k=A.index1_data()[i]; k<A.index1_data()[i+1]; ++k){
+                const IndexType j = A.index2_data()[k];
+                const double expected = (i == j) ? ((i == 0 || i == n-1) ? 1.0 : 2.0) : -1.0;
+                QUEST_EXPECT_NEAR(A.value_data()[k], expected, 1e-14);
+            }
+        }
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(CsrAssemblyPlanDetectsPatternChanges, QuestCoreContainersFastSuite)
+    {
+        const IndexType n = 20;
+        CsrMatrix<double> A;
+        auto rows = TridiagonalRows(n);
+        FillPattern(A, rows);
+        CsrAssemblyPlan<IndexType> plan(A, n - 1, ElementIndices);
+        QUEST_EXPECT_TRUE(plan.IsBuiltFor(A));
+
+        // 行数与非零元个数不变，只移动一个列索引
+        rows[n-1].front() = 0;
+        FillPattern(A, rows);
+        QUEST_EXPECT_FALSE(plan.IsBuiltFor(A));
+
+        // 恢复原稀疏模式后计划再次有效
+        FillPattern(A, TridiagonalRows(n));
+        QUEST_EXPECT_TRUE(plan.IsBuiltFor(A));
+
+        plan.Clear();
+        QUEST_EXPECT_FALSE(plan.IsBuiltFor(A));
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(CsrAssemblyPlanRejectsEntriesOutsidePattern, QuestCoreContainersFastSuite)
+    {
+        const IndexType n = 30;
+        CsrMatrix<double> A;
+        FillPattern(A, TridiagonalRows(n));
+
+        // 最后一个实体连接方程 0 与 n-1，不在三对角模式中；错误须在并行循环之外抛出
+        CsrAssemblyPlan<IndexType> plan;
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(plan.Build(A, n, [&](IndexType i, IndexVectorType& rIndices){
+            if(i < n - 1){
+                ElementIndices(i, rIndices);
+            } else {
+                rIndices.assign({0, n-1});
+            }
+        }));
+        QUEST_EXPECT_FALSE(plan.IsBuiltFor(A));
+        QUEST_EXPECT_EQ(plan.NumberOfEntities(), 0);
+    }
+
+} // namespace Quest::Testing
@@ -0,0 +1,325 @@
+// 系统头文件
+#include <cmath>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/csr_spmv_kernels.hpp"
+#include "utilities/cpu_features.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+
+        /**
+         * @brief 按带宽为 Shift 的带状稀疏模式填充矩阵，每行非零元个数固定，不同 Shift 得到相同非零元个数的不同稀疏模式
+         * @details 行索引数组只分配一次；Reallocate 为 true 时列索引与数值数组按原规模重新分配，否则原地覆盖
+         */
+        void FillBandedPattern(CsrMatrix<double>& rA, const IndexType NumberOfRows, const IndexType Shift, const bool Reallocate = true){
+            const IndexType entries_per_row = 3;
+            const IndexType nnz = NumberOfRows*entries_per_row;
+            if(rA.index1_data().size() != NumberOfRows+1){
+                rA.ResizeIndex1Data(NumberOfRows+1);
+                for(IndexType i=0; i<=NumberOfRows; ++i){
+                    rA.index1_data()[i] = i*entries_per_row;
+                }
+            }
+            if(Reallocate){
+                rA.ResizeIndex2Data(nnz);
+                rA.ResizeValueData(nnz);
+            }
+            for(IndexType i=0; i<NumberOfRows; ++i){
+                for(IndexType k=0; k<entries_per_row; ++k){
+                    rA.index2_data()[i*entries_per_row + k] = (i + k*Shift) % NumberOfRows;
+                    rA.value_data()[i*entries_per_row + k] = 1.0 + 0.01*i + 0.1*k*Shift;
+                }
+                std::sort(rA.index2_data().begin() + i*entries_per_row, rA.index2_data().begin() + (i+1)*entries_per_row);
+            }
+            rA.SetRowSize(NumberOfRows);
+            rA.SetColSize(NumberOfRows);
+        }
+
+        /**
+         * @brief 用 CSR 原始数组逐行计算参考结果并与 SpMV 比较
+         */
+        void CheckSpMV(const CsrMatrix<double>& rA){
+            const IndexType n = rA.size1();
+            DenseVector<double> x(n), y(n), y_reference(n);
+            for(IndexType i=0; i<n; ++i){
+                x[i] = std::cos(0.3*i);
+                y[i] = 1.0;
+                y_reference[i] = 0.5;
+            }
+            for(IndexType i=0; i<n; ++i){
+                for(IndexType k=rA.index1_data()[i]; k<rA.index1_data()[i+1]; ++k){
+                    y_reference[i] += 2.0*rA.value_data()[k]*x[rA.index2_data()[k]];
+                }
+            }
+            rA.SpMV(2.0, x, 0.5, y);
+            for(IndexType i=0; i<n; ++i){
+                QUEST_EXPECT_NEAR(y[i], y_reference[i], 1e-12);
+            }
+        }
+
+        /**
+         * @brief 行长度不规则的CSR数组：含空行、短行以及跨多个线程分段归约的长行
+         */
+        template<typename TIndexType>
+        void IrregularCsrArrays(const IndexType NumberOfRows, const IndexType LongRowLength,
+            std::vector<TIndexType>& rRowIndices, std::vector<TIndexType>& rColIndices, std::vector<double>& rValues)
+        {
+            rRowIndices.assign(1, 0);
+            rColIndices.clear();
+            rValues.clear();
+            for(IndexType i=0; i<NumberOfRows; ++i){
+                const IndexType length = (i == 5 || i == NumberOfRows-1) ? LongRowLength : (i % 7);
+                std::vector<TIndexType> cols;
+                for(IndexType k=0; k<length; ++k){
+                    cols.push_back(static_cast<TIndexType>((i*13 + k*7) % NumberOfRows));
+                }
+                std::sort(cols.begin(), cols.end());
+                cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+                for(const auto col : cols){
+                    rColIndices.push_back(col);
+                    rValues.push_back(std::sin(0.37*rValues.size()) - 0.2);
+                }
+                rRowIndices.push_back(static_cast<TIndexType>(rColIndices.size()));
+            }
+        }
+
+        /**
+         * @brief 在不高于处理器支持的每个SIMD级别上比较 y = alpha*A*x + beta*y 与逐行标量参考结果，
+         *  同时以逆序存放的数值检查间接寻址版本
+         */
+        template<typename TIndexType>
+        void CheckSpMVKernelsAllLevels(const IndexType NumberOfRows, const IndexType LongRowLength){
+            using KernelsType = CsrSpMVKernels<double, TIndexType>;
+            std::vector<TIndexType> row_indices, col_indices;
+            std::vector<double> values;
+            IrregularCsrArrays(NumberOfRows, LongRowLength, row_indices, col_indices, values);
+            const IndexType nnz = values.size();
+
+            std::vector<double> x(NumberOfRows), y0(NumberOfRows), y_reference(NumberOfRows);
+            for(IndexType i=0; i<NumberOfRows; ++i){
+                x[i] = std::cos(0.3*i);
+                y0[i] = 1.0 - 0.001*i;
+            }
+            for(IndexType i=0; i<NumberOfRows; ++i){
+                double sum = 0.0;
+                for(IndexType k=row_indices[i]; k<row_indices[i+1]; ++k){
+                    sum += values[k]*x[col_indices[k]];
+                }
+                y_reference[i] = 2.0*sum + 0.5*y0[i];
+            }
+
+            std::vector<TIndexType> permutation(nnz);
+            std::vector<double> permuted_values(nnz);
+            for(IndexType k=0; k<nnz; ++k){
+                permutation[k] = static_cast<TIndexType>(nnz - 1 - k);
+                permuted_values[nnz - 1 - k] = values[k];
+            }
+
+            CsrSpMVSchedule<TIndexType> schedule;
+            schedule.Build(row_indices.data(), NumberOfRows);
+            const SimdLevel original_level = CpuFeatures::GetSimdLevel();
+            for(const SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}){
+                if(level > CpuFeatures::GetDetectedSimdLevel()){
+                    continue;
+                }
+                CpuFeatures::SetSimdLevel(level);
+                std::vector<double> y = y0;
+                KernelsType::SpMV(schedule, row_indices.data(), col_indices.data(), values.data(), 2.0, x.data(), 0.5, y.data());
+                std::vector<double> y_indirect = y0;
+                KernelsType::SpMVIndirect(schedule, row_indices.data(), col_indices.data(), permutation.data(), permuted_values.data(), 2.0, x.data(), 0.5, y_indirect.data());
+                for(IndexType i=0; i<NumberOfRows; ++i){
+                    QUEST_EXPECT_NEAR(y[i], y_reference[i], 1e-10*(1.0 + std::abs(y_reference[i])));
+                    QUEST_EXPECT_NEAR(y_indirect[i], y_reference[i], 1e-10*(1.0 + std::abs(y_reference[i])));
+                }
+            }
+            CpuFeatures::SetSimdLevel(original_level);
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(CsrSpMVKernelsMatchScalarReference, QuestCoreContainersFastSuite)
+    {
+        // 64位与32位索引走不同的收集指令；长行超过分段阈值，由多个线程归约
+        CheckSpMVKernelsAllLevels<std::size_t>(20000, 12000);
+        CheckSpMVKernelsAllLevels<std::uint32_t>(20000, 12000);
+        CheckSpMVKernelsAllLevels<std::size_t>(37, 13);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrMatrixTransposeSpMVMatchesReference, QuestCoreContainersFastSuite)
+    {
+        // 长方形矩阵，部分列没有非零元；连续存储向量走核函数，其他向量走通用实现
+        const IndexType number_of_rows = 300;
+        const IndexType number_of_cols = 170;
+        CsrMatrix<double> A;
+        A.ResizeIndex1Data(number_of_rows + 1);
+        std::vector<IndexType> cols;
+        std::vector<double> values;
+        A.index1_data()[0] = 0;
+        for(IndexType i=0; i<number_of_rows; ++i){
+            for(IndexType k=0; k<(i % 5); ++k){
+                const IndexType col = (3*i + 29*k) % (number_of_cols - 10);
+                if(std::find(cols.begin() + A.index1_data()[i], cols.end(), col) == cols.end()){
+                    cols.push_back(col);
+                }
+            }
+            std::sort(cols.begin() + A.index1_data()[i], cols.end());
+            A.index1_data()[i+1] = cols.size();
+        }
+        A.ResizeIndex2Data(cols.size());
+        A.ResizeValueData(cols.size());
+        for(IndexType k=0; k<cols.size(); ++k){
+            A.index2_data()[k] = cols[k];
+            A.value_data()[k] = 0.5 + std::sin(0.11*k);
+        }
+        A.SetRowSize(number_of_rows);
+        A.SetColSize(number_of_cols);
+
+        DenseVector<double> x(number_of_rows), y(number_of_cols), product(number_of_cols, 0.0);
+        boost::numeric::ublas::vector<double, std::vector<double>> x_generic(number_of_rows), y_generic(number_of_cols);
+        for(IndexType i=0; i<number_of_rows; ++i){
+            x[i] = std::cos(0.2*i);
+            x_generic[i] = x[i];
+        }
+        for(IndexType j=0; j<number_of_cols; ++j){
+            y[j] = 1.0 + 0.01*j;
+            y_generic[j] = y[j];
+        }
+        for(IndexType i=0; i<number_of_rows; ++i){
+            for(IndexType k=A.index1_data()[i]; k<A.index1_data()[i+1]; ++k){
+                product[A.index2_data()[k]] += A.value_data()[k]*x[i];
+            }
+        }
+
+        A.TransposeSpMV(3.0, x, 0.25, y);
+        A.TransposeSpMV(3.0, x_generic, 0.25, y_generic);
+        for(IndexType j=0; j<number_of_cols; ++j){
+            const double expected = 3.0*product[j] + 0.25*(1.0 + 0.01*j);
+            QUEST_EXPECT_NEAR(y[j], expected, 1e-12);
+            QUEST_EXPECT_NEAR(y_generic[j], expected, 1e-12);
+        }
+
+        // 缓存的转置结构只记录排列，修改数值后结果随之变化；y += A^T*x 形式同样累加
+        for(auto& r_value : A.value_data()){
+            r_value *= -2.0;
+        }
+        DenseVector<double> z(number_of_cols, 1.0);
+        A.TransposeSpMV(x, z);
+        for(IndexType j=0; j<number_of_cols; ++j){
+            QUEST_EXPECT_NEAR(z[j], 1.0 - 2.0*product[j], 1e-12);
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrMatrixSellCSigmaRebuiltWithSameNnz, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_rows = 257;
+        CsrMatrix<double> A;
+        FillBandedPattern(A, number_of_rows, 1);
+        A.EnableSellCSigma(4, 16);
+        CheckSpMV(A);
+
+        // 行数与非零元个数不变、列索引变化，SELL-C-σ 副本必须按新模式重建而不是只刷新数值
+        FillBandedPattern(A, number_of_rows, 7);
+        A.UpdateSellCSigma();
+        QUEST_EXPECT_EQ(A.pGetSellCSigma()->ChunkHeight(), 4);
+        CheckSpMV(A);
+
+        // 原地修改列索引后调用 ResetSpMVSchedule，未刷新的副本不得再参与计算
+        FillBandedPattern(A, number_of_rows, 5, false);
+        A.ResetSpMVSchedule();
+        CheckSpMV(A);
+        A.UpdateSellCSigma();
+        CheckSpMV(A);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrMatrixSellCSigmaFollowsValueWrites, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_rows = 129;
+        CsrMatrix<double> A;
+        FillBandedPattern(A, number_of_rows, 2);
+        A.EnableSellCSigma(4, 8);
+        CheckSpMV(A);
+
+        // 不调用 UpdateSellCSigma，直接通过 value_data() 与 operator() 修改数值，副本须在下次 SpMV 前同步
+        for(auto& r_value : A.value_data()){
+            r_value *= -3.0;
+        }
+        CheckSpMV(A);
+
+        A(0, A.index2_data()[0]) = 42.0;
+        A(number_of_rows-1, A.index2_data()[A.nnz()-1]) += 5.0;
+        CheckSpMV(A);
+        QUEST_EXPECT_TRUE(A.pGetSellCSigma()->IsBuiltFor(A));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrMatrixCompressedIndicesRebuiltWithSameNnz, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_rows = 300;
+        CsrMatrix<double> A;
+        FillBandedPattern(A, number_of_rows, 1);
+        A.EnableCompressedIndices();
+        CheckSpMV(A);
+
+        FillBandedPattern(A, number_of_rows, 11);
+        CheckSpMV(A);
+
+        FillBandedPattern(A, number_of_rows, 13, false);
+        A.ResetSpMVSchedule();
+        CheckSpMV(A);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrMatrixMoveKeepsSellCSigmaParameters, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_rows = 100;
+        CsrMatrix<double> A;
+        FillBandedPattern(A, number_of_rows, 1);
+        A.EnableSellCSigma(8, 32);
+
+        CsrMatrix<double> B;
+        B = std::move(A);
+        FillBandedPattern(B, number_of_rows, 3);
+        B.UpdateSellCSigma();
+        QUEST_EXPECT_EQ(B.pGetSellCSigma()->ChunkHeight(), 8);
+        QUEST_EXPECT_EQ(B.pGetSellCSigma()->Sigma(), 32);
+        CheckSpMV(B);
+
+        CsrMatrix<double> C(std::move(B));
+        FillBandedPattern(C, number_of_rows, 5);
+        C.UpdateSellCSigma();
+        QUEST_EXPECT_EQ(C.pGetSellCSigma()->ChunkHeight(), 8);
+        CheckSpMV(C);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrMatrixIndexConversionRespectsGatherRange, QuestCoreContainersFastSuite)
+    {
+        // 32位列索引由SIMD收集指令按有符号数解释，列数不得超过 INT32_MAX
+        using CsrMatrix32Type = CsrMatrix<double, std::uint32_t>;
+        const IndexType number_of_rows = 10;
+        CsrMatrix<double> A;
+        FillBandedPattern(A, number_of_rows, 1);
+        A.index2_data()[A.nnz()-1] = static_cast<IndexType>(std::numeric_limits<std::int32_t>::max()) + 1;
+        A.SetColSize(static_cast<IndexType>(std::numeric_limits<std::int32_t>::max()) + 2);
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(CsrMatrix32Type A32(A));
+
+        FillBandedPattern(A, number_of_rows, 3, false);
+        CsrMatrix32Type A32(A);
+        QUEST_EXPECT_EQ(A32.nnz(), A.nnz());
+        QUEST_EXPECT_EQ(A32.size2(), number_of_rows);
+    }
+
+} // namespace Quest::Testing
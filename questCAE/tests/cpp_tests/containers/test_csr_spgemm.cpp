@@ -0,0 +1,224 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/csr_spgemm.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+        using DenseType = std::vector<std::vector<double>>;
+        using SpGEMMType = CsrSpGEMM<double>;
+        using TripleProductType = CsrTripleProduct<double>;
+
+        /**
+         * @brief 以稠密矩阵中的非零元填充CSR矩阵（原有存储规模相同时原地覆盖）
+         */
+        void FillFromDense(CsrMatrix<double>& rA, const DenseType& rDense){
+            const IndexType nrows = rDense.size();
+            const IndexType ncols = rDense.empty() ? 0 : rDense[0].size();
+            std::vector<IndexType> row_indices(1, 0), col_indices;
+            std::vector<double> values;
+            for(IndexType i=0; i<nrows; ++i){
+                for(IndexType j=0; j<ncols; ++j){
+                    if(rDense[i][j] != 0.0){
+                        col_indices.push_back(j);
+                        values.push_back(rDense[i][j]);
+                    }
+                }
+                row_indices.push_back(col_indices.size());
+            }
+            if(rA.index1_data().size() != row_indices.size()){
+                rA.ResizeIndex1Data(row_indices.size());
+            }
+            if(rA.nnz() != col_indices.size()){
+                rA.ResizeIndex2Data(col_indices.size());
+                rA.ResizeValueData(values.size());
+            }
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(nrows);
+            rA.SetColSize(ncols);
+            rA.ResetSpMVSchedule();
+        }
+
+        /**
+         * @brief 稠密矩阵乘法参考结果
+         */
+        DenseType DenseProduct(const DenseType& rA, const DenseType& rB){
+            DenseType c(rA.size(), std::vector<double>(rB[0].size(), 0.0));
+            for(IndexType i=0; i<rA.size(); ++i){
+                for(IndexType k=0; k<rB.size(); ++k){
+                    for(IndexType j=0; j<rB[0].size(); ++j){
+                        c[i][j] += rA[i][k]*rB[k][j];
+                    }
+                }
+            }
+            return c;
+        }
+
+        DenseType DenseTranspose(const DenseType& rA){
+            DenseType t(rA[0].size(), std::vector<double>(rA.size(), 0.0));
+            for(IndexType i=0; i<rA.size(); ++i){
+                for(IndexType j=0; j<rA[0].size(); ++j){
+                    t[j][i] = rA[i][j];
+                }
+            }
+            return t;
+        }
+
+        /**
+         * @brief 伪随机稀疏矩阵，约 Density 比例的元素非零
+         */
+        DenseType SparseDense(const IndexType NumberOfRows, const IndexType NumberOfCols, const double Density, const IndexType Seed){
+            DenseType a(NumberOfRows, std::vector<double>(NumberOfCols, 0.0));
+            for(IndexType i=0; i<NumberOfRows; ++i){
+                for(IndexType j=0; j<NumberOfCols; ++j){
+                    const double r = 0.5 + 0.5*std::sin(12.9898*(i + 1) + 78.233*(j + 1) + 37.719*Seed);
+                    if(r < Density){
+                        a[i][j] = std::cos(0.7*i + 0.3*j + Seed);
+                    }
+                }
+            }
+            return a;
+        }
+
+        /**
+         * @brief 检查 CSR 矩阵与稠密参考矩阵一致（列索引升序，且不在模式中的参考值为零）
+         */
+        void CheckEqual(const CsrMatrix<double>& rC, const DenseType& rReference){
+            QUEST_EXPECT_EQ(rC.size1(), rReference.size());
+            QUEST_EXPECT_EQ(rC.size2(), rReference[0].size());
+            for(IndexType i=0; i<rC.size1(); ++i){
+                std::vector<double> row(rC.size2(), 0.0);
+                for(IndexType k=rC.index1_data()[i]; k<rC.index1_data()[i+1]; ++k){
+                    if(k > rC.index1_data()[i]){
+                        QUEST_EXPECT_TRUE(rC.index2_data()[k-1] < rC.index2_data()[k]);
+                    }
+                    row[rC.index2_data()[k]] = rC.value_data()[k];
+                }
+                for(IndexType j=0; j<rC.size2(); ++j){
+                    QUEST_EXPECT_NEAR(row[j], rReference[i][j], 1e-12);
+                }
+            }
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(CsrSpGEMMMatchesDenseProduct, QuestCoreContainersFastSuite)
+    {
+        const DenseType a = SparseDense(60, 45, 0.15, 1);
+        const DenseType b = SparseDense(45, 70, 0.1, 2);
+        CsrMatrix<double> A, B, C;
+        FillFromDense(A, a);
+        FillFromDense(B, b);
+
+        SpGEMMType spgemm;
+        spgemm.Multiply(A, B, C);
+        QUEST_EXPECT_TRUE(spgemm.IsBuiltFor(A, B, C));
+        CheckEqual(C, DenseProduct(a, b));
+
+        // 数值变化、稀疏模式不变：只执行数值阶段，C 的存储不重新分配
+        const auto* p_c_rows = C.index1_data().data();
+        for(auto& r_value : A.value_data()){
+            r_value *= -1.5;
+        }
+        DenseType a_scaled = a;
+        for(auto& r_row : a_scaled){
+            for(auto& r_value : r_row){
+                r_value *= -1.5;
+            }
+        }
+        QUEST_EXPECT_TRUE(spgemm.IsBuiltFor(A, B, C));
+        spgemm.Multiply(A, B, C);
+        QUEST_EXPECT_EQ(C.index1_data().data(), p_c_rows);
+        CheckEqual(C, DenseProduct(a_scaled, b));
+
+        // 显式转置
+        CsrMatrix<double> AT;
+        SpGEMMType::Transpose(A, AT);
+        CheckEqual(AT, DenseTranspose(a_scaled));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrSpGEMMDetectsInPlacePatternChange, QuestCoreContainersFastSuite)
+    {
+        DenseType a = SparseDense(40, 40, 0.2, 3);
+        const DenseType b = SparseDense(40, 40, 0.2, 4);
+        CsrMatrix<double> A, B, C;
+        FillFromDense(A, a);
+        FillFromDense(B, b);
+
+        SpGEMMType spgemm;
+        spgemm.Multiply(A, B, C);
+
+        // 把第一行的一个非零元移到另一列：行数与非零元个数不变，行索引数组原地覆盖
+        IndexType moved_from = 0;
+        while(a[0][moved_from] == 0.0){
+            ++moved_from;
+        }
+        IndexType moved_to = 0;
+        while(a[0][moved_to] != 0.0){
+            ++moved_to;
+        }
+        a[0][moved_to] = a[0][moved_from];
+        a[0][moved_from] = 0.0;
+        const auto* p_a_rows = A.index1_data().data();
+        FillFromDense(A, a);
+        QUEST_EXPECT_EQ(A.index1_data().data(), p_a_rows);
+
+        QUEST_EXPECT_FALSE(spgemm.IsBuiltFor(A, B, C));
+        spgemm.Multiply(A, B, C);
+        CheckEqual(C, DenseProduct(a, b));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrTripleProductMatchesDenseReference, QuestCoreContainersFastSuite)
+    {
+        // 一维拉普拉斯矩阵加单位质量项（对称正定），奇数号自由度为从自由度，取相邻主自由度的平均
+        const IndexType n = 31;
+        DenseType a(n, std::vector<double>(n, 0.0));
+        for(IndexType i=0; i<n; ++i){
+            a[i][i] = 3.0;
+            if(i > 0) a[i][i-1] = -1.0;
+            if(i < n-1) a[i][i+1] = -1.0;
+        }
+        const IndexType number_of_masters = (n + 1)/2;
+        DenseType t(n, std::vector<double>(number_of_masters, 0.0));
+        for(IndexType i=0; i<n; ++i){
+            if(i % 2 == 0){
+                t[i][i/2] = 1.0;
+            } else {
+                t[i][i/2] = 0.5;
+                t[i][i/2 + 1] = 0.5;
+            }
+        }
+
+        CsrMatrix<double> A, T, C;
+        FillFromDense(A, a);
+        FillFromDense(T, t);
+        TripleProductType triple_product;
+        triple_product.Compute(T, A, C);
+        const DenseType reference = DenseProduct(DenseTranspose(t), DenseProduct(a, t));
+        CheckEqual(C, reference);
+
+        // 约束系数变化、稀疏模式不变时复用转置与符号阶段
+        const auto* p_c_rows = C.index1_data().data();
+        for(IndexType i=1; i<n; i+=2){
+            t[i][i/2] = 0.25;
+            t[i][i/2 + 1] = 0.75;
+            T(i, i/2) = 0.25;
+            T(i, i/2 + 1) = 0.75;
+        }
+        triple_product.Compute(T, A, C);
+        QUEST_EXPECT_EQ(C.index1_data().data(), p_c_rows);
+        CheckEqual(C, DenseProduct(DenseTranspose(t), DenseProduct(a, t)));
+    }
+
+} // namespace Quest::Testing
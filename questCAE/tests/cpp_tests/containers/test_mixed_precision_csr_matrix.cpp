@@ -0,0 +1,147 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <cstdint>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/mixed_precision_csr_matrix.hpp"
+#include "utilities/cpu_features.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+
+        /**
+         * @brief 非对称的带状矩阵：每行 1 到 40 个非零元，其中第 7 行为跨线程归约的长行，数值跨越多个数量级
+         */
+        void NonsymmetricBandedMatrix(CsrMatrix<double>& rA, const IndexType NumberOfRows){
+            std::vector<IndexType> row_indices(1, 0), col_indices;
+            std::vector<double> values;
+            for(IndexType i=0; i<NumberOfRows; ++i){
+                const IndexType length = (i == 7) ? NumberOfRows : 1 + (i*7) % 40;
+                const IndexType first = (i >= length/2) ? i - length/2 : 0;
+                for(IndexType j=first; j<std::min(first + length, NumberOfRows); ++j){
+                    col_indices.push_back(j);
+                    values.push_back(j == i ? 10.0 : std::sin(0.1*i + 0.37*j)*std::pow(10.0, static_cast<double>((i + j) % 5) - 2.0));
+                }
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(NumberOfRows);
+            rA.SetColSize(NumberOfRows);
+        }
+
+        /**
+         * @brief 在不高于处理器支持的每个SIMD级别上检查 y = alpha*M*x + beta*y：
+         *  与以低精度存储值做双精度累加的参考结果相差在舍入量级，与双精度矩阵相差在存储精度量级
+         */
+        template<typename TStorageType, typename TIndexType>
+        void CheckMixedPrecisionSpMV(const CsrMatrix<double>& rA, const double StorageEpsilon){
+            using MatrixType = MixedPrecisionCsrMatrix<TStorageType, TIndexType>;
+            const IndexType n = rA.size1();
+            MatrixType M(rA);
+            QUEST_EXPECT_TRUE(M.IsBuiltFor(rA));
+            QUEST_EXPECT_EQ(static_cast<IndexType>(M.nnz()), rA.nnz());
+
+            DenseVector<double> x(n), y0(n), y_stored(n), y_exact(n);
+            for(IndexType i=0; i<n; ++i){
+                x[i] = std::cos(0.3*i);
+                y0[i] = 1.0 - 0.01*i;
+            }
+            for(IndexType i=0; i<n; ++i){
+                double sum_stored = 0.0, sum_exact = 0.0;
+                for(IndexType k=rA.index1_data()[i]; k<rA.index1_data()[i+1]; ++k){
+                    const double xj = x[rA.index2_data()[k]];
+                    sum_stored += M.GetValue(static_cast<TIndexType>(k))*xj;
+                    sum_exact += rA.value_data()[k]*xj;
+                }
+                y_stored[i] = 2.0*sum_stored + 0.5*y0[i];
+                y_exact[i] = 2.0*sum_exact + 0.5*y0[i];
+            }
+
+            const SimdLevel original_level = CpuFeatures::GetSimdLevel();
+            for(const SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}){
+                if(level > CpuFeatures::GetDetectedSimdLevel()){
+                    continue;
+                }
+                CpuFeatures::SetSimdLevel(level);
+                DenseVector<double> y = y0;
+                M.SpMV(2.0, x, 0.5, y);
+                for(IndexType i=0; i<n; ++i){
+                    // 低精度存储带来的误差界
+                    double row_abs = 0.0;
+                    for(IndexType k=rA.index1_data()[i]; k<rA.index1_data()[i+1]; ++k){
+                        row_abs += std::abs(rA.value_data()[k]*x[rA.index2_data()[k]]);
+                    }
+                    QUEST_EXPECT_NEAR(y[i], y_stored[i], 1e-12*(1.0 + 2.0*row_abs));
+                    QUEST_EXPECT_NEAR(y[i], y_exact[i], 2.0*StorageEpsilon*row_abs + 1e-12);
+                }
+            }
+            CpuFeatures::SetSimdLevel(original_level);
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(MixedPrecisionCsrMatrixSpMVAccumulatesInDouble, QuestCoreContainersFastSuite)
+    {
+        CsrMatrix<double> A;
+        NonsymmetricBandedMatrix(A, 3000);
+
+        CheckMixedPrecisionSpMV<double, std::uint32_t>(A, 0.0);
+        CheckMixedPrecisionSpMV<float, std::uint32_t>(A, std::numeric_limits<float>::epsilon());
+        CheckMixedPrecisionSpMV<float, std::size_t>(A, std::numeric_limits<float>::epsilon());
+        CheckMixedPrecisionSpMV<BFloat16, std::uint32_t>(A, 1.0/128.0);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(MixedPrecisionCsrMatrixScalingAndUpdate, QuestCoreContainersFastSuite)
+    {
+        const IndexType n = 200;
+        CsrMatrix<double> A;
+        NonsymmetricBandedMatrix(A, n);
+
+        // 对称 Jacobi 缩放 D^{-1/2} A D^{-1/2}：先缩放后舍入，对角元恰为 1
+        std::vector<double> scaling(n);
+        for(IndexType i=0; i<n; ++i){
+            scaling[i] = 1.0/std::sqrt(std::abs(A(i, i)));
+        }
+        MixedPrecisionCsrMatrix<float> M;
+        M.Build(A, scaling.data(), scaling.data());
+        for(IndexType i=0; i<n; ++i){
+            for(IndexType k=A.index1_data()[i]; k<A.index1_data()[i+1]; ++k){
+                const IndexType j = A.index2_data()[k];
+                const double expected = scaling[i]*A.value_data()[k]*scaling[j];
+                QUEST_EXPECT_NEAR(M.GetValue(k), expected, std::numeric_limits<float>::epsilon()*std::abs(expected));
+                if(i == j){
+                    QUEST_EXPECT_NEAR(M.GetValue(k), 1.0, 0.0);
+                }
+            }
+        }
+
+        // 稀疏模式不变时只刷新数值
+        for(auto& r_value : A.value_data()){
+            r_value *= 4.0;
+        }
+        M.UpdateValues(A);
+        for(IndexType k=0; k<A.nnz(); ++k){
+            QUEST_EXPECT_NEAR(M.GetValue(k), A.value_data()[k], std::numeric_limits<float>::epsilon()*std::abs(A.value_data()[k]));
+        }
+
+        // 单精度无法表示的量级在缩放后可以存储
+        A(0, 0) = 1e60;
+        scaling[0] = 1e-30;
+        M.UpdateValues(A, scaling.data(), scaling.data());
+        QUEST_EXPECT_NEAR(M.GetValue(0), 1.0, std::numeric_limits<float>::epsilon());
+    }
+
+} // namespace Quest::Testing
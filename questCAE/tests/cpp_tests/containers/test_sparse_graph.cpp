@@ -0,0 +1,189 @@
+// 系统头文件
+#include <set>
+#include <map>
+#include <thread>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/sparse_graph.hpp"
+#include "container/sparse_contiguous_row_graph.hpp"
+#include "utilities/parallel_utilities.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+        using ReferenceGraphType = std::map<IndexType, std::set<IndexType>>;
+
+        /**
+         * @brief 第 i 个“单元”的方程编号，相邻单元共享两个编号
+         */
+        std::vector<IndexType> ElementIndices(const IndexType i){
+            return {2*i, 2*i+1, 2*i+2, 2*i+3};
+        }
+
+        void CheckGraph(const SparseGraph<IndexType>& rGraph, const ReferenceGraphType& rReference){
+            IndexType nnz = 0;
+            for(const auto& r_row : rReference){
+                const auto row = rGraph[r_row.first];
+                QUEST_EXPECT_EQ(row.size(), r_row.second.size());
+                QUEST_EXPECT_TRUE(std::equal(row.begin(), row.end(), r_row.second.begin()));
+                nnz += r_row.second.size();
+            }
+            QUEST_EXPECT_EQ(rGraph.GetGraph().NumberOfNonZeros(), nnz);
+        }
+
+        ReferenceGraphType ReferenceGraph(const IndexType NumberOfElements){
+            ReferenceGraphType reference;
+            for(IndexType i=0; i<NumberOfElements; ++i){
+                const auto indices = ElementIndices(i);
+                for(const auto I : indices){
+                    reference[I].insert(indices.begin(), indices.end());
+                }
+            }
+            return reference;
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(SparseGraphParallelAddEntries, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_elements = 1000;
+        SparseGraph<IndexType> graph;
+        IndexPartition<IndexType>(number_of_elements).for_each([&](IndexType i){
+            graph.AddEntries(ElementIndices(i));
+        });
+        graph.Finalize();
+
+        QUEST_EXPECT_EQ(graph.Size(), 2*number_of_elements+2);
+        CheckGraph(graph, ReferenceGraph(number_of_elements));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(SparseGraphFromConnectivity, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_elements = 1000;
+        SparseGraph<IndexType> graph;
+        graph.AddEntriesFromConnectivity(number_of_elements, [](IndexType i, std::vector<IndexType>& rIndices){
+            rIndices = ElementIndices(i);
+        });
+
+        CheckGraph(graph, ReferenceGraph(number_of_elements));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(SparseGraphReadersRequireFinalize, QuestCoreContainersFastSuite)
+    {
+        SparseGraph<IndexType> graph;
+        graph.AddEntry(0, 0);
+        graph.Finalize();
+        graph.AddEntry(0, 1);
+        graph.AddEntry(5, 5);
+
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(graph[0]);
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(graph.Has(0, 1));
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(graph.begin());
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(graph.end());
+
+        graph.Finalize();
+        QUEST_EXPECT_TRUE(graph.Has(0, 1));
+        QUEST_EXPECT_TRUE(graph.Has(5, 5));
+        QUEST_EXPECT_FALSE(graph.Has(5, 0));
+        QUEST_EXPECT_EQ(graph[5].size(), 1);
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(graph[6]);
+
+        IndexType number_of_rows = 0;
+        for(auto it = graph.begin(); it != graph.end(); ++it){
+            ++number_of_rows;
+        }
+        QUEST_EXPECT_EQ(number_of_rows, 6);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(SparseGraphAddEntriesMergesStagedEntries, QuestCoreContainersFastSuite)
+    {
+        SparseGraph<IndexType> graph_a;
+        graph_a.AddEntry(0, 1);
+        graph_a.Finalize();
+        graph_a.AddEntry(2, 3);
+
+        SparseGraph<IndexType> graph_b;
+        graph_b.AddEntry(1, 0);
+        graph_b.Finalize();
+        graph_b.AddEntry(4, 4);
+
+        graph_a.AddEntries(graph_b);
+
+        QUEST_EXPECT_EQ(graph_a.Size(), 5);
+        QUEST_EXPECT_TRUE(graph_a.Has(0, 1));
+        QUEST_EXPECT_TRUE(graph_a.Has(1, 0));
+        QUEST_EXPECT_TRUE(graph_a.Has(2, 3));
+        QUEST_EXPECT_TRUE(graph_a.Has(4, 4));
+        QUEST_EXPECT_EQ(graph_a.GetGraph().NumberOfNonZeros(), 4);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(SparseGraphAddEntriesFromThreads, QuestCoreContainersFastSuite)
+    {
+        // 非 OpenMP 线程以及嵌套并行区都写入加锁的共享暂存缓冲区
+        const IndexType number_of_threads = 8;
+        const IndexType elements_per_thread = 500;
+        SparseGraph<IndexType> graph;
+
+        std::vector<std::thread> threads;
+        for(IndexType t=0; t<number_of_threads; ++t){
+            threads.emplace_back([&graph, t, elements_per_thread](){
+                for(IndexType i=t*elements_per_thread; i<(t+1)*elements_per_thread; ++i){
+                    graph.AddEntries(ElementIndices(i));
+                }
+            });
+        }
+        for(auto& r_thread : threads){
+            r_thread.join();
+        }
+
+        IndexPartition<IndexType>(2).for_each([&](IndexType){
+            IndexPartition<IndexType>(number_of_threads*elements_per_thread).for_each([&](IndexType i){
+                graph.AddEntries(ElementIndices(i));
+            });
+        });
+        graph.Finalize();
+
+        CheckGraph(graph, ReferenceGraph(number_of_threads*elements_per_thread));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(SparseContiguousRowGraphParallelAddEntry, QuestCoreContainersFastSuite)
+    {
+        const IndexType number_of_elements = 1000;
+        const IndexType size = 2*number_of_elements+2;
+        SparseContiguousRowGraph<IndexType> graph(size);
+        IndexPartition<IndexType>(number_of_elements).for_each([&](IndexType i){
+            const auto indices = ElementIndices(i);
+            for(const auto I : indices){
+                for(const auto J : indices){
+                    graph.AddEntry(I, J);
+                }
+            }
+        });
+
+        // 暂存条目合并之前不能查询
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(graph.Has(0, 0));
+        graph.Finalize();
+
+        QUEST_EXPECT_EQ(graph.Size(), size);
+        const auto reference = ReferenceGraph(number_of_elements);
+        for(const auto& r_row : reference){
+            const auto row = graph[r_row.first];
+            QUEST_EXPECT_EQ(row.size(), r_row.second.size());
+            QUEST_EXPECT_TRUE(std::equal(row.begin(), row.end(), r_row.second.begin()));
+            for(const auto J : r_row.second){
+                QUEST_EXPECT_TRUE(graph.Has(r_row.first, J));
+            }
+        }
+        QUEST_EXPECT_FALSE(graph.Has(0, size-1));
+    }
+
+} // namespace Quest::Testing
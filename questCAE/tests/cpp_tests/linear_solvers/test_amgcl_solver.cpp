@@ -0,0 +1,184 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/amgcl_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = TUblasSparseSpace<double>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using DenseMatrixType = LocalSpaceType::MatrixType;
+        using AMGCLSolverType = AMGCLSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上的五点差分 Laplace 矩阵
+         */
+        SparseMatrixType PoissonMatrix(const std::size_t n){
+            const std::size_t size = n*n;
+            SparseMatrixType A(size, size, 5*size);
+            for(std::size_t j=0; j<n; ++j){
+                for(std::size_t i=0; i<n; ++i){
+                    const std::size_t k = j*n + i;
+                    if(j > 0) A.push_back(k, k-n, -1.0);
+                    if(i > 0) A.push_back(k, k-1, -1.0);
+                    A.push_back(k, k, 4.0);
+                    if(i < n-1) A.push_back(k, k+1, -1.0);
+                    if(j < n-1) A.push_back(k, k+n, -1.0);
+                }
+            }
+            return A;
+        }
+
+        /**
+         * @brief 返回 P*A*P^T，P 为固定种子的“伪随机”置换；阶数与非零元个数不变，稀疏模式改变
+         */
+        SparseMatrixType PermutedMatrix(const SparseMatrixType& rA){
+            const std::size_t size = rA.size1();
+            std::vector<std::size_t> permutation(size);
+            std::iota(permutation.begin(), permutation.end(), 0);
+            for(std::size_t i=size; i>1; --i){
+                std::swap(permutation[i-1], permutation[(7919*i + 13) % i]);
+            }
+            std::vector<std::size_t> inverse(size);
+            for(std::size_t i=0; i<size; ++i){
+                inverse[permutation[i]] = i;
+            }
+
+            SparseMatrixType B(size, size, rA.nnz());
+            for(std::size_t i=0; i<size; ++i){
+                std::vector<std::pair<std::size_t, double>> row;
+                const std::size_t old_row = permutation[i];
+                for(std::size_t k=rA.index1_data()[old_row]; k<rA.index1_data()[old_row+1]; ++k){
+                    row.emplace_back(inverse[rA.index2_data()[k]], rA.value_data()[k]);
+                }
+                std::sort(row.begin(), row.end());
+                for(const auto& r_entry : row){
+                    B.push_back(i, r_entry.first, r_entry.second);
+                }
+            }
+            return B;
+        }
+
+        /**
+         * @brief 记录 FinalizeSolutionStep 调用次数的 AMG 求解器
+         */
+        class CountingAMGCLSolver : public AMGCLSolverType{
+            public:
+                using AMGCLSolverType::AMGCLSolverType;
+
+                void FinalizeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                    ++NumberOfFinalizeCalls;
+                }
+
+                std::size_t NumberOfFinalizeCalls = 0;
+        };
+
+        /**
+         * @brief 返回相对残差 |b - A*x| / |b|
+         */
+        double RelativeResidual(const SparseMatrixType& rA, const VectorType& rX, const VectorType& rB){
+            VectorType r(rB.size());
+            SparseSpaceType::Mult(rA, rX, r);
+            r = rB - r;
+            return SparseSpaceType::TwoNorm(r)/SparseSpaceType::TwoNorm(rB);
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(AMGCLSolverSetToleranceKeepsHierarchy, QuestCoreLinearSolversFastSuite)
+    {
+        Parameters settings(R"({
+            "tolerance": 1e-4,
+            "coarse_enough": 100
+        })");
+        AMGCLSolverType solver(settings);
+
+        SparseMatrixType A = PoissonMatrix(40);
+        VectorType b(A.size1(), 1.0);
+        VectorType x(A.size1(), 0.0);
+
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b));
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericRebuilds(), 0);
+        const auto coarse_iterations = solver.GetIterationsNumber();
+
+        // 收紧容差不应丢弃已构建的多重网格层次
+        solver.SetTolerance(1e-10);
+        std::fill(x.begin(), x.end(), 0.0);
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b));
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericRebuilds(), 1);
+        QUEST_EXPECT_TRUE(solver.GetIterationsNumber() > coarse_iterations);
+        QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-9);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(AMGCLSolverRebuildsForInPlacePatternChange, QuestCoreLinearSolversFastSuite)
+    {
+        Parameters settings(R"({
+            "tolerance": 1e-8,
+            "coarse_enough": 100
+        })");
+        AMGCLSolverType solver(settings);
+
+        SparseMatrixType A = PoissonMatrix(30);
+        VectorType b(A.size1(), 1.0);
+        VectorType x(A.size1(), 0.0);
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b));
+
+        // 同阶数、同非零元个数的新稀疏模式写入原有存储，行索引数组地址不变
+        const auto* p_row_indices = &A.index1_data()[0];
+        A = PermutedMatrix(A);
+        QUEST_EXPECT_EQ(&A.index1_data()[0], p_row_indices);
+
+        std::fill(x.begin(), x.end(), 0.0);
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b));
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericRebuilds(), 0);
+        QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-7);
+
+        // 相同模式的拷贝只重算数值
+        SparseMatrixType A_copy(A);
+        std::fill(x.begin(), x.end(), 0.0);
+        QUEST_EXPECT_TRUE(solver.Solve(A_copy, x, b));
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericRebuilds(), 1);
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(AMGCLSolverMultipleRightHandSides, QuestCoreLinearSolversFastSuite)
+    {
+        Parameters settings(R"({
+            "tolerance": 1e-8,
+            "coarse_enough": 100
+        })");
+        CountingAMGCLSolver solver(settings);
+
+        SparseMatrixType A = PoissonMatrix(25);
+        const std::size_t size = A.size1();
+        DenseMatrixType B(size, 3), X(size, 3);
+        for(std::size_t i=0; i<size; ++i){
+            B(i, 0) = 1.0;
+            B(i, 1) = std::sin(0.1*i);
+            B(i, 2) = (i % 2 == 0) ? 1.0 : -1.0;
+        }
+        X.clear();
+
+        QUEST_EXPECT_TRUE(solver.Solve(A, X, B));
+        QUEST_EXPECT_EQ(solver.NumberOfFinalizeCalls, 1);
+        for(std::size_t j=0; j<3; ++j){
+            VectorType x(size), b(size);
+            for(std::size_t i=0; i<size; ++i){
+                x[i] = X(i, j);
+                b[i] = B(i, j);
+            }
+            QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-7);
+        }
+    }
+
+} // namespace Quest::Testing
@@ -0,0 +1,190 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/bicgstab_l_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using DenseMatrixType = LocalSpaceType::MatrixType;
+        using PreconditionerType = Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ILU0PreconditionerType = ILU0Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using BiCGStabLSolverType = BiCGStabLSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上的五点差分对流扩散矩阵（非对称），自然编号
+         * @details Convection > 1 时网格 Péclet 数超过 2，矩阵的特征值成为复数
+         */
+        void ConvectionDiffusionMatrix(SparseMatrixType& rA, const int n, const double Convection){
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                auto add = [&](const int ii, const int jj, const double Value){
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        col_indices.push_back(ii*n + jj);
+                        values.push_back(Value);
+                    }
+                };
+                add(i-1, j, -1.0 - Convection);
+                add(i, j-1, -1.0 - Convection);
+                add(i, j, 4.0);
+                add(i, j+1, -1.0 + Convection);
+                add(i+1, j, -1.0 + Convection);
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 光滑的精确解及其对应的右端项
+         */
+        void ManufacturedSolution(const SparseMatrixType& rA, VectorType& rExact, VectorType& rB){
+            const std::size_t size = rA.size1();
+            rExact.resize(size);
+            rB.resize(size);
+            for(std::size_t i=0; i<size; ++i){
+                rExact[i] = std::sin(0.05*i) + 0.01*i;
+            }
+            SparseSpaceType::Mult(rA, rExact, rB);
+        }
+
+        /**
+         * @brief 真实残差范数 |b - A*x|
+         */
+        double ResidualNorm(const SparseMatrixType& rA, const VectorType& rX, const VectorType& rB){
+            VectorType ax(rX.size());
+            SparseSpaceType::Mult(rA, rX, ax);
+            return norm_2(rB - ax);
+        }
+
+        /**
+         * @brief 参考值：以零初值执行 Iterations 步教科书式的 BiCGStab（影子残差取初始残差）
+         */
+        VectorType ReferenceBiCGStab(const SparseMatrixType& rA, const VectorType& rB, const std::size_t Iterations){
+            const std::size_t size = rB.size();
+            VectorType x(size, 0.0), r = rB, r_shadow = rB, p = rB, v(size), t(size);
+            double rho = inner_prod(r_shadow, r);
+            for(std::size_t k=0; k<Iterations; ++k){
+                SparseSpaceType::Mult(rA, p, v);
+                const double alpha = rho/inner_prod(r_shadow, v);
+                const VectorType s = r - alpha*v;
+                SparseSpaceType::Mult(rA, s, t);
+                const double omega = inner_prod(t, s)/inner_prod(t, t);
+                x += alpha*p + omega*s;
+                r = s - omega*t;
+                const double rho_new = inner_prod(r_shadow, r);
+                const double beta = (rho_new/rho)*(alpha/omega);
+                rho = rho_new;
+                p = r + beta*(p - omega*v);
+            }
+            return x;
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(BiCGStabLSolverOfOrderOneMatchesBiCGStab, QuestCoreLinearSolversFastSuite)
+    {
+        // ℓ = 1 时每个循环即一步 BiCGStab，前几步的迭代解应与参考实现一致到舍入误差
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, 12, 0.6);
+        VectorType exact, b;
+        ManufacturedSolution(A, exact, b);
+
+        for(const std::size_t k : {1, 4, 10}){
+            const VectorType reference = ReferenceBiCGStab(A, b, k);
+
+            BiCGStabLSolverType solver(1e-14, k, 1);
+            VectorType x(b.size(), 0.0), b_copy = b;
+            solver.Solve(A, x, b_copy);
+            QUEST_EXPECT_EQ(solver.GetIterationsNumber(), k);
+            QUEST_EXPECT_TRUE(norm_2(x - reference) < 1e-9*norm_2(reference));
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(BiCGStabLSolverConvergesOnNonsymmetricSystem, QuestCoreLinearSolversFastSuite)
+    {
+        // 网格 Péclet 数超过 2，特征值为复数
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, 30, 1.5);
+        VectorType exact, b;
+        ManufacturedSolution(A, exact, b);
+
+        std::vector<std::size_t> iterations;
+        for(const unsigned int l : {1, 2, 4}){
+            BiCGStabLSolverType solver(1e-10, 5000, l);
+            VectorType x(b.size(), 0.0), b_copy = b;
+            QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+            QUEST_EXPECT_EQ(solver.GetIterationsNumber() % l, 0);
+            QUEST_EXPECT_TRUE(ResidualNorm(A, x, b) < 1e-8*norm_2(b));
+            QUEST_EXPECT_TRUE(norm_2(x - exact) < 1e-6*norm_2(exact));
+            iterations.push_back(solver.GetIterationsNumber());
+        }
+
+        // 复特征值下二次稳定多项式比 BiCGStab 需要的 BiCG 步更少（本例 64 对 105）
+        QUEST_EXPECT_TRUE(iterations[1] < iterations[0]);
+
+        BiCGStabLSolverType solver(1e-10, 5000, 2, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        VectorType x(b.size(), 0.0), b_copy = b;
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+        QUEST_EXPECT_TRUE(ResidualNorm(A, x, b) < 1e-8*norm_2(b));
+        QUEST_EXPECT_TRUE(norm_2(x - exact) < 1e-6*norm_2(exact));
+        QUEST_EXPECT_TRUE(2*solver.GetIterationsNumber() < iterations[1]);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(BiCGStabLSolverMultipleRightHandSides, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, 20, 0.6);
+        const std::size_t size = A.size1();
+        const std::size_t number_of_rhs = 3;
+
+        DenseMatrixType X(size, number_of_rhs), B(size, number_of_rhs);
+        for(std::size_t i=0; i<size; ++i){
+            for(std::size_t c=0; c<number_of_rhs; ++c){
+                X(i, c) = 0.0;
+                B(i, c) = std::cos(0.1*(c+1)*i) + c;
+            }
+        }
+        const DenseMatrixType B_copy = B;
+
+        BiCGStabLSolverType solver(1e-10, 5000, 2, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        QUEST_EXPECT_TRUE(solver.Solve(A, X, B));
+
+        VectorType x(size), b(size);
+        for(std::size_t c=0; c<number_of_rhs; ++c){
+            for(std::size_t i=0; i<size; ++i){
+                x[i] = X(i, c);
+                b[i] = B_copy(i, c);
+            }
+            QUEST_EXPECT_TRUE(ResidualNorm(A, x, b) < 1e-8*norm_2(b));
+        }
+
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(BiCGStabLSolverType(1e-10, 100, 0));
+    }
+
+} // namespace Quest::Testing
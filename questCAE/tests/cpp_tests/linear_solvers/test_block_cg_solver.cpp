@@ -0,0 +1,125 @@
+// 系统头文件
+#include <cmath>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/block_cg_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using DenseMatrixType = LocalSpaceType::MatrixType;
+        using BlockCGSolverType = BlockCGSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上的五点差分 Laplace 矩阵
+         */
+        void PoissonMatrix(SparseMatrixType& rA, const std::size_t n){
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(std::size_t row=0; row<n*n; ++row){
+                const std::size_t i = row/n;
+                const std::size_t j = row%n;
+                auto add = [&](const std::size_t Col, const double Value){
+                    col_indices.push_back(Col);
+                    values.push_back(Value);
+                };
+                if(i > 0) add(row-n, -1.0);
+                if(j > 0) add(row-1, -1.0);
+                add(row, 4.0);
+                if(j < n-1) add(row+1, -1.0);
+                if(i < n-1) add(row+n, -1.0);
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 返回第 Column 列的相对残差 |b - A*x| / |b|，右端项为零时返回 |A*x|
+         */
+        double ColumnResidual(const SparseMatrixType& rA, const DenseMatrixType& rX, const DenseMatrixType& rB, const std::size_t Column){
+            const std::size_t size = rA.size1();
+            VectorType x(size), ax(size);
+            for(std::size_t i=0; i<size; ++i){
+                x[i] = rX(i, Column);
+            }
+            SparseSpaceType::Mult(rA, x, ax);
+            double r_norm = 0.0;
+            double b_norm = 0.0;
+            for(std::size_t i=0; i<size; ++i){
+                r_norm += (rB(i, Column) - ax[i])*(rB(i, Column) - ax[i]);
+                b_norm += rB(i, Column)*rB(i, Column);
+            }
+            return b_norm > 0.0 ? std::sqrt(r_norm/b_norm) : std::sqrt(r_norm);
+        }
+
+        /**
+         * @brief 光滑的右端项，第 NumberOfColumns-2 列与第 0 列相同，最后一列为零
+         */
+        DenseMatrixType RightHandSides(const std::size_t Size, const std::size_t NumberOfColumns){
+            DenseMatrixType b(Size, NumberOfColumns);
+            for(std::size_t j=0; j<NumberOfColumns; ++j){
+                for(std::size_t i=0; i<Size; ++i){
+                    b(i, j) = std::sin(0.01*(j+1)*i + j);
+                }
+            }
+            for(std::size_t i=0; i<Size; ++i){
+                b(i, NumberOfColumns-2) = b(i, 0);
+                b(i, NumberOfColumns-1) = 0.0;
+            }
+            return b;
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(BlockCGSolverMultipleRightHandSides, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        PoissonMatrix(A, 30);
+        const std::size_t size = A.size1();
+        BlockCGSolverType solver(1e-9, 1000);
+
+        // 同一求解器先后求解不同列数的块，检验成员工作区在两次求解间的重复使用
+        for(const std::size_t number_of_columns : {6, 3}){
+            const DenseMatrixType b = RightHandSides(size, number_of_columns);
+            DenseMatrixType b_copy = b;
+            DenseMatrixType x = ZeroMatrix(size, number_of_columns);
+
+            QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+            for(std::size_t j=0; j<number_of_columns; ++j){
+                QUEST_EXPECT_TRUE(ColumnResidual(A, x, b, j) < 1e-8);
+            }
+            QUEST_EXPECT_EQ(solver.GetColumnIterationsNumber()[number_of_columns-1], 0);
+            for(std::size_t i=0; i<size; ++i){
+                QUEST_EXPECT_NEAR(x(i, number_of_columns-2), x(i, 0), 1e-7);
+            }
+        }
+
+        VectorType b(size), x(size, 0.0);
+        for(std::size_t i=0; i<size; ++i){
+            b[i] = std::cos(0.02*i);
+        }
+        VectorType b_copy = b;
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+        VectorType ax(size);
+        SparseSpaceType::Mult(A, x, ax);
+        QUEST_EXPECT_TRUE(norm_2(b - ax) < 1e-8*norm_2(b));
+    }
+
+} // namespace Quest::Testing
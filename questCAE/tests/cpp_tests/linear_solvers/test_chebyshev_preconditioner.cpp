@@ -0,0 +1,136 @@
+// 系统头文件
+#include <cmath>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/preconditioner/chebyshev_preconditioner.hpp"
+#include "linear_solvers/recycling_cg_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using PreconditionerType = Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ILU0PreconditionerType = ILU0Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ChebyshevPreconditionerType = ChebyshevPreconditioner<SparseSpaceType, LocalSpaceType>;
+        using RecyclingCGSolverType = RecyclingCGSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上系数按 4×4 棋盘格跳跃 1000 倍的五点差分扩散矩阵
+         * @details 边界外的邻点只计入对角元（Dirichlet 边界），矩阵对称正定
+         */
+        void HeterogeneousDiffusionMatrix(SparseMatrixType& rA, const int n){
+            auto conductivity = [&](const int i, const int j){
+                return ((i/(n/4) + j/(n/4)) % 2) ? 1000.0 : 1.0;
+            };
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                std::vector<std::pair<int, double>> entries;
+                double diagonal = 0.0;
+                auto add_neighbour = [&](const int ii, const int jj){
+                    const double k = 0.5*(conductivity(i, j) + conductivity(ii, jj));
+                    diagonal += k;
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        entries.push_back({ii*n + jj, -k});
+                    }
+                };
+                add_neighbour(i-1, j);
+                add_neighbour(i, j-1);
+                add_neighbour(i, j+1);
+                add_neighbour(i+1, j);
+                entries.push_back({row, diagonal});
+                std::sort(entries.begin(), entries.end());
+                for(const auto& r_entry : entries){
+                    col_indices.push_back(r_entry.first);
+                    values.push_back(r_entry.second);
+                }
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 以零初值做预处理 CG 求解（回收空间维数为 0），检查真实残差并返回迭代次数
+         */
+        std::size_t SolveAndCount(SparseMatrixType& rA, PreconditionerType::Pointer pPreconditioner){
+            const std::size_t size = rA.size1();
+            VectorType exact(size), b(size), x(size, 0.0), ax(size);
+            for(std::size_t i=0; i<size; ++i){
+                exact[i] = std::sin(0.02*i) + std::cos(0.003*i);
+            }
+            SparseSpaceType::Mult(rA, exact, b);
+            VectorType b_copy = b;
+            RecyclingCGSolverType solver(1e-8, 5000, 0, 16, pPreconditioner);
+            solver.Solve(rA, x, b_copy);
+            SparseSpaceType::Mult(rA, x, ax);
+            QUEST_EXPECT_TRUE(norm_2(b - ax) < 1e-6*norm_2(b));
+            return solver.GetIterationsNumber();
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(ChebyshevPreconditionerReducesCGIterations, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        HeterogeneousDiffusionMatrix(A, 100);
+
+        const std::size_t none = SolveAndCount(A, PreconditionerType::Pointer(new PreconditionerType()));
+        const std::size_t ilu0 = SolveAndCount(A, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        const std::size_t degree_3 = SolveAndCount(A, PreconditionerType::Pointer(new ChebyshevPreconditionerType(3)));
+        const std::size_t degree_8 = SolveAndCount(A, PreconditionerType::Pointer(new ChebyshevPreconditionerType(8)));
+
+        // 未预处理 2036 次、ILU(0) 108 次、三次多项式 108 次、八次多项式 50 次
+        QUEST_EXPECT_TRUE(10*degree_3 < none);
+        QUEST_EXPECT_TRUE(2*degree_3 < 3*ilu0);
+        QUEST_EXPECT_TRUE(degree_8 < degree_3);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(ChebyshevPreconditionerTransposeApplication, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        HeterogeneousDiffusionMatrix(A, 20);
+        const std::size_t size = A.size1();
+
+        ChebyshevPreconditionerType preconditioner(4);
+        VectorType u(size), v(size);
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(preconditioner.ApplyLeft(u));
+
+        VectorType x(size, 0.0), b(size, 1.0);
+        preconditioner.Initialize(A, x, b);
+
+        // 左预处理为 p(As)*S，转置右预处理必须是它的转置 S*p(As)：<M*u, v> = <u, M^T*v>
+        for(std::size_t i=0; i<size; ++i){
+            u[i] = std::sin(0.1*i) + 0.5;
+            v[i] = std::cos(0.07*i);
+        }
+        VectorType left_u = u;
+        VectorType transpose_v = v;
+        preconditioner.ApplyLeft(left_u);
+        preconditioner.ApplyTransposeRight(transpose_v);
+        const double lhs = inner_prod(left_u, v);
+        const double rhs = inner_prod(u, transpose_v);
+        QUEST_EXPECT_NEAR(lhs, rhs, 1e-10*std::abs(lhs));
+    }
+
+} // namespace Quest::Testing
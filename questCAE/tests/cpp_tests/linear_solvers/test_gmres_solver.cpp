@@ -0,0 +1,194 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/gmres_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using DenseMatrixType = LocalSpaceType::MatrixType;
+        using PreconditionerType = Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ILU0PreconditionerType = ILU0Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using GMRESSolverType = GMRESSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上的五点差分对流扩散矩阵（非对称），自然编号
+         * @details Convection > 1 时网格 Péclet 数超过 2，矩阵的特征值成为复数
+         */
+        void ConvectionDiffusionMatrix(SparseMatrixType& rA, const int n, const double Convection){
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                auto add = [&](const int ii, const int jj, const double Value){
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        col_indices.push_back(ii*n + jj);
+                        values.push_back(Value);
+                    }
+                };
+                add(i-1, j, -1.0 - Convection);
+                add(i, j-1, -1.0 - Convection);
+                add(i, j, 4.0);
+                add(i, j+1, -1.0 + Convection);
+                add(i+1, j, -1.0 + Convection);
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 光滑的精确解及其对应的右端项
+         */
+        void ManufacturedSolution(const SparseMatrixType& rA, VectorType& rExact, VectorType& rB){
+            const std::size_t size = rA.size1();
+            rExact.resize(size);
+            rB.resize(size);
+            for(std::size_t i=0; i<size; ++i){
+                rExact[i] = std::sin(0.05*i) + 0.01*i;
+            }
+            SparseSpaceType::Mult(rA, rExact, rB);
+        }
+
+        /**
+         * @brief 真实残差范数 |b - A*x|
+         */
+        double ResidualNorm(const SparseMatrixType& rA, const VectorType& rX, const VectorType& rB){
+            VectorType ax(rX.size());
+            SparseSpaceType::Mult(rA, rX, ax);
+            return norm_2(rB - ax);
+        }
+
+        /**
+         * @brief 参考值：以零初值在 K_k(A, b) 上可达到的最小残差范数
+         * @details 以两遍修正 Gram-Schmidt 构造 A*K_k 的正交基 Q，最小残差即 b 在 Q 的正交补上的投影的范数
+         */
+        double MinimalResidualNorm(const SparseMatrixType& rA, const VectorType& rB, const std::size_t k){
+            const std::size_t size = rB.size();
+            std::vector<VectorType> krylov(1, rB/norm_2(rB));
+            std::vector<VectorType> image;
+            VectorType residual = rB;
+            for(std::size_t j=0; j<k; ++j){
+                VectorType w(size);
+                SparseSpaceType::Mult(rA, krylov.back(), w);
+                VectorType q = w;
+                for(int pass=0; pass<2; ++pass){
+                    for(const auto& r_q : image){
+                        q -= inner_prod(r_q, q)*r_q;
+                    }
+                }
+                q /= norm_2(q);
+                residual -= inner_prod(q, residual)*q;
+                image.push_back(q);
+                for(int pass=0; pass<2; ++pass){
+                    for(const auto& r_v : krylov){
+                        w -= inner_prod(r_v, w)*r_v;
+                    }
+                }
+                krylov.push_back(w/norm_2(w));
+            }
+            return norm_2(residual);
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(GMRESSolverMinimizesResidualOverKrylovSpace, QuestCoreLinearSolversFastSuite)
+    {
+        // 不重启时 k 步后的残差即 K_k(A, b) 上的最小残差；重启后的残差不可能更小
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, 12, 1.5);
+        VectorType exact, b;
+        ManufacturedSolution(A, exact, b);
+
+        for(const std::size_t k : {5, 15, 30}){
+            const double reference = MinimalResidualNorm(A, b, k);
+
+            GMRESSolverType full(1e-14, k, 50);
+            VectorType x(b.size(), 0.0), b_copy = b;
+            full.Solve(A, x, b_copy);
+            QUEST_EXPECT_EQ(full.GetIterationsNumber(), k);
+            QUEST_EXPECT_NEAR(ResidualNorm(A, x, b), reference, 1e-8*norm_2(b));
+
+            GMRESSolverType restarted(1e-14, k, 4);
+            VectorType x_restarted(b.size(), 0.0), b_restarted = b;
+            restarted.Solve(A, x_restarted, b_restarted);
+            QUEST_EXPECT_TRUE(ResidualNorm(A, x_restarted, b) >= reference*(1.0 - 1e-8));
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(GMRESSolverConvergesOnNonsymmetricSystem, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, 30, 1.5);
+        VectorType exact, b;
+        ManufacturedSolution(A, exact, b);
+
+        GMRESSolverType plain(1e-10, 5000, 30);
+        VectorType x_plain(b.size(), 0.0), b_plain = b;
+        QUEST_EXPECT_TRUE(plain.Solve(A, x_plain, b_plain));
+        QUEST_EXPECT_TRUE(ResidualNorm(A, x_plain, b) < 1e-8*norm_2(b));
+        QUEST_EXPECT_TRUE(norm_2(x_plain - exact) < 1e-6*norm_2(exact));
+
+        GMRESSolverType solver(1e-10, 5000, 30, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        VectorType x(b.size(), 0.0), b_copy = b;
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+        QUEST_EXPECT_TRUE(ResidualNorm(A, x, b) < 1e-8*norm_2(b));
+        QUEST_EXPECT_TRUE(norm_2(x - exact) < 1e-6*norm_2(exact));
+        QUEST_EXPECT_TRUE(2*solver.GetIterationsNumber() < plain.GetIterationsNumber());
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(GMRESSolverMultipleRightHandSides, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, 20, 0.6);
+        const std::size_t size = A.size1();
+        const std::size_t number_of_rhs = 3;
+
+        DenseMatrixType X(size, number_of_rhs), B(size, number_of_rhs);
+        for(std::size_t i=0; i<size; ++i){
+            for(std::size_t c=0; c<number_of_rhs; ++c){
+                X(i, c) = 0.0;
+                B(i, c) = std::cos(0.1*(c+1)*i) + c;
+            }
+        }
+        const DenseMatrixType B_copy = B;
+
+        GMRESSolverType solver(1e-10, 5000, 20, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        QUEST_EXPECT_TRUE(solver.Solve(A, X, B));
+
+        VectorType x(size), b(size);
+        for(std::size_t c=0; c<number_of_rhs; ++c){
+            for(std::size_t i=0; i<size; ++i){
+                x[i] = X(i, c);
+                b[i] = B_copy(i, c);
+            }
+            QUEST_EXPECT_TRUE(ResidualNorm(A, x, b) < 1e-8*norm_2(b));
+        }
+
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(GMRESSolverType(1e-10, 100, 0));
+    }
+
+} // namespace Quest::Testing
@@ -0,0 +1,191 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/preconditioner/ilut_preconditioner.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using ILU0PreconditionerType = ILU0Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ILUTPreconditionerType = ILUTPreconditioner<SparseSpaceType, LocalSpaceType>;
+        using DenseType = std::vector<std::vector<double>>;
+
+        /**
+         * @brief n×n 网格上的五点差分对流扩散矩阵（非对称，对角占优），自然编号
+         */
+        void ConvectionDiffusionMatrix(SparseMatrixType& rA, const int n, const double Convection){
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                auto add = [&](const int ii, const int jj, const double Value){
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        col_indices.push_back(ii*n + jj);
+                        values.push_back(Value);
+                    }
+                };
+                add(i-1, j, -1.0 - Convection);
+                add(i, j-1, -1.0 - Convection);
+                add(i, j, 4.0);
+                add(i, j+1, -1.0 + Convection);
+                add(i+1, j, -1.0 + Convection);
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 施加完整的预处理 M^(-1) = U^(-1)*L^(-1)（左右预处理中的对角缩放相互抵消）
+         */
+        template<typename TPreconditionerType>
+        void ApplyInverse(TPreconditionerType& rPreconditioner, VectorType& rX){
+            rPreconditioner.ApplyLeft(rX);
+            rPreconditioner.ApplyRight(rX);
+        }
+
+        /**
+         * @brief 部分选主元的 Gauss-Jordan 稠密求逆
+         */
+        DenseType DenseInverse(DenseType a){
+            const std::size_t n = a.size();
+            DenseType inv(n, std::vector<double>(n, 0.0));
+            for(std::size_t i=0; i<n; ++i){
+                inv[i][i] = 1.0;
+            }
+            for(std::size_t c=0; c<n; ++c){
+                std::size_t pivot = c;
+                for(std::size_t r=c+1; r<n; ++r){
+                    if(std::abs(a[r][c]) > std::abs(a[pivot][c])){
+                        pivot = r;
+                    }
+                }
+                std::swap(a[c], a[pivot]);
+                std::swap(inv[c], inv[pivot]);
+                const double d = a[c][c];
+                for(std::size_t j=0; j<n; ++j){
+                    a[c][j] /= d;
+                    inv[c][j] /= d;
+                }
+                for(std::size_t r=0; r<n; ++r){
+                    if(r != c && a[r][c] != 0.0){
+                        const double f = a[r][c];
+                        for(std::size_t j=0; j<n; ++j){
+                            a[r][j] -= f*a[c][j];
+                            inv[r][j] -= f*inv[c][j];
+                        }
+                    }
+                }
+            }
+            return inv;
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(ILU0PreconditionerMatchesMatrixOnPattern, QuestCoreLinearSolversFastSuite)
+    {
+        // ILU(0) 的定义：L*U 在 A 的稀疏模式上与 A 相等，模式之外的填充被舍弃
+        const int n = 6;
+        const std::size_t size = n*n;
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, n, 0.3);
+        VectorType x(size, 0.0), b(size, 1.0);
+        ILU0PreconditionerType preconditioner;
+        preconditioner.Initialize(A, x, b);
+        QUEST_EXPECT_EQ(preconditioner.NumberOfNonZeros(), A.nnz());
+
+        DenseType inverse(size, std::vector<double>(size, 0.0));
+        for(std::size_t j=0; j<size; ++j){
+            VectorType e(size, 0.0);
+            e[j] = 1.0;
+            ApplyInverse(preconditioner, e);
+            for(std::size_t i=0; i<size; ++i){
+                inverse[i][j] = e[i];
+            }
+        }
+        const DenseType lu = DenseInverse(inverse);
+        for(std::size_t i=0; i<size; ++i){
+            for(std::size_t k=A.index1_data()[i]; k<A.index1_data()[i+1]; ++k){
+                QUEST_EXPECT_NEAR(lu[i][A.index2_data()[k]], A.value_data()[k], 1e-10);
+            }
+        }
+
+        // 自然编号的五点格式按反对角线分层：前代与回代各 2n-1 层，每行只依赖于更早的层
+        const auto& r_lower = preconditioner.GetLowerSchedule();
+        QUEST_EXPECT_EQ(r_lower.NumberOfLevels(), static_cast<std::size_t>(2*n - 1));
+        QUEST_EXPECT_EQ(preconditioner.GetUpperSchedule().NumberOfLevels(), static_cast<std::size_t>(2*n - 1));
+        std::vector<std::size_t> level_of_row(size);
+        for(std::size_t l=0; l<r_lower.NumberOfLevels(); ++l){
+            for(std::size_t p=r_lower.LevelBegin(l); p<r_lower.LevelEnd(l); ++p){
+                level_of_row[r_lower.Rows()[p]] = l;
+            }
+        }
+        for(std::size_t i=0; i<size; ++i){
+            for(std::size_t k=A.index1_data()[i]; k<A.index1_data()[i+1]; ++k){
+                const std::size_t j = A.index2_data()[k];
+                if(j < i){
+                    QUEST_EXPECT_TRUE(level_of_row[j] < level_of_row[i]);
+                }
+            }
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(ILUTPreconditionerWithoutDroppingIsExact, QuestCoreLinearSolversFastSuite)
+    {
+        // τ = 0 且填充不受限时 ILUT 即完全 LU 分解，M^(-1)*b 为精确解
+        const int n = 10;
+        const std::size_t size = n*n;
+        SparseMatrixType A;
+        ConvectionDiffusionMatrix(A, n, 0.45);
+        VectorType exact(size), b(size), x(size, 0.0);
+        for(std::size_t i=0; i<size; ++i){
+            exact[i] = std::sin(0.2*i) + 0.1*i;
+        }
+        SparseSpaceType::Mult(A, exact, b);
+
+        ILUTPreconditionerType preconditioner(0.0, size);
+        preconditioner.Initialize(A, x, b);
+        QUEST_EXPECT_TRUE(preconditioner.NumberOfNonZeros() > A.nnz());
+        VectorType y = b;
+        ApplyInverse(preconditioner, y);
+        for(std::size_t i=0; i<size; ++i){
+            QUEST_EXPECT_NEAR(y[i], exact[i], 1e-10*(1.0 + std::abs(exact[i])));
+        }
+
+        // 稀疏模式不变时只进行数值分解，结果仍为精确解
+        for(auto& r_value : A.value_data()){
+            r_value *= 2.0;
+        }
+        SparseSpaceType::Mult(A, exact, b);
+        preconditioner.Initialize(A, x, b);
+        QUEST_EXPECT_EQ(preconditioner.GetNumberOfNumericFactorizations(), 2);
+        y = b;
+        ApplyInverse(preconditioner, y);
+        for(std::size_t i=0; i<size; ++i){
+            QUEST_EXPECT_NEAR(y[i], exact[i], 1e-10*(1.0 + std::abs(exact[i])));
+        }
+    }
+
+} // namespace Quest::Testing
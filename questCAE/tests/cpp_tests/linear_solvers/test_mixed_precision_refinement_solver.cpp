@@ -0,0 +1,151 @@
+// 系统头文件
+#include <cmath>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "space/ublas_space.hpp"
+#include "factories/linear_solver_factory.hpp"
+#include "factories/standard_linear_solver_factory.hpp"
+#include "linear_solvers/supernodal_cholesky_solver.hpp"
+#include "linear_solvers/mixed_precision_refinement_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = TUblasSparseSpace<double>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using LowSparseSpaceType = TUblasSparseSpace<float>;
+        using LowLocalSpaceType = TUblasDenseSpace<float>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using MixedPrecisionSolverType = MixedPrecisionRefinementSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上中心区域系数为 Jump 的五点差分扩散矩阵，Jump 越大条件数越大
+         */
+        SparseMatrixType DiffusionMatrix(const int n, const double Jump){
+            auto conductivity = [&](const int i, const int j){
+                return (i > n/3 && i < 2*n/3 && j > n/3 && j < 2*n/3) ? Jump : 1.0;
+            };
+            const std::size_t size = n*n;
+            SparseMatrixType A(size, size, 5*size);
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                std::vector<std::pair<int, double>> entries;
+                double diagonal = 0.0;
+                auto add_neighbour = [&](const int ii, const int jj){
+                    const double k = 0.5*(conductivity(i, j) + conductivity(ii, jj));
+                    diagonal += k;
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        entries.push_back({ii*n + jj, -k});
+                    }
+                };
+                add_neighbour(i-1, j);
+                add_neighbour(i, j-1);
+                add_neighbour(i, j+1);
+                add_neighbour(i+1, j);
+                entries.push_back({row, diagonal});
+                std::sort(entries.begin(), entries.end());
+                for(const auto& r_entry : entries){
+                    A.push_back(row, r_entry.first, r_entry.second);
+                }
+            }
+            return A;
+        }
+
+        /**
+         * @brief 单精度与双精度内层求解器均为超节点 Cholesky
+         */
+        MixedPrecisionSolverType CreateSolver(const double Tolerance, const unsigned int MaxIterations, const double MaxConditionNumber){
+            return MixedPrecisionSolverType(
+                LinearSolver<LowSparseSpaceType, LowLocalSpaceType>::Pointer(new SupernodalCholeskySolver<LowSparseSpaceType, LowLocalSpaceType>()),
+                LinearSolver<SparseSpaceType, LocalSpaceType>::Pointer(new SupernodalCholeskySolver<SparseSpaceType, LocalSpaceType>()),
+                Tolerance, MaxIterations, MaxConditionNumber);
+        }
+
+        /**
+         * @brief 求解并返回相对残差 |b - A*x| / |b|
+         */
+        double SolveAndCheck(MixedPrecisionSolverType& rSolver, SparseMatrixType& rA){
+            const std::size_t size = rA.size1();
+            VectorType b(size), x(size), ax(size);
+            for(std::size_t i=0; i<size; ++i){
+                b[i] = std::sin(0.01*i) + 1.0;
+            }
+            VectorType b_copy = b;
+            QUEST_EXPECT_TRUE(rSolver.Solve(rA, x, b_copy));
+            SparseSpaceType::Mult(rA, x, ax);
+            return norm_2(b - ax)/norm_2(b);
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(MixedPrecisionRefinementSolverRefines, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A = DiffusionMatrix(30, 1.0);
+        MixedPrecisionSolverType solver = CreateSolver(1e-12, 10, 1e6);
+
+        // 条件数小：单精度分解加若干次双精度修正即达到双精度容差
+        QUEST_EXPECT_TRUE(SolveAndCheck(solver, A) < 1e-12);
+        QUEST_EXPECT_FALSE(solver.IsUsingFallback());
+        QUEST_EXPECT_TRUE(solver.GetIterationsNumber() > 1);
+        QUEST_EXPECT_TRUE(solver.GetResidualNorm() < 1e-12);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(MixedPrecisionRefinementSolverFallback, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A = DiffusionMatrix(30, 1e3);
+
+        // 条件数估计超过阈值：分解阶段即改用双精度分解
+        MixedPrecisionSolverType ill_conditioned = CreateSolver(1e-10, 10, 10.0);
+        QUEST_EXPECT_TRUE(SolveAndCheck(ill_conditioned, A) < 1e-10);
+        QUEST_EXPECT_TRUE(ill_conditioned.IsUsingFallback());
+        QUEST_EXPECT_EQ(ill_conditioned.GetIterationsNumber(), 0);
+        QUEST_EXPECT_TRUE(ill_conditioned.GetResidualNorm() < 1e-10);
+
+        // 一次修正达不到容差：求解阶段改用双精度分解，修正次数记为 0，残差为双精度解的真实残差
+        MixedPrecisionSolverType stagnating = CreateSolver(1e-10, 1, 1e6);
+        QUEST_EXPECT_TRUE(SolveAndCheck(stagnating, A) < 1e-10);
+        QUEST_EXPECT_TRUE(stagnating.IsUsingFallback());
+        QUEST_EXPECT_EQ(stagnating.GetIterationsNumber(), 0);
+        QUEST_EXPECT_TRUE(stagnating.GetResidualNorm() < 1e-10);
+
+        // 容差无法达到时双精度解也不能报告收敛
+        MixedPrecisionSolverType unreachable = CreateSolver(1e-30, 1, 1e6);
+        const std::size_t size = A.size1();
+        VectorType x(size), b(size, 1.0);
+        QUEST_EXPECT_FALSE(unreachable.Solve(A, x, b));
+        QUEST_EXPECT_TRUE(unreachable.IsUsingFallback());
+        QUEST_EXPECT_EQ(unreachable.GetIterationsNumber(), 0);
+        QUEST_EXPECT_TRUE(unreachable.GetResidualNorm() > 0.0);
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(MixedPrecisionRefinementSolverFromFactory, QuestCoreLinearSolversFastSuite)
+    {
+        RegisterLinearSolvers();
+        QUEST_EXPECT_TRUE((LinearSolverFactory<LowSparseSpaceType, LowLocalSpaceType>().Has("supernodal_cholesky")));
+
+        // 单精度内层求解器经由 float 工厂创建
+        SparseMatrixType A = DiffusionMatrix(30, 1.0);
+        auto p_solver = LinearSolverFactory<SparseSpaceType, LocalSpaceType>().Create(
+            Parameters(R"({"solver_type" : "mixed_precision_refinement", "tolerance" : 1e-12})"));
+        auto p_mixed = dynamic_cast<MixedPrecisionSolverType*>(p_solver.get());
+        QUEST_EXPECT_TRUE(p_mixed != nullptr);
+        QUEST_EXPECT_TRUE(SolveAndCheck(*p_mixed, A) < 1e-12);
+        QUEST_EXPECT_FALSE(p_mixed->IsUsingFallback());
+
+        // 回退所用的双精度求解器经由 double 工厂创建
+        SparseMatrixType B = DiffusionMatrix(30, 1e3);
+        auto p_fallback_solver = LinearSolverFactory<SparseSpaceType, LocalSpaceType>().Create(
+            Parameters(R"({"solver_type" : "mixed_precision_refinement", "tolerance" : 1e-10, "max_condition_number" : 10.0})"));
+        auto p_fallback = dynamic_cast<MixedPrecisionSolverType*>(p_fallback_solver.get());
+        QUEST_EXPECT_TRUE(p_fallback != nullptr);
+        QUEST_EXPECT_TRUE(SolveAndCheck(*p_fallback, B) < 1e-10);
+        QUEST_EXPECT_TRUE(p_fallback->IsUsingFallback());
+    }
+
+} // namespace Quest::Testing
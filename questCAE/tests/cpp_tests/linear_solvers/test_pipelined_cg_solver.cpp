@@ -0,0 +1,190 @@
+// 系统头文件
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/pipelined_cg_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using DenseMatrixType = LocalSpaceType::MatrixType;
+        using PreconditionerType = Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ILU0PreconditionerType = ILU0Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using PipelinedCGSolverType = PipelinedCGSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上变系数五点差分扩散矩阵，Dirichlet 边界，对称正定
+         */
+        void VariableDiffusionMatrix(SparseMatrixType& rA, const int n){
+            auto conductivity = [](const int i, const int j){
+                return 1.0 + 0.9*std::sin(0.7*i)*std::cos(0.4*j) + 0.05*(i + j);
+            };
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                std::vector<std::pair<int, double>> entries;
+                double diagonal = 0.0;
+                auto add_neighbour = [&](const int ii, const int jj){
+                    const double k = 0.5*(conductivity(i, j) + conductivity(ii, jj));
+                    diagonal += k;
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        entries.push_back({ii*n + jj, -k});
+                    }
+                };
+                add_neighbour(i-1, j);
+                add_neighbour(i, j-1);
+                add_neighbour(i, j+1);
+                add_neighbour(i+1, j);
+                entries.push_back({row, diagonal});
+                std::sort(entries.begin(), entries.end());
+                for(const auto& r_entry : entries){
+                    col_indices.push_back(r_entry.first);
+                    values.push_back(r_entry.second);
+                }
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 真实相对残差 |b - A*x| / |b|
+         */
+        double RelativeResidual(const SparseMatrixType& rA, const VectorType& rX, const VectorType& rB){
+            VectorType ax(rX.size());
+            SparseSpaceType::Mult(rA, rX, ax);
+            return norm_2(rB - ax)/norm_2(rB);
+        }
+
+        /**
+         * @brief 教科书式的无预处理CG，以零初值求解，收敛准则与 IterativeSolver 相同（|r| <= Tolerance*|b|）
+         * @return 迭代次数
+         */
+        unsigned int ReferenceCG(const SparseMatrixType& rA, const VectorType& rB, const double Tolerance, VectorType& rX){
+            const std::size_t size = rB.size();
+            rX = VectorType(size, 0.0);
+            VectorType r = rB, p = rB, ap(size);
+            double gamma = SparseSpaceType::Dot(r, r);
+            const double b_norm = std::sqrt(gamma);
+            unsigned int iterations = 0;
+            while(std::sqrt(gamma) > Tolerance*b_norm && iterations < 10*size){
+                SparseSpaceType::Mult(rA, p, ap);
+                const double alpha = gamma/SparseSpaceType::Dot(p, ap);
+                rX += alpha*p;
+                r -= alpha*ap;
+                const double gamma_new = SparseSpaceType::Dot(r, r);
+                p = r + (gamma_new/gamma)*p;
+                gamma = gamma_new;
+                ++iterations;
+            }
+            return iterations;
+        }
+
+        /**
+         * @brief 光滑的精确解及其对应的右端项
+         */
+        void ManufacturedSolution(const SparseMatrixType& rA, VectorType& rExact, VectorType& rB){
+            const std::size_t size = rA.size1();
+            rExact.resize(size);
+            rB.resize(size);
+            for(std::size_t i=0; i<size; ++i){
+                rExact[i] = std::sin(0.05*i) + 0.01*i;
+            }
+            SparseSpaceType::Mult(rA, rExact, rB);
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(PipelinedCGSolverMatchesReferenceCG, QuestCoreLinearSolversFastSuite)
+    {
+        // 精确算术下流水线CG与标准CG生成相同的迭代序列，迭代次数只能因舍入误差略有差异
+        SparseMatrixType A;
+        VariableDiffusionMatrix(A, 30);
+        VectorType exact, b;
+        ManufacturedSolution(A, exact, b);
+
+        VectorType x_reference;
+        const double reference_iterations = ReferenceCG(A, b, 1e-10, x_reference);
+
+        PipelinedCGSolverType solver(1e-10, 2000);
+        VectorType x(b.size(), 0.0), b_copy = b;
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+        QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-8);
+        QUEST_EXPECT_TRUE(norm_2(x - x_reference) < 1e-6*norm_2(x_reference));
+        const double iterations = solver.GetIterationsNumber();
+        QUEST_EXPECT_TRUE(std::abs(iterations - reference_iterations) <= std::max(2.0, 0.05*reference_iterations));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(PipelinedCGSolverWithPreconditioner, QuestCoreLinearSolversFastSuite)
+    {
+        // 对称矩阵的 ILU(0) 分裂预处理是对称的，预处理后迭代次数应明显减少
+        SparseMatrixType A;
+        VariableDiffusionMatrix(A, 30);
+        VectorType exact, b;
+        ManufacturedSolution(A, exact, b);
+
+        PipelinedCGSolverType plain(1e-10, 2000);
+        VectorType x_plain(b.size(), 0.0), b_plain = b;
+        QUEST_EXPECT_TRUE(plain.Solve(A, x_plain, b_plain));
+
+        PipelinedCGSolverType solver(1e-10, 2000, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        VectorType x(b.size(), 0.0), b_copy = b;
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b_copy));
+        QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-8);
+        QUEST_EXPECT_TRUE(norm_2(x - exact) < 1e-6*norm_2(exact));
+        QUEST_EXPECT_TRUE(2*solver.GetIterationsNumber() < plain.GetIterationsNumber());
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(PipelinedCGSolverMultipleRightHandSides, QuestCoreLinearSolversFastSuite)
+    {
+        SparseMatrixType A;
+        VariableDiffusionMatrix(A, 20);
+        const std::size_t size = A.size1();
+        const std::size_t number_of_rhs = 3;
+
+        DenseMatrixType X(size, number_of_rhs), B(size, number_of_rhs);
+        for(std::size_t i=0; i<size; ++i){
+            for(std::size_t c=0; c<number_of_rhs; ++c){
+                X(i, c) = 0.0;
+                B(i, c) = std::cos(0.1*(c+1)*i) + c;
+            }
+        }
+        const DenseMatrixType B_copy = B;
+
+        PipelinedCGSolverType solver(1e-10, 2000, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        QUEST_EXPECT_TRUE(solver.Solve(A, X, B));
+
+        VectorType x(size), b(size);
+        for(std::size_t c=0; c<number_of_rhs; ++c){
+            for(std::size_t i=0; i<size; ++i){
+                x[i] = X(i, c);
+                b[i] = B_copy(i, c);
+            }
+            QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-8);
+        }
+    }
+
+} // namespace Quest::Testing
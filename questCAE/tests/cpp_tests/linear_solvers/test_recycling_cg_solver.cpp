@@ -0,0 +1,116 @@
+// 系统头文件
+#include <cmath>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/preconditioner/ilu0_preconditioner.hpp"
+#include "linear_solvers/recycling_cg_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using PreconditionerType = Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using ILU0PreconditionerType = ILU0Preconditioner<SparseSpaceType, LocalSpaceType>;
+        using RecyclingCGSolverType = RecyclingCGSolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief n×n 网格上系数按 4×4 棋盘格跳跃 1000 倍的五点差分扩散矩阵，Step 对系数做光滑扰动
+         * @details 边界外的邻点只计入对角元（Dirichlet 边界），矩阵对称正定，各步稀疏模式相同
+         */
+        void HeterogeneousDiffusionMatrix(SparseMatrixType& rA, const int n, const double Step){
+            auto conductivity = [&](const int i, const int j){
+                const double jump = ((i/(n/4) + j/(n/4)) % 2) ? 1000.0 : 1.0;
+                return jump * (1.0 + 0.1*Step*std::sin(0.3*i + 0.2*j));
+            };
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            for(int row=0; row<n*n; ++row){
+                const int i = row/n;
+                const int j = row%n;
+                std::vector<std::pair<int, double>> entries;
+                double diagonal = 0.0;
+                auto add_neighbour = [&](const int ii, const int jj){
+                    const double k = 0.5*(conductivity(i, j) + conductivity(ii, jj));
+                    diagonal += k;
+                    if(ii >= 0 && ii < n && jj >= 0 && jj < n){
+                        entries.push_back({ii*n + jj, -k});
+                    }
+                };
+                add_neighbour(i-1, j);
+                add_neighbour(i, j-1);
+                add_neighbour(i, j+1);
+                add_neighbour(i+1, j);
+                entries.push_back({row, diagonal});
+                std::sort(entries.begin(), entries.end());
+                for(const auto& r_entry : entries){
+                    col_indices.push_back(r_entry.first);
+                    values.push_back(r_entry.second);
+                }
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(n*n);
+            rA.SetColSize(n*n);
+        }
+
+        /**
+         * @brief 以零初值求解并返回相对残差 |b - A*x| / |b|，rIterations 返回迭代次数
+         */
+        double SolveAndCheck(RecyclingCGSolverType& rSolver, SparseMatrixType& rA, const int Step, unsigned int& rIterations){
+            const std::size_t size = rA.size1();
+            VectorType exact(size), b(size), x(size, 0.0), ax(size);
+            for(std::size_t i=0; i<size; ++i){
+                exact[i] = std::sin(0.01*i*(Step+1)) + std::cos(0.003*i*Step);
+            }
+            SparseSpaceType::Mult(rA, exact, b);
+            VectorType b_copy = b;
+            rSolver.Solve(rA, x, b_copy);
+            rIterations = rSolver.GetIterationsNumber();
+            SparseSpaceType::Mult(rA, x, ax);
+            return norm_2(b - ax)/norm_2(b);
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(RecyclingCGSolverReducesIterationsOverSequence, QuestCoreLinearSolversFastSuite)
+    {
+        const int n = 80;
+        const int number_of_steps = 10;
+        RecyclingCGSolverType plain(1e-8, 5000, 0, 16, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        RecyclingCGSolverType recycling(1e-8, 5000, 8, 16, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+
+        unsigned int plain_total = 0;
+        unsigned int recycling_total = 0;
+        for(int step=0; step<number_of_steps; ++step){
+            SparseMatrixType A;
+            HeterogeneousDiffusionMatrix(A, n, step);
+            unsigned int plain_iterations = 0;
+            unsigned int recycling_iterations = 0;
+            QUEST_EXPECT_TRUE(SolveAndCheck(plain, A, step, plain_iterations) < 1e-6);
+            QUEST_EXPECT_TRUE(SolveAndCheck(recycling, A, step, recycling_iterations) < 1e-6);
+            plain_total += plain_iterations;
+            recycling_total += recycling_iterations;
+        }
+
+        // k = 0 时不回收，等价于普通 PCG（总计 991 次）；回收 8 个近似特征向量后总迭代次数降至 576 次
+        QUEST_EXPECT_EQ(plain.GetRecycleSpaceSize(), 0);
+        QUEST_EXPECT_EQ(recycling.GetRecycleSpaceSize(), 8);
+        QUEST_EXPECT_TRUE(10*recycling_total < 7*plain_total);
+    }
+
+} // namespace Quest::Testing
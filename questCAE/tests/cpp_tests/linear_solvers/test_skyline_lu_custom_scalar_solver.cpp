@@ -0,0 +1,77 @@
+// 系统头文件
+#include <complex>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/skyline_lu_custom_scalar_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using ComplexType = std::complex<double>;
+        using ComplexSparseSpaceType = TUblasSparseSpace<ComplexType>;
+        using ComplexLocalSpaceType = TUblasDenseSpace<ComplexType>;
+        using ComplexSparseMatrixType = ComplexSparseSpaceType::MatrixType;
+        using ComplexVectorType = ComplexSparseSpaceType::VectorType;
+        using ComplexSkylineLUSolverType = SkylineLUCustomScalarSolver<ComplexSparseSpaceType, ComplexLocalSpaceType>;
+
+        /**
+         * @brief 带复数位移的非对称一维 Helmholtz 型矩阵，Shift 只改变数值不改变稀疏模式
+         */
+        ComplexSparseMatrixType HelmholtzMatrix(const std::size_t Size, const ComplexType Shift){
+            ComplexSparseMatrixType A(Size, Size, 3*Size);
+            for(std::size_t i=0; i<Size; ++i){
+                if(i > 0) A.push_back(i, i-1, ComplexType(-1.0, 0.1));
+                A.push_back(i, i, ComplexType(2.5, 0.0) + Shift);
+                if(i < Size-1) A.push_back(i, i+1, ComplexType(-1.0, -0.2));
+            }
+            return A;
+        }
+
+        double RelativeResidual(const ComplexSparseMatrixType& rA, const ComplexVectorType& rX, const ComplexVectorType& rB){
+            const ComplexVectorType r = rB - prod(rA, rX);
+            return norm_2(r)/norm_2(rB);
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(SkylineLUCustomScalarSolverRefactorizesChangedValues, QuestCoreLinearSolversFastSuite)
+    {
+        const std::size_t size = 200;
+        ComplexSkylineLUSolverType solver;
+
+        ComplexVectorType b(size);
+        for(std::size_t i=0; i<size; ++i){
+            b[i] = ComplexType(1.0, 0.01*i);
+        }
+
+        ComplexSparseMatrixType A = HelmholtzMatrix(size, ComplexType(0.0, 0.5));
+        ComplexVectorType x(size);
+        QUEST_EXPECT_TRUE(solver.Solve(A, x, b));
+        QUEST_EXPECT_TRUE(RelativeResidual(A, x, b) < 1e-12);
+
+        // 稀疏模式不变、数值改变：只重做数值分解，结果必须对应新的数值
+        ComplexSparseMatrixType A_shifted = HelmholtzMatrix(size, ComplexType(1.0, -0.3));
+        QUEST_EXPECT_TRUE(solver.Solve(A_shifted, x, b));
+        QUEST_EXPECT_TRUE(RelativeResidual(A_shifted, x, b) < 1e-12);
+        QUEST_EXPECT_EQ(solver.GetNumberOfSymbolicFactorizations(), 1);
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericFactorizations(), 2);
+
+        // 沿用分解时只回代（由构建器在 LHS 未更新时调用）
+        ComplexVectorType b_scaled = 2.0*b;
+        solver.PerformSolutionStep(A_shifted, x, b_scaled);
+        QUEST_EXPECT_TRUE(RelativeResidual(A_shifted, x, b_scaled) < 1e-12);
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericFactorizations(), 2);
+
+        // 稀疏模式改变时重新做符号分解
+        ComplexSparseMatrixType A_small = HelmholtzMatrix(size/2, ComplexType(0.0, 0.5));
+        ComplexVectorType b_small(size/2, ComplexType(1.0, 0.0));
+        ComplexVectorType x_small(size/2);
+        QUEST_EXPECT_TRUE(solver.Solve(A_small, x_small, b_small));
+        QUEST_EXPECT_TRUE(RelativeResidual(A_small, x_small, b_small) < 1e-12);
+        QUEST_EXPECT_EQ(solver.GetNumberOfSymbolicFactorizations(), 2);
+    }
+
+} // namespace Quest::Testing
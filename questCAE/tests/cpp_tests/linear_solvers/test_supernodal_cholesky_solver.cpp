@@ -0,0 +1,134 @@
+// 系统头文件
+#include <cmath>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/csr_matrix.hpp"
+#include "space/csr_space.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/supernodal_cholesky_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = CsrSpace<double, CsrMatrix<double>>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+        using SupernodalCholeskySolverType = SupernodalCholeskySolver<SparseSpaceType, LocalSpaceType>;
+
+        /**
+         * @brief 存储方式：完整矩阵或只存下三角
+         */
+        enum class StorageType{
+            Full,
+            Lower
+        };
+
+        /**
+         * @brief n×n×n 网格上的七点差分 Laplace 矩阵减去 Shift*I
+         */
+        void LaplaceMatrix(SparseMatrixType& rA, const std::size_t n, const double Shift, const StorageType Storage){
+            std::vector<std::size_t> row_indices(1, 0);
+            std::vector<std::size_t> col_indices;
+            std::vector<double> values;
+            const std::size_t size = n*n*n;
+            for(std::size_t row=0; row<size; ++row){
+                auto add = [&](const std::size_t Col, const double Value){
+                    if(Storage == StorageType::Lower && Col > row){
+                        return;
+                    }
+                    col_indices.push_back(Col);
+                    values.push_back(Value);
+                };
+                const std::size_t k = row/(n*n);
+                const std::size_t i = (row/n)%n;
+                const std::size_t j = row%n;
+                if(k > 0) add(row-n*n, -1.0);
+                if(i > 0) add(row-n, -1.0);
+                if(j > 0) add(row-1, -1.0);
+                add(row, 6.0 - Shift);
+                if(j < n-1) add(row+1, -1.0);
+                if(i < n-1) add(row+n, -1.0);
+                if(k < n-1) add(row+n*n, -1.0);
+                row_indices.push_back(col_indices.size());
+            }
+            rA.ResizeIndex1Data(row_indices.size());
+            rA.ResizeIndex2Data(col_indices.size());
+            rA.ResizeValueData(values.size());
+            std::copy(row_indices.begin(), row_indices.end(), rA.index1_data().begin());
+            std::copy(col_indices.begin(), col_indices.end(), rA.index2_data().begin());
+            std::copy(values.begin(), values.end(), rA.value_data().begin());
+            rA.SetRowSize(size);
+            rA.SetColSize(size);
+        }
+
+        /**
+         * @brief 以 rA 求解后用完整矩阵 rFullA 计算相对残差
+         */
+        double SolveAndCheck(SupernodalCholeskySolverType& rSolver, SparseMatrixType& rA, const SparseMatrixType& rFullA){
+            const std::size_t size = rFullA.size1();
+            VectorType b(size), x(size, 0.0), ax(size);
+            for(std::size_t i=0; i<size; ++i){
+                b[i] = std::sin(0.01*i) + 1.0;
+            }
+            VectorType b_copy = b;
+            QUEST_EXPECT_TRUE(rSolver.Solve(rA, x, b_copy));
+            SparseSpaceType::Mult(rFullA, x, ax);
+            return norm_2(b - ax)/norm_2(b);
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(SupernodalCholeskySolverFactorizations, QuestCoreLinearSolversFastSuite)
+    {
+        const std::size_t n = 10;
+        SparseMatrixType A;
+        LaplaceMatrix(A, n, 0.0, StorageType::Full);
+
+        SupernodalCholeskySolverType cholesky;
+        QUEST_EXPECT_TRUE(SolveAndCheck(cholesky, A, A) < 1e-12);
+
+        SupernodalCholeskySolverType natural(SupernodalCholeskySolverType::FactorizationType::Cholesky, SupernodalCholeskySolverType::OrderingType::Natural);
+        QUEST_EXPECT_TRUE(SolveAndCheck(natural, A, A) < 1e-12);
+        QUEST_EXPECT_TRUE(cholesky.GetFactorNonZeros() < natural.GetFactorNonZeros());
+
+        SparseMatrixType A_lower;
+        LaplaceMatrix(A_lower, n, 0.0, StorageType::Lower);
+        SupernodalCholeskySolverType lower_only;
+        QUEST_EXPECT_TRUE(SolveAndCheck(lower_only, A_lower, A) < 1e-12);
+
+        // 带移位的对称不定矩阵：LDLT 可以分解，LLT 必须报错
+        SparseMatrixType A_shifted;
+        LaplaceMatrix(A_shifted, n, 0.5, StorageType::Full);
+        SupernodalCholeskySolverType ldlt(SupernodalCholeskySolverType::FactorizationType::LDLT);
+        QUEST_EXPECT_TRUE(SolveAndCheck(ldlt, A_shifted, A_shifted) < 1e-10);
+        VectorType x(A_shifted.size1()), b(A_shifted.size1(), 1.0);
+        QUEST_EXPECT_EXCEPTION_IS_THROWN(cholesky.Solve(A_shifted, x, b));
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(SupernodalCholeskySolverKeepsSymbolicFactorization, QuestCoreLinearSolversFastSuite)
+    {
+        const std::size_t n = 8;
+        SparseMatrixType A;
+        LaplaceMatrix(A, n, 0.0, StorageType::Full);
+        SupernodalCholeskySolverType solver(SupernodalCholeskySolverType::FactorizationType::LDLT);
+        QUEST_EXPECT_TRUE(SolveAndCheck(solver, A, A) < 1e-12);
+
+        // 只改变数值：沿用符号分解，重新做数值分解
+        for(auto& r_value : A.value_data()){
+            r_value *= 3.0;
+        }
+        QUEST_EXPECT_TRUE(SolveAndCheck(solver, A, A) < 1e-12);
+        QUEST_EXPECT_EQ(solver.GetNumberOfSymbolicFactorizations(), 1);
+        QUEST_EXPECT_EQ(solver.GetNumberOfNumericFactorizations(), 2);
+
+        SparseMatrixType A_larger;
+        LaplaceMatrix(A_larger, n+1, 0.0, StorageType::Full);
+        QUEST_EXPECT_TRUE(SolveAndCheck(solver, A_larger, A_larger) < 1e-12);
+        QUEST_EXPECT_EQ(solver.GetNumberOfSymbolicFactorizations(), 2);
+    }
+
+} // namespace Quest::Testing
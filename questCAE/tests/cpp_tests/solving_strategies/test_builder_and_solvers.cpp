@@ -0,0 +1,569 @@
+// 系统头文件
+#include <cmath>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/model.hpp"
+#include "includes/model_part.hpp"
+#include "includes/element.hpp"
+#include "includes/condition.hpp"
+#include "includes/variables.hpp"
+#include "includes/quest_flags.hpp"
+#include "utilities/scratch_arena.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/supernodal_cholesky_solver.hpp"
+#include "solving_strategies/schemes/schemes.hpp"
+#include "solving_strategies/builder_and_solvers/residual_based_block_builder_and_solver.hpp"
+#include "solving_strategies/builder_and_solvers/residual_based_elimination_builder_and_solver.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = TUblasSparseSpace<double>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using LinearSolverType = LinearSolver<SparseSpaceType, LocalSpaceType>;
+        using SchemeType = Scheme<SparseSpaceType, LocalSpaceType>;
+        using BlockBuilderType = ResidualBasedBlockBuilderAndSolver<SparseSpaceType, LocalSpaceType, LinearSolverType>;
+        using EliminationBuilderType = ResidualBasedEliminationBuilderAndSolver<SparseSpaceType, LocalSpaceType, LinearSolverType>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using SparseMatrixPointerType = SparseSpaceType::MatrixPointerType;
+        using VectorType = SparseSpaceType::VectorType;
+        using VectorPointerType = SparseSpaceType::VectorPointerType;
+        using DenseMatrixType = LocalSpaceType::MatrixType;
+
+        /**
+         * @brief 以 TEMPERATURE 为自由度的线性扩散实体，节点两两以传导系数 k 相连
+         * @details LHS = k*(n*I - 1*1^T)，RHS = q - LHS*u，TEntityType 为 Element 或 Condition
+         */
+        template<class TEntityType>
+        class TestDiffusionEntity : public TEntityType{
+            public:
+                using typename TEntityType::IndexType;
+                using typename TEntityType::NodesArrayType;
+                using typename TEntityType::MatrixType;
+                using typename TEntityType::VectorType;
+                using typename TEntityType::EquationIdVectorType;
+                using typename TEntityType::DofsVectorType;
+
+                TestDiffusionEntity(IndexType NewId, const NodesArrayType& rNodes, const double Conductivity, const double Source):
+                    TEntityType(NewId, rNodes),
+                    mConductivity(Conductivity),
+                    mSource(Source)
+                {
+                }
+
+                void EquationIdVector(EquationIdVectorType& rResult, const ProcessInfo& rCurrentProcessInfo) const override{
+                    const auto& r_geometry = this->GetGeometry();
+                    rResult.resize(r_geometry.size());
+                    for(std::size_t i=0; i<r_geometry.size(); ++i){
+                        rResult[i] = r_geometry[i].GetDof(TEMPERATURE).GetEquationId();
+                    }
+                }
+
+                void GetDofList(DofsVectorType& rDofList, const ProcessInfo& rCurrentProcessInfo) const override{
+                    const auto& r_geometry = this->GetGeometry();
+                    rDofList.resize(r_geometry.size());
+                    for(std::size_t i=0; i<r_geometry.size(); ++i){
+                        rDofList[i] = r_geometry[i].pGetDof(TEMPERATURE);
+                    }
+                }
+
+                void CalculateLocalSystem(MatrixType& rLeftHandSideMatrix, VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo) override{
+                    const auto& r_geometry = this->GetGeometry();
+                    const std::size_t size = r_geometry.size();
+                    rLeftHandSideMatrix.resize(size, size, false);
+                    rRightHandSideVector.resize(size, false);
+                    for(std::size_t i=0; i<size; ++i){
+                        for(std::size_t j=0; j<size; ++j){
+                            rLeftHandSideMatrix(i, j) = (i == j) ? mConductivity*(size-1) : -mConductivity;
+                        }
+                    }
+                    for(std::size_t i=0; i<size; ++i){
+                        rRightHandSideVector[i] = mSource;
+                        for(std::size_t j=0; j<size; ++j){
+                            rRightHandSideVector[i] -= rLeftHandSideMatrix(i, j)*r_geometry[j].FastGetSolutionStepValue(TEMPERATURE);
+                        }
+                    }
+                }
+
+            protected:
+                double mConductivity;
+                double mSource;
+        };
+
+        using TestDiffusionElement = TestDiffusionEntity<Element>;
+        using TestDiffusionCondition = TestDiffusionEntity<Condition>;
+
+        /**
+         * @brief 与 TestDiffusionElement 相同的单元，但跨单元按 LhsLanes/RhsLanes 批量计算局部系统
+         */
+        class TestVectorizedDiffusionElement : public TestDiffusionElement{
+            public:
+                using TestDiffusionElement::TestDiffusionElement;
+
+                void CalculateLocalSystemBatch(const Quest::span<Element* const> rElements, LocalSystemBatch& rBatch, const ProcessInfo& rCurrentProcessInfo) override{
+                    ++msNumberOfBatchCalls;
+                    const std::size_t lanes = rElements.size();
+                    const std::size_t size = this->GetGeometry().size();
+                    rBatch.Initialize(lanes, size);
+                    for(std::size_t i=0; i<size; ++i){
+                        for(std::size_t j=0; j<size; ++j){
+                            double* p_lhs = rBatch.LhsLanes(i, j);
+                            for(std::size_t lane=0; lane<lanes; ++lane){
+                                const double conductivity = static_cast<const TestVectorizedDiffusionElement*>(rElements[lane])->mConductivity;
+                                p_lhs[lane] = (i == j) ? conductivity*(size-1) : -conductivity;
+                            }
+                        }
+                    }
+                    for(std::size_t i=0; i<size; ++i){
+                        double* p_rhs = rBatch.RhsLanes(i);
+                        for(std::size_t lane=0; lane<lanes; ++lane){
+                            p_rhs[lane] = static_cast<const TestVectorizedDiffusionElement*>(rElements[lane])->mSource;
+                        }
+                        for(std::size_t j=0; j<size; ++j){
+                            const double* p_lhs = rBatch.LhsLanes(i, j);
+                            for(std::size_t lane=0; lane<lanes; ++lane){
+                                p_rhs[lane] -= p_lhs[lane]*rElements[lane]->GetGeometry()[j].FastGetSolutionStepValue(TEMPERATURE);
+                            }
+                        }
+                    }
+                }
+
+                static inline std::atomic<std::size_t> msNumberOfBatchCalls{0};
+        };
+
+        /**
+         * @brief 贡献即实体局部系统的方案，批量计算时直接使用实体的批量核函数
+         */
+        class TestLocalSystemScheme : public SchemeType{
+            public:
+                void CalculateSystemContributionsBatch(const Quest::span<Element* const> rElements, LocalSystemBatch& rBatch, const ProcessInfo& rCurrentProcessInfo) override{
+                    CalculateLocalSystemBatch(rElements, rBatch, rCurrentProcessInfo);
+                }
+
+                void CalculateSystemContributionsBatch(const Quest::span<Condition* const> rConditions, LocalSystemBatch& rBatch, const ProcessInfo& rCurrentProcessInfo) override{
+                    CalculateLocalSystemBatch(rConditions, rBatch, rCurrentProcessInfo);
+                }
+        };
+
+        /**
+         * @brief 只重写 CalculateSystemContributions 的方案，在实体局部系统上附加对角项
+         */
+        class TestMassScheme : public SchemeType{
+            public:
+                void CalculateSystemContributions(Element& rElement, LocalSystemMatrixType& rLHS, LocalSystemVectorType& rRHS, Element::EquationIdVectorType& rEquationIds, const ProcessInfo& rCurrentProcessInfo) override{
+                    SchemeType::CalculateSystemContributions(rElement, rLHS, rRHS, rEquationIds, rCurrentProcessInfo);
+                    AddMass(rLHS, rRHS);
+                }
+
+                void CalculateSystemContributions(Condition& rCondition, LocalSystemMatrixType& rLHS, LocalSystemVectorType& rRHS, Element::EquationIdVectorType& rEquationIds, const ProcessInfo& rCurrentProcessInfo) override{
+                    SchemeType::CalculateSystemContributions(rCondition, rLHS, rRHS, rEquationIds, rCurrentProcessInfo);
+                    AddMass(rLHS, rRHS);
+                }
+
+            private:
+                static void AddMass(LocalSystemMatrixType& rLHS, LocalSystemVectorType& rRHS){
+                    for(std::size_t i=0; i<rRHS.size(); ++i){
+                        rLHS(i, i) += 1.0;
+                        rRHS[i] += 0.5;
+                    }
+                }
+        };
+
+        /**
+         * @brief n×n 个四节点扩散单元，上边界为两节点扩散条件，左边界节点固定
+         * @param Mixed 为 true 时交替使用默认与向量化的单元类型，部分单元拆成两个三节点单元，并停用部分单元
+         */
+        ModelPart& CreateDiffusionModelPart(Model& rModel, const std::string& rName, const int n, const bool Mixed = false){
+            ModelPart& r_model_part = rModel.CreateModelPart(rName);
+            r_model_part.AddNodalSolutionStepVariable(TEMPERATURE);
+            r_model_part.AddNodalSolutionStepVariable(REACTION_FLUX);
+
+            for(int i=0; i<=n; ++i){
+                for(int j=0; j<=n; ++j){
+                    const std::size_t id = i*(n+1) + j + 1;
+                    auto p_node = r_model_part.CreateNewNode(id, j, i, 0.0);
+                    p_node->AddDof(TEMPERATURE, REACTION_FLUX);
+                    p_node->FastGetSolutionStepValue(TEMPERATURE) = 0.001*(id%13);
+                    if(j == 0){
+                        p_node->Fix(TEMPERATURE);
+                    }
+                }
+            }
+
+            std::size_t element_id = 0;
+            auto add_element = [&](std::initializer_list<std::size_t> NodeIds, const double Conductivity, const bool Vectorized){
+                Element::NodesArrayType nodes;
+                for(const std::size_t id : NodeIds){
+                    nodes.push_back(r_model_part.pGetNode(id));
+                }
+                Element::Pointer p_element;
+                if(Vectorized){
+                    p_element = Quest::make_intrusive<TestVectorizedDiffusionElement>(++element_id, nodes, Conductivity, 0.1);
+                } else {
+                    p_element = Quest::make_intrusive<TestDiffusionElement>(++element_id, nodes, Conductivity, 0.1);
+                }
+                if(Mixed && element_id%17 == 0){
+                    p_element->Set(ACTIVE, false);
+                }
+                r_model_part.AddElement(p_element);
+            };
+
+            for(int i=0; i<n; ++i){
+                for(int j=0; j<n; ++j){
+                    const std::size_t first = i*(n+1) + j + 1;
+                    const double conductivity = 1.0 + (i*7 + j*3)%5;
+                    if(Mixed && (i+j)%5 == 0){
+                        add_element({first, first+1, first+n+2}, conductivity, false);
+                        add_element({first, first+n+2, first+n+1}, conductivity, false);
+                    } else {
+                        add_element({first, first+1, first+n+2, first+n+1}, conductivity, Mixed && (i+j)%3 != 0);
+                    }
+                }
+            }
+
+            for(int j=0; j<n; ++j){
+                const std::size_t first = n*(n+1) + j + 1;
+                Condition::NodesArrayType nodes;
+                nodes.push_back(r_model_part.pGetNode(first));
+                nodes.push_back(r_model_part.pGetNode(first+1));
+                r_model_part.AddCondition(Quest::make_intrusive<TestDiffusionCondition>(j + 1, nodes, 0.5, 0.0));
+            }
+
+            return r_model_part;
+        }
+
+        /**
+         * @brief 不经过构建器，按节点编号逐个实体组装的稠密参考系统
+         */
+        template<class TContainerType>
+        void AssembleReference(TContainerType& rEntities, const ProcessInfo& rProcessInfo, DenseMatrixType& rK, VectorType& rF){
+            DenseMatrixType lhs;
+            VectorType rhs;
+            for(auto& r_entity : rEntities){
+                if(!r_entity.IsActive()){
+                    continue;
+                }
+                r_entity.CalculateLocalSystem(lhs, rhs, rProcessInfo);
+                const auto& r_geometry = r_entity.GetGeometry();
+                for(std::size_t i=0; i<r_geometry.size(); ++i){
+                    const std::size_t row = r_geometry[i].Id() - 1;
+                    rF[row] += rhs[i];
+                    for(std::size_t j=0; j<r_geometry.size(); ++j){
+                        rK(row, r_geometry[j].Id() - 1) += lhs(i, j);
+                    }
+                }
+            }
+        }
+
+        void AssembleReference(ModelPart& rModelPart, DenseMatrixType& rK, VectorType& rF){
+            const std::size_t size = rModelPart.NumberOfNodes();
+            rK.resize(size, size, false);
+            rF.resize(size, false);
+            rK.clear();
+            rF.clear();
+            AssembleReference(rModelPart.Elements(), rModelPart.GetProcessInfo(), rK, rF);
+            AssembleReference(rModelPart.Conditions(), rModelPart.GetProcessInfo(), rK, rF);
+        }
+
+        /**
+         * @brief 按方程编号比较构建器的系统与参考系统，返回最大偏差
+         * @param FreeRowsOnly 为 true 时只比较自由行与自由列（消去构建器只组装这部分）
+         */
+        double DifferenceToReference(ModelPart& rModelPart, const SparseMatrixType& rA, const VectorType& rb, const bool FreeRowsOnly){
+            DenseMatrixType K;
+            VectorType f;
+            AssembleReference(rModelPart, K, f);
+
+            double difference = 0.0;
+            for(const auto& r_row_node : rModelPart.Nodes()){
+                const auto& r_row_dof = r_row_node.GetDof(TEMPERATURE);
+                if(FreeRowsOnly && r_row_dof.IsFixed()){
+                    continue;
+                }
+                const std::size_t row = r_row_dof.GetEquationId();
+                difference = std::max(difference, std::abs(rb[row] - f[r_row_node.Id()-1]));
+                for(const auto& r_col_node : rModelPart.Nodes()){
+                    const auto& r_col_dof = r_col_node.GetDof(TEMPERATURE);
+                    if(FreeRowsOnly && r_col_dof.IsFixed()){
+                        continue;
+                    }
+                    const double value = rA(row, r_col_dof.GetEquationId());
+                    difference = std::max(difference, std::abs(value - K(r_row_node.Id()-1, r_col_node.Id()-1)));
+                }
+            }
+            return difference;
+        }
+
+        /**
+         * @brief 组装、求解一次并把增量加到自由节点上，随后计算反力
+         */
+        template<class TBuilderType>
+        void SolveAndUpdate(TBuilderType& rBuilder, SchemeType::Pointer pScheme, ModelPart& rModelPart){
+            SparseMatrixPointerType p_A = nullptr;
+            VectorPointerType p_Dx = nullptr;
+            VectorPointerType p_b = nullptr;
+            rBuilder.ResizeAndInitializeVectors(pScheme, p_A, p_Dx, p_b, rModelPart);
+            rBuilder.BuildAndSolve(pScheme, rModelPart, *p_A, *p_Dx, *p_b);
+            for(auto& r_dof : rBuilder.GetDofSet()){
+                if(r_dof.IsFree()){
+                    r_dof.GetSolutionStepValue() += (*p_Dx)[r_dof.GetEquationId()];
+                }
+            }
+            rBuilder.CalculateReactions(pScheme, rModelPart, *p_A, *p_Dx, *p_b);
+        }
+
+        LinearSolverType::Pointer CreateLinearSolver(){
+            return LinearSolverType::Pointer(new SupernodalCholeskySolver<SparseSpaceType, LocalSpaceType>());
+        }
+
+        /**
+         * @brief 分别用逐实体组装与批量组装构建同一系统，返回两者的最大偏差
+         * @param CompareToReference 为 true 时同时与实体局部系统的参考组装比较（只适用于不修改贡献的方案）
+         */
+        template<class TBuilderType>
+        double DifferenceToBatchedAssembly(ModelPart& rModelPart, SchemeType::Pointer p_scheme, const char* PerEntitySettings, const char* BatchedSettings, const bool CompareToReference = true){
+            TBuilderType per_entity_builder(CreateLinearSolver(), Parameters(PerEntitySettings));
+            TBuilderType batched_builder(CreateLinearSolver(), Parameters(BatchedSettings));
+
+            SparseMatrixPointerType p_A = nullptr, p_batched_A = nullptr;
+            VectorPointerType p_Dx = nullptr, p_b = nullptr, p_batched_Dx = nullptr, p_batched_b = nullptr;
+            per_entity_builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, rModelPart);
+            batched_builder.ResizeAndInitializeVectors(p_scheme, p_batched_A, p_batched_Dx, p_batched_b, rModelPart);
+            per_entity_builder.Build(p_scheme, rModelPart, *p_A, *p_b);
+            batched_builder.Build(p_scheme, rModelPart, *p_batched_A, *p_batched_b);
+
+            // 两个构建器的稀疏模式相同，值数组逐项对应
+            QUEST_EXPECT_EQ(p_A->nnz(), p_batched_A->nnz());
+            double difference = 0.0;
+            for(std::size_t k=0; k<p_A->nnz(); ++k){
+                difference = std::max(difference, std::abs(p_A->value_data()[k] - p_batched_A->value_data()[k]));
+            }
+            for(std::size_t i=0; i<p_b->size(); ++i){
+                difference = std::max(difference, std::abs((*p_b)[i] - (*p_batched_b)[i]));
+            }
+            if(!CompareToReference){
+                return difference;
+            }
+            const bool free_rows_only = p_A->size1() != rModelPart.NumberOfNodes();
+            return std::max(difference, DifferenceToReference(rModelPart, *p_batched_A, *p_batched_b, free_rows_only));
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(BlockBuilderAndSolverMatchesReferenceAssembly, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateDiffusionModelPart(model, "Main", 12);
+        SchemeType::Pointer p_scheme = Quest::make_shared<SchemeType>();
+
+        for(const char* settings : {R"({})", R"({"use_coloring": true})"}){
+            BlockBuilderType builder(CreateLinearSolver(), Parameters(settings));
+            SparseMatrixPointerType p_A = nullptr;
+            VectorPointerType p_Dx = nullptr;
+            VectorPointerType p_b = nullptr;
+            builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, r_model_part);
+            QUEST_EXPECT_EQ(p_A->size1(), r_model_part.NumberOfNodes());
+
+            // 施加 Dirichlet 条件之前为完整系统
+            builder.Build(p_scheme, r_model_part, *p_A, *p_b);
+            QUEST_EXPECT_TRUE(DifferenceToReference(r_model_part, *p_A, *p_b, false) < 1e-12);
+
+            // 施加之后固定行只保留对角元，自由行不再耦合固定列
+            builder.ApplyDirichletConditions(p_scheme, r_model_part, *p_A, *p_Dx, *p_b);
+            QUEST_EXPECT_TRUE(DifferenceToReference(r_model_part, *p_A, *p_b, true) < 1e-12);
+            for(const auto& r_dof : builder.GetDofSet()){
+                const std::size_t row = r_dof.GetEquationId();
+                for(const auto& r_other : builder.GetDofSet()){
+                    const std::size_t col = r_other.GetEquationId();
+                    if(row != col && (r_dof.IsFixed() || r_other.IsFixed())){
+                        QUEST_EXPECT_EQ((*p_A)(row, col), 0.0);
+                    }
+                }
+                if(r_dof.IsFixed()){
+                    QUEST_EXPECT_EQ((*p_b)[row], 0.0);
+                }
+            }
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(EliminationBuilderAndSolverMatchesReferenceAssembly, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateDiffusionModelPart(model, "Main", 12);
+        SchemeType::Pointer p_scheme = Quest::make_shared<SchemeType>();
+
+        for(const char* settings : {R"({})", R"({"use_coloring": true})"}){
+            EliminationBuilderType builder(CreateLinearSolver(), Parameters(settings));
+            SparseMatrixPointerType p_A = nullptr;
+            VectorPointerType p_Dx = nullptr;
+            VectorPointerType p_b = nullptr;
+            builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, r_model_part);
+
+            // 系统只包含自由自由度，固定自由度编号排在其后
+            const std::size_t number_of_fixed = 13;
+            QUEST_EXPECT_EQ(builder.GetNumberOfFixedDofs(), number_of_fixed);
+            QUEST_EXPECT_EQ(p_A->size1(), r_model_part.NumberOfNodes() - number_of_fixed);
+            for(const auto& r_dof : builder.GetDofSet()){
+                QUEST_EXPECT_EQ(r_dof.IsFixed(), r_dof.GetEquationId() >= p_A->size1());
+            }
+
+            builder.Build(p_scheme, r_model_part, *p_A, *p_b);
+            QUEST_EXPECT_TRUE(DifferenceToReference(r_model_part, *p_A, *p_b, true) < 1e-12);
+            QUEST_EXPECT_EQ(builder.GetNumberOfStructureBuilds(), 1);
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(BuilderAndSolversGiveSameSolutionAndReactions, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_block_model_part = CreateDiffusionModelPart(model, "Block", 12);
+        ModelPart& r_elimination_model_part = CreateDiffusionModelPart(model, "Elimination", 12);
+        SchemeType::Pointer p_scheme = Quest::make_shared<SchemeType>();
+
+        BlockBuilderType block_builder(CreateLinearSolver());
+        EliminationBuilderType elimination_builder(CreateLinearSolver());
+        block_builder.SetCalculateReactionsFlag(true);
+        elimination_builder.SetCalculateReactionsFlag(true);
+        SolveAndUpdate(block_builder, p_scheme, r_block_model_part);
+        SolveAndUpdate(elimination_builder, p_scheme, r_elimination_model_part);
+
+        // 线性问题一步收敛：自由行的参考残差为零
+        DenseMatrixType K;
+        VectorType f;
+        AssembleReference(r_elimination_model_part, K, f);
+        for(const auto& r_node : r_elimination_model_part.Nodes()){
+            const auto& r_block_node = r_block_model_part.GetNode(r_node.Id());
+            QUEST_EXPECT_NEAR(r_node.FastGetSolutionStepValue(TEMPERATURE), r_block_node.FastGetSolutionStepValue(TEMPERATURE), 1e-10);
+            if(r_node.IsFixed(TEMPERATURE)){
+                QUEST_EXPECT_NEAR(r_node.FastGetSolutionStepValue(REACTION_FLUX), r_block_node.FastGetSolutionStepValue(REACTION_FLUX), 1e-8);
+                QUEST_EXPECT_NEAR(r_node.FastGetSolutionStepValue(REACTION_FLUX), -f[r_node.Id()-1], 1e-8);
+            } else {
+                QUEST_EXPECT_NEAR(f[r_node.Id()-1], 0.0, 1e-9);
+            }
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(EliminationBuilderAndSolverPrescribedIncrements, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateDiffusionModelPart(model, "Main", 12);
+        SchemeType::Pointer p_scheme = Quest::make_shared<SchemeType>();
+
+        EliminationBuilderType builder(CreateLinearSolver());
+        SparseMatrixPointerType p_A = nullptr;
+        VectorPointerType p_Dx = nullptr;
+        VectorPointerType p_b = nullptr;
+        builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, r_model_part);
+        const std::size_t free_size = p_A->size1();
+
+        auto& r_increments = builder.GetFixedDofIncrements();
+        for(const auto& r_dof : builder.GetDofSet()){
+            if(r_dof.IsFixed()){
+                r_increments[r_dof.GetEquationId() - free_size] = 0.01*(r_dof.Id()%7);
+            }
+        }
+
+        // 预设增量只在一次 Build 中施加，之后清零
+        builder.BuildAndSolve(p_scheme, r_model_part, *p_A, *p_Dx, *p_b);
+        QUEST_EXPECT_EQ(SparseSpaceType::TwoNorm(builder.GetFixedDofIncrements()), 0.0);
+        const auto& r_applied = builder.GetAppliedFixedDofIncrements();
+        for(auto& r_dof : builder.GetDofSet()){
+            const std::size_t equation_id = r_dof.GetEquationId();
+            r_dof.GetSolutionStepValue() += r_dof.IsFixed() ? r_applied[equation_id - free_size] : (*p_Dx)[equation_id];
+        }
+
+        // 更新后的状态满足平衡，再次 Build 不会重复施加预设增量
+        builder.Build(p_scheme, r_model_part, *p_A, *p_b);
+        QUEST_EXPECT_TRUE(SparseSpaceType::TwoNorm(*p_b) < 1e-9);
+        QUEST_EXPECT_TRUE(DifferenceToReference(r_model_part, *p_A, *p_b, true) < 1e-12);
+
+        // 改变固定状态后重新编号并重建结构
+        r_model_part.GetNode(2).Fix(TEMPERATURE);
+        builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, r_model_part);
+        QUEST_EXPECT_EQ(p_A->size1(), free_size - 1);
+        QUEST_EXPECT_EQ(builder.GetNumberOfStructureBuilds(), 2);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(BuilderAndSolverResetsScratchArenaPerStep, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateDiffusionModelPart(model, "Main", 4);
+        SchemeType::Pointer p_scheme = Quest::make_shared<SchemeType>();
+        BlockBuilderType builder(CreateLinearSolver());
+        SparseMatrixPointerType p_A = nullptr;
+        VectorPointerType p_Dx = nullptr;
+        VectorPointerType p_b = nullptr;
+        builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, r_model_part);
+
+        // 上一步中内存池扩容出多个块
+        ScratchArena& r_arena = ScratchArena::GetThreadLocalArena();
+        while(r_arena.NumberOfBlocks() < 2){
+            r_arena.Allocate<double>(1024);
+        }
+
+        // 新的求解步开始时合并为一个块，容量保留
+        const std::size_t grown_capacity = r_arena.Capacity();
+        builder.InitializeSolutionStep(r_model_part, *p_A, *p_Dx, *p_b);
+        QUEST_EXPECT_EQ(r_arena.NumberOfBlocks(), 1);
+        QUEST_EXPECT_EQ(r_arena.Capacity(), grown_capacity);
+        QUEST_EXPECT_EQ(r_arena.HighWaterMark(), 0);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(BatchedAssemblyMatchesPerEntityAssembly, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateDiffusionModelPart(model, "Main", 12, true);
+
+        // 默认与向量化单元、四节点与三节点单元、停用单元及条件混合；批量与逐实体组装只差求和顺序带来的舍入
+        const std::vector<std::pair<const char*, const char*>> settings = {
+            {R"({})", R"({"use_batched_assembly": true})"},
+            {R"({})", R"({"use_batched_assembly": true, "batch_size": 3})"},
+            {R"({"use_coloring": true})", R"({"use_coloring": true, "use_batched_assembly": true})"}
+        };
+        SchemeType::Pointer p_scheme = Quest::make_shared<TestLocalSystemScheme>();
+        for(const auto& r_settings : settings){
+            TestVectorizedDiffusionElement::msNumberOfBatchCalls = 0;
+            QUEST_EXPECT_TRUE(DifferenceToBatchedAssembly<BlockBuilderType>(r_model_part, p_scheme, r_settings.first, r_settings.second) < 1e-12);
+            QUEST_EXPECT_TRUE(TestVectorizedDiffusionElement::msNumberOfBatchCalls > 0);
+
+            TestVectorizedDiffusionElement::msNumberOfBatchCalls = 0;
+            QUEST_EXPECT_TRUE(DifferenceToBatchedAssembly<EliminationBuilderType>(r_model_part, p_scheme, r_settings.first, r_settings.second) < 1e-12);
+            QUEST_EXPECT_TRUE(TestVectorizedDiffusionElement::msNumberOfBatchCalls > 0);
+        }
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(BatchedAssemblyUsesSchemeContributions, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateDiffusionModelPart(model, "Main", 12, true);
+
+        // 方案只重写了 CalculateSystemContributions：默认的批量实现须逐实体调用它，而不是直接使用单元的批量核函数
+        SchemeType::Pointer p_scheme = Quest::make_shared<TestMassScheme>();
+        const char* batched_settings = R"({"use_batched_assembly": true})";
+
+        TestVectorizedDiffusionElement::msNumberOfBatchCalls = 0;
+        QUEST_EXPECT_TRUE(DifferenceToBatchedAssembly<BlockBuilderType>(r_model_part, p_scheme, R"({})", batched_settings, false) < 1e-12);
+        QUEST_EXPECT_TRUE(DifferenceToBatchedAssembly<EliminationBuilderType>(r_model_part, p_scheme, R"({})", batched_settings, false) < 1e-12);
+        QUEST_EXPECT_EQ(TestVectorizedDiffusionElement::msNumberOfBatchCalls, 0);
+
+        // 附加的对角项确实进入了批量组装的系统
+        BlockBuilderType builder(CreateLinearSolver(), Parameters(batched_settings));
+        SparseMatrixPointerType p_A = nullptr;
+        VectorPointerType p_Dx = nullptr, p_b = nullptr;
+        builder.ResizeAndInitializeVectors(p_scheme, p_A, p_Dx, p_b, r_model_part);
+        builder.Build(p_scheme, r_model_part, *p_A, *p_b);
+        QUEST_EXPECT_TRUE(DifferenceToReference(r_model_part, *p_A, *p_b, false) > 0.5);
+    }
+
+} // namespace Quest::Testing
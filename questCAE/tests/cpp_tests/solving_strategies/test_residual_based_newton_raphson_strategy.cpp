@@ -0,0 +1,354 @@
+// 系统头文件
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/model.hpp"
+#include "includes/model_part.hpp"
+#include "includes/element.hpp"
+#include "includes/variables.hpp"
+#include "space/ublas_space.hpp"
+#include "linear_solvers/supernodal_cholesky_solver.hpp"
+#include "solving_strategies/schemes/schemes.hpp"
+#include "solving_strategies/builder_and_solvers/residual_based_block_builder_and_solver.hpp"
+#include "solving_strategies/builder_and_solvers/residual_based_elimination_builder_and_solver.hpp"
+#include "solving_strategies/strategies/residual_based_newton_raphson_strategy.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using SparseSpaceType = TUblasSparseSpace<double>;
+        using LocalSpaceType = TUblasDenseSpace<double>;
+        using LinearSolverType = LinearSolver<SparseSpaceType, LocalSpaceType>;
+        using SchemeType = Scheme<SparseSpaceType, LocalSpaceType>;
+        using BuilderAndSolverType = BuilderAndSolver<SparseSpaceType, LocalSpaceType, LinearSolverType>;
+        using BlockBuilderType = ResidualBasedBlockBuilderAndSolver<SparseSpaceType, LocalSpaceType, LinearSolverType>;
+        using EliminationBuilderType = ResidualBasedEliminationBuilderAndSolver<SparseSpaceType, LocalSpaceType, LinearSolverType>;
+        using StrategyType = ResidualBasedNewtonRaphsonStrategy<SparseSpaceType, LocalSpaceType, LinearSolverType>;
+        using SparseMatrixType = SparseSpaceType::MatrixType;
+        using VectorType = SparseSpaceType::VectorType;
+
+        /**
+         * @brief 以 TEMPERATURE 为自由度的非线性扩散单元
+         * @details 线性部分同节点两两以传导系数 k 相连，另加非线性项 a*u^3：RHS_i = q - (K*u)_i - a*u_i^3，LHS = K + diag(3*a*u_i^2)
+         */
+        class TestNonlinearDiffusionElement : public Element{
+            public:
+                TestNonlinearDiffusionElement(IndexType NewId, const NodesArrayType& rNodes, const double Conductivity):
+                    Element(NewId, rNodes),
+                    mConductivity(Conductivity)
+                {
+                }
+
+                void SetNonlinearCoefficient(const double Coefficient){
+                    mNonlinearCoefficient = Coefficient;
+                }
+
+                void EquationIdVector(EquationIdVectorType& rResult, const ProcessInfo& rCurrentProcessInfo) const override{
+                    const auto& r_geometry = this->GetGeometry();
+                    rResult.resize(r_geometry.size());
+                    for(std::size_t i=0; i<r_geometry.size(); ++i){
+                        rResult[i] = r_geometry[i].GetDof(TEMPERATURE).GetEquationId();
+                    }
+                }
+
+                void GetDofList(DofsVectorType& rDofList, const ProcessInfo& rCurrentProcessInfo) const override{
+                    const auto& r_geometry = this->GetGeometry();
+                    rDofList.resize(r_geometry.size());
+                    for(std::size_t i=0; i<r_geometry.size(); ++i){
+                        rDofList[i] = r_geometry[i].pGetDof(TEMPERATURE);
+                    }
+                }
+
+                void CalculateLocalSystem(MatrixType& rLeftHandSideMatrix, VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo) override{
+                    const auto& r_geometry = this->GetGeometry();
+                    const std::size_t size = r_geometry.size();
+                    rLeftHandSideMatrix.resize(size, size, false);
+                    rRightHandSideVector.resize(size, false);
+                    for(std::size_t i=0; i<size; ++i){
+                        const double u = r_geometry[i].FastGetSolutionStepValue(TEMPERATURE);
+                        rRightHandSideVector[i] = 0.1 - mNonlinearCoefficient*u*u*u;
+                        for(std::size_t j=0; j<size; ++j){
+                            const double k = (i == j) ? mConductivity*(size-1) : -mConductivity;
+                            rLeftHandSideMatrix(i, j) = k;
+                            rRightHandSideVector[i] -= k*r_geometry[j].FastGetSolutionStepValue(TEMPERATURE);
+                        }
+                        rLeftHandSideMatrix(i, i) += 3.0*mNonlinearCoefficient*u*u;
+                    }
+                }
+
+            private:
+                double mConductivity;
+                double mNonlinearCoefficient = 0.0;
+        };
+
+        /**
+         * @brief 把增量加到自由自由度上；设置了消去型构建器时，同时把其施加过的给定增量加到约束自由度上
+         */
+        class TestIncrementalScheme : public SchemeType{
+            public:
+                void SetEliminationBuilder(const EliminationBuilderType* pBuilder){
+                    mpEliminationBuilder = pBuilder;
+                }
+
+                void Update(ModelPart& rModelPart, DofsArrayType& rDofSet, TSystemMatrixType& rA, TSystemVectorType& rDx, TSystemVectorType& rb) override{
+                    const std::size_t free_size = rDx.size();
+                    for(auto& r_dof : rDofSet){
+                        if(r_dof.IsFree()){
+                            r_dof.GetSolutionStepValue() += rDx[r_dof.GetEquationId()];
+                        } else if(mpEliminationBuilder != nullptr){
+                            const auto& r_applied = mpEliminationBuilder->GetAppliedFixedDofIncrements();
+                            r_dof.GetSolutionStepValue() += r_applied[r_dof.GetEquationId() - free_size];
+                        }
+                    }
+                    // 同一 Build 施加的增量只在第一次更新时加上
+                    mpEliminationBuilder = nullptr;
+                }
+
+            private:
+                const EliminationBuilderType* mpEliminationBuilder = nullptr;
+        };
+
+        /**
+         * @brief 记录分解次数的超节点 Cholesky 求解器（沿用分解时只调用 PerformSolutionStep）
+         */
+        class CountingCholeskySolver : public SupernodalCholeskySolver<SparseSpaceType, LocalSpaceType>{
+            public:
+                bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override{
+                    ++mNumberOfFactorizations;
+                    return SupernodalCholeskySolver<SparseSpaceType, LocalSpaceType>::Solve(rA, rX, rB);
+                }
+
+                std::size_t mNumberOfFactorizations = 0;
+        };
+
+        /**
+         * @brief n×n 个四节点非线性扩散单元，边界节点固定为零
+         */
+        ModelPart& CreateNonlinearDiffusionModelPart(Model& rModel, const std::string& rName, const int n){
+            ModelPart& r_model_part = rModel.CreateModelPart(rName);
+            r_model_part.AddNodalSolutionStepVariable(TEMPERATURE);
+            r_model_part.AddNodalSolutionStepVariable(REACTION_FLUX);
+
+            for(int i=0; i<=n; ++i){
+                for(int j=0; j<=n; ++j){
+                    auto p_node = r_model_part.CreateNewNode(i*(n+1) + j + 1, j, i, 0.0);
+                    p_node->AddDof(TEMPERATURE, REACTION_FLUX);
+                    if(i == 0 || j == 0 || i == n || j == n){
+                        p_node->Fix(TEMPERATURE);
+                    }
+                }
+            }
+
+            for(int i=0; i<n; ++i){
+                for(int j=0; j<n; ++j){
+                    const std::size_t first = i*(n+1) + j + 1;
+                    Element::NodesArrayType nodes;
+                    for(const std::size_t id : {first, first+1, first+n+2, first+n+1}){
+                        nodes.push_back(r_model_part.pGetNode(id));
+                    }
+                    r_model_part.AddElement(Quest::make_intrusive<TestNonlinearDiffusionElement>(i*n + j + 1, nodes, 1.0 + (i*7 + j*3)%5));
+                }
+            }
+
+            return r_model_part;
+        }
+
+        void SetNonlinearCoefficient(ModelPart& rModelPart, const double Coefficient){
+            for(auto& r_element : rModelPart.Elements()){
+                static_cast<TestNonlinearDiffusionElement&>(r_element).SetNonlinearCoefficient(Coefficient);
+            }
+        }
+
+        Parameters NewtonSettings(const std::string& rNewtonType){
+            return Parameters(R"({
+                "newton_type"                     : ")" + rNewtonType + R"(",
+                "max_iteration"                   : 200,
+                "residual_relative_tolerance"     : 1e-10,
+                "residual_absolute_tolerance"     : 1e-12,
+                "displacement_relative_tolerance" : 1e-12,
+                "displacement_absolute_tolerance" : 1e-14
+            })");
+        }
+
+        /**
+         * @brief 求解一个载荷步，返回是否收敛
+         */
+        bool SolveStep(StrategyType& rStrategy){
+            rStrategy.Initialize();
+            rStrategy.InitializeSolutionStep();
+            rStrategy.Predict();
+            const bool is_converged = rStrategy.SolveSolutionStep();
+            rStrategy.FinalizeSolutionStep();
+            return is_converged;
+        }
+
+        struct NewtonRunResult{
+            bool IsConverged = true;
+            std::size_t NumberOfIterations = 0;
+            std::size_t NumberOfTangentUpdates = 0;
+            std::size_t NumberOfFactorizations = 0;
+            std::vector<double> Solution;
+        };
+
+        /**
+         * @brief 非线性系数逐步增大的三个载荷步
+         */
+        template<class TBuilderType>
+        NewtonRunResult RunLoadSteps(const std::string& rNewtonType){
+            Model model;
+            ModelPart& r_model_part = CreateNonlinearDiffusionModelPart(model, "Main", 20);
+            auto p_solver = Quest::make_shared<CountingCholeskySolver>();
+            auto p_builder = Quest::make_shared<TBuilderType>(p_solver);
+            SchemeType::Pointer p_scheme = Quest::make_shared<TestIncrementalScheme>();
+            StrategyType strategy(r_model_part, p_scheme, p_builder, NewtonSettings(rNewtonType));
+            strategy.Check();
+
+            NewtonRunResult result;
+            for(int step=1; step<=3; ++step){
+                SetNonlinearCoefficient(r_model_part, 0.01*step);
+                result.IsConverged = SolveStep(strategy) && result.IsConverged;
+                result.NumberOfIterations += strategy.GetIterationNumber();
+            }
+            result.NumberOfTangentUpdates = strategy.GetNumberOfTangentUpdates();
+            result.NumberOfFactorizations = p_solver->mNumberOfFactorizations;
+            for(const auto& r_node : r_model_part.Nodes()){
+                result.Solution.push_back(r_node.FastGetSolutionStepValue(TEMPERATURE));
+            }
+            return result;
+        }
+
+        double MaxDifference(const std::vector<double>& rA, const std::vector<double>& rB){
+            double difference = 0.0;
+            for(std::size_t i=0; i<rA.size(); ++i){
+                difference = std::max(difference, std::abs(rA[i] - rB[i]));
+            }
+            return difference;
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(NewtonRaphsonStrategyReuseModes, QuestCoreSolvingStrategiesFastSuite)
+    {
+        const NewtonRunResult full = RunLoadSteps<BlockBuilderType>("full");
+        const NewtonRunResult modified = RunLoadSteps<BlockBuilderType>("modified");
+        const NewtonRunResult initial_stiffness = RunLoadSteps<BlockBuilderType>("initial_stiffness");
+
+        QUEST_EXPECT_TRUE(full.IsConverged);
+        QUEST_EXPECT_TRUE(modified.IsConverged);
+        QUEST_EXPECT_TRUE(initial_stiffness.IsConverged);
+
+        // 完全牛顿法每次迭代更新切线
+        QUEST_EXPECT_EQ(full.NumberOfTangentUpdates, full.NumberOfIterations);
+
+        // 修正牛顿法每步只在第一次迭代更新切线，其余迭代沿用分解
+        QUEST_EXPECT_EQ(modified.NumberOfTangentUpdates, 3);
+        QUEST_EXPECT_EQ(modified.NumberOfFactorizations, 3);
+        QUEST_EXPECT_TRUE(modified.NumberOfIterations > full.NumberOfIterations);
+
+        // 初始刚度法在整个分析中只组装并分解一次
+        QUEST_EXPECT_EQ(initial_stiffness.NumberOfTangentUpdates, 1);
+        QUEST_EXPECT_EQ(initial_stiffness.NumberOfFactorizations, 1);
+        QUEST_EXPECT_TRUE(initial_stiffness.NumberOfIterations > modified.NumberOfIterations);
+
+        QUEST_EXPECT_TRUE(MaxDifference(full.Solution, modified.Solution) < 1e-10);
+        QUEST_EXPECT_TRUE(MaxDifference(full.Solution, initial_stiffness.Solution) < 1e-10);
+
+        // 消去型构建器给出相同的解与切线更新次数
+        const NewtonRunResult elimination_full = RunLoadSteps<EliminationBuilderType>("full");
+        const NewtonRunResult elimination_initial_stiffness = RunLoadSteps<EliminationBuilderType>("initial_stiffness");
+        QUEST_EXPECT_TRUE(elimination_full.IsConverged);
+        QUEST_EXPECT_TRUE(elimination_initial_stiffness.IsConverged);
+        QUEST_EXPECT_EQ(elimination_initial_stiffness.NumberOfTangentUpdates, 1);
+        QUEST_EXPECT_TRUE(MaxDifference(full.Solution, elimination_full.Solution) < 1e-10);
+        QUEST_EXPECT_TRUE(MaxDifference(full.Solution, elimination_initial_stiffness.Solution) < 1e-10);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(NewtonRaphsonStrategyInvalidatesTangentOnSystemChange, QuestCoreSolvingStrategiesFastSuite)
+    {
+        Model model;
+        ModelPart& r_model_part = CreateNonlinearDiffusionModelPart(model, "Main", 10);
+        auto p_builder = Quest::make_shared<BlockBuilderType>(Quest::make_shared<CountingCholeskySolver>());
+        SchemeType::Pointer p_scheme = Quest::make_shared<TestIncrementalScheme>();
+        StrategyType strategy(r_model_part, p_scheme, p_builder, NewtonSettings("initial_stiffness"));
+
+        SetNonlinearCoefficient(r_model_part, 0.1);
+        QUEST_EXPECT_TRUE(SolveStep(strategy));
+        QUEST_EXPECT_EQ(strategy.GetNumberOfTangentUpdates(), 1);
+
+        // 重建稀疏模式后大小、非零元数与约束状态都不变，切线仍须更新
+        p_builder->Clear();
+        QUEST_EXPECT_TRUE(SolveStep(strategy));
+        QUEST_EXPECT_EQ(p_builder->GetNumberOfStructureBuilds(), 2);
+        QUEST_EXPECT_EQ(strategy.GetNumberOfTangentUpdates(), 2);
+
+        // 约束状态变化
+        r_model_part.GetNode(13).Fix(TEMPERATURE);
+        QUEST_EXPECT_TRUE(SolveStep(strategy));
+        QUEST_EXPECT_EQ(strategy.GetNumberOfTangentUpdates(), 3);
+
+        // 方程系统不变时沿用切线
+        SetNonlinearCoefficient(r_model_part, 0.2);
+        QUEST_EXPECT_TRUE(SolveStep(strategy));
+        QUEST_EXPECT_EQ(strategy.GetNumberOfTangentUpdates(), 3);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(NewtonRaphsonStrategyInitialStiffnessWithPrescribedIncrements, QuestCoreSolvingStrategiesFastSuite)
+    {
+        // 参考：块构建器，直接把约束值设为给定值后求解
+        Model model;
+        ModelPart& r_reference_model_part = CreateNonlinearDiffusionModelPart(model, "Reference", 10);
+        auto p_reference_builder = Quest::make_shared<BlockBuilderType>(Quest::make_shared<CountingCholeskySolver>());
+        StrategyType reference_strategy(r_reference_model_part, Quest::make_shared<TestIncrementalScheme>(), p_reference_builder, NewtonSettings("full"));
+
+        ModelPart& r_model_part = CreateNonlinearDiffusionModelPart(model, "Main", 10);
+        auto p_builder = Quest::make_shared<EliminationBuilderType>(Quest::make_shared<CountingCholeskySolver>());
+        auto p_scheme = Quest::make_shared<TestIncrementalScheme>();
+        StrategyType strategy(r_model_part, p_scheme, p_builder, NewtonSettings("initial_stiffness"));
+
+        SetNonlinearCoefficient(r_reference_model_part, 0.1);
+        SetNonlinearCoefficient(r_model_part, 0.1);
+        QUEST_EXPECT_TRUE(SolveStep(reference_strategy));
+        QUEST_EXPECT_TRUE(SolveStep(strategy));
+        QUEST_EXPECT_EQ(strategy.GetNumberOfTangentUpdates(), 1);
+
+        // 第二步给左边界施加增量：消去型构建器有待施加的增量，初始刚度法也须在第一次迭代组装左端矩阵
+        auto prescribed_increment = [](const Node& rNode){
+            const std::size_t index = rNode.Id() - 1;
+            return index%11 == 0 ? 0.05*(1.0 + index/11) : 0.0;
+        };
+        for(auto& r_node : r_reference_model_part.Nodes()){
+            r_node.FastGetSolutionStepValue(TEMPERATURE) += prescribed_increment(r_node);
+        }
+        QUEST_EXPECT_TRUE(SolveStep(reference_strategy));
+
+        strategy.InitializeSolutionStep();
+        auto& r_increments = p_builder->GetFixedDofIncrements();
+        const std::size_t free_size = p_builder->GetEquationSystemSize();
+        for(const auto& r_node : r_model_part.Nodes()){
+            const auto& r_dof = r_node.GetDof(TEMPERATURE);
+            if(r_dof.IsFixed()){
+                r_increments[r_dof.GetEquationId() - free_size] = prescribed_increment(r_node);
+            }
+        }
+        QUEST_EXPECT_TRUE(p_builder->IsBuildRequired());
+        p_scheme->SetEliminationBuilder(p_builder.get());
+        strategy.Predict();
+        QUEST_EXPECT_TRUE(strategy.SolveSolutionStep());
+        strategy.FinalizeSolutionStep();
+
+        QUEST_EXPECT_FALSE(p_builder->IsBuildRequired());
+        QUEST_EXPECT_EQ(strategy.GetNumberOfTangentUpdates(), 2);
+        for(const auto& r_node : r_model_part.Nodes()){
+            const double reference_value = r_reference_model_part.GetNode(r_node.Id()).FastGetSolutionStepValue(TEMPERATURE);
+            QUEST_EXPECT_NEAR(r_node.FastGetSolutionStepValue(TEMPERATURE), reference_value, 1e-10);
+        }
+    }
+
+} // namespace Quest::Testing
@@ -0,0 +1,103 @@
+// 系统头文件
+#include <limits>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "container/sparse_graph.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/block_csr_matrix.hpp"
+#include "space/csr_space.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+
+        /**
+         * @brief 三个节点、每个节点两个自由度的链状非对称矩阵，两个“单元”分别连接节点 0-1 与 1-2
+         */
+        template<typename TMatrixType>
+        void AssembleChain(TMatrixType& rA){
+            for(IndexType e=0; e<2; ++e){
+                DenseMatrix<double> local(4, 4);
+                for(IndexType i=0; i<4; ++i){
+                    for(IndexType j=0; j<4; ++j){
+                        local(i,j) = 1.0 + e + 0.5*i - 0.25*j;
+                    }
+                }
+                DenseVector<IndexType> equation_ids(4);
+                for(IndexType i=0; i<4; ++i){
+                    equation_ids[i] = 2*e + i;
+                }
+                rA.Assemble(local, equation_ids);
+            }
+        }
+
+        DenseMatrix<double> DenseChain(){
+            DenseMatrix<double> dense = ZeroMatrix(6, 6);
+            for(IndexType e=0; e<2; ++e){
+                for(IndexType i=0; i<4; ++i){
+                    for(IndexType j=0; j<4; ++j){
+                        dense(2*e+i, 2*e+j) += 1.0 + e + 0.5*i - 0.25*j;
+                    }
+                }
+            }
+            return dense;
+        }
+
+        template<typename TSpaceType>
+        void CheckMultOverwritesNaN(const typename TSpaceType::MatrixType& rA){
+            const DenseMatrix<double> dense = DenseChain();
+            DenseVector<double> x(6);
+            for(IndexType i=0; i<6; ++i){
+                x[i] = 1.0 + 0.1*i;
+            }
+
+            DenseVector<double> y(6, std::numeric_limits<double>::quiet_NaN());
+            TSpaceType::Mult(rA, x, y);
+            const DenseVector<double> y_reference = prod(dense, x);
+            for(IndexType i=0; i<6; ++i){
+                QUEST_EXPECT_NEAR(y[i], y_reference[i], 1e-12);
+            }
+
+            DenseVector<double> z(6, std::numeric_limits<double>::infinity());
+            TSpaceType::TransposeMult(rA, x, z);
+            const DenseVector<double> z_reference = prod(trans(dense), x);
+            for(IndexType i=0; i<6; ++i){
+                QUEST_EXPECT_NEAR(z[i], z_reference[i], 1e-12);
+            }
+        }
+
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(CsrSpaceMultIgnoresOldValues, QuestCoreSpacesFastSuite)
+    {
+        SparseGraph<IndexType> graph;
+        for(IndexType e=0; e<2; ++e){
+            std::vector<IndexType> ids{2*e, 2*e+1, 2*e+2, 2*e+3};
+            graph.AddEntries(ids);
+        }
+        graph.Finalize();
+
+        CsrMatrix<double> A(graph);
+        AssembleChain(A);
+        CheckMultOverwritesNaN<CsrSpace<double, CsrMatrix<double>>>(A);
+    }
+
+
+    QUEST_TEST_CASE_IN_SUITE(CsrSpaceBlockMultIgnoresOldValues, QuestCoreSpacesFastSuite)
+    {
+        SparseGraph<IndexType> nodal_graph;
+        for(IndexType e=0; e<2; ++e){
+            std::vector<IndexType> nodes{e, e+1};
+            nodal_graph.AddEntries(nodes);
+        }
+        nodal_graph.Finalize();
+
+        BlockCsrMatrix<2> A(nodal_graph);
+        AssembleChain(A);
+        CheckMultOverwritesNaN<CsrSpace<double, BlockCsrMatrix<2>>>(A);
+    }
+
+} // namespace Quest::Testing
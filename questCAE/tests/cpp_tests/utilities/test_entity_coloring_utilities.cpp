@@ -0,0 +1,97 @@
+// 系统头文件
+#include <vector>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "utilities/entity_coloring_utilities.hpp"
+
+namespace Quest::Testing{
+
+    namespace{
+
+        using IndexType = std::size_t;
+        using IndexVectorType = std::vector<IndexType>;
+
+        /**
+         * @brief 检查着色的合法性：每个实体恰好着色一次，同一颜色内的实体互不共享索引
+         */
+        void CheckColoring(const EntityColoring& rColoring, const IndexVectorType& rOffsets, const IndexVectorType& rIndices){
+            const IndexType number_of_entities = rOffsets.size() - 1;
+            QUEST_EXPECT_EQ(rColoring.NumberOfEntities(), number_of_entities);
+
+            IndexVectorType times_colored(number_of_entities, 0);
+            IndexType max_index = 0;
+            for(const auto index : rIndices){
+                max_index = std::max(max_index, index);
+            }
+
+            for(IndexType c=0; c<rColoring.NumberOfColors(); ++c){
+                const auto color = rColoring.GetColor(c);
+                QUEST_EXPECT_TRUE(color.size() > 0);
+                std::vector<bool> used(max_index + 1, false);
+                for(const auto i : color){
+                    ++times_colored[i];
+                    for(IndexType k=rOffsets[i]; k<rOffsets[i+1]; ++k){
+                        QUEST_EXPECT_FALSE(used[rIndices[k]]);
+                        used[rIndices[k]] = true;
+                    }
+                }
+            }
+
+            for(const auto count : times_colored){
+                QUEST_EXPECT_EQ(count, 1);
+            }
+        }
+
+    } // namespace
+
+    QUEST_TEST_CASE_IN_SUITE(EntityColoringByIndicesIsValid, QuestCoreUtilitiesFastSuite)
+    {
+        // n×n 四边形网格，每个节点两个方程；另有一个所有实体共享的全局方程（类似拉格朗日乘子），
+        // 只按节点着色时会把不同单元放到同一颜色中
+        const IndexType n = 20;
+        const IndexType global_equation = 2*(n+1)*(n+1);
+        IndexVectorType offsets(1, 0), indices;
+        for(IndexType i=0; i<n; ++i){
+            for(IndexType j=0; j<n; ++j){
+                for(const IndexType node : {i*(n+1)+j, i*(n+1)+j+1, (i+1)*(n+1)+j+1, (i+1)*(n+1)+j}){
+                    indices.push_back(2*node);
+                    indices.push_back(2*node+1);
+                }
+                if((i + j) % 7 == 0){
+                    indices.push_back(global_equation);
+                }
+                offsets.push_back(indices.size());
+            }
+        }
+
+        const auto coloring = EntityColoringUtilities::ColorByIndices(offsets, indices);
+        CheckColoring(coloring, offsets, indices);
+        // 四边形网格的按节点着色需要 4 种颜色，共享全局方程的单元各占一种颜色
+        QUEST_EXPECT_TRUE(coloring.NumberOfColors() >= 4);
+
+        IndexType number_of_coupled = 0;
+        for(IndexType e=0; e<n*n; ++e){
+            if(((e/n) + (e%n)) % 7 == 0){
+                ++number_of_coupled;
+            }
+        }
+        QUEST_EXPECT_TRUE(coloring.NumberOfColors() >= number_of_coupled);
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(EntityColoringByIndicesEdgeCases, QuestCoreUtilitiesFastSuite)
+    {
+        // 没有实体
+        const auto empty = EntityColoringUtilities::ColorByIndices(IndexVectorType(1, 0), IndexVectorType());
+        QUEST_EXPECT_EQ(empty.NumberOfEntities(), 0);
+        QUEST_EXPECT_EQ(empty.NumberOfColors(), 0);
+
+        // 没有索引的实体互不冲突，稀疏的大索引也能处理
+        const IndexVectorType offsets = {0, 0, 2, 2, 4};
+        const IndexVectorType indices = {1000000, 7, 7, 3};
+        const auto coloring = EntityColoringUtilities::ColorByIndices(offsets, indices);
+        CheckColoring(coloring, offsets, indices);
+        QUEST_EXPECT_EQ(coloring.NumberOfColors(), 2);
+    }
+
+} // namespace Quest::Testing
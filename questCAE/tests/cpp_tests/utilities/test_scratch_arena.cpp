@@ -0,0 +1,59 @@
+// 系统头文件
+#include <thread>
+
+// 项目头文件
+#include "tests/testing.hpp"
+#include "utilities/scratch_arena.hpp"
+
+namespace Quest::Testing{
+
+    QUEST_TEST_CASE_IN_SUITE(ScratchArenaScopeMergesBlocks, QuestCoreUtilitiesFastSuite)
+    {
+        ScratchArena arena(1024);
+        std::size_t grown_capacity = 0;
+        {
+            ScratchArena::Scope outer(arena);
+            arena.Allocate<double>(64);
+            {
+                ScratchArena::Scope inner(arena);
+                while(arena.NumberOfBlocks() < 3){
+                    arena.Allocate<double>(256);
+                }
+            }
+            // 内层退出时内存池未回到起点，块保持不变
+            QUEST_EXPECT_EQ(arena.NumberOfBlocks(), 3);
+            grown_capacity = arena.Capacity();
+        }
+        QUEST_EXPECT_EQ(arena.NumberOfBlocks(), 1);
+        QUEST_EXPECT_EQ(arena.Capacity(), grown_capacity);
+        QUEST_EXPECT_TRUE(arena.HighWaterMark() > 0);
+
+        // 合并后的块能容纳同样的分配
+        {
+            ScratchArena::Scope scope(arena);
+            arena.Allocate<double>(64);
+            arena.Allocate<double>(256);
+            QUEST_EXPECT_EQ(arena.NumberOfBlocks(), 1);
+        }
+    }
+
+    QUEST_TEST_CASE_IN_SUITE(ScratchArenaThreadOutsideTeamMergesBlocks, QuestCoreUtilitiesFastSuite)
+    {
+        // 不属于 OpenMP 线程组的线程不会被 ResetThreadLocalArenas 重置，依靠 Scope 退出合并块
+        std::size_t number_of_blocks = 0;
+        std::thread worker([&](){
+            ScratchArena& r_arena = ScratchArena::GetThreadLocalArena();
+            for(int step=0; step<2; ++step){
+                ScratchArena::Scope scope(r_arena);
+                const std::size_t initial_capacity = r_arena.Capacity();
+                while(r_arena.Capacity() < initial_capacity + 256*1024){
+                    r_arena.Allocate<double>(16*1024);
+                }
+            }
+            number_of_blocks = r_arena.NumberOfBlocks();
+        });
+        worker.join();
+        QUEST_EXPECT_EQ(number_of_blocks, 1);
+    }
+
+} // namespace Quest::Testing
@@ -0,0 +1,107 @@
+/*---------------------------------------------
+C++ 单元测试的注册与检查宏
+测试用例在静态初始化时注册，由 testing_main.cpp 统一运行
+----------------------------------------------*/
+
+#ifndef QUEST_TESTING_HPP
+#define QUEST_TESTING_HPP
+
+// 系统头文件
+#include <cmath>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <exception>
+
+// 项目头文件
+#include "includes/define.hpp"
+
+namespace Quest::Testing{
+
+    /**
+     * @brief 一个测试用例
+     */
+    struct TestCase{
+        std::string Suite;
+        std::string Name;
+        void (*pFunction)();
+    };
+
+    /**
+     * @brief 返回所有已注册的测试用例
+     */
+    inline std::vector<TestCase>& GetTestCases(){
+        static std::vector<TestCase> test_cases;
+        return test_cases;
+    }
+
+    /**
+     * @brief 在静态初始化时注册测试用例
+     */
+    struct TestCaseRegistrar{
+        TestCaseRegistrar(const char* pSuite, const char* pName, void (*pFunction)()){
+            GetTestCases().push_back({pSuite, pName, pFunction});
+        }
+    };
+
+    /**
+     * @brief 运行名称（"套件.用例"）包含 rFilter 的测试用例
+     * @return 失败的用例个数
+     */
+    inline int RunTestCases(const std::string& rFilter = ""){
+        int number_of_failures = 0;
+        int number_of_runs = 0;
+        for(const auto& r_test_case : GetTestCases()){
+            const std::string full_name = r_test_case.Suite + "." + r_test_case.Name;
+            if(!rFilter.empty() && full_name.find(rFilter) == std::string::npos){
+                continue;
+            }
+            ++number_of_runs;
+            try{
+                r_test_case.pFunction();
+                std::cout << "[  OK  ] " << full_name << std::endl;
+            } catch(std::exception& e){
+                ++number_of_failures;
+                std::cout << "[FAILED] " << full_name << " : " << e.what() << std::endl;
+            } catch(...){
+                ++number_of_failures;
+                std::cout << "[FAILED] " << full_name << " : unknown exception" << std::endl;
+            }
+        }
+        std::cout << number_of_runs << " test cases run, " << number_of_failures << " failed" << std::endl;
+        return number_of_failures;
+    }
+
+} // namespace Quest::Testing
+
+
+#define QUEST_TEST_CASE_IN_SUITE(TestName, SuiteName) \
+    static void QuestTest##SuiteName##TestName(); \
+    static const ::Quest::Testing::TestCaseRegistrar QuestTestRegistrar##SuiteName##TestName(#SuiteName, #TestName, &QuestTest##SuiteName##TestName); \
+    static void QuestTest##SuiteName##TestName()
+
+#define QUEST_EXPECT_TRUE(Condition) \
+    QUEST_ERROR_IF_NOT(Condition) << "Check \"" << #Condition << "\" failed" << std::endl
+
+#define QUEST_EXPECT_FALSE(Condition) \
+    QUEST_ERROR_IF(Condition) << "Check \"!(" << #Condition << ")\" failed" << std::endl
+
+#define QUEST_EXPECT_EQ(a, b) \
+    QUEST_ERROR_IF_NOT((a) == (b)) << "Check \"" << #a << " == " << #b << "\" failed (" << (a) << " != " << (b) << ")" << std::endl
+
+#define QUEST_EXPECT_NEAR(a, b, Tolerance) \
+    QUEST_ERROR_IF_NOT(std::abs((a) - (b)) <= (Tolerance)) << "Check \"" << #a << " == " << #b << "\" failed (" << (a) << " != " << (b) \
+        << ", tolerance " << (Tolerance) << ")" << std::endl
+
+#define QUEST_EXPECT_EXCEPTION_IS_THROWN(Statement) \
+    { \
+        bool quest_exception_is_thrown = false; \
+        try{ \
+            Statement; \
+        } catch(std::exception&){ \
+            quest_exception_is_thrown = true; \
+        } \
+        QUEST_ERROR_IF_NOT(quest_exception_is_thrown) << "\"" << #Statement << "\" did not throw" << std::endl; \
+    }
+
+#endif //QUEST_TESTING_HPP
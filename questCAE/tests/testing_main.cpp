@@ -0,0 +1,12 @@
+/*---------------------------------
+运行所有已注册的 C++ 单元测试
+用法：QuestCoreTests [套件.用例名称的子串]
+----------------------------------*/
+
+// 项目头文件
+#include "tests/testing.hpp"
+
+int main(int argc, char* argv[]){
+    const std::string filter = argc > 1 ? argv[1] : "";
+    return Quest::Testing::RunTestCases(filter) == 0 ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+/*---------------------------------
+cpu_features.hpp文件实现代码
+----------------------------------*/
+
+// 系统头文件
+#include <algorithm>
+
+// 项目头文件
+#include "utilities/cpu_features.hpp"
+
+namespace Quest{
+
+    bool CpuFeatures::HasAVX2(){
+        return GetDetectedSimdLevel() >= SimdLevel::AVX2;
+    }
+
+
+    bool CpuFeatures::HasAVX512(){
+        return GetDetectedSimdLevel() >= SimdLevel::AVX512;
+    }
+
+
+    SimdLevel CpuFeatures::GetDetectedSimdLevel(){
+        static const SimdLevel detected_level = DetectSimdLevel();
+        return detected_level;
+    }
+
+
+    SimdLevel CpuFeatures::GetSimdLevel(){
+        return static_cast<SimdLevel>(GetSelectedSimdLevel());
+    }
+
+
+    void CpuFeatures::SetSimdLevel(const SimdLevel Level){
+        const int detected = static_cast<int>(GetDetectedSimdLevel());
+        GetSelectedSimdLevel() = std::min(static_cast<int>(Level), detected);
+    }
+
+
+    std::string CpuFeatures::GetSimdLevelName(const SimdLevel Level){
+        switch(Level){
+            case SimdLevel::AVX512:
+                return "AVX-512";
+            case SimdLevel::AVX2:
+                return "AVX2";
+            default:
+                return "Scalar";
+        }
+    }
+
+
+    SimdLevel CpuFeatures::DetectSimdLevel(){
+        #ifdef QUEST_X86_SIMD_KERNELS
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f")){
+                return SimdLevel::AVX512;
+            }
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+                return SimdLevel::AVX2;
+            }
+        #endif
+        return SimdLevel::Scalar;
+    }
+
+
+    int& CpuFeatures::GetSelectedSimdLevel(){
+        static int selected_level = static_cast<int>(GetDetectedSimdLevel());
+        return selected_level;
+    }
+
+} // namespace Quest
@@ -0,0 +1,82 @@
+/*-------------------------------------------
+运行时CPU指令集检测
+用于在运行时选择数值核函数的SIMD实现
+-------------------------------------------*/
+
+#ifndef QUEST_CPU_FEATURES_HPP
+#define QUEST_CPU_FEATURES_HPP
+
+// 系统头文件
+#include <string>
+
+// 项目头文件
+#include "includes/define.hpp"
+
+// 仅在 x86-64 的 GCC/Clang 下编译手写的 SIMD 核函数，其余平台使用标量实现
+#if (defined(__x86_64__) || defined(__amd64__)) && (defined(__GNUC__) || defined(__clang__))
+    #define QUEST_X86_SIMD_KERNELS
+#endif
+
+namespace Quest{
+
+    /**
+     * @brief SIMD指令集级别，数值越大表示能力越强
+     */
+    enum class SimdLevel{
+        Scalar = 0,
+        AVX2 = 1,
+        AVX512 = 2
+    };
+
+    /**
+     * @class CpuFeatures
+     * @brief 运行时CPU特性检测
+     * @details 首次调用时通过CPUID检测处理器支持的指令集并缓存结果。
+     *  可通过 SetSimdLevel 把实际使用的级别限制为不高于检测结果的值（例如强制使用标量实现以便比较结果）
+     */
+    class QUEST_API(QUEST_CORE) CpuFeatures{
+        public:
+            /**
+             * @brief 返回处理器是否支持 AVX2 与 FMA
+             */
+            [[nodiscard]] static bool HasAVX2();
+
+            /**
+             * @brief 返回处理器是否支持 AVX-512F
+             */
+            [[nodiscard]] static bool HasAVX512();
+
+            /**
+             * @brief 返回处理器支持的最高SIMD级别
+             */
+            [[nodiscard]] static SimdLevel GetDetectedSimdLevel();
+
+            /**
+             * @brief 返回数值核函数实际使用的SIMD级别
+             */
+            [[nodiscard]] static SimdLevel GetSimdLevel();
+
+            /**
+             * @brief 设置数值核函数使用的SIMD级别，超过处理器支持的级别时取处理器支持的最高级别
+             */
+            static void SetSimdLevel(const SimdLevel Level);
+
+            /**
+             * @brief 返回SIMD级别的名称
+             */
+            [[nodiscard]] static std::string GetSimdLevelName(const SimdLevel Level);
+
+        protected:
+
+        private:
+            CpuFeatures() = delete;
+
+            static SimdLevel DetectSimdLevel();
+
+            static int& GetSelectedSimdLevel();
+
+    };
+
+} // namespace Quest
+
+#endif //QUEST_CPU_FEATURES_HPP
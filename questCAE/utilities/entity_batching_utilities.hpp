@@ -0,0 +1,270 @@
+/*---------------------------------------------
+单元/条件按类型分批的工具
+用于批量计算局部系统（CalculateLocalSystemBatch）
+----------------------------------------------*/
+
+#ifndef QUEST_ENTITY_BATCHING_UTILITIES_HPP
+#define QUEST_ENTITY_BATCHING_UTILITIES_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <typeindex>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
+// 第三方头文件
+#include "span/span.hpp"
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "utilities/entity_coloring_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class EntityBatching
+     * @brief 实体集合的分批结果
+     * @details 同一批中的实体动态类型相同、局部系统尺寸相同，且批大小不超过给定值。
+     *  批以类CSR的形式存储：第 b 批包含的实体（在容器中的位置）为 mEntities[mBatchOffsets[b], mBatchOffsets[b+1])。
+     *  基于着色分批时批不跨越颜色，第 c 种颜色包含的批为 [mColorBatchOffsets[c], mColorBatchOffsets[c+1])；
+     *  不着色时所有批属于同一种颜色
+     */
+    class EntityBatching final{
+        public:
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(EntityBatching);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            EntityBatching():
+                mBatchOffsets(1, 0),
+                mColorBatchOffsets(1, 0)
+            {
+            }
+
+            /**
+             * @brief 构造函数
+             * @param rBatchOffsets 每批在 rEntities 中的起始位置（大小为批数+1）
+             * @param rEntities 按批排列的实体位置
+             * @param rColorBatchOffsets 每种颜色的第一批（大小为颜色数+1）
+             */
+            EntityBatching(IndexVectorType&& rBatchOffsets, IndexVectorType&& rEntities, IndexVectorType&& rColorBatchOffsets):
+                mBatchOffsets(std::move(rBatchOffsets)),
+                mEntities(std::move(rEntities)),
+                mColorBatchOffsets(std::move(rColorBatchOffsets))
+            {
+            }
+
+            /**
+             * @brief 返回批数
+             */
+            IndexType NumberOfBatches() const{
+                return mBatchOffsets.size()-1;
+            }
+
+            /**
+             * @brief 返回颜色数（不着色时为1，空集合为0）
+             */
+            IndexType NumberOfColors() const{
+                return mColorBatchOffsets.size()-1;
+            }
+
+            /**
+             * @brief 返回被分批的实体总数
+             */
+            IndexType NumberOfEntities() const{
+                return mEntities.size();
+            }
+
+            /**
+             * @brief 返回第 Batch 批包含的实体在容器中的位置
+             */
+            Quest::span<const IndexType> GetBatch(const IndexType Batch) const{
+                QUEST_DEBUG_ERROR_IF(Batch >= NumberOfBatches()) << "Batch " << Batch << " exceeds the number of batches " << NumberOfBatches() << std::endl;
+                return Quest::span<const IndexType>(mEntities.data() + mBatchOffsets[Batch], mBatchOffsets[Batch+1] - mBatchOffsets[Batch]);
+            }
+
+            /**
+             * @brief 返回第 Color 种颜色包含的批的范围 [first, second)
+             */
+            std::pair<IndexType, IndexType> GetColorBatches(const IndexType Color) const{
+                QUEST_DEBUG_ERROR_IF(Color >= NumberOfColors()) << "Color " << Color << " exceeds the number of colors " << NumberOfColors() << std::endl;
+                return {mColorBatchOffsets[Color], mColorBatchOffsets[Color+1]};
+            }
+
+
+            std::string Info() const{
+                return "EntityBatching";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of entities : " << NumberOfEntities() << " number of batches : " << NumberOfBatches()
+                         << " number of colors : " << NumberOfColors() << std::endl;
+            }
+
+        private:
+            /**
+             * @brief 每批在 mEntities 中的起始位置（大小为批数+1）
+             */
+            IndexVectorType mBatchOffsets;
+
+            /**
+             * @brief 按批排列的实体位置
+             */
+            IndexVectorType mEntities;
+
+            /**
+             * @brief 每种颜色的第一批（大小为颜色数+1）
+             */
+            IndexVectorType mColorBatchOffsets;
+
+    };
+
+
+    /**
+     * @class EntityBatchingUtilities
+     * @brief 把实体按（动态类型，局部系统尺寸）分组，再切分为不超过给定大小的批
+     */
+    class EntityBatchingUtilities{
+        public:
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+
+        public:
+            /**
+             * @brief 对实体容器分批
+             * @details 组按首次出现的顺序排列，组内保持容器顺序，因此结果是确定性的
+             * @param rEntities 单元或条件容器
+             * @param rLocalSizeOffsets 各实体方程编号的起始位置（大小为实体数+1），相邻两项之差为局部系统尺寸
+             * @param BatchSize 批大小的上限
+             */
+            template<typename TContainerType>
+            static EntityBatching BatchEntities(const TContainerType& rEntities, const IndexVectorType& rLocalSizeOffsets, const IndexType BatchSize){
+                IndexVectorType batch_offsets(1, 0);
+                IndexVectorType entities;
+                IndexVectorType color_batch_offsets(1, 0);
+
+                const IndexType number_of_entities = rEntities.size();
+                if(number_of_entities == 0){
+                    return EntityBatching(std::move(batch_offsets), std::move(entities), std::move(color_batch_offsets));
+                }
+
+                IndexVectorType all_entities(number_of_entities);
+                std::iota(all_entities.begin(), all_entities.end(), IndexType(0));
+
+                AppendBatches(rEntities, rLocalSizeOffsets, Quest::span<const IndexType>(all_entities.data(), all_entities.size()), BatchSize, batch_offsets, entities);
+                color_batch_offsets.push_back(batch_offsets.size()-1);
+
+                return EntityBatching(std::move(batch_offsets), std::move(entities), std::move(color_batch_offsets));
+            }
+
+            /**
+             * @brief 在每种颜色内对实体分批，批不跨越颜色
+             * @param rEntities 单元或条件容器，须与着色时的容器一致
+             * @param rLocalSizeOffsets 各实体方程编号的起始位置（大小为实体数+1）
+             * @param rColoring 着色结果
+             * @param BatchSize 批大小的上限
+             */
+            template<typename TContainerType>
+            static EntityBatching BatchEntities(const TContainerType& rEntities, const IndexVectorType& rLocalSizeOffsets, const EntityColoring& rColoring, const IndexType BatchSize){
+                QUEST_ERROR_IF(rColoring.NumberOfEntities() != rEntities.size()) << "The coloring does not match the container. Number of colored entities : "
+                    << rColoring.NumberOfEntities() << " number of entities : " << rEntities.size() << std::endl;
+
+                IndexVectorType batch_offsets(1, 0);
+                IndexVectorType entities;
+                IndexVectorType color_batch_offsets(1, 0);
+
+                entities.reserve(rEntities.size());
+                for(IndexType c=0; c<rColoring.NumberOfColors(); ++c){
+                    AppendBatches(rEntities, rLocalSizeOffsets, rColoring.GetColor(c), BatchSize, batch_offsets, entities);
+                    color_batch_offsets.push_back(batch_offsets.size()-1);
+                }
+
+                return EntityBatching(std::move(batch_offsets), std::move(entities), std::move(color_batch_offsets));
+            }
+
+        private:
+            /**
+             * @brief 把一组实体按（动态类型，局部系统尺寸）分组后切分为批，追加到结果中
+             */
+            template<typename TContainerType>
+            static void AppendBatches(
+                const TContainerType& rEntities,
+                const IndexVectorType& rLocalSizeOffsets,
+                Quest::span<const IndexType> Entities,
+                const IndexType BatchSize,
+                IndexVectorType& rBatchOffsets,
+                IndexVectorType& rBatchEntities
+            ){
+                QUEST_ERROR_IF(BatchSize == 0) << "The batch size must be positive" << std::endl;
+
+                using KeyType = std::pair<std::type_index, IndexType>;
+
+                const auto it_begin = rEntities.begin();
+                std::vector<KeyType> keys;
+                IndexVectorType entity_groups(Entities.size());
+
+                for(IndexType k=0; k<Entities.size(); ++k){
+                    const IndexType i = Entities[k];
+                    const KeyType key(std::type_index(typeid(*(it_begin + i))), rLocalSizeOffsets[i+1] - rLocalSizeOffsets[i]);
+                    const auto it_key = std::find(keys.begin(), keys.end(), key);
+                    entity_groups[k] = it_key - keys.begin();
+                    if(it_key == keys.end()){
+                        keys.push_back(key);
+                    }
+                }
+
+                // 按组计数排序，组内保持原有顺序
+                IndexVectorType group_offsets(keys.size()+1, 0);
+                for(const auto group : entity_groups){
+                    ++group_offsets[group+1];
+                }
+                for(IndexType g=0; g<keys.size(); ++g){
+                    group_offsets[g+1] += group_offsets[g];
+                }
+
+                const IndexType first = rBatchEntities.size();
+                rBatchEntities.resize(first + Entities.size());
+                IndexVectorType cursor(group_offsets.begin(), group_offsets.end()-1);
+                for(IndexType k=0; k<Entities.size(); ++k){
+                    rBatchEntities[first + cursor[entity_groups[k]]++] = Entities[k];
+                }
+
+                for(IndexType g=0; g<keys.size(); ++g){
+                    for(IndexType begin=group_offsets[g]; begin<group_offsets[g+1]; begin+=BatchSize){
+                        rBatchOffsets.push_back(first + std::min(begin + BatchSize, group_offsets[g+1]));
+                    }
+                }
+            }
+
+    };
+
+
+    inline std::istream& operator >> (std::istream& rIstream, EntityBatching& rThis){
+        return rIstream;
+    }
+
+
+    inline std::ostream& operator << (std::ostream& rOstream, const EntityBatching& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_ENTITY_BATCHING_UTILITIES_HPP
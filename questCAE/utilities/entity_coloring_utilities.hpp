@@ -0,0 +1,332 @@
+/*---------------------------------------------
+单元/条件的图着色工具
+用于无冲突（无原子操作）的并行组装
+----------------------------------------------*/
+
+#ifndef QUEST_ENTITY_COLORING_UTILITIES_HPP
+#define QUEST_ENTITY_COLORING_UTILITIES_HPP
+
+// 系统头文件
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+// 第三方头文件
+#include "span/span.hpp"
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/key_hash.hpp"
+#include "utilities/parallel_utilities.hpp"
+#include "utilities/reduction_utilities.hpp"
+
+namespace Quest{
+
+    /**
+     * @class EntityColoring
+     * @brief 实体集合的着色结果
+     * @details 同一颜色内的实体互不共享节点或方程编号（取决于着色依据），
+     *  可以在同一颜色内并行组装而无需原子操作。颜色以类CSR的形式存储：
+     *  第 c 种颜色包含的实体（在容器中的位置）为 mEntities[mColorOffsets[c], mColorOffsets[c+1])
+     */
+    class EntityColoring final{
+        public:
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+
+            QUEST_CLASS_POINTER_DEFINITION(EntityColoring);
+
+        public:
+            /**
+             * @brief 默认构造函数
+             */
+            EntityColoring():
+                mColorOffsets(1, 0)
+            {
+            }
+
+            /**
+             * @brief 构造函数
+             * @param rEntityColors 每个实体的颜色
+             * @param NumberOfColors 颜色数
+             */
+            EntityColoring(const IndexVectorType& rEntityColors, const IndexType NumberOfColors):
+                mColorOffsets(NumberOfColors+1, 0),
+                mEntities(rEntityColors.size())
+            {
+                for(const auto color : rEntityColors){
+                    ++mColorOffsets[color+1];
+                }
+                for(IndexType c=0; c<NumberOfColors; ++c){
+                    mColorOffsets[c+1] += mColorOffsets[c];
+                }
+
+                IndexVectorType cursor(mColorOffsets.begin(), mColorOffsets.end()-1);
+                for(IndexType i=0; i<rEntityColors.size(); ++i){
+                    mEntities[cursor[rEntityColors[i]]++] = i;
+                }
+            }
+
+            /**
+             * @brief 返回颜色数
+             */
+            IndexType NumberOfColors() const{
+                return mColorOffsets.size()-1;
+            }
+
+            /**
+             * @brief 返回被着色的实体总数
+             */
+            IndexType NumberOfEntities() const{
+                return mEntities.size();
+            }
+
+            /**
+             * @brief 返回第 Color 种颜色包含的实体在容器中的位置（升序）
+             */
+            Quest::span<const IndexType> GetColor(const IndexType Color) const{
+                QUEST_DEBUG_ERROR_IF(Color >= NumberOfColors()) << "Color " << Color << " exceeds the number of colors " << NumberOfColors() << std::endl;
+                return Quest::span<const IndexType>(mEntities.data() + mColorOffsets[Color], mColorOffsets[Color+1] - mColorOffsets[Color]);
+            }
+
+
+            std::string Info() const{
+                return "EntityColoring";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of entities : " << NumberOfEntities() << " number of colors : " << NumberOfColors() << std::endl;
+            }
+
+        private:
+            /**
+             * @brief 每种颜色在 mEntities 中的起始位置（大小为颜色数+1）
+             */
+            IndexVectorType mColorOffsets;
+
+            /**
+             * @brief 按颜色排列的实体位置
+             */
+            IndexVectorType mEntities;
+
+    };
+
+
+    /**
+     * @class ModelPartColoring
+     * @brief 模型部件中单元与条件的着色，缓存在 ModelPart 中
+     * @details 单元与条件分别着色（两者在组装时处于不同的循环中）。
+     *  同时记录着色时的实体数目与连接关系指纹，用于判断缓存是否过期
+     */
+    struct ModelPartColoring{
+        QUEST_CLASS_POINTER_DEFINITION(ModelPartColoring);
+
+        EntityColoring ElementColoring;
+        EntityColoring ConditionColoring;
+        std::size_t NumberOfElements = 0;
+        std::size_t NumberOfConditions = 0;
+        std::size_t ElementConnectivityHash = 0;
+        std::size_t ConditionConnectivityHash = 0;
+    };
+
+
+    /**
+     * @class EntityColoringUtilities
+     * @brief 基于网格连接关系对实体进行图着色，并提供按颜色并行遍历的辅助函数
+     */
+    class EntityColoringUtilities{
+        public:
+            using IndexType = std::size_t;
+            using IndexVectorType = std::vector<IndexType>;
+
+        public:
+            /**
+             * @brief 对实体容器按共享节点进行贪心着色
+             * @details 两个实体共享至少一个节点时视为冲突。同一颜色的实体互不共享节点上的自由度，
+             *  但实体的方程编号若包含其几何以外的自由度（如约束、拉格朗日乘子），则需改用 ColorByIndices 按方程编号着色
+             * @param rEntities 单元或条件容器
+             */
+            template<typename TContainerType>
+            static EntityColoring ColorEntities(const TContainerType& rEntities){
+                const IndexType number_of_entities = rEntities.size();
+
+                IndexVectorType entity_offsets(number_of_entities+1, 0);
+                IndexPartition<IndexType>(number_of_entities).for_each([&](IndexType i){
+                    entity_offsets[i+1] = (rEntities.begin() + i)->GetGeometry().size();
+                });
+                for(IndexType i=0; i<number_of_entities; ++i){
+                    entity_offsets[i+1] += entity_offsets[i];
+                }
+
+                IndexVectorType entity_nodes(entity_offsets[number_of_entities]);
+                IndexPartition<IndexType>(number_of_entities).for_each([&](IndexType i){
+                    const auto& r_geometry = (rEntities.begin() + i)->GetGeometry();
+                    for(IndexType k=0; k<r_geometry.size(); ++k){
+                        entity_nodes[entity_offsets[i]+k] = r_geometry[k].Id();
+                    }
+                });
+
+                return ColorByIndices(entity_offsets, entity_nodes);
+            }
+
+            /**
+             * @brief 按类CSR形式给出的实体索引（节点Id或方程编号）进行贪心着色
+             * @details 两个实体的索引有交集时视为冲突。先构建“索引->实体”的邻接表，
+             *  再按实体顺序贪心地为每个实体选择其邻居未使用的最小颜色。
+             *  结果只依赖于实体顺序，因此是确定性的
+             * @param rOffsets 第 i 个实体的索引为 rIndices[rOffsets[i], rOffsets[i+1])（大小为实体数+1）
+             * @param rIndices 所有实体的索引，可以不连续
+             */
+            static EntityColoring ColorByIndices(const IndexVectorType& rOffsets, const IndexVectorType& rIndices){
+                const IndexType number_of_entities = rOffsets.empty() ? 0 : rOffsets.size()-1;
+                if(number_of_entities == 0){
+                    return EntityColoring();
+                }
+
+                // 索引压缩为连续编号
+                IndexVectorType unique_indices(rIndices);
+                std::sort(unique_indices.begin(), unique_indices.end());
+                unique_indices.erase(std::unique(unique_indices.begin(), unique_indices.end()), unique_indices.end());
+
+                IndexVectorType entity_indices(rIndices.size());
+                IndexPartition<IndexType>(rIndices.size()).for_each([&](IndexType k){
+                    entity_indices[k] = std::lower_bound(unique_indices.begin(), unique_indices.end(), rIndices[k]) - unique_indices.begin();
+                });
+
+                // 索引->实体邻接表
+                const IndexType number_of_indices = unique_indices.size();
+                IndexVectorType index_offsets(number_of_indices+1, 0);
+                for(const auto index : entity_indices){
+                    ++index_offsets[index+1];
+                }
+                for(IndexType n=0; n<number_of_indices; ++n){
+                    index_offsets[n+1] += index_offsets[n];
+                }
+                IndexVectorType index_entities(entity_indices.size());
+                IndexVectorType cursor(index_offsets.begin(), index_offsets.end()-1);
+                for(IndexType i=0; i<number_of_entities; ++i){
+                    for(IndexType k=rOffsets[i]; k<rOffsets[i+1]; ++k){
+                        index_entities[cursor[entity_indices[k]]++] = i;
+                    }
+                }
+
+                // 贪心着色
+                constexpr IndexType uncolored = std::numeric_limits<IndexType>::max();
+                IndexVectorType entity_colors(number_of_entities, uncolored);
+                IndexVectorType forbidden;
+                IndexType number_of_colors = 0;
+
+                for(IndexType i=0; i<number_of_entities; ++i){
+                    for(IndexType k=rOffsets[i]; k<rOffsets[i+1]; ++k){
+                        const IndexType index = entity_indices[k];
+                        for(IndexType m=index_offsets[index]; m<index_offsets[index+1]; ++m){
+                            const IndexType color = entity_colors[index_entities[m]];
+                            if(color != uncolored){
+                                forbidden[color] = i;
+                            }
+                        }
+                    }
+
+                    IndexType color = 0;
+                    while(color < number_of_colors && forbidden[color] == i){
+                        ++color;
+                    }
+                    if(color == number_of_colors){
+                        ++number_of_colors;
+                        forbidden.push_back(uncolored);
+                    }
+                    entity_colors[i] = color;
+                }
+
+                return EntityColoring(entity_colors, number_of_colors);
+            }
+
+            /**
+             * @brief 计算实体容器的连接关系指纹（与实体顺序、编号及节点编号有关）
+             * @details 实体数目不变而连接关系改变（如重新划分网格）时指纹随之改变，用于判断着色等缓存是否过期
+             * @param rEntities 单元或条件容器
+             */
+            template<typename TContainerType>
+            static std::size_t ComputeConnectivityHash(const TContainerType& rEntities){
+                const auto it_begin = rEntities.begin();
+                return IndexPartition<IndexType>(rEntities.size()).template for_each<Internals::SumReduction<std::size_t>>([&](IndexType i){
+                    const auto& r_entity = *(it_begin + i);
+                    const auto& r_geometry = r_entity.GetGeometry();
+                    HashType seed = i;
+                    HashCombine(seed, r_entity.Id());
+                    for(IndexType k=0; k<r_geometry.size(); ++k){
+                        HashCombine(seed, r_geometry[k].Id());
+                    }
+                    return static_cast<std::size_t>(seed);
+                });
+            }
+
+            /**
+             * @brief 按颜色依次并行遍历实体
+             * @details 颜色之间串行，同一颜色内的实体并行处理；同一颜色内的实体不共享自由度，
+             *  因此 rFunction 中可以对全局矩阵/向量使用普通（非原子）加法
+             * @param rEntities 单元或条件容器，须与着色时的容器一致
+             * @param rColoring 着色结果
+             * @param rFunction 对每个实体调用的函数 rFunction(rEntity)
+             */
+            template<typename TContainerType, typename TFunctionType>
+            static void ColoredForEach(TContainerType& rEntities, const EntityColoring& rColoring, TFunctionType&& rFunction){
+                QUEST_DEBUG_ERROR_IF(rColoring.NumberOfEntities() != rEntities.size()) << "The coloring does not match the container. Number of colored entities : "
+                    << rColoring.NumberOfEntities() << " number of entities : " << rEntities.size() << std::endl;
+
+                const auto it_begin = rEntities.begin();
+                for(IndexType c=0; c<rColoring.NumberOfColors(); ++c){
+                    const auto color = rColoring.GetColor(c);
+                    IndexPartition<IndexType>(color.size()).for_each([&](IndexType k){
+                        rFunction(*(it_begin + color[k]));
+                    });
+                }
+            }
+
+            /**
+             * @brief 按颜色依次并行遍历实体（带线程局部存储）
+             * @param rEntities 单元或条件容器，须与着色时的容器一致
+             * @param rColoring 着色结果
+             * @param rThreadLocalStoragePrototype 线程局部存储的原型
+             * @param rFunction 对每个实体调用的函数 rFunction(rEntity, rThreadLocalStorage)
+             */
+            template<typename TContainerType, typename TThreadLocalStorage, typename TFunctionType>
+            static void ColoredForEach(TContainerType& rEntities, const EntityColoring& rColoring, const TThreadLocalStorage& rThreadLocalStoragePrototype, TFunctionType&& rFunction){
+                QUEST_DEBUG_ERROR_IF(rColoring.NumberOfEntities() != rEntities.size()) << "The coloring does not match the container. Number of colored entities : "
+                    << rColoring.NumberOfEntities() << " number of entities : " << rEntities.size() << std::endl;
+
+                const auto it_begin = rEntities.begin();
+                for(IndexType c=0; c<rColoring.NumberOfColors(); ++c){
+                    const auto color = rColoring.GetColor(c);
+                    IndexPartition<IndexType>(color.size()).for_each(rThreadLocalStoragePrototype, [&](IndexType k, TThreadLocalStorage& rThreadLocalStorage){
+                        rFunction(*(it_begin + color[k]), rThreadLocalStorage);
+                    });
+                }
+            }
+
+    };
+
+
+    inline std::istream& operator >> (std::istream& rIstream, EntityColoring& rThis){
+        return rIstream;
+    }
+
+
+    inline std::ostream& operator << (std::ostream& rOstream, const EntityColoring& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_ENTITY_COLORING_UTILITIES_HPP
@@ -0,0 +1,112 @@
+/*---------------------------------
+scratch_arena.hpp文件实现代码
+----------------------------------*/
+
+// 系统头文件
+#include <cstdint>
+
+// 项目头文件
+#include "utilities/scratch_arena.hpp"
+
+namespace Quest{
+
+    void* ScratchArena::Allocate(const SizeType Bytes, const SizeType Alignment){
+        QUEST_DEBUG_ERROR_IF(Alignment == 0 || (Alignment & (Alignment - 1)) != 0) << "The alignment must be a power of two. Got " << Alignment << std::endl;
+
+        for(; mCurrentBlock < mBlocks.size(); ++mCurrentBlock){
+            void* p_data = TryAllocate(mCurrentBlock, Bytes, Alignment);
+            if(p_data != nullptr){
+                UpdateHighWaterMark();
+                return p_data;
+            }
+            mCurrentOffset = 0;
+        }
+
+        const SizeType last_size = mBlocks.empty() ? mInitialCapacity/2 : mBlocks.back().Size;
+        Block new_block;
+        new_block.Size = std::max(2*last_size, Bytes + Alignment);
+        new_block.pData.reset(new char[new_block.Size]);
+        mBlocks.push_back(std::move(new_block));
+
+        mCurrentBlock = mBlocks.size() - 1;
+        mCurrentOffset = 0;
+        void* p_data = TryAllocate(mCurrentBlock, Bytes, Alignment);
+        QUEST_DEBUG_ERROR_IF(p_data == nullptr) << "A new block of the scratch arena is too small" << std::endl;
+        UpdateHighWaterMark();
+        return p_data;
+    }
+
+
+    void ScratchArena::Reset(){
+        mCurrentBlock = 0;
+        mCurrentOffset = 0;
+        MergeBlocks();
+        mHighWaterMark = 0;
+    }
+
+
+    void ScratchArena::Clear(){
+        mBlocks.clear();
+        mCurrentBlock = 0;
+        mCurrentOffset = 0;
+        mHighWaterMark = 0;
+    }
+
+
+    ScratchArena::SizeType ScratchArena::Capacity() const{
+        SizeType capacity = 0;
+        for(const auto& r_block : mBlocks){
+            capacity += r_block.Size;
+        }
+        return capacity;
+    }
+
+
+    ScratchArena& ScratchArena::GetThreadLocalArena(){
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+
+    void ScratchArena::ResetThreadLocalArenas(){
+        #pragma omp parallel
+        {
+            GetThreadLocalArena().Reset();
+        }
+    }
+
+
+    void* ScratchArena::TryAllocate(const SizeType BlockIndex, const SizeType Bytes, const SizeType Alignment){
+        auto& r_block = mBlocks[BlockIndex];
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(r_block.pData.get());
+        const std::uintptr_t aligned = (base + mCurrentOffset + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1);
+        const SizeType begin = static_cast<SizeType>(aligned - base);
+        if(begin + Bytes > r_block.Size){
+            return nullptr;
+        }
+        mCurrentOffset = begin + Bytes;
+        return r_block.pData.get() + begin;
+    }
+
+
+    void ScratchArena::MergeBlocks(){
+        if(mBlocks.size() < 2 || mCurrentBlock != 0 || mCurrentOffset != 0){
+            return;
+        }
+        Block merged;
+        merged.Size = Capacity();
+        merged.pData.reset(new char[merged.Size]);
+        mBlocks.clear();
+        mBlocks.push_back(std::move(merged));
+    }
+
+
+    void ScratchArena::UpdateHighWaterMark(){
+        SizeType in_use = mCurrentOffset;
+        for(SizeType i=0; i<mCurrentBlock; ++i){
+            in_use += mBlocks[i].Size;
+        }
+        mHighWaterMark = std::max(mHighWaterMark, in_use);
+    }
+
+} // namespace Quest
@@ -0,0 +1,440 @@
+/*---------------------------------------------
+线程局部的临时内存池（bump 分配）
+用于单元/条件计算局部系统时的临时矩阵与向量
+----------------------------------------------*/
+
+#ifndef QUEST_SCRATCH_ARENA_HPP
+#define QUEST_SCRATCH_ARENA_HPP
+
+// 系统头文件
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+// 项目头文件
+#include "includes/define.hpp"
+#include "includes/ublas_interface.hpp"
+
+namespace Quest{
+
+    /**
+     * @class ScratchArena
+     * @brief 按块管理的 bump 分配器
+     * @details 分配只移动当前块内的偏移量，不单独释放；通过 Rewind 回到之前记录的位置，或通过 Reset 回到起点。
+     *  当前块放不下时使用下一块（不足时新建一块，容量至少翻倍）。Reset 时若使用过多个块，
+     *  会把它们合并为一个容量为总和的块，因此稳定运行后每个线程只有一个块，分配不再调用 malloc。
+     *  每个线程有一个由 GetThreadLocalArena 返回的实例，构建器在计算每个实体之前记录位置、之后回退，
+     *  单元与条件可以通过 ProcessInfo::GetScratchArena 取得当前线程的实例。
+     *  构建器在每个求解步开始时（InitializeSolutionStep）调用 ResetThreadLocalArenas 重置 OpenMP 线程的实例；
+     *  其余线程（例如不属于该线程组的线程）的实例在最外层 Scope 退出、内存池回到起点时合并多余的块。
+     *  从内存池中取得的内存只在本次实体计算内有效
+     */
+    class QUEST_API(QUEST_CORE) ScratchArena final{
+        public:
+            using SizeType = std::size_t;
+
+            /**
+             * @brief 内存池中的位置
+             */
+            struct Marker{
+                SizeType Block = 0;
+                SizeType Offset = 0;
+            };
+
+            /**
+             * @brief 作用域守卫：构造时记录位置，析构时回退
+             * @details 最外层的守卫退出后若内存池回到起点，把扩容出的多个块合并为一个块
+             */
+            class Scope{
+                public:
+                    explicit Scope(ScratchArena& rArena):
+                        mrArena(rArena),
+                        mMarker(rArena.GetMarker())
+                    {
+                        ++mrArena.mScopeDepth;
+                    }
+
+                    ~Scope(){
+                        mrArena.Rewind(mMarker);
+                        if(--mrArena.mScopeDepth == 0){
+                            mrArena.MergeBlocks();
+                        }
+                    }
+
+                    Scope(const Scope&) = delete;
+                    Scope& operator = (const Scope&) = delete;
+
+                private:
+                    ScratchArena& mrArena;
+                    Marker mMarker;
+            };
+
+            /**
+             * @brief 默认的对齐字节数（一条缓存行）
+             */
+            static constexpr SizeType DefaultAlignment = 64;
+
+        public:
+            /**
+             * @brief 构造函数
+             * @param InitialCapacity 第一块的容量（字节），首次分配时才申请
+             */
+            explicit ScratchArena(const SizeType InitialCapacity = 64*1024):
+                mInitialCapacity(std::max<SizeType>(InitialCapacity, DefaultAlignment))
+            {
+            }
+
+            ScratchArena(const ScratchArena&) = delete;
+            ScratchArena& operator = (const ScratchArena&) = delete;
+
+            /**
+             * @brief 分配 Bytes 字节（未初始化）
+             * @param Bytes 字节数
+             * @param Alignment 对齐字节数，须为2的幂
+             */
+            void* Allocate(const SizeType Bytes, const SizeType Alignment = DefaultAlignment);
+
+            /**
+             * @brief 分配 Size 个 T 类型的元素（未初始化），T 须可平凡构造与析构
+             */
+            template<typename T>
+            T* Allocate(const SizeType Size){
+                static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                    "ScratchArena only holds trivially constructible and destructible types");
+                return static_cast<T*>(Allocate(Size*sizeof(T), std::max<SizeType>(alignof(T), DefaultAlignment)));
+            }
+
+            /**
+             * @brief 返回当前位置
+             */
+            Marker GetMarker() const{
+                return {mCurrentBlock, mCurrentOffset};
+            }
+
+            /**
+             * @brief 回退到之前记录的位置，此后分配的内存全部失效
+             */
+            void Rewind(const Marker& rMarker){
+                QUEST_DEBUG_ERROR_IF(rMarker.Block > mCurrentBlock || (rMarker.Block == mCurrentBlock && rMarker.Offset > mCurrentOffset))
+                    << "Rewinding the scratch arena forward" << std::endl;
+                mCurrentBlock = rMarker.Block;
+                mCurrentOffset = rMarker.Offset;
+            }
+
+            /**
+             * @brief 回到起点，所有分配的内存失效；使用过多个块时合并为一个块
+             */
+            void Reset();
+
+            /**
+             * @brief 释放所有块
+             */
+            void Clear();
+
+            /**
+             * @brief 返回所有块的总容量（字节）
+             */
+            SizeType Capacity() const;
+
+            /**
+             * @brief 返回块的个数
+             */
+            SizeType NumberOfBlocks() const{
+                return mBlocks.size();
+            }
+
+            /**
+             * @brief 返回自上次 Reset 以来的最大占用（字节，按块容量累计）
+             */
+            SizeType HighWaterMark() const{
+                return mHighWaterMark;
+            }
+
+            /**
+             * @brief 返回当前线程的内存池
+             */
+            static ScratchArena& GetThreadLocalArena();
+
+            /**
+             * @brief 在并行区域中重置每个线程的内存池，只能在没有实体计算进行时调用
+             * @details 只能重置新开的 OpenMP 线程组中的线程的实例，线程组之外的线程依靠 Scope 退出时合并块
+             */
+            static void ResetThreadLocalArenas();
+
+
+            std::string Info() const{
+                return "ScratchArena";
+            }
+
+
+            void PrintInfo(std::ostream& rOstream) const{
+                rOstream << Info();
+            }
+
+
+            void PrintData(std::ostream& rOstream) const{
+                rOstream << "number of blocks : " << NumberOfBlocks() << " capacity : " << Capacity() << " high water mark : " << HighWaterMark() << std::endl;
+            }
+
+        private:
+            /**
+             * @brief 一块连续内存
+             */
+            struct Block{
+                std::unique_ptr<char[]> pData;
+                SizeType Size = 0;
+            };
+
+            /**
+             * @brief 在第 BlockIndex 块中尝试分配，失败返回空指针
+             */
+            void* TryAllocate(const SizeType BlockIndex, const SizeType Bytes, const SizeType Alignment);
+
+            /**
+             * @brief 更新最大占用
+             */
+            void UpdateHighWaterMark();
+
+            /**
+             * @brief 内存池处于起点且有多个块时，合并为一个容量为总和的块
+             */
+            void MergeBlocks();
+
+        private:
+            /**
+             * @brief 所有块
+             */
+            std::vector<Block> mBlocks;
+
+            /**
+             * @brief 当前块
+             */
+            SizeType mCurrentBlock = 0;
+
+            /**
+             * @brief 当前块内的偏移量
+             */
+            SizeType mCurrentOffset = 0;
+
+            /**
+             * @brief 第一块的容量
+             */
+            SizeType mInitialCapacity;
+
+            /**
+             * @brief 最大占用
+             */
+            SizeType mHighWaterMark = 0;
+
+            /**
+             * @brief 当前嵌套的 Scope 层数
+             */
+            SizeType mScopeDepth = 0;
+
+    };
+
+
+    /**
+     * @class ScratchArray
+     * @brief 从当前线程内存池取得内存的 ublas 存储类型
+     * @details 构造与扩容时从 ScratchArena::GetThreadLocalArena() 分配，缩小或在容量内扩大时复用已有内存，
+     *  析构不释放内存（由构建器回退内存池时统一回收）。只能用于单元/条件计算过程中的临时量，
+     *  不能保存到计算结束之后，也不能在线程之间传递
+     * @tparam T 元素类型，须可平凡构造与析构
+     */
+    template<typename T>
+    class ScratchArray : public boost::numeric::ublas::storage_array<ScratchArray<T>>{
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using reverse_iterator = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        public:
+            ScratchArray(){}
+
+            explicit ScratchArray(const size_type Size){
+                Reserve(Size);
+                mSize = Size;
+            }
+
+            ScratchArray(const size_type Size, const value_type& rInit){
+                Reserve(Size);
+                mSize = Size;
+                std::fill(begin(), end(), rInit);
+            }
+
+            ScratchArray(const ScratchArray& rOther){
+                Reserve(rOther.mSize);
+                mSize = rOther.mSize;
+                std::copy(rOther.begin(), rOther.end(), begin());
+            }
+
+            ScratchArray& operator = (const ScratchArray& rOther){
+                if(this != &rOther){
+                    resize(rOther.mSize);
+                    std::copy(rOther.begin(), rOther.end(), begin());
+                }
+                return *this;
+            }
+
+            ScratchArray& assign_temporary(ScratchArray& rOther){
+                swap(rOther);
+                return *this;
+            }
+
+            /**
+             * @brief 改变大小，不保留原有的值
+             */
+            void resize(const size_type Size){
+                if(Size > mCapacity){
+                    mpData = nullptr;
+                    mCapacity = 0;
+                    Reserve(Size);
+                }
+                mSize = Size;
+            }
+
+            /**
+             * @brief 改变大小，保留原有的值，新增的元素取 rInit
+             */
+            void resize(const size_type Size, const value_type& rInit){
+                if(Size > mCapacity){
+                    T* p_old = mpData;
+                    const size_type old_size = mSize;
+                    mpData = nullptr;
+                    mCapacity = 0;
+                    Reserve(Size);
+                    if(p_old != nullptr){
+                        std::copy(p_old, p_old + std::min(old_size, Size), mpData);
+                    }
+                }
+                if(Size > mSize){
+                    std::fill(mpData + mSize, mpData + Size, rInit);
+                }
+                mSize = Size;
+            }
+
+            size_type size() const{
+                return mSize;
+            }
+
+            size_type capacity() const{
+                return mCapacity;
+            }
+
+            size_type max_size() const{
+                return static_cast<size_type>(-1)/sizeof(T);
+            }
+
+            bool empty() const{
+                return mSize == 0;
+            }
+
+            const_reference operator [] (const size_type i) const{
+                QUEST_DEBUG_ERROR_IF(i >= mSize) << "Index " << i << " out of range " << mSize << std::endl;
+                return mpData[i];
+            }
+
+            reference operator [] (const size_type i){
+                QUEST_DEBUG_ERROR_IF(i >= mSize) << "Index " << i << " out of range " << mSize << std::endl;
+                return mpData[i];
+            }
+
+            void swap(ScratchArray& rOther){
+                if(this != &rOther){
+                    std::swap(mpData, rOther.mpData);
+                    std::swap(mSize, rOther.mSize);
+                    std::swap(mCapacity, rOther.mCapacity);
+                }
+            }
+
+            friend void swap(ScratchArray& rA, ScratchArray& rB){
+                rA.swap(rB);
+            }
+
+            const_iterator begin() const{
+                return mpData;
+            }
+
+            const_iterator cbegin() const{
+                return mpData;
+            }
+
+            const_iterator end() const{
+                return mpData + mSize;
+            }
+
+            const_iterator cend() const{
+                return mpData + mSize;
+            }
+
+            iterator begin(){
+                return mpData;
+            }
+
+            iterator end(){
+                return mpData + mSize;
+            }
+
+            const_reverse_iterator rbegin() const{
+                return const_reverse_iterator(end());
+            }
+
+            const_reverse_iterator rend() const{
+                return const_reverse_iterator(begin());
+            }
+
+            reverse_iterator rbegin(){
+                return reverse_iterator(end());
+            }
+
+            reverse_iterator rend(){
+                return reverse_iterator(begin());
+            }
+
+            pointer data(){
+                return mpData;
+            }
+
+            const_pointer data() const{
+                return mpData;
+            }
+
+        private:
+            void Reserve(const size_type Size){
+                if(Size > mCapacity){
+                    mpData = ScratchArena::GetThreadLocalArena().template Allocate<T>(Size);
+                    mCapacity = Size;
+                }
+            }
+
+        private:
+            T* mpData = nullptr;
+            size_type mSize = 0;
+            size_type mCapacity = 0;
+
+    };
+
+
+    inline std::ostream& operator << (std::ostream& rOstream, const ScratchArena& rThis){
+        rThis.PrintInfo(rOstream);
+        rOstream << std::endl;
+        rThis.PrintData(rOstream);
+
+        return rOstream;
+    }
+
+} // namespace Quest
+
+#endif //QUEST_SCRATCH_ARENA_HPP